@@ -24,11 +24,15 @@
 */
 
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/FrameArena.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/TaskScheduler.h"
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/ResourceManager.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
@@ -276,4 +280,63 @@ Resource<GL::Mesh> myMesh = manager.get<GL::Mesh>("my-mesh");
 }
 #endif
 
+{
+auto loadTerrain = []{};
+auto loadBuildings = []{};
+auto placeBuildingsOnTerrain = []{};
+/* [TaskScheduler-usage] */
+TaskScheduler scheduler;
+
+UnsignedInt terrain = scheduler.add(loadTerrain);
+UnsignedInt buildings = scheduler.add(loadBuildings);
+scheduler.add(placeBuildingsOnTerrain, {terrain, buildings});
+
+// Do other work in the meantime ...
+
+scheduler.wait();
+/* [TaskScheduler-usage] */
+}
+
+{
+TaskScheduler scheduler;
+Containers::ArrayView<Float> values;
+/* [TaskScheduler-parallelFor] */
+scheduler.parallelFor(values.size(), 4096, [&](std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i)
+        values[i] = Math::sqrt(values[i]);
+});
+/* [TaskScheduler-parallelFor] */
+}
+
+{
+bool running = false;
+std::size_t particleCount{};
+/* [FrameArena-usage] */
+FrameArena arena{1024*1024};
+
+while(running) {
+    arena.reset();
+
+    // Scratch memory for this frame only, no need to free it
+    Containers::ArrayView<Vector3> positions =
+        arena.allocate<Vector3>(particleCount);
+
+    // ...
+}
+/* [FrameArena-usage] */
+static_cast<void>(arena);
+}
+
+{
+/* [MemoryAccounting-usage] */
+MemoryAccounting::setEnabled(true);
+
+// Load and upload all assets ...
+
+Debug{} << "GPU buffers use" << MemoryAccounting::usage(MemoryCategory::GLBuffer)
+    << "bytes, at most" << MemoryAccounting::peakUsage(MemoryCategory::GLBuffer);
+Debug{} << MemoryAccounting::report();
+/* [MemoryAccounting-usage] */
+}
+
 }
@@ -30,6 +30,7 @@
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Animation/Easing.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/PlayerScheduler.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -359,4 +360,29 @@ static_cast<void>(position);
 static_cast<void>(rotation);
 }
 
+{
+struct Character {
+    Animation::Player<Float> player;
+    Vector3 animatedTranslation, translation;
+    Float distance;
+};
+Animation::TrackView<Float, Vector3> walk;
+std::vector<Character> crowd;
+Timeline timeline;
+/* [PlayerScheduler] */
+Animation::PlayerScheduler<Float> scheduler;
+for(Character& character: crowd) {
+    character.player.add(walk, character.animatedTranslation);
+    UnsignedInt id = scheduler.add(character.player);
+    scheduler.addInterpolated(id, character.animatedTranslation,
+                                  character.translation);
+}
+
+// every frame, update importance based on distance and advance
+for(std::size_t i = 0; i != crowd.size(); ++i)
+    scheduler.setImportance(i, 10.0f/crowd[i].distance);
+scheduler.advance(timeline.previousFrameTime());
+/* [PlayerScheduler] */
+}
+
 }
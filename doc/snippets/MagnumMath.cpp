@@ -39,6 +39,7 @@
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Algorithms/GramSchmidt.h"
 #include "Magnum/Math/StrictWeakOrdering.h"
+#include "Magnum/Math/TransformationPacking.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -1049,6 +1050,21 @@ static_cast<void>(a);
 static_cast<void>(b);
 }
 
+{
+Quaternion rotation;
+Vector3 translation;
+/* [packQuaternion] */
+/* 4 + 6 bytes instead of 28 bytes of a Quaternion and a Vector3 */
+const Range3D worldBounds{{-500.0f, -10.0f, -500.0f}, {500.0f, 100.0f, 500.0f}};
+UnsignedInt packedRotation = Math::packQuaternion<UnsignedInt>(rotation);
+Vector3us packedTranslation = Math::packTranslation<UnsignedShort>(translation, worldBounds);
+
+// on the receiving side
+rotation = Math::unpackQuaternion<Float>(packedRotation);
+translation = Math::unpackTranslation(packedTranslation, worldBounds);
+/* [packQuaternion] */
+}
+
 {
 Range1D range, a, b;
 constexpr UnsignedInt dimensions = 1;
@@ -25,14 +25,58 @@
 
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/AsyncCompiler.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/PointCloudStreamer.h"
+#include "Magnum/Shaders/VertexColor.h"
+#include "Magnum/Trade/MeshData3D.h"
 
 using namespace Magnum;
 
 int main() {
 
+{
+/* [AsyncCompiler] */
+std::vector<Trade::MeshData3D> meshes; // e.g. from an importer
+
+MeshTools::AsyncCompiler compiler{3};
+std::vector<UnsignedInt> ids;
+for(Trade::MeshData3D& mesh: meshes)
+    ids.push_back(compiler.add(std::move(mesh),
+        MeshTools::CompileFlag::GenerateSmoothNormals));
+
+// Every frame, upload at most 4 MB and spend at most 2 ms doing so
+compiler.upload(4*1024*1024, std::chrono::milliseconds{2});
+for(UnsignedInt id: ids) {
+    if(!compiler.isReady(id)) continue;
+
+    GL::Mesh& mesh = compiler.mesh(id);
+    // draw the mesh ...
+    static_cast<void>(mesh);
+}
+/* [AsyncCompiler] */
+}
+
+{
+/* [PointCloudStreamer] */
+Containers::Optional<MeshTools::PointCloudOctree> octree; // see above
+Matrix4 cameraMatrix, projectionMatrix;
+Shaders::VertexColor3D shader;
+
+/* Keep at most 20 million points in GPU memory */
+MeshTools::PointCloudStreamer streamer{*octree, 20000000};
+
+/* Every frame, select at most 5 million points, upload at most 8 MB */
+Containers::Array<UnsignedInt> selection = MeshTools::selectPointCloudNodes(
+    *octree, cameraMatrix, projectionMatrix, 1080.0f, 5000000);
+streamer.update(selection, 8*1024*1024);
+shader.setTransformationProjectionMatrix(projectionMatrix*cameraMatrix);
+streamer.draw(shader);
+/* [PointCloudStreamer] */
+}
+
 {
 /* [compressIndices] */
 std::vector<UnsignedInt> indices;
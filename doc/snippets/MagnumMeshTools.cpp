@@ -23,13 +23,24 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <tuple>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Timeline.h"
+#include "Magnum/Animation/Player.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/DuplicateForWireframe.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/MorphTargets.h"
+#include "Magnum/MeshTools/PointCloud.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/SplitIndices.h"
 #include "Magnum/MeshTools/Transform.h"
 
 using namespace Magnum;
@@ -61,6 +72,20 @@ Containers::Array<UnsignedShort> indexData =
 /* [compressIndicesAs] */
 }
 
+{
+/* [duplicateForWireframe] */
+Containers::ArrayView<UnsignedInt> indices;
+Containers::ArrayView<Vector3> positions;
+
+Containers::Array<UnsignedInt> wireframeIndices, vertexMapping;
+std::tie(wireframeIndices, vertexMapping) =
+    MeshTools::duplicateForWireframe(indices);
+Containers::Array<Vector3> wireframePositions =
+    MeshTools::duplicate<UnsignedInt, Vector3>(
+        Containers::arrayView(vertexMapping), positions);
+/* [duplicateForWireframe] */
+}
+
 {
 /* [generateFlatNormals] */
 Containers::ArrayView<UnsignedInt> indices;
@@ -84,6 +109,26 @@ auto data = MeshTools::interleave(positions, weights, 2, vertexColors, 1);
 /* [interleave2] */
 }
 
+{
+/* [PointCloudOctree] */
+/* Offline, build the octree and save it to a file */
+Containers::ArrayView<const Vector3> positions; // e.g. mapped from a file
+Containers::ArrayView<const Color4ub> colors;
+Utility::Directory::write("scan.mpco",
+    MeshTools::buildPointCloudOctree(positions, colors));
+
+/* At runtime, map the file and select nodes to draw every frame */
+Containers::Array<const char, Utility::Directory::MapDeleter> data =
+    Utility::Directory::mapRead("scan.mpco");
+Containers::Optional<MeshTools::PointCloudOctree> octree =
+    MeshTools::PointCloudOctree::open(data);
+
+Matrix4 cameraMatrix, projectionMatrix;
+Containers::Array<UnsignedInt> selection = MeshTools::selectPointCloudNodes(
+    *octree, cameraMatrix, projectionMatrix, 1080.0f, 5000000);
+/* [PointCloudOctree] */
+}
+
 {
 /* [removeDuplicates1] */
 std::vector<UnsignedInt> indices;
@@ -108,6 +153,55 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 /* [removeDuplicates2] */
 }
 
+{
+/* [splitIndices] */
+Containers::Array<UnsignedInt> indices;
+Containers::Array<Vector3> positions;
+MeshTools::IndexSplit split = MeshTools::splitIndices(indices, positions);
+
+for(const MeshTools::IndexSplit::Chunk& chunk: split.chunks) {
+    Containers::ArrayView<const UnsignedInt> chunkIndices =
+        split.indices.slice(chunk.indexOffset, chunk.indexOffset + chunk.indexCount);
+    Containers::ArrayView<const UnsignedInt> chunkMapping =
+        split.vertexMapping.slice(chunk.vertexOffset, chunk.vertexOffset + chunk.vertexCount);
+
+    /* 16-bit indices and vertex data for this chunk */
+    Containers::Array<UnsignedShort> indexData =
+        MeshTools::compressIndicesAs<UnsignedShort>(
+            std::vector<UnsignedInt>{chunkIndices.begin(), chunkIndices.end()});
+    Containers::Array<Vector3> chunkPositions =
+        MeshTools::duplicate<UnsignedInt, Vector3>(chunkMapping, positions);
+    // ...
+}
+/* [splitIndices] */
+}
+
+{
+Containers::ArrayView<const Vector3> basePositions, baseNormals;
+Containers::ArrayView<const Animation::TrackView<Float, Float>> weightTracks;
+Timeline timeline;
+/* [applyMorphTargets] */
+Containers::Array<MeshTools::MorphTarget> targets;
+Containers::Array<Float> weights{Containers::ValueInit, targets.size()};
+
+/* One weight track per target writing directly into the weight array */
+Animation::Player<Float> player;
+for(std::size_t i = 0; i != targets.size(); ++i)
+    player.add(weightTracks[i], weights[i]);
+player.play(timeline.previousFrameTime());
+
+// every frame
+Containers::Array<Vector3> positions{basePositions.size()};
+Containers::Array<Vector3> normals{baseNormals.size()};
+player.advance(timeline.previousFrameTime());
+MeshTools::applyMorphTargets(
+    Containers::stridedArrayView(basePositions),
+    Containers::stridedArrayView(baseNormals), targets, weights,
+    Containers::stridedArrayView(Containers::arrayView(positions)),
+    Containers::stridedArrayView(Containers::arrayView(normals)));
+/* [applyMorphTargets] */
+}
+
 {
 /* [transformVectors] */
 std::vector<Vector3> vectors;
@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <numeric>
+#include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
 
@@ -33,13 +35,19 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Sampler.h"
 #include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/DuplicateForWireframe.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/LightClusters.h"
 #include "Magnum/Shaders/MeshVisualizer.h"
 #include "Magnum/Shaders/Phong.h"
 #include "Magnum/Shaders/Vector.h"
@@ -321,6 +329,77 @@ shader.setColor(0x2f83cc_rgbf)
 mesh.draw(shader);
 /* [MeshVisualizer-usage-no-geom2] */
 }
+
+{
+/* [MeshVisualizer-usage-no-geom-indexed] */
+Containers::ArrayView<const UnsignedInt> indices;
+Containers::ArrayView<const Vector3> indexedPositions;
+
+/* Duplicating only vertices that need a different corner ID */
+Containers::Array<UnsignedInt> wireframeIndices, vertexMapping;
+std::tie(wireframeIndices, vertexMapping) =
+    MeshTools::duplicateForWireframe(indices);
+
+GL::Buffer vertices, indexBuffer;
+vertices.setData(MeshTools::duplicate<UnsignedInt, Vector3>(
+    Containers::arrayView(vertexMapping), indexedPositions),
+    GL::BufferUsage::StaticDraw);
+indexBuffer.setData(wireframeIndices, GL::BufferUsage::StaticDraw);
+
+GL::Mesh mesh;
+mesh.setCount(wireframeIndices.size())
+    .addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{})
+    .setIndexBuffer(indexBuffer, 0, MeshIndexType::UnsignedInt);
+/* [MeshVisualizer-usage-no-geom-indexed] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+/* [MeshVisualizer-usage-vertex-fetch1] */
+Containers::ArrayView<const UnsignedInt> indices;
+Containers::ArrayView<const Vector3> positions;
+
+/* Padding the data to whole rows */
+constexpr Int Width = 1024;
+const Vector2i indexSize{Width, Int(indices.size() + Width - 1)/Width};
+const Vector2i positionSize{Width, Int(positions.size() + Width - 1)/Width};
+Containers::Array<UnsignedInt> indexData{Containers::ValueInit,
+    std::size_t(indexSize.product())};
+Containers::Array<Vector3> positionData{Containers::ValueInit,
+    std::size_t(positionSize.product())};
+std::memcpy(indexData.data(), indices.data(), indices.size()*sizeof(UnsignedInt));
+std::memcpy(positionData.data(), positions.data(), positions.size()*sizeof(Vector3));
+
+GL::Texture2D indexTexture, positionTexture;
+indexTexture
+    .setMinificationFilter(GL::SamplerFilter::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::R32UI, indexSize)
+    .setSubImage(0, {}, ImageView2D{PixelFormat::R32UI, indexSize, indexData});
+positionTexture
+    .setMinificationFilter(GL::SamplerFilter::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::RGB32F, positionSize)
+    .setSubImage(0, {}, ImageView2D{PixelFormat::RGB32F, positionSize, positionData});
+
+GL::Mesh mesh;
+mesh.setCount(indices.size());
+/* [MeshVisualizer-usage-vertex-fetch1] */
+
+/* [MeshVisualizer-usage-vertex-fetch2] */
+Matrix4 transformationMatrix, projectionMatrix;
+
+Shaders::MeshVisualizer shader{Shaders::MeshVisualizer::Flag::Wireframe|
+                               Shaders::MeshVisualizer::Flag::VertexFetch};
+shader.setColor(0x2f83cc_rgbf)
+    .setWireframeColor(0xdcdcdc_rgbf)
+    .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+    .bindVertexFetchTextures(indexTexture, positionTexture);
+
+mesh.draw(shader);
+/* [MeshVisualizer-usage-vertex-fetch2] */
+}
+#endif
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Phong-usage-colored1] */
@@ -409,6 +488,68 @@ shader.bindTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr, nullptr
 /* [Phong-usage-alpha] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+Matrix4 projectionMatrix, transformationMatrix;
+Vector2i viewportSize;
+std::vector<Vector4> lights;
+std::vector<Color4> lightColors;
+GL::Mesh mesh;
+/* [LightClusters-usage1] */
+Shaders::LightClusters clusters{{16, 9, 24}};
+clusters.setProjection(projectionMatrix, 0.1f, 100.0f);
+/* [LightClusters-usage1] */
+
+/* [LightClusters-usage2] */
+/* View-space positions in XYZ, ranges in W */
+clusters.assign(Containers::arrayView(lights));
+
+GL::Texture3D clusterTexture;
+clusterTexture
+    .setMinificationFilter(GL::SamplerFilter::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::RG32UI, clusters.size())
+    .setSubImage(0, {}, clusters.clusterImage());
+
+/* The image height depends on the light index count, recreate the texture
+   if it grows */
+ImageView2D lightIndexImage = clusters.lightIndexImage();
+GL::Texture2D lightIndexTexture;
+lightIndexTexture
+    .setMinificationFilter(GL::SamplerFilter::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::R32UI, lightIndexImage.size())
+    .setSubImage(0, {}, lightIndexImage);
+/* [LightClusters-usage2] */
+
+/* [Phong-usage-clustered] */
+/* Positions and ranges in the first row, colors in the second */
+const Vector2i lightTextureSize{Int(lights.size()), 2};
+Containers::Array<Vector4> lightData{Containers::NoInit, lights.size()*2};
+for(std::size_t i = 0; i != lights.size(); ++i) {
+    lightData[i] = lights[i];
+    lightData[lights.size() + i] = lightColors[i];
+}
+
+GL::Texture2D lightTexture;
+lightTexture
+    .setMinificationFilter(GL::SamplerFilter::Nearest)
+    .setMagnificationFilter(GL::SamplerFilter::Nearest)
+    .setStorage(1, GL::TextureFormat::RGBA32F, lightTextureSize)
+    .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA32F, lightTextureSize, lightData});
+
+Shaders::Phong shader{Shaders::Phong::Flag::ClusteredLights, UnsignedInt(lights.size())};
+shader.bindLightClusterTextures(clusterTexture, lightIndexTexture, lightTexture)
+    .setLightClusters(clusters, viewportSize)
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.normalMatrix())
+    .setProjectionMatrix(projectionMatrix);
+
+mesh.draw(shader);
+/* [Phong-usage-clustered] */
+}
+#endif
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Vector-usage1] */
@@ -337,6 +337,14 @@ if(NOT TARGET Magnum::Magnum)
     # Dependent libraries
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
          Corrade::Utility)
+
+    # TaskScheduler uses worker threads, a private dependency that has to be
+    # linked explicitly only with a static build
+    if(MAGNUM_BUILD_STATIC)
+        find_package(Threads REQUIRED)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES Threads::Threads)
+    endif()
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -344,8 +352,8 @@ endif()
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
 set(_MAGNUM_LIBRARY_COMPONENT_LIST
-    Audio DebugTools GL MeshTools Primitives SceneGraph Shaders Text
-    TextureTools Trade Vk
+    Audio DebugTools GL MeshTools Primitives SceneGraph SceneGraphGL Shaders
+    Text TextureTools Trade Vk
     AndroidApplication EmscriptenApplication GlfwApplication GlxApplication
     Sdl2Application XEglApplication WindowlessCglApplication
     WindowlessEglApplication WindowlessGlxApplication WindowlessIosApplication
@@ -407,6 +415,7 @@ endif()
 
 set(_MAGNUM_Primitives_DEPENDENCIES Trade)
 set(_MAGNUM_SceneGraph_DEPENDENCIES )
+set(_MAGNUM_SceneGraphGL_DEPENDENCIES SceneGraph GL)
 set(_MAGNUM_Shaders_DEPENDENCIES GL)
 set(_MAGNUM_Text_DEPENDENCIES TextureTools)
 if(MAGNUM_TARGET_GL)
@@ -836,6 +845,13 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+            # AsyncCompiler uses worker threads
+            if(MAGNUM_TARGET_GL)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/GL)
@@ -845,6 +861,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
         # No special setup for SceneGraph library
+
+        # SceneGraphGL library
+        elseif(_component STREQUAL SceneGraphGL)
+            set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/SceneGraph)
+            set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES OcclusionQueryCuller.h)
+
         # No special setup for Shaders library
 
         # Text library
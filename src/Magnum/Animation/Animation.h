@@ -45,6 +45,7 @@ enum class Interpolation: UnsignedByte;
 enum class Extrapolation: UnsignedByte;
 
 template<class T, class K = T> class Player;
+template<class T, class K = T> class PlayerScheduler;
 
 template<class K, class V, class R = ResultOf<V>> class Track;
 template<class K> class TrackViewStorage;
@@ -0,0 +1,255 @@
+#ifndef Magnum_Animation_PlayerScheduler_h
+#define Magnum_Animation_PlayerScheduler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::PlayerScheduler
+ * @m_since_latest
+ */
+
+#include <cstring>
+
+#include "Magnum/Animation/Interpolation.h"
+#include "Magnum/Animation/Player.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Player scheduler
+@m_since_latest
+
+Advances a large amount of @ref Player instances, such as animated characters
+in a crowd, at reduced update rates based on their importance. Each player
+gets an importance, for example based on its distance from the camera or size
+on the screen, from which its update interval in frames is calculated:
+
+-   Players with importance @cpp 1.0f @ce or larger are advanced every
+    @ref advance() call,
+-   players with importance @cpp 0.5f @ce every second call, players with
+    importance @cpp 0.25f @ce every fourth and so on, up to
+    @ref maxInterval(). The interval is @cpp 1.0f/importance @ce rounded
+    down, tolerating float precision loss, so for example importance of
+    @cpp 0.3f @ce as well as @cpp 1.0f/3.0f @ce results in every third call,
+-   players with zero, negative or NaN importance every @ref maxInterval()
+    calls.
+
+@snippet MagnumAnimation.cpp PlayerScheduler
+
+@section Animation-PlayerScheduler-staggering Staggered updates
+
+The updates are spread across frames so the per-frame cost stays roughly
+constant --- with four players that have an update interval of four frames,
+exactly one of them is advanced each frame instead of all four every fourth
+frame. The first @ref advance() after a player is added always advances it.
+
+@section Animation-PlayerScheduler-detail Detail players
+
+Tracks that aren't important for distant players, such as finger animation,
+can be put into a separate detail player passed to @ref add(). It gets
+advanced together with the main player, but only if the importance is at
+least @ref detailThreshold(). Otherwise its destinations keep their last
+values.
+
+@section Animation-PlayerScheduler-interpolation Interpolation between updates
+
+Advancing a player only every few frames makes its motion choppy. To avoid
+that, let the tracks write into intermediate locations and register them
+together with the final destinations using @ref addInterpolated(). The
+scheduler then advances such players ahead to the time of their next
+expected update, based on the duration of the last frame, and every frame
+interpolates the final destinations from their last value towards the
+result. For players without interpolated results the player is advanced with
+the actual time.
+
+Advancing ahead of time means that player callbacks fire and the animation
+ends up to an update interval earlier than it would otherwise.
+
+@section Animation-PlayerScheduler-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into the @ref Animation
+library. For other specializations you have to use the
+@ref PlayerScheduler.hpp implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref PlayerScheduler "PlayerScheduler<Float, Float>"
+-   @ref PlayerScheduler "PlayerScheduler<std::chrono::nanoseconds, Float>"
+
+@experimental
+*/
+template<class T, class K
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    = T
+    #endif
+> class PlayerScheduler {
+    public:
+        /** @brief Time type */
+        typedef T TimeType;
+
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /**
+         * @brief Constructor
+         *
+         * The @ref maxInterval() is set to @cpp 8 @ce and
+         * @ref detailThreshold() to @cpp 0.5f @ce.
+         */
+        explicit PlayerScheduler();
+
+        /** @brief Copying is not allowed */
+        PlayerScheduler(const PlayerScheduler<T, K>&) = delete;
+
+        /** @brief Move constructor */
+        PlayerScheduler(PlayerScheduler<T, K>&&);
+
+        ~PlayerScheduler();
+
+        /** @brief Copying is not allowed */
+        PlayerScheduler<T, K>& operator=(const PlayerScheduler<T, K>&) = delete;
+
+        /** @brief Move assignment */
+        PlayerScheduler<T, K>& operator=(PlayerScheduler<T, K>&&);
+
+        /** @brief Max update interval in frames */
+        UnsignedInt maxInterval() const { return _maxInterval; }
+
+        /**
+         * @brief Set max update interval in frames
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p interval is at least @cpp 1 @ce.
+         */
+        PlayerScheduler<T, K>& setMaxInterval(UnsignedInt interval);
+
+        /** @brief Importance threshold for advancing detail players */
+        Float detailThreshold() const { return _detailThreshold; }
+
+        /**
+         * @brief Set importance threshold for advancing detail players
+         * @return Reference to self (for method chaining)
+         */
+        PlayerScheduler<T, K>& setDetailThreshold(Float threshold) {
+            _detailThreshold = threshold;
+            return *this;
+        }
+
+        /** @brief Count of scheduled players */
+        std::size_t size() const;
+
+        /**
+         * @brief Add a player
+         * @param player    Player
+         * @param detail    Detail player or @cpp nullptr @ce
+         * @return Player ID
+         *
+         * The player gets importance @cpp 1.0f @ce. IDs are assigned
+         * sequentially, starting from @cpp 0 @ce. The players are expected to
+         * stay in scope for the whole lifetime of the scheduler.
+         */
+        UnsignedInt add(Player<T, K>& player, Player<T, K>* detail = nullptr);
+
+        /**
+         * @brief Player importance
+         *
+         * Expects that @p id was returned from @ref add().
+         */
+        Float importance(UnsignedInt id) const;
+
+        /**
+         * @brief Set player importance
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p id was returned from @ref add().
+         */
+        PlayerScheduler<T, K>& setImportance(UnsignedInt id, Float importance);
+
+        /**
+         * @brief Player update interval in frames
+         *
+         * Calculated from @ref importance() and @ref maxInterval(), see the
+         * @ref PlayerScheduler class documentation for details. Expects that
+         * @p id was returned from @ref add().
+         */
+        UnsignedInt interval(UnsignedInt id) const;
+
+        /**
+         * @brief Add an interpolated result
+         * @param id            Player ID
+         * @param source        Location the player tracks write to
+         * @param destination   Interpolated location
+         * @param interpolator  Interpolator function
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Animation-PlayerScheduler-interpolation for more
+         * information. The @p source and @p destination are expected to stay
+         * in scope for the whole lifetime of the scheduler and @p R is
+         * expected to be trivially copyable. Expects that @p id was returned
+         * from @ref add().
+         */
+        template<class R> PlayerScheduler<T, K>& addInterpolated(UnsignedInt id, const R& source, R& destination, R(*interpolator)(const R&, const R&, Float) = interpolatorFor<R>(Interpolation::Linear));
+
+        /**
+         * @brief Advance the players
+         * @return Count of advanced players
+         *
+         * Advances players that are due in this frame and interpolates the
+         * results of the others.
+         */
+        std::size_t advance(T time);
+
+    private:
+        struct Entry;
+
+        PlayerScheduler<T, K>& addInterpolatedInternal(UnsignedInt id, const void* source, void* destination, std::size_t size, void(*blender)(const void*, const void*, void*, void(*)(), Float), void(*interpolator)());
+
+        UnsignedInt intervalFor(Float importance) const;
+
+        std::vector<Entry> _entries;
+        UnsignedInt _maxInterval{8};
+        Float _detailThreshold{0.5f};
+        UnsignedLong _frame{};
+        T _lastTime{};
+};
+
+template<class T, class K> template<class R> PlayerScheduler<T, K>& PlayerScheduler<T, K>::addInterpolated(const UnsignedInt id, const R& source, R& destination, R(*const interpolator)(const R&, const R&, Float)) {
+    return addInterpolatedInternal(id, &source, &destination, sizeof(R),
+        [](const void* previous, const void* current, void* destination, void(*interpolator)(), Float factor) {
+            /* The previous value is a byte copy of R, so it has to be copied
+               out to be properly aligned */
+            R previousValue;
+            std::memcpy(&previousValue, previous, sizeof(R));
+            *static_cast<R*>(destination) = reinterpret_cast<R(*)(const R&, const R&, Float)>(interpolator)(previousValue, *static_cast<const R*>(current), factor);
+        }, reinterpret_cast<void(*)()>(interpolator));
+}
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_EXPORT PlayerScheduler<Float, Float>;
+extern template class MAGNUM_EXPORT PlayerScheduler<std::chrono::nanoseconds, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef Magnum_Animation_PlayerScheduler_hpp
+#define Magnum_Animation_PlayerScheduler_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref PlayerScheduler.h
+ * @m_since_latest
+ */
+
+#include "PlayerScheduler.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+
+namespace Magnum { namespace Animation {
+
+namespace Implementation {
+    /* Ratio of two time values, with a variant for std::chrono types where
+       the division would be integral */
+    template<class T> Float schedulerTimeRatio(T a, T b) {
+        return Float(a/b);
+    }
+    template<class Rep, class Period> Float schedulerTimeRatio(std::chrono::duration<Rep, Period> a, std::chrono::duration<Rep, Period> b) {
+        return Float(Double(a.count())/Double(b.count()));
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template<class T, class K> struct PlayerScheduler<T, K>::Entry {
+    struct Output {
+        /*implicit*/ Output(const void* source, void* destination, std::size_t size, void(*blender)(const void*, const void*, void*, void(*)(), Float), void(*interpolator)()) noexcept: source{source}, destination{destination}, blender{blender}, interpolator{interpolator}, previous{Containers::ValueInit, size} {}
+
+        const void* source;
+        void* destination;
+        void(*blender)(const void*, const void*, void*, void(*)(), Float);
+        void(*interpolator)();
+        /* Byte copy of the destination value at the last update */
+        Containers::Array<char> previous;
+    };
+
+    /*implicit*/ Entry(Player<T, K>& player, Player<T, K>* detail) noexcept: player{&player}, detail{detail} {}
+
+    void blend(const T time) {
+        const Float factor = toTime == fromTime ? 1.0f :
+            Math::clamp(Implementation::schedulerTimeRatio(time - fromTime, toTime - fromTime), 0.0f, 1.0f);
+        for(Output& output: outputs)
+            output.blender(output.previous, output.source, output.destination, output.interpolator, factor);
+    }
+
+    Player<T, K>* player;
+    Player<T, K>* detail;
+    Float importance{1.0f};
+    bool advanced{};
+    /* Time of the frame before the last update and the time the player was
+       advanced to in the last update */
+    T fromTime{}, toTime{};
+    std::vector<Output> outputs;
+};
+#endif
+
+template<class T, class K> PlayerScheduler<T, K>::PlayerScheduler() = default;
+
+template<class T, class K> PlayerScheduler<T, K>::PlayerScheduler(PlayerScheduler<T, K>&&) = default;
+
+template<class T, class K> PlayerScheduler<T, K>::~PlayerScheduler() = default;
+
+template<class T, class K> PlayerScheduler<T, K>& PlayerScheduler<T, K>::operator=(PlayerScheduler<T, K>&&) = default;
+
+template<class T, class K> PlayerScheduler<T, K>& PlayerScheduler<T, K>::setMaxInterval(const UnsignedInt interval) {
+    CORRADE_ASSERT(interval,
+        "Animation::PlayerScheduler::setMaxInterval(): expected a non-zero interval", *this);
+    _maxInterval = interval;
+    return *this;
+}
+
+template<class T, class K> std::size_t PlayerScheduler<T, K>::size() const {
+    return _entries.size();
+}
+
+template<class T, class K> UnsignedInt PlayerScheduler<T, K>::add(Player<T, K>& player, Player<T, K>* const detail) {
+    _entries.emplace_back(player, detail);
+    return _entries.size() - 1;
+}
+
+template<class T, class K> Float PlayerScheduler<T, K>::importance(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _entries.size(),
+        "Animation::PlayerScheduler::importance(): index" << id << "out of range for" << _entries.size() << "players", {});
+    return _entries[id].importance;
+}
+
+template<class T, class K> PlayerScheduler<T, K>& PlayerScheduler<T, K>::setImportance(const UnsignedInt id, const Float importance) {
+    CORRADE_ASSERT(id < _entries.size(),
+        "Animation::PlayerScheduler::setImportance(): index" << id << "out of range for" << _entries.size() << "players", *this);
+    _entries[id].importance = importance;
+    return *this;
+}
+
+template<class T, class K> UnsignedInt PlayerScheduler<T, K>::interval(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _entries.size(),
+        "Animation::PlayerScheduler::interval(): index" << id << "out of range for" << _entries.size() << "players", {});
+    return intervalFor(_entries[id].importance);
+}
+
+template<class T, class K> UnsignedInt PlayerScheduler<T, K>::intervalFor(const Float importance) const {
+    if(importance >= 1.0f) return 1;
+    /* Written this way so NaN, zero and very small values don't overflow */
+    if(!(importance*Float(_maxInterval) > 1.0f)) return _maxInterval;
+    /* Importance of 1.0f/7.0f results in 6.9999995f here, which would get
+       truncated to 6. Nudge the value up by a relative epsilon before
+       truncating, that's still far from rounding up a value like 3.3. */
+    return Math::min(UnsignedInt(1.0f/importance*(1.0f + Math::TypeTraits<Float>::epsilon())), _maxInterval);
+}
+
+template<class T, class K> PlayerScheduler<T, K>& PlayerScheduler<T, K>::addInterpolatedInternal(const UnsignedInt id, const void* const source, void* const destination, const std::size_t size, void(*const blender)(const void*, const void*, void*, void(*)(), Float), void(*const interpolator)()) {
+    CORRADE_ASSERT(id < _entries.size(),
+        "Animation::PlayerScheduler::addInterpolated(): index" << id << "out of range for" << _entries.size() << "players", *this);
+    _entries[id].outputs.emplace_back(source, destination, size, blender, interpolator);
+    return *this;
+}
+
+template<class T, class K> std::size_t PlayerScheduler<T, K>::advance(const T time) {
+    /* Duration of the last frame, used to estimate when the next update
+       happens */
+    const T frameDuration = _frame ? time - _lastTime : T{};
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _entries.size(); ++i) {
+        Entry& entry = _entries[i];
+        const UnsignedInt interval = intervalFor(entry.importance);
+
+        /* Not due in this frame, only interpolate. Offsetting by the ID
+           spreads players with the same interval evenly across frames. */
+        if(entry.advanced && (_frame + i) % interval != 0) {
+            entry.blend(time);
+            continue;
+        }
+
+        /* With interpolated results advance ahead to the time of the last
+           frame before the next update and interpolate towards it from the
+           currently displayed value */
+        T playerTime = time;
+        if(!entry.outputs.empty()) {
+            playerTime = time + frameDuration*Int(interval - 1);
+            entry.fromTime = time - frameDuration;
+            entry.toTime = playerTime;
+            for(typename Entry::Output& output: entry.outputs)
+                std::memcpy(output.previous, output.destination, output.previous.size());
+        }
+
+        entry.player->advance(playerTime);
+        if(entry.detail && entry.importance >= _detailThreshold)
+            entry.detail->advance(playerTime);
+
+        /* The first time there's nothing to interpolate from */
+        if(!entry.advanced) {
+            for(typename Entry::Output& output: entry.outputs)
+                std::memcpy(output.previous, output.source, output.previous.size());
+            entry.advanced = true;
+        }
+
+        entry.blend(time);
+        ++count;
+    }
+
+    ++_frame;
+    _lastTime = time;
+    return count;
+}
+
+}}
+
+#endif
@@ -26,6 +26,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/PlayerScheduler.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -50,6 +51,9 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
 
+    void playerAdvanceMany();
+    void playerSchedulerAdvanceMany();
+
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
     Containers::Array<std::pair<Float, Int>> _interleaved;
@@ -60,7 +64,7 @@ struct Benchmark: TestSuite::Tester {
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t { DataSize = 2000, PlayerCount = 5000 };
 }
 
 Benchmark::Benchmark() {
@@ -80,7 +84,10 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+
+                   &Benchmark::playerAdvanceMany,
+                   &Benchmark::playerSchedulerAdvanceMany}, 10);
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{Containers::DirectInit, DataSize, 1};
@@ -260,6 +267,37 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::playerAdvanceMany() {
+    Containers::Array<Int> results{Containers::ValueInit, PlayerCount};
+    Containers::Array<Player<Float>> players{PlayerCount};
+    for(std::size_t i = 0; i != PlayerCount; ++i)
+        players[i].add(_track, results[i])
+            .play({});
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 10.0f; i += 1.0f)
+            for(Player<Float>& player: players) player.advance(i);
+    }
+    CORRADE_COMPARE(results[PlayerCount - 1], 1);
+}
+
+void Benchmark::playerSchedulerAdvanceMany() {
+    Containers::Array<Int> results{Containers::ValueInit, PlayerCount};
+    Containers::Array<Player<Float>> players{PlayerCount};
+    PlayerScheduler<Float> scheduler;
+    for(std::size_t i = 0; i != PlayerCount; ++i) {
+        players[i].add(_track, results[i])
+            .play({});
+        /* Importance spread from 1 to 1/8 as if the players were at various
+           distances from the camera */
+        scheduler.setImportance(scheduler.add(players[i]), 1.0f/Float(1 + i%8));
+    }
+    CORRADE_BENCHMARK(5) {
+        for(Float i = 0.0f; i < 10.0f; i += 1.0f)
+            scheduler.advance(i);
+    }
+    CORRADE_COMPARE(results[PlayerCount - 1], 1);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
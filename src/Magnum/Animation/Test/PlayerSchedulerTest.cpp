@@ -0,0 +1,339 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/PlayerScheduler.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct PlayerSchedulerTest: TestSuite::Tester {
+    explicit PlayerSchedulerTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void setMaxIntervalZero();
+    void invalidIndex();
+
+    void interval();
+
+    void advanceFullImportance();
+    void advanceStaggered();
+    void advanceDetail();
+    void advanceInterpolated();
+    void advanceInterpolatedCustomInterpolator();
+    void advanceInterpolatedChrono();
+};
+
+const Animation::Track<Float, Float> Track{{
+    {0.0f, 0.0f},
+    {100.0f, 100.0f}
+}, Math::lerp};
+
+const struct {
+    const char* name;
+    Float importance;
+    UnsignedInt expected;
+} IntervalData[]{
+    {"2", 2.0f, 1},
+    {"1", 1.0f, 1},
+    {"0.5", 0.5f, 2},
+    {"0.3", 0.3f, 3},
+    {"1/3", 1.0f/3.0f, 3},
+    {"1/7", 1.0f/7.0f, 7},
+    {"0.125", 0.125f, 8},
+    {"0.01", 0.01f, 8},
+    {"0", 0.0f, 8},
+    {"negative", -1.0f, 8},
+    {"NaN", Constants::nan(), 8}
+};
+
+PlayerSchedulerTest::PlayerSchedulerTest() {
+    addTests({&PlayerSchedulerTest::construct,
+              &PlayerSchedulerTest::constructCopy,
+              &PlayerSchedulerTest::constructMove,
+
+              &PlayerSchedulerTest::setMaxIntervalZero,
+              &PlayerSchedulerTest::invalidIndex});
+
+    addInstancedTests({&PlayerSchedulerTest::interval},
+        Containers::arraySize(IntervalData));
+
+    addTests({&PlayerSchedulerTest::advanceFullImportance,
+              &PlayerSchedulerTest::advanceStaggered,
+              &PlayerSchedulerTest::advanceDetail,
+              &PlayerSchedulerTest::advanceInterpolated,
+              &PlayerSchedulerTest::advanceInterpolatedCustomInterpolator,
+              &PlayerSchedulerTest::advanceInterpolatedChrono});
+}
+
+void PlayerSchedulerTest::construct() {
+    PlayerScheduler<Float> scheduler;
+    CORRADE_COMPARE(scheduler.maxInterval(), 8);
+    CORRADE_COMPARE(scheduler.detailThreshold(), 0.5f);
+    CORRADE_COMPARE(scheduler.size(), 0);
+
+    scheduler.setMaxInterval(16)
+        .setDetailThreshold(0.75f);
+    CORRADE_COMPARE(scheduler.maxInterval(), 16);
+    CORRADE_COMPARE(scheduler.detailThreshold(), 0.75f);
+}
+
+void PlayerSchedulerTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<PlayerScheduler<Float>, const PlayerScheduler<Float>&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<PlayerScheduler<Float>, const PlayerScheduler<Float>&>{}));
+}
+
+void PlayerSchedulerTest::constructMove() {
+    Player<Float> player;
+    PlayerScheduler<Float> a;
+    a.setMaxInterval(4);
+    a.add(player);
+    a.setImportance(0, 0.5f);
+
+    PlayerScheduler<Float> b{std::move(a)};
+    CORRADE_COMPARE(b.maxInterval(), 4);
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_COMPARE(b.importance(0), 0.5f);
+
+    PlayerScheduler<Float> c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.maxInterval(), 4);
+    CORRADE_COMPARE(c.size(), 1);
+    CORRADE_COMPARE(c.importance(0), 0.5f);
+}
+
+void PlayerSchedulerTest::setMaxIntervalZero() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    PlayerScheduler<Float> scheduler;
+    scheduler.setMaxInterval(0);
+    CORRADE_COMPARE(out.str(), "Animation::PlayerScheduler::setMaxInterval(): expected a non-zero interval\n");
+}
+
+void PlayerSchedulerTest::invalidIndex() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Player<Float> player;
+    Float source, destination;
+    PlayerScheduler<Float> scheduler;
+    scheduler.add(player);
+    scheduler.importance(1);
+    scheduler.setImportance(1, 0.5f);
+    scheduler.interval(1);
+    scheduler.addInterpolated(1, source, destination);
+    CORRADE_COMPARE(out.str(),
+        "Animation::PlayerScheduler::importance(): index 1 out of range for 1 players\n"
+        "Animation::PlayerScheduler::setImportance(): index 1 out of range for 1 players\n"
+        "Animation::PlayerScheduler::interval(): index 1 out of range for 1 players\n"
+        "Animation::PlayerScheduler::addInterpolated(): index 1 out of range for 1 players\n");
+}
+
+void PlayerSchedulerTest::interval() {
+    auto&& data = IntervalData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Player<Float> player;
+    PlayerScheduler<Float> scheduler;
+    scheduler.add(player);
+    scheduler.setImportance(0, data.importance);
+    CORRADE_COMPARE(scheduler.interval(0), data.expected);
+}
+
+void PlayerSchedulerTest::advanceFullImportance() {
+    Float valueA = -1.0f, valueB = -1.0f;
+    Player<Float> a, b;
+    a.add(Track, valueA).play(0.0f);
+    b.add(Track, valueB).play(10.0f);
+
+    PlayerScheduler<Float> scheduler;
+    CORRADE_COMPARE(scheduler.add(a), 0);
+    CORRADE_COMPARE(scheduler.add(b), 1);
+    CORRADE_COMPARE(scheduler.size(), 2);
+
+    /* With full importance everything is advanced every frame, equivalent to
+       advancing the players directly */
+    for(Float time: {10.0f, 12.5f, 13.0f}) {
+        CORRADE_COMPARE(scheduler.advance(time), 2);
+        CORRADE_COMPARE(valueA, time);
+        CORRADE_COMPARE(valueB, time - 10.0f);
+    }
+}
+
+void PlayerSchedulerTest::advanceStaggered() {
+    Float values[4]{-1.0f, -1.0f, -1.0f, -1.0f};
+    Player<Float> players[4];
+    PlayerScheduler<Float> scheduler;
+    for(std::size_t i = 0; i != 4; ++i) {
+        players[i].add(Track, values[i]).play(0.0f);
+        scheduler.setImportance(scheduler.add(players[i]), 0.25f);
+    }
+
+    /* The first frame advances everything */
+    CORRADE_COMPARE(scheduler.advance(0.0f), 4);
+    for(Float value: values) CORRADE_COMPARE(value, 0.0f);
+
+    /* Then exactly one player is advanced each frame, player i when
+       (frame + i) is divisible by 4 */
+    for(UnsignedInt frame = 1; frame != 9; ++frame) {
+        CORRADE_COMPARE(scheduler.advance(Float(frame)), 1);
+        const UnsignedInt advanced = (4 - frame%4)%4;
+        CORRADE_COMPARE(values[advanced], Float(frame));
+    }
+
+    /* Player 0 was advanced last in frame 8, player 1 in frame 7 etc. */
+    CORRADE_COMPARE(values[0], 8.0f);
+    CORRADE_COMPARE(values[1], 7.0f);
+    CORRADE_COMPARE(values[2], 6.0f);
+    CORRADE_COMPARE(values[3], 5.0f);
+}
+
+void PlayerSchedulerTest::advanceDetail() {
+    Float value = -1.0f, detailValue = -1.0f;
+    Player<Float> player, detail;
+    player.add(Track, value).play(0.0f);
+    detail.add(Track, detailValue).play(0.0f);
+
+    PlayerScheduler<Float> scheduler;
+    scheduler.add(player, &detail);
+
+    /* Above the threshold both are advanced */
+    scheduler.advance(1.0f);
+    CORRADE_COMPARE(value, 1.0f);
+    CORRADE_COMPARE(detailValue, 1.0f);
+
+    /* At the threshold as well */
+    scheduler.setImportance(0, 0.5f);
+    scheduler.advance(2.0f);
+    CORRADE_COMPARE(value, 2.0f);
+    CORRADE_COMPARE(detailValue, 2.0f);
+
+    /* Below only the main player is */
+    scheduler.setImportance(0, 1.0f)
+        .setDetailThreshold(2.0f);
+    scheduler.advance(3.0f);
+    CORRADE_COMPARE(value, 3.0f);
+    CORRADE_COMPARE(detailValue, 2.0f);
+}
+
+void PlayerSchedulerTest::advanceInterpolated() {
+    Float value = -1.0f, interpolated = -1.0f;
+    Player<Float> player;
+    player.add(Track, value).play(0.0f);
+
+    PlayerScheduler<Float> scheduler;
+    scheduler.add(player);
+    scheduler.setImportance(0, 0.25f)
+        .addInterpolated(0, value, interpolated);
+
+    /* The first frame has no previous frame duration to extrapolate from, so
+       the value stays until the next update */
+    for(Float time: {0.0f, 1.0f, 2.0f, 3.0f}) {
+        scheduler.advance(time);
+        CORRADE_COMPARE(interpolated, 0.0f);
+    }
+
+    /* In frame 4 the player is advanced to 7, the time of the last frame
+       before the next update, and the result is interpolated towards it */
+    scheduler.advance(4.0f);
+    CORRADE_COMPARE(value, 7.0f);
+    CORRADE_COMPARE(interpolated, 1.75f);
+    scheduler.advance(5.0f);
+    CORRADE_COMPARE(interpolated, 3.5f);
+    scheduler.advance(6.0f);
+    CORRADE_COMPARE(interpolated, 5.25f);
+    scheduler.advance(7.0f);
+    CORRADE_COMPARE(interpolated, 7.0f);
+
+    /* With the interpolation caught up the results now match exactly */
+    for(Float time: {8.0f, 9.0f, 10.0f, 11.0f}) {
+        scheduler.advance(time);
+        CORRADE_COMPARE(value, 11.0f);
+        CORRADE_COMPARE(interpolated, time);
+    }
+}
+
+void PlayerSchedulerTest::advanceInterpolatedCustomInterpolator() {
+    Animation::Track<Float, Vector3> track{{
+        {0.0f, {}},
+        {100.0f, Vector3{100.0f}}
+    }, Math::lerp};
+
+    Vector3 value, interpolated;
+    Player<Float> player;
+    player.add(track, value).play(0.0f);
+
+    PlayerScheduler<Float> scheduler;
+    scheduler.add(player);
+    scheduler.setImportance(0, 0.5f)
+        .addInterpolated(0, value, interpolated, Math::select);
+
+    /* Constant interpolation shows the previous value until the next update
+       catches up */
+    scheduler.advance(0.0f);
+    CORRADE_COMPARE(interpolated, Vector3{0.0f});
+    scheduler.advance(1.0f);
+    CORRADE_COMPARE(interpolated, Vector3{0.0f});
+    scheduler.advance(2.0f);
+    CORRADE_COMPARE(value, Vector3{3.0f});
+    CORRADE_COMPARE(interpolated, Vector3{0.0f});
+    scheduler.advance(3.0f);
+    CORRADE_COMPARE(interpolated, Vector3{3.0f});
+}
+
+void PlayerSchedulerTest::advanceInterpolatedChrono() {
+    Float value = -1.0f, interpolated = -1.0f;
+    Player<std::chrono::nanoseconds, Float> player;
+    player.add(Track, value).play(std::chrono::seconds{1});
+
+    PlayerScheduler<std::chrono::nanoseconds, Float> scheduler;
+    scheduler.add(player);
+    scheduler.setImportance(0, 0.5f)
+        .addInterpolated(0, value, interpolated);
+
+    scheduler.advance(std::chrono::seconds{1});
+    CORRADE_COMPARE(interpolated, 0.0f);
+    scheduler.advance(std::chrono::seconds{2});
+    CORRADE_COMPARE(interpolated, 0.0f);
+
+    /* Advanced to 4 seconds, the interpolation is halfway there */
+    scheduler.advance(std::chrono::seconds{3});
+    CORRADE_COMPARE(value, 3.0f);
+    CORRADE_COMPARE(interpolated, 1.5f);
+    scheduler.advance(std::chrono::seconds{4});
+    CORRADE_COMPARE(interpolated, 3.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::PlayerSchedulerTest)
@@ -0,0 +1,90 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameArena.h"
+
+#include <cstdint>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+FrameArena::FrameArena(const std::size_t capacity) {
+    if(capacity) {
+        _block = Containers::Array<char>{Containers::NoInit, capacity};
+        ++_heapAllocationCount;
+    }
+}
+
+FrameArena::~FrameArena() = default;
+
+std::size_t FrameArena::capacity() const {
+    std::size_t capacity = _block.size();
+    for(const Containers::Array<char>& block: _overflowBlocks)
+        capacity += block.size();
+    return capacity;
+}
+
+void* FrameArena::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "FrameArena::allocate(): alignment" << alignment << "is not a power of two", nullptr);
+
+    ++_allocationCount;
+
+    /* Allocations always go to the last block. If it doesn't fit, allocate a
+       new one at least as large as all previous together, so a frame needs
+       only a logarithmic count of them */
+    Containers::Array<char>* block = _overflowBlocks.empty() ? &_block : &_overflowBlocks.back();
+    std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(block->data() + _offset) % alignment) % alignment;
+    if(!block->data() || _offset + padding + size > block->size()) {
+        _overflowBlocks.emplace_back(Containers::NoInit, Math::max(size + alignment, capacity()));
+        ++_heapAllocationCount;
+        block = &_overflowBlocks.back();
+        _offset = 0;
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(block->data()) % alignment) % alignment;
+    }
+
+    char* const out = block->data() + _offset + padding;
+    _offset += padding + size;
+    _usedSize += padding + size;
+    return out;
+}
+
+void FrameArena::reset() {
+    /* Replace all blocks with a single one so the same allocations fit
+       without overflowing next time */
+    if(!_overflowBlocks.empty()) {
+        _block = Containers::Array<char>{Containers::NoInit, capacity()};
+        _overflowBlocks.clear();
+        ++_heapAllocationCount;
+    }
+
+    _offset = 0;
+    _usedSize = 0;
+    _allocationCount = 0;
+}
+
+}
@@ -0,0 +1,174 @@
+#ifndef Magnum_FrameArena_h
+#define Magnum_FrameArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Class @ref Magnum::FrameArena
+ * @m_since_latest
+ */
+
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Frame-scoped arena allocator
+@m_since_latest
+
+A bump allocator for transient data that live at most until the end of a
+frame, such as lists of drawable transformations. Allocations are just a
+pointer increment in a preallocated block, nothing is freed individually and
+the whole arena is rewound at once with @ref reset(), usually at the start of
+every frame:
+
+@snippet Magnum.cpp FrameArena-usage
+
+If the current block runs out of space, an additional block is allocated from
+the heap. On the next @ref reset() all blocks are then replaced with a single
+one large enough to hold everything allocated during the previous frame, so
+after a few frames the arena reaches a steady state with no heap allocations
+at all. Use @ref heapAllocationCount() to verify that.
+
+@section FrameArena-threads Thread safety
+
+The arena is not thread-safe, create one instance for each thread that needs
+one.
+*/
+class MAGNUM_EXPORT FrameArena {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity  Initial capacity in bytes
+         *
+         * If @p capacity is @cpp 0 @ce, no memory is allocated until the
+         * first allocation.
+         */
+        explicit FrameArena(std::size_t capacity = 0);
+
+        /** @brief Copying is not allowed */
+        FrameArena(const FrameArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameArena(FrameArena&&) = delete;
+
+        ~FrameArena();
+
+        /** @brief Copying is not allowed */
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        /**
+         * @brief Capacity
+         *
+         * Sum of sizes of all blocks, in bytes.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Used size
+         *
+         * Count of bytes allocated since the last @ref reset(), including
+         * alignment padding.
+         */
+        std::size_t usedSize() const { return _usedSize; }
+
+        /** @brief Count of allocations since the last @ref reset() */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Count of heap allocations
+         *
+         * Count of blocks allocated from the heap since construction. Stays
+         * the same from frame to frame once the arena reaches a steady state.
+         */
+        std::size_t heapAllocationCount() const { return _heapAllocationCount; }
+
+        /**
+         * @brief Allocate raw memory
+         *
+         * Expects that @p alignment is a power of two. The memory stays valid
+         * until the next @ref reset() or until the arena is destroyed.
+         */
+        void* allocate(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Allocate a default-constructed array
+         *
+         * As nothing is destructed on @ref reset(), @p T is required to be
+         * trivially destructible.
+         */
+        template<class T> Containers::ArrayView<T> allocate(std::size_t count) {
+            Containers::ArrayView<T> out = allocate<T>(Containers::NoInit, count);
+            for(T& i: out) new(&i) T{};
+            return out;
+        }
+
+        /**
+         * @brief Allocate an uninitialized array
+         *
+         * Useful for types that are not default-constructible, the caller is
+         * responsible for constructing the contents using placement-new. As
+         * nothing is destructed on @ref reset(), @p T is required to be
+         * trivially destructible.
+         */
+        template<class T> Containers::ArrayView<T> allocate(Containers::NoInitT, std::size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value,
+                "types with non-trivial destructors can't be allocated from a frame arena");
+            return {static_cast<T*>(allocate(count*sizeof(T), alignof(T))), count};
+        }
+
+        /**
+         * @brief Reset the arena
+         *
+         * Invalidates all allocated memory. If additional blocks had to be
+         * allocated since the last reset, they're replaced with a single
+         * block large enough to satisfy the same allocations without
+         * overflowing.
+         */
+        void reset();
+
+    private:
+        Containers::Array<char> _block;
+        std::vector<Containers::Array<char>> _overflowBlocks;
+        /* Offset into the last block (either _block or the last overflow
+           one) */
+        std::size_t _offset{},
+            _usedSize{},
+            _allocationCount{},
+            _heapAllocationCount{};
+};
+
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "Magnum/Array.h"
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
+#include "Magnum/MemoryAccounting.h"
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/BufferImage.h"
 #endif
@@ -44,6 +45,7 @@
 #include "Magnum/GL/Implementation/RendererState.h"
 #include "Magnum/GL/Implementation/State.h"
 #include "Magnum/GL/Implementation/TextureState.h"
+#include "Magnum/GL/Implementation/textureStorageSize.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Range.h"
 
@@ -2105,26 +2107,53 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture->storage1DImplementation)(levels, internalFormat, size);
+
+    if(MemoryAccounting::isEnabled())
+        texture._accountedMemory = AccountedMemory{Implementation::textureMemoryCategory(texture._target), Implementation::textureStorageSize(internalFormat, levels, Vector3i::pad(size, 1), 1)};
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture->storage2DImplementation)(levels, internalFormat, size);
+
+    if(MemoryAccounting::isEnabled()) {
+        #ifndef MAGNUM_TARGET_GLES
+        /* The second dimension of 1D texture arrays are layers */
+        const UnsignedInt mipDimensions = texture._target == GL_TEXTURE_1D_ARRAY ? 1 : 2;
+        #else
+        const UnsignedInt mipDimensions = 2;
+        #endif
+        /* Cube maps have six faces */
+        const Int faceCount = texture._target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+        texture._accountedMemory = AccountedMemory{Implementation::textureMemoryCategory(texture._target), Implementation::textureStorageSize(internalFormat, levels, {size, faceCount}, mipDimensions)};
+    }
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture->storage3DImplementation)(levels, internalFormat, size);
+
+    if(MemoryAccounting::isEnabled()) {
+        /* The third dimension of 2D and cube map texture arrays are layers */
+        const UnsignedInt mipDimensions = Implementation::textureMemoryCategory(texture._target) == MemoryCategory::GLTexture ? 3 : 2;
+        texture._accountedMemory = AccountedMemory{Implementation::textureMemoryCategory(texture._target), Implementation::textureStorageSize(internalFormat, levels, size, mipDimensions)};
+    }
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+
+    if(MemoryAccounting::isEnabled())
+        texture._accountedMemory = AccountedMemory{Implementation::textureMemoryCategory(texture._target), samples*Implementation::textureStorageSize(internalFormat, 1, {size, 1}, 2)};
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+
+    if(MemoryAccounting::isEnabled())
+        texture._accountedMemory = AccountedMemory{Implementation::textureMemoryCategory(texture._target), samples*Implementation::textureStorageSize(internalFormat, 1, size, 2)};
 }
 #endif
 
@@ -32,6 +32,7 @@
 #include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/Tags.h"
 #include "Magnum/GL/AbstractObject.h"
 #include "Magnum/GL/GL.h"
@@ -706,6 +707,7 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
 
         GLuint _id;
         ObjectFlags _flags;
+        AccountedMemory _accountedMemory;
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -811,7 +813,7 @@ template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<3> {
 };
 #endif
 
-inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags} {
+inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags}, _accountedMemory{std::move(other._accountedMemory)} {
     other._id = 0;
 }
 
@@ -820,6 +822,7 @@ inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noex
     swap(_target, other._target);
     swap(_id, other._id);
     swap(_flags, other._flags);
+    swap(_accountedMemory, other._accountedMemory);
     return *this;
 }
 
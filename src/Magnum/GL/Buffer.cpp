@@ -194,6 +194,10 @@ Buffer::~Buffer() {
     for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
         if(bindings[i] == _id) bindings[i] = 0;
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    Context::current().state().mesh->invalidateSharedVertexLayoutBindings(_id);
+    #endif
+
     glDeleteBuffers(1, &_id);
 }
 
@@ -323,6 +327,7 @@ Containers::Array<char> Buffer::data() {
 
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
     (this->*Context::current().state().buffer->dataImplementation)(data.size(), data, usage);
+    _accountedMemory = AccountedMemory{MemoryCategory::GLBuffer, data.size()};
     return *this;
 }
 
@@ -35,6 +35,7 @@
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/StlForwardTuple.h>
 
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/Tags.h"
 #include "Magnum/GL/AbstractObject.h"
 #include "Magnum/GL/GL.h"
@@ -1024,7 +1025,8 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
          *
          * If @gl_extension{ARB,direct_state_access} (part of OpenGL 4.5) is
          * not available, the buffer is bound to hinted target before the
-         * operation (if not already).
+         * operation (if not already). If @ref MemoryAccounting is enabled,
+         * size of @p data is accounted in @ref MemoryCategory::GLBuffer.
          * @see @ref setTargetHint(), @fn_gl2_keyword{NamedBufferData,BufferData},
          *      eventually @fn_gl{BindBuffer} and @fn_gl_keyword{BufferData}
          */
@@ -1322,6 +1324,7 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
         GLuint _id;
         TargetHint _targetHint;
         ObjectFlags _flags;
+        AccountedMemory _accountedMemory;
 };
 
 #ifndef MAGNUM_TARGET_WEBGL
@@ -1338,7 +1341,7 @@ MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Buffer::Target value);
 
 inline Buffer::Buffer(NoCreateT) noexcept: _id{0}, _targetHint{TargetHint::Array}, _flags{ObjectFlag::DeleteOnDestruction} {}
 
-inline Buffer::Buffer(Buffer&& other) noexcept: _id{other._id}, _targetHint{other._targetHint}, _flags{other._flags} {
+inline Buffer::Buffer(Buffer&& other) noexcept: _id{other._id}, _targetHint{other._targetHint}, _flags{other._flags}, _accountedMemory{std::move(other._accountedMemory)} {
     other._id = 0;
 }
 
@@ -1347,6 +1350,7 @@ inline Buffer& Buffer::operator=(Buffer&& other) noexcept {
     swap(_id, other._id);
     swap(_targetHint, other._targetHint);
     swap(_flags, other._flags);
+    swap(_accountedMemory, other._accountedMemory);
     return *this;
 }
 
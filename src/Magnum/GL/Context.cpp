@@ -576,10 +576,12 @@ Context::Context(NoCreateT, Utility::Arguments& args, Int argc, const char** arg
         .addOption("disable-extensions").setHelp("disable-extensions", "API extensions to disable", "LIST")
         .addOption("gpu-validation", "off").setHelp("gpu-validation", "GPU validation using KHR_debug (if present)", "off|on")
         .addOption("log", "default").setHelp("log", "console logging", "default|quiet|verbose")
+        .addOption("shared-vertex-layouts", "off").setHelp("shared-vertex-layouts", "share vertex array objects among meshes with the same vertex layout (if supported)", "off|on")
         .setFromEnvironment("disable-workarounds")
         .setFromEnvironment("disable-extensions")
         .setFromEnvironment("gpu-validation")
         .setFromEnvironment("log")
+        .setFromEnvironment("shared-vertex-layouts")
         .parse(argc, argv);
 
     /* Decide how to display initialization log */
@@ -592,6 +594,10 @@ Context::Context(NoCreateT, Utility::Arguments& args, Int argc, const char** arg
     if(args.value("gpu-validation") == "on" || args.value("gpu-validation") == "ON")
         _internalFlags |= InternalFlag::GpuValidation;
 
+    /* Decide whether to share VAOs among meshes */
+    if(args.value("shared-vertex-layouts") == "on" || args.value("shared-vertex-layouts") == "ON")
+        _internalFlags |= InternalFlag::SharedVertexLayouts;
+
     /* Disable driver workarounds */
     for(auto&& workaround: Utility::String::splitWithoutEmptyParts(args.value("disable-workarounds")))
         disableDriverWorkaround(workaround);
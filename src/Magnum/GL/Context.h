@@ -124,7 +124,8 @@ either from the `Platform::*Application` classes or from the
 <application> [--magnum-help] [--magnum-disable-workarounds LIST]
               [--magnum-disable-extensions LIST]
               [--magnum-gpu-validation off|on]
-              [--magnum-log default|quiet|verbose] ...
+              [--magnum-log default|quiet|verbose]
+              [--magnum-shared-vertex-layouts off|on] ...
 @endcode
 
 Arguments:
@@ -147,6 +148,11 @@ Arguments:
     (environment: `MAGNUM_LOG`) (default: `default`). If you need to suppress
     the engine startup log from code, the recommended way is to redirect
     @ref Utility-Debug-scoped-output "debug output to null" during context creation.
+-   `--magnum-shared-vertex-layouts off|on` --- share vertex array objects
+    among meshes with the same vertex layout, if
+    @gl_extension{ARB,vertex_attrib_binding} or OpenGL ES 3.1 is available
+    (environment: `MAGNUM_SHARED_VERTEX_LAYOUTS`) (default: `off`). See
+    @ref GL-Mesh-shared-vertex-layouts for more information.
 
 Note that all options are prefixed with `--magnum-` to avoid conflicts with
 options passed to the application itself. Options that don't have this prefix
@@ -725,7 +731,8 @@ class MAGNUM_GL_EXPORT Context {
         enum class InternalFlag: UnsignedByte {
             DisplayInitializationLog = 1 << 0,
             DisplayVerboseInitializationLog = DisplayInitializationLog|(1 << 1),
-            GpuValidation = 1 << 2
+            GpuValidation = 1 << 2,
+            SharedVertexLayouts = 1 << 3
         };
         typedef Containers::EnumSet<InternalFlag> InternalFlags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(InternalFlags)
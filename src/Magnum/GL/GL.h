@@ -124,6 +124,8 @@ class RectangleTexture;
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
 
+class RenderTargetPool;
+
 enum class SamplerFilter: GLint;
 enum class SamplerMipmap: GLint;
 enum class SamplerWrapping: GLint;
@@ -107,6 +107,35 @@ MeshState::MeshState(Context& context, ContextState& contextState, std::vector<s
     }
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* If requested, meshes don't have their own VAO but store the attribute
+       list like without VAOs, and a VAO matching the attribute formats is
+       picked on draw */
+    if((context.internalFlags() & Context::InternalFlag::SharedVertexLayouts)
+        #ifndef MAGNUM_TARGET_GLES
+        && context.isExtensionSupported<Extensions::ARB::vertex_array_object>()
+        && context.isExtensionSupported<Extensions::ARB::vertex_attrib_binding>()
+        #else
+        && context.isVersionSupported(Version::GLES310)
+        #endif
+    ) {
+        #ifndef MAGNUM_TARGET_GLES
+        extensions.emplace_back(Extensions::ARB::vertex_attrib_binding::string());
+        #endif
+
+        createImplementation = &Mesh::createImplementationDefault;
+        moveConstructImplementation = &Mesh::moveConstructImplementationDefault;
+        moveAssignImplementation = &Mesh::moveAssignImplementationDefault;
+        destroyImplementation = &Mesh::destroyImplementationDefault;
+        attributePointerImplementation = &Mesh::attributePointerImplementationDefault;
+        acquireVertexBufferImplementation = &Mesh::acquireVertexBufferImplementationDefault;
+        bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationDefault;
+        bindVAOImplementation = &Mesh::bindVAOImplementationVAO;
+        bindImplementation = &Mesh::bindImplementationSharedVAO;
+        unbindImplementation = &Mesh::unbindImplementationVAO;
+    }
+    #endif
+
     #ifdef MAGNUM_TARGET_GLES
     #ifndef MAGNUM_TARGET_WEBGL
     /* Multi draw implementation on ES */
@@ -212,10 +241,35 @@ MeshState::~MeshState() {
     if(defaultVAO) glDeleteVertexArrays(1, &defaultVAO);
     if(scratchVAO) glDeleteVertexArrays(1, &scratchVAO);
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    for(const SharedVertexLayout& layout: sharedVertexLayouts)
+        glDeleteVertexArrays(1, &layout.id);
+    #endif
 }
 
 void MeshState::reset() {
     currentVAO = State::DisengagedBinding;
+
+    /* External code might have modified buffer bindings of the shared VAOs
+       as well */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    for(SharedVertexLayout& layout: sharedVertexLayouts) {
+        for(SharedVertexLayout::Binding& binding: layout.bindings)
+            binding.buffer = State::DisengagedBinding;
+        layout.indexBuffer = State::DisengagedBinding;
+    }
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshState::invalidateSharedVertexLayoutBindings(const GLuint buffer) {
+    for(SharedVertexLayout& layout: sharedVertexLayouts) {
+        for(SharedVertexLayout::Binding& binding: layout.bindings)
+            if(binding.buffer == buffer) binding.buffer = State::DisengagedBinding;
+        if(layout.indexBuffer == buffer) layout.indexBuffer = State::DisengagedBinding;
+    }
 }
+#endif
 
 }}}
@@ -34,12 +34,46 @@ namespace Magnum { namespace GL { namespace Implementation {
 
 struct ContextState;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/* A VAO shared by all meshes with the same attribute formats, see
+   Mesh::bindImplementationSharedVAO() */
+struct SharedVertexLayout {
+    struct Attribute {
+        GLuint location;
+        GLint size;
+        GLenum type;
+        DynamicAttribute::Kind kind;
+        GLuint divisor;
+    };
+
+    /* Buffer currently bound to a binding point, the binding index is the
+       same as attribute location */
+    struct Binding {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizei stride;
+    };
+
+    /* Sorted by location */
+    std::vector<Attribute> attributes;
+    std::vector<Binding> bindings;
+    GLuint id;
+    GLuint indexBuffer;
+};
+#endif
+
 struct MeshState {
     explicit MeshState(Context& context, ContextState& contextState, std::vector<std::string>& extensions);
     ~MeshState();
 
     void reset();
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Called when a buffer is deleted, so a new buffer with the same ID isn't
+       mistaken for a buffer that's still bound to a shared VAO */
+    void invalidateSharedVertexLayoutBindings(GLuint buffer);
+    #endif
+
     void(Mesh::*createImplementation)(bool);
     void(Mesh::*moveConstructImplementation)(Mesh&&);
     void(Mesh::*moveAssignImplementation)(Mesh&&);
@@ -72,6 +106,10 @@ struct MeshState {
     #endif
 
     GLuint currentVAO;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    std::vector<SharedVertexLayout> sharedVertexLayouts;
+    #endif
+    UnsignedLong vertexArrayBindCount{}, vertexBufferBindCount{};
     #if !defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
     GLint maxVertexAttributeStride{};
     #endif
@@ -23,10 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-/* See Magnum/GL/PixelFormat.cpp, Magnum/GL/Test/PixelFormatTest.cpp and
-   DebugTools/Screenshot.cpp. _c() is a mapping, _s() denotes a skipped value
-   (so the enum numbering is preserved), _n() denotes a value where pixel
-   format mapping is defined, but texture format is not */
+/* See Magnum/GL/PixelFormat.cpp, Magnum/GL/Test/PixelFormatTest.cpp,
+   DebugTools/Screenshot.cpp and TextureTools/TextureArrayGL.cpp. _c() is a
+   mapping, _s() denotes a skipped value (so the enum numbering is preserved),
+   _n() denotes a value where pixel format mapping is defined, but texture
+   format is not */
 #ifdef _c
 #ifndef MAGNUM_TARGET_GLES2
 _c(R8Unorm, Red, UnsignedByte, R8)
@@ -0,0 +1,367 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "textureStorageSize.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/MemoryAccounting.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+namespace {
+
+/* Returns size of a block in bytes, blockSize is set to 1x1x1 for
+   uncompressed formats. Unsized and generic compressed formats are assumed to
+   be stored with the precision of the corresponding 8-bit format, depth
+   formats with less than 32 bits are assumed to be padded to 32 bits. */
+UnsignedInt textureFormatBlockSize(const TextureFormat format, Vector3i& blockSize) {
+    blockSize = {1, 1, 1};
+
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::Red:
+        case TextureFormat::R8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8UI:
+        case TextureFormat::R8I:
+        #endif
+        #if defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::Luminance:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::SR8:
+        case TextureFormat::StencilIndex8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R3G3B2:
+        case TextureFormat::RGBA2:
+        case TextureFormat::CompressedRed:
+        #endif
+            return 1;
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RG:
+        case TextureFormat::RG8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::RG8UI:
+        case TextureFormat::RG8I:
+        case TextureFormat::R16UI:
+        case TextureFormat::R16I:
+        case TextureFormat::R16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R16:
+        case TextureFormat::R16Snorm:
+        #endif
+        #if defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::LuminanceAlpha:
+        #endif
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        case TextureFormat::SRG8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGB4:
+        case TextureFormat::RGB5:
+        case TextureFormat::CompressedRG:
+        #endif
+        case TextureFormat::RGB565:
+        case TextureFormat::RGBA4:
+        case TextureFormat::RGB5A1:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::DepthComponent16:
+        #endif
+            return 2;
+
+        case TextureFormat::RGB:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGB8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::SRGB8:
+        case TextureFormat::RGB8Snorm:
+        case TextureFormat::RGB8UI:
+        case TextureFormat::RGB8I:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGB:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRGB:
+        #endif
+            return 3;
+
+        case TextureFormat::RGBA:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGBA8:
+        case TextureFormat::SRGB8Alpha8:
+        case TextureFormat::RGB10A2:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::RGBA8I:
+        case TextureFormat::RG16UI:
+        case TextureFormat::RG16I:
+        case TextureFormat::RG16F:
+        case TextureFormat::R32UI:
+        case TextureFormat::R32I:
+        case TextureFormat::R32F:
+        case TextureFormat::R11FG11FB10F:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::RGB10A2UI:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RG16:
+        case TextureFormat::RG16Snorm:
+        case TextureFormat::CompressedRGBA:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGBAlpha:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || (defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL))
+        case TextureFormat::RGB10:
+        #endif
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        case TextureFormat::BGRA:
+        case TextureFormat::BGRA8:
+        #endif
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::DepthComponent24:
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::DepthComponent32F:
+        #endif
+            return 4;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB16UI:
+        case TextureFormat::RGB16I:
+        case TextureFormat::RGB16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGB16:
+        case TextureFormat::RGB16Snorm:
+        case TextureFormat::RGB12:
+        case TextureFormat::RGBA12:
+        #endif
+            return 6;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA16UI:
+        case TextureFormat::RGBA16I:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32UI:
+        case TextureFormat::RG32I:
+        case TextureFormat::RG32F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGBA16:
+        case TextureFormat::RGBA16Snorm:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        /* 32-bit float depth, 8-bit stencil and 24 bits of padding */
+        case TextureFormat::Depth32FStencil8:
+        #endif
+            return 8;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB32UI:
+        case TextureFormat::RGB32I:
+        case TextureFormat::RGB32F:
+            return 12;
+
+        case TextureFormat::RGBA32UI:
+        case TextureFormat::RGBA32I:
+        case TextureFormat::RGBA32F:
+            return 16;
+        #endif
+
+        /* 4x4 blocks, 8 bytes */
+        case TextureFormat::CompressedRGBS3tcDxt1:
+        case TextureFormat::CompressedSRGBS3tcDxt1:
+        case TextureFormat::CompressedRGBAS3tcDxt1:
+        case TextureFormat::CompressedSRGBAlphaS3tcDxt1:
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+        case TextureFormat::CompressedRedRgtc1:
+        case TextureFormat::CompressedSignedRedRgtc1:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGB8Etc2:
+        case TextureFormat::CompressedSRGB8Etc2:
+        case TextureFormat::CompressedRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedSRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedR11Eac:
+        case TextureFormat::CompressedSignedR11Eac:
+        #endif
+            blockSize = {4, 4, 1};
+            return 8;
+
+        /* 4x4 blocks, 16 bytes */
+        case TextureFormat::CompressedRGBAS3tcDxt3:
+        case TextureFormat::CompressedSRGBAlphaS3tcDxt3:
+        case TextureFormat::CompressedRGBAS3tcDxt5:
+        case TextureFormat::CompressedSRGBAlphaS3tcDxt5:
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+        case TextureFormat::CompressedRGRgtc2:
+        case TextureFormat::CompressedSignedRGRgtc2:
+        case TextureFormat::CompressedRGBBptcUnsignedFloat:
+        case TextureFormat::CompressedRGBBptcSignedFloat:
+        case TextureFormat::CompressedRGBABptcUnorm:
+        case TextureFormat::CompressedSRGBAlphaBptcUnorm:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGBA8Etc2Eac:
+        case TextureFormat::CompressedSRGB8Alpha8Etc2Eac:
+        case TextureFormat::CompressedRG11Eac:
+        case TextureFormat::CompressedSignedRG11Eac:
+        #endif
+            blockSize = {4, 4, 1};
+            return 16;
+
+        /* ASTC has always 16-byte blocks */
+        #define _c(w, h)                                                    \
+        case TextureFormat::CompressedRGBAAstc ## w ## x ## h:              \
+        case TextureFormat::CompressedSRGB8Alpha8Astc ## w ## x ## h:       \
+            blockSize = {w, h, 1};                                          \
+            return 16;
+        _c(4, 4)
+        _c(5, 4)
+        _c(5, 5)
+        _c(6, 5)
+        _c(6, 6)
+        _c(8, 5)
+        _c(8, 6)
+        _c(8, 8)
+        _c(10, 5)
+        _c(10, 6)
+        _c(10, 8)
+        _c(10, 10)
+        _c(12, 10)
+        _c(12, 12)
+        #undef _c
+
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        #define _c(w, h, d)                                                 \
+        case TextureFormat::CompressedRGBAAstc ## w ## x ## h ## x ## d:    \
+        case TextureFormat::CompressedSRGB8Alpha8Astc ## w ## x ## h ## x ## d: \
+            blockSize = {w, h, d};                                          \
+            return 16;
+        _c(3, 3, 3)
+        _c(4, 3, 3)
+        _c(4, 4, 3)
+        _c(4, 4, 4)
+        _c(5, 4, 4)
+        _c(5, 5, 4)
+        _c(5, 5, 5)
+        _c(6, 5, 5)
+        _c(6, 6, 5)
+        _c(6, 6, 6)
+        #undef _c
+        #endif
+
+        #ifdef MAGNUM_TARGET_GLES
+        /* 8x4 blocks, 8 bytes */
+        case TextureFormat::CompressedRGBPvrtc2bppV1:
+        case TextureFormat::CompressedRGBAPvrtc2bppV1:
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::CompressedSRGBPvrtc2bppV1:
+        case TextureFormat::CompressedSRGBAlphaPvrtc2bppV1:
+        #endif
+            blockSize = {8, 4, 1};
+            return 8;
+
+        /* 4x4 blocks, 8 bytes */
+        case TextureFormat::CompressedRGBPvrtc4bppV1:
+        case TextureFormat::CompressedRGBAPvrtc4bppV1:
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::CompressedSRGBPvrtc4bppV1:
+        case TextureFormat::CompressedSRGBAlphaPvrtc4bppV1:
+        #endif
+            blockSize = {4, 4, 1};
+            return 8;
+        #endif
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+std::size_t textureStorageSize(const TextureFormat format, const Int levels, const Vector3i& size, const UnsignedInt mipDimensions) {
+    Vector3i blockSize{NoInit};
+    const UnsignedInt blockDataSize = textureFormatBlockSize(format, blockSize);
+
+    std::size_t dataSize = 0;
+    Vector3i levelSize = size;
+    for(Int level = 0; level != levels; ++level) {
+        const Vector3i blockCount = (levelSize + blockSize - Vector3i{1})/blockSize;
+        dataSize += std::size_t(blockCount.product())*blockDataSize;
+
+        for(UnsignedInt i = 0; i != mipDimensions; ++i)
+            levelSize[i] = Math::max(levelSize[i]/2, 1);
+    }
+
+    return dataSize;
+}
+
+MemoryCategory textureMemoryCategory(const GLenum target) {
+    switch(target) {
+        #ifndef MAGNUM_TARGET_GLES
+        case GL_TEXTURE_1D_ARRAY:
+        case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case GL_TEXTURE_2D_ARRAY:
+        #endif
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        case GL_TEXTURE_2D_MULTISAMPLE_ARRAY_OES:
+        #endif
+            return MemoryCategory::GLTextureArray;
+
+        case GL_TEXTURE_CUBE_MAP:
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        case GL_TEXTURE_CUBE_MAP_ARRAY:
+        #endif
+            return MemoryCategory::GLCubeMapTexture;
+    }
+
+    return MemoryCategory::GLTexture;
+}
+
+}}}
@@ -0,0 +1,48 @@
+#ifndef Magnum_GL_Implementation_textureStorageSize_h
+#define Magnum_GL_Implementation_textureStorageSize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+/* Estimated size of texture storage in bytes, used for memory accounting.
+   Only first mipDimensions components of size are halved for each mip level,
+   the rest are array layers. Compressed formats are rounded up to whole
+   blocks, unsized formats are assumed to have eight bits per component.
+   Exported only for tests. */
+MAGNUM_GL_EXPORT std::size_t textureStorageSize(TextureFormat format, Int levels, const Vector3i& size, UnsignedInt mipDimensions);
+
+/* Memory category corresponding to given texture target */
+MemoryCategory textureMemoryCategory(GLenum target);
+
+}}}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include "Mesh.h"
 
+#include <algorithm>
 #include <vector>
 #include <Corrade/Utility/Debug.h>
 
@@ -63,6 +64,46 @@ constexpr MeshIndexType IndexTypeMapping[]{
     MeshIndexType::UnsignedInt
 };
 
+/* Stride of a tightly packed attribute. Zero stride means tightly packed only
+   for glVertexAttribPointer(), while for glBindVertexBuffer() and
+   glVertexArrayVertexBuffer() it means all vertices read the same value. */
+GLsizei tightStride(const DynamicAttribute& attribute) {
+    #ifndef MAGNUM_TARGET_GLES
+    const GLsizei components = attribute.components() == DynamicAttribute::Components::BGRA ? 4 : GLsizei(attribute.components());
+    #else
+    const GLsizei components = GLsizei(attribute.components());
+    #endif
+
+    switch(attribute.dataType()) {
+        case DynamicAttribute::DataType::UnsignedByte:
+        case DynamicAttribute::DataType::Byte:
+            return components;
+        case DynamicAttribute::DataType::UnsignedShort:
+        case DynamicAttribute::DataType::Short:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case DynamicAttribute::DataType::Half:
+        #endif
+            return 2*components;
+        case DynamicAttribute::DataType::UnsignedInt:
+        case DynamicAttribute::DataType::Int:
+        case DynamicAttribute::DataType::Float:
+            return 4*components;
+        #ifndef MAGNUM_TARGET_GLES
+        case DynamicAttribute::DataType::Double:
+            return 8*components;
+        case DynamicAttribute::DataType::UnsignedInt10f11f11fRev:
+            return 4;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case DynamicAttribute::DataType::UnsignedInt2101010Rev:
+        case DynamicAttribute::DataType::Int2101010Rev:
+            return 4;
+        #endif
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 }
 
 MeshPrimitive meshPrimitive(const Magnum::MeshPrimitive primitive) {
@@ -223,6 +264,36 @@ Int Mesh::maxElementsVertices() {
 }
 #endif
 
+bool Mesh::hasSharedVertexLayouts() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    return Context::current().state().mesh->bindImplementation == &Mesh::bindImplementationSharedVAO;
+    #else
+    return false;
+    #endif
+}
+
+UnsignedInt Mesh::sharedVertexLayoutCount() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    return Context::current().state().mesh->sharedVertexLayouts.size();
+    #else
+    return 0;
+    #endif
+}
+
+UnsignedLong Mesh::vertexArrayBindCount() {
+    return Context::current().state().mesh->vertexArrayBindCount;
+}
+
+UnsignedLong Mesh::vertexBufferBindCount() {
+    return Context::current().state().mesh->vertexBufferBindCount;
+}
+
+void Mesh::resetBindCounters() {
+    Implementation::MeshState& state = *Context::current().state().mesh;
+    state.vertexArrayBindCount = 0;
+    state.vertexBufferBindCount = 0;
+}
+
 Mesh::Mesh(const MeshPrimitive primitive): _primitive{primitive}, _flags{ObjectFlag::DeleteOnDestruction} {
     (this->*Context::current().state().mesh->createImplementation)(true);
 }
@@ -249,6 +320,9 @@ Mesh::Mesh(Mesh&& other) noexcept: _id(other._id), _primitive(other._primitive),
     #ifndef MAGNUM_TARGET_GLES2
     _indexStart(other._indexStart), _indexEnd(other._indexEnd),
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    _sharedVertexLayout{other._sharedVertexLayout},
+    #endif
     _indexOffset(other._indexOffset), _indexType(other._indexType), _indexBuffer{std::move(other._indexBuffer)}
 {
     if(_constructed || other._constructed)
@@ -272,6 +346,9 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     swap(_indexStart, other._indexStart);
     swap(_indexEnd, other._indexEnd);
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_sharedVertexLayout, other._sharedVertexLayout);
+    #endif
     swap(_indexOffset, other._indexOffset);
     swap(_indexType, other._indexType);
     swap(_indexBuffer, other._indexBuffer);
@@ -343,7 +420,7 @@ Mesh& Mesh::addVertexBufferInstanced(Buffer& buffer, const UnsignedInt divisor,
         GLenum(attribute.dataType()),
         attribute.kind(),
         offset,
-        stride,
+        stride ? stride : tightStride(attribute),
         divisor});
     return *this;
 }
@@ -550,12 +627,15 @@ Mesh& Mesh::draw(AbstractShaderProgram& shader, TransformFeedback& xfb, Unsigned
 void Mesh::bindVAOImplementationDefault(GLuint) {}
 
 void Mesh::bindVAOImplementationVAO(const GLuint id) {
+    Implementation::MeshState& state = *Context::current().state().mesh;
+    ++state.vertexArrayBindCount;
+
     #ifndef MAGNUM_TARGET_GLES2
     glBindVertexArray
     #else
     glBindVertexArrayOES
     #endif
-        (Context::current().state().mesh->currentVAO = id);
+        (state.currentVAO = id);
 }
 
 void Mesh::bindVAO() {
@@ -681,6 +761,10 @@ void Mesh::attributePointerInternal(const Buffer& buffer, const GLuint location,
 void Mesh::attributePointerInternal(AttributeLayout&& attribute) {
     CORRADE_ASSERT(attribute.buffer.id(),
         "GL::Mesh::addVertexBuffer(): empty or moved-out Buffer instance was passed", );
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* The vertex layout changed, it has to be looked up again */
+    _sharedVertexLayout = 0;
+    #endif
     (this->*Context::current().state().mesh->attributePointerImplementation)(std::move(attribute));
 }
 
@@ -825,8 +909,10 @@ void Mesh::bindIndexBufferImplementationVAODSA(Buffer& buffer) {
 
 void Mesh::bindImplementationDefault() {
     /* Specify vertex attributes */
-    for(AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes))
+    auto& attributes = *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes);
+    for(AttributeLayout& attribute: attributes)
         vertexAttribPointer(attribute);
+    Context::current().state().mesh->vertexBufferBindCount += attributes.size();
 
     /* Bind index buffer, if the mesh is indexed */
     if(_indexBuffer.id()) _indexBuffer.bindInternal(Buffer::TargetHint::ElementArray);
@@ -836,6 +922,99 @@ void Mesh::bindImplementationVAO() {
     bindVAO();
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void Mesh::bindImplementationSharedVAO() {
+    Implementation::State& state = Context::current().state();
+    std::vector<Implementation::SharedVertexLayout>& layouts = state.mesh->sharedVertexLayouts;
+    const auto& attributes = *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes);
+
+    /* Look up the layout if not done already. This is done only once for
+       each mesh (or again when it gets more attributes), so a linear search
+       through the (usually rather small) list of layouts is fine. */
+    if(!_sharedVertexLayout) {
+        /* Sort the formats by location so the order in which the attributes
+           were added doesn't matter. If the same location is specified more
+           than once, the last one wins, same as with glVertexAttribPointer(). */
+        std::vector<Implementation::SharedVertexLayout::Attribute> formats;
+        formats.reserve(attributes.size());
+        for(auto it = attributes.rbegin(); it != attributes.rend(); ++it)
+            formats.push_back({it->location, it->size, it->type, it->kind, it->divisor});
+        std::stable_sort(formats.begin(), formats.end(), [](const Implementation::SharedVertexLayout::Attribute& a, const Implementation::SharedVertexLayout::Attribute& b) {
+            return a.location < b.location;
+        });
+        formats.erase(std::unique(formats.begin(), formats.end(), [](const Implementation::SharedVertexLayout::Attribute& a, const Implementation::SharedVertexLayout::Attribute& b) {
+            return a.location == b.location;
+        }), formats.end());
+
+        auto found = std::find_if(layouts.begin(), layouts.end(), [&formats](const Implementation::SharedVertexLayout& layout) {
+            return formats.size() == layout.attributes.size() && std::equal(formats.begin(), formats.end(), layout.attributes.begin(), [](const Implementation::SharedVertexLayout::Attribute& a, const Implementation::SharedVertexLayout::Attribute& b) {
+                return a.location == b.location && a.size == b.size && a.type == b.type && a.kind == b.kind && a.divisor == b.divisor;
+            });
+        });
+
+        /* Not found, create a new VAO with given formats. Every attribute
+           uses its own binding point with zero relative offset, which means
+           meshes with different strides or interleaving can still share the
+           same VAO. */
+        if(found == layouts.end()) {
+            Implementation::SharedVertexLayout layout;
+            glGenVertexArrays(1, &layout.id);
+            bindVAOImplementationVAO(layout.id);
+            layout.indexBuffer = 0;
+            state.buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = 0;
+
+            for(const Implementation::SharedVertexLayout::Attribute& attribute: formats) {
+                glEnableVertexAttribArray(attribute.location);
+                if(attribute.kind == DynamicAttribute::Kind::Integral)
+                    glVertexAttribIFormat(attribute.location, attribute.size, attribute.type, 0);
+                #ifndef MAGNUM_TARGET_GLES
+                else if(attribute.kind == DynamicAttribute::Kind::Long)
+                    glVertexAttribLFormat(attribute.location, attribute.size, attribute.type, 0);
+                #endif
+                else
+                    glVertexAttribFormat(attribute.location, attribute.size, attribute.type, attribute.kind == DynamicAttribute::Kind::GenericNormalized, 0);
+                glVertexAttribBinding(attribute.location, attribute.location);
+                if(attribute.divisor)
+                    glVertexBindingDivisor(attribute.location, attribute.divisor);
+            }
+
+            layout.bindings.resize(formats.empty() ? 0 : formats.back().location + 1,
+                Implementation::SharedVertexLayout::Binding{Implementation::State::DisengagedBinding, 0, 0});
+            layout.attributes = std::move(formats);
+            layouts.push_back(std::move(layout));
+            found = layouts.end() - 1;
+        }
+
+        _sharedVertexLayout = UnsignedInt(found - layouts.begin()) + 1;
+    }
+
+    Implementation::SharedVertexLayout& layout = layouts[_sharedVertexLayout - 1];
+
+    /* Bind the VAO. The element array binding is a VAO state, so update the
+       buffer state tracker to what's attached to this VAO. */
+    if(state.mesh->currentVAO != layout.id) {
+        bindVAOImplementationVAO(layout.id);
+        state.buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = layout.indexBuffer;
+    }
+
+    /* Rebind only buffers that differ from what's bound already */
+    for(const AttributeLayout& attribute: attributes) {
+        Implementation::SharedVertexLayout::Binding& binding = layout.bindings[attribute.location];
+        if(binding.buffer == attribute.buffer.id() && binding.offset == attribute.offset && binding.stride == attribute.stride)
+            continue;
+
+        glBindVertexBuffer(attribute.location, attribute.buffer.id(), attribute.offset, attribute.stride);
+        binding = {attribute.buffer.id(), attribute.offset, attribute.stride};
+        ++state.mesh->vertexBufferBindCount;
+    }
+
+    if(_indexBuffer.id() && layout.indexBuffer != _indexBuffer.id()) {
+        _indexBuffer.bindInternal(Buffer::TargetHint::ElementArray);
+        layout.indexBuffer = _indexBuffer.id();
+    }
+}
+#endif
+
 void Mesh::unbindImplementationDefault() {
     for(const AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes)) {
         glDisableVertexAttribArray(attribute.location);
@@ -295,6 +295,32 @@ documentation of @ref addVertexBuffer() for more information.
 If index range is specified in @ref setIndexBuffer(), range-based version of
 drawing commands are used on desktop OpenGL and OpenGL ES 3.0. See also
 @ref draw() for more information.
+
+@subsection GL-Mesh-shared-vertex-layouts Shared vertex layouts
+
+With a VAO per mesh, switching between meshes always means binding a
+different VAO, which can be expensive if thousands of meshes are drawn every
+frame. If the `--magnum-shared-vertex-layouts on`
+@ref GL-Context-command-line "command-line option" is passed and
+@gl_extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or OpenGL ES 3.1
+is available, meshes don't create VAOs on their own. Instead, a single VAO is
+created for each distinct set of vertex attribute formats (location, component
+count, type, normalization and instance divisor) on first draw and shared by
+all meshes with the same formats. Switching between such meshes then only
+rebinds the vertex and index buffers that actually differ, using
+@fn_gl_keyword{BindVertexBuffer}. Buffer offsets and strides don't affect the
+sharing, so for example meshes suballocated from a single buffer can share
+the VAO and need no rebinds at all.
+
+Use @ref hasSharedVertexLayouts() to check whether the layouts are shared in
+current context and @ref sharedVertexLayoutCount() to see how many distinct
+layouts were created so far. The @ref vertexArrayBindCount() and
+@ref vertexBufferBindCount() counters can be used to measure the effect,
+for example per frame with @ref resetBindCounters() called at the start of
+each frame.
+
+With shared vertex layouts, @ref id() is always @cpp 0 @ce, meshes can't be
+labeled and @ref wrap() can't be used, same as when VAOs are not available.
  */
 class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
     friend MeshView;
@@ -362,6 +388,62 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
         static Int maxElementsVertices();
         #endif
 
+        /**
+         * @brief Whether vertex layouts are shared among meshes
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if the `--magnum-shared-vertex-layouts on`
+         * @ref GL-Context-command-line "command-line option" is set and
+         * @gl_extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or
+         * OpenGL ES 3.1 is available, @cpp false @ce otherwise. See
+         * @ref GL-Mesh-shared-vertex-layouts for more information.
+         */
+        static bool hasSharedVertexLayouts();
+
+        /**
+         * @brief Count of shared vertex layouts
+         * @m_since_latest
+         *
+         * Count of distinct vertex layouts and thus VAOs created so far in
+         * current context. Always @cpp 0 @ce if
+         * @ref hasSharedVertexLayouts() is @cpp false @ce.
+         */
+        static UnsignedInt sharedVertexLayoutCount();
+
+        /**
+         * @brief Count of vertex array binds
+         * @m_since_latest
+         *
+         * Count of @fn_gl{BindVertexArray} calls done by the engine in
+         * current context since the context creation or the last call to
+         * @ref resetBindCounters().
+         * @see @ref vertexBufferBindCount()
+         */
+        static UnsignedLong vertexArrayBindCount();
+
+        /**
+         * @brief Count of vertex buffer binds
+         * @m_since_latest
+         *
+         * Count of vertex buffer bindings changed on draw in current context
+         * since the context creation or the last call to
+         * @ref resetBindCounters(). With @ref GL-Mesh-shared-vertex-layouts "shared vertex layouts"
+         * it's the count of @fn_gl{BindVertexBuffer} calls, if VAOs are not
+         * available it's the count of attributes specified on each draw,
+         * otherwise it's always @cpp 0 @ce.
+         * @see @ref vertexArrayBindCount()
+         */
+        static UnsignedLong vertexBufferBindCount();
+
+        /**
+         * @brief Reset bind counters
+         * @m_since_latest
+         *
+         * Resets both @ref vertexArrayBindCount() and
+         * @ref vertexBufferBindCount() to zero.
+         */
+        static void resetBindCounters();
+
         /**
          * @brief Wrap existing OpenGL vertex array object
          * @param id            OpenGL vertex array ID
@@ -768,7 +850,9 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
          * but with the possibility to fully specify the attribute properties
          * at runtime, including base type and location. See
          * @ref GL-Mesh-configuration-dynamic "class documentation" for usage
-         * example.
+         * example. If @p stride is @cpp 0 @ce, the attribute is treated as
+         * tightly packed and the stride is calculated from its component
+         * count and data type.
          */
         Mesh& addVertexBuffer(Buffer& buffer, GLintptr offset, GLsizei stride, const DynamicAttribute& attribute) {
             return addVertexBufferInstanced(buffer, 0, offset, stride, attribute);
@@ -1162,6 +1246,9 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
 
         void MAGNUM_GL_LOCAL bindImplementationDefault();
         void MAGNUM_GL_LOCAL bindImplementationVAO();
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        void MAGNUM_GL_LOCAL bindImplementationSharedVAO();
+        #endif
 
         void MAGNUM_GL_LOCAL unbindImplementationDefault();
         void MAGNUM_GL_LOCAL unbindImplementationVAO();
@@ -1197,6 +1284,11 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
         #ifndef MAGNUM_TARGET_GLES2
         UnsignedInt _indexStart{}, _indexEnd{};
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Index of the shared vertex layout plus one, zero if not resolved
+           yet. Used only with shared vertex layouts. */
+        UnsignedInt _sharedVertexLayout{};
+        #endif
         GLintptr _indexOffset{};
         MeshIndexType _indexType{};
         Buffer _indexBuffer{NoCreate};
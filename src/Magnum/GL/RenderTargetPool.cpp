@@ -0,0 +1,437 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/Implementation/textureStorageSize.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+struct Key {
+    Vector2i size;
+    GLenum format;
+    Int samples;
+    bool renderbuffer;
+};
+
+bool operator==(const Key& a, const Key& b) {
+    return a.size == b.size && a.format == b.format && a.samples == b.samples && a.renderbuffer == b.renderbuffer;
+}
+
+/* Size of a renderbuffer pixel in bytes. Consistently with texture memory
+   accounting, unsized formats are assumed to have eight bits per component
+   and 24-bit depth is assumed to be padded to 32 bits. */
+UnsignedInt renderbufferFormatSize(const RenderbufferFormat format) {
+    switch(format) {
+        #ifndef MAGNUM_TARGET_GLES
+        case RenderbufferFormat::Red:
+        case RenderbufferFormat::StencilIndex:
+        #endif
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case RenderbufferFormat::R8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case RenderbufferFormat::R8UI:
+        case RenderbufferFormat::R8I:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case RenderbufferFormat::StencilIndex1:
+        case RenderbufferFormat::StencilIndex4:
+        #endif
+        case RenderbufferFormat::StencilIndex8:
+            return 1;
+
+        #ifndef MAGNUM_TARGET_GLES
+        case RenderbufferFormat::RG:
+        case RenderbufferFormat::R16:
+        case RenderbufferFormat::StencilIndex16:
+        #endif
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case RenderbufferFormat::RG8:
+        case RenderbufferFormat::R16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case RenderbufferFormat::RG8UI:
+        case RenderbufferFormat::RG8I:
+        case RenderbufferFormat::R16UI:
+        case RenderbufferFormat::R16I:
+        #endif
+        case RenderbufferFormat::RGB565:
+        case RenderbufferFormat::RGBA4:
+        case RenderbufferFormat::RGB5A1:
+        case RenderbufferFormat::DepthComponent16:
+            return 2;
+
+        #ifndef MAGNUM_TARGET_GLES
+        case RenderbufferFormat::RGBA:
+        case RenderbufferFormat::RG16:
+        case RenderbufferFormat::R11FG11FB10F:
+        case RenderbufferFormat::DepthComponent:
+        #endif
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case RenderbufferFormat::RGBA8:
+        case RenderbufferFormat::RG16F:
+        case RenderbufferFormat::DepthComponent24:
+        case RenderbufferFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case RenderbufferFormat::RGBA8UI:
+        case RenderbufferFormat::RGBA8I:
+        case RenderbufferFormat::RG16UI:
+        case RenderbufferFormat::RG16I:
+        case RenderbufferFormat::R32UI:
+        case RenderbufferFormat::R32I:
+        case RenderbufferFormat::R32F:
+        case RenderbufferFormat::RGB10A2:
+        case RenderbufferFormat::RGB10A2UI:
+        case RenderbufferFormat::DepthComponent32F:
+        #endif
+        case RenderbufferFormat::SRGB8Alpha8:
+        #ifndef MAGNUM_TARGET_WEBGL
+        case RenderbufferFormat::DepthComponent32:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || (defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case RenderbufferFormat::DepthStencil:
+        #endif
+            return 4;
+
+        #ifndef MAGNUM_TARGET_GLES
+        case RenderbufferFormat::RGB16:
+            return 6;
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        case RenderbufferFormat::RGBA16:
+        #endif
+        case RenderbufferFormat::RGBA16F:
+        #ifndef MAGNUM_TARGET_GLES2
+        case RenderbufferFormat::RGBA16UI:
+        case RenderbufferFormat::RGBA16I:
+        case RenderbufferFormat::RG32UI:
+        case RenderbufferFormat::RG32I:
+        case RenderbufferFormat::RG32F:
+        /* 32-bit float depth, 8-bit stencil and 24 bits of padding */
+        case RenderbufferFormat::Depth32FStencil8:
+        #endif
+            return 8;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case RenderbufferFormat::RGBA32UI:
+        case RenderbufferFormat::RGBA32I:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+        case RenderbufferFormat::RGBA32F:
+        #endif
+            return 16;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+std::size_t targetSize(const Key& key) {
+    const std::size_t size = key.renderbuffer ?
+        std::size_t(key.size.product())*renderbufferFormatSize(RenderbufferFormat(key.format)) :
+        Implementation::textureStorageSize(TextureFormat(key.format), 1, {key.size, 1}, 2);
+    return size*Math::max(key.samples, 1);
+}
+
+}
+
+struct RenderTargetPool::State {
+    struct Request {
+        Key key;
+        UnsignedInt firstPass, lastPass;
+        std::size_t target;
+    };
+
+    struct Target {
+        Key key;
+        std::size_t size;
+        UnsignedLong lastUsedFrame;
+        bool claimed;
+        Containers::Pointer<Texture2D> texture;
+        Containers::Pointer<Renderbuffer> renderbuffer;
+    };
+
+    struct CachedFramebuffer {
+        std::vector<std::pair<GLenum, Target*>> attachments;
+        Containers::Pointer<Framebuffer> framebuffer;
+    };
+
+    explicit State(UnsignedInt maxIdleFrames): maxIdleFrames{maxIdleFrames} {}
+
+    UnsignedInt maxIdleFrames;
+    UnsignedLong frame{};
+    bool allocated{};
+    std::vector<Request> requests;
+    /* Pointers so the targets stay at the same address for the framebuffer
+       cache when the vector reallocates */
+    std::vector<Containers::Pointer<Target>> targets;
+    std::vector<CachedFramebuffer> framebuffers;
+    std::size_t frameMemory{}, allocatedMemory{}, peakMemory{};
+};
+
+RenderTargetPool::RenderTargetPool(const UnsignedInt maxIdleFrames): _state{new State{maxIdleFrames}} {}
+
+RenderTargetPool::RenderTargetPool(RenderTargetPool&&) noexcept = default;
+
+RenderTargetPool::~RenderTargetPool() = default;
+
+RenderTargetPool& RenderTargetPool::operator=(RenderTargetPool&&) noexcept = default;
+
+UnsignedInt RenderTargetPool::maxIdleFrames() const { return _state->maxIdleFrames; }
+
+UnsignedInt RenderTargetPool::addTexture(const Vector2i& size, const TextureFormat format, const UnsignedInt firstPass, const UnsignedInt lastPass) {
+    CORRADE_ASSERT(!_state->allocated,
+        "GL::RenderTargetPool::addTexture(): targets already allocated for this frame", {});
+    CORRADE_ASSERT(firstPass <= lastPass,
+        "GL::RenderTargetPool::addTexture(): first pass" << firstPass << "is after last pass" << lastPass, {});
+    _state->requests.push_back({{size, GLenum(format), 0, false}, firstPass, lastPass, 0});
+    return _state->requests.size() - 1;
+}
+
+UnsignedInt RenderTargetPool::addRenderbuffer(const Vector2i& size, const RenderbufferFormat format, const Int samples, const UnsignedInt firstPass, const UnsignedInt lastPass) {
+    CORRADE_ASSERT(!_state->allocated,
+        "GL::RenderTargetPool::addRenderbuffer(): targets already allocated for this frame", {});
+    CORRADE_ASSERT(firstPass <= lastPass,
+        "GL::RenderTargetPool::addRenderbuffer(): first pass" << firstPass << "is after last pass" << lastPass, {});
+    #if defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    CORRADE_ASSERT(samples <= 1,
+        "GL::RenderTargetPool::addRenderbuffer(): multisampled renderbuffers are not available in WebGL 1.0", {});
+    #endif
+    /* 0 and 1 samples are the same thing, make them share targets */
+    _state->requests.push_back({{size, GLenum(format), samples > 1 ? samples : 0, true}, firstPass, lastPass, 0});
+    return _state->requests.size() - 1;
+}
+
+std::size_t RenderTargetPool::requestCount() const { return _state->requests.size(); }
+
+RenderTargetPool& RenderTargetPool::allocate() {
+    CORRADE_ASSERT(!_state->allocated,
+        "GL::RenderTargetPool::allocate(): targets already allocated for this frame", *this);
+
+    /* Go through the requests in order of their first pass. The sort is
+       stable so the assignment is deterministic for a given request
+       sequence. */
+    std::vector<UnsignedInt> order(_state->requests.size());
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](UnsignedInt a, UnsignedInt b) {
+        return _state->requests[a].firstPass < _state->requests[b].firstPass;
+    });
+
+    /* Greedy interval coloring -- put each request into the first slot of
+       the same key that's free by the time it starts, or open a new slot.
+       With intervals sorted by start this gives the minimal slot count for
+       each key. */
+    struct Slot {
+        Key key;
+        UnsignedInt lastPass;
+    };
+    std::vector<Slot> slots;
+    std::vector<std::size_t> requestSlots(_state->requests.size());
+    for(const UnsignedInt i: order) {
+        const State::Request& request = _state->requests[i];
+        std::size_t slot = 0;
+        for(; slot != slots.size(); ++slot)
+            if(slots[slot].key == request.key && slots[slot].lastPass < request.firstPass) break;
+        if(slot == slots.size())
+            slots.push_back({request.key, request.lastPass});
+        else slots[slot].lastPass = request.lastPass;
+        requestSlots[i] = slot;
+    }
+
+    /* Match the slots to physical targets kept from previous frames, in
+       order, so the same slot gets the same target every frame if the
+       requests don't change */
+    std::vector<std::size_t> slotTargets(slots.size());
+    _state->frameMemory = 0;
+    for(std::size_t slot = 0; slot != slots.size(); ++slot) {
+        const Key& key = slots[slot].key;
+        std::size_t target = 0;
+        for(; target != _state->targets.size(); ++target)
+            if(!_state->targets[target]->claimed && _state->targets[target]->key == key) break;
+
+        if(target == _state->targets.size()) {
+            const std::size_t size = targetSize(key);
+            _state->targets.emplace_back(new State::Target{key, size, 0, false, {}, {}});
+            _state->allocatedMemory += size;
+        }
+
+        State::Target& t = *_state->targets[target];
+        t.claimed = true;
+        t.lastUsedFrame = _state->frame;
+        _state->frameMemory += t.size;
+        slotTargets[slot] = target;
+    }
+
+    for(std::size_t i = 0; i != _state->requests.size(); ++i)
+        _state->requests[i].target = slotTargets[requestSlots[i]];
+
+    _state->peakMemory = Math::max(_state->peakMemory, _state->allocatedMemory);
+    _state->allocated = true;
+    return *this;
+}
+
+std::size_t RenderTargetPool::target(const UnsignedInt id) const {
+    CORRADE_ASSERT(_state->allocated,
+        "GL::RenderTargetPool::target(): targets not allocated for this frame", {});
+    CORRADE_ASSERT(id < _state->requests.size(),
+        "GL::RenderTargetPool::target(): index" << id << "out of range for" << _state->requests.size() << "requests", {});
+    return _state->requests[id].target;
+}
+
+std::size_t RenderTargetPool::targetCount() const { return _state->targets.size(); }
+
+Texture2D& RenderTargetPool::texture(const UnsignedInt id) {
+    CORRADE_ASSERT(_state->allocated,
+        "GL::RenderTargetPool::texture(): targets not allocated for this frame", *static_cast<Texture2D*>(nullptr));
+    CORRADE_ASSERT(id < _state->requests.size(),
+        "GL::RenderTargetPool::texture(): index" << id << "out of range for" << _state->requests.size() << "requests", *static_cast<Texture2D*>(nullptr));
+    State::Target& t = *_state->targets[_state->requests[id].target];
+    CORRADE_ASSERT(!t.key.renderbuffer,
+        "GL::RenderTargetPool::texture(): request" << id << "is a renderbuffer", *static_cast<Texture2D*>(nullptr));
+
+    if(!t.texture) {
+        t.texture.reset(new Texture2D);
+        t.texture->setMinificationFilter(SamplerFilter::Linear)
+            .setMagnificationFilter(SamplerFilter::Linear)
+            .setWrapping(SamplerWrapping::ClampToEdge)
+            .setStorage(1, TextureFormat(t.key.format), t.key.size);
+    }
+
+    return *t.texture;
+}
+
+Renderbuffer& RenderTargetPool::renderbuffer(const UnsignedInt id) {
+    CORRADE_ASSERT(_state->allocated,
+        "GL::RenderTargetPool::renderbuffer(): targets not allocated for this frame", *static_cast<Renderbuffer*>(nullptr));
+    CORRADE_ASSERT(id < _state->requests.size(),
+        "GL::RenderTargetPool::renderbuffer(): index" << id << "out of range for" << _state->requests.size() << "requests", *static_cast<Renderbuffer*>(nullptr));
+    State::Target& t = *_state->targets[_state->requests[id].target];
+    CORRADE_ASSERT(t.key.renderbuffer,
+        "GL::RenderTargetPool::renderbuffer(): request" << id << "is a texture", *static_cast<Renderbuffer*>(nullptr));
+
+    if(!t.renderbuffer) {
+        t.renderbuffer.reset(new Renderbuffer);
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        if(t.key.samples)
+            t.renderbuffer->setStorageMultisample(t.key.samples, RenderbufferFormat(t.key.format), t.key.size);
+        else
+        #endif
+        {
+            t.renderbuffer->setStorage(RenderbufferFormat(t.key.format), t.key.size);
+        }
+    }
+
+    return *t.renderbuffer;
+}
+
+Framebuffer& RenderTargetPool::framebuffer(const std::initializer_list<std::pair<Framebuffer::BufferAttachment, UnsignedInt>> attachments) {
+    CORRADE_ASSERT(_state->allocated,
+        "GL::RenderTargetPool::framebuffer(): targets not allocated for this frame", *static_cast<Framebuffer*>(nullptr));
+    CORRADE_ASSERT(attachments.size(),
+        "GL::RenderTargetPool::framebuffer(): no attachments given", *static_cast<Framebuffer*>(nullptr));
+
+    std::vector<std::pair<GLenum, State::Target*>> key;
+    key.reserve(attachments.size());
+    for(const std::pair<Framebuffer::BufferAttachment, UnsignedInt>& attachment: attachments) {
+        CORRADE_ASSERT(attachment.second < _state->requests.size(),
+            "GL::RenderTargetPool::framebuffer(): index" << attachment.second << "out of range for" << _state->requests.size() << "requests", *static_cast<Framebuffer*>(nullptr));
+        key.emplace_back(GLenum(attachment.first), _state->targets[_state->requests[attachment.second].target].get());
+    }
+
+    for(State::CachedFramebuffer& cached: _state->framebuffers)
+        if(cached.attachments == key) return *cached.framebuffer;
+
+    Containers::Pointer<Framebuffer> framebuffer{new Framebuffer{{{}, key.front().second->key.size}}};
+    for(const std::pair<Framebuffer::BufferAttachment, UnsignedInt>& attachment: attachments) {
+        if(_state->targets[_state->requests[attachment.second].target]->key.renderbuffer)
+            framebuffer->attachRenderbuffer(attachment.first, renderbuffer(attachment.second));
+        else
+            framebuffer->attachTexture(attachment.first, texture(attachment.second), 0);
+    }
+
+    _state->framebuffers.push_back({std::move(key), std::move(framebuffer)});
+    return *_state->framebuffers.back().framebuffer;
+}
+
+std::size_t RenderTargetPool::requestedMemory() const {
+    std::size_t size = 0;
+    for(const State::Request& request: _state->requests)
+        size += targetSize(request.key);
+    return size;
+}
+
+std::size_t RenderTargetPool::frameMemory() const {
+    return _state->allocated ? _state->frameMemory : 0;
+}
+
+std::size_t RenderTargetPool::allocatedMemory() const { return _state->allocatedMemory; }
+
+std::size_t RenderTargetPool::peakMemory() const { return _state->peakMemory; }
+
+UnsignedLong RenderTargetPool::frame() const { return _state->frame; }
+
+RenderTargetPool& RenderTargetPool::nextFrame() {
+    /* Targets that weren't used for more than maxIdleFrames frames,
+       including this one, go away together with all framebuffers that
+       reference them */
+    auto stale = [&](const State::Target* t) {
+        return _state->frame - t->lastUsedFrame > _state->maxIdleFrames;
+    };
+    _state->framebuffers.erase(std::remove_if(_state->framebuffers.begin(), _state->framebuffers.end(), [&](const State::CachedFramebuffer& cached) {
+        for(const std::pair<GLenum, State::Target*>& attachment: cached.attachments)
+            if(stale(attachment.second)) return true;
+        return false;
+    }), _state->framebuffers.end());
+    _state->targets.erase(std::remove_if(_state->targets.begin(), _state->targets.end(), [&](const Containers::Pointer<State::Target>& t) {
+        if(!stale(t.get())) return false;
+        _state->allocatedMemory -= t->size;
+        return true;
+    }), _state->targets.end());
+
+    for(Containers::Pointer<State::Target>& t: _state->targets)
+        t->claimed = false;
+    _state->requests.clear();
+    _state->allocated = false;
+    _state->frameMemory = 0;
+    ++_state->frame;
+    return *this;
+}
+
+}}
@@ -0,0 +1,263 @@
+#ifndef Magnum_GL_RenderTargetPool_h
+#define Magnum_GL_RenderTargetPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::RenderTargetPool
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Pool of transient render targets
+@m_since_latest
+
+Hands out textures and renderbuffers used as intermediate render targets
+during a frame and reuses them both inside the frame and across frames. Each
+request declares the range of passes in which the target is alive; two
+requests with the same size, format and sample count whose pass ranges don't
+overlap are aliased to the same physical target:
+
+@code{.cpp}
+GL::RenderTargetPool pool;
+
+// every frame
+UnsignedInt depth = pool.addRenderbuffer(size, GL::RenderbufferFormat::DepthComponent24, 0, 0, 2);
+UnsignedInt hdr = pool.addTexture(size, GL::TextureFormat::RGBA16F, 0, 1);
+UnsignedInt bloom = pool.addTexture(size, GL::TextureFormat::RGBA16F, 1, 1);
+UnsignedInt tonemapped = pool.addTexture(size, GL::TextureFormat::RGBA16F, 2, 2);
+pool.allocate();
+
+GL::Framebuffer& scene = pool.framebuffer({
+    {GL::Framebuffer::ColorAttachment{0}, hdr},
+    {GL::Framebuffer::BufferAttachment::Depth, depth}});
+// ... render passes, pool.texture(hdr), pool.texture(bloom) ...
+
+pool.nextFrame();
+@endcode
+
+In the above, @cpp tonemapped @ce is alive only after both @cpp hdr @ce and
+@cpp bloom @ce are done with, so it reuses one of their textures and only two
+textures are allocated instead of three. A pass range is inclusive --- a
+target written in the same pass in which another one is last read is never
+aliased with it.
+
+@section GL-RenderTargetPool-lifetime Target lifetime
+
+Physical targets that weren't needed in a frame are kept around for
+@ref maxIdleFrames() frames in case the next frames need them again and are
+deleted after that. Framebuffers returned from @ref framebuffer() are cached
+for the given attachment combination and deleted together with any of the
+targets they reference.
+
+The planning and bookkeeping in @ref addTexture(), @ref addRenderbuffer(),
+@ref allocate() and @ref nextFrame() doesn't touch OpenGL at all, the actual
+GL objects are created lazily on first access through @ref texture(),
+@ref renderbuffer() or @ref framebuffer(). Memory numbers reported by
+@ref requestedMemory(), @ref frameMemory(), @ref allocatedMemory() and
+@ref peakMemory() are estimated from the format and size the same way as
+@ref MemoryAccounting does for textures, with an equivalent explicit mapping
+for renderbuffer formats, and so are available without a GL context as well.
+
+@requires_gles30 Multisampled renderbuffers are not available in WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT RenderTargetPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxIdleFrames     How many frames to keep targets that
+         *      weren't used
+         *
+         * Doesn't create any OpenGL objects.
+         */
+        explicit RenderTargetPool(UnsignedInt maxIdleFrames = 2);
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool(const RenderTargetPool&) = delete;
+
+        /** @brief Move constructor */
+        RenderTargetPool(RenderTargetPool&&) noexcept;
+
+        ~RenderTargetPool();
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        /** @brief Move assignment */
+        RenderTargetPool& operator=(RenderTargetPool&&) noexcept;
+
+        /** @brief How many frames to keep targets that weren't used */
+        UnsignedInt maxIdleFrames() const;
+
+        /**
+         * @brief Request a texture
+         * @param size          Texture size
+         * @param format        Internal format
+         * @param firstPass     First pass in which the texture is used
+         * @param lastPass      Last pass in which the texture is used
+         * @return Request ID, counted from @cpp 0 @ce every frame
+         *
+         * The texture has a single mip level. Expects that
+         * @ref allocate() wasn't called yet in this frame and that
+         * @p firstPass is not larger than @p lastPass.
+         */
+        UnsignedInt addTexture(const Vector2i& size, TextureFormat format, UnsignedInt firstPass, UnsignedInt lastPass);
+
+        /**
+         * @brief Request a renderbuffer
+         * @param size          Renderbuffer size
+         * @param format        Internal format
+         * @param samples       Sample count. Values of @cpp 0 @ce and
+         *      @cpp 1 @ce mean a non-multisampled renderbuffer.
+         * @param firstPass     First pass in which the renderbuffer is used
+         * @param lastPass      Last pass in which the renderbuffer is used
+         * @return Request ID, counted from @cpp 0 @ce every frame
+         *
+         * Expects that @ref allocate() wasn't called yet in this frame and
+         * that @p firstPass is not larger than @p lastPass.
+         */
+        UnsignedInt addRenderbuffer(const Vector2i& size, RenderbufferFormat format, Int samples, UnsignedInt firstPass, UnsignedInt lastPass);
+
+        /** @brief Count of requests in this frame */
+        std::size_t requestCount() const;
+
+        /**
+         * @brief Assign physical targets to requests
+         *
+         * Aliases requests with non-overlapping pass ranges and matching
+         * size, format and sample count, then matches the result to
+         * physical targets kept from previous frames, creating new
+         * bookkeeping entries where needed. Doesn't touch OpenGL. Expects
+         * that it wasn't called yet in this frame.
+         */
+        RenderTargetPool& allocate();
+
+        /**
+         * @brief Physical target index of a request
+         *
+         * Two requests with the same index share the same target. Expects
+         * that @ref allocate() was called in this frame and @p id is a
+         * valid request ID.
+         */
+        std::size_t target(UnsignedInt id) const;
+
+        /**
+         * @brief Count of physical targets
+         *
+         * Includes targets that weren't used in this frame but are kept
+         * for later frames.
+         */
+        std::size_t targetCount() const;
+
+        /**
+         * @brief Texture for given request
+         *
+         * Creates the texture on first access. Expects that
+         * @ref allocate() was called in this frame and @p id is a valid
+         * request ID added with @ref addTexture().
+         */
+        Texture2D& texture(UnsignedInt id);
+
+        /**
+         * @brief Renderbuffer for given request
+         *
+         * Creates the renderbuffer on first access. Expects that
+         * @ref allocate() was called in this frame and @p id is a valid
+         * request ID added with @ref addRenderbuffer().
+         */
+        Renderbuffer& renderbuffer(UnsignedInt id);
+
+        /**
+         * @brief Framebuffer with given requests attached
+         *
+         * Returns a framebuffer cached for given combination of attachment
+         * points and physical targets, creating it on first access. The
+         * viewport is set to the size of the first attachment. Expects that
+         * @ref allocate() was called in this frame, @p attachments is not
+         * empty and all IDs in it are valid.
+         */
+        Framebuffer& framebuffer(std::initializer_list<std::pair<Framebuffer::BufferAttachment, UnsignedInt>> attachments);
+
+        /**
+         * @brief Memory requested in this frame
+         *
+         * Sum of sizes of all requests, i.e. the amount of memory that
+         * would be needed without any aliasing.
+         */
+        std::size_t requestedMemory() const;
+
+        /**
+         * @brief Memory used in this frame
+         *
+         * Sum of sizes of physical targets assigned to requests in this
+         * frame. Zero before @ref allocate() is called.
+         */
+        std::size_t frameMemory() const;
+
+        /**
+         * @brief Memory allocated by the pool
+         *
+         * Sum of sizes of all physical targets, including the ones kept
+         * from previous frames.
+         */
+        std::size_t allocatedMemory() const;
+
+        /**
+         * @brief Peak allocated memory
+         *
+         * Maximum of @ref allocatedMemory() since construction.
+         */
+        std::size_t peakMemory() const;
+
+        /** @brief Frame counter */
+        UnsignedLong frame() const;
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Clears all requests, and deletes targets that weren't used in the
+         * last @ref maxIdleFrames() frames together with framebuffers
+         * referencing them.
+         */
+        RenderTargetPool& nextFrame();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
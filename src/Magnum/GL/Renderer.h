@@ -245,6 +245,22 @@ class MAGNUM_GL_EXPORT Renderer {
             #endif
             #endif
 
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Primitive restart with a fixed index. If enabled, index equal
+             * to the maximal value representable by the index type ends the
+             * current primitive and starts a new one. Useful for drawing
+             * triangle strips produced by @ref MeshTools::stripify().
+             * @m_since_latest
+             * @requires_gl43 Extension @gl_extension{ARB,ES3_compatibility}
+             * @requires_gles30 Primitive restart is not available in OpenGL
+             *      ES 2.0.
+             * @requires_gles Always enabled in WebGL 2.0, not available in
+             *      WebGL 1.0.
+             */
+            PrimitiveRestartFixedIndex = GL_PRIMITIVE_RESTART_FIXED_INDEX,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES
             /**
              * Programmable point size. If enabled, the point size is taken
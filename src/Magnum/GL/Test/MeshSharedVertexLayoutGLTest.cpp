@@ -0,0 +1,314 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Version.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+/* The test is executed with MAGNUM_SHARED_VERTEX_LAYOUTS=on in the
+   environment, as the layout sharing is a context-wide option that can't be
+   switched at runtime */
+
+struct MeshSharedVertexLayoutGLTest: OpenGLTester {
+    explicit MeshSharedVertexLayoutGLTest();
+
+    void construct();
+    void share();
+    void shareDifferentFormats();
+    void shareIndexed();
+    void dynamicAttributeZeroStride();
+    void bufferDeleted();
+
+    private:
+        UnsignedByte drawAndRead(Mesh& mesh);
+
+        Renderbuffer _renderbuffer{NoCreate};
+        Framebuffer _framebuffer{NoCreate};
+};
+
+struct ValueShader: AbstractShaderProgram {
+    typedef Attribute<0, Float> Value;
+
+    explicit ValueShader();
+};
+
+ValueShader::ValueShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert{Version::GL330, Shader::Type::Vertex};
+    Shader frag{Version::GL330, Shader::Type::Fragment};
+    #else
+    Shader vert{Version::GLES300, Shader::Type::Vertex};
+    Shader frag{Version::GLES300, Shader::Type::Fragment};
+    #endif
+
+    vert.addSource(
+        "layout(location = 0) in mediump float value;\n"
+        "out mediump float valueInterpolated;\n"
+        "void main() {\n"
+        "    valueInterpolated = value;\n"
+        "    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "in mediump float valueInterpolated;\n"
+        "out mediump vec4 result;\n"
+        "void main() { result = vec4(valueInterpolated, 0.0, 0.0, 0.0); }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+}
+
+MeshSharedVertexLayoutGLTest::MeshSharedVertexLayoutGLTest() {
+    addTests({&MeshSharedVertexLayoutGLTest::construct,
+              &MeshSharedVertexLayoutGLTest::share,
+              &MeshSharedVertexLayoutGLTest::shareDifferentFormats,
+              &MeshSharedVertexLayoutGLTest::shareIndexed,
+              &MeshSharedVertexLayoutGLTest::dynamicAttributeZeroStride,
+              &MeshSharedVertexLayoutGLTest::bufferDeleted});
+
+    if(Mesh::hasSharedVertexLayouts()) {
+        _renderbuffer = Renderbuffer{};
+        _renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i{1});
+        _framebuffer = Framebuffer{{{}, Vector2i{1}}};
+        _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, _renderbuffer);
+    }
+}
+
+UnsignedByte MeshSharedVertexLayoutGLTest::drawAndRead(Mesh& mesh) {
+    _framebuffer.bind();
+    mesh.draw(ValueShader{});
+    return Containers::arrayCast<UnsignedByte>(_framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data())[0];
+}
+
+#define SKIP_IF_NOT_SHARED()                                                \
+    if(!Mesh::hasSharedVertexLayouts())                                     \
+        CORRADE_SKIP("Shared vertex layouts are not enabled or not supported.");
+
+void MeshSharedVertexLayoutGLTest::construct() {
+    SKIP_IF_NOT_SHARED()
+
+    const Float data = Math::unpack<Float, UnsignedByte>(96);
+    Buffer buffer;
+    buffer.setData({&data, 1});
+
+    /* No VAO is created for the mesh itself */
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .addVertexBuffer(buffer, 0, ValueShader::Value{});
+    CORRADE_COMPARE(mesh.id(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(drawAndRead(mesh), 96);
+    CORRADE_VERIFY(Mesh::sharedVertexLayoutCount() >= 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshSharedVertexLayoutGLTest::share() {
+    SKIP_IF_NOT_SHARED()
+
+    /* Different buffers, offsets and strides, but the same format */
+    const Float dataA[]{0.0f, Math::unpack<Float, UnsignedByte>(96)};
+    const Float dataB[]{Math::unpack<Float, UnsignedByte>(157), 0.0f, 0.0f};
+    Buffer bufferA, bufferB;
+    bufferA.setData(dataA);
+    bufferB.setData(dataB);
+
+    Mesh a{MeshPrimitive::Points};
+    a.setCount(1)
+        .addVertexBuffer(bufferA, 4, ValueShader::Value{});
+    Mesh b{MeshPrimitive::Points};
+    b.setCount(1)
+        .addVertexBuffer(bufferB, 0, ValueShader::Value{}, 8);
+
+    CORRADE_COMPARE(drawAndRead(a), 96);
+    const UnsignedInt layoutCount = Mesh::sharedVertexLayoutCount();
+
+    /* Drawing the other mesh doesn't need any new VAO, just a buffer
+       rebind */
+    Mesh::resetBindCounters();
+    CORRADE_COMPARE(drawAndRead(b), 157);
+    CORRADE_COMPARE(Mesh::sharedVertexLayoutCount(), layoutCount);
+    CORRADE_COMPARE(Mesh::vertexArrayBindCount(), 0);
+    CORRADE_COMPARE(Mesh::vertexBufferBindCount(), 1);
+
+    /* Drawing the same mesh again doesn't rebind anything */
+    CORRADE_COMPARE(drawAndRead(b), 157);
+    CORRADE_COMPARE(Mesh::vertexArrayBindCount(), 0);
+    CORRADE_COMPARE(Mesh::vertexBufferBindCount(), 1);
+
+    CORRADE_COMPARE(drawAndRead(a), 96);
+    CORRADE_COMPARE(Mesh::vertexArrayBindCount(), 0);
+    CORRADE_COMPARE(Mesh::vertexBufferBindCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshSharedVertexLayoutGLTest::shareDifferentFormats() {
+    SKIP_IF_NOT_SHARED()
+
+    const Float floatData = Math::unpack<Float, UnsignedByte>(96);
+    const Vector2 vector2Data{Math::unpack<Float, UnsignedByte>(157), 0.0f};
+    const UnsignedByte normalizedData[]{35, 0, 0, 0};
+    Buffer floatBuffer, vector2Buffer, normalizedBuffer;
+    floatBuffer.setData({&floatData, 1});
+    vector2Buffer.setData({&vector2Data, 1});
+    normalizedBuffer.setData(normalizedData);
+
+    Mesh a{MeshPrimitive::Points};
+    a.setCount(1)
+        .addVertexBuffer(floatBuffer, 0, ValueShader::Value{});
+    Mesh b{MeshPrimitive::Points};
+    b.setCount(1)
+        .addVertexBuffer(vector2Buffer, 0, Attribute<0, Vector2>{});
+    Mesh c{MeshPrimitive::Points};
+    c.setCount(1)
+        .addVertexBuffer(normalizedBuffer, 0, ValueShader::Value{ValueShader::Value::DataType::UnsignedByte, ValueShader::Value::DataOption::Normalized}, 3);
+
+    /* The float layout might exist already from previous tests */
+    CORRADE_COMPARE(drawAndRead(a), 96);
+    const UnsignedInt layoutCount = Mesh::sharedVertexLayoutCount();
+
+    /* Different component count and a different type both need a new VAO */
+    Mesh::resetBindCounters();
+    CORRADE_COMPARE(drawAndRead(b), 157);
+    CORRADE_COMPARE(Mesh::sharedVertexLayoutCount(), layoutCount + 1);
+    CORRADE_COMPARE(drawAndRead(c), 35);
+    CORRADE_COMPARE(Mesh::sharedVertexLayoutCount(), layoutCount + 2);
+    CORRADE_COMPARE(Mesh::vertexArrayBindCount(), 2);
+
+    /* Going back to the first binds its VAO again */
+    CORRADE_COMPARE(drawAndRead(a), 96);
+    CORRADE_COMPARE(Mesh::sharedVertexLayoutCount(), layoutCount + 2);
+    CORRADE_COMPARE(Mesh::vertexArrayBindCount(), 3);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshSharedVertexLayoutGLTest::shareIndexed() {
+    SKIP_IF_NOT_SHARED()
+
+    const Float data[]{Math::unpack<Float, UnsignedByte>(96), Math::unpack<Float, UnsignedByte>(157)};
+    Buffer vertices;
+    vertices.setData(data);
+
+    /* Different index buffers attached to the same shared VAO */
+    const UnsignedShort indicesA[]{0};
+    const UnsignedShort indicesB[]{1};
+    Buffer indexBufferA{Buffer::TargetHint::ElementArray}, indexBufferB{Buffer::TargetHint::ElementArray};
+    indexBufferA.setData(indicesA);
+    indexBufferB.setData(indicesB);
+
+    Mesh a{MeshPrimitive::Points};
+    a.setCount(1)
+        .addVertexBuffer(vertices, 0, ValueShader::Value{})
+        .setIndexBuffer(indexBufferA, 0, MeshIndexType::UnsignedShort);
+    Mesh b{MeshPrimitive::Points};
+    b.setCount(1)
+        .addVertexBuffer(vertices, 0, ValueShader::Value{})
+        .setIndexBuffer(indexBufferB, 0, MeshIndexType::UnsignedShort);
+
+    CORRADE_COMPARE(drawAndRead(a), 96);
+    CORRADE_COMPARE(drawAndRead(b), 157);
+    CORRADE_COMPARE(drawAndRead(a), 96);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshSharedVertexLayoutGLTest::dynamicAttributeZeroStride() {
+    SKIP_IF_NOT_SHARED()
+
+    const Float data[]{0.0f, Math::unpack<Float, UnsignedByte>(157)};
+    Buffer vertices;
+    vertices.setData(data);
+
+    const UnsignedShort indices[]{1};
+    Buffer indexBuffer{Buffer::TargetHint::ElementArray};
+    indexBuffer.setData(indices);
+
+    /* Zero stride means tightly packed, so the second vertex has to be read
+       and not the first one */
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .addVertexBuffer(vertices, 0, 0, DynamicAttribute{
+            DynamicAttribute::Kind::Generic, 0,
+            DynamicAttribute::Components::One,
+            DynamicAttribute::DataType::Float})
+        .setIndexBuffer(indexBuffer, 0, MeshIndexType::UnsignedShort);
+
+    CORRADE_COMPARE(drawAndRead(mesh), 157);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void MeshSharedVertexLayoutGLTest::bufferDeleted() {
+    SKIP_IF_NOT_SHARED()
+
+    {
+        const Float data = Math::unpack<Float, UnsignedByte>(96);
+        Buffer buffer;
+        buffer.setData({&data, 1});
+
+        Mesh mesh{MeshPrimitive::Points};
+        mesh.setCount(1)
+            .addVertexBuffer(buffer, 0, ValueShader::Value{});
+        CORRADE_COMPARE(drawAndRead(mesh), 96);
+    }
+
+    /* The new buffer likely gets the same ID as the deleted one, it should
+       be bound again nevertheless */
+    const Float data = Math::unpack<Float, UnsignedByte>(157);
+    Buffer buffer;
+    buffer.setData({&data, 1});
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1)
+        .addVertexBuffer(buffer, 0, ValueShader::Value{});
+    CORRADE_COMPARE(drawAndRead(mesh), 157);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::MeshSharedVertexLayoutGLTest)
@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/RenderTargetPool.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RenderTargetPoolGLTest: OpenGLTester {
+    explicit RenderTargetPoolGLTest();
+
+    void texture();
+    void renderbuffer();
+    void framebuffer();
+};
+
+RenderTargetPoolGLTest::RenderTargetPoolGLTest() {
+    addTests({&RenderTargetPoolGLTest::texture,
+              &RenderTargetPoolGLTest::renderbuffer,
+              &RenderTargetPoolGLTest::framebuffer});
+}
+
+void RenderTargetPoolGLTest::texture() {
+    RenderTargetPool pool;
+    UnsignedInt a = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    UnsignedInt b = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    UnsignedInt c = pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    pool.allocate();
+
+    Texture2D& textureA = pool.texture(a);
+    Texture2D& textureB = pool.texture(b);
+    Texture2D& textureC = pool.texture(c);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(textureA.id() > 0);
+    CORRADE_VERIFY(textureA.id() != textureB.id());
+    CORRADE_COMPARE(&textureC, &textureA);
+
+    /* The same object is handed out in the next frame */
+    GLuint id = textureA.id();
+    pool.nextFrame();
+    UnsignedInt d = pool.addTexture({16, 16}, TextureFormat::RGBA8, 3, 4);
+    pool.allocate();
+    CORRADE_COMPARE(pool.texture(d).id(), id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RenderTargetPoolGLTest::renderbuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool;
+    UnsignedInt a = pool.addRenderbuffer({16, 16}, RenderbufferFormat::DepthComponent16, 0, 0, 0);
+    UnsignedInt b = pool.addRenderbuffer({16, 16}, RenderbufferFormat::DepthComponent16, 0, 1, 1);
+    pool.allocate();
+
+    Renderbuffer& renderbufferA = pool.renderbuffer(a);
+    Renderbuffer& renderbufferB = pool.renderbuffer(b);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(renderbufferA.id() > 0);
+    CORRADE_COMPARE(&renderbufferB, &renderbufferA);
+}
+
+void RenderTargetPoolGLTest::framebuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    RenderTargetPool pool;
+    UnsignedInt color = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    UnsignedInt depth = pool.addRenderbuffer({16, 16}, RenderbufferFormat::DepthComponent16, 0, 0, 0);
+    pool.allocate();
+
+    Framebuffer& framebuffer = pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, color},
+        {Framebuffer::BufferAttachment::Depth, depth}});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, {16, 16}}));
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+
+    /* Cached for the same attachments */
+    CORRADE_COMPARE(&pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, color},
+        {Framebuffer::BufferAttachment::Depth, depth}}), &framebuffer);
+
+    /* Different attachment combination is a different framebuffer */
+    CORRADE_VERIFY(&pool.framebuffer({
+        {Framebuffer::ColorAttachment{0}, color}}) != &framebuffer);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderTargetPoolGLTest)
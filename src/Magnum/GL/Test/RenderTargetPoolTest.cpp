@@ -0,0 +1,344 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/RenderTargetPool.h"
+#include "Magnum/GL/TextureFormat.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+/* Only the GL-free planning and bookkeeping is tested here, the GL object
+   creation is in RenderTargetPoolGLTest */
+
+struct RenderTargetPoolTest: TestSuite::Tester {
+    explicit RenderTargetPoolTest();
+
+    void construct();
+
+    void aliasing();
+    void aliasingSamePass();
+    void aliasingUnsortedRequests();
+    void differentKeys();
+    void renderbufferSamples();
+
+    void memory();
+    void memoryRenderbuffer();
+    void reuseAcrossFrames();
+    void freeIdle();
+    void freeIdleImmediately();
+
+    void addAfterAllocate();
+    void invalidPassRange();
+    void targetNotAllocated();
+    void targetOutOfRange();
+};
+
+RenderTargetPoolTest::RenderTargetPoolTest() {
+    addTests({&RenderTargetPoolTest::construct,
+
+              &RenderTargetPoolTest::aliasing,
+              &RenderTargetPoolTest::aliasingSamePass,
+              &RenderTargetPoolTest::aliasingUnsortedRequests,
+              &RenderTargetPoolTest::differentKeys,
+              &RenderTargetPoolTest::renderbufferSamples,
+
+              &RenderTargetPoolTest::memory,
+              &RenderTargetPoolTest::memoryRenderbuffer,
+              &RenderTargetPoolTest::reuseAcrossFrames,
+              &RenderTargetPoolTest::freeIdle,
+              &RenderTargetPoolTest::freeIdleImmediately,
+
+              &RenderTargetPoolTest::addAfterAllocate,
+              &RenderTargetPoolTest::invalidPassRange,
+              &RenderTargetPoolTest::targetNotAllocated,
+              &RenderTargetPoolTest::targetOutOfRange});
+}
+
+void RenderTargetPoolTest::construct() {
+    RenderTargetPool pool{5};
+    CORRADE_COMPARE(pool.maxIdleFrames(), 5);
+    CORRADE_COMPARE(pool.frame(), 0);
+    CORRADE_COMPARE(pool.requestCount(), 0);
+    CORRADE_COMPARE(pool.targetCount(), 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 0);
+    CORRADE_COMPARE(pool.frameMemory(), 0);
+    CORRADE_COMPARE(pool.allocatedMemory(), 0);
+    CORRADE_COMPARE(pool.peakMemory(), 0);
+}
+
+void RenderTargetPoolTest::aliasing() {
+    RenderTargetPool pool;
+    UnsignedInt a = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    UnsignedInt b = pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    UnsignedInt c = pool.addTexture({16, 16}, TextureFormat::RGBA8, 2, 3);
+    UnsignedInt d = pool.addTexture({16, 16}, TextureFormat::RGBA8, 2, 2);
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(c, 2);
+    CORRADE_COMPARE(d, 3);
+    CORRADE_COMPARE(pool.requestCount(), 4);
+    pool.allocate();
+
+    /* A and B overlap in pass 1, C and D reuse them once they're done */
+    CORRADE_COMPARE(pool.targetCount(), 2);
+    CORRADE_COMPARE(pool.target(a), 0);
+    CORRADE_COMPARE(pool.target(b), 1);
+    CORRADE_COMPARE(pool.target(c), 0);
+    CORRADE_COMPARE(pool.target(d), 1);
+}
+
+void RenderTargetPoolTest::aliasingSamePass() {
+    RenderTargetPool pool;
+    /* A is read in the same pass in which B is written, so they can't
+       share */
+    UnsignedInt a = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    UnsignedInt b = pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 2);
+    pool.allocate();
+
+    CORRADE_COMPARE(pool.targetCount(), 2);
+    CORRADE_COMPARE(pool.target(a), 0);
+    CORRADE_COMPARE(pool.target(b), 1);
+}
+
+void RenderTargetPoolTest::aliasingUnsortedRequests() {
+    RenderTargetPool pool;
+    /* Same as aliasing(), but added in a different order. The assignment
+       follows the first pass, not the request order. */
+    UnsignedInt d = pool.addTexture({16, 16}, TextureFormat::RGBA8, 2, 2);
+    UnsignedInt b = pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    UnsignedInt c = pool.addTexture({16, 16}, TextureFormat::RGBA8, 2, 3);
+    UnsignedInt a = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    pool.allocate();
+
+    CORRADE_COMPARE(pool.targetCount(), 2);
+    CORRADE_COMPARE(pool.target(a), 0);
+    CORRADE_COMPARE(pool.target(b), 1);
+    CORRADE_COMPARE(pool.target(d), 0);
+    CORRADE_COMPARE(pool.target(c), 1);
+}
+
+void RenderTargetPoolTest::differentKeys() {
+    RenderTargetPool pool;
+    /* None of these overlap, but none of them is compatible either */
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.addTexture({16, 8}, TextureFormat::RGBA8, 1, 1);
+    pool.addTexture({16, 16}, TextureFormat::RGB8, 2, 2);
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::RGBA8, 0, 3, 3);
+    pool.allocate();
+
+    CORRADE_COMPARE(pool.targetCount(), 4);
+    CORRADE_COMPARE(pool.target(0), 0);
+    CORRADE_COMPARE(pool.target(1), 1);
+    CORRADE_COMPARE(pool.target(2), 2);
+    CORRADE_COMPARE(pool.target(3), 3);
+}
+
+void RenderTargetPoolTest::renderbufferSamples() {
+    #if defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2)
+    CORRADE_SKIP("Multisampled renderbuffers are not available in WebGL 1.0.");
+    #else
+    RenderTargetPool pool;
+    UnsignedInt a = pool.addRenderbuffer({4, 4}, RenderbufferFormat::RGBA8, 0, 0, 0);
+    UnsignedInt b = pool.addRenderbuffer({4, 4}, RenderbufferFormat::RGBA8, 1, 1, 1);
+    UnsignedInt c = pool.addRenderbuffer({4, 4}, RenderbufferFormat::RGBA8, 4, 2, 2);
+    pool.allocate();
+
+    /* Zero and one sample are the same thing */
+    CORRADE_COMPARE(pool.targetCount(), 2);
+    CORRADE_COMPARE(pool.target(a), 0);
+    CORRADE_COMPARE(pool.target(b), 0);
+    CORRADE_COMPARE(pool.target(c), 1);
+
+    /* 4x4 pixels, four bytes each, the multisampled one four times */
+    CORRADE_COMPARE(pool.requestedMemory(), 64 + 64 + 256);
+    CORRADE_COMPARE(pool.allocatedMemory(), 64 + 256);
+    #endif
+}
+
+void RenderTargetPoolTest::memory() {
+    RenderTargetPool pool;
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 2, 2);
+    CORRADE_COMPARE(pool.requestedMemory(), 3*1024);
+    CORRADE_COMPARE(pool.frameMemory(), 0);
+    CORRADE_COMPARE(pool.allocatedMemory(), 0);
+
+    pool.allocate();
+    CORRADE_COMPARE(pool.requestedMemory(), 3*1024);
+    CORRADE_COMPARE(pool.frameMemory(), 2*1024);
+    CORRADE_COMPARE(pool.allocatedMemory(), 2*1024);
+    CORRADE_COMPARE(pool.peakMemory(), 2*1024);
+
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.frame(), 1);
+    CORRADE_COMPARE(pool.requestCount(), 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 0);
+    CORRADE_COMPARE(pool.frameMemory(), 0);
+    /* Kept for the next frames */
+    CORRADE_COMPARE(pool.allocatedMemory(), 2*1024);
+    CORRADE_COMPARE(pool.peakMemory(), 2*1024);
+}
+
+void RenderTargetPoolTest::memoryRenderbuffer() {
+    RenderTargetPool pool;
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::DepthComponent16, 0, 0, 0);
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::StencilIndex8, 0, 0, 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 512 + 256);
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    /* 24-bit depth is padded to four bytes */
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::Depth24Stencil8, 0, 0, 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 512 + 256 + 1024);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Float depth and stencil take eight bytes */
+    pool.nextFrame();
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::Depth32FStencil8, 0, 0, 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 2048);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* A format that has no texture equivalent */
+    pool.nextFrame();
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::StencilIndex16, 0, 0, 0);
+    CORRADE_COMPARE(pool.requestedMemory(), 512);
+    #endif
+}
+
+void RenderTargetPoolTest::reuseAcrossFrames() {
+    RenderTargetPool pool;
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    pool.allocate();
+    pool.nextFrame();
+
+    /* The same target is reused, nothing new is allocated */
+    UnsignedInt a = pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    UnsignedInt b = pool.addTexture({8, 8}, TextureFormat::RGBA8, 0, 0);
+    pool.allocate();
+    CORRADE_COMPARE(pool.target(a), 0);
+    CORRADE_COMPARE(pool.target(b), 2);
+    CORRADE_COMPARE(pool.targetCount(), 3);
+    CORRADE_COMPARE(pool.frameMemory(), 1024 + 256);
+    CORRADE_COMPARE(pool.allocatedMemory(), 2*1024 + 256);
+    CORRADE_COMPARE(pool.peakMemory(), 2*1024 + 256);
+}
+
+void RenderTargetPoolTest::freeIdle() {
+    RenderTargetPool pool{1};
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 1);
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 1, 1);
+    pool.allocate();
+    pool.nextFrame();
+
+    /* Second target unused for one frame, still kept */
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.allocate();
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.targetCount(), 2);
+    CORRADE_COMPARE(pool.allocatedMemory(), 2*1024);
+
+    /* Unused for two frames, deleted */
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.allocate();
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.targetCount(), 1);
+    CORRADE_COMPARE(pool.allocatedMemory(), 1024);
+    CORRADE_COMPARE(pool.peakMemory(), 2*1024);
+}
+
+void RenderTargetPoolTest::freeIdleImmediately() {
+    RenderTargetPool pool{0};
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.allocate();
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.targetCount(), 1);
+
+    /* Not used in this frame, so it's deleted right away */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.targetCount(), 0);
+    CORRADE_COMPARE(pool.allocatedMemory(), 0);
+    CORRADE_COMPARE(pool.peakMemory(), 1024);
+}
+
+void RenderTargetPoolTest::addAfterAllocate() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderTargetPool pool;
+    pool.allocate();
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::RGBA8, 0, 0, 0);
+    pool.allocate();
+    CORRADE_COMPARE(out.str(),
+        "GL::RenderTargetPool::addTexture(): targets already allocated for this frame\n"
+        "GL::RenderTargetPool::addRenderbuffer(): targets already allocated for this frame\n"
+        "GL::RenderTargetPool::allocate(): targets already allocated for this frame\n");
+}
+
+void RenderTargetPoolTest::invalidPassRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderTargetPool pool;
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 3, 2);
+    pool.addRenderbuffer({16, 16}, RenderbufferFormat::RGBA8, 0, 1, 0);
+    CORRADE_COMPARE(out.str(),
+        "GL::RenderTargetPool::addTexture(): first pass 3 is after last pass 2\n"
+        "GL::RenderTargetPool::addRenderbuffer(): first pass 1 is after last pass 0\n");
+}
+
+void RenderTargetPoolTest::targetNotAllocated() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderTargetPool pool;
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.target(0);
+    CORRADE_COMPARE(out.str(),
+        "GL::RenderTargetPool::target(): targets not allocated for this frame\n");
+}
+
+void RenderTargetPoolTest::targetOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderTargetPool pool;
+    pool.addTexture({16, 16}, TextureFormat::RGBA8, 0, 0);
+    pool.allocate();
+    pool.target(1);
+    CORRADE_COMPARE(out.str(),
+        "GL::RenderTargetPool::target(): index 1 out of range for 1 requests\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RenderTargetPoolTest)
@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/Implementation/textureStorageSize.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TextureStorageSizeTest: TestSuite::Tester {
+    explicit TextureStorageSizeTest();
+
+    void uncompressed();
+    void uncompressedLevelClamp();
+    void unsized();
+    void depthStencil();
+    void array();
+    void threeDimensional();
+    void compressed();
+    #ifdef MAGNUM_TARGET_GLES
+    void compressedPvrtc();
+    #endif
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compressedAstc3D();
+    #endif
+    void compressedAstc();
+};
+
+TextureStorageSizeTest::TextureStorageSizeTest() {
+    addTests({&TextureStorageSizeTest::uncompressed,
+              &TextureStorageSizeTest::uncompressedLevelClamp,
+              &TextureStorageSizeTest::unsized,
+              &TextureStorageSizeTest::depthStencil,
+              &TextureStorageSizeTest::array,
+              &TextureStorageSizeTest::threeDimensional,
+              &TextureStorageSizeTest::compressed,
+              #ifdef MAGNUM_TARGET_GLES
+              &TextureStorageSizeTest::compressedPvrtc,
+              #endif
+              #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &TextureStorageSizeTest::compressedAstc3D,
+              #endif
+              &TextureStorageSizeTest::compressedAstc});
+}
+
+void TextureStorageSizeTest::uncompressed() {
+    /* 256x128, 128x64 and 64x32 levels of four bytes each */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RGBA, 3, {256, 128, 1}, 2), 131072 + 32768 + 8192);
+}
+
+void TextureStorageSizeTest::uncompressedLevelClamp() {
+    /* The smaller dimension doesn't go below 1 */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RGB, 3, {4, 1, 1}, 2), 12 + 6 + 3);
+}
+
+void TextureStorageSizeTest::unsized() {
+    /* Assuming eight bits per component */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RGB, 1, {16, 16, 1}, 2), 768);
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RG, 1, {16, 16, 1}, 2), 512);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    /* Generic compressed formats have no block size, assuming the driver
+       doesn't compress at all */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBA, 1, {16, 16, 1}, 2), 1024);
+    #endif
+}
+
+void TextureStorageSizeTest::depthStencil() {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::DepthComponent16, 1, {16, 16, 1}, 2), 512);
+    /* 24-bit depth is padded to four bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::DepthComponent24, 1, {16, 16, 1}, 2), 1024);
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::Depth24Stencil8, 1, {16, 16, 1}, 2), 1024);
+    #endif
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::DepthStencil, 1, {16, 16, 1}, 2), 1024);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::DepthComponent32F, 1, {16, 16, 1}, 2), 1024);
+    /* Float depth and stencil take eight bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::Depth32FStencil8, 1, {16, 16, 1}, 2), 2048);
+    #endif
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::StencilIndex8, 1, {16, 16, 1}, 2), 256);
+    #endif
+}
+
+void TextureStorageSizeTest::array() {
+    /* Layer count stays the same for all levels */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RGB, 2, {16, 16, 10}, 2), 7680 + 1920);
+}
+
+void TextureStorageSizeTest::threeDimensional() {
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::RGBA, 4, {8, 8, 8}, 3), 2048 + 256 + 32 + 4);
+}
+
+void TextureStorageSizeTest::compressed() {
+    /* 3x2 and 2x1 blocks of 16 bytes each */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBAS3tcDxt5, 2, {10, 6, 1}, 2), 96 + 32);
+    /* 8 bytes per block */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBS3tcDxt1, 1, {16, 16, 1}, 2), 128);
+}
+
+#ifdef MAGNUM_TARGET_GLES
+void TextureStorageSizeTest::compressedPvrtc() {
+    /* 8x4 blocks of 8 bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBPvrtc2bppV1, 1, {32, 32, 1}, 2), 256);
+    /* 4x4 blocks of 8 bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBAPvrtc4bppV1, 1, {32, 32, 1}, 2), 512);
+}
+#endif
+
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void TextureStorageSizeTest::compressedAstc3D() {
+    /* 3x3x2 and 2x2x1 blocks of 16 bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBAAstc4x4x4, 2, {12, 12, 8}, 3), 288 + 64);
+}
+#endif
+
+void TextureStorageSizeTest::compressedAstc() {
+    /* 11x11 blocks of 16 bytes */
+    CORRADE_COMPARE(Implementation::textureStorageSize(TextureFormat::CompressedRGBAAstc6x6, 1, {64, 64, 1}, 2), 1936);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TextureStorageSizeTest)
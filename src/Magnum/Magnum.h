@@ -860,12 +860,18 @@ typedef BasicMutableCompressedImageView<1> MutableCompressedImageView1D;
 typedef BasicMutableCompressedImageView<2> MutableCompressedImageView2D;
 typedef BasicMutableCompressedImageView<3> MutableCompressedImageView3D;
 
+enum class MemoryCategory: UnsignedByte;
+class MemoryAccounting;
+class AccountedMemory;
+
 enum class MeshPrimitive: UnsignedInt;
 enum class MeshIndexType: UnsignedInt;
 
 enum class PixelFormat: UnsignedInt;
 enum class CompressedPixelFormat: UnsignedInt;
 
+class FrameArena;
+
 class PixelStorage;
 class CompressedPixelStorage;
 
@@ -880,6 +886,7 @@ enum class SamplerFilter: UnsignedInt;
 enum class SamplerMipmap: UnsignedInt;
 enum class SamplerWrapping: UnsignedInt;
 
+class TaskScheduler;
 class Timeline;
 #endif
 
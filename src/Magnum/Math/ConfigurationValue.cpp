@@ -0,0 +1,321 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ConfigurationValue.h"
+
+#include <cfloat>
+#include <clocale>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+namespace {
+
+inline bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+/* Powers of ten that are exactly representable in a double */
+constexpr double Powers10[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+    1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* The exact fast path relies on every operation being rounded to a double,
+   which isn't the case with x87 extended precision */
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+constexpr bool FastPathAvailable = true;
+#else
+constexpr bool FastPathAvailable = false;
+#endif
+
+/* Copies the number into a null-terminated buffer with the decimal point
+   replaced by the one used by current locale, so the result can be fed to
+   std::strtod() / std::strtof() */
+std::string localizedNumber(const char* const begin, const char* const end) {
+    std::string out{begin, end};
+    const char decimalPoint = *std::localeconv()->decimal_point;
+    if(decimalPoint != '.') for(char& c: out)
+        if(c == '.') c = decimalPoint;
+    return out;
+}
+
+struct ParsedNumber {
+    const char* end;
+    std::uint64_t mantissa;
+    Int exponent;
+    bool negative, truncated;
+};
+
+/* Splits a decimal floating-point number into a mantissa and a base-10
+   exponent. Returns `begin` in ParsedNumber::end if there's no number. */
+ParsedNumber parseDecimal(const char* const begin, const char* const end) {
+    /* Anything above is kept only as an exponent, the remaining digits are
+       then just marked as truncated */
+    constexpr std::uint64_t MaxMantissa = 1000000000000000000ull;
+
+    ParsedNumber out{begin, 0, 0, false, false};
+    const char* it = begin;
+    if(it != end && (*it == '+' || *it == '-')) out.negative = *it++ == '-';
+
+    bool digits = false;
+    for(; it != end && isDigit(*it); ++it) {
+        digits = true;
+        if(out.mantissa < MaxMantissa)
+            out.mantissa = out.mantissa*10 + (*it - '0');
+        else {
+            ++out.exponent;
+            if(*it != '0') out.truncated = true;
+        }
+    }
+
+    if(it != end && *it == '.') {
+        ++it;
+        for(; it != end && isDigit(*it); ++it) {
+            digits = true;
+            if(out.mantissa < MaxMantissa) {
+                out.mantissa = out.mantissa*10 + (*it - '0');
+                --out.exponent;
+            } else if(*it != '0') out.truncated = true;
+        }
+    }
+
+    if(!digits) return out;
+
+    /* The exponent is consumed only if there are some digits after it */
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        const char* e = it + 1;
+        bool negativeExponent = false;
+        if(e != end && (*e == '+' || *e == '-')) negativeExponent = *e++ == '-';
+        if(e != end && isDigit(*e)) {
+            Int exponent = 0;
+            for(; e != end && isDigit(*e); ++e)
+                if(exponent < 100000) exponent = exponent*10 + (*e - '0');
+            out.exponent += negativeExponent ? -exponent : exponent;
+            it = e;
+        }
+    }
+
+    out.end = it;
+    return out;
+}
+
+/* Case-insensitive match of a lowercase literal */
+bool matches(const char* const begin, const char* const end, const char* const literal) {
+    const std::size_t size = std::strlen(literal);
+    if(std::size_t(end - begin) < size) return false;
+    for(std::size_t i = 0; i != size; ++i)
+        if((begin[i] | 0x20) != literal[i]) return false;
+    return true;
+}
+
+/* NaN and infinity, the same spellings as std::strtod() accepts */
+template<class T> const char* parseSpecial(const char* const begin, const char* const end, T& out) {
+    const char* it = begin;
+    bool negative = false;
+    if(it != end && (*it == '+' || *it == '-')) negative = *it++ == '-';
+
+    if(matches(it, end, "nan")) {
+        out = std::numeric_limits<T>::quiet_NaN();
+        return it + 3;
+    }
+    if(matches(it, end, "infinity")) {
+        out = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return it + 8;
+    }
+    if(matches(it, end, "inf")) {
+        out = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return it + 3;
+    }
+
+    return begin;
+}
+
+/* Clinger's fast path -- if both the mantissa and the power of ten are
+   exactly representable, a single multiplication or division is correctly
+   rounded */
+bool fastPath(const ParsedNumber& number, double& out) {
+    if(!FastPathAvailable || number.truncated || number.mantissa > (1ull << 53) || number.exponent < -22 || number.exponent > 22)
+        return false;
+
+    const double mantissa = double(number.mantissa);
+    const double value = number.exponent < 0 ?
+        mantissa/Powers10[-number.exponent] :
+        mantissa*Powers10[number.exponent];
+    out = number.negative ? -value : value;
+    return true;
+}
+
+const char* parse(const char* const begin, const char* const end, Double& out) {
+    const ParsedNumber number = parseDecimal(begin, end);
+    if(number.end == begin) {
+        const char* const special = parseSpecial(begin, end, out);
+        if(special == begin) out = 0.0;
+        return special;
+    }
+
+    if(!fastPath(number, out))
+        out = std::strtod(localizedNumber(begin, number.end).data(), nullptr);
+    return number.end;
+}
+
+const char* parse(const char* const begin, const char* const end, Float& out) {
+    const ParsedNumber number = parseDecimal(begin, end);
+    if(number.end == begin) {
+        const char* const special = parseSpecial(begin, end, out);
+        if(special == begin) out = 0.0f;
+        return special;
+    }
+
+    /* The fast path result is always in the normal float range. Rounding it
+       to a float then gives the correctly rounded value unless the double
+       landed exactly in the middle between two floats, in which case the
+       rounding direction is ambiguous and a slow path needs to be taken. */
+    double value;
+    if(fastPath(number, value)) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if((bits & 0x1fffffffull) != 0x10000000ull) {
+            out = Float(value);
+            return number.end;
+        }
+    }
+
+    out = std::strtof(localizedNumber(begin, number.end).data(), nullptr);
+    return number.end;
+}
+
+template<class T> const char* parseInteger(const char* const begin, const char* const end, T& out) {
+    const char* it = begin;
+    bool negative = false;
+    if(it != end && (*it == '+' || *it == '-')) negative = *it++ == '-';
+
+    if(it == end || !isDigit(*it)) {
+        out = T{};
+        return begin;
+    }
+
+    /* Saturate on overflow, same as std::strtol() / std::strtoul() */
+    constexpr std::uint64_t Max = std::uint64_t(std::numeric_limits<T>::max());
+    constexpr std::uint64_t Min = std::uint64_t(-(std::numeric_limits<T>::min() + 1)) + 1;
+    std::uint64_t value = 0;
+    for(; it != end && isDigit(*it); ++it)
+        if(value <= 0xffffffffull) value = value*10 + (*it - '0');
+
+    if(std::numeric_limits<T>::is_signed) {
+        if(negative) out = value >= Min ? std::numeric_limits<T>::min() : T(-std::int64_t(value));
+        else out = value > Max ? std::numeric_limits<T>::max() : T(value);
+    } else {
+        /* Negative values wrap around, same as with std::strtoul() */
+        if(value > Max) out = std::numeric_limits<T>::max();
+        else out = negative ? T(-value) : T(value);
+    }
+
+    return it;
+}
+
+void appendInteger(std::string& out, std::uint64_t value, const bool negative) {
+    char buffer[24];
+    char* it = buffer + sizeof(buffer);
+    do {
+        *--it = '0' + char(value % 10);
+    } while(value /= 10);
+    if(negative) *--it = '-';
+    out.append(it, buffer + sizeof(buffer));
+}
+
+/* Prints the value with increasing precision until it parses back to the
+   same value. Starting at six significant digits means values that need at
+   most that many are printed the same as with std::ostream defaults, only
+   the rest gets the extra digits needed for an exact round-trip. */
+template<class T> void appendFloatingPoint(std::string& out, const T value, const Int maxPrecision) {
+    if(value != value) {
+        out += "nan";
+        return;
+    }
+    if(value == std::numeric_limits<T>::infinity()) {
+        out += "inf";
+        return;
+    }
+    if(value == -std::numeric_limits<T>::infinity()) {
+        out += "-inf";
+        return;
+    }
+
+    const char decimalPoint = *std::localeconv()->decimal_point;
+    char buffer[32];
+    std::size_t size = 0;
+    for(Int precision = 6; precision <= maxPrecision; ++precision) {
+        size = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, Double(value));
+        if(decimalPoint != '.') for(std::size_t i = 0; i != size; ++i)
+            if(buffer[i] == decimalPoint) buffer[i] = '.';
+
+        T parsed;
+        parse(buffer, buffer + size, parsed);
+        if(parsed == value) break;
+    }
+
+    out.append(buffer, size);
+}
+
+}
+
+void configurationValueAppend(std::string& out, const Float value) {
+    appendFloatingPoint(out, value, 9);
+}
+
+void configurationValueAppend(std::string& out, const Double value) {
+    appendFloatingPoint(out, value, 17);
+}
+
+void configurationValueAppend(std::string& out, const Int value) {
+    appendInteger(out, value < 0 ? std::uint64_t(-std::int64_t(value)) : std::uint64_t(value), value < 0);
+}
+
+void configurationValueAppend(std::string& out, const UnsignedInt value) {
+    appendInteger(out, value, false);
+}
+
+const char* configurationValueParse(const char* const begin, const char* const end, Float& out) {
+    return parse(begin, end, out);
+}
+
+const char* configurationValueParse(const char* const begin, const char* const end, Double& out) {
+    return parse(begin, end, out);
+}
+
+const char* configurationValueParse(const char* const begin, const char* const end, Int& out) {
+    return parseInteger(begin, end, out);
+}
+
+const char* configurationValueParse(const char* const begin, const char* const end, UnsignedInt& out) {
+    return parseInteger(begin, end, out);
+}
+
+}}}
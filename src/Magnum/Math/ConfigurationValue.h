@@ -50,6 +50,79 @@
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Math/Vector4.h"
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Locale-independent conversion of Float, Double, Int and UnsignedInt
+   components without going through std::stringstream. Floating-point values
+   are printed with the least precision (but at least the six digits
+   std::ostream uses) that parses back to the exact same value.
+   configurationValueParse() returns pointer after the parsed value or
+   `begin` if there's no value, in which case `out` is set to zero. */
+MAGNUM_EXPORT void configurationValueAppend(std::string& out, Float value);
+MAGNUM_EXPORT void configurationValueAppend(std::string& out, Double value);
+MAGNUM_EXPORT void configurationValueAppend(std::string& out, Int value);
+MAGNUM_EXPORT void configurationValueAppend(std::string& out, UnsignedInt value);
+MAGNUM_EXPORT const char* configurationValueParse(const char* begin, const char* end, Float& out);
+MAGNUM_EXPORT const char* configurationValueParse(const char* begin, const char* end, Double& out);
+MAGNUM_EXPORT const char* configurationValueParse(const char* begin, const char* end, Int& out);
+MAGNUM_EXPORT const char* configurationValueParse(const char* begin, const char* end, UnsignedInt& out);
+
+/* Other types and non-default flags (hexadecimal, scientific...) go through
+   the generic Corrade implementation */
+template<class T> struct ConfigurationValueComponent {
+    static void append(std::string& out, const T value, const Corrade::Utility::ConfigurationValueFlags flags) {
+        out += Corrade::Utility::ConfigurationValue<T>::toString(value, flags);
+    }
+
+    static T parse(const char* const begin, const char* const end, const Corrade::Utility::ConfigurationValueFlags flags) {
+        return Corrade::Utility::ConfigurationValue<T>::fromString(std::string{begin, end}, flags);
+    }
+};
+
+template<class T> struct ConfigurationValueFastComponent {
+    static void append(std::string& out, const T value, const Corrade::Utility::ConfigurationValueFlags flags) {
+        if(flags) out += Corrade::Utility::ConfigurationValue<T>::toString(value, flags);
+        else configurationValueAppend(out, value);
+    }
+
+    static T parse(const char* const begin, const char* const end, const Corrade::Utility::ConfigurationValueFlags flags) {
+        if(flags) return Corrade::Utility::ConfigurationValue<T>::fromString(std::string{begin, end}, flags);
+        T out;
+        configurationValueParse(begin, end, out);
+        return out;
+    }
+};
+
+template<> struct ConfigurationValueComponent<Float>: ConfigurationValueFastComponent<Float> {};
+template<> struct ConfigurationValueComponent<Double>: ConfigurationValueFastComponent<Double> {};
+template<> struct ConfigurationValueComponent<Int>: ConfigurationValueFastComponent<Int> {};
+template<> struct ConfigurationValueComponent<UnsignedInt>: ConfigurationValueFastComponent<UnsignedInt> {};
+
+inline bool isConfigurationValueSeparator(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/* Calls assign(i, value) for at most `count` whitespace-separated values,
+   parsing them in place without creating temporary substrings */
+template<class T, class F> void parseConfigurationValueComponents(const std::string& stringValue, const std::size_t count, const Corrade::Utility::ConfigurationValueFlags flags, F assign) {
+    const char* it = stringValue.data();
+    const char* const end = it + stringValue.size();
+    for(std::size_t i = 0; i != count; ++i) {
+        while(it != end && isConfigurationValueSeparator(*it)) ++it;
+        if(it == end) break;
+
+        const char* valueEnd = it;
+        while(valueEnd != end && !isConfigurationValueSeparator(*valueEnd)) ++valueEnd;
+
+        assign(i, ConfigurationValueComponent<T>::parse(it, valueEnd, flags));
+        it = valueEnd;
+    }
+}
+
+}}}
+#endif
+
 namespace Corrade { namespace Utility {
 
 /** @configurationvalue{Magnum::Math::Deg} */
@@ -58,12 +131,18 @@ template<class T> struct ConfigurationValue<Magnum::Math::Deg<T>> {
 
     /** @brief Writes degrees as a number */
     static std::string toString(const Magnum::Math::Deg<T>& value, ConfigurationValueFlags flags) {
-        return ConfigurationValue<T>::toString(T(value), flags);
+        std::string output;
+        Magnum::Math::Implementation::ConfigurationValueComponent<T>::append(output, T(value), flags);
+        return output;
     }
 
     /** @brief Reads degrees as a number */
     static Magnum::Math::Deg<T> fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
-        return Magnum::Math::Deg<T>(ConfigurationValue<T>::fromString(stringValue, flags));
+        Magnum::Math::Deg<T> result;
+        Magnum::Math::Implementation::parseConfigurationValueComponents<T>(stringValue, 1, flags, [&result](std::size_t, T value) {
+            result = Magnum::Math::Deg<T>{value};
+        });
+        return result;
     }
 };
 
@@ -73,12 +152,18 @@ template<class T> struct ConfigurationValue<Magnum::Math::Rad<T>> {
 
     /** @brief Writes degrees as a number */
     static std::string toString(const Magnum::Math::Rad<T>& value, ConfigurationValueFlags flags) {
-        return ConfigurationValue<T>::toString(T(value), flags);
+        std::string output;
+        Magnum::Math::Implementation::ConfigurationValueComponent<T>::append(output, T(value), flags);
+        return output;
     }
 
     /** @brief Reads degrees as a number */
     static Magnum::Math::Rad<T> fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
-        return Magnum::Math::Rad<T>(ConfigurationValue<T>::fromString(stringValue, flags));
+        Magnum::Math::Rad<T> result;
+        Magnum::Math::Implementation::parseConfigurationValueComponents<T>(stringValue, 1, flags, [&result](std::size_t, T value) {
+            result = Magnum::Math::Rad<T>{value};
+        });
+        return result;
     }
 };
 
@@ -92,7 +177,7 @@ template<std::size_t size, class T> struct ConfigurationValue<Magnum::Math::Vect
 
         for(std::size_t i = 0; i != size; ++i) {
             if(!output.empty()) output += ' ';
-            output += ConfigurationValue<T>::toString(value[i], flags);
+            Magnum::Math::Implementation::ConfigurationValueComponent<T>::append(output, value[i], flags);
         }
 
         return output;
@@ -101,20 +186,9 @@ template<std::size_t size, class T> struct ConfigurationValue<Magnum::Math::Vect
     /** @brief Reads elements separated with whitespace */
     static Magnum::Math::Vector<size, T> fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
         Magnum::Math::Vector<size, T> result;
-
-        std::size_t oldpos = 0, pos = std::string::npos, i = 0;
-        do {
-            pos = stringValue.find(' ', oldpos);
-            std::string part = stringValue.substr(oldpos, pos-oldpos);
-
-            if(!part.empty()) {
-                result[i] = ConfigurationValue<T>::fromString(part, flags);
-                ++i;
-            }
-
-            oldpos = pos+1;
-        } while(pos != std::string::npos && i != size);
-
+        Magnum::Math::Implementation::parseConfigurationValueComponents<T>(stringValue, size, flags, [&result](std::size_t i, T value) {
+            result[i] = value;
+        });
         return result;
     }
 };
@@ -164,7 +238,7 @@ template<std::size_t cols, std::size_t rows, class T> struct ConfigurationValue<
         for(std::size_t row = 0; row != rows; ++row) {
             for(std::size_t col = 0; col != cols; ++col) {
                 if(!output.empty()) output += ' ';
-                output += ConfigurationValue<T>::toString(value[col][row], flags);
+                Magnum::Math::Implementation::ConfigurationValueComponent<T>::append(output, value[col][row], flags);
             }
         }
 
@@ -174,20 +248,9 @@ template<std::size_t cols, std::size_t rows, class T> struct ConfigurationValue<
     /** @brief Reads elements separated with whitespace */
     static Magnum::Math::RectangularMatrix<cols, rows, T> fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
         Magnum::Math::RectangularMatrix<cols, rows, T> result;
-
-        std::size_t oldpos = 0, pos = std::string::npos, i = 0;
-        do {
-            pos = stringValue.find(' ', oldpos);
-            std::string part = stringValue.substr(oldpos, pos-oldpos);
-
-            if(!part.empty()) {
-                result[i%cols][i/cols] = ConfigurationValue<T>::fromString(part, flags);
-                ++i;
-            }
-
-            oldpos = pos+1;
-        } while(pos != std::string::npos && i != cols*rows);
-
+        Magnum::Math::Implementation::parseConfigurationValueComponents<T>(stringValue, cols*rows, flags, [&result](std::size_t i, T value) {
+            result[i%cols][i/cols] = value;
+        });
         return result;
     }
 };
@@ -349,7 +412,7 @@ template<Magnum::UnsignedInt order, Magnum::UnsignedInt dimensions, class T> str
         for(std::size_t o = 0; o != order + 1; ++o) {
             for(std::size_t i = 0; i != dimensions; ++i) {
                 if(!output.empty()) output += ' ';
-                output += ConfigurationValue<T>::toString(value[o][i], flags);
+                Magnum::Math::Implementation::ConfigurationValueComponent<T>::append(output, value[o][i], flags);
             }
         }
 
@@ -359,20 +422,9 @@ template<Magnum::UnsignedInt order, Magnum::UnsignedInt dimensions, class T> str
     /** @brief Reads elements separated with whitespace */
     static Magnum::Math::Bezier<order, dimensions, T> fromString(const std::string& stringValue, ConfigurationValueFlags flags) {
         Magnum::Math::Bezier<order, dimensions, T> result;
-
-        std::size_t oldpos = 0, pos = std::string::npos, i = 0;
-        do {
-            pos = stringValue.find(' ', oldpos);
-            std::string part = stringValue.substr(oldpos, pos-oldpos);
-
-            if(!part.empty()) {
-                result[i/dimensions][i%dimensions] = ConfigurationValue<T>::fromString(part, flags);
-                ++i;
-            }
-
-            oldpos = pos+1;
-        } while(pos != std::string::npos);
-
+        Magnum::Math::Implementation::parseConfigurationValueComponents<T>(stringValue, (order + 1)*dimensions, flags, [&result](std::size_t i, T value) {
+            result[i/dimensions][i%dimensions] = value;
+        });
         return result;
     }
 };
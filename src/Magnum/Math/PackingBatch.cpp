@@ -29,6 +29,7 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Math/TransformationPacking.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
 
 namespace Magnum { namespace Math {
@@ -296,4 +297,125 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     }
 }
 
+namespace {
+
+/* The per-element work is inlined from the single-value APIs so the batch
+   results are bit-exact with them */
+
+template<class T> inline void packQuaternionIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packQuaternionInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Quaternion<Float>& q = *reinterpret_cast<const Quaternion<Float>*>(srcPtr);
+        *reinterpret_cast<T*>(dstPtr) = Implementation::packQuaternion<T>(Vector4<Float>{q.vector(), q.scalar()});
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+template<class T> inline void unpackQuaternionIntoImplementation(const Corrade::Containers::StridedArrayView1D<const T>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackQuaternionInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        const Vector4<Float> q = Implementation::unpackQuaternion<Float>(*reinterpret_cast<const T*>(srcPtr));
+        *reinterpret_cast<Quaternion<Float>*>(dstPtr) = Quaternion<Float>{q.xyz(), q.w()};
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+}
+
+void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<UnsignedInt>& dst) {
+    packQuaternionIntoImplementation(src, dst);
+}
+
+void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedShort>>& dst) {
+    packQuaternionIntoImplementation(src, dst);
+}
+
+void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<UnsignedLong>& dst) {
+    packQuaternionIntoImplementation(src, dst);
+}
+
+void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    unpackQuaternionIntoImplementation(src, dst);
+}
+
+void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedShort>>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    unpackQuaternionIntoImplementation(src, dst);
+}
+
+void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const UnsignedLong>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    unpackQuaternionIntoImplementation(src, dst);
+}
+
+namespace {
+
+template<class T> inline void packTranslationIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<T>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packTranslationInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        *reinterpret_cast<Vector3<T>*>(dstPtr) = packTranslation<T>(*reinterpret_cast<const Vector3<Float>*>(srcPtr), range);
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+template<class T> inline void unpackTranslationIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<T>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackTranslationInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    for(std::size_t i = 0, max = src.size(); i != max; ++i) {
+        *reinterpret_cast<Vector3<Float>*>(dstPtr) = unpackTranslation(*reinterpret_cast<const Vector3<T>*>(srcPtr), range);
+
+        srcPtr += srcStride;
+        dstPtr += dstStride;
+    }
+}
+
+}
+
+void packTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedByte>>& dst) {
+    packTranslationIntoImplementation(src, range, dst);
+}
+
+void packTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedShort>>& dst) {
+    packTranslationIntoImplementation(src, range, dst);
+}
+
+void unpackTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedByte>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    unpackTranslationIntoImplementation(src, range, dst);
+}
+
+void unpackTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedShort>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    unpackTranslationIntoImplementation(src, range, dst);
+}
+
 }}
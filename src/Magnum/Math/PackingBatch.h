@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::castInto()
+ * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::castInto(), @ref Magnum::Math::packQuaternionInto(), @ref Magnum::Math::unpackQuaternionInto(), @ref Magnum::Math::packTranslationInto(), @ref Magnum::Math::unpackTranslationInto()
  * @m_since_latest
  */
 
@@ -34,8 +34,13 @@
 
 #include "Magnum/Types.h"
 #include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
 
-namespace Magnum { namespace Math {
+namespace Magnum {
+
+class TaskScheduler;
+
+namespace Math {
 
 /**
 @{ @name Batch packing functions
@@ -127,6 +132,70 @@ MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView2D<const
  */
 MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst);
 
+/**
+@brief Unpack integral values into a floating-point representation in parallel
+@param[in]  scheduler   Task scheduler to use
+@param[in]  src         Source integral values
+@param[out] dst         Destination floating-point values
+@m_since_latest
+
+Splits the first dimension into chunks and processes them with
+@ref unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>&, const Corrade::Containers::StridedArrayView2D<Float>&)
+using @ref TaskScheduler::parallelFor(). The output is the same as with the
+single-threaded variant.
+*/
+MAGNUM_EXPORT void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Pack floating-point values into an integer representation in parallel
+@param[in]  scheduler   Task scheduler to use
+@param[in]  src         Source floating-point values
+@param[out] dst         Destination integral values
+@m_since_latest
+
+Splits the first dimension into chunks and processes them with
+@ref packInto(const Corrade::Containers::StridedArrayView2D<const Float>&, const Corrade::Containers::StridedArrayView2D<UnsignedByte>&)
+using @ref TaskScheduler::parallelFor(). The output is the same as with the
+single-threaded variant.
+*/
+MAGNUM_EXPORT void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst);
+
 /**
 @brief Pack 32-bit float values into 16-bit half-float representation
 @param[in]  src     Source 32-bit float values
@@ -265,6 +334,94 @@ MAGNUM_EXPORT void castInto(const Corrade::Containers::StridedArrayView2D<const
  */
 MAGNUM_EXPORT void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst);
 
+/**
+@brief Pack quaternions into the smallest-three representation
+@param[in]  src     Source quaternions
+@param[out] dst     Destination packed values
+@m_since_latest
+
+Batch variant of @ref packQuaternion(), see its documentation for details
+about the supported representations and their precision. Expects that @p src
+and @p dst have the same size. The quaternions are expected to be normalized,
+but unlike with @ref packQuaternion() it's not checked.
+@see @ref unpackQuaternionInto()
+*/
+MAGNUM_EXPORT void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<UnsignedInt>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedShort>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<UnsignedLong>& dst);
+
+/**
+@brief Unpack quaternions from the smallest-three representation
+@param[in]  src     Source packed values
+@param[out] dst     Destination quaternions
+@m_since_latest
+
+Batch variant of @ref unpackQuaternion(). Expects that @p src and @p dst have
+the same size.
+@see @ref packQuaternionInto()
+*/
+MAGNUM_EXPORT void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedShort>>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackQuaternionInto(const Corrade::Containers::StridedArrayView1D<const UnsignedLong>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+@brief Pack translations into an integer representation
+@param[in]  src     Source translations
+@param[in]  range   Translation range
+@param[out] dst     Destination packed values
+@m_since_latest
+
+Batch variant of @ref packTranslation(). Expects that @p src and @p dst have
+the same size.
+@see @ref unpackTranslationInto()
+*/
+MAGNUM_EXPORT void packTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedByte>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<UnsignedShort>>& dst);
+
+/**
+@brief Unpack translations from an integer representation
+@param[in]  src     Source packed values
+@param[in]  range   Translation range
+@param[out] dst     Destination translations
+@m_since_latest
+
+Batch variant of @ref unpackTranslation(). Expects that @p src and @p dst have
+the same size.
+@see @ref packTranslationInto()
+*/
+MAGNUM_EXPORT void unpackTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedByte>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackTranslationInto(const Corrade::Containers::StridedArrayView1D<const Vector3<UnsignedShort>>& src, const Range3D<Float>& range, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
 /*@}*/
 
 }}
@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PackingBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Functions.h"
+
+/* Lives in the main library and not in the Math objects as it needs the
+   TaskScheduler */
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Roughly 16k scalars per chunk, small enough to balance well and large
+   enough that the scheduling overhead doesn't matter */
+enum: std::size_t { ChunkScalarCount = 16384 };
+
+template<class T, class U> void parallelInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, void(*function)(const Corrade::Containers::StridedArrayView2D<const T>&, const Corrade::Containers::StridedArrayView2D<U>&)) {
+    const std::size_t componentCount = src.size()[1];
+    scheduler.parallelFor(src.size()[0], Math::max(std::size_t{1}, std::size_t{ChunkScalarCount}/Math::max(componentCount, std::size_t{1})),
+        [&](std::size_t begin, std::size_t end) {
+            function(src.slice({begin, 0}, {end, componentCount}),
+                     dst.slice({begin, 0}, {end, componentCount}));
+        });
+}
+
+}
+
+void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<UnsignedByte, Float>(scheduler, src, dst, unpackInto);
+}
+
+void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<UnsignedShort, Float>(scheduler, src, dst, unpackInto);
+}
+
+void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Byte, Float>(scheduler, src, dst, unpackInto);
+}
+
+void unpackInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Short, Float>(scheduler, src, dst, unpackInto);
+}
+
+void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Float, UnsignedByte>(scheduler, src, dst, packInto);
+}
+
+void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Float, Byte>(scheduler, src, dst, packInto);
+}
+
+void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Float, UnsignedShort>(scheduler, src, dst, packInto);
+}
+
+void packInto(TaskScheduler& scheduler, const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    parallelInto<Float, Short>(scheduler, src, dst, packInto);
+}
+
+}}
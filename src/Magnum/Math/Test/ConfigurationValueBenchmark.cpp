@@ -0,0 +1,312 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Configuration.h>
+
+#include "Magnum/Math/ConfigurationValue.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct ConfigurationValueBenchmark: Corrade::TestSuite::Tester {
+    explicit ConfigurationValueBenchmark();
+
+    void toStringFloat();
+    void toStringFloatStream();
+    void fromStringFloat();
+    void fromStringFloatStream();
+
+    void toStringInt();
+    void toStringIntStream();
+    void fromStringInt();
+    void fromStringIntStream();
+
+    void saveGlyphs();
+    void saveGlyphsStream();
+    void loadGlyphs();
+    void loadGlyphsStream();
+};
+
+ConfigurationValueBenchmark::ConfigurationValueBenchmark() {
+    addBenchmarks({&ConfigurationValueBenchmark::toStringFloat,
+                   &ConfigurationValueBenchmark::toStringFloatStream,
+                   &ConfigurationValueBenchmark::fromStringFloat,
+                   &ConfigurationValueBenchmark::fromStringFloatStream,
+
+                   &ConfigurationValueBenchmark::toStringInt,
+                   &ConfigurationValueBenchmark::toStringIntStream,
+                   &ConfigurationValueBenchmark::fromStringInt,
+                   &ConfigurationValueBenchmark::fromStringIntStream}, 50);
+
+    addBenchmarks({&ConfigurationValueBenchmark::saveGlyphs,
+                   &ConfigurationValueBenchmark::saveGlyphsStream,
+                   &ConfigurationValueBenchmark::loadGlyphs,
+                   &ConfigurationValueBenchmark::loadGlyphsStream}, 10);
+}
+
+typedef Math::Vector2<Int> Vector2i;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Range2D<Float> Range2D;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Matrix4<Int> Matrix4i;
+
+enum: std::size_t { Repeats = 1000, GlyphCount = 256 };
+
+const Matrix4 DataFloat{
+    {1.0f/3.0f, 0.75f, -2.5f, 0.0f},
+    {123.456f, 9.55f, 1.0e-5f, 1.0f},
+    {-0.1f, 16.0f, 3.14159f, 0.0f},
+    {25.3f, -7.125f, 0.5f, 1.0f}};
+
+const Matrix4i DataInt{
+    {1, 75, -25, 0},
+    {123456, 955, -100000, 1},
+    {-1, 16, 314159, 0},
+    {253, -7125, 5, 2147483647}};
+
+/* What the ConfigurationValue specializations used before, each component
+   going through its own std::stringstream */
+template<class T> std::string toStringStream(const Math::Matrix4<T>& value) {
+    std::string out;
+    for(std::size_t row = 0; row != 4; ++row) {
+        for(std::size_t col = 0; col != 4; ++col) {
+            if(!out.empty()) out += ' ';
+            out += Corrade::Utility::ConfigurationValue<T>::toString(value[col][row], {});
+        }
+    }
+    return out;
+}
+
+template<class T> Math::Matrix4<T> fromStringStream(const std::string& value) {
+    Math::Matrix4<T> out;
+    std::size_t oldpos = 0, pos = std::string::npos, i = 0;
+    do {
+        pos = value.find(' ', oldpos);
+        std::string part = value.substr(oldpos, pos-oldpos);
+
+        if(!part.empty()) {
+            out[i%4][i/4] = Corrade::Utility::ConfigurationValue<T>::fromString(part, {});
+            ++i;
+        }
+
+        oldpos = pos+1;
+    } while(pos != std::string::npos && i != 16);
+    return out;
+}
+
+/* Same as above for an arbitrary component count, used for the glyph data */
+template<class T> std::string toStringStream(const T* const data, const std::size_t count) {
+    std::string out;
+    for(std::size_t i = 0; i != count; ++i) {
+        if(!out.empty()) out += ' ';
+        out += Corrade::Utility::ConfigurationValue<T>::toString(data[i], {});
+    }
+    return out;
+}
+
+template<class T> void fromStringStream(const std::string& value, T* const out, const std::size_t count) {
+    std::size_t oldpos = 0, pos = std::string::npos, i = 0;
+    do {
+        pos = value.find(' ', oldpos);
+        std::string part = value.substr(oldpos, pos-oldpos);
+
+        if(!part.empty()) {
+            out[i] = Corrade::Utility::ConfigurationValue<T>::fromString(part, {});
+            ++i;
+        }
+
+        oldpos = pos+1;
+    } while(pos != std::string::npos && i != count);
+}
+
+void ConfigurationValueBenchmark::toStringFloat() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        size += Corrade::Utility::ConfigurationValue<Matrix4>::toString(DataFloat, {}).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void ConfigurationValueBenchmark::toStringFloatStream() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        size += toStringStream(DataFloat).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void ConfigurationValueBenchmark::fromStringFloat() {
+    const std::string data = Corrade::Utility::ConfigurationValue<Matrix4>::toString(DataFloat, {});
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += Corrade::Utility::ConfigurationValue<Matrix4>::fromString(data, {})[1][0];
+    }
+
+    CORRADE_VERIFY(sum != 0.0f);
+}
+
+void ConfigurationValueBenchmark::fromStringFloatStream() {
+    const std::string data = Corrade::Utility::ConfigurationValue<Matrix4>::toString(DataFloat, {});
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += fromStringStream<Float>(data)[1][0];
+    }
+
+    CORRADE_VERIFY(sum != 0.0f);
+}
+
+void ConfigurationValueBenchmark::toStringInt() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        size += Corrade::Utility::ConfigurationValue<Matrix4i>::toString(DataInt, {}).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void ConfigurationValueBenchmark::toStringIntStream() {
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        size += toStringStream(DataInt).size();
+    }
+
+    CORRADE_VERIFY(size);
+}
+
+void ConfigurationValueBenchmark::fromStringInt() {
+    const std::string data = Corrade::Utility::ConfigurationValue<Matrix4i>::toString(DataInt, {});
+
+    Int sum = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += Corrade::Utility::ConfigurationValue<Matrix4i>::fromString(data, {})[1][0];
+    }
+
+    CORRADE_VERIFY(sum != 0);
+}
+
+void ConfigurationValueBenchmark::fromStringIntStream() {
+    const std::string data = Corrade::Utility::ConfigurationValue<Matrix4i>::toString(DataInt, {});
+
+    Int sum = 0;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += fromStringStream<Int>(data)[1][0];
+    }
+
+    CORRADE_VERIFY(sum != 0);
+}
+
+/* Same layout of glyph data as the MagnumFont plugin and its converter
+   use */
+void ConfigurationValueBenchmark::saveGlyphs() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        Corrade::Utility::Configuration conf;
+        for(std::size_t i = 0; i != GlyphCount; ++i) {
+            Corrade::Utility::ConfigurationGroup* group = conf.addGroup("glyph");
+            group->setValue("advance", Vector2{Float(i)*0.37f, 0.0f});
+            group->setValue("position", Vector2i{Int(i), -Int(i)});
+            group->setValue("rectangle", Range2D{{Float(i)/GlyphCount, 0.0f}, {Float(i + 1)/GlyphCount, 1.0f/3.0f}});
+        }
+        count += conf.groupCount("glyph");
+    }
+
+    CORRADE_COMPARE(count, std::size_t(GlyphCount));
+}
+
+void ConfigurationValueBenchmark::saveGlyphsStream() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        Corrade::Utility::Configuration conf;
+        for(std::size_t i = 0; i != GlyphCount; ++i) {
+            const Vector2 advance{Float(i)*0.37f, 0.0f};
+            const Vector2i position{Int(i), -Int(i)};
+            const Range2D rectangle{{Float(i)/GlyphCount, 0.0f}, {Float(i + 1)/GlyphCount, 1.0f/3.0f}};
+
+            Corrade::Utility::ConfigurationGroup* group = conf.addGroup("glyph");
+            group->setValue("advance", toStringStream(advance.data(), 2));
+            group->setValue("position", toStringStream(position.data(), 2));
+            group->setValue("rectangle", toStringStream(rectangle.data(), 4));
+        }
+        count += conf.groupCount("glyph");
+    }
+
+    CORRADE_COMPARE(count, std::size_t(GlyphCount));
+}
+
+void ConfigurationValueBenchmark::loadGlyphs() {
+    Corrade::Utility::Configuration conf;
+    for(std::size_t i = 0; i != GlyphCount; ++i) {
+        Corrade::Utility::ConfigurationGroup* group = conf.addGroup("glyph");
+        group->setValue("advance", Vector2{Float(i)*0.37f, 0.0f});
+        group->setValue("position", Vector2i{Int(i), -Int(i)});
+        group->setValue("rectangle", Range2D{{Float(i)/GlyphCount, 0.0f}, {Float(i + 1)/GlyphCount, 1.0f/3.0f}});
+    }
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(const Corrade::Utility::ConfigurationGroup* group: conf.groups("glyph")) {
+            sum += group->value<Vector2>("advance").x();
+            sum += Float(group->value<Vector2i>("position").x());
+            sum += group->value<Range2D>("rectangle").sizeX();
+        }
+    }
+
+    CORRADE_VERIFY(sum != 0.0f);
+}
+
+void ConfigurationValueBenchmark::loadGlyphsStream() {
+    Corrade::Utility::Configuration conf;
+    for(std::size_t i = 0; i != GlyphCount; ++i) {
+        Corrade::Utility::ConfigurationGroup* group = conf.addGroup("glyph");
+        group->setValue("advance", Vector2{Float(i)*0.37f, 0.0f});
+        group->setValue("position", Vector2i{Int(i), -Int(i)});
+        group->setValue("rectangle", Range2D{{Float(i)/GlyphCount, 0.0f}, {Float(i + 1)/GlyphCount, 1.0f/3.0f}});
+    }
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(1) {
+        for(const Corrade::Utility::ConfigurationGroup* group: conf.groups("glyph")) {
+            Vector2 advance;
+            Vector2i position;
+            Range2D rectangle;
+            fromStringStream(group->value("advance"), advance.data(), 2);
+            fromStringStream(group->value("position"), position.data(), 2);
+            fromStringStream(group->value("rectangle"), rectangle.data(), 4);
+            sum += advance.x();
+            sum += Float(position.x());
+            sum += rectangle.sizeX();
+        }
+    }
+
+    CORRADE_VERIFY(sum != 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::ConfigurationValueBenchmark)
@@ -23,6 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <clocale>
+#include <limits>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -56,6 +59,41 @@ struct ConfigurationValueTest: Corrade::TestSuite::Tester {
     void dualQuaternion();
 
     void bezier();
+
+    void roundTripFloat();
+    void roundTripDouble();
+    void roundTripInteger();
+    void whitespace();
+    void invalid();
+    void flags();
+    void locale();
+};
+
+const struct {
+    const char* name;
+    Float value;
+    const char* string;
+} RoundTripFloatData[]{
+    {"one third", 1.0f/3.0f, "0.33333334"},
+    {"seven digits", 123456.79f, "123456.79"},
+    {"large integer", 16777216.0f, "16777216"},
+    {"small", 1.0e-7f, "1e-07"},
+    {"max", std::numeric_limits<Float>::max(), "3.4028235e+38"},
+    {"min", std::numeric_limits<Float>::min(), "1.1754944e-38"},
+    {"denormal", std::numeric_limits<Float>::denorm_min(), "1.4013e-45"}
+};
+
+const struct {
+    const char* name;
+    Double value;
+    const char* string;
+} RoundTripDoubleData[]{
+    {"one tenth", 0.1, "0.1"},
+    {"sum", 0.1 + 0.2, "0.30000000000000004"},
+    {"one third", 1.0/3.0, "0.3333333333333333"},
+    {"large integer", 9007199254740992.0, "9007199254740992"},
+    {"large", 1.0e23, "1e+23"},
+    {"max", std::numeric_limits<Double>::max(), "1.7976931348623157e+308"}
 };
 
 ConfigurationValueTest::ConfigurationValueTest() {
@@ -81,6 +119,18 @@ ConfigurationValueTest::ConfigurationValueTest() {
               &ConfigurationValueTest::dualQuaternion,
 
               &ConfigurationValueTest::bezier});
+
+    addInstancedTests({&ConfigurationValueTest::roundTripFloat},
+        Corrade::Containers::arraySize(RoundTripFloatData));
+
+    addInstancedTests({&ConfigurationValueTest::roundTripDouble},
+        Corrade::Containers::arraySize(RoundTripDoubleData));
+
+    addTests({&ConfigurationValueTest::roundTripInteger,
+              &ConfigurationValueTest::whitespace,
+              &ConfigurationValueTest::invalid,
+              &ConfigurationValueTest::flags,
+              &ConfigurationValueTest::locale});
 }
 
 void ConfigurationValueTest::deg() {
@@ -379,6 +429,117 @@ void ConfigurationValueTest::bezier() {
     CORRADE_COMPARE(c.value<CubicBezier2D>("bezier"), bezier);
 }
 
+void ConfigurationValueTest::roundTripFloat() {
+    auto&& data = RoundTripFloatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Utility::Configuration c;
+
+    c.setValue("value", Math::Vector2<Float>{data.value, -data.value});
+    CORRADE_COMPARE(c.value("value"), std::string{data.string} + " -" + data.string);
+
+    /* Not using fuzzy compare, the value has to be exactly the same */
+    const Math::Vector2<Float> parsed = c.value<Math::Vector2<Float>>("value");
+    CORRADE_VERIFY(parsed[0] == data.value);
+    CORRADE_VERIFY(parsed[1] == -data.value);
+}
+
+void ConfigurationValueTest::roundTripDouble() {
+    auto&& data = RoundTripDoubleData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Utility::Configuration c;
+
+    c.setValue("value", Math::Vector2<Double>{data.value, -data.value});
+    CORRADE_COMPARE(c.value("value"), std::string{data.string} + " -" + data.string);
+
+    /* Not using fuzzy compare, the value has to be exactly the same */
+    const Math::Vector2<Double> parsed = c.value<Math::Vector2<Double>>("value");
+    CORRADE_VERIFY(parsed[0] == data.value);
+    CORRADE_VERIFY(parsed[1] == -data.value);
+}
+
+void ConfigurationValueTest::roundTripInteger() {
+    typedef Math::Vector3<Int> Vector3i;
+    typedef Math::Vector3<UnsignedInt> Vector3ui;
+
+    Corrade::Utility::Configuration c;
+
+    Vector3i a{std::numeric_limits<Int>::min(), 0, std::numeric_limits<Int>::max()};
+    c.setValue("int", a);
+    CORRADE_COMPARE(c.value("int"), "-2147483648 0 2147483647");
+    CORRADE_COMPARE(c.value<Vector3i>("int"), a);
+
+    Vector3ui b{0, 17, std::numeric_limits<UnsignedInt>::max()};
+    c.setValue("unsigned", b);
+    CORRADE_COMPARE(c.value("unsigned"), "0 17 4294967295");
+    CORRADE_COMPARE(c.value<Vector3ui>("unsigned"), b);
+
+    /* Out-of-range values saturate */
+    c.setValue("overflow", "-3000000000 +3000000000 7");
+    CORRADE_COMPARE(c.value<Vector3i>("overflow"), (Vector3i{std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max(), 7}));
+}
+
+void ConfigurationValueTest::whitespace() {
+    typedef Math::Vector4<Float> Vector4;
+
+    Corrade::Utility::Configuration c;
+
+    c.setValue("vector", "  3\t3.125   9\n9.55 ");
+    CORRADE_COMPARE(c.value<Vector4>("vector"), (Vector4{3.0f, 3.125f, 9.0f, 9.55f}));
+}
+
+void ConfigurationValueTest::invalid() {
+    typedef Math::Vector4<Float> Vector4;
+    typedef Math::Vector3<Int> Vector3i;
+
+    Corrade::Utility::Configuration c;
+
+    /* Unparseable values are zero, trailing garbage is ignored */
+    c.setValue("float", "2.5 abc 1e 7.5f");
+    CORRADE_COMPARE(c.value<Vector4>("float"), (Vector4{2.5f, 0.0f, 1.0f, 7.5f}));
+    c.setValue("int", "- 17.5 0x10");
+    CORRADE_COMPARE(c.value<Vector3i>("int"), (Vector3i{0, 17, 0}));
+
+    /* Special values */
+    c.setValue("special", "inf -inf nan 1");
+    const Vector4 special = c.value<Vector4>("special");
+    CORRADE_COMPARE(special[0], std::numeric_limits<Float>::infinity());
+    CORRADE_COMPARE(special[1], -std::numeric_limits<Float>::infinity());
+    CORRADE_VERIFY(special[2] != special[2]);
+    CORRADE_COMPARE(special[3], 1.0f);
+}
+
+void ConfigurationValueTest::flags() {
+    typedef Math::Vector2<Int> Vector2i;
+
+    Corrade::Utility::Configuration c;
+
+    /* Non-default flags go through the generic implementation */
+    c.setValue("hex", Vector2i{255, 16}, 0, Corrade::Utility::ConfigurationValueFlag::Hex);
+    CORRADE_COMPARE(c.value("hex"), "ff 10");
+    CORRADE_COMPARE(c.value<Vector2i>("hex", 0, Corrade::Utility::ConfigurationValueFlag::Hex), (Vector2i{255, 16}));
+}
+
+void ConfigurationValueTest::locale() {
+    typedef Math::Vector2<Float> Vector2;
+
+    if(!std::setlocale(LC_NUMERIC, "de_DE.UTF-8") && !std::setlocale(LC_NUMERIC, "de_DE") && !std::setlocale(LC_NUMERIC, "German"))
+        CORRADE_SKIP("No locale with a decimal comma available.");
+
+    Corrade::Utility::Configuration c;
+
+    /* Decimal comma in the locale shouldn't affect anything */
+    c.setValue("vector", Vector2{3.125f, 1.0f/3.0f});
+    const std::string value = c.value("vector");
+    const Vector2 parsed = c.value<Vector2>("vector");
+    std::setlocale(LC_NUMERIC, "C");
+
+    CORRADE_COMPARE(value, "3.125 0.33333334");
+    CORRADE_VERIFY(parsed[0] == 3.125f);
+    CORRADE_VERIFY(parsed[1] == 1.0f/3.0f);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::ConfigurationValueTest)
@@ -32,6 +32,7 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/TransformationPacking.h"
 #include "Magnum/Math/Vector4.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
@@ -54,9 +55,13 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     template<class T> void castUnsigned();
     template<class T> void castSigned();
 
+    template<class T> void packUnpackQuaternion();
+    template<class T> void packUnpackTranslation();
+
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
     template<class T> void assertionsCast();
+    void assertionsQuaternionTranslation();
 };
 
 PackingBatchTest::PackingBatchTest() {
@@ -79,6 +84,12 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::castSigned<Short>,
               &PackingBatchTest::castSigned<Int>,
 
+              &PackingBatchTest::packUnpackQuaternion<UnsignedInt>,
+              &PackingBatchTest::packUnpackQuaternion<Math::Vector3<UnsignedShort>>,
+              &PackingBatchTest::packUnpackQuaternion<UnsignedLong>,
+              &PackingBatchTest::packUnpackTranslation<UnsignedByte>,
+              &PackingBatchTest::packUnpackTranslation<UnsignedShort>,
+
               &PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
               &PackingBatchTest::assertionsPackUnpack<Byte>,
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
@@ -89,7 +100,8 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::assertionsCast<UnsignedShort>,
               &PackingBatchTest::assertionsCast<Short>,
               &PackingBatchTest::assertionsCast<UnsignedInt>,
-              &PackingBatchTest::assertionsCast<Int>});
+              &PackingBatchTest::assertionsCast<Int>,
+              &PackingBatchTest::assertionsQuaternionTranslation});
 }
 
 typedef Math::Constants<Float> Constants;
@@ -100,6 +112,9 @@ typedef Math::Vector2<Short> Vector2s;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
+typedef Math::Rad<Float> Rad;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Range3D<Float> Range3D;
 
 void PackingBatchTest::unpackUnsignedByte() {
     /* Test data adapted from PackingTest */
@@ -479,6 +494,71 @@ template<class T> void PackingBatchTest::castSigned() {
         Corrade::TestSuite::Compare::Container);
 }
 
+template<class> struct QuaternionPackingName;
+template<> struct QuaternionPackingName<UnsignedInt> {
+    static const char* name() { return "UnsignedInt"; }
+};
+template<> struct QuaternionPackingName<Math::Vector3<UnsignedShort>> {
+    static const char* name() { return "Vector3us"; }
+};
+template<> struct QuaternionPackingName<UnsignedLong> {
+    static const char* name() { return "UnsignedLong"; }
+};
+
+template<class T> void PackingBatchTest::packUnpackQuaternion() {
+    setTestCaseTemplateName(QuaternionPackingName<T>::name());
+
+    struct Data {
+        Quaternion src;
+        T packed;
+        Quaternion dst;
+    } data[]{
+        {{}, {}, {}},
+        {Quaternion::rotation(Rad{1.2f}, Vector3{1.0f, 2.0f, 3.0f}.normalized()), {}, {}},
+        {Quaternion::rotation(Rad{4.5f}, Vector3{-3.0f, 1.0f, 0.5f}.normalized()), {}, {}},
+        {Quaternion::rotation(Rad{2.8f}, Vector3{0.0f, -1.0f, 0.0f}), {}, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Quaternion> src{data, &data[0].src, 4, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<T> packed{data, &data[0].packed, 4, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Quaternion> dst{data, &data[0].dst, 4, sizeof(Data)};
+    packQuaternionInto(src, packed);
+    unpackQuaternionInto(packed, dst);
+
+    /* Ensure the results are bit-exact with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_COMPARE(data[i].packed, packQuaternion<T>(data[i].src));
+        CORRADE_COMPARE(data[i].dst, unpackQuaternion<Float>(data[i].packed));
+    }
+}
+
+template<class T> void PackingBatchTest::packUnpackTranslation() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Range3D range{{-10.0f, 0.0f, -10.0f}, {10.0f, 5.0f, 10.0f}};
+    struct Data {
+        Vector3 src;
+        Math::Vector3<T> packed;
+        Vector3 dst;
+    } data[]{
+        {{-10.0f, 0.0f, 10.0f}, {}, {}},
+        {{1.337f, 4.2f, -6.66f}, {}, {}},
+        {{50.0f, -3.0f, 0.0f}, {}, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<Vector3> src{data, &data[0].src, 3, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Math::Vector3<T>> packed{data, &data[0].packed, 3, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3> dst{data, &data[0].dst, 3, sizeof(Data)};
+    packTranslationInto(src, range, packed);
+    unpackTranslationInto(packed, range, dst);
+
+    /* Ensure the results are bit-exact with non-batch APIs */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_COMPARE(data[i].packed, packTranslation<T>(data[i].src, range));
+        CORRADE_COMPARE(data[i].dst, unpackTranslation(data[i].packed, range));
+    }
+}
+
 template<class T> void PackingBatchTest::assertionsPackUnpack() {
     Math::Vector2<T> data[2]{};
     Vector2 resultWrongCount[1]{};
@@ -575,6 +655,33 @@ template<class T> void PackingBatchTest::assertionsCast() {
         "Math::castInto(): second view dimension is not contiguous\n");
 }
 
+void PackingBatchTest::assertionsQuaternionTranslation() {
+    Quaternion quaternions[2];
+    UnsignedInt packedQuaternions[3]{};
+    Vector3 translations[2];
+    Math::Vector3<UnsignedShort> packedTranslations[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packQuaternionInto(
+        Corrade::Containers::stridedArrayView(quaternions),
+        Corrade::Containers::stridedArrayView(packedQuaternions));
+    unpackQuaternionInto(
+        Corrade::Containers::stridedArrayView(packedQuaternions),
+        Corrade::Containers::stridedArrayView(quaternions));
+    packTranslationInto(
+        Corrade::Containers::stridedArrayView(translations), {},
+        Corrade::Containers::stridedArrayView(packedTranslations));
+    unpackTranslationInto(
+        Corrade::Containers::stridedArrayView(packedTranslations), {},
+        Corrade::Containers::stridedArrayView(translations));
+    CORRADE_COMPARE(out.str(),
+        "Math::packQuaternionInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::unpackQuaternionInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::packTranslationInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::unpackTranslationInto(): wrong destination size, got 2 but expected 3\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchTest)
@@ -0,0 +1,164 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/TransformationPacking.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformationPackingBenchmark: Corrade::TestSuite::Tester {
+    explicit TransformationPackingBenchmark();
+
+    template<class T> void packQuaternion();
+    template<class T> void unpackQuaternion();
+    template<class T> void packTranslation();
+    template<class T> void unpackTranslation();
+};
+
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Rad<Float> Rad;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector3<UnsignedShort> Vector3us;
+
+template<class> struct PackingTraits;
+template<> struct PackingTraits<UnsignedByte> {
+    static const char* name() { return "UnsignedByte"; }
+};
+template<> struct PackingTraits<UnsignedShort> {
+    static const char* name() { return "UnsignedShort"; }
+};
+template<> struct PackingTraits<UnsignedInt> {
+    static const char* name() { return "UnsignedInt"; }
+};
+template<> struct PackingTraits<Vector3us> {
+    static const char* name() { return "Vector3us"; }
+};
+template<> struct PackingTraits<UnsignedLong> {
+    static const char* name() { return "UnsignedLong"; }
+};
+
+/* A typical count of replicated objects in a large scene */
+enum: std::size_t { TransformCount = 100000 };
+
+const Range3D TranslationRange{{-1000.0f, -10.0f, -1000.0f}, {1000.0f, 100.0f, 1000.0f}};
+
+TransformationPackingBenchmark::TransformationPackingBenchmark() {
+    addBenchmarks({&TransformationPackingBenchmark::packQuaternion<UnsignedInt>,
+                   &TransformationPackingBenchmark::packQuaternion<Vector3us>,
+                   &TransformationPackingBenchmark::packQuaternion<UnsignedLong>,
+                   &TransformationPackingBenchmark::unpackQuaternion<UnsignedInt>,
+                   &TransformationPackingBenchmark::unpackQuaternion<Vector3us>,
+                   &TransformationPackingBenchmark::unpackQuaternion<UnsignedLong>,
+                   &TransformationPackingBenchmark::packTranslation<UnsignedByte>,
+                   &TransformationPackingBenchmark::packTranslation<UnsignedShort>,
+                   &TransformationPackingBenchmark::unpackTranslation<UnsignedByte>,
+                   &TransformationPackingBenchmark::unpackTranslation<UnsignedShort>}, 10);
+}
+
+/* Deterministic rotations around various axes, so the largest component
+   isn't always the same */
+Corrade::Containers::Array<Quaternion> quaternions() {
+    Corrade::Containers::Array<Quaternion> out{Corrade::Containers::NoInit, TransformCount};
+    for(std::size_t i = 0; i != TransformCount; ++i) {
+        const Float f = Float(i);
+        out[i] = Quaternion::rotation(Rad(f*0.0137f),
+            Vector3{Math::sin(Rad(f*0.71f)), Math::cos(Rad(f*0.29f)), 0.5f}.normalized());
+    }
+    return out;
+}
+
+Corrade::Containers::Array<Vector3> translations() {
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::NoInit, TransformCount};
+    for(std::size_t i = 0; i != TransformCount; ++i) {
+        const Float f = Float(i);
+        out[i] = TranslationRange.min() + TranslationRange.size()*
+            Vector3{Math::abs(Math::sin(Rad(f*0.37f))), Math::abs(Math::cos(Rad(f*0.11f))), f/TransformCount};
+    }
+    return out;
+}
+
+template<class T> void TransformationPackingBenchmark::packQuaternion() {
+    setTestCaseTemplateName(PackingTraits<T>::name());
+
+    const Corrade::Containers::Array<Quaternion> src = quaternions();
+    Corrade::Containers::Array<T> dst{Corrade::Containers::NoInit, TransformCount};
+    CORRADE_BENCHMARK(1)
+        packQuaternionInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)), Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(dst)));
+
+    /* Spot-check against the single-value API */
+    CORRADE_COMPARE(dst[TransformCount/3], Math::packQuaternion<T>(src[TransformCount/3]));
+    CORRADE_COMPARE(dst[TransformCount - 1], Math::packQuaternion<T>(src[TransformCount - 1]));
+}
+
+template<class T> void TransformationPackingBenchmark::unpackQuaternion() {
+    setTestCaseTemplateName(PackingTraits<T>::name());
+
+    const Corrade::Containers::Array<Quaternion> original = quaternions();
+    Corrade::Containers::Array<T> src{Corrade::Containers::NoInit, TransformCount};
+    packQuaternionInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(original)), Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)));
+
+    Corrade::Containers::Array<Quaternion> dst{Corrade::Containers::NoInit, TransformCount};
+    CORRADE_BENCHMARK(1)
+        unpackQuaternionInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)), Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(dst)));
+
+    CORRADE_COMPARE(dst[TransformCount/3], Math::unpackQuaternion<Float>(src[TransformCount/3]));
+    CORRADE_COMPARE(dst[TransformCount - 1], Math::unpackQuaternion<Float>(src[TransformCount - 1]));
+}
+
+template<class T> void TransformationPackingBenchmark::packTranslation() {
+    setTestCaseTemplateName(PackingTraits<T>::name());
+
+    const Corrade::Containers::Array<Vector3> src = translations();
+    Corrade::Containers::Array<Math::Vector3<T>> dst{Corrade::Containers::NoInit, TransformCount};
+    CORRADE_BENCHMARK(1)
+        packTranslationInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)), TranslationRange, Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(dst)));
+
+    CORRADE_COMPARE(dst[TransformCount/3], Math::packTranslation<T>(src[TransformCount/3], TranslationRange));
+    CORRADE_COMPARE(dst[TransformCount - 1], Math::packTranslation<T>(src[TransformCount - 1], TranslationRange));
+}
+
+template<class T> void TransformationPackingBenchmark::unpackTranslation() {
+    setTestCaseTemplateName(PackingTraits<T>::name());
+
+    const Corrade::Containers::Array<Vector3> original = translations();
+    Corrade::Containers::Array<Math::Vector3<T>> src{Corrade::Containers::NoInit, TransformCount};
+    packTranslationInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(original)), TranslationRange, Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)));
+
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, TransformCount};
+    CORRADE_BENCHMARK(1)
+        unpackTranslationInto(Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(src)), TranslationRange, Corrade::Containers::stridedArrayView(Corrade::Containers::arrayView(dst)));
+
+    CORRADE_COMPARE(dst[TransformCount/3], Math::unpackTranslation(src[TransformCount/3], TranslationRange));
+    CORRADE_COMPARE(dst[TransformCount - 1], Math::unpackTranslation(src[TransformCount - 1], TranslationRange));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformationPackingBenchmark)
@@ -0,0 +1,274 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TransformationPacking.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformationPackingTest: Corrade::TestSuite::Tester {
+    explicit TransformationPackingTest();
+
+    void packQuaternionIdentity32();
+    void packQuaternionIdentity48();
+    void packQuaternionIdentity64();
+    void packQuaternion32();
+    void packQuaternion48();
+    void packQuaternion64();
+    template<class T> void packQuaternionSign();
+    template<class T> void packQuaternionErrorBound();
+    void packQuaternionNotNormalized();
+
+    void packTranslation();
+    void packTranslationClamp();
+    void packTranslationZeroSizeAxis();
+
+    void packDualQuaternion();
+    void packDualQuaternionNotNormalized();
+};
+
+using namespace Literals;
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Deg<Double> Degd;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Quaternion<Double> Quaterniond;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<Double> Vector3d;
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector3<UnsignedShort> Vector3us;
+
+template<class> struct QuaternionPackingTraits;
+template<> struct QuaternionPackingTraits<UnsignedInt> {
+    typedef Float Type;
+    static const char* name() { return "UnsignedInt"; }
+    static Double maxAngle() { return 0.25; }
+};
+template<> struct QuaternionPackingTraits<Vector3us> {
+    typedef Float Type;
+    static const char* name() { return "Vector3us"; }
+    static Double maxAngle() { return 0.008; }
+};
+template<> struct QuaternionPackingTraits<UnsignedLong> {
+    /* The 64-bit representation is more precise than a Float can verify */
+    typedef Double Type;
+    static const char* name() { return "UnsignedLong"; }
+    static Double maxAngle() { return 0.00025; }
+};
+
+/* Angle between the two rotations in degrees. Calculated from the distance
+   and not from acos() of the dot product, which is too imprecise for small
+   angles. */
+template<class T> Double rotationDifference(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b) {
+    const Quaterniond ad{a};
+    const Quaterniond bd{b};
+    const Double distance = Math::min((ad - bd).length(), (ad + bd).length());
+    return Double(Degd(Math::Rad<Double>(4.0*std::asin(distance*0.5))));
+}
+
+TransformationPackingTest::TransformationPackingTest() {
+    addTests({&TransformationPackingTest::packQuaternionIdentity32,
+              &TransformationPackingTest::packQuaternionIdentity48,
+              &TransformationPackingTest::packQuaternionIdentity64,
+              &TransformationPackingTest::packQuaternion32,
+              &TransformationPackingTest::packQuaternion48,
+              &TransformationPackingTest::packQuaternion64,
+              &TransformationPackingTest::packQuaternionSign<UnsignedInt>,
+              &TransformationPackingTest::packQuaternionSign<Vector3us>,
+              &TransformationPackingTest::packQuaternionSign<UnsignedLong>});
+
+    addRepeatedTests<TransformationPackingTest>({
+        &TransformationPackingTest::packQuaternionErrorBound<UnsignedInt>,
+        &TransformationPackingTest::packQuaternionErrorBound<Vector3us>,
+        &TransformationPackingTest::packQuaternionErrorBound<UnsignedLong>}, 1000);
+
+    addTests({&TransformationPackingTest::packQuaternionNotNormalized,
+
+              &TransformationPackingTest::packTranslation,
+              &TransformationPackingTest::packTranslationClamp,
+              &TransformationPackingTest::packTranslationZeroSizeAxis,
+
+              &TransformationPackingTest::packDualQuaternion,
+              &TransformationPackingTest::packDualQuaternionNotNormalized});
+}
+
+void TransformationPackingTest::packQuaternionIdentity32() {
+    /* Index of W and three zeros in the middle of the range */
+    CORRADE_COMPARE(packQuaternion<UnsignedInt>(Quaternion{}), 0xdff7fdff);
+    CORRADE_COMPARE(unpackQuaternion<Float>(0xdff7fdffu), Quaternion{});
+}
+
+void TransformationPackingTest::packQuaternionIdentity48() {
+    /* Index of W split into the top bits of the first two components */
+    CORRADE_COMPARE(packQuaternion<Vector3us>(Quaternion{}), (Vector3us{0xbfff, 0xbfff, 0x3fff}));
+    CORRADE_COMPARE(unpackQuaternion<Float>(Vector3us{0xbfff, 0xbfff, 0x3fff}), Quaternion{});
+}
+
+void TransformationPackingTest::packQuaternionIdentity64() {
+    CORRADE_COMPARE(packQuaternion<UnsignedLong>(Quaternion{}), UnsignedLong{0xc7ffff7ffff7ffffull});
+    CORRADE_COMPARE(unpackQuaternion<Float>(UnsignedLong{0xc7ffff7ffff7ffffull}), Quaternion{});
+}
+
+void TransformationPackingTest::packQuaternion32() {
+    const Quaternion a = Quaternion::rotation(30.0_degf, Vector3{1.0f, 2.0f, 3.0f}.normalized());
+    const UnsignedInt packed = packQuaternion<UnsignedInt>(a);
+    CORRADE_COMPARE(packed, 0xe3198e95);
+
+    const Quaternion b = unpackQuaternion<Float>(packed);
+    CORRADE_VERIFY(b.isNormalized());
+    CORRADE_COMPARE(b, (Quaternion{{0.0691885f, 0.138377f, 0.207566f}, 0.96591f}));
+}
+
+void TransformationPackingTest::packQuaternion48() {
+    const Quaternion a = Quaternion::rotation(30.0_degf, Vector3{1.0f, 2.0f, 3.0f}.normalized());
+    const Vector3us packed = packQuaternion<Vector3us>(a);
+    /* 17986, 19588, 21191 with the W index in the top bits */
+    CORRADE_COMPARE(packed, (Vector3us{0xc642, 0xcc84, 0x52c7}));
+
+    const Quaternion b = unpackQuaternion<Float>(packed);
+    CORRADE_VERIFY(b.isNormalized());
+    CORRADE_COMPARE(b, (Quaternion{{0.0691871f, 0.138331f, 0.207518f}, 0.965926f}));
+}
+
+void TransformationPackingTest::packQuaternion64() {
+    /* Verifying with doubles, as floats don't have enough precision for the
+       exact bit pattern */
+    const Quaterniond a = Quaterniond::rotation(Degd(30.0), Vector3d{1.0, 2.0, 3.0}.normalized());
+    const UnsignedLong packed = packQuaternion<UnsignedLong>(a);
+    CORRADE_COMPARE(packed, UnsignedLong{(3ull << 62)|(575575ull << 40)|(626863ull << 20)|678151ull});
+
+    const Quaterniond b = unpackQuaternion<Double>(packed);
+    CORRADE_VERIFY(b.isNormalized());
+    CORRADE_COMPARE(b, (Quaterniond{{0.0691722140611834, 0.138344428122367, 0.207516642183550}, 0.965925911872248}));
+}
+
+template<class T> void TransformationPackingTest::packQuaternionSign() {
+    setTestCaseTemplateName(QuaternionPackingTraits<T>::name());
+
+    typedef typename QuaternionPackingTraits<T>::Type Type;
+
+    /* q and -q are the same rotation, so they should give the same result.
+       The largest component, X, is negative here. */
+    const Math::Quaternion<Type> a = Math::Quaternion<Type>::rotation(Math::Deg<Type>(250.0), Math::Vector3<Type>{-3.0, 1.0, 0.5}.normalized());
+    CORRADE_VERIFY(a.vector().x() < Type(0.0));
+    CORRADE_COMPARE(packQuaternion<T>(a), packQuaternion<T>(-a));
+    CORRADE_COMPARE_AS(rotationDifference(a, unpackQuaternion<Type>(packQuaternion<T>(a))),
+        QuaternionPackingTraits<T>::maxAngle(),
+        Corrade::TestSuite::Compare::Less);
+}
+
+template<class T> void TransformationPackingTest::packQuaternionErrorBound() {
+    setTestCaseTemplateName(QuaternionPackingTraits<T>::name());
+
+    typedef typename QuaternionPackingTraits<T>::Type Type;
+
+    /* Deterministic pseudo-random rotations covering all four possible
+       largest components and both signs */
+    const Type i = Type(testCaseRepeatId());
+    const Math::Quaternion<Type> a = Math::Quaternion<Type>::rotation(
+        Math::Deg<Type>(i*Type(0.731)),
+        Math::Vector3<Type>{std::sin(i*Type(0.37)), std::cos(i*Type(1.91)), std::sin(i*Type(2.73) + Type(1.0))}.normalized());
+
+    const Math::Quaternion<Type> b = unpackQuaternion<Type>(packQuaternion<T>(a));
+    CORRADE_VERIFY(b.isNormalized());
+    CORRADE_COMPARE_AS(rotationDifference(a, b),
+        QuaternionPackingTraits<T>::maxAngle(),
+        Corrade::TestSuite::Compare::Less);
+}
+
+void TransformationPackingTest::packQuaternionNotNormalized() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    packQuaternion<UnsignedInt>(Quaternion{{1.0f, 2.0f, 3.0f}, 4.0f});
+    CORRADE_COMPARE(out.str(), "Math::packQuaternion(): Quaternion({1, 2, 3}, 4) is not normalized\n");
+}
+
+void TransformationPackingTest::packTranslation() {
+    const Range3D range{{-100.0f, 0.0f, -100.0f}, {100.0f, 50.0f, 100.0f}};
+
+    CORRADE_COMPARE(Math::packTranslation<UnsignedShort>(Vector3{-100.0f, 0.0f, 100.0f}, range), (Vector3us{0, 0, 65535}));
+    CORRADE_COMPARE(Math::packTranslation<UnsignedShort>(Vector3{0.0f, 25.0f, 50.0f}, range), (Vector3us{32768, 32768, 49151}));
+    CORRADE_COMPARE(Math::packTranslation<UnsignedByte>(Vector3{0.0f, 25.0f, 50.0f}, range), (Vector3ub{128, 128, 191}));
+
+    CORRADE_COMPARE(Math::unpackTranslation(Vector3us{0, 0, 65535}, range), (Vector3{-100.0f, 0.0f, 100.0f}));
+
+    /* Error is at most half of the quantization step */
+    const Vector3 a{13.37f, 42.0f, -66.6f};
+    const Vector3 b = Math::unpackTranslation(Math::packTranslation<UnsignedShort>(a, range), range);
+    const Vector3 maxError = range.size()/(2.0f*65535.0f);
+    for(std::size_t i = 0; i != 3; ++i)
+        CORRADE_COMPARE_AS(Math::abs(a[i] - b[i]), maxError[i],
+            Corrade::TestSuite::Compare::LessOrEqual);
+}
+
+void TransformationPackingTest::packTranslationClamp() {
+    const Range3D range{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+
+    CORRADE_COMPARE(Math::packTranslation<UnsignedShort>(Vector3{-5.0f, 0.0f, 5.0f}, range), (Vector3us{0, 32768, 65535}));
+}
+
+void TransformationPackingTest::packTranslationZeroSizeAxis() {
+    /* Flat on Y, which would otherwise be a division by zero */
+    const Range3D range{{-1.0f, 2.0f, -1.0f}, {1.0f, 2.0f, 1.0f}};
+
+    CORRADE_COMPARE(Math::packTranslation<UnsignedShort>(Vector3{0.0f, 7.0f, 1.0f}, range), (Vector3us{32768, 0, 65535}));
+    CORRADE_COMPARE(Math::unpackTranslation(Vector3us{}, range), (Vector3{-1.0f, 2.0f, -1.0f}));
+}
+
+void TransformationPackingTest::packDualQuaternion() {
+    const Range3D range{{-100.0f, -100.0f, -100.0f}, {100.0f, 100.0f, 100.0f}};
+    const DualQuaternion a =
+        DualQuaternion::translation({12.5f, -42.0f, 66.0f})*
+        DualQuaternion::rotation(30.0_degf, Vector3{1.0f, 2.0f, 3.0f}.normalized());
+
+    const std::pair<UnsignedInt, Vector3us> packed = Math::packDualQuaternion<UnsignedInt, UnsignedShort>(a, range);
+    CORRADE_COMPARE(packed.first, 0xe3198e95);
+    CORRADE_COMPARE(packed.second, (Vector3us{36863, 19005, 54394}));
+
+    const DualQuaternion b = Math::unpackDualQuaternion(packed, range);
+    CORRADE_VERIFY(b.isNormalized());
+    CORRADE_COMPARE_AS(rotationDifference(a.rotation(), b.rotation()),
+        QuaternionPackingTraits<UnsignedInt>::maxAngle(),
+        Corrade::TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS((a.translation() - b.translation()).length(), 0.005f,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void TransformationPackingTest::packDualQuaternionNotNormalized() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::packDualQuaternion<UnsignedInt, UnsignedShort>(DualQuaternion{{{1.0f, 2.0f, 3.0f}, 4.0f}, {{}, 0.0f}}, Range3D{});
+    CORRADE_COMPARE(out.str(), "Math::packDualQuaternion(): DualQuaternion({{1, 2, 3}, 4}, {{0, 0, 0}, 0}) is not normalized\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformationPackingTest)
@@ -0,0 +1,257 @@
+#ifndef Magnum_Math_TransformationPacking_h
+#define Magnum_Math_TransformationPacking_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::packQuaternion(), @ref Magnum::Math::unpackQuaternion(), @ref Magnum::Math::packTranslation(), @ref Magnum::Math::unpackTranslation(), @ref Magnum::Math::packDualQuaternion(), @ref Magnum::Math::unpackDualQuaternion()
+ * @m_since_latest
+ */
+
+#include <utility>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Math {
+
+namespace Implementation {
+
+/* Bit layout of the smallest-three representation. The two-bit index of the
+   omitted component is always stored separately from the three quantized
+   components. */
+template<class> struct QuaternionPacking;
+template<> struct QuaternionPacking<UnsignedInt> {
+    enum: UnsignedInt { Bits = 10 };
+
+    static UnsignedInt pack(UnsignedInt index, const Vector3<UnsignedInt>& components) {
+        return index << 30|components[0] << 20|components[1] << 10|components[2];
+    }
+    static UnsignedInt index(UnsignedInt packed) { return packed >> 30; }
+    static Vector3<UnsignedInt> components(UnsignedInt packed) {
+        return {(packed >> 20) & 0x3ff, (packed >> 10) & 0x3ff, packed & 0x3ff};
+    }
+};
+template<> struct QuaternionPacking<Vector3<UnsignedShort>> {
+    enum: UnsignedInt { Bits = 15 };
+
+    /* The index is split between the top bits of the first two components */
+    static Vector3<UnsignedShort> pack(UnsignedInt index, const Vector3<UnsignedInt>& components) {
+        return {UnsignedShort((index & 1) << 15|components[0]),
+                UnsignedShort((index >> 1) << 15|components[1]),
+                UnsignedShort(components[2])};
+    }
+    static UnsignedInt index(const Vector3<UnsignedShort>& packed) {
+        return packed[0] >> 15|(packed[1] >> 15) << 1;
+    }
+    static Vector3<UnsignedInt> components(const Vector3<UnsignedShort>& packed) {
+        return {packed[0] & 0x7fffu, packed[1] & 0x7fffu, packed[2] & 0x7fffu};
+    }
+};
+template<> struct QuaternionPacking<UnsignedLong> {
+    enum: UnsignedInt { Bits = 20 };
+
+    static UnsignedLong pack(UnsignedInt index, const Vector3<UnsignedInt>& components) {
+        return UnsignedLong(index) << 62|UnsignedLong(components[0]) << 40|UnsignedLong(components[1]) << 20|components[2];
+    }
+    static UnsignedInt index(UnsignedLong packed) { return packed >> 62; }
+    static Vector3<UnsignedInt> components(UnsignedLong packed) {
+        return {UnsignedInt(packed >> 40) & 0xfffff, UnsignedInt(packed >> 20) & 0xfffff, UnsignedInt(packed) & 0xfffff};
+    }
+};
+
+/* Used by both the single-value and batch APIs, doesn't check for
+   normalization */
+template<class Integral, class T> inline Integral packQuaternion(const Vector4<T>& quaternion) {
+    /* Using one value less than the full range so zero is exactly
+       representable */
+    constexpr T halfMax = T((1u << (QuaternionPacking<Integral>::Bits - 1)) - 1);
+
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(std::abs(quaternion[i]) > std::abs(quaternion[largest])) largest = i;
+
+    /* q and -q is the same rotation, flip the sign so the omitted component
+       is positive. The remaining components are then in range
+       [-1/sqrt(2), 1/sqrt(2)], scale that to [-1, 1] and quantize. */
+    const T scale = quaternion[largest] < T(0) ? -Constants<T>::sqrt2() : Constants<T>::sqrt2();
+    Vector3<UnsignedInt> components{NoInit};
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const T value = quaternion[i]*scale;
+        /* Avoiding a clamp() call in debug builds */
+        components[j++] = UnsignedInt(((value < T(-1) ? T(-1) : value > T(1) ? T(1) : value) + T(1))*halfMax + T(0.5));
+    }
+
+    return QuaternionPacking<Integral>::pack(largest, components);
+}
+
+template<class T, class Integral> inline Vector4<T> unpackQuaternion(const Integral& packed) {
+    constexpr T halfMax = T((1u << (QuaternionPacking<Integral>::Bits - 1)) - 1);
+
+    const UnsignedInt largest = QuaternionPacking<Integral>::index(packed);
+    const Vector3<UnsignedInt> components = QuaternionPacking<Integral>::components(packed);
+
+    Vector4<T> out{NoInit};
+    T lengthSquared{};
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        out[i] = (T(components[j++])/halfMax - T(1))*Constants<T>::sqrtHalf();
+        lengthSquared += out[i]*out[i];
+    }
+
+    /* The omitted component is reconstructed from the unit length */
+    out[largest] = std::sqrt(lengthSquared < T(1) ? T(1) - lengthSquared : T(0));
+    return out;
+}
+
+}
+
+/**
+@{ @name Transformation packing functions
+
+Compact representations of rotations and translations, useful for example for
+replicating object transformations over a network.
+*/
+
+/**
+@brief Pack a quaternion into the smallest-three representation
+@m_since_latest
+
+Since a normalized quaternion has a unit length and @f$ q @f$ and @f$ -q @f$
+represent the same rotation, it's enough to store the three smallest
+components together with a two-bit index of the largest one, which is then
+reconstructed on unpacking. The three components are in range
+@f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$ and are quantized to the
+remaining bits, with zero being exactly representable so an identity rotation
+survives the round trip unchanged. Supported `Integral` types are:
+
+-   @ref Magnum::UnsignedInt "UnsignedInt" --- 32 bits, three 10-bit
+    components, worst-case rotation error around @f$ 0.25 \degree @f$
+-   @ref Magnum::Math::Vector3 "Vector3<UnsignedShort>" --- 48 bits, three
+    15-bit components, worst-case rotation error around @f$ 0.008 \degree @f$
+-   @ref Magnum::UnsignedLong "UnsignedLong" --- 64 bits, three 20-bit
+    components, worst-case rotation error around @f$ 0.00025 \degree @f$,
+    which is close to precision of a @ref Magnum::Float "Float" quaternion
+
+Expects that the quaternion is normalized. Example usage:
+
+@snippet MagnumMath.cpp packQuaternion
+
+@see @ref unpackQuaternion(), @ref packQuaternionInto(),
+    @ref Quaternion::isNormalized()
+*/
+template<class Integral, class T> Integral packQuaternion(const Quaternion<T>& quaternion) {
+    CORRADE_ASSERT(quaternion.isNormalized(),
+        "Math::packQuaternion():" << quaternion << "is not normalized", {});
+    return Implementation::packQuaternion<Integral>(Vector4<T>{quaternion.vector(), quaternion.scalar()});
+}
+
+/**
+@brief Unpack a quaternion from the smallest-three representation
+@m_since_latest
+
+Inverse to @ref packQuaternion(). The returned quaternion is normalized,
+however it's not guaranteed to have the same sign as the original --- it still
+represents the same rotation though.
+@see @ref unpackQuaternionInto()
+*/
+template<class T, class Integral> Quaternion<T> unpackQuaternion(const Integral& packed) {
+    const Vector4<T> out = Implementation::unpackQuaternion<T>(packed);
+    return {out.xyz(), out.w()};
+}
+
+/**
+@brief Pack a translation into an integer representation
+@m_since_latest
+
+Maps @p translation from given @p range to the full range of the `Integral`
+type, with a precision of @cpp range.size()/bitMax @ce in each axis.
+Translations outside of the range are clamped to it. An axis with a zero size
+is packed to zero and unpacks back to the range minimum.
+@see @ref unpackTranslation(), @ref packTranslationInto(), @ref pack()
+*/
+template<class Integral, class T> Vector3<Integral> packTranslation(const Vector3<T>& translation, const Range3D<T>& range) {
+    /* A zero-size axis would be a division by zero resulting in a NaN, pack
+       it to zero instead */
+    const Vector3<T> size = range.size();
+    Vector3<T> normalized{NoInit};
+    for(std::size_t i = 0; i != 3; ++i)
+        normalized[i] = size[i] == T(0) ? T(0) : (translation[i] - range.min()[i])/size[i];
+    return pack<Vector3<Integral>>(clamp(normalized, T(0), T(1)));
+}
+
+/**
+@brief Unpack a translation from an integer representation
+@m_since_latest
+
+Inverse to @ref packTranslation(), @p range has to be the same as was used for
+packing.
+@see @ref unpackTranslationInto(), @ref unpack()
+*/
+template<class T, class Integral> Vector3<T> unpackTranslation(const Vector3<Integral>& packed, const Range3D<T>& range) {
+    return range.min() + unpack<Vector3<T>>(packed)*range.size();
+}
+
+/**
+@brief Pack a rigid transformation dual quaternion
+@m_since_latest
+
+Splits the transformation into a rotation, packed using
+@ref packQuaternion() into `QuaternionIntegral`, and a translation, packed
+using @ref packTranslation() into `TranslationIntegral` components. For
+example, with a 32-bit rotation and 16-bit translation components a
+transformation fits into 80 bits compared to 256 bits of a
+@ref Magnum::DualQuaternion "DualQuaternion". Expects that the dual quaternion
+is normalized.
+@see @ref unpackDualQuaternion(), @ref DualQuaternion::isNormalized()
+*/
+template<class QuaternionIntegral, class TranslationIntegral, class T> std::pair<QuaternionIntegral, Vector3<TranslationIntegral>> packDualQuaternion(const DualQuaternion<T>& transformation, const Range3D<T>& translationRange) {
+    CORRADE_ASSERT(transformation.isNormalized(),
+        "Math::packDualQuaternion():" << transformation << "is not normalized", {});
+    const Quaternion<T> rotation = transformation.rotation();
+    return {Implementation::packQuaternion<QuaternionIntegral>(Vector4<T>{rotation.vector(), rotation.scalar()}),
+            packTranslation<TranslationIntegral>(transformation.translation(), translationRange)};
+}
+
+/**
+@brief Unpack a rigid transformation dual quaternion
+@m_since_latest
+
+Inverse to @ref packDualQuaternion(), @p translationRange has to be the same as
+was used for packing.
+*/
+template<class T, class QuaternionIntegral, class TranslationIntegral> DualQuaternion<T> unpackDualQuaternion(const std::pair<QuaternionIntegral, Vector3<TranslationIntegral>>& packed, const Range3D<T>& translationRange) {
+    return DualQuaternion<T>::translation(unpackTranslation(packed.second, translationRange))*
+           DualQuaternion<T>{unpackQuaternion<T>(packed.first)};
+}
+
+/*@}*/
+
+}}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryAccounting.h"
+
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum {
+
+namespace {
+
+constexpr const char* MemoryCategoryNames[]{
+    "Other",
+    "ImageData",
+    "MeshData",
+    "GLBuffer",
+    "GLTexture",
+    "GLTextureArray",
+    "GLCubeMapTexture"
+};
+
+constexpr std::size_t MemoryCategoryCount = Containers::arraySize(MemoryCategoryNames);
+
+/* Zero-initialized, as they have static storage duration */
+std::atomic<bool> accountingEnabled;
+std::atomic<std::size_t> usages[MemoryCategoryCount];
+std::atomic<std::size_t> peakUsages[MemoryCategoryCount];
+std::atomic<std::size_t> allocationCounts[MemoryCategoryCount];
+
+}
+
+Debug& operator<<(Debug& debug, const MemoryCategory value) {
+    debug << "MemoryCategory" << Debug::nospace;
+
+    if(UnsignedByte(value) < MemoryCategoryCount)
+        return debug << "::" << Debug::nospace << MemoryCategoryNames[UnsignedByte(value)];
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+bool MemoryAccounting::isEnabled() {
+    return accountingEnabled.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::setEnabled(const bool enabled) {
+    accountingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::size_t MemoryAccounting::usage(const MemoryCategory category) {
+    return usages[UnsignedByte(category)].load(std::memory_order_relaxed);
+}
+
+std::size_t MemoryAccounting::peakUsage(const MemoryCategory category) {
+    return peakUsages[UnsignedByte(category)].load(std::memory_order_relaxed);
+}
+
+std::size_t MemoryAccounting::allocationCount(const MemoryCategory category) {
+    return allocationCounts[UnsignedByte(category)].load(std::memory_order_relaxed);
+}
+
+std::size_t MemoryAccounting::totalUsage() {
+    std::size_t total = 0;
+    for(const std::atomic<std::size_t>& usage: usages)
+        total += usage.load(std::memory_order_relaxed);
+    return total;
+}
+
+void MemoryAccounting::resetPeakUsage() {
+    for(std::size_t i = 0; i != MemoryCategoryCount; ++i)
+        peakUsages[i].store(usages[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::string MemoryAccounting::report() {
+    std::ostringstream out;
+    out << std::left << std::setw(20) << "Category" << std::right
+        << std::setw(14) << "Usage"
+        << std::setw(14) << "Peak"
+        << std::setw(14) << "Allocations" << '\n';
+    for(std::size_t i = 0; i != MemoryCategoryCount; ++i)
+        out << std::left << std::setw(20) << MemoryCategoryNames[i] << std::right
+            << std::setw(14) << usages[i].load(std::memory_order_relaxed)
+            << std::setw(14) << peakUsages[i].load(std::memory_order_relaxed)
+            << std::setw(14) << allocationCounts[i].load(std::memory_order_relaxed) << '\n';
+    out << std::left << std::setw(20) << "Total" << std::right
+        << std::setw(14) << totalUsage() << '\n';
+    return out.str();
+}
+
+void MemoryAccounting::add(const MemoryCategory category, const std::size_t size) {
+    const std::size_t usage = usages[UnsignedByte(category)].fetch_add(size, std::memory_order_relaxed) + size;
+    allocationCounts[UnsignedByte(category)].fetch_add(1, std::memory_order_relaxed);
+
+    /* Update the peak only if it's less than current usage. If another
+       thread updated it in the meantime, the loop picks up the new value. */
+    std::atomic<std::size_t>& peak = peakUsages[UnsignedByte(category)];
+    std::size_t previous = peak.load(std::memory_order_relaxed);
+    while(previous < usage && !peak.compare_exchange_weak(previous, usage, std::memory_order_relaxed));
+}
+
+void MemoryAccounting::remove(const MemoryCategory category, const std::size_t size) {
+    usages[UnsignedByte(category)].fetch_sub(size, std::memory_order_relaxed);
+    allocationCounts[UnsignedByte(category)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+AccountedMemory::AccountedMemory(const MemoryCategory category, const std::size_t size) noexcept: _category{category}, _size{} {
+    setSize(size);
+}
+
+AccountedMemory::~AccountedMemory() {
+    if(_size) MemoryAccounting::remove(_category, _size);
+}
+
+AccountedMemory& AccountedMemory::operator=(AccountedMemory&& other) noexcept {
+    using std::swap;
+    swap(_category, other._category);
+    swap(_size, other._size);
+    return *this;
+}
+
+void AccountedMemory::setSize(const std::size_t size) {
+    if(_size) MemoryAccounting::remove(_category, _size);
+    _size = size && MemoryAccounting::isEnabled() ? size : 0;
+    if(_size) MemoryAccounting::add(_category, _size);
+}
+
+}
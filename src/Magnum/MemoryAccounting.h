@@ -0,0 +1,256 @@
+#ifndef Magnum_MemoryAccounting_h
+#define Magnum_MemoryAccounting_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MemoryAccounting, @ref Magnum::AccountedMemory, enum @ref Magnum::MemoryCategory
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <string>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Memory category
+@m_since_latest
+
+@see @ref MemoryAccounting
+*/
+enum class MemoryCategory: UnsignedByte {
+    /** Memory not belonging to any other category */
+    Other,
+
+    /** Pixel data of @ref Trade::ImageData instances */
+    ImageData,
+
+    /**
+     * Index and vertex data of @ref Trade::MeshData2D and
+     * @ref Trade::MeshData3D instances
+     */
+    MeshData,
+
+    /** Data uploaded to @ref GL::Buffer instances */
+    GLBuffer,
+
+    /**
+     * Storage of one-, two- and three-dimensional textures, including
+     * rectangle and multisample textures
+     */
+    GLTexture,
+
+    /** Storage of one- and two-dimensional texture arrays */
+    GLTextureArray,
+
+    /** Storage of cube map textures and cube map texture arrays */
+    GLCubeMapTexture
+};
+
+/**
+@debugoperatorenum{MemoryCategory}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MemoryCategory value);
+
+/**
+@brief Memory accounting
+@m_since_latest
+
+Opt-in tracking of how much memory is held by various Magnum subsystems. The
+accounting is disabled by default, enable it using @ref setEnabled() early
+during application startup. After that, @ref usage(), @ref peakUsage() and
+@ref allocationCount() report the state of each @ref MemoryCategory and
+@ref report() produces a human-readable overview:
+
+@snippet Magnum.cpp MemoryAccounting-usage
+
+CPU memory is accounted for @ref Trade::ImageData and
+@ref Trade::MeshData3D / @ref Trade::MeshData2D instances, based on the size
+of their data at construction time. GPU memory is accounted for
+@ref GL::Buffer based on the size passed to @ref GL::Buffer::setData() and for
+textures based on the format and size passed to @ref GL::Texture::setStorage() "*Texture::setStorage()".
+As the GPU amounts are calculated from the API calls and not queried from the
+driver, they don't include any driver-specific padding or alignment, but on
+the other hand they can be tested without a GPU.
+
+Custom allocations can be accounted using the @ref AccountedMemory class.
+
+@section MemoryAccounting-performance Performance and thread safety
+
+The counters are updated with relaxed atomic operations, so the accounting is
+thread-safe and cheap enough to be enabled in production builds. When
+disabled, the only overhead is a single atomic load on each tracked
+allocation.
+
+Objects created while the accounting is disabled are not tracked even after
+it gets enabled, and objects created while it was enabled are correctly
+removed from the counters even after it gets disabled again.
+*/
+class MAGNUM_EXPORT MemoryAccounting {
+    public:
+        /** @brief Whether memory accounting is enabled */
+        static bool isEnabled();
+
+        /**
+         * @brief Enable or disable memory accounting
+         *
+         * Disabled by default.
+         */
+        static void setEnabled(bool enabled);
+
+        /** @brief Count of bytes currently used in given category */
+        static std::size_t usage(MemoryCategory category);
+
+        /**
+         * @brief Peak count of bytes used in given category
+         *
+         * Maximum of @ref usage() since the accounting was enabled or since
+         * the last call to @ref resetPeakUsage().
+         */
+        static std::size_t peakUsage(MemoryCategory category);
+
+        /** @brief Count of live allocations in given category */
+        static std::size_t allocationCount(MemoryCategory category);
+
+        /** @brief Count of bytes currently used in all categories */
+        static std::size_t totalUsage();
+
+        /**
+         * @brief Reset peak usage
+         *
+         * Sets @ref peakUsage() of all categories to their current
+         * @ref usage().
+         */
+        static void resetPeakUsage();
+
+        /**
+         * @brief Usage report
+         *
+         * Returns a human-readable table with current and peak usage and
+         * allocation count for all categories.
+         */
+        static std::string report();
+
+        /**
+         * @brief Account an allocation
+         *
+         * Adds @p size to @ref usage() of given category, updates
+         * @ref peakUsage() and increments @ref allocationCount(). Does the
+         * accounting even if it's not enabled, prefer to use
+         * @ref AccountedMemory instead.
+         */
+        static void add(MemoryCategory category, std::size_t size);
+
+        /**
+         * @brief Account a deallocation
+         *
+         * Counterpart to @ref add().
+         */
+        static void remove(MemoryCategory category, std::size_t size);
+
+        MemoryAccounting() = delete;
+};
+
+/**
+@brief Accounted memory
+@m_since_latest
+
+Move-only handle that adds itself to @ref MemoryAccounting on construction
+or on @ref setSize() and removes itself on destruction. Meant to be used as a
+class member next to the actual allocation. If @ref MemoryAccounting is not
+enabled at the time the size is set, the size is not accounted and
+@ref size() is @cpp 0 @ce.
+*/
+class MAGNUM_EXPORT AccountedMemory {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Accounts no memory in @ref MemoryCategory::Other.
+         */
+        /*implicit*/ AccountedMemory() noexcept: _category{MemoryCategory::Other}, _size{} {}
+
+        /**
+         * @brief Constructor
+         *
+         * If @ref MemoryAccounting is enabled, adds @p size to given
+         * category.
+         */
+        explicit AccountedMemory(MemoryCategory category, std::size_t size = 0) noexcept;
+
+        /** @brief Copying is not allowed */
+        AccountedMemory(const AccountedMemory&) = delete;
+
+        /** @brief Move constructor */
+        AccountedMemory(AccountedMemory&& other) noexcept: _category{other._category}, _size{other._size} {
+            other._size = 0;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Removes @ref size() from @ref category().
+         */
+        ~AccountedMemory();
+
+        /** @brief Copying is not allowed */
+        AccountedMemory& operator=(const AccountedMemory&) = delete;
+
+        /** @brief Move assignment */
+        AccountedMemory& operator=(AccountedMemory&& other) noexcept;
+
+        /** @brief Category */
+        MemoryCategory category() const { return _category; }
+
+        /**
+         * @brief Accounted size
+         *
+         * Can be less than size passed to the constructor or to
+         * @ref setSize() if @ref MemoryAccounting wasn't enabled at that
+         * time.
+         */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Set accounted size
+         *
+         * Removes the previous size from the accounting and, if
+         * @ref MemoryAccounting is enabled, adds the new one.
+         */
+        void setSize(std::size_t size);
+
+    private:
+        MemoryCategory _category;
+        std::size_t _size;
+};
+
+}
+
+#endif
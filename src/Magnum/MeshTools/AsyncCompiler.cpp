@@ -0,0 +1,239 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncCompiler.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/MeshTools/Implementation/CompileData.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+struct AsyncCompiler::State {
+    struct Entry {
+        /* Input data, present until prepared */
+        Containers::Optional<Trade::MeshData3D> meshData;
+        CompileFlags flags;
+
+        /* Staging data, present between being prepared and uploaded */
+        Implementation::CompileData data;
+
+        GL::Mesh mesh{NoCreate};
+        Matrix4 dequantization;
+        bool ready{};
+    };
+
+    static void prepare(Entry& entry);
+    void work();
+
+    bool isReady(UnsignedInt id) const {
+        return id < entries.size() && entries[id] && entries[id]->ready;
+    }
+
+    /* Guards everything below except for the Entry contents, which are
+       accessed only by the thread that currently owns given ID -- a worker
+       between popping it from `queued` and pushing it to `prepared` and the
+       user thread otherwise */
+    std::mutex mutex;
+    std::condition_variable workAvailable, workDone;
+
+    /* Entries are never moved, so the workers can access them without
+       holding the lock. Released meshes have the entry deleted. */
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::deque<UnsignedInt> queued, prepared;
+    std::size_t preparing{};
+    bool quit{};
+
+    std::vector<std::thread> workers;
+
+    /* Returned from mesh() on a graceful assert */
+    GL::Mesh invalidMesh{NoCreate};
+};
+
+void AsyncCompiler::State::prepare(Entry& entry) {
+    entry.data = Implementation::prepareCompile(*entry.meshData, entry.flags);
+    entry.meshData = Containers::NullOpt;
+}
+
+void AsyncCompiler::State::work() {
+    std::unique_lock<std::mutex> lock{mutex};
+    for(;;) {
+        workAvailable.wait(lock, [this]{ return quit || !queued.empty(); });
+        if(quit) return;
+
+        const UnsignedInt id = queued.front();
+        queued.pop_front();
+        Entry& entry = *entries[id];
+        ++preparing;
+
+        lock.unlock();
+        prepare(entry);
+        lock.lock();
+
+        --preparing;
+        prepared.push_back(id);
+        workDone.notify_all();
+    }
+}
+
+AsyncCompiler::AsyncCompiler(const UnsignedInt workerCount): _state{new State} {
+    _state->workers.reserve(workerCount);
+    for(UnsignedInt i = 0; i != workerCount; ++i)
+        _state->workers.emplace_back(&State::work, _state.get());
+}
+
+AsyncCompiler::~AsyncCompiler() {
+    {
+        std::unique_lock<std::mutex> lock{_state->mutex};
+        _state->quit = true;
+    }
+    _state->workAvailable.notify_all();
+    for(std::thread& worker: _state->workers) worker.join();
+}
+
+UnsignedInt AsyncCompiler::workerCount() const {
+    return _state->workers.size();
+}
+
+UnsignedInt AsyncCompiler::add(Trade::MeshData3D&& meshData, const CompileFlags flags) {
+    std::unique_ptr<State::Entry> entry{new State::Entry};
+    entry->meshData.emplace(std::move(meshData));
+    entry->flags = flags;
+
+    UnsignedInt id;
+    {
+        std::unique_lock<std::mutex> lock{_state->mutex};
+        id = _state->entries.size();
+        _state->entries.push_back(std::move(entry));
+        _state->queued.push_back(id);
+    }
+    _state->workAvailable.notify_one();
+    return id;
+}
+
+std::size_t AsyncCompiler::pendingCount() const {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    return _state->queued.size() + _state->preparing + _state->prepared.size();
+}
+
+std::size_t AsyncCompiler::upload(const std::size_t byteBudget, const std::chrono::nanoseconds timeBudget) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::size_t uploadedCount = 0, uploadedBytes = 0;
+    for(;;) {
+        State::Entry* entry;
+        {
+            std::unique_lock<std::mutex> lock{_state->mutex};
+
+            /* Without workers, prepare the data here. Nobody else touches the
+               state, so it's fine to do that with the lock held. */
+            if(_state->workers.empty() && _state->prepared.empty() && !_state->queued.empty()) {
+                const UnsignedInt id = _state->queued.front();
+                _state->queued.pop_front();
+                State::prepare(*_state->entries[id]);
+                _state->prepared.push_back(id);
+            }
+
+            if(_state->prepared.empty()) break;
+
+            /* Always upload at least one mesh so meshes larger than the
+               budget don't get stuck */
+            entry = _state->entries[_state->prepared.front()].get();
+            const std::size_t size = entry->data.vertexData.size() + entry->data.indexData.size();
+            if(uploadedCount && uploadedBytes + size > byteBudget) break;
+
+            _state->prepared.pop_front();
+            uploadedBytes += size;
+        }
+
+        entry->mesh = Implementation::uploadCompiled(entry->data);
+        entry->dequantization = entry->data.dequantization;
+        /* Free the staging memory */
+        entry->data.vertexData = nullptr;
+        entry->data.indexData = nullptr;
+        entry->ready = true;
+        ++uploadedCount;
+
+        if(std::chrono::steady_clock::now() - start >= timeBudget) break;
+    }
+
+    return uploadedCount;
+}
+
+void AsyncCompiler::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+
+    /* Without workers, prepare everything here */
+    if(_state->workers.empty()) {
+        while(!_state->queued.empty()) {
+            const UnsignedInt id = _state->queued.front();
+            _state->queued.pop_front();
+            State::prepare(*_state->entries[id]);
+            _state->prepared.push_back(id);
+        }
+        return;
+    }
+
+    _state->workDone.wait(lock, [this]{
+        return _state->queued.empty() && !_state->preparing;
+    });
+}
+
+bool AsyncCompiler::isReady(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->entries.size(),
+        "MeshTools::AsyncCompiler::isReady(): index" << id << "out of range for" << _state->entries.size() << "meshes", {});
+    return _state->isReady(id);
+}
+
+GL::Mesh& AsyncCompiler::mesh(const UnsignedInt id) {
+    CORRADE_ASSERT(_state->isReady(id),
+        "MeshTools::AsyncCompiler::mesh(): mesh" << id << "is not ready", _state->invalidMesh);
+    return _state->entries[id]->mesh;
+}
+
+Matrix4 AsyncCompiler::dequantization(const UnsignedInt id) const {
+    CORRADE_ASSERT(_state->isReady(id),
+        "MeshTools::AsyncCompiler::dequantization(): mesh" << id << "is not ready", {});
+    return _state->entries[id]->dequantization;
+}
+
+GL::Mesh AsyncCompiler::release(const UnsignedInt id) {
+    CORRADE_ASSERT(_state->isReady(id),
+        "MeshTools::AsyncCompiler::release(): mesh" << id << "is not ready", GL::Mesh{NoCreate});
+    GL::Mesh mesh = std::move(_state->entries[id]->mesh);
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->entries[id] = nullptr;
+    return mesh;
+}
+
+}}
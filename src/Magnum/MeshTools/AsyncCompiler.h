@@ -0,0 +1,200 @@
+#ifndef Magnum_MeshTools_AsyncCompiler_h
+#define Magnum_MeshTools_AsyncCompiler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::AsyncCompiler
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <chrono>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/MeshTools/Compile.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Asynchronous mesh compiler
+@m_since_latest
+
+Splits @ref compile(const Trade::MeshData3D&, CompileFlags) into two parts.
+Normal generation, attribute quantization, interleaving and index compression
+are done on worker threads into staging memory, while buffer creation and
+upload is done in @ref upload() on the thread with the GL context, limited by a
+per-call byte and time budget. That way loading a lot of meshes doesn't block
+rendering for more than the budget allows.
+
+@snippet MagnumMeshTools-gl.cpp AsyncCompiler
+
+Each mesh added with @ref add() gets an ID. Once @ref isReady() returns
+@cpp true @ce for it, the mesh can be accessed with @ref mesh() or taken over
+with @ref release(). The resulting meshes are the same as if
+@ref compile(const Trade::MeshData3D&, CompileFlags, Matrix4&) was called on
+the data, including support for all @ref CompileFlags.
+
+With zero worker threads the data preparation is done directly in
+@ref upload() and counts towards its time budget, which is useful on platforms
+without thread support, such as Emscripten without pthreads.
+
+@section MeshTools-AsyncCompiler-threads Thread safety
+
+Apart from the worker threads managed internally, the class is not
+thread-safe --- all functions are expected to be called from the same thread,
+which is the one with the GL context current.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_MESHTOOLS_EXPORT AsyncCompiler {
+    public:
+        /**
+         * @brief Constructor
+         * @param workerCount   Worker thread count
+         *
+         * If @p workerCount is @cpp 0 @ce, the data are prepared on the
+         * calling thread in @ref upload() and @ref wait().
+         */
+        explicit AsyncCompiler(UnsignedInt workerCount = 1);
+
+        /** @brief Copying is not allowed */
+        AsyncCompiler(const AsyncCompiler&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * The worker threads reference the internal state.
+         */
+        AsyncCompiler(AsyncCompiler&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for the meshes that are being prepared at the moment to
+         * finish, discards all others. Meshes that weren't released using
+         * @ref release() are destroyed, so the GL context is expected to be
+         * current.
+         */
+        ~AsyncCompiler();
+
+        /** @brief Copying is not allowed */
+        AsyncCompiler& operator=(const AsyncCompiler&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncCompiler& operator=(AsyncCompiler&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt workerCount() const;
+
+        /**
+         * @brief Add a mesh for compilation
+         * @return Mesh ID
+         *
+         * The data are handed over to a worker thread. IDs are assigned
+         * sequentially, starting from @cpp 0 @ce.
+         */
+        UnsignedInt add(Trade::MeshData3D&& meshData, CompileFlags flags = {});
+
+        /**
+         * @brief Count of meshes that were added but not uploaded yet
+         *
+         * Includes also meshes that are not prepared yet.
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Upload prepared meshes
+         * @param byteBudget    Maximal byte count of vertex and index data to
+         *      upload
+         * @param timeBudget    Time after which no more meshes are uploaded
+         * @return Count of uploaded meshes
+         *
+         * Uploads the meshes in the order they were prepared, stopping before
+         * a mesh that wouldn't fit into @p byteBudget or after
+         * @p timeBudget is exceeded. At least one mesh is uploaded if any is
+         * prepared, so meshes larger than the budget don't get stuck. Expects
+         * that the GL context is current.
+         */
+        std::size_t upload(std::size_t byteBudget, std::chrono::nanoseconds timeBudget = std::chrono::nanoseconds::max());
+
+        /**
+         * @brief Wait until all added meshes are prepared
+         *
+         * Doesn't upload anything, call @ref upload() after for that. Useful
+         * for example for a loading screen.
+         */
+        void wait();
+
+        /**
+         * @brief Whether a mesh is uploaded
+         *
+         * Returns @cpp false @ce also for meshes that were already taken
+         * over using @ref release(). Expects that @p id was returned from
+         * @ref add().
+         */
+        bool isReady(UnsignedInt id) const;
+
+        /**
+         * @brief Compiled mesh
+         *
+         * Expects that @ref isReady() is @cpp true @ce for @p id.
+         */
+        GL::Mesh& mesh(UnsignedInt id);
+
+        /**
+         * @brief Position dequantization transformation
+         *
+         * An identity if the mesh was not added with
+         * @ref CompileFlag::QuantizePositions. See
+         * @ref compile(const Trade::MeshData3D&, CompileFlags, Matrix4&) for
+         * more information. Expects that @ref isReady() is @cpp true @ce for
+         * @p id.
+         */
+        Matrix4 dequantization(UnsignedInt id) const;
+
+        /**
+         * @brief Take over a compiled mesh
+         *
+         * Expects that @ref isReady() is @cpp true @ce for @p id. After this
+         * call @ref isReady() returns @cpp false @ce for @p id.
+         */
+        GL::Mesh release(UnsignedInt id);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -0,0 +1,386 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Roughly the same amount of work per chunk as in the other parallel
+   MeshTools functions */
+enum: std::size_t {
+    PositionGrainSize = 16384,
+    SubmeshGrainSize = 64
+};
+
+bool checkOffsets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const char* const function) {
+    for(std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        CORRADE_ASSERT(offsets[i] <= offsets[i + 1] && offsets[i + 1] <= indices.size(),
+            "MeshTools::" << Debug::nospace << function << Debug::nospace << "(): submesh" << i << "offsets" << offsets[i] << "and" << offsets[i + 1] << "out of order or out of bounds for" << indices.size() << "indices", false);
+    }
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(indices);
+    static_cast<void>(function);
+    #endif
+    return true;
+}
+
+/* Ritter's algorithm over an arbitrary point accessor, shared by the plain
+   and the indexed variant */
+template<class F> std::pair<Vector3, Float> ritter(const std::size_t count, F point) {
+    if(!count) return {};
+
+    /* Point farthest from the first one, then point farthest from that */
+    const Vector3 first = point(0);
+    Vector3 a = first;
+    Float maxDistanceSquared = 0.0f;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 p = point(i);
+        const Float distanceSquared = (p - first).dot();
+        if(distanceSquared > maxDistanceSquared) {
+            maxDistanceSquared = distanceSquared;
+            a = p;
+        }
+    }
+    Vector3 b = a;
+    maxDistanceSquared = 0.0f;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 p = point(i);
+        const Float distanceSquared = (p - a).dot();
+        if(distanceSquared > maxDistanceSquared) {
+            maxDistanceSquared = distanceSquared;
+            b = p;
+        }
+    }
+
+    /* Initial sphere spanning these two, grow it to include all points that
+       are outside, moving the center towards them */
+    Vector3 center = (a + b)*0.5f;
+    Float radius = Math::sqrt(maxDistanceSquared)*0.5f;
+    Float radiusSquared = radius*radius;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector3 p = point(i);
+        const Float distanceSquared = (p - center).dot();
+        if(distanceSquared <= radiusSquared) continue;
+
+        const Float distance = Math::sqrt(distanceSquared);
+        const Float newRadius = (radius + distance)*0.5f;
+        center += (p - center)*((newRadius - radius)/distance);
+        radius = newRadius;
+        radiusSquared = radius*radius;
+    }
+
+    return {center, radius};
+}
+
+struct Sphere {
+    Vector3d center;
+    Double radiusSquared;
+};
+
+inline bool contains(const Sphere& sphere, const Vector3d& point) {
+    /* Relative tolerance to not get stuck on points that are on the boundary
+       but fail the test due to rounding errors */
+    return (point - sphere.center).dot() <= sphere.radiusSquared*(1.0 + 1.0e-10);
+}
+
+inline Sphere sphereFrom(const Vector3d& a, const Vector3d& b) {
+    return {(a + b)*0.5, (b - a).dot()*0.25};
+}
+
+Sphere sphereFrom(const Vector3d& a, const Vector3d& b, const Vector3d& c) {
+    const Vector3d ab = b - a;
+    const Vector3d ac = c - a;
+    const Vector3d normal = Math::cross(ab, ac);
+    const Double normalLengthSquared = normal.dot();
+
+    /* Collinear points, take a sphere around the two farthest */
+    if(normalLengthSquared <= 1.0e-12*ab.dot()*ac.dot()) {
+        const Vector3d bc = c - b;
+        if(ab.dot() >= ac.dot() && ab.dot() >= bc.dot()) return sphereFrom(a, b);
+        if(ac.dot() >= bc.dot()) return sphereFrom(a, c);
+        return sphereFrom(b, c);
+    }
+
+    /* Circumcenter in the triangle plane */
+    const Vector3d offset = (Math::cross(normal, ab)*ac.dot() + Math::cross(ac, normal)*ab.dot())/(2.0*normalLengthSquared);
+    return {a + offset, offset.dot()};
+}
+
+Sphere sphereFrom(const Vector3d& a, const Vector3d& b, const Vector3d& c, const Vector3d& d) {
+    const Vector3d u = b - a;
+    const Vector3d v = c - a;
+    const Vector3d w = d - a;
+    const Double determinant = 2.0*Math::dot(u, Math::cross(v, w));
+
+    /* Coplanar points, take the smallest sphere around three of them that
+       contains the fourth */
+    if(Math::abs(determinant) <= 1.0e-12*Math::sqrt(u.dot()*v.dot()*w.dot())) {
+        const Sphere candidates[]{
+            sphereFrom(a, b, c),
+            sphereFrom(a, b, d),
+            sphereFrom(a, c, d),
+            sphereFrom(b, c, d)
+        };
+        const Vector3d opposite[]{d, c, b, a};
+        Sphere out{{}, Constantsd::inf()};
+        for(std::size_t i = 0; i != 4; ++i)
+            if(candidates[i].radiusSquared < out.radiusSquared && contains(candidates[i], opposite[i]))
+                out = candidates[i];
+
+        /* None contains the fourth point due to rounding errors, the largest
+           one is the closest to containing it */
+        if(out.radiusSquared == Constantsd::inf()) {
+            out = candidates[0];
+            for(std::size_t i = 1; i != 4; ++i)
+                if(candidates[i].radiusSquared > out.radiusSquared)
+                    out = candidates[i];
+        }
+        return out;
+    }
+
+    /* Circumcenter of the tetrahedron */
+    const Vector3d offset = (Math::cross(v, w)*u.dot() + Math::cross(w, u)*v.dot() + Math::cross(u, v)*w.dot())/determinant;
+    return {a + offset, offset.dot()};
+}
+
+}
+
+Range3D boundingBox(const Containers::StridedArrayView1D<const Vector3>& positions) {
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(positions);
+    return {minmax.first, minmax.second};
+}
+
+Range3D boundingBox(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const Vector3>& positions) {
+    const std::size_t chunkCount = (positions.size() + PositionGrainSize - 1)/PositionGrainSize;
+    if(chunkCount <= 1) return boundingBox(positions);
+
+    /* Chunks are aligned to the grain size, so each writes into its own
+       slot. NaN handling of Math::min() / Math::max() then makes the merged
+       result the same as with the single-threaded variant. */
+    Containers::Array<Vector3> min{Containers::NoInit, chunkCount};
+    Containers::Array<Vector3> max{Containers::NoInit, chunkCount};
+    scheduler.parallelFor(positions.size(), PositionGrainSize, [&](std::size_t begin, std::size_t end) {
+        const std::pair<Vector3, Vector3> minmax = Math::minmax(positions.slice(begin, end));
+        min[begin/PositionGrainSize] = minmax.first;
+        max[begin/PositionGrainSize] = minmax.second;
+    });
+
+    return {Math::min(min), Math::max(max)};
+}
+
+void boundingBoxesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Range3D>& boxes) {
+    CORRADE_ASSERT(offsets.size() == boxes.size() + 1,
+        "MeshTools::boundingBoxesInto(): expected" << boxes.size() + 1 << "offsets but got" << offsets.size(), );
+    if(!checkOffsets(indices, offsets, "boundingBoxesInto")) return;
+
+    for(std::size_t i = 0; i != boxes.size(); ++i) {
+        const UnsignedInt begin = offsets[i];
+        const UnsignedInt end = offsets[i + 1];
+        if(begin == end) {
+            boxes[i] = {};
+            continue;
+        }
+
+        Vector3 min{Constants::inf()}, max{-Constants::inf()};
+        for(std::size_t j = begin; j != end; ++j) {
+            const UnsignedInt index = indices[j];
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::boundingBoxesInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+            min = Math::min(min, positions[index]);
+            max = Math::max(max, positions[index]);
+        }
+        boxes[i] = {min, max};
+    }
+}
+
+void boundingBoxesInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Range3D>& boxes) {
+    CORRADE_ASSERT(offsets.size() == boxes.size() + 1,
+        "MeshTools::boundingBoxesInto(): expected" << boxes.size() + 1 << "offsets but got" << offsets.size(), );
+    if(!checkOffsets(indices, offsets, "boundingBoxesInto")) return;
+
+    scheduler.parallelFor(boxes.size(), SubmeshGrainSize, [&](std::size_t begin, std::size_t end) {
+        boundingBoxesInto(indices, offsets.slice(begin, end + 1), positions, boxes.slice(begin, end));
+    });
+}
+
+std::pair<Vector3, Float> boundingSphereRitter(const Containers::StridedArrayView1D<const Vector3>& positions) {
+    return ritter(positions.size(), [&positions](std::size_t i) {
+        return positions[i];
+    });
+}
+
+std::pair<Vector3, Float> boundingSphereWelzl(const Containers::StridedArrayView1D<const Vector3>& positions) {
+    if(positions.empty()) return {};
+
+    /* Randomizing the order is what makes the expected time linear, a fixed
+       seed to have the output reproducible */
+    Containers::Array<Vector3d> points{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        points[i] = Vector3d{positions[i]};
+    std::shuffle(points.begin(), points.end(), std::minstd_rand{});
+
+    /* Iterative form of the recursion, each level fixing one more point on
+       the sphere boundary */
+    Sphere sphere{points[0], 0.0};
+    for(std::size_t i = 1; i != points.size(); ++i) {
+        if(contains(sphere, points[i])) continue;
+        sphere = {points[i], 0.0};
+        for(std::size_t j = 0; j != i; ++j) {
+            if(contains(sphere, points[j])) continue;
+            sphere = sphereFrom(points[i], points[j]);
+            for(std::size_t k = 0; k != j; ++k) {
+                if(contains(sphere, points[k])) continue;
+                sphere = sphereFrom(points[i], points[j], points[k]);
+                for(std::size_t l = 0; l != k; ++l) {
+                    if(contains(sphere, points[l])) continue;
+                    sphere = sphereFrom(points[i], points[j], points[k], points[l]);
+                }
+            }
+        }
+    }
+
+    /* Recalculate the radius for the center rounded to floats, rounding the
+       result up so all points are really inside */
+    const Vector3 center{sphere.center};
+    Double radiusSquared = 0.0;
+    for(const Vector3d& point: points)
+        radiusSquared = Math::max(radiusSquared, (point - Vector3d{center}).dot());
+    const Double radius = Math::sqrt(radiusSquared);
+    Float radiusRounded = Float(radius);
+    if(Double(radiusRounded) < radius)
+        radiusRounded = std::nextafter(radiusRounded, Constants::inf());
+
+    return {center, radiusRounded};
+}
+
+void boundingSpheresInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& centers, const Containers::StridedArrayView1D<Float>& radii) {
+    CORRADE_ASSERT(radii.size() == centers.size(),
+        "MeshTools::boundingSpheresInto(): expected" << centers.size() << "radii but got" << radii.size(), );
+    CORRADE_ASSERT(offsets.size() == centers.size() + 1,
+        "MeshTools::boundingSpheresInto(): expected" << centers.size() + 1 << "offsets but got" << offsets.size(), );
+    if(!checkOffsets(indices, offsets, "boundingSpheresInto")) return;
+
+    for(std::size_t i = 0; i != centers.size(); ++i) {
+        const Containers::StridedArrayView1D<const UnsignedInt> submesh = indices.slice(offsets[i], offsets[i + 1]);
+        #ifndef CORRADE_NO_ASSERT
+        for(const UnsignedInt index: submesh)
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::boundingSpheresInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+        #endif
+
+        const std::pair<Vector3, Float> sphere = ritter(submesh.size(), [&submesh, &positions](std::size_t j) {
+            return positions[submesh[j]];
+        });
+        centers[i] = sphere.first;
+        radii[i] = sphere.second;
+    }
+}
+
+void boundingSpheresInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& centers, const Containers::StridedArrayView1D<Float>& radii) {
+    CORRADE_ASSERT(radii.size() == centers.size(),
+        "MeshTools::boundingSpheresInto(): expected" << centers.size() << "radii but got" << radii.size(), );
+    CORRADE_ASSERT(offsets.size() == centers.size() + 1,
+        "MeshTools::boundingSpheresInto(): expected" << centers.size() + 1 << "offsets but got" << offsets.size(), );
+    if(!checkOffsets(indices, offsets, "boundingSpheresInto")) return;
+
+    scheduler.parallelFor(centers.size(), SubmeshGrainSize, [&](std::size_t begin, std::size_t end) {
+        boundingSpheresInto(indices, offsets.slice(begin, end + 1), positions, centers.slice(begin, end), radii.slice(begin, end));
+    });
+}
+
+Matrix4 orientedBoundingBox(const Containers::StridedArrayView1D<const Vector3>& positions) {
+    if(positions.empty()) return Matrix4{Math::ZeroInit};
+
+    /* Covariance of the points. Done in doubles as the sums can get large
+       and the subtraction of the mean would lose precision otherwise. */
+    Vector3d mean;
+    for(const Vector3& position: positions) mean += Vector3d{position};
+    mean /= Double(positions.size());
+
+    Matrix3x3d covariance{Math::ZeroInit};
+    for(const Vector3& position: positions) {
+        const Vector3d d = Vector3d{position} - mean;
+        for(std::size_t col = 0; col != 3; ++col)
+            for(std::size_t row = 0; row != 3; ++row)
+                covariance[col][row] += d[col]*d[row];
+    }
+
+    /* The covariance matrix is symmetric positive semi-definite, so columns
+       of V are its eigenvectors and the singular values the eigenvalues.
+       Order them from the largest variance. If the decomposition failed, it
+       returns zeros, fall back to coordinate axes then. */
+    const std::tuple<Math::RectangularMatrix<3, 3, Double>, Math::Vector<3, Double>, Math::Matrix<3, Double>> svd = Math::Algorithms::svd(Math::RectangularMatrix<3, 3, Double>{covariance});
+    Vector3d axes[3]{std::get<2>(svd)[0], std::get<2>(svd)[1], std::get<2>(svd)[2]};
+    Double variances[3]{std::get<1>(svd)[0], std::get<1>(svd)[1], std::get<1>(svd)[2]};
+    if(axes[0].dot() < 0.5 || axes[1].dot() < 0.5) {
+        axes[0] = Vector3d::xAxis();
+        axes[1] = Vector3d::yAxis();
+        variances[0] = variances[1] = variances[2] = 0.0;
+    }
+    for(std::size_t i = 0; i != 2; ++i) for(std::size_t j = 0; j != 2 - i; ++j) {
+        if(variances[j] >= variances[j + 1]) continue;
+        std::swap(variances[j], variances[j + 1]);
+        std::swap(axes[j], axes[j + 1]);
+    }
+    axes[0] = axes[0].normalized();
+    axes[1] = (axes[1] - axes[0]*Math::dot(axes[0], axes[1])).normalized();
+    axes[2] = Math::cross(axes[0], axes[1]);
+
+    /* Extents along the axes */
+    Vector3d min{Constantsd::inf()}, max{-Constantsd::inf()};
+    for(const Vector3& position: positions) {
+        const Vector3d d = Vector3d{position} - mean;
+        const Vector3d projected{Math::dot(d, axes[0]), Math::dot(d, axes[1]), Math::dot(d, axes[2])};
+        min = Math::min(min, projected);
+        max = Math::max(max, projected);
+    }
+
+    const Vector3d localCenter = (min + max)*0.5;
+    const Vector3d halfSize = (max - min)*0.5;
+    const Vector3d center = mean + axes[0]*localCenter[0] + axes[1]*localCenter[1] + axes[2]*localCenter[2];
+    return Matrix4{
+        {Vector3{axes[0]*halfSize[0]}, 0.0f},
+        {Vector3{axes[1]*halfSize[1]}, 0.0f},
+        {Vector3{axes[2]*halfSize[2]}, 0.0f},
+        {Vector3{center}, 1.0f}};
+}
+
+}}
@@ -0,0 +1,173 @@
+#ifndef Magnum_MeshTools_Bounds_h
+#define Magnum_MeshTools_Bounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::boundingBox(), @ref Magnum::MeshTools::boundingBoxesInto(), @ref Magnum::MeshTools::boundingSphereRitter(), @ref Magnum::MeshTools::boundingSphereWelzl(), @ref Magnum::MeshTools::boundingSpheresInto(), @ref Magnum::MeshTools::orientedBoundingBox()
+ * @m_since_latest
+ */
+
+#include <utility>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Axis-aligned bounding box of a point set
+@m_since_latest
+
+Calculates component-wise minimum and maximum of @p positions using
+@ref Math::minmax(const Corrade::Containers::StridedArrayView1D<const T>&).
+<em>NaN</em>s are ignored, unless all positions are <em>NaN</em>s. If
+@p positions are empty, returns a zero range.
+@see @ref boundingBoxesInto(), @ref orientedBoundingBox(),
+    @ref boundingSphereRitter(), @ref boundingSphereWelzl()
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D boundingBox(const Containers::StridedArrayView1D<const Vector3>& positions);
+
+/**
+@brief Axis-aligned bounding box of a point set using a task scheduler
+@m_since_latest
+
+Splits @p positions into chunks, calculates their bounds using
+@ref TaskScheduler::parallelFor() and merges the results. The output is the
+same as with @ref boundingBox(const Containers::StridedArrayView1D<const Vector3>&).
+*/
+MAGNUM_MESHTOOLS_EXPORT Range3D boundingBox(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const Vector3>& positions);
+
+/**
+@brief Axis-aligned bounding boxes of submeshes
+@param[in]  indices     Submesh indices
+@param[in]  offsets     Offsets of submeshes in @p indices
+@param[in]  positions   Vertex positions
+@param[out] boxes       Where to put the bounding boxes
+@m_since_latest
+
+Submesh @cpp i @ce consists of vertices referenced by
+@cpp indices[offsets[i]] @ce up to but not including
+@cpp indices[offsets[i + 1]] @ce, which means @p offsets is expected to be
+one item larger than @p boxes, non-decreasing and with the last value not
+larger than size of @p indices. The same vertices can be shared by more
+submeshes, which makes this usable also for meshlet-like clusters. Expects
+that all indices are in bounds for @p positions. Empty submeshes get a zero
+range.
+@see @ref boundingBox(), @ref boundingSpheresInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingBoxesInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Range3D>& boxes);
+
+/**
+@brief Axis-aligned bounding boxes of submeshes using a task scheduler
+@m_since_latest
+
+Processes the submeshes in parallel using @ref TaskScheduler::parallelFor().
+The output is the same as with the single-threaded variant.
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingBoxesInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Range3D>& boxes);
+
+/**
+@brief Approximate bounding sphere of a point set
+@return Sphere center and radius
+@m_since_latest
+
+Uses *Ritter, J. (1990). "An efficient bounding sphere"* --- an initial
+sphere is made from two distant points and then grown to include all points
+that are outside. Needs just three passes over the data, but the result can
+be noticeably larger than the minimal sphere calculated by
+@ref boundingSphereWelzl(). If @p positions are empty, returns a zero center
+and zero radius.
+@see @ref boundingSphereWelzl(), @ref boundingSpheresInto(),
+    @ref boundingBox()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Vector3, Float> boundingSphereRitter(const Containers::StridedArrayView1D<const Vector3>& positions);
+
+/**
+@brief Minimal bounding sphere of a point set
+@return Sphere center and radius
+@m_since_latest
+
+Uses an iterative variant of *Welzl, E. (1991). "Smallest enclosing disks
+(balls and ellipsoids)"* on a copy of @p positions shuffled with a fixed
+seed, so the result is deterministic. The expected time is linear, but
+compared to @ref boundingSphereRitter() it needs a temporary allocation and
+has a considerably larger constant factor. Calculation is done in double
+precision, the radius is then rounded up so all points are guaranteed to be
+inside. If @p positions are empty, returns a zero center and zero radius.
+@see @ref boundingBox()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Vector3, Float> boundingSphereWelzl(const Containers::StridedArrayView1D<const Vector3>& positions);
+
+/**
+@brief Approximate bounding spheres of submeshes
+@param[in]  indices     Submesh indices
+@param[in]  offsets     Offsets of submeshes in @p indices
+@param[in]  positions   Vertex positions
+@param[out] centers     Where to put sphere centers
+@param[out] radii       Where to put sphere radii
+@m_since_latest
+
+Calculates @ref boundingSphereRitter() for each submesh. Submeshes are
+defined the same way as in @ref boundingBoxesInto(), @p centers and @p radii
+are expected to have the same size, one item less than @p offsets. Empty
+submeshes get a zero center and zero radius.
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingSpheresInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& centers, const Containers::StridedArrayView1D<Float>& radii);
+
+/**
+@brief Approximate bounding spheres of submeshes using a task scheduler
+@m_since_latest
+
+Processes the submeshes in parallel using @ref TaskScheduler::parallelFor().
+The output is the same as with the single-threaded variant.
+*/
+MAGNUM_MESHTOOLS_EXPORT void boundingSpheresInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& centers, const Containers::StridedArrayView1D<Float>& radii);
+
+/**
+@brief Oriented bounding box of a point set
+@return Transformation of a @f$ [-1, 1]^3 @f$ cube to the box
+@m_since_latest
+
+Box axes are principal axes of the point set, calculated as eigenvectors of
+its covariance matrix using @ref Math::Algorithms::svd(). The points are then
+projected on the axes to get the box extents. The returned matrix has the
+axes scaled by half of the extents in its rotation part and box center in
+its translation part, which means it can be directly used to draw for
+example @ref Primitives::cubeWireframe(). The axes form a right-handed
+coordinate system. If the decomposition doesn't converge, coordinate axes
+are used, which gives the same result as @ref boundingBox(). If
+@p positions are empty, returns a zero matrix.
+
+The result is not the minimal-volume box in general, but PCA gives a good
+fit for elongated or otherwise non-axis-aligned meshes at a fraction of the
+cost.
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix4 orientedBoundingBox(const Containers::StridedArrayView1D<const Vector3>& positions);
+
+}}
+
+#endif
@@ -32,10 +32,14 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/PackingBatch.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/MeshTools/Implementation/CompileData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -126,32 +130,46 @@ std::tuple<GL::Mesh, std::unique_ptr<GL::Buffer>, std::unique_ptr<GL::Buffer>> c
 }
 #endif
 
-GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags) {
-    GL::Mesh mesh;
-    mesh.setPrimitive(meshData.primitive());
+Implementation::CompileData Implementation::prepareCompile(const Trade::MeshData3D& meshData, const CompileFlags flags) {
+    CompileData out;
+    out.primitive = meshData.primitive();
 
     const bool generateNormals = flags & (CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals) && meshData.primitive() == MeshPrimitive::Triangles;
+    const bool quantizePositions = flags & CompileFlag::QuantizePositions;
+    const bool quantizeNormals = flags & CompileFlag::QuantizeNormals;
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    const bool quantizeTextureCoords = flags & CompileFlag::QuantizeTextureCoordinates;
+    #else
+    constexpr bool quantizeTextureCoords = false;
+    #endif
+
+    /* Size of the data for each attribute. Quantized positions and normals
+       are padded to four bytes to keep each attribute aligned. */
+    const UnsignedInt positionSize = quantizePositions ? sizeof(Vector4us) : sizeof(Shaders::Generic3D::Position::Type);
+    const UnsignedInt normalSize = quantizeNormals ? sizeof(Vector4b) : sizeof(Shaders::Generic3D::Normal::Type);
+    const UnsignedInt textureCoordsSize = quantizeTextureCoords ? sizeof(Vector2us) : sizeof(Shaders::Generic3D::TextureCoordinates::Type);
 
     /* Decide about stride and offsets */
-    UnsignedInt stride = sizeof(Shaders::Generic3D::Position::Type);
-    const UnsignedInt normalOffset = sizeof(Shaders::Generic3D::Position::Type);
-    UnsignedInt textureCoordsOffset = sizeof(Shaders::Generic3D::Position::Type);
-    UnsignedInt colorsOffset = sizeof(Shaders::Generic3D::Position::Type);
+    UnsignedInt stride = positionSize;
+    const UnsignedInt normalOffset = positionSize;
+    UnsignedInt textureCoordsOffset = positionSize;
+    UnsignedInt colorsOffset = positionSize;
     if(meshData.hasNormals() || generateNormals) {
-        stride += sizeof(Shaders::Generic3D::Normal::Type);
-        textureCoordsOffset += sizeof(Shaders::Generic3D::Normal::Type);
-        colorsOffset += sizeof(Shaders::Generic3D::Normal::Type);
+        stride += normalSize;
+        textureCoordsOffset += normalSize;
+        colorsOffset += normalSize;
     }
     if(meshData.hasTextureCoords2D()) {
-        stride += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
-        colorsOffset += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+        stride += textureCoordsSize;
+        colorsOffset += textureCoordsSize;
     }
     if(meshData.hasColors())
         stride += sizeof(Shaders::Generic3D::Color4::Type);
 
-    /* Create vertex buffer */
-    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
-    GL::Buffer vertexBufferRef = GL::Buffer::wrap(vertexBuffer.id(), GL::Buffer::TargetHint::Array);
+    out.stride = stride;
+    out.normalOffset = normalOffset;
+    out.textureCoordsOffset = textureCoordsOffset;
+    out.colorsOffset = colorsOffset;
 
     /* Indirect reference to the mesh data -- either directly the original mesh
        data or processed ones */
@@ -213,38 +231,62 @@ GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags) {
         useIndices = meshData.isIndexed();
     }
 
-    /* Interleave positions and put them in with ownership transfer, use the
-       ref for the rest */
-    Containers::Array<char> data = MeshTools::interleave(
-        positions,
-        stride - sizeof(Shaders::Generic3D::Position::Type));
-    mesh.addVertexBuffer(std::move(vertexBuffer), 0,
-        Shaders::Generic3D::Position(),
-        stride - sizeof(Shaders::Generic3D::Position::Type));
-
-    /* Add also normals, if present */
-    if(normals) {
+    /* Interleave positions first, the rest is put into the already allocated
+       array. Quantized positions are unsigned normalized relative to the mesh
+       bounds, the dequantization is left on the user. */
+    Containers::Array<char> data;
+    if(quantizePositions) {
+        Containers::Array<Vector3us> quantized{Containers::NoInit, positions.size()};
+        out.dequantization = quantizePositionsInto(positions, Containers::arrayView(quantized));
+        data = MeshTools::interleave(quantized,
+            stride - sizeof(Vector3us));
+    } else {
+        data = MeshTools::interleave(
+            positions,
+            stride - sizeof(Shaders::Generic3D::Position::Type));
+    }
+    out.quantizedPositions = quantizePositions;
+
+    /* Add also normals, if present. Quantized normals are signed normalized,
+       as the stock shaders renormalize them anyway, no dequantization is
+       needed. */
+    if(normals && quantizeNormals) {
+        Containers::Array<Vector3b> quantized{Containers::NoInit, normals.size()};
+        Math::packInto(Containers::arrayCast<2, const Float>(normals),
+            Containers::arrayCast<2, Byte>(Containers::stridedArrayView(Containers::arrayView(quantized))));
         MeshTools::interleaveInto(data,
             normalOffset,
-            normals,
-            stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
-        mesh.addVertexBuffer(vertexBufferRef, 0,
+            quantized,
+            stride - normalOffset - sizeof(Vector3b));
+    } else if(normals) {
+        MeshTools::interleaveInto(data,
             normalOffset,
-            Shaders::Generic3D::Normal(),
+            normals,
             stride - normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
     }
+    out.hasNormals = bool(normals);
+    out.quantizedNormals = normals && quantizeNormals;
 
     /* Add also texture coordinates, if present */
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    if(textureCoords2D && quantizeTextureCoords) {
+        Containers::Array<Vector2us> quantized{Containers::NoInit, textureCoords2D.size()};
+        Math::packHalfInto(Containers::arrayCast<2, const Float>(textureCoords2D),
+            Containers::arrayCast<2, UnsignedShort>(Containers::stridedArrayView(Containers::arrayView(quantized))));
+        MeshTools::interleaveInto(data,
+            textureCoordsOffset,
+            quantized,
+            stride - textureCoordsOffset - sizeof(Vector2us));
+    } else
+    #endif
     if(textureCoords2D) {
         MeshTools::interleaveInto(data,
             textureCoordsOffset,
             textureCoords2D,
             stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
-        mesh.addVertexBuffer(vertexBufferRef, 0,
-            textureCoordsOffset,
-            Shaders::Generic3D::TextureCoordinates(),
-            stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
     }
+    out.hasTextureCoords = bool(textureCoords2D);
+    out.quantizedTextureCoords = textureCoords2D && quantizeTextureCoords;
 
     /* Add also colors, if present */
     if(colors) {
@@ -252,34 +294,119 @@ GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags) {
             colorsOffset,
             colors,
             stride - colorsOffset - sizeof(Shaders::Generic3D::Color4::Type));
-        mesh.addVertexBuffer(vertexBufferRef, 0,
-            colorsOffset,
-            Shaders::Generic3D::Color4(),
-            stride - colorsOffset - sizeof(Shaders::Generic3D::Color4::Type));
     }
+    out.hasColors = bool(colors);
 
-    /* Fill vertex buffer with interleaved data */
-    vertexBufferRef.setData(data, GL::BufferUsage::StaticDraw);
+    out.vertexData = std::move(data);
 
     /* If indexed (and the mesh didn't have the vertex data duplicated for flat
-       normals), fill index buffer and configure indexed mesh */
+       normals), compress the indices */
+    out.indexed = useIndices;
     if(useIndices) {
-        Containers::Array<char> indexData;
-        MeshIndexType indexType;
-        UnsignedInt indexStart, indexEnd;
-        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(meshData.indices());
+        std::tie(out.indexData, out.indexType, out.indexStart, out.indexEnd) = MeshTools::compressIndices(meshData.indices());
+        out.count = meshData.indices().size();
 
-        GL::Buffer indexBuffer{GL::Buffer::TargetHint::ElementArray};
-        indexBuffer.setData(indexData, GL::BufferUsage::StaticDraw);
-        mesh.setCount(meshData.indices().size())
-            .setIndexBuffer(std::move(indexBuffer), 0, indexType, indexStart, indexEnd);
+    /* Else use vertex count */
+    } else out.count = positions.size();
 
-    /* Else set vertex count */
-    } else mesh.setCount(positions.size());
+    return out;
+}
+
+GL::Mesh Implementation::uploadCompiled(const CompileData& data) {
+    GL::Mesh mesh;
+    mesh.setPrimitive(data.primitive);
+
+    const UnsignedInt stride = data.stride;
+
+    /* Create vertex buffer, put it in with ownership transfer, use the ref for
+       the rest */
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+    GL::Buffer vertexBufferRef = GL::Buffer::wrap(vertexBuffer.id(), GL::Buffer::TargetHint::Array);
+    vertexBuffer.setData(data.vertexData, GL::BufferUsage::StaticDraw);
+
+    if(data.quantizedPositions) {
+        mesh.addVertexBuffer(std::move(vertexBuffer), 0,
+            Shaders::Generic3D::Position{
+                Shaders::Generic3D::Position::Components::Three,
+                Shaders::Generic3D::Position::DataType::UnsignedShort,
+                Shaders::Generic3D::Position::DataOption::Normalized},
+            stride - sizeof(Vector3us));
+    } else {
+        mesh.addVertexBuffer(std::move(vertexBuffer), 0,
+            Shaders::Generic3D::Position(),
+            stride - sizeof(Shaders::Generic3D::Position::Type));
+    }
+
+    if(data.quantizedNormals) {
+        mesh.addVertexBuffer(vertexBufferRef, 0,
+            data.normalOffset,
+            Shaders::Generic3D::Normal{
+                Shaders::Generic3D::Normal::Components::Three,
+                Shaders::Generic3D::Normal::DataType::Byte,
+                Shaders::Generic3D::Normal::DataOption::Normalized},
+            stride - data.normalOffset - sizeof(Vector3b));
+    } else if(data.hasNormals) {
+        mesh.addVertexBuffer(vertexBufferRef, 0,
+            data.normalOffset,
+            Shaders::Generic3D::Normal(),
+            stride - data.normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
+    }
+
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    if(data.quantizedTextureCoords) {
+        mesh.addVertexBuffer(vertexBufferRef, 0,
+            data.textureCoordsOffset,
+            Shaders::Generic3D::TextureCoordinates{
+                Shaders::Generic3D::TextureCoordinates::Components::Two,
+                Shaders::Generic3D::TextureCoordinates::DataType::Half},
+            stride - data.textureCoordsOffset - sizeof(Vector2us));
+    } else
+    #endif
+    if(data.hasTextureCoords) {
+        mesh.addVertexBuffer(vertexBufferRef, 0,
+            data.textureCoordsOffset,
+            Shaders::Generic3D::TextureCoordinates(),
+            stride - data.textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
+    }
+
+    if(data.hasColors) {
+        mesh.addVertexBuffer(vertexBufferRef, 0,
+            data.colorsOffset,
+            Shaders::Generic3D::Color4(),
+            stride - data.colorsOffset - sizeof(Shaders::Generic3D::Color4::Type));
+    }
+
+    /* If indexed, fill index buffer and configure indexed mesh */
+    mesh.setCount(data.count);
+    if(data.indexed) {
+        GL::Buffer indexBuffer{GL::Buffer::TargetHint::ElementArray};
+        indexBuffer.setData(data.indexData, GL::BufferUsage::StaticDraw);
+        mesh.setIndexBuffer(std::move(indexBuffer), 0, data.indexType, data.indexStart, data.indexEnd);
+    }
 
     return mesh;
 }
 
+namespace {
+
+GL::Mesh compileInternal(const Trade::MeshData3D& meshData, const CompileFlags flags, Matrix4* const dequantization) {
+    const Implementation::CompileData data = Implementation::prepareCompile(meshData, flags);
+    if(dequantization) *dequantization = data.dequantization;
+    return Implementation::uploadCompiled(data);
+}
+
+}
+
+GL::Mesh compile(const Trade::MeshData3D& meshData, const CompileFlags flags) {
+    CORRADE_ASSERT(!(flags & CompileFlag::QuantizePositions),
+        "MeshTools::compile(): use the overload returning a dequantization transformation for quantized positions", GL::Mesh{NoCreate});
+    return compileInternal(meshData, flags, nullptr);
+}
+
+GL::Mesh compile(const Trade::MeshData3D& meshData, const CompileFlags flags, Matrix4& dequantization) {
+    return compileInternal(meshData, flags, &dequantization);
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 std::tuple<GL::Mesh, std::unique_ptr<GL::Buffer>, std::unique_ptr<GL::Buffer>> compile(const Trade::MeshData3D& meshData, GL::BufferUsage) {
     return std::make_tuple(compile(meshData),
@@ -72,7 +72,45 @@ enum class CompileFlag: UnsignedByte {
      * is not a triangle mesh or doesn't have 3D positions, this flag does
      * nothing. If the mesh already has its own normals, these get replaced.
      */
-    GenerateSmoothNormals = 1 << 1
+    GenerateSmoothNormals = 1 << 1,
+
+    /**
+     * Quantize positions to normalized 16-bit values relative to the mesh
+     * bounds using @ref quantizePositionsInto(), making them take 8 bytes
+     * instead of 12 bytes per vertex (including padding to four bytes). The
+     * dequantization transformation is returned through
+     * @ref compile(const Trade::MeshData3D&, CompileFlags, Matrix4&) and
+     * is expected to be multiplied with the transformation matrix the mesh
+     * is drawn with. Specifying this flag with the overload that doesn't
+     * return the dequantization transformation is an error.
+     * @m_since_latest
+     */
+    QuantizePositions = 1 << 2,
+
+    /**
+     * Quantize normals to normalized 8-bit signed values using
+     * @ref Math::packInto(), making them take 4 bytes instead of 12 bytes per
+     * vertex (including padding). Applies also to generated normals. If the
+     * mesh has no normals, this flag does nothing.
+     * @m_since_latest
+     */
+    QuantizeNormals = 1 << 3,
+
+    #if defined(DOXYGEN_GENERATING_OUTPUT) || !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    /**
+     * Convert texture coordinates to half-floats using
+     * @ref Math::packHalfInto(), making them take 4 bytes instead of 8 bytes
+     * per vertex. If the mesh has no texture coordinates, this flag does
+     * nothing.
+     * @m_since_latest
+     * @requires_gl30 Extension @gl_extension{ARB,half_float_vertex}
+     * @requires_gles30 Extension @gl_extension{OES,vertex_half_float} in
+     *      OpenGL ES 2.0
+     * @requires_webgl20 Half float vertex attributes are not available in
+     *      WebGL 1.0.
+     */
+    QuantizeTextureCoordinates = 1 << 4
+    #endif
 };
 
 /**
@@ -129,9 +167,13 @@ possibly also index buffer, if the mesh is indexed. Positions are bound to
 are bound to @ref Shaders::Generic3D::Normal attribute, texture coordinates are
 bound to @ref Shaders::Generic3D::TextureCoordinates attribute. If the mesh
 contains colors, they are bound to @ref Shaders::Generic3D::Color4 attribute.
-No data compression or index optimization (except for index buffer packing) is
-done, both the vertex buffer and the index buffer (if any) is owned by the mesh,
-both created with @ref GL::BufferUsage::StaticDraw.
+No data compression or index optimization (except for index buffer packing and
+the optional attribute quantization selected via @p flags) is done, both the
+vertex buffer and the index buffer (if any) is owned by the mesh, both created
+with @ref GL::BufferUsage::StaticDraw. Expects that
+@ref CompileFlag::QuantizePositions is not present in @p flags, use
+@ref compile(const Trade::MeshData3D&, CompileFlags, Matrix4&) for that
+instead.
 
 This is just a convenience function for creating generic meshes, you might want
 to use @ref interleave() and @ref compressIndices() functions together with
@@ -147,6 +189,31 @@ greater flexibility.
 */
 MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags = {});
 
+/**
+@brief Compile 3D mesh data with quantized positions
+@param[in]  meshData        Mesh data
+@param[in]  flags           Compilation flags
+@param[out] dequantization  Dequantization transformation
+@m_since_latest
+
+Same as @ref compile(const Trade::MeshData3D&, CompileFlags), but allows
+@ref CompileFlag::QuantizePositions to be used. The @p dequantization matrix
+is set to a transformation mapping the quantized positions back to their
+original range, or to an identity if positions are not quantized. It's
+meant to be folded into the mesh transformation, normals don't need it:
+
+@code{.cpp}
+Matrix4 dequantization;
+GL::Mesh mesh = MeshTools::compile(meshData,
+    MeshTools::CompileFlag::QuantizePositions|
+    MeshTools::CompileFlag::QuantizeNormals, dequantization);
+
+shader.setTransformationMatrix(transformation*dequantization)
+    .setNormalMatrix(transformation.normalMatrix());
+@endcode
+*/
+MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData3D& meshData, CompileFlags flags, Matrix4& dequantization);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /** @brief @copybrief compile(const Trade::MeshData3D&, CompileFlags)
  * @m_deprecated_since{2018,10} Use @ref compile(const Trade::MeshData3D&, CompileFlags)
@@ -36,6 +36,7 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/TaskScheduler.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -82,6 +83,27 @@ template<class IndexType, class T> void duplicateInto(const Containers::StridedA
     }
 }
 
+/**
+@brief Duplicate data using an index array into given output array in parallel
+@param[in]  scheduler   Task scheduler to use
+@param[in]  indices     Index array to use
+@param[in]  data        Input data
+@param[out] out         Where to store the output
+@m_since_latest
+
+Splits the index array into chunks and processes them with
+@ref duplicateInto(const Containers::StridedArrayView1D<const IndexType>&, const Containers::StridedArrayView1D<const T>&, const Containers::StridedArrayView1D<T>&)
+using @ref TaskScheduler::parallelFor(). The output is the same as with the
+single-threaded variant.
+*/
+template<class IndexType, class T> void duplicateInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const IndexType>& indices, const Containers::StridedArrayView1D<const T>& data, const Containers::StridedArrayView1D<T>& out) {
+    CORRADE_ASSERT(out.size() == indices.size(),
+        "MeshTools::duplicateInto(): bad output size, expected" << indices.size() << "but got" << out.size(), );
+    scheduler.parallelFor(indices, 16384, [&](const Containers::StridedArrayView1D<const IndexType>& chunk, std::size_t offset) {
+        duplicateInto<IndexType, T>(chunk, data, out.slice(offset, offset + chunk.size()));
+    });
+}
+
 /**
 @brief Duplicate data using given index array
 
@@ -0,0 +1,158 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DuplicateForWireframe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* All possible assignments of corner IDs to the three triangle vertices */
+constexpr UnsignedByte CornerPermutations[6][3]{
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+}
+
+std::pair<Containers::Array<UnsignedInt>, Containers::Array<UnsignedInt>> duplicateForWireframe(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::duplicateForWireframe(): index count not divisible by 3", {});
+
+    const std::size_t triangleCount = indices.size()/3;
+    UnsignedInt vertexCount = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        vertexCount = std::max(vertexCount, indices[i] + 1);
+
+    /* Vertex-triangle adjacency, the triangles adjacent to vertex i are
+       triangles[offsets[i]] to triangles[offsets[i + 1]] */
+    Containers::Array<UnsignedInt> offsets{Containers::ValueInit, std::size_t(vertexCount) + 1};
+    Containers::Array<UnsignedInt> triangles{Containers::NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        ++offsets[indices[i] + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        offsets[i + 1] += offsets[i];
+    {
+        Containers::Array<UnsignedInt> cursor{Containers::NoInit, vertexCount};
+        std::memcpy(cursor.data(), offsets.data(), vertexCount*sizeof(UnsignedInt));
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            triangles[cursor[indices[i]]++] = i/3;
+    }
+
+    /* For every original vertex, new index of its copy with given corner ID
+       or ~0 if there's no such copy yet */
+    Containers::Array<Vector3ui> copies{Containers::NoInit, vertexCount};
+    for(Vector3ui& i: copies) i = Vector3ui{~UnsignedInt{}};
+
+    /* Original vertices for copies with given corner ID, in order */
+    std::vector<UnsignedInt> corners[3];
+
+    /* Triangles are processed in a breadth-first order over shared edges, so
+       for each triangle except the first in a connected region the corner
+       IDs of at least two vertices are already decided. That's enough for a
+       mesh with a three-colorable vertex graph to not need any duplicates. */
+    Containers::Array<UnsignedInt> queue{Containers::NoInit, triangleCount};
+    Containers::Array<bool> visited{Containers::ValueInit, triangleCount};
+    Containers::Array<UnsignedInt> outIndices{Containers::NoInit, indices.size()};
+    for(std::size_t first = 0; first != triangleCount; ++first) {
+        if(visited[first]) continue;
+
+        std::size_t queueBegin = 0, queueEnd = 0;
+        queue[queueEnd++] = first;
+        visited[first] = true;
+        while(queueBegin != queueEnd) {
+            const std::size_t t = queue[queueBegin++];
+            const UnsignedInt triangle[]{indices[3*t], indices[3*t + 1], indices[3*t + 2]};
+
+            /* Pick the assignment that creates the least new copies, on a tie
+               the one putting the copies to the least populated corner IDs */
+            std::size_t best = 0;
+            std::size_t bestNew = ~std::size_t{}, bestPopulation = ~std::size_t{};
+            for(std::size_t p = 0; p != 6; ++p) {
+                std::size_t newCount = 0, population = 0;
+                for(std::size_t j = 0; j != 3; ++j) {
+                    const UnsignedByte corner = CornerPermutations[p][j];
+                    if(copies[triangle[j]][corner] != ~UnsignedInt{}) continue;
+                    ++newCount;
+                    population += corners[corner].size();
+                }
+
+                if(newCount < bestNew || (newCount == bestNew && population < bestPopulation)) {
+                    best = p;
+                    bestNew = newCount;
+                    bestPopulation = population;
+                }
+            }
+
+            for(std::size_t j = 0; j != 3; ++j) {
+                const UnsignedByte corner = CornerPermutations[best][j];
+                UnsignedInt& copy = copies[triangle[j]][corner];
+                if(copy == ~UnsignedInt{}) {
+                    copy = 3*UnsignedInt(corners[corner].size()) + corner;
+                    corners[corner].push_back(triangle[j]);
+                }
+                outIndices[3*t + j] = copy;
+            }
+
+            /* Enqueue unvisited triangles sharing an edge with this one */
+            for(const UnsignedInt vertex: triangle) {
+                for(UnsignedInt i = offsets[vertex], end = offsets[vertex + 1]; i != end; ++i) {
+                    const UnsignedInt neighbor = triangles[i];
+                    if(visited[neighbor]) continue;
+
+                    std::size_t shared = 0;
+                    for(std::size_t j = 0; j != 3; ++j) {
+                        const UnsignedInt v = indices[3*neighbor + j];
+                        if(v == triangle[0] || v == triangle[1] || v == triangle[2])
+                            ++shared;
+                    }
+                    if(shared < 2) continue;
+
+                    visited[neighbor] = true;
+                    queue[queueEnd++] = neighbor;
+                }
+            }
+        }
+    }
+
+    /* Interleave the per-corner vertex lists, padding the shorter ones with
+       vertex 0 */
+    const std::size_t copyCount = std::max({corners[0].size(), corners[1].size(), corners[2].size()});
+    Containers::Array<UnsignedInt> mapping{Containers::ValueInit, 3*copyCount};
+    for(UnsignedInt corner = 0; corner != 3; ++corner)
+        for(std::size_t i = 0; i != corners[corner].size(); ++i)
+            mapping[3*i + corner] = corners[corner][i];
+
+    return {std::move(outIndices), std::move(mapping)};
+}
+
+}}
@@ -0,0 +1,81 @@
+#ifndef Magnum_MeshTools_DuplicateForWireframe_h
+#define Magnum_MeshTools_DuplicateForWireframe_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::duplicateForWireframe()
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Prepare an indexed mesh for wireframe rendering without a geometry shader
+@param indices      Triangle indices
+@return New triangle indices and a mapping from new vertices to the original
+    ones
+@m_since_latest
+
+The @ref Shaders::MeshVisualizer wireframe rendering without a geometry shader
+needs each triangle to consist of vertices whose index modulo 3 is different.
+Instead of de-indexing the whole mesh with @ref duplicate(), which makes the
+vertex count equal to the index count, this function assigns every vertex a
+corner ID between 0 and 2 so all triangles have distinct corner IDs, and
+duplicates a vertex only if it has to appear with more than one corner ID. The
+triangles are processed in a breadth-first order over shared edges and each is
+given a corner assignment that needs the least new vertex copies, preferring
+corner IDs with the least vertices on a tie.
+
+A copy of a vertex with corner ID @f$ c @f$ gets a new index @f$ 3n + c @f$,
+where @f$ n @f$ is the count of copies having the same corner ID created
+before it. The second returned array has a size divisible by 3 and maps the
+new vertices to the original ones, to be used with @ref duplicate() to create
+the new vertex data. Slots not used by any copy, which are needed to keep the
+index-to-corner-ID relation, are mapped to vertex @cpp 0 @ce. The new vertex
+index is then usable directly as the @ref Shaders::MeshVisualizer::VertexIndex
+attribute, where it's needed.
+
+@snippet MagnumMeshTools.cpp duplicateForWireframe
+
+A mesh where the vertex graph can be colored with three colors, such as a
+regular triangulated grid, needs no duplicates apart from the padding. For
+icospheres of subdivision levels 1 to 4 the vertex count grows by 36% to 7%,
+compared to almost six times the vertex count with @ref duplicate().
+
+Expects that the index count is divisible by 3.
+@see @ref Shaders-MeshVisualizer-wireframe
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, Containers::Array<UnsignedInt>> duplicateForWireframe(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+}}
+
+#endif
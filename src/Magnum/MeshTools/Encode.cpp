@@ -0,0 +1,480 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Encode.h"
+
+#include <cstring>
+#include <limits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* First byte of the encoded data, used to detect that the data are of the
+   right kind. The low nibble is a version. */
+enum: UnsignedByte {
+    IndexDataHeader = 0xe0,
+    VertexDataHeader = 0xd0
+};
+
+/* LEB128 */
+inline std::size_t writeVarint(char* const out, UnsignedInt value) {
+    std::size_t i = 0;
+    while(value >= 0x80) {
+        out[i++] = char(value|0x80);
+        value >>= 7;
+    }
+    out[i++] = char(value);
+    return i;
+}
+
+inline bool readVarint(const char*& data, const char* const end, UnsignedInt& value) {
+    value = 0;
+    for(UnsignedInt shift = 0; shift < 35; shift += 7) {
+        if(data == end) return false;
+        const UnsignedByte byte = *data++;
+        value |= UnsignedInt(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/* Zigzag mapping of a signed delta to an unsigned value, so small negative
+   values are small as well */
+inline UnsignedInt zigzag(const UnsignedInt delta) {
+    return (delta << 1) ^ UnsignedInt(-Int(delta >> 31));
+}
+
+inline UnsignedInt unzigzag(const UnsignedInt value) {
+    return (value >> 1) ^ UnsignedInt(-Int(value & 1));
+}
+
+inline UnsignedByte zigzag(const UnsignedByte delta) {
+    return UnsignedByte((delta << 1) ^ -(delta >> 7));
+}
+
+inline UnsignedByte unzigzag(const UnsignedByte value) {
+    return UnsignedByte((value >> 1) ^ -(value & 1));
+}
+
+/* State shared by the index encoder and decoder, both have to update it in
+   the exact same way */
+struct IndexCodecState {
+    explicit IndexCodecState() {
+        for(UnsignedInt(&edge)[2]: edges)
+            edge[0] = edge[1] = ~UnsignedInt{};
+        for(UnsignedInt& vertex: vertices)
+            vertex = ~UnsignedInt{};
+    }
+
+    void pushEdge(const UnsignedInt a, const UnsignedInt b) {
+        UnsignedInt(&edge)[2] = edges[edgeOffset++ & 15];
+        edge[0] = a;
+        edge[1] = b;
+    }
+
+    const UnsignedInt(&edge(const std::size_t i) const)[2] {
+        return edges[(edgeOffset - 1 - i) & 15];
+    }
+
+    /* Remembers a vertex that wasn't referenced from the vertex FIFO */
+    void pushVertex(const UnsignedInt vertex) {
+        vertices[vertexOffset++ & 15] = vertex;
+        last = vertex;
+        if(vertex >= next) next = vertex + 1;
+    }
+
+    UnsignedInt vertex(const std::size_t i) const {
+        return vertices[(vertexOffset - 1 - i) & 15];
+    }
+
+    /* Pushes the triangle edges reversed, as that's how they appear in the
+       neighboring triangles with the same winding */
+    void pushTriangle(const UnsignedInt a, const UnsignedInt b, const UnsignedInt c) {
+        pushEdge(b, a);
+        pushEdge(c, b);
+        pushEdge(a, c);
+    }
+
+    UnsignedInt edges[16][2];
+    UnsignedInt vertices[16];
+    std::size_t edgeOffset{}, vertexOffset{};
+    UnsignedInt next{}, last{};
+};
+
+/* Count of edges and vertices looked up in the FIFOs. The 0xf edge code
+   signals that no edge was found, low nibble 0 is the next vertex and 0xf
+   is an explicitly encoded vertex. */
+constexpr std::size_t EdgeLookup = 15;
+constexpr std::size_t VertexLookup = 14;
+
+}
+
+template<class T> Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const T>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::encodeIndices(): index count not divisible by 3", {});
+
+    /* Worst case is one code byte and three five-byte varints per triangle */
+    Containers::Array<char> out{Containers::NoInit, 1 + 5 + indices.size()/3*16};
+    char* ptr = out.data();
+    *ptr++ = char(IndexDataHeader);
+    ptr += writeVarint(ptr, UnsignedInt(indices.size()));
+
+    IndexCodecState state;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt a = indices[i], b = indices[i + 1], c = indices[i + 2];
+
+        /* Find an edge shared with a recent triangle, rotate the triangle so
+           it starts with the edge */
+        std::size_t edge = EdgeLookup;
+        UnsignedInt x{}, y{}, z{};
+        for(std::size_t e = 0; e != EdgeLookup; ++e) {
+            const UnsignedInt(&candidate)[2] = state.edge(e);
+            if(candidate[0] == a && candidate[1] == b) {
+                x = a; y = b; z = c;
+            } else if(candidate[0] == b && candidate[1] == c) {
+                x = b; y = c; z = a;
+            } else if(candidate[0] == c && candidate[1] == a) {
+                x = c; y = a; z = b;
+            } else continue;
+
+            edge = e;
+            break;
+        }
+
+        /* Edge found, encode just the third vertex */
+        if(edge != EdgeLookup) {
+            char& code = *ptr++;
+            UnsignedByte vertexCode = 0xf;
+            if(z == state.next) {
+                vertexCode = 0;
+                state.pushVertex(z);
+            } else {
+                for(std::size_t v = 0; v != VertexLookup; ++v) if(state.vertex(v) == z) {
+                    vertexCode = UnsignedByte(v + 1);
+                    break;
+                }
+
+                if(vertexCode == 0xf) {
+                    ptr += writeVarint(ptr, zigzag(z - state.last));
+                    state.pushVertex(z);
+                }
+            }
+
+            code = char(edge << 4 | vertexCode);
+            state.pushEdge(z, y);
+            state.pushEdge(x, z);
+
+        /* Otherwise encode all three vertices, each either as the next vertex
+           or explicitly */
+        } else {
+            char& code = *ptr++;
+            UnsignedByte nextMask = 0;
+            const UnsignedInt triangle[]{a, b, c};
+            for(std::size_t v = 0; v != 3; ++v) {
+                if(triangle[v] == state.next)
+                    nextMask |= 1 << v;
+                else ptr += writeVarint(ptr, zigzag(triangle[v] - state.last));
+                state.pushVertex(triangle[v]);
+            }
+
+            code = char(EdgeLookup << 4 | nextMask);
+            state.pushTriangle(a, b, c);
+        }
+    }
+
+    /* Copy to an array of exact size */
+    Containers::Array<char> result{Containers::NoInit, std::size_t(ptr - out.data())};
+    std::memcpy(result.data(), out.data(), result.size());
+    return result;
+}
+
+template Containers::Array<char> encodeIndices<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&);
+template Containers::Array<char> encodeIndices<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&);
+template Containers::Array<char> encodeIndices<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&);
+
+template<class T> bool decodeIndicesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<T>& indices) {
+    const char* ptr = data.begin();
+    const char* const end = data.end();
+    UnsignedInt count;
+    if(data.empty() || UnsignedByte(*ptr++) != IndexDataHeader || !readVarint(ptr, end, count)) {
+        Error{} << "MeshTools::decodeIndicesInto(): invalid header";
+        return false;
+    }
+    if(count != indices.size()) {
+        Error{} << "MeshTools::decodeIndicesInto(): expected" << indices.size() << "indices but got" << count;
+        return false;
+    }
+
+    IndexCodecState state;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        if(ptr == end) {
+            Error{} << "MeshTools::decodeIndicesInto(): unexpected end of data";
+            return false;
+        }
+
+        const UnsignedByte code = *ptr++;
+        const std::size_t edge = code >> 4;
+        UnsignedInt a, b, c;
+
+        /* Edge found, decode the third vertex */
+        if(edge != EdgeLookup) {
+            const UnsignedInt(&shared)[2] = state.edge(edge);
+            a = shared[0];
+            b = shared[1];
+
+            const UnsignedByte vertexCode = code & 0xf;
+            if(vertexCode == 0) {
+                c = state.next;
+                state.pushVertex(c);
+            } else if(vertexCode != 0xf) {
+                c = state.vertex(vertexCode - 1);
+            } else {
+                UnsignedInt delta;
+                if(!readVarint(ptr, end, delta)) {
+                    Error{} << "MeshTools::decodeIndicesInto(): unexpected end of data";
+                    return false;
+                }
+                c = state.last + unzigzag(delta);
+                state.pushVertex(c);
+            }
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+
+        /* Otherwise decode all three vertices */
+        } else {
+            UnsignedInt triangle[3];
+            for(std::size_t v = 0; v != 3; ++v) {
+                if(code & (1 << v))
+                    triangle[v] = state.next;
+                else {
+                    UnsignedInt delta;
+                    if(!readVarint(ptr, end, delta)) {
+                        Error{} << "MeshTools::decodeIndicesInto(): unexpected end of data";
+                        return false;
+                    }
+                    triangle[v] = state.last + unzigzag(delta);
+                }
+                state.pushVertex(triangle[v]);
+            }
+
+            a = triangle[0];
+            b = triangle[1];
+            c = triangle[2];
+            state.pushTriangle(a, b, c);
+        }
+
+        /* Invalid data may result in values that don't fit into the type,
+           for example when referencing the initial ~0 values in the FIFOs */
+        if((a|b|c) & ~UnsignedInt(std::numeric_limits<T>::max())) {
+            Error{} << "MeshTools::decodeIndicesInto(): decoded index doesn't fit into" << sizeof(T)*8 << "bits";
+            return false;
+        }
+
+        indices[i] = T(a);
+        indices[i + 1] = T(b);
+        indices[i + 2] = T(c);
+    }
+
+    if(ptr != end) {
+        Error{} << "MeshTools::decodeIndicesInto():" << (end - ptr) << "unexpected bytes at the end of data";
+        return false;
+    }
+
+    return true;
+}
+
+template bool decodeIndicesInto<UnsignedByte>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedByte>&);
+template bool decodeIndicesInto<UnsignedShort>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedShort>&);
+template bool decodeIndicesInto<UnsignedInt>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedInt>&);
+
+namespace {
+
+/* Bit widths of packed vertex deltas, indexed by the two-bit header value */
+constexpr UnsignedByte VertexDeltaBits[]{0, 2, 4, 8};
+
+constexpr std::size_t VertexBlockSize = 16;
+
+}
+
+Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "MeshTools::encodeVertices(): second view dimension is not contiguous", {});
+
+    const std::size_t vertexCount = vertices.size()[0];
+    const std::size_t vertexSize = vertices.size()[1];
+    const std::size_t headerSize = (vertexSize + 3)/4;
+    const std::size_t blockCount = (vertexCount + VertexBlockSize - 1)/VertexBlockSize;
+
+    /* Worst case is all deltas taking full eight bits */
+    Containers::Array<char> out{Containers::NoInit, 1 + 5 + 5 + blockCount*(headerSize + vertexSize*VertexBlockSize)};
+    char* ptr = out.data();
+    *ptr++ = char(VertexDataHeader);
+    ptr += writeVarint(ptr, UnsignedInt(vertexCount));
+    ptr += writeVarint(ptr, UnsignedInt(vertexSize));
+
+    const char* const data = static_cast<const char*>(vertices.data());
+    const std::ptrdiff_t stride = vertices.stride()[0];
+    Containers::Array<UnsignedByte> previous{Containers::ValueInit, vertexSize};
+    for(std::size_t block = 0; block < vertexCount; block += VertexBlockSize) {
+        const std::size_t blockVertexCount = Math::min(VertexBlockSize, vertexCount - block);
+        const char* const blockData = data + std::ptrdiff_t(block)*stride;
+
+        char* const header = ptr;
+        std::memset(header, 0, headerSize);
+        ptr += headerSize;
+
+        for(std::size_t byte = 0; byte != vertexSize; ++byte) {
+            /* Calculate deltas, padding the last block with zeros */
+            UnsignedByte deltas[VertexBlockSize]{};
+            UnsignedByte prev = previous[byte];
+            UnsignedByte bits = 0;
+            for(std::size_t i = 0; i != blockVertexCount; ++i) {
+                const UnsignedByte value = blockData[std::ptrdiff_t(i)*stride + byte];
+                deltas[i] = zigzag(UnsignedByte(value - prev));
+                bits |= deltas[i];
+                prev = value;
+            }
+            previous[byte] = prev;
+
+            /* Pick the smallest bit width that can hold all deltas */
+            const UnsignedByte width = !bits ? 0 : bits < 4 ? 1 : bits < 16 ? 2 : 3;
+            header[byte/4] |= char(width << (byte%4*2));
+
+            /* Pack */
+            const UnsignedByte deltaBits = VertexDeltaBits[width];
+            if(!deltaBits) continue;
+            const std::size_t deltasPerByte = 8/deltaBits;
+            for(std::size_t i = 0; i != VertexBlockSize; i += deltasPerByte) {
+                UnsignedByte packed = 0;
+                for(std::size_t j = 0; j != deltasPerByte; ++j)
+                    packed |= deltas[i + j] << (j*deltaBits);
+                *ptr++ = char(packed);
+            }
+        }
+    }
+
+    /* Copy to an array of exact size */
+    Containers::Array<char> result{Containers::NoInit, std::size_t(ptr - out.data())};
+    std::memcpy(result.data(), out.data(), result.size());
+    return result;
+}
+
+bool decodeVerticesInto(const Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "MeshTools::decodeVerticesInto(): second view dimension is not contiguous", {});
+
+    const char* ptr = data.begin();
+    const char* const end = data.end();
+    UnsignedInt vertexCount, vertexSize;
+    if(data.empty() || UnsignedByte(*ptr++) != VertexDataHeader || !readVarint(ptr, end, vertexCount) || !readVarint(ptr, end, vertexSize)) {
+        Error{} << "MeshTools::decodeVerticesInto(): invalid header";
+        return false;
+    }
+    if(vertexCount != vertices.size()[0] || vertexSize != vertices.size()[1]) {
+        Error{} << "MeshTools::decodeVerticesInto(): expected" << vertices.size()[0] << "vertices of" << vertices.size()[1] << "bytes but got" << vertexCount << "vertices of" << vertexSize << "bytes";
+        return false;
+    }
+
+    const std::size_t headerSize = (vertexSize + 3)/4;
+    char* const out = static_cast<char*>(vertices.data());
+    const std::ptrdiff_t stride = vertices.stride()[0];
+
+    /* Each block is decoded into a temporary buffer that stays in cache and
+       then copied to the output a vertex at a time. The last row of the
+       buffer holds values of the last vertex from the previous block. */
+    Containers::Array<UnsignedByte> blockData{Containers::ValueInit, (VertexBlockSize + 1)*vertexSize};
+    UnsignedByte* const previous = blockData.data() + VertexBlockSize*vertexSize;
+    for(std::size_t block = 0; block < vertexCount; block += VertexBlockSize) {
+        const std::size_t blockVertexCount = Math::min(VertexBlockSize, vertexCount - block);
+
+        if(std::size_t(end - ptr) < headerSize) {
+            Error{} << "MeshTools::decodeVerticesInto(): unexpected end of data";
+            return false;
+        }
+        const char* const header = ptr;
+        ptr += headerSize;
+
+        for(std::size_t byte = 0; byte != vertexSize; ++byte) {
+            const UnsignedByte deltaBits = VertexDeltaBits[(UnsignedByte(header[byte/4]) >> (byte%4*2)) & 0x3];
+            const std::size_t packedSize = VertexBlockSize*deltaBits/8;
+            if(std::size_t(end - ptr) < packedSize) {
+                Error{} << "MeshTools::decodeVerticesInto(): unexpected end of data";
+                return false;
+            }
+
+            /* Unpack the deltas, specialized for each bit width so the
+               compiler can unroll the loops */
+            UnsignedByte deltas[VertexBlockSize];
+            const UnsignedByte* const packed = reinterpret_cast<const UnsignedByte*>(ptr);
+            switch(deltaBits) {
+                case 0:
+                    for(std::size_t i = 0; i != VertexBlockSize; ++i)
+                        deltas[i] = 0;
+                    break;
+                case 2:
+                    for(std::size_t i = 0; i != VertexBlockSize; ++i)
+                        deltas[i] = unzigzag(UnsignedByte((packed[i/4] >> (i%4*2)) & 0x3));
+                    break;
+                case 4:
+                    for(std::size_t i = 0; i != VertexBlockSize; ++i)
+                        deltas[i] = unzigzag(UnsignedByte((packed[i/2] >> (i%2*4)) & 0xf));
+                    break;
+                case 8:
+                    for(std::size_t i = 0; i != VertexBlockSize; ++i)
+                        deltas[i] = unzigzag(packed[i]);
+                    break;
+            }
+            ptr += packedSize;
+
+            /* Accumulate */
+            UnsignedByte prev = previous[byte];
+            for(std::size_t i = 0; i != VertexBlockSize; ++i) {
+                prev += deltas[i];
+                blockData[i*vertexSize + byte] = prev;
+            }
+            previous[byte] = blockData[(blockVertexCount - 1)*vertexSize + byte];
+        }
+
+        for(std::size_t i = 0; i != blockVertexCount; ++i)
+            std::memcpy(out + std::ptrdiff_t(block + i)*stride, blockData.data() + i*vertexSize, vertexSize);
+    }
+
+    if(ptr != end) {
+        Error{} << "MeshTools::decodeVerticesInto():" << (end - ptr) << "unexpected bytes at the end of data";
+        return false;
+    }
+
+    return true;
+}
+
+}}
@@ -0,0 +1,131 @@
+#ifndef Magnum_MeshTools_Encode_h
+#define Magnum_MeshTools_Encode_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeIndices(), @ref Magnum::MeshTools::decodeIndicesInto(), @ref Magnum::MeshTools::encodeVertices(), @ref Magnum::MeshTools::decodeVerticesInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode a triangle index buffer
+@param indices      Triangle indices
+@return Encoded data
+@m_since_latest
+
+Produces a byte stream meant for compact storage of triangle index buffers.
+Each triangle is encoded relative to previous triangles --- if it shares an
+edge with one of the 15 most recently encoded triangle edges, only a single
+byte with the edge position and a reference to the third vertex is stored.
+The third vertex is then either one higher than the highest index seen so
+far, one of 14 most recently seen vertices or a variable-length delta from the
+previous vertex. Triangles not sharing a recent edge have their vertices
+encoded in a similar way.
+
+The encoding is most efficient if the triangles are ordered for vertex
+locality, for example using @ref tipsify(), and if vertices are ordered in
+the order they are first referenced by the index buffer. The output is not
+further compressed, which means it can be still successfully fed to a generic
+compressor for additional savings.
+
+Vertices of each triangle may get rotated during encoding, but the order of
+triangles and their winding is preserved. Expects that the index count is
+divisible by 3. Use @ref decodeIndicesInto() to decode the data again.
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices(const Containers::StridedArrayView1D<const T>& indices);
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&);
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&);
+extern template MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeIndices<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&);
+#endif
+
+/**
+@brief Decode a triangle index buffer
+@param[in]  data        Data produced by @ref encodeIndices()
+@param[out] indices     Where to put the decoded indices
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+@m_since_latest
+
+The @p indices array is expected to have the same size as the array passed to
+@ref encodeIndices(). If the data are invalid, truncated, the index count
+doesn't match or the decoded indices don't fit into @p T, prints a message to
+@ref Error and returns @cpp false @ce, leaving the contents of @p indices in
+an unspecified state.
+*/
+template<class T> MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<T>& indices);
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto<UnsignedByte>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedByte>&);
+extern template MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto<UnsignedShort>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedShort>&);
+extern template MAGNUM_MESHTOOLS_EXPORT bool decodeIndicesInto<UnsignedInt>(Containers::ArrayView<const char>, const Containers::StridedArrayView1D<UnsignedInt>&);
+#endif
+
+/**
+@brief Encode a vertex buffer
+@param vertices     Vertex data
+@return Encoded data
+@m_since_latest
+
+The first dimension of @p vertices is the vertex index, the second goes over
+bytes of a single vertex. Expects that the second dimension is contiguous,
+attribute types and their layout inside the vertex don't matter.
+
+Each byte of a vertex is delta-encoded relative to the same byte of the
+previous vertex. Blocks of 16 deltas are then bit-packed to 0, 2, 4 or 8 bits
+each, depending on their magnitude, so attributes that change slowly from
+vertex to vertex, such as positions of a mesh ordered for vertex locality,
+take considerably less space. For best results, the vertices should be
+quantized first (see for example @ref quantizePositionsInto()), as the low
+bits of floating-point values are generally noisy. The output can be further
+compressed with a generic compressor. Use @ref decodeVerticesInto() to decode
+the data again.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertices(const Containers::StridedArrayView2D<const char>& vertices);
+
+/**
+@brief Decode a vertex buffer
+@param[in]  data        Data produced by @ref encodeVertices()
+@param[out] vertices    Where to put the decoded vertices
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+@m_since_latest
+
+The @p vertices view is expected to have the same size as the view passed to
+@ref encodeVertices() and its second dimension is expected to be contiguous,
+the stride can be arbitrary. If the data are invalid, truncated or the size
+doesn't match, prints a message to @ref Error and returns @cpp false @ce,
+leaving the contents of @p vertices in an unspecified state.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVerticesInto(Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices);
+
+}}
+
+#endif
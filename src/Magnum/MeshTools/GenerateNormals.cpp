@@ -28,6 +28,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/TaskScheduler.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
 
@@ -52,6 +53,18 @@ void generateFlatNormalsInto(const Containers::StridedArrayView1D<const Vector3>
             positions[i] - positions[i+1]).normalized();
 }
 
+void generateFlatNormalsInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    CORRADE_ASSERT(positions.size() % 3 == 0,
+        "MeshTools::generateFlatNormalsInto(): position count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateFlatNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+
+    /* Chunks of whole triangles */
+    scheduler.parallelFor(positions.size()/3, 4096, [&](std::size_t begin, std::size_t end) {
+        generateFlatNormalsInto(positions.slice(begin*3, end*3), normals.slice(begin*3, end*3));
+    });
+}
+
 Containers::Array<Vector3> generateFlatNormals(const Containers::StridedArrayView1D<const Vector3>& positions) {
     Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
     generateFlatNormalsInto(positions, Containers::arrayView(out));
@@ -77,6 +77,20 @@ conversions:
 */
 MAGNUM_MESHTOOLS_EXPORT void generateFlatNormalsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals);
 
+/**
+@brief Generate flat normals into an existing array in parallel
+@param[in]  scheduler   Task scheduler to use
+@param[in]  positions   Triangle vertex positions
+@param[out] normals     Where to put the generated normals
+@m_since_latest
+
+Splits the triangles into chunks and processes them with
+@ref generateFlatNormalsInto(const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&)
+using @ref TaskScheduler::parallelFor(). The output is the same as with the
+single-threaded variant.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateFlatNormalsInto(TaskScheduler& scheduler, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Generate flat normals
@@ -0,0 +1,74 @@
+#ifndef Magnum_MeshTools_Implementation_CompileData_h
+#define Magnum_MeshTools_Implementation_CompileData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/MeshTools/Compile.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Result of the CPU part of compile(), containing everything needed to create
+   the GL mesh. Split out so it can be done on a different thread than the GL
+   upload, see AsyncCompiler. */
+struct CompileData {
+    MeshPrimitive primitive;
+    UnsignedInt count;
+
+    /* Interleaved vertex data layout */
+    UnsignedInt stride,
+        normalOffset,
+        textureCoordsOffset,
+        colorsOffset;
+    bool hasNormals,
+        hasTextureCoords,
+        hasColors;
+    bool quantizedPositions,
+        quantizedNormals,
+        quantizedTextureCoords;
+    Containers::Array<char> vertexData;
+
+    /* Compressed index data, empty if not indexed */
+    bool indexed;
+    MeshIndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    Containers::Array<char> indexData;
+
+    Matrix4 dequantization;
+};
+
+/* Doesn't touch any GL state, thus is safe to be called from any thread */
+CompileData prepareCompile(const Trade::MeshData3D& meshData, CompileFlags flags);
+
+/* Has to be called on a thread with a current GL context */
+GL::Mesh uploadCompiled(const CompileData& data);
+
+}}}
+
+#endif
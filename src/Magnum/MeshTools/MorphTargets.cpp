@@ -0,0 +1,111 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MorphTargets.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+MorphTarget sparseMorphTarget(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Float epsilon) {
+    CORRADE_ASSERT(normals.empty() || normals.size() == positions.size(),
+        "MeshTools::sparseMorphTarget(): expected either no normals or" << positions.size() << "but got" << normals.size(), {});
+
+    std::vector<UnsignedInt> indices;
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        if((Math::abs(positions[i]) > Vector3{epsilon}).any() ||
+           (!normals.empty() && (Math::abs(normals[i]) > Vector3{epsilon}).any()))
+            indices.push_back(UnsignedInt(i));
+    }
+
+    MorphTarget out;
+    out.indices = Containers::Array<UnsignedInt>{Containers::NoInit, indices.size()};
+    out.positions = Containers::Array<Vector3>{Containers::NoInit, indices.size()};
+    if(!normals.empty())
+        out.normals = Containers::Array<Vector3>{Containers::NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        out.indices[i] = indices[i];
+        out.positions[i] = positions[indices[i]];
+        if(!normals.empty()) out.normals[i] = normals[indices[i]];
+    }
+
+    return out;
+}
+
+namespace {
+
+/* Kept separate and working on plain pointers so the compiler has a tight
+   loop to unroll */
+void applyOffsets(const Containers::StridedArrayView1D<Vector3>& out, const UnsignedInt* const indices, const Vector3* const offsets, const std::size_t count, const Float weight) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[indices[i]] += offsets[i]*weight;
+}
+
+}
+
+std::size_t applyMorphTargets(const Containers::StridedArrayView1D<const Vector3>& basePositions, const Containers::StridedArrayView1D<const Vector3>& baseNormals, const Containers::ArrayView<const MorphTarget> targets, const Containers::ArrayView<const Float> weights, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    CORRADE_ASSERT(targets.size() == weights.size(),
+        "MeshTools::applyMorphTargets(): expected" << targets.size() << "weights but got" << weights.size(), {});
+    CORRADE_ASSERT(baseNormals.empty() || baseNormals.size() == basePositions.size(),
+        "MeshTools::applyMorphTargets(): expected either no base normals or" << basePositions.size() << "but got" << baseNormals.size(), {});
+    CORRADE_ASSERT(positions.size() == basePositions.size(),
+        "MeshTools::applyMorphTargets(): expected" << basePositions.size() << "output positions but got" << positions.size(), {});
+    CORRADE_ASSERT(normals.size() == baseNormals.size(),
+        "MeshTools::applyMorphTargets(): expected" << baseNormals.size() << "output normals but got" << normals.size(), {});
+
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = basePositions[i];
+    for(std::size_t i = 0; i != normals.size(); ++i)
+        normals[i] = baseNormals[i];
+
+    std::size_t applied = 0;
+    for(std::size_t i = 0; i != targets.size(); ++i) {
+        if(weights[i] == 0.0f) continue;
+
+        const MorphTarget& target = targets[i];
+        CORRADE_ASSERT(target.positions.size() == target.indices.size(),
+            "MeshTools::applyMorphTargets(): expected" << target.indices.size() << "position offsets in target" << i << "but got" << target.positions.size(), {});
+        CORRADE_ASSERT(target.normals.empty() || target.normals.size() == target.indices.size(),
+            "MeshTools::applyMorphTargets(): expected either no normal offsets in target" << i << "or" << target.indices.size() << "but got" << target.normals.size(), {});
+        #ifndef CORRADE_NO_ASSERT
+        for(const UnsignedInt index: target.indices)
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::applyMorphTargets(): index" << index << "in target" << i << "out of bounds for" << positions.size() << "vertices", {});
+        #endif
+
+        applyOffsets(positions, target.indices, target.positions, target.indices.size(), weights[i]);
+        if(!normals.empty() && !target.normals.empty())
+            applyOffsets(normals, target.indices, target.normals, target.indices.size(), weights[i]);
+        ++applied;
+    }
+
+    return applied;
+}
+
+}}
@@ -0,0 +1,120 @@
+#ifndef Magnum_MeshTools_MorphTargets_h
+#define Magnum_MeshTools_MorphTargets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::MorphTarget, function @ref Magnum::MeshTools::sparseMorphTarget(), @ref Magnum::MeshTools::applyMorphTargets()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Sparse morph target
+@m_since_latest
+
+Position and normal offsets of vertices affected by a morph target (also
+called a blend shape), vertices that the target doesn't move are not stored.
+Create from dense offsets using @ref sparseMorphTarget(), evaluate using
+@ref applyMorphTargets().
+*/
+struct MorphTarget {
+    /**
+     * @brief Indices of affected vertices
+     *
+     * Sorted in ascending order if created with @ref sparseMorphTarget().
+     */
+    Containers::Array<UnsignedInt> indices;
+
+    /**
+     * @brief Position offsets
+     *
+     * Same size as @ref indices.
+     */
+    Containers::Array<Vector3> positions;
+
+    /**
+     * @brief Normal offsets
+     *
+     * Either empty or the same size as @ref indices.
+     */
+    Containers::Array<Vector3> normals;
+};
+
+/**
+@brief Create a sparse morph target from dense offsets
+@param positions    Position offsets of all vertices
+@param normals      Normal offsets of all vertices or an empty view
+@param epsilon      Largest offset component that's considered zero
+@m_since_latest
+
+A vertex is put into the target if any component of its position or normal
+offset has an absolute value larger than @p epsilon. Facial animation blend
+shapes usually move only a small part of the mesh, so the result is often an
+order of magnitude smaller than the input. Expects that @p normals is either
+empty or has the same size as @p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT MorphTarget sparseMorphTarget(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals = {}, Float epsilon = 0.0f);
+
+/**
+@brief Apply morph targets
+@param basePositions    Positions of the undeformed mesh
+@param baseNormals      Normals of the undeformed mesh or an empty view
+@param targets          Morph targets
+@param weights          Morph target weights
+@param positions        Where to put the deformed positions
+@param normals          Where to put the deformed normals or an empty view
+@return Count of targets that were applied
+@m_since_latest
+
+Copies @p basePositions to @p positions and @p baseNormals to @p normals and
+then adds offsets of all targets multiplied by their weight. Targets with
+zero weight are skipped, so the cost is proportional to the mesh size plus
+the count of vertices affected by targets that are currently active. The
+resulting normals are not renormalized, which is commonly done in the shader
+anyway.
+
+The weights are a plain array so they can be driven directly by
+@ref Animation::Player tracks:
+
+@snippet MagnumMeshTools.cpp applyMorphTargets
+
+Expects that @p targets and @p weights have the same size, that the output
+views have the same size as the base views, @p baseNormals is either empty or
+has the same size as @p basePositions and all target indices are in bounds.
+If @p normals is empty, normal offsets of the targets are ignored.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t applyMorphTargets(const Containers::StridedArrayView1D<const Vector3>& basePositions, const Containers::StridedArrayView1D<const Vector3>& baseNormals, Containers::ArrayView<const MorphTarget> targets, Containers::ArrayView<const Float> weights, const Containers::StridedArrayView1D<Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals);
+
+}}
+
+#endif
@@ -0,0 +1,316 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PointCloud.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+struct Header {
+    char magic[4];
+    UnsignedInt version;
+    UnsignedInt nodeCount;
+    UnsignedInt padding;
+    UnsignedLong pointCount;
+};
+
+static_assert(sizeof(Header) == 24, "improper size of the header");
+static_assert(sizeof(PointCloudNode) == 48, "improper size of a node");
+static_assert(sizeof(PointCloudPoint) == 16, "improper size of a point");
+
+constexpr char Magic[]{'M', 'P', 'C', 'O'};
+
+/* Bits per axis of the subsampling grid */
+enum: UnsignedInt { GridBits = 7 };
+
+/* Spreads the lower 10 bits of the value so there are two zero bits between
+   each of them */
+UnsignedInt part1By2(UnsignedInt x) {
+    x &= 0x000003ff;
+    x = (x ^ (x << 16)) & 0xff0000ff;
+    x = (x ^ (x <<  8)) & 0x0300f00f;
+    x = (x ^ (x <<  4)) & 0x030c30c3;
+    x = (x ^ (x <<  2)) & 0x09249249;
+    return x;
+}
+
+}
+
+Containers::Optional<PointCloudOctree> PointCloudOctree::open(const Containers::ArrayView<const char> data) {
+    if(reinterpret_cast<std::uintptr_t>(data.data()) % 8) {
+        Error{} << "MeshTools::PointCloudOctree::open(): data not aligned to 8 bytes";
+        return Containers::NullOpt;
+    }
+
+    if(data.size() < sizeof(Header)) {
+        Error{} << "MeshTools::PointCloudOctree::open(): expected at least" << sizeof(Header) << "bytes but got" << data.size();
+        return Containers::NullOpt;
+    }
+
+    const Header& header = *reinterpret_cast<const Header*>(data.data());
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        Error{} << "MeshTools::PointCloudOctree::open(): invalid signature";
+        return Containers::NullOpt;
+    }
+    if(header.version != 1) {
+        Error{} << "MeshTools::PointCloudOctree::open(): unsupported version" << header.version;
+        return Containers::NullOpt;
+    }
+
+    /* Compare the counts first to avoid overflows in the size calculation */
+    const std::size_t available = data.size() - sizeof(Header);
+    if(header.nodeCount > available/sizeof(PointCloudNode) || header.pointCount > (available - header.nodeCount*sizeof(PointCloudNode))/sizeof(PointCloudPoint)) {
+        Error{} << "MeshTools::PointCloudOctree::open(): expected" << header.nodeCount << "nodes and" << header.pointCount << "points but got only" << data.size() << "bytes";
+        return Containers::NullOpt;
+    }
+
+    const Containers::ArrayView<const PointCloudNode> nodes{reinterpret_cast<const PointCloudNode*>(data.data() + sizeof(Header)), header.nodeCount};
+    const Containers::ArrayView<const PointCloudPoint> points{reinterpret_cast<const PointCloudPoint*>(nodes.end()), std::size_t(header.pointCount)};
+    for(std::size_t i = 0; i != nodes.size(); ++i) {
+        const PointCloudNode& node = nodes[i];
+        if(node.pointOffset > points.size() || node.pointCount > points.size() - node.pointOffset) {
+            Error{} << "MeshTools::PointCloudOctree::open(): points" << node.pointOffset << Debug::nospace << ":" << Debug::nospace << node.pointOffset + node.pointCount << "of node" << i << "out of bounds for" << points.size() << "points";
+            return Containers::NullOpt;
+        }
+        /* Children after the parent, so the traversal can't end up in a
+           cycle */
+        if(node.childCount && (node.childCount > 8 || node.firstChild <= i || node.firstChild > nodes.size() || node.childCount > nodes.size() - node.firstChild)) {
+            Error{} << "MeshTools::PointCloudOctree::open(): children" << node.firstChild << Debug::nospace << ":" << Debug::nospace << node.firstChild + node.childCount << "of node" << i << "out of range for" << nodes.size() << "nodes";
+            return Containers::NullOpt;
+        }
+    }
+
+    return PointCloudOctree{nodes, points};
+}
+
+Range3D PointCloudOctree::bounds() const {
+    return _nodes.empty() ? Range3D{} : _nodes[0].bounds;
+}
+
+Containers::ArrayView<const PointCloudPoint> PointCloudOctree::points(const UnsignedInt node) const {
+    CORRADE_ASSERT(node < _nodes.size(),
+        "MeshTools::PointCloudOctree::points(): index" << node << "out of range for" << _nodes.size() << "nodes", {});
+    return _points.slice(_nodes[node].pointOffset, _nodes[node].pointOffset + _nodes[node].pointCount);
+}
+
+Containers::Array<char> buildPointCloudOctree(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Color4ub>& colors, const UnsignedInt nodePointCount, const UnsignedInt maxDepth) {
+    CORRADE_ASSERT(positions.size() == colors.size(),
+        "MeshTools::buildPointCloudOctree(): expected the same number of positions and colors but got" << positions.size() << "and" << colors.size(), {});
+    CORRADE_ASSERT(positions.size() <= 0xffffffffu,
+        "MeshTools::buildPointCloudOctree(): expected less than 2^32 points but got" << positions.size(), {});
+    CORRADE_ASSERT(nodePointCount,
+        "MeshTools::buildPointCloudOctree(): expected a non-zero node point count", {});
+
+    /* Root bounds, a cube around all non-NaN points */
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(const Vector3& position: positions) {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+
+    /* Points of each pending node occupy a contiguous range of this array */
+    Containers::Array<UnsignedInt> order{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = UnsignedInt(i);
+
+    struct Pending {
+        UnsignedInt begin, end, depth;
+    };
+    std::vector<PointCloudNode> nodes;
+    std::deque<Pending> pending;
+
+    /* Every point ends up in exactly one node, so instead of collecting the
+       points only their IDs are recorded in the output order. The points are
+       then gathered directly into the output once the node count is known. */
+    Containers::Array<UnsignedInt> pointOrder{Containers::NoInit, positions.size()};
+    std::size_t pointCount = 0;
+    if(!positions.empty()) {
+        const Float size = Math::max((max - min).max(), 0.0f);
+        nodes.push_back({{min, min + Vector3{size}}, 0.0f, 0, 0, 0, 0});
+        pending.push_back({0, UnsignedInt(order.size()), 0});
+    }
+
+    /* The nodes are processed in the same order as they're created, so the
+       node ID is always the same as the count of processed nodes */
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> codes;
+    std::vector<UnsignedInt> octants;
+    for(std::size_t id = 0; !pending.empty(); ++id) {
+        const Pending current = pending.front();
+        pending.pop_front();
+        const Range3D bounds = nodes[id].bounds;
+        const UnsignedInt count = current.end - current.begin;
+
+        /* Sort the node points along a Morton curve through the grid. The
+           index is a part of the key so the output is deterministic. */
+        const Vector3 size = bounds.size();
+        const Float scale = size.x() > 0.0f ? Float(1 << GridBits)/size.x() : 0.0f;
+        codes.clear();
+        for(UnsignedInt i = current.begin; i != current.end; ++i) {
+            const Vector3 scaled = (positions[order[i]] - bounds.min())*scale;
+            UnsignedInt code = 0;
+            for(std::size_t k = 0; k != 3; ++k) {
+                const Float coordinate = scaled[k] == scaled[k] ? Math::clamp(scaled[k], 0.0f, Float((1 << GridBits) - 1)) : 0.0f;
+                code |= part1By2(UnsignedInt(coordinate)) << k;
+            }
+            codes.emplace_back(code, order[i]);
+        }
+        std::sort(codes.begin(), codes.end());
+
+        /* Leaf node, take all points */
+        if(count <= nodePointCount || current.depth == maxDepth) {
+            nodes[id].spacing = size.x()/Float(1 << GridBits);
+            nodes[id].pointCount = count;
+            nodes[id].pointOffset = pointCount;
+            for(const std::pair<UnsignedInt, UnsignedInt>& code: codes)
+                pointOrder[pointCount++] = code.second;
+            continue;
+        }
+
+        /* Find the finest grid level at which the first points of occupied
+           cells fit into the budget. Coarser cells are prefixes of the
+           Morton code, so that's just a matter of dropping low bits. Level
+           zero is a single cell, so it always fits. */
+        UnsignedInt level = GridBits;
+        for(;; --level) {
+            const UnsignedInt shift = 3*(GridBits - level);
+            UnsignedInt occupied = 0;
+            for(std::size_t i = 0; i != codes.size() && occupied <= nodePointCount; ++i)
+                if(!i || codes[i].first >> shift != codes[i - 1].first >> shift)
+                    ++occupied;
+            if(occupied <= nodePointCount) break;
+        }
+
+        /* Take the first point from each cell, put the rest back to the
+           index array. They stay sorted, so points of each octant are next to
+           each other. The octant is the top three bits of the code, X in the
+           lowest. */
+        const UnsignedInt shift = 3*(GridBits - level);
+        nodes[id].spacing = size.x()/Float(1 << level);
+        nodes[id].pointOffset = pointCount;
+        octants.clear();
+        for(std::size_t i = 0; i != codes.size(); ++i) {
+            if(!i || codes[i].first >> shift != codes[i - 1].first >> shift)
+                pointOrder[pointCount++] = codes[i].second;
+            else {
+                order[current.begin + octants.size()] = codes[i].second;
+                octants.push_back(codes[i].first >> 3*(GridBits - 1));
+            }
+        }
+        nodes[id].pointCount = UnsignedInt(pointCount - nodes[id].pointOffset);
+
+        /* Create a child for each non-empty octant */
+        nodes[id].firstChild = UnsignedInt(nodes.size());
+        const Vector3 half = size*0.5f;
+        for(std::size_t begin = 0, end; begin != octants.size(); begin = end) {
+            const UnsignedInt octant = octants[begin];
+            for(end = begin + 1; end != octants.size() && octants[end] == octant; ++end);
+
+            const Vector3 childMin = bounds.min() + half*Vector3{Float(octant & 1), Float((octant >> 1) & 1), Float(octant >> 2)};
+            nodes.push_back({{childMin, childMin + half}, 0.0f, 0, 0, 0, 0});
+            pending.push_back({UnsignedInt(current.begin + begin), UnsignedInt(current.begin + end), current.depth + 1});
+        }
+        nodes[id].childCount = UnsignedInt(nodes.size() - nodes[id].firstChild);
+    }
+
+    CORRADE_INTERNAL_ASSERT(pointCount == positions.size());
+
+    /* Assemble the output. Everything gets written, so no need to zero-init
+       it. */
+    Containers::Array<char> out{Containers::NoInit, sizeof(Header) + nodes.size()*sizeof(PointCloudNode) + pointCount*sizeof(PointCloudPoint)};
+    Header& header = *reinterpret_cast<Header*>(out.data());
+    header = Header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = 1;
+    header.nodeCount = UnsignedInt(nodes.size());
+    header.pointCount = pointCount;
+    PointCloudNode* const outNodes = reinterpret_cast<PointCloudNode*>(out.data() + sizeof(Header));
+    std::copy(nodes.begin(), nodes.end(), outNodes);
+    PointCloudPoint* const outPoints = reinterpret_cast<PointCloudPoint*>(outNodes + nodes.size());
+    for(std::size_t i = 0; i != pointCount; ++i)
+        outPoints[i] = {positions[pointOrder[i]], colors[pointOrder[i]]};
+    return out;
+}
+
+Containers::Array<UnsignedInt> selectPointCloudNodes(const PointCloudOctree& octree, const Matrix4& transformation, const Matrix4& projection, const Float viewportHeight, const std::size_t pointBudget, const Float minPointSpacing) {
+    const Containers::ArrayView<const PointCloudNode> nodes = octree.nodes();
+    const Frustum frustum = Frustum::fromMatrix(projection*transformation);
+    const Vector3 cameraPosition = transformation.inverted().translation();
+
+    /* Size of a unit at unit distance in pixels. For orthographic projection
+       the distance doesn't matter. */
+    const Float pixelsPerUnit = projection[1][1]*viewportHeight*0.5f;
+    const bool perspective = projection[2][3] != 0.0f;
+    auto projectedSpacing = [&](const PointCloudNode& node) -> Float {
+        if(!perspective) return node.spacing*pixelsPerUnit;
+        const Vector3 closest = Math::clamp(cameraPosition, node.bounds.min(), node.bounds.max());
+        const Float distance = (closest - cameraPosition).length();
+        return distance > 0.0f ? node.spacing*pixelsPerUnit/distance : Constants::inf();
+    };
+
+    std::vector<UnsignedInt> selected;
+    std::priority_queue<std::pair<Float, UnsignedInt>> candidates;
+    if(!nodes.empty() && Math::Intersection::rangeFrustum(nodes[0].bounds, frustum))
+        candidates.emplace(projectedSpacing(nodes[0]), 0);
+
+    std::size_t pointCount = 0;
+    while(!candidates.empty()) {
+        const UnsignedInt id = candidates.top().second;
+        candidates.pop();
+        const PointCloudNode& node = nodes[id];
+        if(node.pointCount > pointBudget - pointCount) continue;
+
+        selected.push_back(id);
+        pointCount += node.pointCount;
+
+        /* Refine only nodes that are still too coarse */
+        if(projectedSpacing(node) < minPointSpacing) continue;
+        for(UnsignedInt i = node.firstChild; i != node.firstChild + node.childCount; ++i) {
+            if(Math::Intersection::rangeFrustum(nodes[i].bounds, frustum))
+                candidates.emplace(projectedSpacing(nodes[i]), i);
+        }
+    }
+
+    Containers::Array<UnsignedInt> out{Containers::NoInit, selected.size()};
+    std::copy(selected.begin(), selected.end(), out.begin());
+    return out;
+}
+
+}}
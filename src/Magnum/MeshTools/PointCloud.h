@@ -0,0 +1,219 @@
+#ifndef Magnum_MeshTools_PointCloud_h
+#define Magnum_MeshTools_PointCloud_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::PointCloudPoint, @ref Magnum::MeshTools::PointCloudNode, class @ref Magnum::MeshTools::PointCloudOctree, function @ref Magnum::MeshTools::buildPointCloudOctree(), @ref Magnum::MeshTools::selectPointCloudNodes()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Point of a point cloud octree
+@m_since_latest
+
+Layout of a single point in @ref PointCloudOctree data. Directly usable as a
+vertex of a @ref MeshPrimitive::Points mesh, with the color being a
+normalized four-component unsigned byte attribute.
+*/
+struct PointCloudPoint {
+    Vector3 position;   /**< Position */
+    Color4ub color;     /**< Color */
+};
+
+/**
+@brief Node of a point cloud octree
+@m_since_latest
+
+Layout of a single node in @ref PointCloudOctree data. See
+@ref buildPointCloudOctree() for more information.
+*/
+struct PointCloudNode {
+    /** @brief Node bounds, always a cube */
+    Range3D bounds;
+
+    /**
+     * @brief Point spacing
+     *
+     * Approximate distance between neighboring points in the node. Leaf
+     * nodes contain all remaining points, for them it's the cell size of the
+     * finest subsampling grid.
+     */
+    Float spacing;
+
+    /** @brief Count of points in the node */
+    UnsignedInt pointCount;
+
+    /** @brief Offset of the first node point in the point data */
+    UnsignedLong pointOffset;
+
+    /**
+     * @brief ID of the first child node
+     *
+     * Children of a node are stored next to each other, each child ID is
+     * always larger than the ID of its parent.
+     */
+    UnsignedInt firstChild;
+
+    /** @brief Child node count, at most @cpp 8 @ce */
+    UnsignedInt childCount;
+};
+
+/**
+@brief Point cloud octree
+@m_since_latest
+
+A non-owning view on data produced by @ref buildPointCloudOctree(). The data
+are meant to be written to a file and then memory-mapped at runtime, for
+example using @ref Corrade::Utility::Directory::mapRead(), so only the parts
+that are actually accessed need to be paged into memory.
+
+@snippet MagnumMeshTools.cpp PointCloudOctree
+
+@section MeshTools-PointCloudOctree-format Data format
+
+The data consist of a 24-byte header, followed by a @ref PointCloudNode array
+and a @ref PointCloudPoint array. The header contains the @cb{.txt} MPCO @ce
+magic, a 32-bit version (currently @cpp 1 @ce), a 32-bit node count, four
+bytes of padding and a 64-bit point count. All values are in the machine
+endianness and the data are expected to be aligned to eight bytes.
+*/
+class MAGNUM_MESHTOOLS_EXPORT PointCloudOctree {
+    public:
+        /**
+         * @brief Open point cloud octree data
+         *
+         * Checks the header and that node point ranges and child IDs are in
+         * bounds. On failure prints a message to @ref Error and returns
+         * @ref Containers::NullOpt. The @p data are expected to stay in scope
+         * for the whole lifetime of the returned instance.
+         */
+        static Containers::Optional<PointCloudOctree> open(Containers::ArrayView<const char> data);
+
+        /** @brief Root node bounds */
+        Range3D bounds() const;
+
+        /** @brief Total point count */
+        std::size_t pointCount() const { return _points.size(); }
+
+        /** @brief Node count */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Nodes
+         *
+         * The first node is the root.
+         */
+        Containers::ArrayView<const PointCloudNode> nodes() const { return _nodes; }
+
+        /** @brief All points */
+        Containers::ArrayView<const PointCloudPoint> points() const { return _points; }
+
+        /**
+         * @brief Points of given node
+         *
+         * Expects that @p node is less than @ref nodeCount().
+         */
+        Containers::ArrayView<const PointCloudPoint> points(UnsignedInt node) const;
+
+    private:
+        explicit PointCloudOctree(Containers::ArrayView<const PointCloudNode> nodes, Containers::ArrayView<const PointCloudPoint> points) noexcept: _nodes{nodes}, _points{points} {}
+
+        Containers::ArrayView<const PointCloudNode> _nodes;
+        Containers::ArrayView<const PointCloudPoint> _points;
+};
+
+/**
+@brief Build a point cloud octree
+@param positions        Point positions
+@param colors           Point colors
+@param nodePointCount   Max count of points in a single node
+@param maxDepth         Max octree depth
+@m_since_latest
+
+Partitions the points into an octree where each node contains a subsampled
+representation of the points in its subtree that isn't already present in
+any of its parents. That means every input point is present exactly once and
+rendering a node together with all its parents gives a progressively refined
+representation of its area, with nothing drawn twice.
+
+The points of a node are chosen by sorting them along a Morton curve on a
+@cpp 128 @ce cells wide grid spanning the node and taking the first point in
+each occupied cell. If that's more than @p nodePointCount points, the grid is
+made twice coarser until it fits. Nodes with at most @p nodePointCount
+points or on @p maxDepth are leafs and contain all their points. The nodes
+are stored in a breadth-first order, points of a node are stored together.
+
+Returns data that can be saved to a file and then opened with
+@ref PointCloudOctree::open(), see its documentation for details about the
+format. The builder keeps the output and a 32-bit index for each point in
+memory, the input views can point to memory-mapped files. Expects that
+@p positions and @p colors have the same size, there's less than
+@f$ 2^{32} @f$ points and @p nodePointCount is at least @cpp 1 @ce. Points
+with NaN coordinates are put into the first cell of the grid.
+@see @ref selectPointCloudNodes(), @ref PointCloudStreamer
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> buildPointCloudOctree(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Color4ub>& colors, UnsignedInt nodePointCount = 16384, UnsignedInt maxDepth = 20);
+
+/**
+@brief Select point cloud octree nodes for rendering
+@param octree           Point cloud octree
+@param transformation   Camera transformation, i.e. the inverse of the camera
+    object transformation
+@param projection       Camera projection
+@param viewportHeight   Viewport height in pixels
+@param pointBudget      Max count of points in selected nodes
+@param minPointSpacing  Point spacing in pixels below which nodes aren't
+    refined anymore
+@return IDs of selected nodes, from the most important
+@m_since_latest
+
+Traverses the octree from the root, always refining the visible node that
+has the largest point spacing when projected to the screen, until either the
+@p pointBudget is exhausted or the projected spacing of all candidates is
+below @p minPointSpacing. Nodes outside of the view frustum are skipped,
+nodes that don't fit into the remaining budget are skipped together with
+their children. A node is selected only if its parent is, so the selection
+always forms a connected subtree starting at the root.
+
+Works with both perspective and orthographic @p projection.
+@see @ref PointCloudStreamer::update()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> selectPointCloudNodes(const PointCloudOctree& octree, const Matrix4& transformation, const Matrix4& projection, Float viewportHeight, std::size_t pointBudget, Float minPointSpacing = 1.0f);
+
+}}
+
+#endif
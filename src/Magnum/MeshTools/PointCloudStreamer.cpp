@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PointCloudStreamer.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Shaders/Generic.h"
+
+namespace Magnum { namespace MeshTools {
+
+struct PointCloudStreamer::State {
+    struct Resident {
+        explicit Resident(GL::Mesh&& mesh, UnsignedLong lastSelected): mesh{std::move(mesh)}, lastSelected{lastSelected} {}
+
+        GL::Mesh mesh;
+        /* Value of `frame` when the node was last selected */
+        UnsignedLong lastSelected;
+    };
+
+    explicit State(const PointCloudOctree& octree, std::size_t pointBudget): octree(octree), pointBudget{pointBudget} {}
+
+    /* Evicts the least recently selected node that wasn't selected in the
+       current frame, returns false if there's none */
+    bool evict();
+
+    PointCloudOctree octree;
+    std::size_t pointBudget;
+    std::size_t residentPointCount{};
+    UnsignedLong frame{};
+    std::unordered_map<UnsignedInt, Resident> resident;
+    std::vector<UnsignedInt> selection;
+};
+
+bool PointCloudStreamer::State::evict() {
+    auto found = resident.end();
+    for(auto it = resident.begin(); it != resident.end(); ++it) {
+        if(it->second.lastSelected != frame && (found == resident.end() || it->second.lastSelected < found->second.lastSelected))
+            found = it;
+    }
+    if(found == resident.end()) return false;
+
+    residentPointCount -= octree.nodes()[found->first].pointCount;
+    resident.erase(found);
+    return true;
+}
+
+PointCloudStreamer::PointCloudStreamer(const PointCloudOctree& octree, const std::size_t pointBudget): _state{new State{octree, pointBudget}} {}
+
+PointCloudStreamer::PointCloudStreamer(PointCloudStreamer&&) noexcept = default;
+
+PointCloudStreamer::~PointCloudStreamer() = default;
+
+PointCloudStreamer& PointCloudStreamer::operator=(PointCloudStreamer&&) noexcept = default;
+
+std::size_t PointCloudStreamer::pointBudget() const { return _state->pointBudget; }
+
+std::size_t PointCloudStreamer::residentPointCount() const { return _state->residentPointCount; }
+
+std::size_t PointCloudStreamer::residentNodeCount() const { return _state->resident.size(); }
+
+bool PointCloudStreamer::isResident(const UnsignedInt node) const {
+    CORRADE_ASSERT(node < _state->octree.nodeCount(),
+        "MeshTools::PointCloudStreamer::isResident(): index" << node << "out of range for" << _state->octree.nodeCount() << "nodes", {});
+    return _state->resident.find(node) != _state->resident.end();
+}
+
+std::size_t PointCloudStreamer::update(const Containers::ArrayView<const UnsignedInt> selection, const std::size_t byteBudget) {
+    State& state = *_state;
+    const Containers::ArrayView<const PointCloudNode> nodes = state.octree.nodes();
+
+    /* Mark already resident nodes as used first so they don't get evicted
+       by the uploads below */
+    ++state.frame;
+    state.selection.clear();
+    for(const UnsignedInt id: selection) {
+        CORRADE_ASSERT(id < nodes.size(),
+            "MeshTools::PointCloudStreamer::update(): index" << id << "out of range for" << nodes.size() << "nodes", {});
+        auto found = state.resident.find(id);
+        if(found != state.resident.end()) found->second.lastSelected = state.frame;
+        state.selection.push_back(id);
+    }
+
+    std::size_t uploadedCount = 0;
+    std::size_t uploadedSize = 0;
+    for(const UnsignedInt id: selection) {
+        if(state.resident.find(id) != state.resident.end()) continue;
+
+        const PointCloudNode& node = nodes[id];
+        const std::size_t size = node.pointCount*sizeof(PointCloudPoint);
+        if(uploadedCount && uploadedSize + size > byteBudget) break;
+
+        /* Make room, if not possible, everything resident is more
+           important */
+        bool fits = true;
+        while(fits && state.residentPointCount + node.pointCount > state.pointBudget)
+            fits = state.evict();
+        if(!fits) break;
+
+        GL::Buffer buffer{GL::Buffer::TargetHint::Array};
+        buffer.setData(state.octree.points(id), GL::BufferUsage::StaticDraw);
+
+        GL::Mesh mesh{MeshPrimitive::Points};
+        mesh.setCount(node.pointCount)
+            .addVertexBuffer(std::move(buffer), 0,
+                Shaders::Generic3D::Position{},
+                Shaders::Generic3D::Color4{
+                    Shaders::Generic3D::Color4::Components::Four,
+                    Shaders::Generic3D::Color4::DataType::UnsignedByte,
+                    Shaders::Generic3D::Color4::DataOption::Normalized});
+        state.resident.emplace(id, State::Resident{std::move(mesh), state.frame});
+        state.residentPointCount += node.pointCount;
+
+        ++uploadedCount;
+        uploadedSize += size;
+    }
+
+    return uploadedCount;
+}
+
+std::size_t PointCloudStreamer::draw(GL::AbstractShaderProgram& shader) {
+    std::size_t pointCount = 0;
+    for(const UnsignedInt id: _state->selection) {
+        auto found = _state->resident.find(id);
+        if(found == _state->resident.end()) continue;
+
+        found->second.mesh.draw(shader);
+        pointCount += _state->octree.nodes()[id].pointCount;
+    }
+
+    return pointCount;
+}
+
+}}
@@ -0,0 +1,163 @@
+#ifndef Magnum_MeshTools_PointCloudStreamer_h
+#define Magnum_MeshTools_PointCloudStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::PointCloudStreamer
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/MeshTools/PointCloud.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Point cloud octree streamer
+@m_since_latest
+
+Keeps a subset of @ref PointCloudOctree nodes resident in GPU memory, each as
+a separate @ref MeshPrimitive::Points mesh with a
+@ref Shaders::Generic::Position and a normalized unsigned byte
+@ref Shaders::Generic::Color4 attribute, which makes them drawable for
+example with @ref Shaders::VertexColor3D.
+
+@snippet MagnumMeshTools-gl.cpp PointCloudStreamer
+
+Every frame, pass the output of @ref selectPointCloudNodes() to
+@ref update(). It uploads the selected nodes that aren't resident yet, most
+important first, limited by a per-call byte budget so a sudden camera move
+doesn't stall the frame. To stay within the resident point budget, nodes
+that weren't selected for the longest time are evicted. The @ref draw()
+function then draws the selected nodes that are resident, the rest is
+uploaded over the next frames.
+
+@section MeshTools-PointCloudStreamer-threads Thread safety
+
+The class is not thread-safe and all functions are expected to be called
+from the thread with the GL context current. Reading the node data from a
+memory-mapped file happens during @ref update(), so it may block on disk
+I/O when the pages are not cached yet.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_MESHTOOLS_EXPORT PointCloudStreamer {
+    public:
+        /**
+         * @brief Constructor
+         * @param octree        Point cloud octree
+         * @param pointBudget   Max count of points resident in GPU memory
+         *
+         * The @p octree data are expected to stay in scope for the whole
+         * lifetime of the instance.
+         */
+        explicit PointCloudStreamer(const PointCloudOctree& octree, std::size_t pointBudget);
+
+        /** @brief Copying is not allowed */
+        PointCloudStreamer(const PointCloudStreamer&) = delete;
+
+        /** @brief Move constructor */
+        PointCloudStreamer(PointCloudStreamer&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that the GL context is current.
+         */
+        ~PointCloudStreamer();
+
+        /** @brief Copying is not allowed */
+        PointCloudStreamer& operator=(const PointCloudStreamer&) = delete;
+
+        /** @brief Move assignment */
+        PointCloudStreamer& operator=(PointCloudStreamer&&) noexcept;
+
+        /** @brief Max count of resident points */
+        std::size_t pointBudget() const;
+
+        /** @brief Count of resident points */
+        std::size_t residentPointCount() const;
+
+        /** @brief Count of resident nodes */
+        std::size_t residentNodeCount() const;
+
+        /**
+         * @brief Whether a node is resident
+         *
+         * Expects that @p node is less than @ref PointCloudOctree::nodeCount().
+         */
+        bool isResident(UnsignedInt node) const;
+
+        /**
+         * @brief Update resident nodes
+         * @param selection     Selected nodes, most important first
+         * @param byteBudget    Max byte count of point data to upload
+         * @return Count of uploaded nodes
+         *
+         * Goes through @p selection in order and uploads nodes that aren't
+         * resident yet, stopping before a node that wouldn't fit into
+         * @p byteBudget. At least one node is uploaded if any is missing, so
+         * nodes larger than the budget don't get stuck. If a node doesn't
+         * fit into @ref pointBudget(), nodes that are not in @p selection are
+         * evicted, least recently selected first. If that's not enough, no
+         * more nodes are uploaded. Expects that all IDs in @p selection are
+         * less than @ref PointCloudOctree::nodeCount() and that the GL context
+         * is current.
+         */
+        std::size_t update(Containers::ArrayView<const UnsignedInt> selection, std::size_t byteBudget);
+
+        /**
+         * @brief Draw resident selected nodes
+         * @return Count of drawn points
+         *
+         * Draws all nodes from the selection passed to the last
+         * @ref update() that are resident, using @p shader.
+         */
+        std::size_t draw(GL::AbstractShaderProgram& shader);
+
+        /** @overload */
+        std::size_t draw(GL::AbstractShaderProgram&& shader) {
+            return draw(shader);
+        }
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
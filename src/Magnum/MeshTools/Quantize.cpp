@@ -0,0 +1,65 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace MeshTools {
+
+Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3us>& quantized) {
+    CORRADE_ASSERT(quantized.size() == positions.size(),
+        "MeshTools::quantizePositionsInto(): bad output size, expected" << positions.size() << "but got" << quantized.size(), {});
+
+    if(positions.empty()) return {};
+
+    /* Calculate the bounds, replace zero sizes with 1 so the division below
+       doesn't produce NaNs and the dequantization matrix is invertible */
+    Vector3 min = positions[0], max = positions[0];
+    for(const Vector3& position: positions) {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+    Vector3 size = max - min;
+    for(std::size_t i = 0; i != 3; ++i)
+        if(size[i] == 0.0f) size[i] = 1.0f;
+
+    /* Normalize to the 0-1 range and pack in a batch */
+    Containers::Array<Vector3> normalized{Containers::NoInit, positions.size()};
+    const Vector3 invSize = 1.0f/size;
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        normalized[i] = (positions[i] - min)*invSize;
+    Math::packInto(Containers::arrayCast<2, const Float>(Containers::stridedArrayView(Containers::arrayView(normalized))),
+                   Containers::arrayCast<2, UnsignedShort>(quantized));
+
+    return Matrix4::translation(min)*Matrix4::scaling(size);
+}
+
+}}
@@ -0,0 +1,63 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantizePositionsInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Quantize positions into 16-bit normalized values
+@param[in]  positions   Vertex positions
+@param[out] quantized   Where to put the quantized positions
+@return Dequantization transformation
+@m_since_latest
+
+Calculates bounds of @p positions, maps them to the @f$ [0, 1] @f$ range
+relative to the bounds and packs them to unsigned normalized 16-bit values
+using @ref Math::packInto(). The @p quantized array is expected to have the
+same size as @p positions.
+
+The returned matrix is a translation to the bounds minimum combined with a
+scaling to the bounds size. The data are meant to be uploaded as a
+normalized @ref GL::Attribute::DataType::UnsignedShort attribute and the
+matrix multiplied with the transformation used to draw the mesh, which means
+the vertex shader doesn't need to perform any extra operation. If the bounds
+have zero size in some direction, the scaling is @cpp 1.0f @ce for that
+direction to avoid a degenerate matrix.
+@see @ref MeshTools::CompileFlag::QuantizePositions
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3us>& quantized);
+
+}}
+
+#endif
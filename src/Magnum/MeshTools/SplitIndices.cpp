@@ -0,0 +1,175 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SplitIndices.h"
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Same type selection as in compressIndices() */
+std::size_t indexTypeSize(const UnsignedInt max) {
+    if(max < 256) return 1;
+    if(max < 65536) return 2;
+    return 4;
+}
+
+/* Spreads the lower 10 bits of the value so there are two zero bits between
+   each of them */
+UnsignedInt part1By2(UnsignedInt x) {
+    x &= 0x000003ff;
+    x = (x ^ (x << 16)) & 0xff0000ff;
+    x = (x ^ (x <<  8)) & 0x0300f00f;
+    x = (x ^ (x <<  4)) & 0x030c30c3;
+    x = (x ^ (x <<  2)) & 0x09249249;
+    return x;
+}
+
+}
+
+IndexSplit splitIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::splitIndices(): index count not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3,
+        "MeshTools::splitIndices(): expected max vertex count to be at least 3 but got" << maxVertexCount, {});
+
+    /* Calculate triangle centroids and their bounds, find the max index */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<Vector3> centroids{Containers::NoInit, triangleCount};
+    Vector3 min, max;
+    UnsignedInt maxIndex = 0;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        Vector3 centroid;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt index = indices[i*3 + j];
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::splitIndices(): index" << index << "out of bounds for" << positions.size() << "vertices", {});
+            maxIndex = Math::max(maxIndex, index);
+            centroid += positions[index];
+        }
+        centroids[i] = centroid/3.0f;
+
+        if(!i) min = max = centroids[i];
+        else {
+            min = Math::min(min, centroids[i]);
+            max = Math::max(max, centroids[i]);
+        }
+    }
+
+    /* Sort triangles along a Morton curve through the centroids. Using the
+       same scale for all axes so flat meshes don't get their shorter
+       dimension unnecessarily refined. */
+    const Float maxExtent = (max - min).max();
+    const Float scale = maxExtent > 0.0f ? 1023.0f/maxExtent : 0.0f;
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> order;
+    order.reserve(triangleCount);
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const Vector3 scaled = (centroids[i] - min)*scale;
+        UnsignedInt code = 0;
+        for(std::size_t k = 0; k != 3; ++k) {
+            /* NaN centroids end up at the curve start */
+            const Float coordinate = scaled[k] == scaled[k] ? Math::clamp(scaled[k], 0.0f, 1023.0f) : 0.0f;
+            code |= part1By2(UnsignedInt(coordinate)) << k;
+        }
+        order.emplace_back(code, UnsignedInt(i));
+    }
+    std::sort(order.begin(), order.end());
+
+    /* Greedily fill the chunks. For each original vertex remember the last
+       chunk it was put into and its index there. */
+    IndexSplit out;
+    out.indices = Containers::Array<UnsignedInt>{Containers::NoInit, indices.size()};
+    Containers::Array<UnsignedInt> chunkOf{Containers::DirectInit, positions.size(), ~UnsignedInt{}};
+    Containers::Array<UnsignedInt> localIndex{Containers::NoInit, positions.size()};
+    std::vector<UnsignedInt> vertexMapping;
+    std::vector<IndexSplit::Chunk> chunks;
+    std::size_t indexOffset = 0;
+    for(const std::pair<UnsignedInt, UnsignedInt>& triangle: order) {
+        const UnsignedInt* const triangleIndices[]{
+            &indices[triangle.second*3 + 0],
+            &indices[triangle.second*3 + 1],
+            &indices[triangle.second*3 + 2]};
+
+        /* Count vertices not yet in the current chunk, start a new chunk if
+           they don't fit */
+        const UnsignedInt current = chunks.size() - 1;
+        UnsignedInt newVertexCount = 0;
+        if(!chunks.empty()) for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt index = *triangleIndices[j];
+            if(chunkOf[index] == current) continue;
+            /* Don't count the same vertex twice in degenerate triangles */
+            bool duplicate = false;
+            for(std::size_t k = 0; k != j; ++k)
+                if(*triangleIndices[k] == index) duplicate = true;
+            if(!duplicate) ++newVertexCount;
+        }
+        if(chunks.empty() || chunks.back().vertexCount + newVertexCount > maxVertexCount)
+            chunks.push_back({UnsignedInt(indexOffset), 0, UnsignedInt(vertexMapping.size()), 0});
+
+        IndexSplit::Chunk& chunk = chunks.back();
+        const UnsignedInt chunkId = chunks.size() - 1;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt index = *triangleIndices[j];
+            if(chunkOf[index] != chunkId) {
+                chunkOf[index] = chunkId;
+                localIndex[index] = chunk.vertexCount++;
+                vertexMapping.push_back(index);
+            }
+            out.indices[indexOffset++] = localIndex[index];
+        }
+        chunk.indexCount += 3;
+    }
+
+    /* Copy the growable arrays to the output */
+    out.vertexMapping = Containers::Array<UnsignedInt>{Containers::NoInit, vertexMapping.size()};
+    std::copy(vertexMapping.begin(), vertexMapping.end(), out.vertexMapping.begin());
+    out.chunks = Containers::Array<IndexSplit::Chunk>{Containers::NoInit, chunks.size()};
+    std::copy(chunks.begin(), chunks.end(), out.chunks.begin());
+
+    /* Statistics */
+    {
+        Containers::Array<bool> used{Containers::ValueInit, positions.size()};
+        out.vertexCount = 0;
+        for(const UnsignedInt index: vertexMapping) if(!used[index]) {
+            used[index] = true;
+            ++out.vertexCount;
+        }
+    }
+    out.originalIndexDataSize = indices.size()*indexTypeSize(maxIndex);
+    out.indexDataSize = 0;
+    for(const IndexSplit::Chunk& chunk: chunks)
+        out.indexDataSize += chunk.indexCount*indexTypeSize(chunk.vertexCount - 1);
+
+    return out;
+}
+
+}}
@@ -0,0 +1,158 @@
+#ifndef Magnum_MeshTools_SplitIndices_h
+#define Magnum_MeshTools_SplitIndices_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::IndexSplit, function @ref Magnum::MeshTools::splitIndices()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh split into chunks with a limited vertex count
+@m_since_latest
+
+Returned by @ref splitIndices(), see its documentation for more information.
+*/
+struct IndexSplit {
+    /** @brief Chunk of a split mesh */
+    struct Chunk {
+        /** @brief Offset of chunk indices in @ref IndexSplit::indices */
+        UnsignedInt indexOffset;
+
+        /** @brief Count of chunk indices */
+        UnsignedInt indexCount;
+
+        /**
+         * @brief Offset of chunk vertices in @ref IndexSplit::vertexMapping
+         */
+        UnsignedInt vertexOffset;
+
+        /**
+         * @brief Count of chunk vertices
+         *
+         * All chunk indices are less than this value.
+         */
+        UnsignedInt vertexCount;
+    };
+
+    /**
+     * @brief Chunk-local triangle indices
+     *
+     * Indices of all chunks concatenated together, each chunk indexing its
+     * own vertices from zero.
+     */
+    Containers::Array<UnsignedInt> indices;
+
+    /**
+     * @brief Mapping from chunk vertices to the original ones
+     *
+     * Original vertex indices for vertices of all chunks concatenated
+     * together. Use with @ref duplicate() to create vertex data for the
+     * chunks. Vertices shared by more than one chunk appear here more than
+     * once.
+     */
+    Containers::Array<UnsignedInt> vertexMapping;
+
+    /** @brief Chunks */
+    Containers::Array<Chunk> chunks;
+
+    /**
+     * @brief Count of vertices referenced by the original indices
+     *
+     * Size of @ref vertexMapping minus this value is the count of vertices
+     * that had to be duplicated on chunk boundaries.
+     */
+    UnsignedInt vertexCount;
+
+    /**
+     * @brief Original index data size
+     *
+     * Size in bytes of the original indices with the smallest type
+     * @ref compressIndices() would pick for them.
+     */
+    std::size_t originalIndexDataSize;
+
+    /**
+     * @brief Index data size
+     *
+     * Size in bytes of the chunk indices with the smallest type
+     * @ref compressIndices() would pick for each chunk.
+     */
+    std::size_t indexDataSize;
+
+    /**
+     * @brief Memory saved by the split
+     * @param vertexSize    Size of a single vertex in bytes
+     *
+     * Difference of @ref originalIndexDataSize and @ref indexDataSize minus
+     * size of the duplicated vertices. Negative if the split made the mesh
+     * larger.
+     */
+    Long memorySaved(std::size_t vertexSize) const {
+        return Long(originalIndexDataSize) - Long(indexDataSize) - Long((vertexMapping.size() - vertexCount)*vertexSize);
+    }
+};
+
+/**
+@brief Split a triangle mesh into chunks with a limited vertex count
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxVertexCount   Max vertex count in a single chunk
+@m_since_latest
+
+Meant for meshes that have more than 65536 vertices and thus would need
+32-bit indices, which is wasteful especially on mobile targets. With the
+default @p maxVertexCount all chunk indices fit into
+@ref Magnum::UnsignedShort "UnsignedShort" and @ref compressIndices() picks
+@ref MeshIndexType::UnsignedShort for them.
+
+The triangles are sorted along a Morton curve through their centroids and
+then greedily put into chunks in that order, starting a new chunk when the
+next triangle would make the vertex count exceed @p maxVertexCount. That
+makes the chunks spatially coherent, which keeps the count of vertices
+duplicated on chunk boundaries low and makes the chunks usable for culling
+as well. Triangle order inside the chunks follows the curve, so you may want
+to run @ref tipsify() on each chunk afterwards.
+
+@snippet MagnumMeshTools.cpp splitIndices
+
+Expects that the index count is divisible by 3, @p maxVertexCount is at
+least 3 and all indices are in bounds for @p positions.
+@see @ref IndexSplit::memorySaved(), @ref boundingBoxesInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT IndexSplit splitIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 65536);
+
+}}
+
+#endif
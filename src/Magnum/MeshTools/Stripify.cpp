@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Stripify.h"
+
+#include <cstring>
+#include <limits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> struct Stripifier {
+    explicit Stripifier(const Containers::StridedArrayView1D<const T>& indices, UnsignedInt vertexCount): indices{indices}, offsets{Containers::ValueInit, vertexCount + 1}, triangles{Containers::NoInit, indices.size()}, visited{Containers::ValueInit, indices.size()/3} {
+        /* Vertex-triangle adjacency, the triangles adjacent to vertex i are
+           triangles[offsets[i]] to triangles[offsets[i + 1]] */
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            ++offsets[indices[i] + 1];
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            offsets[i + 1] += offsets[i];
+        Containers::Array<UnsignedInt> cursor{Containers::NoInit, vertexCount};
+        std::memcpy(cursor.data(), offsets.data(), vertexCount*sizeof(UnsignedInt));
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            triangles[cursor[indices[i]]++] = i/3;
+    }
+
+    /* Finds an unvisited triangle containing the directed edge a -> b within
+       the window, returns its third vertex or -1 if there's none */
+    Long neighbor(const T a, const T b, const UnsignedInt windowEnd) {
+        for(UnsignedInt i = offsets[a], end = offsets[a + 1]; i != end; ++i) {
+            const UnsignedInt t = triangles[i];
+            if(visited[t] || t >= windowEnd) continue;
+
+            for(UnsignedInt j = 0; j != 3; ++j) {
+                if(indices[t*3 + j] == a && indices[t*3 + (j + 1)%3] == b) {
+                    visited[t] = true;
+                    return indices[t*3 + (j + 2)%3];
+                }
+            }
+        }
+
+        return -1;
+    }
+
+    /* Whether an unvisited triangle containing the directed edge a -> b
+       exists within the window */
+    bool hasNeighbor(const T a, const T b, const UnsignedInt windowEnd) const {
+        for(UnsignedInt i = offsets[a], end = offsets[a + 1]; i != end; ++i) {
+            const UnsignedInt t = triangles[i];
+            if(visited[t] || t >= windowEnd) continue;
+
+            for(UnsignedInt j = 0; j != 3; ++j)
+                if(indices[t*3 + j] == a && indices[t*3 + (j + 1)%3] == b)
+                    return true;
+        }
+
+        return false;
+    }
+
+    const Containers::StridedArrayView1D<const T>& indices;
+    Containers::Array<UnsignedInt> offsets, triangles;
+    Containers::Array<bool> visited;
+};
+
+}
+
+template<class T> Containers::Array<T> stripify(const Containers::StridedArrayView1D<const T>& indices, const StripJoin join, const std::size_t window) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::stripify(): index count not divisible by 3", {});
+
+    constexpr T RestartIndex = std::numeric_limits<T>::max();
+    UnsignedInt vertexCount = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ASSERT(join != StripJoin::PrimitiveRestart || indices[i] != RestartIndex,
+            "MeshTools::stripify(): index" << indices[i] << "at position" << i << "collides with the primitive restart index", {});
+        vertexCount = Math::max(vertexCount, UnsignedInt(indices[i]) + 1);
+    }
+
+    Stripifier<T> stripifier{indices, vertexCount};
+    const std::size_t triangleCount = indices.size()/3;
+
+    /* Worst case is every triangle being a separate strip, which is four
+       indices per triangle for primitive restart and at most six for
+       degenerate triangles */
+    Containers::Array<T> out{Containers::NoInit, triangleCount*(join == StripJoin::PrimitiveRestart ? 4 : 6)};
+    std::size_t size = 0;
+
+    for(std::size_t first = 0; first != triangleCount; ++first) {
+        if(stripifier.visited[first]) continue;
+        stripifier.visited[first] = true;
+
+        /* Strip can continue only with triangles in a window after the first
+           unvisited one to preserve vertex locality of the input */
+        const UnsignedInt windowEnd = UnsignedInt(triangleCount - first > window ? first + window : triangleCount);
+
+        /* Pick a rotation of the first triangle such that the strip can
+           continue. The second triangle in the strip has flipped winding,
+           so it needs to contain the last edge reversed. */
+        T a = indices[first*3], b = indices[first*3 + 1], c = indices[first*3 + 2];
+        for(UnsignedInt rotation = 0; rotation != 3; ++rotation) {
+            if(stripifier.hasNeighbor(c, b, windowEnd)) break;
+            const T tmp = a;
+            a = b;
+            b = c;
+            c = tmp;
+        }
+
+        /* Join with the previous strip. For degenerate triangles, the new
+           strip has to start at an even position to preserve the winding. */
+        if(size) {
+            if(join == StripJoin::PrimitiveRestart)
+                out[size++] = RestartIndex;
+            else {
+                const T last = out[size - 1];
+                if(size % 2) out[size++] = last;
+                out[size++] = last;
+                out[size++] = a;
+            }
+        }
+
+        const std::size_t start = size;
+        out[size++] = a;
+        out[size++] = b;
+        out[size++] = c;
+
+        /* Extend the strip while there's a neighbor. Triangle on an even
+           position i is (i, i + 1, i + 2), on an odd position
+           (i + 1, i, i + 2). */
+        for(;;) {
+            const T u = out[size - 2], v = out[size - 1];
+            const Long next = (size - start) % 2 ?
+                stripifier.neighbor(v, u, windowEnd) :
+                stripifier.neighbor(u, v, windowEnd);
+            if(next == -1) break;
+            out[size++] = T(next);
+        }
+    }
+
+    /* Copy to an array of exact size */
+    Containers::Array<T> result{Containers::NoInit, size};
+    std::memcpy(result.data(), out.data(), size*sizeof(T));
+    return result;
+}
+
+template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedByte> stripify<UnsignedByte>(const Containers::StridedArrayView1D<const UnsignedByte>&, StripJoin, std::size_t);
+template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedShort> stripify<UnsignedShort>(const Containers::StridedArrayView1D<const UnsignedShort>&, StripJoin, std::size_t);
+template MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> stripify<UnsignedInt>(const Containers::StridedArrayView1D<const UnsignedInt>&, StripJoin, std::size_t);
+
+}}
@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/AsyncCompiler.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct AsyncCompilerGLTest: GL::OpenGLTester {
+    explicit AsyncCompilerGLTest();
+
+    void construct();
+
+    void compile();
+    void compileQuantized();
+    void byteBudget();
+    void timeBudget();
+    void release();
+
+    void notReady();
+    void outOfRange();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt workerCount;
+} WorkerData[]{
+    {"no workers", 0},
+    {"one worker", 1},
+    {"three workers", 3}
+};
+
+AsyncCompilerGLTest::AsyncCompilerGLTest() {
+    addInstancedTests({&AsyncCompilerGLTest::construct,
+
+                       &AsyncCompilerGLTest::compile,
+                       &AsyncCompilerGLTest::compileQuantized,
+                       &AsyncCompilerGLTest::byteBudget,
+                       &AsyncCompilerGLTest::timeBudget,
+                       &AsyncCompilerGLTest::release},
+        Containers::arraySize(WorkerData));
+
+    addTests({&AsyncCompilerGLTest::notReady,
+              &AsyncCompilerGLTest::outOfRange});
+}
+
+/* A quad, 4 vertices and 6 indices. With normals the interleaved vertex data
+   is 96 bytes, the compressed indices 6 bytes. */
+Trade::MeshData3D quad(const bool indexed = true) {
+    return Trade::MeshData3D{MeshPrimitive::Triangles,
+        indexed ? std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3} : std::vector<UnsignedInt>{},
+        {{{-1.0f, -1.0f, 0.0f},
+          { 1.0f, -1.0f, 0.0f},
+          { 1.0f,  1.0f, 0.0f},
+          {-1.0f,  1.0f, 0.0f}}},
+        {{{0.0f, 0.0f, 1.0f},
+          {0.0f, 0.0f, 1.0f},
+          {0.0f, 0.0f, 1.0f},
+          {0.0f, 0.0f, 1.0f}}}, {}, {}};
+}
+
+void AsyncCompilerGLTest::construct() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    CORRADE_COMPARE(compiler.workerCount(), data.workerCount);
+    CORRADE_COMPARE(compiler.pendingCount(), 0);
+
+    /* Nothing to upload */
+    CORRADE_COMPARE(compiler.upload(1024), 0);
+}
+
+void AsyncCompilerGLTest::compile() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    const UnsignedInt a = compiler.add(quad());
+    const UnsignedInt b = compiler.add(quad(false), CompileFlag::GenerateFlatNormals);
+    const UnsignedInt c = compiler.add(quad(), CompileFlag::GenerateFlatNormals);
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(c, 2);
+    CORRADE_COMPARE(compiler.pendingCount(), 3);
+    CORRADE_VERIFY(!compiler.isReady(a));
+
+    compiler.wait();
+    CORRADE_COMPARE(compiler.pendingCount(), 3);
+    CORRADE_VERIFY(!compiler.isReady(a));
+
+    CORRADE_COMPARE(compiler.upload(~std::size_t{}), 3);
+    CORRADE_COMPARE(compiler.pendingCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The meshes should be configured the same as with compile() */
+    const GL::Mesh expectedA = MeshTools::compile(quad());
+    const GL::Mesh expectedB = MeshTools::compile(quad(false), CompileFlag::GenerateFlatNormals);
+    const GL::Mesh expectedC = MeshTools::compile(quad(), CompileFlag::GenerateFlatNormals);
+
+    CORRADE_VERIFY(compiler.isReady(a));
+    CORRADE_VERIFY(compiler.mesh(a).id());
+    CORRADE_COMPARE(compiler.mesh(a).primitive(), expectedA.primitive());
+    CORRADE_COMPARE(compiler.mesh(a).count(), expectedA.count());
+    CORRADE_VERIFY(compiler.mesh(a).isIndexed());
+    CORRADE_COMPARE(compiler.mesh(a).indexType(), expectedA.indexType());
+    CORRADE_COMPARE(compiler.dequantization(a), Matrix4{});
+
+    CORRADE_VERIFY(compiler.isReady(b));
+    CORRADE_COMPARE(compiler.mesh(b).count(), expectedB.count());
+    CORRADE_VERIFY(!compiler.mesh(b).isIndexed());
+
+    /* Flat normals de-index the mesh */
+    CORRADE_VERIFY(compiler.isReady(c));
+    CORRADE_COMPARE(compiler.mesh(c).count(), expectedC.count());
+    CORRADE_COMPARE(compiler.mesh(c).count(), 6);
+    CORRADE_VERIFY(!compiler.mesh(c).isIndexed());
+}
+
+void AsyncCompilerGLTest::compileQuantized() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    const UnsignedInt id = compiler.add(quad(), CompileFlag::QuantizePositions|CompileFlag::QuantizeNormals);
+    compiler.wait();
+    CORRADE_COMPARE(compiler.upload(~std::size_t{}), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Matrix4 dequantization;
+    MeshTools::compile(quad(), CompileFlag::QuantizePositions|CompileFlag::QuantizeNormals, dequantization);
+    CORRADE_VERIFY(compiler.isReady(id));
+    CORRADE_COMPARE(compiler.dequantization(id), dequantization);
+    CORRADE_COMPARE(compiler.mesh(id).count(), 6);
+}
+
+void AsyncCompilerGLTest::byteBudget() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    for(std::size_t i = 0; i != 5; ++i) compiler.add(quad());
+    compiler.wait();
+
+    /* At least one is always uploaded, even if it doesn't fit the budget */
+    CORRADE_COMPARE(compiler.upload(0), 1);
+    CORRADE_COMPARE(compiler.pendingCount(), 4);
+
+    /* Each mesh is 102 bytes, so two fit */
+    CORRADE_COMPARE(compiler.upload(250), 2);
+    CORRADE_COMPARE(compiler.pendingCount(), 2);
+
+    CORRADE_COMPARE(compiler.upload(1024), 2);
+    CORRADE_COMPARE(compiler.pendingCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    for(UnsignedInt i = 0; i != 5; ++i)
+        CORRADE_VERIFY(compiler.isReady(i));
+}
+
+void AsyncCompilerGLTest::timeBudget() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    for(std::size_t i = 0; i != 5; ++i) compiler.add(quad());
+    compiler.wait();
+
+    /* A zero time budget uploads exactly one mesh */
+    CORRADE_COMPARE(compiler.upload(~std::size_t{}, std::chrono::nanoseconds{0}), 1);
+    CORRADE_COMPARE(compiler.pendingCount(), 4);
+
+    CORRADE_COMPARE(compiler.upload(~std::size_t{}, std::chrono::seconds{10}), 4);
+    CORRADE_COMPARE(compiler.pendingCount(), 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void AsyncCompilerGLTest::release() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    AsyncCompiler compiler{data.workerCount};
+    const UnsignedInt id = compiler.add(quad());
+    compiler.wait();
+    compiler.upload(~std::size_t{});
+    CORRADE_VERIFY(compiler.isReady(id));
+
+    const GLuint meshId = compiler.mesh(id).id();
+    GL::Mesh mesh = compiler.release(id);
+    CORRADE_COMPARE(mesh.id(), meshId);
+    CORRADE_COMPARE(mesh.count(), 6);
+    CORRADE_VERIFY(!compiler.isReady(id));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void AsyncCompilerGLTest::notReady() {
+    AsyncCompiler compiler{0};
+    const UnsignedInt id = compiler.add(quad());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compiler.mesh(id);
+    compiler.dequantization(id);
+    compiler.release(id);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::AsyncCompiler::mesh(): mesh 0 is not ready\n"
+        "MeshTools::AsyncCompiler::dequantization(): mesh 0 is not ready\n"
+        "MeshTools::AsyncCompiler::release(): mesh 0 is not ready\n");
+}
+
+void AsyncCompilerGLTest::outOfRange() {
+    AsyncCompiler compiler{0};
+    compiler.add(quad());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compiler.isReady(1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::AsyncCompiler::isReady(): index 1 out of range for 1 meshes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::AsyncCompilerGLTest)
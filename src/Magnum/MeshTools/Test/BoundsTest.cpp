@@ -0,0 +1,475 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Bounds.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BoundsTest: TestSuite::Tester {
+    explicit BoundsTest();
+
+    void boundingBox();
+    void boundingBoxEmpty();
+    void boundingBoxParallel();
+
+    void boundingBoxes();
+    void boundingBoxesParallel();
+    void boundingBoxesWrongOffsetCount();
+    void boundingBoxesOffsetOutOfBounds();
+    void boundingBoxesIndexOutOfBounds();
+
+    void boundingSphereRitter();
+    void boundingSphereWelzl();
+    void boundingSphereWelzlDegenerate();
+    void boundingSphereEmpty();
+
+    void boundingSpheres();
+    void boundingSpheresParallel();
+    void boundingSpheresWrongSize();
+
+    void orientedBoundingBox();
+    void orientedBoundingBoxEmpty();
+
+    void benchmarkBoundingBox();
+    void benchmarkBoundingBoxParallel();
+    void benchmarkBoundingSphereRitter();
+    void benchmarkBoundingSphereWelzl();
+    void benchmarkOrientedBoundingBox();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt workerCount;
+} BenchmarkParallelData[]{
+    {"single-threaded", 0},
+    {"1 worker", 1},
+    {"3 workers", 3},
+    {"7 workers", 7}
+};
+
+BoundsTest::BoundsTest() {
+    addTests({&BoundsTest::boundingBox,
+              &BoundsTest::boundingBoxEmpty,
+              &BoundsTest::boundingBoxParallel,
+
+              &BoundsTest::boundingBoxes,
+              &BoundsTest::boundingBoxesParallel,
+              &BoundsTest::boundingBoxesWrongOffsetCount,
+              &BoundsTest::boundingBoxesOffsetOutOfBounds,
+              &BoundsTest::boundingBoxesIndexOutOfBounds,
+
+              &BoundsTest::boundingSphereRitter,
+              &BoundsTest::boundingSphereWelzl,
+              &BoundsTest::boundingSphereWelzlDegenerate,
+              &BoundsTest::boundingSphereEmpty,
+
+              &BoundsTest::boundingSpheres,
+              &BoundsTest::boundingSpheresParallel,
+              &BoundsTest::boundingSpheresWrongSize,
+
+              &BoundsTest::orientedBoundingBox,
+              &BoundsTest::orientedBoundingBoxEmpty});
+
+    addBenchmarks({&BoundsTest::benchmarkBoundingBox,
+                   &BoundsTest::benchmarkBoundingSphereRitter,
+                   &BoundsTest::benchmarkBoundingSphereWelzl,
+                   &BoundsTest::benchmarkOrientedBoundingBox}, 10);
+
+    addInstancedBenchmarks({&BoundsTest::benchmarkBoundingBoxParallel}, 10,
+        Containers::arraySize(BenchmarkParallelData));
+}
+
+using namespace Math::Literals;
+
+/* Corners of a 2x2x2 cube and a point inside */
+constexpr Vector3 Cube[]{
+    {-1.0f, -1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    {-1.0f,  1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f},
+    { 0.0f,  0.5f,  0.0f},
+    {-1.0f, -1.0f,  1.0f},
+    { 1.0f, -1.0f,  1.0f},
+    {-1.0f,  1.0f,  1.0f},
+    { 1.0f,  1.0f,  1.0f}
+};
+
+/* Deterministic, somewhat irregular point cloud */
+Containers::Array<Vector3> cloud(const std::size_t count) {
+    Containers::Array<Vector3> out{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i) out[i] = {
+        3.0f*Math::sin(Rad(Float(i)*0.37f)),
+        2.0f*Math::cos(Rad(Float(i)*1.1f)) + 1.0f,
+        Float(i % 17)*0.1f - 0.5f};
+    return out;
+}
+
+void BoundsTest::boundingBox() {
+    const Range3D box = MeshTools::boundingBox(Cube);
+    CORRADE_COMPARE(box.min(), (Vector3{-1.0f}));
+    CORRADE_COMPARE(box.max(), (Vector3{1.0f}));
+}
+
+void BoundsTest::boundingBoxEmpty() {
+    CORRADE_COMPARE(MeshTools::boundingBox(Containers::StridedArrayView1D<const Vector3>{}), Range3D{});
+}
+
+void BoundsTest::boundingBoxParallel() {
+    /* Large enough to be split into multiple chunks */
+    Containers::Array<Vector3> positions = cloud(100000);
+    positions[54321] = {-10.0f, 17.0f, 0.0f};
+    positions[99999] = {0.0f, 0.0f, 15.5f};
+
+    TaskScheduler scheduler{3};
+    const Range3D box = MeshTools::boundingBox(scheduler, positions);
+    CORRADE_COMPARE(box, MeshTools::boundingBox(positions));
+    CORRADE_COMPARE(box.min().x(), -10.0f);
+    CORRADE_COMPARE(box.max().y(), 17.0f);
+    CORRADE_COMPARE(box.max().z(), 15.5f);
+}
+
+/* First submesh is the cube, second just a single point of it, third is
+   empty, fourth the top half of the cube */
+constexpr UnsignedInt Indices[]{
+    0, 1, 2, 3, 4, 5, 6, 7, 8,
+    4,
+    5, 6, 7, 8, 4
+};
+constexpr UnsignedInt Offsets[]{0, 9, 10, 10, 15};
+
+void BoundsTest::boundingBoxes() {
+    Range3D boxes[4];
+    boundingBoxesInto(Indices, Offsets, Cube, boxes);
+
+    const Range3D expected[]{
+        {Vector3{-1.0f}, Vector3{1.0f}},
+        {{0.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}},
+        {},
+        {{-1.0f, -1.0f, 0.0f}, Vector3{1.0f}}
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(boxes),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void BoundsTest::boundingBoxesParallel() {
+    /* Many submeshes so they get split among the workers */
+    const Containers::Array<Vector3> positions = cloud(10000);
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 20000};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = UnsignedInt((i*7919) % positions.size());
+    Containers::Array<UnsignedInt> offsets{Containers::NoInit, 1001};
+    for(std::size_t i = 0; i != offsets.size(); ++i)
+        offsets[i] = UnsignedInt(i*20);
+
+    Containers::Array<Range3D> expected{1000};
+    boundingBoxesInto(indices, offsets, positions, expected);
+
+    TaskScheduler scheduler{3};
+    Containers::Array<Range3D> boxes{1000};
+    boundingBoxesInto(scheduler, indices, offsets, positions, boxes);
+    CORRADE_COMPARE_AS(boxes, expected, TestSuite::Compare::Container);
+}
+
+void BoundsTest::boundingBoxesWrongOffsetCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Range3D boxes[4];
+    boundingBoxesInto(Indices, Containers::arrayView(Offsets).prefix(4), Cube, boxes);
+    CORRADE_COMPARE(out.str(), "MeshTools::boundingBoxesInto(): expected 5 offsets but got 4\n");
+}
+
+void BoundsTest::boundingBoxesOffsetOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt offsets[]{0, 9, 8, 15};
+    const UnsignedInt offsets2[]{0, 9, 16};
+    Range3D boxes[3];
+    boundingBoxesInto(Indices, offsets, Cube, boxes);
+    boundingBoxesInto(Indices, offsets2, Cube, Containers::arrayView(boxes).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::boundingBoxesInto(): submesh 1 offsets 9 and 8 out of order or out of bounds for 15 indices\n"
+        "MeshTools::boundingBoxesInto(): submesh 1 offsets 9 and 16 out of order or out of bounds for 15 indices\n");
+}
+
+void BoundsTest::boundingBoxesIndexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 9};
+    const UnsignedInt offsets[]{0, 2};
+    Range3D boxes[1];
+    boundingBoxesInto(indices, offsets, Cube, boxes);
+    CORRADE_COMPARE(out.str(), "MeshTools::boundingBoxesInto(): index 9 out of bounds for 9 elements\n");
+}
+
+void BoundsTest::boundingSphereRitter() {
+    const std::pair<Vector3, Float> sphere = MeshTools::boundingSphereRitter(Cube);
+    CORRADE_COMPARE(sphere.first, Vector3{});
+    CORRADE_COMPARE(sphere.second, Constants::sqrt3());
+
+    /* On a generic point cloud it's not minimal, but has to contain all
+       points */
+    const Containers::Array<Vector3> positions = cloud(1000);
+    const std::pair<Vector3, Float> cloudSphere = MeshTools::boundingSphereRitter(positions);
+    for(const Vector3& position: positions) {
+        CORRADE_COMPARE_AS((position - cloudSphere.first).length(), cloudSphere.second*1.00001f, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void BoundsTest::boundingSphereWelzl() {
+    const std::pair<Vector3, Float> sphere = MeshTools::boundingSphereWelzl(Cube);
+    CORRADE_COMPARE(sphere.first, Vector3{});
+    CORRADE_COMPARE(sphere.second, Constants::sqrt3());
+
+    /* Regular tetrahedron with points inside, Ritter's algorithm gives a
+       ~20% larger sphere here */
+    const Vector3 tetrahedron[]{
+        {0.5f, 0.2f, 0.1f},
+        {1.0f, 1.0f, 1.0f},
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, -1.0f, -1.0f},
+        {-1.0f, 1.0f, -1.0f},
+        {-0.3f, 0.0f, 0.25f},
+        {-1.0f, -1.0f, 1.0f}
+    };
+    const std::pair<Vector3, Float> tetrahedronSphere = MeshTools::boundingSphereWelzl(tetrahedron);
+    CORRADE_COMPARE(tetrahedronSphere.first, Vector3{});
+    CORRADE_COMPARE(tetrahedronSphere.second, Constants::sqrt3());
+    CORRADE_COMPARE_AS(MeshTools::boundingSphereRitter(tetrahedron).second, 2.0f, TestSuite::Compare::Greater);
+
+    /* All points strictly inside and never larger than the approximation */
+    const Containers::Array<Vector3> positions = cloud(1000);
+    const std::pair<Vector3, Float> cloudSphere = MeshTools::boundingSphereWelzl(positions);
+    for(const Vector3& position: positions) {
+        CORRADE_VERIFY(Vector3d{position - cloudSphere.first}.length() <= Double(cloudSphere.second));
+    }
+    CORRADE_COMPARE_AS(cloudSphere.second, MeshTools::boundingSphereRitter(positions).second, TestSuite::Compare::LessOrEqual);
+}
+
+void BoundsTest::boundingSphereWelzlDegenerate() {
+    /* Single point */
+    const Vector3 point[]{{1.0f, 2.0f, 3.0f}};
+    const std::pair<Vector3, Float> pointSphere = MeshTools::boundingSphereWelzl(point);
+    CORRADE_COMPARE(pointSphere.first, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(pointSphere.second, 0.0f);
+
+    /* Collinear points */
+    Vector3 line[10];
+    for(std::size_t i = 0; i != 10; ++i)
+        line[i] = {Float(i), 2.0f*Float(i), 0.0f};
+    const std::pair<Vector3, Float> lineSphere = MeshTools::boundingSphereWelzl(line);
+    CORRADE_COMPARE(lineSphere.first, (Vector3{4.5f, 9.0f, 0.0f}));
+    CORRADE_COMPARE(lineSphere.second, Math::sqrt(101.25f));
+
+    /* Coplanar points on a circle */
+    Vector3 circle[20];
+    for(std::size_t i = 0; i != 20; ++i)
+        circle[i] = {Math::cos(Rad(Float(i)*0.7f)), Math::sin(Rad(Float(i)*0.7f)), 2.0f};
+    const std::pair<Vector3, Float> circleSphere = MeshTools::boundingSphereWelzl(circle);
+    CORRADE_COMPARE(circleSphere.first, (Vector3{0.0f, 0.0f, 2.0f}));
+    CORRADE_COMPARE(circleSphere.second, 1.0f);
+}
+
+void BoundsTest::boundingSphereEmpty() {
+    const std::pair<Vector3, Float> ritter = MeshTools::boundingSphereRitter(Containers::StridedArrayView1D<const Vector3>{});
+    CORRADE_COMPARE(ritter.first, Vector3{});
+    CORRADE_COMPARE(ritter.second, 0.0f);
+
+    const std::pair<Vector3, Float> welzl = MeshTools::boundingSphereWelzl(Containers::StridedArrayView1D<const Vector3>{});
+    CORRADE_COMPARE(welzl.first, Vector3{});
+    CORRADE_COMPARE(welzl.second, 0.0f);
+}
+
+void BoundsTest::boundingSpheres() {
+    Vector3 centers[4];
+    Float radii[4];
+    boundingSpheresInto(Indices, Offsets, Cube, centers, radii);
+
+    const Vector3 expectedCenters[]{
+        {}, {0.0f, 0.5f, 0.0f}, {}, {0.0f, 0.0f, 1.0f}
+    };
+    const Float expectedRadii[]{
+        Constants::sqrt3(), 0.0f, 0.0f, Constants::sqrt2()
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(centers),
+        Containers::arrayView(expectedCenters),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(radii),
+        Containers::arrayView(expectedRadii),
+        TestSuite::Compare::Container);
+}
+
+void BoundsTest::boundingSpheresParallel() {
+    const Containers::Array<Vector3> positions = cloud(10000);
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 20000};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = UnsignedInt((i*7919) % positions.size());
+    Containers::Array<UnsignedInt> offsets{Containers::NoInit, 1001};
+    for(std::size_t i = 0; i != offsets.size(); ++i)
+        offsets[i] = UnsignedInt(i*20);
+
+    Containers::Array<Vector3> expectedCenters{1000};
+    Containers::Array<Float> expectedRadii{1000};
+    boundingSpheresInto(indices, offsets, positions, expectedCenters, expectedRadii);
+
+    TaskScheduler scheduler{3};
+    Containers::Array<Vector3> centers{1000};
+    Containers::Array<Float> radii{1000};
+    boundingSpheresInto(scheduler, indices, offsets, positions, centers, radii);
+    CORRADE_COMPARE_AS(centers, expectedCenters, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(radii, expectedRadii, TestSuite::Compare::Container);
+}
+
+void BoundsTest::boundingSpheresWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Vector3 centers[4];
+    Float radii[4];
+    boundingSpheresInto(Indices, Offsets, Cube, centers, Containers::arrayView(radii).prefix(3));
+    boundingSpheresInto(Indices, Containers::arrayView(Offsets).prefix(4), Cube, centers, radii);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::boundingSpheresInto(): expected 4 radii but got 3\n"
+        "MeshTools::boundingSpheresInto(): expected 5 offsets but got 4\n");
+}
+
+void BoundsTest::orientedBoundingBox() {
+    /* Corners of a 8x4x2 box together with some points inside, rotated and
+       translated */
+    const Matrix4 transformation =
+        Matrix4::translation({3.0f, -1.0f, 0.5f})*
+        Matrix4::rotation(35.0_degf, Vector3{1.0f, 2.0f, 0.5f}.normalized());
+    Vector3 positions[12];
+    std::size_t i = 0;
+    for(Float x: {-4.0f, 4.0f})
+        for(Float y: {-2.0f, 2.0f})
+            for(Float z: {-1.0f, 1.0f})
+                positions[i++] = transformation.transformPoint({x, y, z});
+    positions[i++] = transformation.transformPoint({1.0f, 0.5f, 0.0f});
+    positions[i++] = transformation.transformPoint({-1.0f, 0.5f, 0.0f});
+    positions[i++] = transformation.transformPoint({1.0f, -0.5f, 0.0f});
+    positions[i++] = transformation.transformPoint({-1.0f, -0.5f, 0.0f});
+
+    const Matrix4 box = MeshTools::orientedBoundingBox(positions);
+
+    /* Box axes are sorted by the extent, the signs are arbitrary */
+    CORRADE_COMPARE(box.translation(), (Vector3{3.0f, -1.0f, 0.5f}));
+    CORRADE_COMPARE(box[0].xyz().length(), 4.0f);
+    CORRADE_COMPARE(box[1].xyz().length(), 2.0f);
+    CORRADE_COMPARE(box[2].xyz().length(), 1.0f);
+    CORRADE_COMPARE(Math::abs(Math::dot(box[0].xyz().normalized(), transformation[0].xyz())), 1.0f);
+    CORRADE_COMPARE(Math::abs(Math::dot(box[1].xyz().normalized(), transformation[1].xyz())), 1.0f);
+    CORRADE_COMPARE(Math::abs(Math::dot(box[2].xyz().normalized(), transformation[2].xyz())), 1.0f);
+
+    /* Right-handed */
+    CORRADE_COMPARE_AS(box.rotationScaling().determinant(), 0.0f, TestSuite::Compare::Greater);
+
+    /* All points are inside the [-1, 1] cube after inverse transformation */
+    const Matrix4 inverted = box.inverted();
+    for(const Vector3& position: positions) {
+        CORRADE_COMPARE_AS(Math::abs(inverted.transformPoint(position)).max(), 1.00001f, TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void BoundsTest::orientedBoundingBoxEmpty() {
+    CORRADE_COMPARE(MeshTools::orientedBoundingBox(Containers::StridedArrayView1D<const Vector3>{}), Matrix4{Math::ZeroInit});
+}
+
+void BoundsTest::benchmarkBoundingBox() {
+    const Containers::Array<Vector3> positions = cloud(100000);
+
+    Range3D box;
+    CORRADE_BENCHMARK(5) {
+        box = MeshTools::boundingBox(positions);
+    }
+
+    CORRADE_COMPARE_AS(box.max().x(), 2.9f, TestSuite::Compare::Greater);
+}
+
+void BoundsTest::benchmarkBoundingBoxParallel() {
+    auto&& data = BenchmarkParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<Vector3> positions = cloud(1000000);
+
+    TaskScheduler scheduler{data.workerCount};
+    Range3D box;
+    CORRADE_BENCHMARK(5) {
+        box = MeshTools::boundingBox(scheduler, positions);
+    }
+
+    CORRADE_COMPARE_AS(box.max().x(), 2.9f, TestSuite::Compare::Greater);
+}
+
+void BoundsTest::benchmarkBoundingSphereRitter() {
+    const Containers::Array<Vector3> positions = cloud(100000);
+
+    Float radius = 0.0f;
+    CORRADE_BENCHMARK(5) {
+        radius += MeshTools::boundingSphereRitter(positions).second;
+    }
+
+    CORRADE_VERIFY(radius > 0.0f);
+}
+
+void BoundsTest::benchmarkBoundingSphereWelzl() {
+    const Containers::Array<Vector3> positions = cloud(100000);
+
+    Float radius = 0.0f;
+    CORRADE_BENCHMARK(5) {
+        radius += MeshTools::boundingSphereWelzl(positions).second;
+    }
+
+    CORRADE_VERIFY(radius > 0.0f);
+}
+
+void BoundsTest::benchmarkOrientedBoundingBox() {
+    const Containers::Array<Vector3> positions = cloud(100000);
+
+    Matrix4 box;
+    CORRADE_BENCHMARK(5) {
+        box = MeshTools::orientedBoundingBox(positions);
+    }
+
+    CORRADE_VERIFY(box.rotationScaling().determinant() > 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundsTest)
@@ -60,7 +60,8 @@ enum class Flag {
     GeneratedFlatNormals = 1 << 2,
     GeneratedSmoothNormals = 1 << 3,
     TextureCoordinates2D = 1 << 4,
-    Colors = 1 << 5
+    Colors = 1 << 5,
+    Quantized = 1 << 6
 };
 
 typedef Containers::EnumSet<Flag> Flags;
@@ -136,6 +137,9 @@ constexpr struct {
     {"positions, gen smooth normals + texcoords", Flag::GeneratedSmoothNormals|Flag::TextureCoordinates2D},
     {"positions, gen smooth normals + texcoords + colors", Flag::GeneratedSmoothNormals|Flag::TextureCoordinates2D|Flag::Colors},
     {"positions, nonindexed + gen smooth normals", Flag::NonIndexed|Flag::GeneratedSmoothNormals},
+    {"positions + normals + texcoords, quantized", Flag::Normals|Flag::TextureCoordinates2D|Flag::Quantized},
+    {"positions + normals + colors, nonindexed, quantized", Flag::NonIndexed|Flag::Normals|Flag::Colors|Flag::Quantized},
+    {"positions, gen smooth normals, quantized", Flag::GeneratedSmoothNormals|Flag::Quantized},
 };
 
 using namespace Math::Literals;
@@ -416,7 +420,16 @@ void CompileGLTest::threeDimensions() {
         flags |= CompileFlag::GenerateFlatNormals;
     else if(data.flags & Flag::GeneratedSmoothNormals)
         flags |= CompileFlag::GenerateSmoothNormals;
-    GL::Mesh mesh = compile(Trade::MeshData3D{MeshPrimitive::Triangles, indices, {positions}, normals, textureCoordinates2D, colors}, flags);
+    Trade::MeshData3D meshData{MeshPrimitive::Triangles, indices, {positions}, normals, textureCoordinates2D, colors};
+    Matrix4 dequantization;
+    GL::Mesh mesh{NoCreate};
+    if(data.flags & Flag::Quantized) {
+        flags |= CompileFlag::QuantizePositions|CompileFlag::QuantizeNormals;
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        flags |= CompileFlag::QuantizeTextureCoordinates;
+        #endif
+        mesh = compile(meshData, flags, dequantization);
+    } else mesh = compile(meshData, flags);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -427,11 +440,15 @@ void CompileGLTest::threeDimensions() {
     Matrix4 projection = Matrix4::perspectiveProjection(45.0_degf, 1.0f, 0.1f, 10.0f);
     Matrix4 transformation = Matrix4::translation(Vector3::zAxis(-2.0f));
 
+    /* Quantized positions need the dequantization folded into the
+       transformation, normals are not affected by it */
+    Matrix4 meshTransformation = transformation*dequantization;
+
     /* Check with the flat shader, it should always work */
     {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _flat3D
-            .setTransformationProjectionMatrix(projection*transformation)
+            .setTransformationProjectionMatrix(projection*meshTransformation)
             .setColor(0x6633ff_rgbf);
         mesh.draw(_flat3D);
 
@@ -447,7 +464,7 @@ void CompileGLTest::threeDimensions() {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _phong
             .setDiffuseColor(0x33ff66_rgbf)
-            .setTransformationMatrix(transformation)
+            .setTransformationMatrix(meshTransformation)
             .setNormalMatrix(transformation.normalMatrix())
             .setProjectionMatrix(projection);
         mesh.draw(_phong);
@@ -467,7 +484,7 @@ void CompileGLTest::threeDimensions() {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _phong
             .setDiffuseColor(0x33ff66_rgbf)
-            .setTransformationMatrix(transformation)
+            .setTransformationMatrix(meshTransformation)
             .setNormalMatrix(transformation.normalMatrix())
             .setProjectionMatrix(projection);
         mesh.draw(_phong);
@@ -482,7 +499,7 @@ void CompileGLTest::threeDimensions() {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _phong
             .setDiffuseColor(0x33ff66_rgbf)
-            .setTransformationMatrix(transformation)
+            .setTransformationMatrix(meshTransformation)
             .setNormalMatrix(transformation.normalMatrix())
             .setProjectionMatrix(projection);
         mesh.draw(_phong);
@@ -499,7 +516,7 @@ void CompileGLTest::threeDimensions() {
     if(data.flags & Flag::Colors) {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _color3D
-            .setTransformationProjectionMatrix(projection*transformation);
+            .setTransformationProjectionMatrix(projection*meshTransformation);
         mesh.draw(_color3D);
 
         MAGNUM_VERIFY_NO_GL_ERROR();
@@ -514,7 +531,7 @@ void CompileGLTest::threeDimensions() {
     if(data.flags & Flag::TextureCoordinates2D) {
         _framebuffer.clear(GL::FramebufferClear::Color);
         _flatTextured3D
-            .setTransformationProjectionMatrix(projection*transformation)
+            .setTransformationProjectionMatrix(projection*meshTransformation)
             .bindTexture(_texture);
         mesh.draw(_flatTextured3D);
 
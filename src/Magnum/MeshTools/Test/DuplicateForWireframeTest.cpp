@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/DuplicateForWireframe.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct DuplicateForWireframeTest: TestSuite::Tester {
+    explicit DuplicateForWireframeTest();
+
+    void quad();
+    void noDuplicates();
+    void empty();
+    void icosphere();
+    void wrongIndexCount();
+};
+
+DuplicateForWireframeTest::DuplicateForWireframeTest() {
+    addTests({&DuplicateForWireframeTest::quad,
+              &DuplicateForWireframeTest::noDuplicates,
+              &DuplicateForWireframeTest::empty,
+              &DuplicateForWireframeTest::icosphere,
+              &DuplicateForWireframeTest::wrongIndexCount});
+}
+
+/*
+    0---3
+    |\  |
+    | \ |
+    |  \|
+    1---2
+*/
+void DuplicateForWireframeTest::quad() {
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 2, 3
+    };
+
+    /* Vertex 3 gets the same corner ID as 1, so it's put at 3*1 + 1; slots
+       3 and 5 are padding */
+    Containers::Array<UnsignedInt> outIndices, mapping;
+    std::tie(outIndices, mapping) = duplicateForWireframe(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE_AS(Containers::arrayView<const UnsignedInt>(outIndices),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {
+            0, 1, 2,
+            0, 2, 4
+        }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView<const UnsignedInt>(mapping),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {
+            0, 1, 2, 0, 3, 0
+        }}), TestSuite::Compare::Container);
+}
+
+/*
+    0---2---4
+    |\  |\  |
+    | \ | \ |
+    |  \|  \|
+    1---3---5
+*/
+void DuplicateForWireframeTest::noDuplicates() {
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        2, 1, 3,
+        2, 3, 4,
+        4, 3, 5
+    };
+
+    /* The vertices can be colored with three colors, so the input is
+       already in the desired form */
+    Containers::Array<UnsignedInt> outIndices, mapping;
+    std::tie(outIndices, mapping) = duplicateForWireframe(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE_AS(Containers::arrayView<const UnsignedInt>(outIndices),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView<const UnsignedInt>(mapping),
+        (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {
+            0, 1, 2, 3, 4, 5
+        }}), TestSuite::Compare::Container);
+}
+
+void DuplicateForWireframeTest::empty() {
+    Containers::Array<UnsignedInt> outIndices, mapping;
+    std::tie(outIndices, mapping) = duplicateForWireframe(Containers::StridedArrayView1D<const UnsignedInt>{});
+    CORRADE_COMPARE(outIndices.size(), 0);
+    CORRADE_COMPARE(mapping.size(), 0);
+}
+
+void DuplicateForWireframeTest::icosphere() {
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(2);
+    const std::vector<UnsignedInt>& indices = icosphere.indices();
+    const std::size_t vertexCount = icosphere.positions(0).size();
+
+    Containers::Array<UnsignedInt> outIndices, mapping;
+    std::tie(outIndices, mapping) = duplicateForWireframe(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(outIndices.size(), indices.size());
+    CORRADE_COMPARE(mapping.size() % 3, 0);
+
+    /* Significantly less than what duplicate() would need */
+    CORRADE_COMPARE_AS(mapping.size(), 2*vertexCount,
+        TestSuite::Compare::Less);
+
+    /* Every triangle has distinct corner IDs and references the original
+       vertices */
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        CORRADE_VERIFY(outIndices[i] % 3 != outIndices[i + 1] % 3);
+        CORRADE_VERIFY(outIndices[i + 1] % 3 != outIndices[i + 2] % 3);
+        CORRADE_VERIFY(outIndices[i + 2] % 3 != outIndices[i] % 3);
+        for(std::size_t j = 0; j != 3; ++j)
+            CORRADE_COMPARE(mapping[outIndices[i + j]], indices[i + j]);
+    }
+}
+
+void DuplicateForWireframeTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[4]{};
+    duplicateForWireframe(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::duplicateForWireframe(): index count not divisible by 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::DuplicateForWireframeTest)
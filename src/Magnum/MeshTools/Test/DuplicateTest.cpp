@@ -29,6 +29,7 @@
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/TaskScheduler.h"
 #include "Magnum/MeshTools/Duplicate.h"
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
@@ -42,6 +43,8 @@ struct DuplicateTest: TestSuite::Tester {
 
     void duplicateInto();
     void duplicateIntoWrongSize();
+    void duplicateIntoParallel();
+    void duplicateIntoParallelWrongSize();
 };
 
 DuplicateTest::DuplicateTest() {
@@ -50,7 +53,9 @@ DuplicateTest::DuplicateTest() {
               &DuplicateTest::duplicateStl,
 
               &DuplicateTest::duplicateInto,
-              &DuplicateTest::duplicateIntoWrongSize});
+              &DuplicateTest::duplicateIntoWrongSize,
+              &DuplicateTest::duplicateIntoParallel,
+              &DuplicateTest::duplicateIntoParallelWrongSize});
 }
 
 void DuplicateTest::duplicate() {
@@ -105,6 +110,38 @@ void DuplicateTest::duplicateIntoWrongSize() {
         "MeshTools::duplicateInto(): bad output size, expected 6 but got 5\n");
 }
 
+void DuplicateTest::duplicateIntoParallel() {
+    /* Large enough to be split into several chunks */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 100000};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = (i*7) % 1000;
+    Containers::Array<Int> data{Containers::NoInit, 1000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Int(i)*3 - 500;
+
+    Containers::Array<Int> expected{Containers::NoInit, indices.size()};
+    MeshTools::duplicateInto<UnsignedInt, Int>(indices, data, expected);
+
+    TaskScheduler scheduler{3};
+    Containers::Array<Int> output{Containers::NoInit, indices.size()};
+    MeshTools::duplicateInto<UnsignedInt, Int>(scheduler, indices, data, output);
+    CORRADE_COMPARE_AS(output, expected, TestSuite::Compare::Container);
+}
+
+void DuplicateTest::duplicateIntoParallelWrongSize() {
+    constexpr UnsignedByte indices[]{1, 1, 0, 3, 2, 2};
+    constexpr Int data[]{-7, 35, 12, -18};
+    Int output[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TaskScheduler scheduler{0};
+    MeshTools::duplicateInto<UnsignedByte, Int>(scheduler, indices, data, output);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::duplicateInto(): bad output size, expected 6 but got 5\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::DuplicateTest)
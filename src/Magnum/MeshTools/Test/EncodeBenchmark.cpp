@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Cylinder.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct EncodeBenchmark: TestSuite::Tester {
+    explicit EncodeBenchmark();
+
+    void encodeIndices();
+    void encodeVertices();
+    void decodeIndices();
+    void decodeVertices();
+
+    void indexRatio();
+    void vertexRatio();
+
+    void ratioBegin();
+    std::uint64_t ratioEnd();
+
+    std::uint64_t _ratio;
+};
+
+const struct {
+    const char* name;
+    Trade::MeshData3D(*mesh)();
+} Data[]{
+    {"icosphere", []() { return Primitives::icosphereSolid(6); }},
+    {"UV sphere", []() { return Primitives::uvSphereSolid(256, 512); }},
+    {"grid", []() { return Primitives::grid3DSolid({511, 511}); }},
+    {"cylinder", []() { return Primitives::cylinderSolid(64, 1024, 1.0f, Primitives::CylinderFlag::CapEnds); }},
+    {"large synthetic terrain", []() -> Trade::MeshData3D {
+        /* A million vertices with a non-trivial height field, so the
+           vertex data don't compress trivially like with a flat grid */
+        Trade::MeshData3D mesh = Primitives::grid3DSolid({1023, 1023});
+        for(Vector3& position: mesh.positions(0))
+            position.z() = 0.1f*Math::sin(Rad(17.0f*position.x()))*Math::cos(Rad(13.0f*position.y()));
+        return mesh;
+    }}
+};
+
+/* Original mesh data in the form the codec operates on */
+std::vector<UnsignedInt> tipsifiedIndices(Trade::MeshData3D& mesh) {
+    std::vector<UnsignedInt> indices = mesh.indices();
+    tipsify(indices, mesh.positions(0).size(), 24);
+    return indices;
+}
+
+/* Interleave positions and normals, which is the common case */
+Containers::Array<Vector3> interleavedVertices(Trade::MeshData3D& mesh) {
+    const std::vector<Vector3>& positions = mesh.positions(0);
+    const std::vector<Vector3>& normals = mesh.normals(0);
+    Containers::Array<Vector3> interleaved{Containers::NoInit, positions.size()*2};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        interleaved[i*2] = positions[i];
+        interleaved[i*2 + 1] = normals[i];
+    }
+    return interleaved;
+}
+
+template<class T> Containers::StridedArrayView2D<T> vertexView(const Containers::ArrayView<T> interleaved) {
+    return {interleaved, {interleaved.size()/(2*sizeof(Vector3)), 2*sizeof(Vector3)}, {2*sizeof(Vector3), 1}};
+}
+
+EncodeBenchmark::EncodeBenchmark() {
+    addInstancedBenchmarks({&EncodeBenchmark::encodeIndices,
+                            &EncodeBenchmark::encodeVertices,
+                            &EncodeBenchmark::decodeIndices,
+                            &EncodeBenchmark::decodeVertices}, 10,
+        Containers::arraySize(Data));
+
+    addCustomInstancedBenchmarks({&EncodeBenchmark::indexRatio,
+                                  &EncodeBenchmark::vertexRatio}, 1,
+        Containers::arraySize(Data),
+        &EncodeBenchmark::ratioBegin,
+        &EncodeBenchmark::ratioEnd,
+        BenchmarkUnits::Count);
+}
+
+void EncodeBenchmark::encodeIndices() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const std::vector<UnsignedInt> indices = tipsifiedIndices(mesh);
+
+    Containers::Array<char> encoded;
+    CORRADE_BENCHMARK(10)
+        encoded = MeshTools::encodeIndices<UnsignedInt>(Containers::stridedArrayView(Containers::arrayView(indices)));
+
+    CORRADE_VERIFY(!encoded.empty());
+}
+
+void EncodeBenchmark::encodeVertices() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const Containers::Array<Vector3> interleaved = interleavedVertices(mesh);
+    const Containers::StridedArrayView2D<const char> vertices = vertexView(Containers::arrayCast<const char>(interleaved));
+
+    Containers::Array<char> encoded;
+    CORRADE_BENCHMARK(10)
+        encoded = MeshTools::encodeVertices(vertices);
+
+    CORRADE_VERIFY(!encoded.empty());
+}
+
+void EncodeBenchmark::decodeIndices() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const std::vector<UnsignedInt> indices = tipsifiedIndices(mesh);
+
+    Containers::Array<char> encoded = MeshTools::encodeIndices<UnsignedInt>(Containers::stridedArrayView(Containers::arrayView(indices)));
+
+    std::vector<UnsignedInt> decoded(indices.size());
+    CORRADE_BENCHMARK(10)
+        decodeIndicesInto(encoded, Containers::stridedArrayView(Containers::arrayView(decoded)));
+
+    CORRADE_VERIFY(decodeIndicesInto(encoded, Containers::stridedArrayView(Containers::arrayView(decoded))));
+}
+
+void EncodeBenchmark::decodeVertices() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const Containers::Array<Vector3> interleaved = interleavedVertices(mesh);
+    Containers::Array<char> encoded = MeshTools::encodeVertices(vertexView(Containers::arrayCast<const char>(interleaved)));
+
+    Containers::Array<Vector3> decoded{Containers::NoInit, interleaved.size()};
+    const Containers::StridedArrayView2D<char> decodedVertices = vertexView(Containers::arrayCast<char>(decoded));
+    CORRADE_BENCHMARK(10)
+        decodeVerticesInto(encoded, decodedVertices);
+
+    CORRADE_VERIFY(decodeVerticesInto(encoded, decodedVertices));
+}
+
+void EncodeBenchmark::ratioBegin() {
+    setBenchmarkName("encoded size, per mille of original");
+    _ratio = 0;
+}
+
+std::uint64_t EncodeBenchmark::ratioEnd() {
+    return _ratio;
+}
+
+void EncodeBenchmark::indexRatio() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const std::vector<UnsignedInt> indices = tipsifiedIndices(mesh);
+    const std::size_t originalSize = indices.size()*sizeof(UnsignedInt);
+
+    Containers::Array<char> encoded;
+    CORRADE_BENCHMARK(1) {
+        encoded = MeshTools::encodeIndices<UnsignedInt>(Containers::stridedArrayView(Containers::arrayView(indices)));
+        _ratio = encoded.size()*1000/originalSize;
+    }
+
+    /* Triangles sharing an edge with a recent one take a single byte, so a
+       well-connected mesh should take way less than half of the original */
+    CORRADE_COMPARE_AS(encoded.size(), originalSize/2,
+        TestSuite::Compare::Less);
+}
+
+void EncodeBenchmark::vertexRatio() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    const Containers::Array<Vector3> interleaved = interleavedVertices(mesh);
+    const std::size_t originalSize = interleaved.size()*sizeof(Vector3);
+
+    Containers::Array<char> encoded;
+    CORRADE_BENCHMARK(1) {
+        encoded = MeshTools::encodeVertices(vertexView(Containers::arrayCast<const char>(interleaved)));
+        _ratio = encoded.size()*1000/originalSize;
+    }
+
+    /* Float data don't compress much, but they should never expand by more
+       than the block headers and the padded last block */
+    CORRADE_COMPARE_AS(encoded.size(), originalSize + originalSize/32 + 512,
+        TestSuite::Compare::LessOrEqual);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::EncodeBenchmark)
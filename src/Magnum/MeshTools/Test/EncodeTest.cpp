@@ -0,0 +1,352 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Encode.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct EncodeTest: TestSuite::Tester {
+    explicit EncodeTest();
+
+    template<class T> void indices();
+    void indicesEmpty();
+    void indicesIcosphere();
+    void indicesWrongCount();
+    void indicesDecodeInvalidHeader();
+    void indicesDecodeWrongCount();
+    void indicesDecodeTruncated();
+    void indicesDecodeTrailingData();
+    void indicesDecodeTypeTooSmall();
+
+    void vertices();
+    void verticesEmpty();
+    void verticesIcosphere();
+    void verticesNotContiguous();
+    void verticesDecodeInvalidHeader();
+    void verticesDecodeWrongSize();
+    void verticesDecodeTruncated();
+    void verticesDecodeTrailingData();
+};
+
+EncodeTest::EncodeTest() {
+    addTests({&EncodeTest::indices<UnsignedByte>,
+              &EncodeTest::indices<UnsignedShort>,
+              &EncodeTest::indices<UnsignedInt>,
+              &EncodeTest::indicesEmpty,
+              &EncodeTest::indicesIcosphere,
+              &EncodeTest::indicesWrongCount,
+              &EncodeTest::indicesDecodeInvalidHeader,
+              &EncodeTest::indicesDecodeWrongCount,
+              &EncodeTest::indicesDecodeTruncated,
+              &EncodeTest::indicesDecodeTrailingData,
+              &EncodeTest::indicesDecodeTypeTooSmall,
+
+              &EncodeTest::vertices,
+              &EncodeTest::verticesEmpty,
+              &EncodeTest::verticesIcosphere,
+              &EncodeTest::verticesNotContiguous,
+              &EncodeTest::verticesDecodeInvalidHeader,
+              &EncodeTest::verticesDecodeWrongSize,
+              &EncodeTest::verticesDecodeTruncated,
+              &EncodeTest::verticesDecodeTrailingData});
+}
+
+/*
+    0---2---4
+    |\  |\  |
+    | \ | \ |
+    |  \|  \|
+    1---3---5---6
+*/
+constexpr UnsignedByte Indices[]{
+    0, 1, 3,
+    0, 3, 2,
+    2, 3, 5, /* shares an edge, next vertex */
+    2, 5, 4,
+    3, 1, 0, /* shares an edge, vertex from the FIFO */
+    5, 6, 4, /* shares an edge, explicit vertex */
+    200, 100, 6 /* no shared edge, all explicit */
+};
+
+/* The triangles can get rotated, so compare them in a canonical order */
+template<class T> std::vector<UnsignedInt> canonical(const Containers::StridedArrayView1D<T>& indices) {
+    std::vector<UnsignedInt> out;
+    for(std::size_t i = 0; i < indices.size(); i += 3) {
+        std::size_t min = 0;
+        for(std::size_t j = 1; j != 3; ++j)
+            if(indices[i + j] < indices[i + min]) min = j;
+        for(std::size_t j = 0; j != 3; ++j)
+            out.push_back(indices[i + (min + j)%3]);
+    }
+    return out;
+}
+
+template<class T> void EncodeTest::indices() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+
+    Containers::Array<char> data = encodeIndices<T>(Containers::stridedArrayView(indices));
+    /* Header, index count and a code byte for each triangle, the rest are
+       explicitly encoded vertices of the first and last two triangles */
+    CORRADE_COMPARE(data.size(), 19);
+
+    T decoded[Containers::arraySize(Indices)];
+    CORRADE_VERIFY(decodeIndicesInto(data, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE_AS(canonical(Containers::stridedArrayView(decoded)),
+        canonical(Containers::stridedArrayView(indices)),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::indicesEmpty() {
+    Containers::Array<char> data = encodeIndices(Containers::StridedArrayView1D<const UnsignedInt>{});
+    CORRADE_COMPARE(data.size(), 2);
+    CORRADE_VERIFY(decodeIndicesInto(data, Containers::StridedArrayView1D<UnsignedInt>{}));
+}
+
+void EncodeTest::indicesIcosphere() {
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(3);
+    std::vector<UnsignedInt>& indices = icosphere.indices();
+    tipsify(indices, icosphere.positions(0).size(), 24);
+
+    Containers::Array<char> data = encodeIndices<UnsignedInt>(Containers::stridedArrayView(Containers::arrayView(indices)));
+    /* Should be less than a byte per index on average */
+    CORRADE_COMPARE_AS(data.size(), indices.size(),
+        TestSuite::Compare::Less);
+
+    std::vector<UnsignedInt> decoded(indices.size());
+    CORRADE_VERIFY(decodeIndicesInto(data, Containers::stridedArrayView(Containers::arrayView(decoded))));
+    CORRADE_COMPARE_AS(
+        canonical(Containers::stridedArrayView(Containers::arrayView(decoded))),
+        canonical(Containers::stridedArrayView(Containers::arrayView(indices))),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::indicesWrongCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[4]{};
+    encodeIndices(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::encodeIndices(): index count not divisible by 3\n");
+}
+
+void EncodeTest::indicesDecodeInvalidHeader() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[]{'\xd0', '\x00'};
+    CORRADE_VERIFY(!decodeIndicesInto(data, Containers::StridedArrayView1D<UnsignedInt>{}));
+    CORRADE_VERIFY(!decodeIndicesInto(nullptr, Containers::StridedArrayView1D<UnsignedInt>{}));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndicesInto(): invalid header\n"
+        "MeshTools::decodeIndicesInto(): invalid header\n");
+}
+
+void EncodeTest::indicesDecodeWrongCount() {
+    Containers::Array<char> data = encodeIndices<UnsignedByte>(Containers::stridedArrayView(Indices));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte decoded[18];
+    CORRADE_VERIFY(!decodeIndicesInto(data, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndicesInto(): expected 18 indices but got 21\n");
+}
+
+void EncodeTest::indicesDecodeTruncated() {
+    Containers::Array<char> data = encodeIndices<UnsignedByte>(Containers::stridedArrayView(Indices));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte decoded[21];
+    CORRADE_VERIFY(!decodeIndicesInto(data.prefix(data.size() - 1), Containers::stridedArrayView(decoded)));
+    CORRADE_VERIFY(!decodeIndicesInto(data.prefix(data.size() - 7), Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndicesInto(): unexpected end of data\n"
+        "MeshTools::decodeIndicesInto(): unexpected end of data\n");
+}
+
+void EncodeTest::indicesDecodeTrailingData() {
+    Containers::Array<char> data = encodeIndices<UnsignedByte>(Containers::stridedArrayView(Indices));
+    Containers::Array<char> dataTrailing{Containers::ValueInit, data.size() + 2};
+    std::memcpy(dataTrailing.data(), data.data(), data.size());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte decoded[21];
+    CORRADE_VERIFY(!decodeIndicesInto(dataTrailing, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndicesInto(): 2 unexpected bytes at the end of data\n");
+}
+
+void EncodeTest::indicesDecodeTypeTooSmall() {
+    const UnsignedShort indices[]{0, 1, 256};
+    Containers::Array<char> data = encodeIndices(Containers::stridedArrayView(indices));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte decoded[3];
+    CORRADE_VERIFY(!decodeIndicesInto(data, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndicesInto(): decoded index doesn't fit into 8 bits\n");
+}
+
+struct Vertex {
+    Vector3 position;
+    UnsignedShort id;
+    UnsignedByte flags;
+    UnsignedByte padding;
+};
+
+void EncodeTest::vertices() {
+    /* 37 vertices to test also a partial last block */
+    Vertex vertices[37];
+    for(std::size_t i = 0; i != Containers::arraySize(vertices); ++i)
+        vertices[i] = {Vector3{Float(i)*0.25f, 1.0f, -Float(i)}, UnsignedShort(1000 + i*3), UnsignedByte(i % 2 ? 0xff : 0x00), 0};
+
+    Containers::StridedArrayView2D<const char> view{
+        Containers::arrayCast<const char>(Containers::arrayView(vertices)),
+        {Containers::arraySize(vertices), sizeof(Vertex)}, {sizeof(Vertex), 1}};
+    Containers::Array<char> data = encodeVertices(view);
+    CORRADE_COMPARE_AS(data.size(), sizeof(vertices),
+        TestSuite::Compare::Less);
+
+    Vertex decoded[37];
+    Containers::StridedArrayView2D<char> decodedView{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)),
+        {Containers::arraySize(decoded), sizeof(Vertex)}, {sizeof(Vertex), 1}};
+    CORRADE_VERIFY(decodeVerticesInto(data, decodedView));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const char>(Containers::arrayView(decoded)),
+        Containers::arrayCast<const char>(Containers::arrayView(vertices)),
+        TestSuite::Compare::Container);
+}
+
+void EncodeTest::verticesEmpty() {
+    Containers::Array<char> data = encodeVertices(Containers::StridedArrayView2D<const char>{nullptr, {0, 12}, {12, 1}});
+    CORRADE_COMPARE(data.size(), 3);
+    CORRADE_VERIFY(decodeVerticesInto(data, Containers::StridedArrayView2D<char>{nullptr, {0, 12}, {12, 1}}));
+}
+
+void EncodeTest::verticesIcosphere() {
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(3);
+    const std::vector<Vector3>& positions = icosphere.positions(0);
+
+    Containers::StridedArrayView2D<const char> view{
+        Containers::arrayCast<const char>(Containers::arrayView(positions)),
+        {positions.size(), sizeof(Vector3)}, {sizeof(Vector3), 1}};
+    Containers::Array<char> data = encodeVertices(view);
+
+    std::vector<Vector3> decoded(positions.size());
+    Containers::StridedArrayView2D<char> decodedView{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)),
+        {decoded.size(), sizeof(Vector3)}, {sizeof(Vector3), 1}};
+    CORRADE_VERIFY(decodeVerticesInto(data, decodedView));
+    CORRADE_COMPARE_AS(decoded, positions, TestSuite::Compare::Container);
+}
+
+void EncodeTest::verticesNotContiguous() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[16];
+    encodeVertices(Containers::StridedArrayView2D<const char>{data, {4, 2}, {4, 2}});
+    decodeVerticesInto(nullptr, Containers::StridedArrayView2D<char>{data, {4, 2}, {4, 2}});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertices(): second view dimension is not contiguous\n"
+        "MeshTools::decodeVerticesInto(): second view dimension is not contiguous\n");
+}
+
+void EncodeTest::verticesDecodeInvalidHeader() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[]{'\xe0', '\x00'};
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{nullptr, {0, 12}, {12, 1}}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): invalid header\n");
+}
+
+void EncodeTest::verticesDecodeWrongSize() {
+    const Vector3 positions[3]{};
+    Containers::Array<char> data = encodeVertices(Containers::StridedArrayView2D<const char>{
+        Containers::arrayCast<const char>(Containers::arrayView(positions)), {3, 12}, {12, 1}});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector3 decoded[3];
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)), {2, 12}, {12, 1}}));
+    CORRADE_VERIFY(!decodeVerticesInto(data, Containers::StridedArrayView2D<char>{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)), {3, 8}, {12, 1}}));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVerticesInto(): expected 2 vertices of 12 bytes but got 3 vertices of 12 bytes\n"
+        "MeshTools::decodeVerticesInto(): expected 3 vertices of 8 bytes but got 3 vertices of 12 bytes\n");
+}
+
+void EncodeTest::verticesDecodeTruncated() {
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Containers::Array<char> data = encodeVertices(Containers::StridedArrayView2D<const char>{
+        Containers::arrayCast<const char>(Containers::arrayView(positions)), {2, 12}, {12, 1}});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector3 decoded[2];
+    CORRADE_VERIFY(!decodeVerticesInto(data.prefix(data.size() - 1), Containers::StridedArrayView2D<char>{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)), {2, 12}, {12, 1}}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): unexpected end of data\n");
+}
+
+void EncodeTest::verticesDecodeTrailingData() {
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Containers::Array<char> data = encodeVertices(Containers::StridedArrayView2D<const char>{
+        Containers::arrayCast<const char>(Containers::arrayView(positions)), {2, 12}, {12, 1}});
+    Containers::Array<char> dataTrailing{Containers::ValueInit, data.size() + 3};
+    std::memcpy(dataTrailing.data(), data.data(), data.size());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector3 decoded[2];
+    CORRADE_VERIFY(!decodeVerticesInto(dataTrailing, Containers::StridedArrayView2D<char>{
+        Containers::arrayCast<char>(Containers::arrayView(decoded)), {2, 12}, {12, 1}}));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVerticesInto(): 3 unexpected bytes at the end of data\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::EncodeTest)
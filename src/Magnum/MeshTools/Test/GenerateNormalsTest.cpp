@@ -32,6 +32,7 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/TaskScheduler.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Duplicate.h"
@@ -50,6 +51,7 @@ struct GenerateNormalsTest: TestSuite::Tester {
     #endif
     void flatWrongCount();
     void flatIntoWrongSize();
+    void flatIntoParallel();
 
     void smoothTwoTriangles();
     void smoothCube();
@@ -62,6 +64,17 @@ struct GenerateNormalsTest: TestSuite::Tester {
 
     void benchmarkFlat();
     void benchmarkSmooth();
+    void benchmarkFlatParallel();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt workerCount;
+} BenchmarkParallelData[]{
+    {"single-threaded", 0},
+    {"1 worker", 1},
+    {"3 workers", 3},
+    {"7 workers", 7}
 };
 
 GenerateNormalsTest::GenerateNormalsTest() {
@@ -71,6 +84,7 @@ GenerateNormalsTest::GenerateNormalsTest() {
               #endif
               &GenerateNormalsTest::flatWrongCount,
               &GenerateNormalsTest::flatIntoWrongSize,
+              &GenerateNormalsTest::flatIntoParallel,
 
               &GenerateNormalsTest::smoothTwoTriangles,
               &GenerateNormalsTest::smoothCube,
@@ -83,6 +97,9 @@ GenerateNormalsTest::GenerateNormalsTest() {
 
     addBenchmarks({&GenerateNormalsTest::benchmarkFlat,
                    &GenerateNormalsTest::benchmarkSmooth}, 150);
+
+    addInstancedBenchmarks({&GenerateNormalsTest::benchmarkFlatParallel}, 50,
+        Containers::arraySize(BenchmarkParallelData));
 }
 
 /* Two vertices connected by one edge, each wound in another direction */
@@ -155,6 +172,25 @@ void GenerateNormalsTest::flatIntoWrongSize() {
     CORRADE_COMPARE(out.str(), "MeshTools::generateFlatNormalsInto(): bad output size, expected 6 but got 7\n");
 }
 
+void GenerateNormalsTest::flatIntoParallel() {
+    /* A cylinder repeated enough times to be split into several chunks */
+    Trade::MeshData3D cylinder = Primitives::cylinderSolid(24, 32, 1.0f);
+    Containers::Array<Vector3> triangles = duplicate(
+        Containers::stridedArrayView(cylinder.indices()),
+        Containers::stridedArrayView(cylinder.positions(0)));
+    Containers::Array<Vector3> positions{Containers::NoInit, triangles.size()*10};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = triangles[i % triangles.size()];
+
+    Containers::Array<Vector3> expected{Containers::NoInit, positions.size()};
+    generateFlatNormalsInto(positions, expected);
+
+    TaskScheduler scheduler{3};
+    Containers::Array<Vector3> normals{Containers::NoInit, positions.size()};
+    generateFlatNormalsInto(scheduler, positions, normals);
+    CORRADE_COMPARE_AS(normals, expected, TestSuite::Compare::Container);
+}
+
 void GenerateNormalsTest::smoothTwoTriangles() {
     const UnsignedInt indices[]{0, 1, 2, 3, 4, 5};
 
@@ -420,6 +456,27 @@ void GenerateNormalsTest::benchmarkSmooth() {
     CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
 }
 
+void GenerateNormalsTest::benchmarkFlatParallel() {
+    auto&& data = BenchmarkParallelData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The beveled cube is too small to split, repeat it many times */
+    Containers::Array<Vector3> cube = duplicate(
+        Containers::stridedArrayView(BeveledCubeIndices),
+        Containers::stridedArrayView(BeveledCubePositions));
+    Containers::Array<Vector3> positions{Containers::NoInit, cube.size()*1000};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = cube[i % cube.size()];
+
+    TaskScheduler scheduler{data.workerCount};
+    Containers::Array<Vector3> normals{Containers::NoInit, positions.size()};
+    CORRADE_BENCHMARK(1) {
+        generateFlatNormalsInto(scheduler, positions, normals);
+    }
+
+    CORRADE_COMPARE(Math::min(normals), (Vector3{-1.0f, -1.0f, -1.0f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateNormalsTest)
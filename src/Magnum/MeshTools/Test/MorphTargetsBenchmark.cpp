@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/MorphTargets.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct MorphTargetsBenchmark: TestSuite::Tester {
+    explicit MorphTargetsBenchmark();
+
+    void dense();
+    void sparse();
+
+    void checkResult(const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals);
+
+    Containers::Array<Vector3> _basePositions, _baseNormals;
+    Containers::Array<Containers::Array<Vector3>> _densePositions, _denseNormals;
+    Containers::Array<MorphTarget> _targets;
+    Containers::Array<Float> _weights;
+};
+
+/* Roughly a face rig -- a 30k vertex head with 52 blend shapes, each moving a
+   few percent of the vertices, and 8 of them active at a time */
+enum: std::size_t {
+    VertexCount = 30000,
+    TargetCount = 52,
+    TargetVertexCount = 1500,
+    ActiveTargetCount = 8
+};
+
+/* First vertex affected by given target */
+std::size_t targetOffset(const std::size_t target) {
+    return (target*577)%(VertexCount - TargetVertexCount);
+}
+
+MorphTargetsBenchmark::MorphTargetsBenchmark() {
+    addBenchmarks({&MorphTargetsBenchmark::dense,
+                   &MorphTargetsBenchmark::sparse}, 10);
+
+    _basePositions = Containers::Array<Vector3>{Containers::NoInit, VertexCount};
+    _baseNormals = Containers::Array<Vector3>{Containers::NoInit, VertexCount};
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        _basePositions[i] = Vector3{Float(i%100), Float(i/100), 0.0f};
+        _baseNormals[i] = Vector3::zAxis();
+    }
+
+    /* Each target moves a contiguous region of the mesh */
+    _densePositions = Containers::Array<Containers::Array<Vector3>>{TargetCount};
+    _denseNormals = Containers::Array<Containers::Array<Vector3>>{TargetCount};
+    _targets = Containers::Array<MorphTarget>{TargetCount};
+    for(std::size_t i = 0; i != TargetCount; ++i) {
+        _densePositions[i] = Containers::Array<Vector3>{Containers::ValueInit, VertexCount};
+        _denseNormals[i] = Containers::Array<Vector3>{Containers::ValueInit, VertexCount};
+        const std::size_t offset = targetOffset(i);
+        for(std::size_t j = 0; j != TargetVertexCount; ++j) {
+            _densePositions[i][offset + j] = Vector3{0.0f, 0.0f, 0.01f*Float(j%7)};
+            _denseNormals[i][offset + j] = Vector3{0.01f*Float(j%5), 0.0f, 0.0f};
+        }
+        _targets[i] = sparseMorphTarget(
+            Containers::stridedArrayView(Containers::arrayView(_densePositions[i])),
+            Containers::stridedArrayView(Containers::arrayView(_denseNormals[i])));
+    }
+
+    _weights = Containers::Array<Float>{Containers::ValueInit, TargetCount};
+    for(std::size_t i = 0; i != ActiveTargetCount; ++i)
+        _weights[i*(TargetCount/ActiveTargetCount)] = 0.5f;
+}
+
+void MorphTargetsBenchmark::dense() {
+    Containers::Array<Vector3> positions{Containers::NoInit, VertexCount};
+    Containers::Array<Vector3> normals{Containers::NoInit, VertexCount};
+
+    /* Straightforward evaluation going through all vertices of all active
+       targets. Inactive targets are skipped, same as in applyMorphTargets(),
+       so the difference is only in touching unaffected vertices. */
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != VertexCount; ++i) {
+            positions[i] = _basePositions[i];
+            normals[i] = _baseNormals[i];
+        }
+        for(std::size_t i = 0; i != TargetCount; ++i) {
+            if(_weights[i] == 0.0f) continue;
+
+            for(std::size_t j = 0; j != VertexCount; ++j) {
+                positions[j] += _densePositions[i][j]*_weights[i];
+                normals[j] += _denseNormals[i][j]*_weights[i];
+            }
+        }
+    }
+
+    checkResult(positions, normals);
+}
+
+void MorphTargetsBenchmark::sparse() {
+    Containers::Array<Vector3> positions{Containers::NoInit, VertexCount};
+    Containers::Array<Vector3> normals{Containers::NoInit, VertexCount};
+
+    std::size_t applied{};
+    CORRADE_BENCHMARK(10) {
+        applied = applyMorphTargets(
+            Containers::stridedArrayView(Containers::arrayView(_basePositions)),
+            Containers::stridedArrayView(Containers::arrayView(_baseNormals)),
+            _targets, _weights,
+            Containers::stridedArrayView(Containers::arrayView(positions)),
+            Containers::stridedArrayView(Containers::arrayView(normals)));
+    }
+
+    CORRADE_COMPARE(applied, std::size_t(ActiveTargetCount));
+    checkResult(positions, normals);
+}
+
+void MorphTargetsBenchmark::checkResult(const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals) {
+    /* Check the second vertex of each active target, the first one has a
+       zero offset. Overlapping targets are accounted for. */
+    for(std::size_t i = 0; i != ActiveTargetCount; ++i) {
+        const std::size_t vertex = targetOffset(i*(TargetCount/ActiveTargetCount)) + 1;
+
+        Vector3 expectedPosition = _basePositions[vertex];
+        Vector3 expectedNormal = _baseNormals[vertex];
+        for(std::size_t j = 0; j != TargetCount; ++j) {
+            expectedPosition += _densePositions[j][vertex]*_weights[j];
+            expectedNormal += _denseNormals[j][vertex]*_weights[j];
+        }
+
+        CORRADE_VERIFY(expectedPosition != _basePositions[vertex]);
+        CORRADE_VERIFY(expectedNormal != _baseNormals[vertex]);
+        CORRADE_COMPARE(positions[vertex], expectedPosition);
+        CORRADE_COMPARE(normals[vertex], expectedNormal);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MorphTargetsBenchmark)
@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/MorphTargets.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct MorphTargetsTest: TestSuite::Tester {
+    explicit MorphTargetsTest();
+
+    void sparse();
+    void sparseEpsilon();
+    void sparseNormals();
+    void sparseWrongNormalCount();
+
+    void apply();
+    void applyNormals();
+    void applyNoNormalOutput();
+    void applyZeroWeights();
+    void applyPlayer();
+
+    void applyWrongWeightCount();
+    void applyWrongOutputSize();
+    void applyWrongOffsetCount();
+    void applyIndexOutOfBounds();
+};
+
+MorphTargetsTest::MorphTargetsTest() {
+    addTests({&MorphTargetsTest::sparse,
+              &MorphTargetsTest::sparseEpsilon,
+              &MorphTargetsTest::sparseNormals,
+              &MorphTargetsTest::sparseWrongNormalCount,
+
+              &MorphTargetsTest::apply,
+              &MorphTargetsTest::applyNormals,
+              &MorphTargetsTest::applyNoNormalOutput,
+              &MorphTargetsTest::applyZeroWeights,
+              &MorphTargetsTest::applyPlayer,
+
+              &MorphTargetsTest::applyWrongWeightCount,
+              &MorphTargetsTest::applyWrongOutputSize,
+              &MorphTargetsTest::applyWrongOffsetCount,
+              &MorphTargetsTest::applyIndexOutOfBounds});
+}
+
+const Vector3 PositionOffsets[]{
+    {},
+    {1.0f, 0.0f, 0.0f},
+    {},
+    {0.0f, 0.001f, 0.0f},
+    {0.0f, 0.0f, -2.0f}
+};
+
+const Vector3 BasePositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f}
+};
+
+const Vector3 BaseNormals[]{
+    {0.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f}
+};
+
+/* Two targets, one moving vertices 1 and 3, the other vertex 3 only */
+MorphTarget targets() {
+    MorphTarget a;
+    a.indices = Containers::Array<UnsignedInt>{Containers::InPlaceInit, {1, 3}};
+    a.positions = Containers::Array<Vector3>{Containers::InPlaceInit, {
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f}}};
+    a.normals = Containers::Array<Vector3>{Containers::InPlaceInit, {
+        {1.0f, 0.0f, -1.0f},
+        {0.0f, 0.0f, 0.0f}}};
+    return a;
+}
+
+void MorphTargetsTest::sparse() {
+    MorphTarget target = sparseMorphTarget(Containers::stridedArrayView(PositionOffsets));
+
+    const UnsignedInt expectedIndices[]{1, 3, 4};
+    const Vector3 expectedPositions[]{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 0.001f, 0.0f},
+        {0.0f, 0.0f, -2.0f}
+    };
+    CORRADE_COMPARE_AS(target.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(target.positions, Containers::arrayView(expectedPositions),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(target.normals.empty());
+}
+
+void MorphTargetsTest::sparseEpsilon() {
+    MorphTarget target = sparseMorphTarget(Containers::stridedArrayView(PositionOffsets), {}, 0.01f);
+
+    const UnsignedInt expectedIndices[]{1, 4};
+    const Vector3 expectedPositions[]{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, -2.0f}
+    };
+    CORRADE_COMPARE_AS(target.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(target.positions, Containers::arrayView(expectedPositions),
+        TestSuite::Compare::Container);
+}
+
+void MorphTargetsTest::sparseNormals() {
+    const Vector3 normalOffsets[]{
+        {},
+        {},
+        {0.5f, 0.0f, 0.0f},
+        {},
+        {0.0f, 0.25f, 0.0f}
+    };
+    MorphTarget target = sparseMorphTarget(Containers::stridedArrayView(PositionOffsets), Containers::stridedArrayView(normalOffsets), 0.01f);
+
+    /* Vertex 2 is included because of its normal offset */
+    const UnsignedInt expectedIndices[]{1, 2, 4};
+    const Vector3 expectedPositions[]{
+        {1.0f, 0.0f, 0.0f},
+        {},
+        {0.0f, 0.0f, -2.0f}
+    };
+    const Vector3 expectedNormals[]{
+        {},
+        {0.5f, 0.0f, 0.0f},
+        {0.0f, 0.25f, 0.0f}
+    };
+    CORRADE_COMPARE_AS(target.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(target.positions, Containers::arrayView(expectedPositions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(target.normals, Containers::arrayView(expectedNormals),
+        TestSuite::Compare::Container);
+}
+
+void MorphTargetsTest::sparseWrongNormalCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 normalOffsets[3];
+    sparseMorphTarget(Containers::stridedArrayView(PositionOffsets), Containers::stridedArrayView(normalOffsets));
+    CORRADE_COMPARE(out.str(), "MeshTools::sparseMorphTarget(): expected either no normals or 5 but got 3\n");
+}
+
+void MorphTargetsTest::apply() {
+    MorphTarget t[2];
+    t[0] = targets();
+    t[1].indices = Containers::Array<UnsignedInt>{Containers::InPlaceInit, {3}};
+    t[1].positions = Containers::Array<Vector3>{Containers::InPlaceInit, {
+        {1.0f, 1.0f, 1.0f}}};
+    const Float weights[]{0.5f, -1.0f};
+
+    Vector3 positions[4];
+    CORRADE_COMPARE(applyMorphTargets(
+        Containers::stridedArrayView(BasePositions), {}, t, weights,
+        Containers::stridedArrayView(positions), {}), 2);
+
+    const Vector3 expected[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.5f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f}
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void MorphTargetsTest::applyNormals() {
+    MorphTarget t[1];
+    t[0] = targets();
+    const Float weights[]{0.5f};
+
+    Vector3 positions[4];
+    Vector3 normals[4];
+    CORRADE_COMPARE(applyMorphTargets(
+        Containers::stridedArrayView(BasePositions),
+        Containers::stridedArrayView(BaseNormals), t, weights,
+        Containers::stridedArrayView(positions),
+        Containers::stridedArrayView(normals)), 1);
+
+    const Vector3 expectedPositions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.5f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 1.0f}
+    };
+    /* Not renormalized */
+    const Vector3 expectedNormals[]{
+        {0.0f, 0.0f, 1.0f},
+        {0.5f, 0.0f, 0.5f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView(expectedPositions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals), Containers::arrayView(expectedNormals),
+        TestSuite::Compare::Container);
+}
+
+void MorphTargetsTest::applyNoNormalOutput() {
+    MorphTarget t[1];
+    t[0] = targets();
+    const Float weights[]{1.0f};
+
+    /* Normal offsets get ignored */
+    Vector3 positions[4];
+    CORRADE_COMPARE(applyMorphTargets(
+        Containers::stridedArrayView(BasePositions), {}, t, weights,
+        Containers::stridedArrayView(positions), {}), 1);
+    CORRADE_COMPARE(positions[1], (Vector3{2.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[3], (Vector3{0.0f, 2.0f, 1.0f}));
+}
+
+void MorphTargetsTest::applyZeroWeights() {
+    MorphTarget t[2];
+    t[0] = targets();
+    t[1] = targets();
+    const Float weights[]{0.0f, 0.0f};
+
+    Vector3 positions[4]{Vector3{-1.0f}, Vector3{-1.0f}, Vector3{-1.0f}, Vector3{-1.0f}};
+    CORRADE_COMPARE(applyMorphTargets(
+        Containers::stridedArrayView(BasePositions), {}, t, weights,
+        Containers::stridedArrayView(positions), {}), 0);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView(BasePositions),
+        TestSuite::Compare::Container);
+}
+
+void MorphTargetsTest::applyPlayer() {
+    const Animation::Track<Float, Float> weightTrack{{
+        {0.0f, 0.0f},
+        {1.0f, 1.0f}
+    }, Math::lerp};
+
+    MorphTarget t[1];
+    t[0] = targets();
+    Float weights[1]{};
+
+    Animation::Player<Float> player;
+    player.add(weightTrack, weights[0])
+        .play(0.0f);
+
+    Vector3 positions[4];
+    player.advance(0.25f);
+    CORRADE_COMPARE(applyMorphTargets(
+        Containers::stridedArrayView(BasePositions), {}, t, weights,
+        Containers::stridedArrayView(positions), {}), 1);
+    CORRADE_COMPARE(positions[1], (Vector3{1.25f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[3], (Vector3{0.0f, 0.5f, 1.0f}));
+}
+
+void MorphTargetsTest::applyWrongWeightCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MorphTarget t[2];
+    const Float weights[1]{};
+    Vector3 positions[4];
+    applyMorphTargets(Containers::stridedArrayView(BasePositions), {}, t, weights, Containers::stridedArrayView(positions), {});
+    CORRADE_COMPARE(out.str(), "MeshTools::applyMorphTargets(): expected 2 weights but got 1\n");
+}
+
+void MorphTargetsTest::applyWrongOutputSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 basePositions3[3];
+    const Vector3 baseNormals3[3];
+    Vector3 positions[3];
+    Vector3 normals3[3];
+    Vector3 normals4[4];
+    applyMorphTargets(Containers::stridedArrayView(BasePositions), {}, nullptr, nullptr, Containers::stridedArrayView(positions), {});
+    applyMorphTargets(Containers::stridedArrayView(basePositions3), Containers::stridedArrayView(BaseNormals), nullptr, nullptr, Containers::stridedArrayView(positions), Containers::stridedArrayView(normals3));
+    applyMorphTargets(Containers::stridedArrayView(basePositions3), Containers::stridedArrayView(baseNormals3), nullptr, nullptr, Containers::stridedArrayView(positions), Containers::stridedArrayView(normals4));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::applyMorphTargets(): expected 4 output positions but got 3\n"
+        "MeshTools::applyMorphTargets(): expected either no base normals or 3 but got 4\n"
+        "MeshTools::applyMorphTargets(): expected 3 output normals but got 4\n");
+}
+
+void MorphTargetsTest::applyWrongOffsetCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MorphTarget t[2];
+    t[0] = targets();
+    t[0].positions = Containers::Array<Vector3>{1};
+    t[1] = targets();
+    t[1].normals = Containers::Array<Vector3>{3};
+    const Float weights[]{1.0f, 1.0f};
+    Vector3 positions[4];
+
+    applyMorphTargets(Containers::stridedArrayView(BasePositions), {}, Containers::arrayView(t).prefix(1), Containers::arrayView(weights).prefix(1), Containers::stridedArrayView(positions), {});
+    applyMorphTargets(Containers::stridedArrayView(BasePositions), {}, Containers::arrayView(t).suffix(1), Containers::arrayView(weights).suffix(1), Containers::stridedArrayView(positions), {});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::applyMorphTargets(): expected 2 position offsets in target 0 but got 1\n"
+        "MeshTools::applyMorphTargets(): expected either no normal offsets in target 0 or 2 but got 3\n");
+}
+
+void MorphTargetsTest::applyIndexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MorphTarget t[2];
+    t[1] = targets();
+    t[1].indices[1] = 4;
+    const Float weights[]{0.0f, 1.0f};
+    Vector3 positions[4];
+    applyMorphTargets(Containers::stridedArrayView(BasePositions), {}, t, weights, Containers::stridedArrayView(positions), {});
+    CORRADE_COMPARE(out.str(), "MeshTools::applyMorphTargets(): index 4 in target 1 out of bounds for 4 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MorphTargetsTest)
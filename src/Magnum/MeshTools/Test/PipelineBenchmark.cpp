@@ -0,0 +1,457 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#include "configure.h"
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+#define WIN32_LEAN_AND_MEAN 1
+#define VC_EXTRALEAN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(CORRADE_TARGET_APPLE)
+#include <mach/mach.h>
+#endif
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define MAGNUM_PIPELINE_BENCHMARK_MALLINFO2
+#endif
+
+/* End-to-end asset pipeline benchmark. Unlike the other benchmarks in this
+   directory it's not a TestSuite::Tester, because the output is meant to be
+   consumed by scripts tracking performance over time -- it prints a JSON
+   document with time, throughput and memory usage of each pipeline stage for
+   generated datasets of increasing size.
+
+    MeshToolsPipelineBenchmark --mesh-sizes 1000,100000 --repeats 5 \
+        --output pipeline.json
+
+   The mesh pipeline is OBJ import, removeDuplicates(), generateSmoothNormals(),
+   tipsify(), compressIndices() and interleave(); the image pipeline is TGA
+   import and conversion of the RGB8 pixels to RGBA32F.
+
+   Memory usage is queried from the OS instead of replacing the global
+   allocation functions, as that would break with shared libraries and
+   plugins that have their own allocator, such as DLLs on Windows. Which
+   means:
+
+   -    peakResidentBytes is the peak resident set size of the process during
+        the stage. It can be reset before each stage only on Linux 4.0+,
+        everywhere else it's null and processPeakResidentBytes, which is the
+        peak of the whole process so far, is printed instead. The two
+        shouldn't be compared to each other.
+   -    heapDeltaBytes is heap memory in use at the end of the stage minus
+        heap memory in use at its start, so temporaries freed during the stage
+        are not included. It's not a peak. Available only with glibc 2.33+,
+        null otherwise. */
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+/* Resets the peak resident set size, returns false if the platform doesn't
+   support that */
+bool resetPeakResidentMemory() {
+    #ifdef __linux__
+    /* Writing 5 to clear_refs resets VmHWM, since Linux 4.0. Older kernels
+       fail the write with EINVAL, which gets reported on fclose(). */
+    std::FILE* const f = std::fopen("/proc/self/clear_refs", "w");
+    if(!f) return false;
+    const bool written = std::fputs("5", f) != EOF;
+    return std::fclose(f) == 0 && written;
+    #else
+    return false;
+    #endif
+}
+
+/* Peak resident set size in bytes or 0 if not known */
+std::size_t peakResidentMemory() {
+    #ifdef __linux__
+    std::size_t peak = 0;
+    if(std::FILE* const f = std::fopen("/proc/self/status", "r")) {
+        char line[128];
+        while(std::fgets(line, sizeof(line), f)) {
+            if(std::strncmp(line, "VmHWM:", 6) == 0) {
+                peak = std::strtoull(line + 6, nullptr, 10)*1024;
+                break;
+            }
+        }
+        std::fclose(f);
+    }
+    return peak;
+    #elif defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+    #elif defined(CORRADE_TARGET_APPLE)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size_max;
+    #else
+    return 0;
+    #endif
+}
+
+/* Heap memory currently in use in bytes or 0 if not known, see
+   HeapUsageKnown */
+std::size_t heapUsage() {
+    #ifdef MAGNUM_PIPELINE_BENCHMARK_MALLINFO2
+    return mallinfo2().uordblks;
+    #else
+    return 0;
+    #endif
+}
+
+#ifdef MAGNUM_PIPELINE_BENCHMARK_MALLINFO2
+constexpr bool HeapUsageKnown = true;
+#else
+constexpr bool HeapUsageKnown = false;
+#endif
+
+struct Stage {
+    explicit Stage(const char* name, std::size_t itemCount): name{name}, itemCount{itemCount} {}
+
+    const char* name;
+    std::size_t itemCount;
+    /* Minimum over all repeats, as that's the least affected by noise */
+    double seconds = Math::Constants<Double>::inf();
+    /* Maximum over all repeats. If the peak couldn't be reset before the
+       stage, it's the peak of the whole process so far. */
+    std::size_t peakResident{};
+    bool peakResidentPerStage = true;
+    Long heapDelta{};
+};
+
+/* Runs given stage, updating its statistics. The stage is expected to return
+   false on failure. */
+template<class F> bool measure(Stage& stage, F&& f) {
+    if(!resetPeakResidentMemory()) stage.peakResidentPerStage = false;
+    const std::size_t heapBefore = heapUsage();
+
+    const auto begin = std::chrono::steady_clock::now();
+    const bool result = f();
+    const auto end = std::chrono::steady_clock::now();
+
+    stage.seconds = Math::min(stage.seconds, std::chrono::duration<double>(end - begin).count());
+    stage.peakResident = Math::max(stage.peakResident, peakResidentMemory());
+    stage.heapDelta = Math::max(stage.heapDelta, Long(heapUsage()) - Long(heapBefore));
+    return result;
+}
+
+void printStages(std::ostream& out, const std::vector<Stage>& stages) {
+    out << "      \"stages\": [\n";
+    for(std::size_t i = 0; i != stages.size(); ++i) {
+        const Stage& stage = stages[i];
+        out << "        {\"name\": \"" << stage.name << "\", "
+            << "\"seconds\": " << stage.seconds << ", "
+            << "\"itemsPerSecond\": " << (stage.seconds > 0.0 ? stage.itemCount/stage.seconds : 0.0) << ", "
+            << "\"peakResidentBytes\": ";
+        if(stage.peakResidentPerStage)
+            out << stage.peakResident << ", ";
+        else
+            out << "null, \"processPeakResidentBytes\": " << stage.peakResident << ", ";
+        out << "\"heapDeltaBytes\": ";
+        if(HeapUsageKnown)
+            out << stage.heapDelta;
+        else
+            out << "null";
+        out << "}"
+            << (i + 1 == stages.size() ? "\n" : ",\n");
+    }
+    out << "      ]\n";
+}
+
+/* A heightfield with approximately given triangle count. Every triangle has
+   its own vertices so removeDuplicates() has something to do, and the surface
+   is curved so the smooth normals aren't trivial. */
+std::string generateObj(const std::size_t triangleCount, std::size_t& actualTriangleCount) {
+    const std::size_t side = Math::max(std::size_t(1), std::size_t(std::sqrt(triangleCount/2.0)));
+    actualTriangleCount = side*side*2;
+
+    const auto vertex = [side](std::ostream& out, std::size_t x, std::size_t y) {
+        const Float fx = Float(x)/side;
+        const Float fy = Float(y)/side;
+        out << "v " << fx << ' ' << fy << ' '
+            << 0.1f*std::sin(fx*Constants::tau())*std::cos(fy*Constants::tau())
+            << '\n';
+    };
+
+    std::ostringstream out;
+    out << "o heightfield\n";
+    for(std::size_t y = 0; y != side; ++y) {
+        for(std::size_t x = 0; x != side; ++x) {
+            vertex(out, x, y);
+            vertex(out, x + 1, y);
+            vertex(out, x + 1, y + 1);
+            vertex(out, x, y);
+            vertex(out, x + 1, y + 1);
+            vertex(out, x, y + 1);
+        }
+    }
+    for(std::size_t i = 0; i != actualTriangleCount; ++i)
+        out << "f " << i*3 + 1 << ' ' << i*3 + 2 << ' ' << i*3 + 3 << '\n';
+
+    return out.str();
+}
+
+/* An uncompressed 24-bit TGA with a color gradient */
+Containers::Array<char> generateTga(const UnsignedShort size) {
+    Containers::Array<char> data{Containers::ValueInit, 18 + std::size_t(size)*size*3};
+    data[2] = 2; /* Uncompressed RGB */
+    Utility::Endianness::littleEndianInPlace(*reinterpret_cast<UnsignedShort*>(data + 12) = size);
+    Utility::Endianness::littleEndianInPlace(*reinterpret_cast<UnsignedShort*>(data + 14) = size);
+    data[16] = 24;
+
+    char* pixel = data + 18;
+    for(std::size_t y = 0; y != size; ++y) {
+        for(std::size_t x = 0; x != size; ++x) {
+            /* BGR */
+            *pixel++ = char(x*255/size);
+            *pixel++ = char(y*255/size);
+            *pixel++ = char((x + y)*127/size);
+        }
+    }
+
+    return data;
+}
+
+bool benchmarkMesh(Trade::AbstractImporter& importer, const std::size_t requestedTriangleCount, const UnsignedInt repeats, std::ostream& out) {
+    std::size_t triangleCount;
+    const std::string obj = generateObj(requestedTriangleCount, triangleCount);
+
+    std::vector<Stage> stages;
+    stages.emplace_back("import", triangleCount);
+    stages.emplace_back("removeDuplicates", triangleCount);
+    stages.emplace_back("generateSmoothNormals", triangleCount);
+    stages.emplace_back("tipsify", triangleCount);
+    stages.emplace_back("compressIndices", triangleCount);
+    stages.emplace_back("interleave", triangleCount);
+
+    for(UnsignedInt repeat = 0; repeat != repeats; ++repeat) {
+        std::vector<UnsignedInt> indices;
+        std::vector<Vector3> positions;
+        Containers::Array<Vector3> normals;
+        Containers::Array<char> indexData;
+        Containers::Array<char> vertexData;
+
+        if(!measure(stages[0], [&]() {
+            Containers::Optional<Trade::MeshData3D> mesh;
+            if(!importer.openData({obj.data(), obj.size()}) || !(mesh = importer.mesh3D(0)))
+                return false;
+
+            indices = std::move(mesh->indices());
+            positions = std::move(mesh->positions(0));
+            importer.close();
+            return true;
+        })) {
+            Error{} << "Cannot import a mesh with" << triangleCount << "triangles";
+            return false;
+        }
+
+        measure(stages[1], [&]() {
+            indices = MeshTools::duplicate(indices, MeshTools::removeDuplicates(positions));
+            return true;
+        });
+
+        measure(stages[2], [&]() {
+            normals = MeshTools::generateSmoothNormals<UnsignedInt>(Containers::arrayView(indices), Containers::arrayView(positions));
+            return true;
+        });
+
+        measure(stages[3], [&]() {
+            MeshTools::tipsify(indices, positions.size(), 24);
+            return true;
+        });
+
+        measure(stages[4], [&]() {
+            std::tie(indexData, std::ignore, std::ignore, std::ignore) = MeshTools::compressIndices(indices);
+            return true;
+        });
+
+        measure(stages[5], [&]() {
+            vertexData = MeshTools::interleave(positions, Containers::arrayView(normals));
+            return true;
+        });
+    }
+
+    out << "    {\n"
+        << "      \"triangles\": " << triangleCount << ",\n"
+        << "      \"objBytes\": " << obj.size() << ",\n";
+    printStages(out, stages);
+    out << "    }";
+    return true;
+}
+
+bool benchmarkImage(Trade::AbstractImporter& importer, const UnsignedShort size, const UnsignedInt repeats, std::ostream& out) {
+    const Containers::Array<char> tga = generateTga(size);
+    const std::size_t pixelCount = std::size_t(size)*size;
+
+    std::vector<Stage> stages;
+    stages.emplace_back("import", pixelCount);
+    stages.emplace_back("convertRGB8ToRGBA32F", pixelCount);
+
+    for(UnsignedInt repeat = 0; repeat != repeats; ++repeat) {
+        Containers::Optional<Trade::ImageData2D> image;
+        Containers::Array<Color4> converted;
+
+        if(!measure(stages[0], [&]() {
+            if(!importer.openData(tga) || !(image = importer.image2D(0)))
+                return false;
+
+            importer.close();
+            return image->format() == PixelFormat::RGB8Unorm;
+        })) {
+            Error{} << "Cannot import a" << size << Debug::nospace << "x" << Debug::nospace << size << "RGB8 image";
+            return false;
+        }
+
+        measure(stages[1], [&]() {
+            const Containers::StridedArrayView2D<const Color3ub> pixels = image->pixels<Color3ub>();
+            converted = Containers::Array<Color4>{Containers::NoInit, pixelCount};
+            Color4* output = converted.data();
+            for(std::size_t y = 0; y != pixels.size()[0]; ++y)
+                for(std::size_t x = 0; x != pixels.size()[1]; ++x)
+                    *output++ = Color4{Math::unpack<Color3>(pixels[y][x]), 1.0f};
+            return true;
+        });
+    }
+
+    out << "    {\n"
+        << "      \"size\": [" << size << ", " << size << "],\n"
+        << "      \"tgaBytes\": " << tga.size() << ",\n";
+    printStages(out, stages);
+    out << "    }";
+    return true;
+}
+
+}}}}
+
+using namespace Magnum;
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addOption("mesh-sizes", "1000,10000,100000,1000000").setHelp("mesh-sizes", "approximate triangle counts of generated meshes", "N,N,…")
+        .addOption("image-sizes", "256,1024,4096").setHelp("image-sizes", "side lengths of generated square images", "N,N,…")
+        .addOption("repeats", "5").setHelp("repeats", "how many times to run each pipeline", "N")
+        .addOption("output").setHelp("output", "write the JSON output to a file instead of standard output", "FILE")
+        .setGlobalHelp(R"(Benchmarks the OBJ import → removeDuplicates() → generateSmoothNormals() →
+tipsify() → compressIndices() → interleave() mesh pipeline and the TGA import →
+RGB8 to RGBA32F conversion image pipeline on generated datasets of increasing
+size. For every stage the output contains minimal time over all repeats,
+throughput in triangles or pixels per second, peak resident memory during the
+stage and heap usage at the end of the stage minus heap usage at its start in
+JSON. The per-stage peak is available only on Linux, elsewhere the output
+contains a peak of the whole process so far instead. The heap usage change is
+available only with glibc.)")
+        .parse(argc, argv);
+
+    const UnsignedInt repeats = Math::max(args.value<UnsignedInt>("repeats"), 1u);
+
+    /* Load the plugins directly from the build tree */
+    PluginManager::Manager<Trade::AbstractImporter> manager{"nonexistent"};
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    if(!(manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Cannot load the ObjImporter plugin";
+        return 1;
+    }
+    #endif
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    if(!(manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Cannot load the TgaImporter plugin";
+        return 1;
+    }
+    #endif
+    Containers::Pointer<Trade::AbstractImporter> objImporter = manager.instantiate("ObjImporter");
+    Containers::Pointer<Trade::AbstractImporter> tgaImporter = manager.instantiate("TgaImporter");
+
+    std::ostringstream out;
+    out << "{\n"
+        << "  \"repeats\": " << repeats << ",\n"
+        << "  \"meshes\": [\n";
+    {
+        const std::vector<std::string> sizes = Utility::String::splitWithoutEmptyParts(args.value("mesh-sizes"), ',');
+        for(std::size_t i = 0; i != sizes.size(); ++i) {
+            if(!MeshTools::Test::benchmarkMesh(*objImporter, std::stoul(sizes[i]), repeats, out))
+                return 2;
+            out << (i + 1 == sizes.size() ? "\n" : ",\n");
+        }
+    }
+    out << "  ],\n"
+        << "  \"images\": [\n";
+    {
+        const std::vector<std::string> sizes = Utility::String::splitWithoutEmptyParts(args.value("image-sizes"), ',');
+        for(std::size_t i = 0; i != sizes.size(); ++i) {
+            if(!MeshTools::Test::benchmarkImage(*tgaImporter, UnsignedShort(std::stoul(sizes[i])), repeats, out))
+                return 2;
+            out << (i + 1 == sizes.size() ? "\n" : ",\n");
+        }
+    }
+    out << "  ]\n"
+        << "}\n";
+
+    const std::string json = out.str();
+    if(args.value("output").empty())
+        Debug{Debug::Flag::NoNewlineAtTheEnd} << json;
+    else if(!Utility::Directory::write(args.value("output"), Containers::arrayView(json.data(), json.size()))) {
+        Error{} << "Cannot write" << args.value("output");
+        return 3;
+    }
+
+    return 0;
+}
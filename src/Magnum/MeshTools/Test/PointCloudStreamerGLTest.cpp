@@ -0,0 +1,232 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/MeshTools/PointCloudStreamer.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct PointCloudStreamerGLTest: GL::OpenGLTester {
+    explicit PointCloudStreamerGLTest();
+
+    void construct();
+    void constructMove();
+
+    void update();
+    void updateByteBudget();
+    void updateEvict();
+    void updatePointBudgetFull();
+    void draw();
+
+    void isResidentOutOfRange();
+    void updateOutOfRange();
+};
+
+PointCloudStreamerGLTest::PointCloudStreamerGLTest() {
+    addTests({&PointCloudStreamerGLTest::construct,
+              &PointCloudStreamerGLTest::constructMove,
+
+              &PointCloudStreamerGLTest::update,
+              &PointCloudStreamerGLTest::updateByteBudget,
+              &PointCloudStreamerGLTest::updateEvict,
+              &PointCloudStreamerGLTest::updatePointBudgetFull,
+              &PointCloudStreamerGLTest::draw,
+
+              &PointCloudStreamerGLTest::isResidentOutOfRange,
+              &PointCloudStreamerGLTest::updateOutOfRange});
+}
+
+constexpr Vector3 Cube[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 1.0f},
+    {1.0f, 1.0f, 1.0f}
+};
+
+constexpr Color4ub CubeColors[8]{};
+
+/* Eight nodes with one 16-byte point each */
+struct Octree {
+    explicit Octree(): data{buildPointCloudOctree(Cube, CubeColors, 1)}, octree{*PointCloudOctree::open(data)} {}
+
+    Containers::Array<char> data;
+    PointCloudOctree octree;
+};
+
+void PointCloudStreamerGLTest::construct() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+    CORRADE_COMPARE(streamer.pointBudget(), 100);
+    CORRADE_COMPARE(streamer.residentPointCount(), 0);
+    CORRADE_COMPARE(streamer.residentNodeCount(), 0);
+    CORRADE_VERIFY(!streamer.isResident(0));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PointCloudStreamerGLTest::constructMove() {
+    Octree octree;
+    PointCloudStreamer a{octree.octree, 100};
+    const UnsignedInt selection[]{0, 1};
+    a.update(selection, 1000);
+
+    PointCloudStreamer b{std::move(a)};
+    CORRADE_COMPARE(b.residentNodeCount(), 2);
+
+    PointCloudStreamer c{octree.octree, 5};
+    c = std::move(b);
+    CORRADE_COMPARE(c.pointBudget(), 100);
+    CORRADE_COMPARE(c.residentNodeCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PointCloudStreamerGLTest::update() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+
+    const UnsignedInt selection[]{0, 7, 6, 5, 4, 3, 2, 1};
+    CORRADE_COMPARE(streamer.update(selection, 1000), 8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.residentPointCount(), 8);
+    CORRADE_COMPARE(streamer.residentNodeCount(), 8);
+    for(UnsignedInt i = 0; i != 8; ++i)
+        CORRADE_VERIFY(streamer.isResident(i));
+
+    /* Nothing more to upload */
+    CORRADE_COMPARE(streamer.update(selection, 1000), 0);
+    CORRADE_COMPARE(streamer.residentNodeCount(), 8);
+}
+
+void PointCloudStreamerGLTest::updateByteBudget() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+
+    /* Two nodes fit into the budget */
+    const UnsignedInt selection[]{0, 7, 6, 5, 4};
+    CORRADE_COMPARE(streamer.update(selection, 32), 2);
+    CORRADE_VERIFY(streamer.isResident(0));
+    CORRADE_VERIFY(streamer.isResident(7));
+    CORRADE_VERIFY(!streamer.isResident(6));
+
+    /* At least one node gets uploaded even with zero budget */
+    CORRADE_COMPARE(streamer.update(selection, 0), 1);
+    CORRADE_VERIFY(streamer.isResident(6));
+    CORRADE_VERIFY(!streamer.isResident(5));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PointCloudStreamerGLTest::updateEvict() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 4};
+
+    const UnsignedInt first[]{0, 1, 2, 3};
+    CORRADE_COMPARE(streamer.update(first, 1000), 4);
+    const UnsignedInt second[]{0, 1, 4, 5};
+    CORRADE_COMPARE(streamer.update(second, 1000), 2);
+    const UnsignedInt third[]{0, 6};
+    CORRADE_COMPARE(streamer.update(third, 1000), 1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Nodes 2 and 3 got evicted in the second update, one of 1, 4 and 5 in
+       the third */
+    CORRADE_COMPARE(streamer.residentPointCount(), 4);
+    CORRADE_VERIFY(streamer.isResident(0));
+    CORRADE_VERIFY(!streamer.isResident(2));
+    CORRADE_VERIFY(!streamer.isResident(3));
+    CORRADE_VERIFY(streamer.isResident(6));
+}
+
+void PointCloudStreamerGLTest::updatePointBudgetFull() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 2};
+
+    /* Everything resident is selected, so nothing can be evicted */
+    const UnsignedInt selection[]{0, 7, 6};
+    CORRADE_COMPARE(streamer.update(selection, 1000), 2);
+    CORRADE_COMPARE(streamer.residentPointCount(), 2);
+    CORRADE_VERIFY(!streamer.isResident(6));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PointCloudStreamerGLTest::draw() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+    Shaders::VertexColor3D shader;
+
+    /* Nothing selected yet */
+    CORRADE_COMPARE(streamer.draw(shader), 0);
+
+    const UnsignedInt selection[]{0, 7, 6};
+    streamer.update(selection, 16);
+    CORRADE_COMPARE(streamer.draw(shader), 1);
+    streamer.update(selection, 1000);
+    CORRADE_COMPARE(streamer.draw(shader), 3);
+
+    /* Only nodes from the last selection are drawn */
+    const UnsignedInt less[]{0, 6};
+    streamer.update(less, 1000);
+    CORRADE_COMPARE(streamer.residentNodeCount(), 3);
+    CORRADE_COMPARE(streamer.draw(shader), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PointCloudStreamerGLTest::isResidentOutOfRange() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.isResident(8);
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudStreamer::isResident(): index 8 out of range for 8 nodes\n");
+}
+
+void PointCloudStreamerGLTest::updateOutOfRange() {
+    Octree octree;
+    PointCloudStreamer streamer{octree.octree, 100};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const UnsignedInt selection[]{0, 8};
+    streamer.update(selection, 1000);
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudStreamer::update(): index 8 out of range for 8 nodes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::PointCloudStreamerGLTest)
@@ -0,0 +1,475 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/PointCloud.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct PointCloudTest: TestSuite::Tester {
+    explicit PointCloudTest();
+
+    void buildEmpty();
+    void buildSingleNode();
+    void buildSubsampled();
+    void buildMaxDepth();
+    void buildLarge();
+    void buildWrongColorCount();
+    void buildZeroNodePointCount();
+
+    void openTooShort();
+    void openInvalidSignature();
+    void openUnsupportedVersion();
+    void openTruncated();
+    void openPointsOutOfBounds();
+    void openChildrenOutOfRange();
+    void openNotAligned();
+
+    void pointsOutOfRange();
+
+    void select();
+    void selectPointBudget();
+    void selectMinPointSpacing();
+    void selectOutsideOfFrustum();
+    void selectOrthographic();
+    void selectEmpty();
+
+    void benchmarkBuild();
+    void benchmarkSelect();
+};
+
+PointCloudTest::PointCloudTest() {
+    addTests({&PointCloudTest::buildEmpty,
+              &PointCloudTest::buildSingleNode,
+              &PointCloudTest::buildSubsampled,
+              &PointCloudTest::buildMaxDepth,
+              &PointCloudTest::buildLarge,
+              &PointCloudTest::buildWrongColorCount,
+              &PointCloudTest::buildZeroNodePointCount,
+
+              &PointCloudTest::openTooShort,
+              &PointCloudTest::openInvalidSignature,
+              &PointCloudTest::openUnsupportedVersion,
+              &PointCloudTest::openTruncated,
+              &PointCloudTest::openPointsOutOfBounds,
+              &PointCloudTest::openChildrenOutOfRange,
+              &PointCloudTest::openNotAligned,
+
+              &PointCloudTest::pointsOutOfRange,
+
+              &PointCloudTest::select,
+              &PointCloudTest::selectPointBudget,
+              &PointCloudTest::selectMinPointSpacing,
+              &PointCloudTest::selectOutsideOfFrustum,
+              &PointCloudTest::selectOrthographic,
+              &PointCloudTest::selectEmpty});
+
+    addBenchmarks({&PointCloudTest::benchmarkBuild,
+                   &PointCloudTest::benchmarkSelect}, 5);
+}
+
+using namespace Math::Literals;
+
+/* Corners of a unit cube, in Morton order */
+constexpr Vector3 Cube[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 1.0f},
+    {1.0f, 1.0f, 1.0f}
+};
+
+constexpr Color4ub CubeColors[]{
+    0xff000000_rgba, 0x00ff0000_rgba, 0x0000ff00_rgba, 0x000000ff_rgba,
+    0xffff0000_rgba, 0x00ffff00_rgba, 0x0000ffff_rgba, 0xffffffff_rgba
+};
+
+/* Offset of the node array in the data */
+constexpr std::size_t NodeOffset = 24;
+
+/* A 64x64x4 block of points in a shuffled order */
+void block(Containers::Array<Vector3>& positions, Containers::Array<Color4ub>& colors) {
+    positions = Containers::Array<Vector3>{Containers::NoInit, 64*64*4};
+    colors = Containers::Array<Color4ub>{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const std::size_t j = (i*7919) % positions.size();
+        positions[i] = {Float(j % 64)*0.1f, Float(j/64 % 64)*0.1f, Float(j/4096)*0.3f};
+        colors[i] = {UnsignedByte(j), UnsignedByte(j >> 8), 0, 255};
+    }
+}
+
+/* Camera at (0.5, 0.5, 5) looking in the -Z direction */
+const Matrix4 Transformation = Matrix4::translation({-0.5f, -0.5f, -5.0f});
+const Matrix4 Projection = Matrix4::perspectiveProjection(35.0_degf, 1.0f, 0.01f, 100.0f);
+
+void PointCloudTest::buildEmpty() {
+    Containers::Array<char> data = buildPointCloudOctree(Containers::StridedArrayView1D<const Vector3>{}, Containers::StridedArrayView1D<const Color4ub>{});
+    CORRADE_COMPARE(data.size(), NodeOffset);
+
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+    CORRADE_COMPARE(octree->nodeCount(), 0);
+    CORRADE_COMPARE(octree->pointCount(), 0);
+    CORRADE_COMPARE(octree->bounds(), Range3D{});
+}
+
+void PointCloudTest::buildSingleNode() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 8);
+
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+    CORRADE_COMPARE(octree->nodeCount(), 1);
+    CORRADE_COMPARE(octree->pointCount(), 8);
+    CORRADE_COMPARE(octree->bounds(), (Range3D{{}, Vector3{1.0f}}));
+
+    const PointCloudNode& node = octree->nodes()[0];
+    CORRADE_COMPARE(node.spacing, 1.0f/128.0f);
+    CORRADE_COMPARE(node.pointCount, 8);
+    CORRADE_COMPARE(node.pointOffset, 0);
+    CORRADE_COMPARE(node.childCount, 0);
+
+    /* The points are already in the Morton order so they stay the same */
+    Containers::ArrayView<const PointCloudPoint> points = octree->points(0);
+    CORRADE_COMPARE(points.size(), 8);
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        CORRADE_COMPARE(points[i].position, Cube[i]);
+        CORRADE_COMPARE(points[i].color, CubeColors[i]);
+    }
+}
+
+void PointCloudTest::buildSubsampled() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+
+    /* The root gets the first point, the rest is distributed among the
+       other seven octants */
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+    CORRADE_COMPARE(octree->nodeCount(), 8);
+    CORRADE_COMPARE(octree->pointCount(), 8);
+
+    const PointCloudNode& root = octree->nodes()[0];
+    CORRADE_COMPARE(root.bounds, (Range3D{{}, Vector3{1.0f}}));
+    CORRADE_COMPARE(root.spacing, 1.0f);
+    CORRADE_COMPARE(root.pointCount, 1);
+    CORRADE_COMPARE(root.firstChild, 1);
+    CORRADE_COMPARE(root.childCount, 7);
+    CORRADE_COMPARE(octree->points(0)[0].position, Cube[0]);
+    CORRADE_COMPARE(octree->points(0)[0].color, CubeColors[0]);
+
+    for(UnsignedInt i = 1; i != 8; ++i) {
+        const PointCloudNode& node = octree->nodes()[i];
+        CORRADE_COMPARE(node.bounds, Range3D::fromSize(Cube[i]*0.5f, Vector3{0.5f}));
+        CORRADE_COMPARE(node.spacing, 0.5f/128.0f);
+        CORRADE_COMPARE(node.pointCount, 1);
+        CORRADE_COMPARE(node.pointOffset, i);
+        CORRADE_COMPARE(node.childCount, 0);
+        CORRADE_COMPARE(octree->points(i)[0].position, Cube[i]);
+        CORRADE_COMPARE(octree->points(i)[0].color, CubeColors[i]);
+    }
+}
+
+void PointCloudTest::buildMaxDepth() {
+    /* Coincident points can't be subdivided, so each level takes just one
+       and the last level takes all that's left */
+    Containers::Array<Vector3> positions{Containers::DirectInit, 100, 1.0f, 2.0f, 3.0f};
+    Containers::Array<Color4ub> colors{Containers::ValueInit, 100};
+    Containers::Array<char> data = buildPointCloudOctree(positions, colors, 10, 3);
+
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+    CORRADE_COMPARE(octree->nodeCount(), 4);
+    CORRADE_COMPARE(octree->nodes()[0].pointCount, 1);
+    CORRADE_COMPARE(octree->nodes()[1].pointCount, 1);
+    CORRADE_COMPARE(octree->nodes()[2].pointCount, 1);
+    CORRADE_COMPARE(octree->nodes()[3].pointCount, 97);
+    CORRADE_COMPARE(octree->nodes()[3].childCount, 0);
+}
+
+void PointCloudTest::buildLarge() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<Color4ub> colors;
+    block(positions, colors);
+
+    Containers::Array<char> data = buildPointCloudOctree(positions, colors, 1000);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+    CORRADE_COMPARE(octree->pointCount(), positions.size());
+    CORRADE_COMPARE_AS(octree->nodeCount(), std::size_t{1},
+        TestSuite::Compare::Greater);
+
+    /* Every point is in exactly one node and inside its bounds, every node
+       is within the limit and its children are inside it */
+    Containers::Array<UnsignedInt> found{Containers::ValueInit, positions.size()};
+    const Containers::ArrayView<const PointCloudNode> nodes = octree->nodes();
+    for(UnsignedInt i = 0; i != nodes.size(); ++i) {
+        const PointCloudNode& node = nodes[i];
+        CORRADE_COMPARE_AS(node.pointCount, 1000u,
+            TestSuite::Compare::LessOrEqual);
+        const Range3D bounds = node.bounds.padded(Vector3{0.0001f});
+        for(const PointCloudPoint& point: octree->points(i)) {
+            CORRADE_VERIFY(bounds.contains(point.position));
+            /* The color encodes the original position */
+            const std::size_t j = point.color.r() | point.color.g() << 8;
+            CORRADE_COMPARE(point.position, (Vector3{Float(j % 64)*0.1f, Float(j/64 % 64)*0.1f, Float(j/4096)*0.3f}));
+            ++found[j];
+        }
+        for(UnsignedInt j = node.firstChild; j != node.firstChild + node.childCount; ++j) {
+            CORRADE_COMPARE_AS(j, i, TestSuite::Compare::Greater);
+            CORRADE_VERIFY(bounds.contains(nodes[j].bounds));
+            CORRADE_COMPARE(nodes[j].bounds.size(), node.bounds.size()*0.5f);
+        }
+    }
+    for(std::size_t i = 0; i != found.size(); ++i)
+        CORRADE_COMPARE(found[i], 1);
+}
+
+void PointCloudTest::buildWrongColorCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    buildPointCloudOctree(Cube, Containers::arrayView(CubeColors).prefix(7));
+    CORRADE_COMPARE(out.str(), "MeshTools::buildPointCloudOctree(): expected the same number of positions and colors but got 8 and 7\n");
+}
+
+void PointCloudTest::buildZeroNodePointCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    buildPointCloudOctree(Cube, CubeColors, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::buildPointCloudOctree(): expected a non-zero node point count\n");
+}
+
+void PointCloudTest::openTooShort() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(data.prefix(23)));
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::open(): expected at least 24 bytes but got 23\n");
+}
+
+void PointCloudTest::openInvalidSignature() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+    data[3] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::open(): invalid signature\n");
+}
+
+void PointCloudTest::openUnsupportedVersion() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+    const UnsignedInt version = 2;
+    std::memcpy(data + 4, &version, 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::open(): unsupported version 2\n");
+}
+
+void PointCloudTest::openTruncated() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+    CORRADE_COMPARE(data.size(), 24 + 48 + 8*16);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(data.prefix(data.size() - 1)));
+    CORRADE_VERIFY(!PointCloudOctree::open(data.prefix(24 + 47)));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::PointCloudOctree::open(): expected 1 nodes and 8 points but got only 199 bytes\n"
+        "MeshTools::PointCloudOctree::open(): expected 1 nodes and 8 points but got only 71 bytes\n");
+}
+
+void PointCloudTest::openPointsOutOfBounds() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    reinterpret_cast<PointCloudNode*>(data + NodeOffset)[5].pointCount = 4;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::open(): points 5:9 of node 5 out of bounds for 8 points\n");
+}
+
+void PointCloudTest::openChildrenOutOfRange() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    PointCloudNode* nodes = reinterpret_cast<PointCloudNode*>(data + NodeOffset);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    nodes[0].childCount = 8;
+    CORRADE_VERIFY(!PointCloudOctree::open(data));
+    /* A cycle */
+    nodes[0].childCount = 7;
+    nodes[3].firstChild = 2;
+    nodes[3].childCount = 1;
+    CORRADE_VERIFY(!PointCloudOctree::open(data));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::PointCloudOctree::open(): children 1:9 of node 0 out of range for 8 nodes\n"
+        "MeshTools::PointCloudOctree::open(): children 2:3 of node 3 out of range for 8 nodes\n");
+}
+
+void PointCloudTest::openNotAligned() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+    Containers::Array<char> shifted{Containers::ValueInit, data.size() + 1};
+    std::memcpy(shifted + 1, data, data.size());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!PointCloudOctree::open(shifted.suffix(1)));
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::open(): data not aligned to 8 bytes\n");
+}
+
+void PointCloudTest::pointsOutOfRange() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    octree->points(1);
+    CORRADE_COMPARE(out.str(), "MeshTools::PointCloudOctree::points(): index 1 out of range for 1 nodes\n");
+}
+
+void PointCloudTest::select() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    /* Root first, then the rest. The four nodes closer to the camera are
+       equally important and they come before the rest, ties are broken by
+       the larger ID. */
+    Containers::Array<UnsignedInt> selected = selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 100, 0.0f);
+    const UnsignedInt expected[]{0, 7, 6, 5, 4, 3, 2, 1};
+    CORRADE_COMPARE_AS(selected, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PointCloudTest::selectPointBudget() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    Containers::Array<UnsignedInt> selected = selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 4, 0.0f);
+    const UnsignedInt expected[]{0, 7, 6, 5};
+    CORRADE_COMPARE_AS(selected, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* Not even the root fits */
+    CORRADE_VERIFY(selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 0).empty());
+}
+
+void PointCloudTest::selectMinPointSpacing() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    /* The root spacing is 1 at a distance of 4 units, which is about 39.6
+       pixels on a 100 pixel high viewport. If that's enough, no children
+       are selected. */
+    const Float spacing = Projection[1][1]*100.0f*0.5f/4.0f;
+    CORRADE_COMPARE(selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 100, spacing*1.01f).size(), 1);
+    CORRADE_COMPARE(selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 100, spacing*0.99f).size(), 8);
+}
+
+void PointCloudTest::selectOutsideOfFrustum() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    /* Camera behind the cube, looking away from it */
+    CORRADE_VERIFY(selectPointCloudNodes(*octree, Matrix4::translation({-0.5f, -0.5f, 5.0f}), Projection, 100.0f, 100, 0.0f).empty());
+
+    /* A narrow view on the lower left quarter, only the root and the front
+       lower left child are visible */
+    Containers::Array<UnsignedInt> selected = selectPointCloudNodes(*octree, Matrix4::translation({-0.25f, -0.25f, -5.0f}), Matrix4::perspectiveProjection(4.0_degf, 1.0f, 0.01f, 100.0f), 100.0f, 100, 0.0f);
+    const UnsignedInt expected[]{0, 4};
+    CORRADE_COMPARE_AS(selected, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PointCloudTest::selectOrthographic() {
+    Containers::Array<char> data = buildPointCloudOctree(Cube, CubeColors, 1);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    /* The distance doesn't matter, root spacing is 50 pixels */
+    const Matrix4 projection = Matrix4::orthographicProjection({2.0f, 2.0f}, 0.01f, 100.0f);
+    CORRADE_COMPARE(selectPointCloudNodes(*octree, Transformation, projection, 100.0f, 100, 50.5f).size(), 1);
+    CORRADE_COMPARE(selectPointCloudNodes(*octree, Matrix4::translation({-0.5f, -0.5f, -50.0f}), projection, 100.0f, 100, 49.5f).size(), 8);
+}
+
+void PointCloudTest::selectEmpty() {
+    Containers::Array<char> data = buildPointCloudOctree(Containers::StridedArrayView1D<const Vector3>{}, Containers::StridedArrayView1D<const Color4ub>{});
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    CORRADE_VERIFY(selectPointCloudNodes(*octree, Transformation, Projection, 100.0f, 100).empty());
+}
+
+void PointCloudTest::benchmarkBuild() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<Color4ub> colors;
+    block(positions, colors);
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1)
+        size += buildPointCloudOctree(positions, colors, 1000).size();
+
+    CORRADE_COMPARE_AS(size, std::size_t{0}, TestSuite::Compare::Greater);
+}
+
+void PointCloudTest::benchmarkSelect() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<Color4ub> colors;
+    block(positions, colors);
+    Containers::Array<char> data = buildPointCloudOctree(positions, colors, 100);
+    Containers::Optional<PointCloudOctree> octree = PointCloudOctree::open(data);
+    CORRADE_VERIFY(octree);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(100)
+        count += selectPointCloudNodes(*octree, Matrix4::translation({-3.2f, -3.2f, -10.0f}), Projection, 1080.0f, 10000).size();
+
+    CORRADE_COMPARE_AS(count, std::size_t{0}, TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::PointCloudTest)
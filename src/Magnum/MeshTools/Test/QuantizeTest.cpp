@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/Quantize.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void positions();
+    void positionsFlat();
+    void positionsEmpty();
+    void positionsWrongSize();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::positions,
+              &QuantizeTest::positionsFlat,
+              &QuantizeTest::positionsEmpty,
+              &QuantizeTest::positionsWrongSize});
+}
+
+void QuantizeTest::positions() {
+    const Vector3 positions[]{
+        {-1.0f, 2.0f, 0.5f},
+        { 3.0f, 2.5f, 0.0f},
+        { 1.0f, 4.0f, 1.0f}
+    };
+    Vector3us quantized[3];
+    Matrix4 dequantization = quantizePositionsInto(positions, quantized);
+
+    CORRADE_COMPARE_AS(Containers::arrayView<const Vector3us>(quantized),
+        (Containers::Array<Vector3us>{Containers::InPlaceInit, {
+            {0, 0, 32768},
+            {65535, 16384, 0},
+            {32768, 65535, 65535}
+        }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(dequantization, Matrix4::translation({-1.0f, 2.0f, 0.0f})*Matrix4::scaling({4.0f, 2.0f, 1.0f}));
+
+    /* Dequantizing should give back the original data, up to the precision */
+    for(std::size_t i = 0; i != 3; ++i) {
+        const Vector3 dequantized = dequantization.transformPoint(Math::unpack<Vector3>(quantized[i]));
+        CORRADE_COMPARE_AS(Math::abs(dequantized - positions[i]).max(), 0.0001f,
+            TestSuite::Compare::Less);
+    }
+}
+
+void QuantizeTest::positionsFlat() {
+    const Vector3 positions[]{
+        {-1.0f, 2.0f, 0.5f},
+        { 3.0f, 2.0f, 0.5f}
+    };
+    Vector3us quantized[2];
+    Matrix4 dequantization = quantizePositionsInto(positions, quantized);
+
+    /* The zero-sized dimensions get a unit scale */
+    CORRADE_COMPARE(quantized[0], (Vector3us{0, 0, 0}));
+    CORRADE_COMPARE(quantized[1], (Vector3us{65535, 0, 0}));
+    CORRADE_COMPARE(dequantization, Matrix4::translation({-1.0f, 2.0f, 0.5f})*Matrix4::scaling({4.0f, 1.0f, 1.0f}));
+}
+
+void QuantizeTest::positionsEmpty() {
+    CORRADE_COMPARE(quantizePositionsInto(nullptr, nullptr), Matrix4{});
+}
+
+void QuantizeTest::positionsWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const Vector3 positions[3]{};
+    Vector3us quantized[2];
+    quantizePositionsInto(positions, quantized);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantizePositionsInto(): bad output size, expected 3 but got 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
@@ -0,0 +1,291 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/SplitIndices.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SplitIndicesTest: TestSuite::Tester {
+    explicit SplitIndicesTest();
+
+    void noSplit();
+    void split();
+    void splitStrip();
+    void splitLarge();
+    void empty();
+
+    void wrongIndexCount();
+    void maxVertexCountTooSmall();
+    void indexOutOfBounds();
+
+    void benchmark();
+};
+
+SplitIndicesTest::SplitIndicesTest() {
+    addTests({&SplitIndicesTest::noSplit,
+              &SplitIndicesTest::split,
+              &SplitIndicesTest::splitStrip,
+              &SplitIndicesTest::splitLarge,
+              &SplitIndicesTest::empty,
+
+              &SplitIndicesTest::wrongIndexCount,
+              &SplitIndicesTest::maxVertexCountTooSmall,
+              &SplitIndicesTest::indexOutOfBounds});
+
+    addBenchmarks({&SplitIndicesTest::benchmark}, 10);
+}
+
+constexpr Vector3 QuadPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f}
+};
+
+constexpr UnsignedInt QuadIndices[]{0, 1, 2, 2, 1, 3};
+
+/* Vertices 0 to 4 on the bottom row, 5 to 9 on the top row */
+constexpr Vector3 StripPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {2.0f, 0.0f, 0.0f},
+    {3.0f, 0.0f, 0.0f},
+    {4.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {2.0f, 1.0f, 0.0f},
+    {3.0f, 1.0f, 0.0f},
+    {4.0f, 1.0f, 0.0f}
+};
+
+constexpr UnsignedInt StripIndices[]{
+    0, 1, 5, 5, 1, 6,
+    1, 2, 6, 6, 2, 7,
+    2, 3, 7, 7, 3, 8,
+    3, 4, 8, 8, 4, 9
+};
+
+/* A quad grid with (size + 1)^2 vertices */
+void grid(const UnsignedInt size, Containers::Array<Vector3>& positions, Containers::Array<UnsignedInt>& indices) {
+    positions = Containers::Array<Vector3>{Containers::NoInit, (size + 1)*(size + 1)};
+    for(UnsignedInt y = 0; y <= size; ++y)
+        for(UnsignedInt x = 0; x <= size; ++x)
+            positions[y*(size + 1) + x] = {Float(x), Float(y), 0.0f};
+
+    indices = Containers::Array<UnsignedInt>{Containers::NoInit, size*size*6};
+    std::size_t i = 0;
+    for(UnsignedInt y = 0; y != size; ++y) {
+        for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt a = y*(size + 1) + x;
+            const UnsignedInt b = a + size + 1;
+            indices[i++] = a;
+            indices[i++] = a + 1;
+            indices[i++] = b;
+            indices[i++] = b;
+            indices[i++] = a + 1;
+            indices[i++] = b + 1;
+        }
+    }
+}
+
+void SplitIndicesTest::noSplit() {
+    IndexSplit split = splitIndices(QuadIndices, QuadPositions, 4);
+
+    const UnsignedInt expectedIndices[]{0, 1, 2, 2, 1, 3};
+    const UnsignedInt expectedMapping[]{0, 1, 2, 3};
+    CORRADE_COMPARE_AS(split.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(split.vertexMapping, Containers::arrayView(expectedMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(split.chunks.size(), 1);
+    CORRADE_COMPARE(split.chunks[0].indexOffset, 0);
+    CORRADE_COMPARE(split.chunks[0].indexCount, 6);
+    CORRADE_COMPARE(split.chunks[0].vertexOffset, 0);
+    CORRADE_COMPARE(split.chunks[0].vertexCount, 4);
+    CORRADE_COMPARE(split.vertexCount, 4);
+    CORRADE_COMPARE(split.originalIndexDataSize, 6);
+    CORRADE_COMPARE(split.indexDataSize, 6);
+    CORRADE_COMPARE(split.memorySaved(12), 0);
+}
+
+void SplitIndicesTest::split() {
+    IndexSplit split = splitIndices(QuadIndices, QuadPositions, 3);
+
+    /* Each triangle in its own chunk, the diagonal vertices duplicated */
+    const UnsignedInt expectedIndices[]{0, 1, 2, 0, 1, 2};
+    const UnsignedInt expectedMapping[]{0, 1, 2, 2, 1, 3};
+    CORRADE_COMPARE_AS(split.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(split.vertexMapping, Containers::arrayView(expectedMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(split.chunks.size(), 2);
+    CORRADE_COMPARE(split.chunks[0].indexOffset, 0);
+    CORRADE_COMPARE(split.chunks[0].indexCount, 3);
+    CORRADE_COMPARE(split.chunks[0].vertexOffset, 0);
+    CORRADE_COMPARE(split.chunks[0].vertexCount, 3);
+    CORRADE_COMPARE(split.chunks[1].indexOffset, 3);
+    CORRADE_COMPARE(split.chunks[1].indexCount, 3);
+    CORRADE_COMPARE(split.chunks[1].vertexOffset, 3);
+    CORRADE_COMPARE(split.chunks[1].vertexCount, 3);
+    CORRADE_COMPARE(split.vertexCount, 4);
+    CORRADE_COMPARE(split.memorySaved(12), -24);
+}
+
+void SplitIndicesTest::splitStrip() {
+    IndexSplit split = splitIndices(StripIndices, StripPositions, 6);
+
+    /* The curve goes through the left half first, the middle column of
+       vertices is shared by both chunks */
+    const UnsignedInt expectedIndices[]{
+        0, 1, 2, 2, 1, 3, 1, 4, 3, 3, 4, 5,
+        0, 1, 2, 2, 1, 3, 1, 4, 3, 3, 4, 5
+    };
+    const UnsignedInt expectedMapping[]{
+        0, 1, 5, 6, 2, 7,
+        2, 3, 7, 8, 4, 9
+    };
+    CORRADE_COMPARE_AS(split.indices, Containers::arrayView(expectedIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(split.vertexMapping, Containers::arrayView(expectedMapping),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(split.chunks.size(), 2);
+    CORRADE_COMPARE(split.chunks[0].indexCount, 12);
+    CORRADE_COMPARE(split.chunks[0].vertexCount, 6);
+    CORRADE_COMPARE(split.chunks[1].indexOffset, 12);
+    CORRADE_COMPARE(split.chunks[1].indexCount, 12);
+    CORRADE_COMPARE(split.chunks[1].vertexOffset, 6);
+    CORRADE_COMPARE(split.chunks[1].vertexCount, 6);
+    CORRADE_COMPARE(split.vertexCount, 10);
+}
+
+void SplitIndicesTest::splitLarge() {
+    /* 90601 vertices, needs 32-bit indices */
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(300, positions, indices);
+
+    IndexSplit split = splitIndices(indices, positions);
+    CORRADE_COMPARE_AS(split.chunks.size(), std::size_t{1},
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(split.vertexCount, positions.size());
+    CORRADE_COMPARE(split.originalIndexDataSize, indices.size()*4);
+    CORRADE_COMPARE(split.indexDataSize, indices.size()*2);
+    CORRADE_COMPARE_AS(split.memorySaved(sizeof(Vector3)), Long{0},
+        TestSuite::Compare::Greater);
+
+    /* All chunks fit into 16 bits and together reference the original
+       triangles, each exactly once */
+    Containers::Array<UnsignedInt> triangleCount{Containers::ValueInit, indices.size()/3};
+    std::size_t indexCount = 0;
+    for(const IndexSplit::Chunk& chunk: split.chunks) {
+        CORRADE_COMPARE_AS(chunk.vertexCount, 65536u,
+            TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE(chunk.indexOffset, indexCount);
+        indexCount += chunk.indexCount;
+
+        for(std::size_t i = 0; i != chunk.indexCount; i += 3) {
+            UnsignedInt original[3];
+            for(std::size_t j = 0; j != 3; ++j) {
+                const UnsignedInt index = split.indices[chunk.indexOffset + i + j];
+                CORRADE_COMPARE_AS(index, chunk.vertexCount,
+                    TestSuite::Compare::Less);
+                original[j] = split.vertexMapping[chunk.vertexOffset + index];
+            }
+
+            /* The second index of each grid triangle is right of the
+               quad origin, the first one is either the origin or above it */
+            const UnsignedInt size = 300;
+            const UnsignedInt quad = original[1] - 1;
+            const UnsignedInt second = original[0] != quad;
+            const UnsignedInt triangle = ((quad/(size + 1))*size + quad % (size + 1))*2 + second;
+            CORRADE_COMPARE(indices[triangle*3 + 0], original[0]);
+            CORRADE_COMPARE(indices[triangle*3 + 1], original[1]);
+            CORRADE_COMPARE(indices[triangle*3 + 2], original[2]);
+            ++triangleCount[triangle];
+        }
+    }
+    CORRADE_COMPARE(indexCount, indices.size());
+    for(UnsignedInt count: triangleCount) CORRADE_COMPARE(count, 1);
+}
+
+void SplitIndicesTest::empty() {
+    IndexSplit split = splitIndices(Containers::StridedArrayView1D<const UnsignedInt>{}, Containers::StridedArrayView1D<const Vector3>{});
+    CORRADE_VERIFY(split.indices.empty());
+    CORRADE_VERIFY(split.vertexMapping.empty());
+    CORRADE_VERIFY(split.chunks.empty());
+    CORRADE_COMPARE(split.vertexCount, 0);
+    CORRADE_COMPARE(split.originalIndexDataSize, 0);
+    CORRADE_COMPARE(split.indexDataSize, 0);
+}
+
+void SplitIndicesTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    splitIndices(Containers::arrayView(QuadIndices).prefix(5), QuadPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::splitIndices(): index count not divisible by 3\n");
+}
+
+void SplitIndicesTest::maxVertexCountTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    splitIndices(QuadIndices, QuadPositions, 2);
+    CORRADE_COMPARE(out.str(), "MeshTools::splitIndices(): expected max vertex count to be at least 3 but got 2\n");
+}
+
+void SplitIndicesTest::indexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1, 4};
+    splitIndices(indices, QuadPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::splitIndices(): index 4 out of bounds for 4 vertices\n");
+}
+
+void SplitIndicesTest::benchmark() {
+    Containers::Array<Vector3> positions;
+    Containers::Array<UnsignedInt> indices;
+    grid(300, positions, indices);
+
+    std::size_t chunkCount = 0;
+    CORRADE_BENCHMARK(1)
+        chunkCount += splitIndices(indices, positions).chunks.size();
+
+    CORRADE_COMPARE_AS(chunkCount, std::size_t{1}, TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SplitIndicesTest)
@@ -0,0 +1,110 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <deque>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/MeshTools/Stripify.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct StripifyBenchmark: TestSuite::Tester {
+    explicit StripifyBenchmark();
+
+    void stripify();
+};
+
+const struct {
+    const char* name;
+    Trade::MeshData3D(*mesh)();
+    StripJoin join;
+    std::size_t window;
+} Data[]{
+    {"icosphere, primitive restart", []() { return Primitives::icosphereSolid(5); }, StripJoin::PrimitiveRestart, 16},
+    {"icosphere, degenerate triangles", []() { return Primitives::icosphereSolid(5); }, StripJoin::DegenerateTriangles, 16},
+    {"icosphere, primitive restart, unlimited window", []() { return Primitives::icosphereSolid(5); }, StripJoin::PrimitiveRestart, ~std::size_t{}},
+    {"UV sphere, primitive restart", []() { return Primitives::uvSphereSolid(128, 256); }, StripJoin::PrimitiveRestart, 16},
+    {"grid, primitive restart", []() { return Primitives::grid3DSolid({255, 255}); }, StripJoin::PrimitiveRestart, 16},
+    {"grid, degenerate triangles", []() { return Primitives::grid3DSolid({255, 255}); }, StripJoin::DegenerateTriangles, 16},
+    {"grid, primitive restart, unlimited window", []() { return Primitives::grid3DSolid({255, 255}); }, StripJoin::PrimitiveRestart, ~std::size_t{}}
+};
+
+StripifyBenchmark::StripifyBenchmark() {
+    addInstancedBenchmarks({&StripifyBenchmark::stripify}, 10,
+        Containers::arraySize(Data));
+}
+
+/* Average cache miss ratio -- how many vertices get transformed per triangle
+   with a FIFO post-transform vertex cache of given size */
+Float acmr(const Containers::ArrayView<const UnsignedInt> indices, const std::size_t triangleCount) {
+    std::deque<UnsignedInt> cache;
+    std::size_t misses = 0;
+    for(const UnsignedInt index: indices) {
+        if(index == 0xffffffffu || std::find(cache.begin(), cache.end(), index) != cache.end()) continue;
+
+        ++misses;
+        cache.push_back(index);
+        if(cache.size() > 16) cache.pop_front();
+    }
+
+    return Float(misses)/triangleCount;
+}
+
+void StripifyBenchmark::stripify() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D mesh = data.mesh();
+    std::vector<UnsignedInt>& indices = mesh.indices();
+    const std::size_t triangleCount = indices.size()/3;
+    const Float originalAcmr = acmr(indices, triangleCount);
+    tipsify(indices, mesh.positions(0).size(), 24);
+
+    Containers::Array<UnsignedInt> strips;
+    CORRADE_BENCHMARK(1)
+        strips = MeshTools::stripify<UnsignedInt>(Containers::stridedArrayView(indices), data.join, data.window);
+
+    /* Tipsifying has to improve the vertex cache use and the strips need to
+       be smaller than the triangle list they came from. Strip correctness is
+       verified in StripifyTest already. */
+    CORRADE_COMPARE_AS(acmr(indices, triangleCount), originalAcmr,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(strips.size(), indices.size(),
+        TestSuite::Compare::Less);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StripifyBenchmark)
@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Stripify.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct StripifyTest: TestSuite::Tester {
+    explicit StripifyTest();
+
+    template<class T> void primitiveRestart();
+    void degenerateTriangles();
+    void empty();
+    void icosphere();
+    void wrongIndexCount();
+    void restartIndexCollision();
+};
+
+const struct {
+    const char* name;
+    StripJoin join;
+} IcosphereData[]{
+    {"primitive restart", StripJoin::PrimitiveRestart},
+    {"degenerate triangles", StripJoin::DegenerateTriangles}
+};
+
+StripifyTest::StripifyTest() {
+    addTests({&StripifyTest::primitiveRestart<UnsignedByte>,
+              &StripifyTest::primitiveRestart<UnsignedShort>,
+              &StripifyTest::primitiveRestart<UnsignedInt>,
+              &StripifyTest::degenerateTriangles,
+              &StripifyTest::empty});
+
+    addInstancedTests({&StripifyTest::icosphere},
+        Containers::arraySize(IcosphereData));
+
+    addTests({&StripifyTest::wrongIndexCount,
+              &StripifyTest::restartIndexCollision});
+}
+
+Vector3ui canonicalTriangle(Vector3ui triangle) {
+    while(triangle[0] > triangle[1] || triangle[0] > triangle[2])
+        triangle = {triangle[1], triangle[2], triangle[0]};
+    return triangle;
+}
+
+void sortTriangles(std::vector<Vector3ui>& triangles) {
+    std::sort(triangles.begin(), triangles.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::make_tuple(a[0], a[1], a[2]) < std::make_tuple(b[0], b[1], b[2]);
+    });
+}
+
+/* Converts strips back to a sorted list of triangles in a canonical rotation,
+   dropping the degenerate ones */
+std::vector<Vector3ui> stripTriangles(const Containers::ArrayView<const UnsignedInt> strips) {
+    std::vector<Vector3ui> out;
+    std::size_t start = 0;
+    for(std::size_t i = 0; i != strips.size(); ++i) {
+        if(strips[i] == 0xffffffffu) {
+            start = i + 1;
+            continue;
+        }
+
+        if(i - start < 2) continue;
+        const Vector3ui triangle = (i - start) % 2 ?
+            Vector3ui{strips[i - 1], strips[i - 2], strips[i]} :
+            Vector3ui{strips[i - 2], strips[i - 1], strips[i]};
+        if(triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0])
+            continue;
+
+        out.push_back(canonicalTriangle(triangle));
+    }
+
+    sortTriangles(out);
+    return out;
+}
+
+/*
+    0---2---4
+    |\  |\  |
+    | \ | \ |
+    |  \|  \|
+    1---3---5
+*/
+template<class T> void StripifyTest::primitiveRestart() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{
+        0, 1, 3,
+        0, 3, 2,
+        2, 3, 5,
+        2, 5, 4
+    };
+
+    /* The second and third triangle don't share an edge in the strip order */
+    constexpr T R = std::numeric_limits<T>::max();
+    Containers::Array<T> strips = stripify(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE_AS(Containers::arrayView<const T>(strips),
+        (Containers::Array<T>{Containers::InPlaceInit, {
+            1, 3, 0, 2, R, 3, 5, 2, 4
+        }}), TestSuite::Compare::Container);
+}
+
+void StripifyTest::degenerateTriangles() {
+    const UnsignedShort indices[]{
+        0, 1, 2,
+        5, 6, 7,
+        6, 8, 7
+    };
+
+    /* Two degenerate indices to join the strips, one more to make the second
+       strip start on an even position */
+    Containers::Array<UnsignedShort> strips = stripify(Containers::stridedArrayView(indices), StripJoin::DegenerateTriangles);
+    CORRADE_COMPARE_AS(Containers::arrayView<const UnsignedShort>(strips),
+        (Containers::Array<UnsignedShort>{Containers::InPlaceInit, {
+            0, 1, 2, 2, 2, 5, 5, 6, 7, 8
+        }}), TestSuite::Compare::Container);
+}
+
+void StripifyTest::empty() {
+    CORRADE_COMPARE(stripify(Containers::StridedArrayView1D<const UnsignedInt>{}).size(), 0);
+}
+
+void StripifyTest::icosphere() {
+    auto&& data = IcosphereData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData3D icosphere = Primitives::icosphereSolid(3);
+    std::vector<UnsignedInt>& indices = icosphere.indices();
+    tipsify(indices, icosphere.positions(0).size(), 24);
+
+    Containers::Array<UnsignedInt> strips = stripify<UnsignedInt>(Containers::stridedArrayView(indices), data.join);
+    CORRADE_COMPARE_AS(strips.size(), indices.size(),
+        TestSuite::Compare::Less);
+
+    /* All triangles should be there with the same winding */
+    std::vector<Vector3ui> expected;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        expected.push_back(canonicalTriangle({indices[i], indices[i + 1], indices[i + 2]}));
+    sortTriangles(expected);
+    CORRADE_COMPARE_AS(stripTriangles(strips), expected,
+        TestSuite::Compare::Container);
+}
+
+void StripifyTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[4]{};
+    stripify(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index count not divisible by 3\n");
+}
+
+void StripifyTest::restartIndexCollision() {
+    const UnsignedByte indices[]{0, 1, 2, 3, 255, 4};
+
+    /* Is fine with degenerate triangles */
+    stripify(Containers::stridedArrayView(indices), StripJoin::DegenerateTriangles);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    stripify(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index 255 at position 4 collides with the primitive restart index\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StripifyTest)
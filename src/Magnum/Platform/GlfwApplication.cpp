@@ -40,6 +40,7 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
 #include "Magnum/Platform/Implementation/DpiScaling.h"
+#include "Magnum/Platform/Implementation/EventCoalescing.h"
 
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/Version.h"
@@ -56,6 +57,7 @@ static_assert(GLFW_TRUE == true && GLFW_FALSE == false, "GLFW does not have sane
 enum class GlfwApplication::Flag: UnsignedByte {
     Redraw = 1 << 0,
     TextInputActive = 1 << 1,
+    CoalesceEvents = 1 << 3,
     #ifdef CORRADE_TARGET_APPLE
     HiDpiWarningPrinted = 1 << 2
     #elif defined(CORRADE_TARGET_WINDOWS)
@@ -584,14 +586,20 @@ bool GlfwApplication::tryCreate(const Configuration& configuration, const GLConf
 
 void GlfwApplication::setupCallbacks() {
     glfwSetWindowUserPointer(_window, this);
+    /* All callbacks except cursor motion and text input first dispatch
+       whatever got coalesced so far, to preserve the event order */
     glfwSetWindowCloseCallback(_window, [](GLFWwindow* const window){
+        auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
         ExitEvent e;
-        static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window))->exitEvent(e);
+        app.exitEvent(e);
         if(!e.isAccepted()) glfwSetWindowShouldClose(window, false);
     });
     glfwSetWindowRefreshCallback(_window, [](GLFWwindow* const window){
+        auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
         /* Properly redraw after the window is restored from minimized state */
-        static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window))->drawEvent();
+        app.drawEvent();
     });
     #ifdef MAGNUM_TARGET_GL
     glfwSetFramebufferSizeCallback
@@ -600,6 +608,7 @@ void GlfwApplication::setupCallbacks() {
     #endif
     (_window, [](GLFWwindow* const window, const int w, const int h) {
         auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
         #ifdef CORRADE_TARGET_WINDOWS
         /* See the flag for details */
         if(!(app._flags & Flag::FirstViewportEventIgnored)) {
@@ -616,6 +625,7 @@ void GlfwApplication::setupCallbacks() {
     });
     glfwSetKeyCallback(_window, [](GLFWwindow* const window, const int key, int, const int action, const int mods) {
         auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
 
         KeyEvent e(static_cast<KeyEvent::Key>(key), {static_cast<InputEvent::Modifier>(mods)}, action == GLFW_REPEAT);
 
@@ -626,6 +636,7 @@ void GlfwApplication::setupCallbacks() {
     });
     glfwSetMouseButtonCallback(_window, [](GLFWwindow* const window, const int button, const int action, const int mods) {
         auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
 
         double x, y;
         glfwGetCursorPos(window, &x, &y);
@@ -641,15 +652,25 @@ void GlfwApplication::setupCallbacks() {
         /* Avoid bogus offset at first -- report 0 when the event is called for
            the first time */
         Vector2i position{Int(x), Int(y)};
-        MouseMoveEvent e{window, position,
-            app._previousMouseMovePosition == Vector2i{-1} ? Vector2i{} :
-            position - app._previousMouseMovePosition};
+        const Vector2i relativePosition = app._previousMouseMovePosition == Vector2i{-1} ? Vector2i{} : position - app._previousMouseMovePosition;
         app._previousMouseMovePosition = position;
+
+        if(app._flags & Flag::CoalesceEvents) {
+            if(app._eventCoalescer->flushNeeded(Implementation::EventCoalescer::Type::MouseMove))
+                app.dispatchCoalescedEvent();
+            app._eventCoalescer->addMouseMove(position, relativePosition);
+            return;
+        }
+
+        app.dispatchCoalescedEvent();
+        MouseMoveEvent e{window, position, relativePosition};
         app.mouseMoveEvent(e);
     });
     glfwSetScrollCallback(_window, [](GLFWwindow* window, double xoffset, double yoffset) {
+        auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
+        app.dispatchCoalescedEvent();
         MouseScrollEvent e(window, Vector2{Float(xoffset), Float(yoffset)});
-        static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window))->mouseScrollEvent(e);
+        app.mouseScrollEvent(e);
     });
     glfwSetCharCallback(_window, [](GLFWwindow* window, unsigned int codepoint) {
         auto& app = *static_cast<GlfwApplication*>(glfwGetWindowUserPointer(window));
@@ -658,6 +679,15 @@ void GlfwApplication::setupCallbacks() {
 
         char utf8[4]{};
         const std::size_t size = Utility::Unicode::utf8(codepoint, utf8);
+
+        if(app._flags & Flag::CoalesceEvents) {
+            if(app._eventCoalescer->flushNeeded(Implementation::EventCoalescer::Type::TextInput))
+                app.dispatchCoalescedEvent();
+            app._eventCoalescer->addTextInput({utf8, size});
+            return;
+        }
+
+        app.dispatchCoalescedEvent();
         TextInputEvent e{{utf8, size}};
         app.textInputEvent(e);
     });
@@ -719,6 +749,33 @@ void GlfwApplication::setSwapInterval(const Int interval) {
 
 void GlfwApplication::redraw() { _flags |= Flag::Redraw; }
 
+bool GlfwApplication::isEventCoalescingEnabled() const {
+    return !!(_flags & Flag::CoalesceEvents);
+}
+
+void GlfwApplication::setEventCoalescingEnabled(const bool enabled) {
+    /* The coalescer is kept even if disabled again, so events that are
+       pending at that point still get dispatched */
+    if(enabled) {
+        if(!_eventCoalescer) _eventCoalescer.reset(new Implementation::EventCoalescer);
+        _flags |= Flag::CoalesceEvents;
+    } else _flags &= ~Flag::CoalesceEvents;
+}
+
+void GlfwApplication::dispatchCoalescedEvent() {
+    if(!_eventCoalescer) return;
+
+    Implementation::EventCoalescer& coalescer = *_eventCoalescer;
+    if(coalescer.pending() == Implementation::EventCoalescer::Type::MouseMove) {
+        MouseMoveEvent e{_window, coalescer.position(), coalescer.relativePosition(), coalescer.positions()};
+        mouseMoveEvent(e);
+    } else if(coalescer.pending() == Implementation::EventCoalescer::Type::TextInput) {
+        TextInputEvent e{coalescer.text()};
+        textInputEvent(e);
+    }
+    coalescer.clear();
+}
+
 int GlfwApplication::exec() {
     CORRADE_ASSERT(_window, "Platform::GlfwApplication::exec(): no window opened", {});
 
@@ -733,6 +790,7 @@ bool GlfwApplication::mainLoopIteration() {
         drawEvent();
     }
     glfwPollEvents();
+    dispatchCoalescedEvent();
 
     return !glfwWindowShouldClose(_window);
 }
@@ -54,6 +54,7 @@ namespace Magnum { namespace Platform {
 
 namespace Implementation {
     enum class GlfwDpiScalingPolicy: UnsignedByte;
+    class EventCoalescer;
 }
 
 /** @nosubgrouping
@@ -150,6 +151,15 @@ implicitly advertising DPI awareness, so the manifest file described in
 @ref platforms-windows-hidpi doesn't necessarily need to be supplied. See
 @ref Platform-Sdl2Application-dpi "Sdl2Application DPI awareness documentation"
 for more information.
+
+@section Platform-GlfwApplication-event-coalescing Event coalescing
+
+Event coalescing enabled with @ref setEventCoalescingEnabled() behaves the
+same as in @ref Sdl2Application, see
+@ref Platform-Sdl2Application-event-coalescing "its documentation" for
+details. Because GLFW doesn't report button state with cursor motion, all
+consecutive cursor motion events are merged, and button presses and releases
+split them.
 */
 class GlfwApplication {
     public:
@@ -501,6 +511,25 @@ class GlfwApplication {
         /** @copydoc Sdl2Application::redraw() */
         void redraw();
 
+        /**
+         * @brief Whether event coalescing is enabled
+         * @m_since_latest
+         *
+         * @see @ref setEventCoalescingEnabled()
+         */
+        bool isEventCoalescingEnabled() const;
+
+        /**
+         * @brief Enable or disable event coalescing
+         * @m_since_latest
+         *
+         * If enabled, consecutive cursor motion and text input events
+         * arriving in one main loop iteration are merged together. See
+         * @ref Platform-GlfwApplication-event-coalescing for more
+         * information. Disabled by default.
+         */
+        void setEventCoalescingEnabled(bool enabled);
+
     private:
         /**
          * @brief Viewport event
@@ -705,6 +734,7 @@ class GlfwApplication {
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
         void setupCallbacks();
+        void dispatchCoalescedEvent();
 
         GLFWcursor* _cursors[8]{};
         Cursor _cursor = Cursor::Arrow;
@@ -724,6 +754,9 @@ class GlfwApplication {
 
         Vector2i _minWindowSize, _maxWindowSize;
         Vector2i _previousMouseMovePosition{-1};
+
+        /* Created on first setEventCoalescingEnabled(true) */
+        Containers::Pointer<Implementation::EventCoalescer> _eventCoalescer;
 };
 
 #ifdef MAGNUM_TARGET_GL
@@ -1818,6 +1851,19 @@ class GlfwApplication::MouseMoveEvent: public GlfwApplication::InputEvent {
          */
         Vector2i relativePosition() const { return _relativePosition; }
 
+        /**
+         * @brief Positions of coalesced events
+         * @m_since_latest
+         *
+         * If @ref GlfwApplication::setEventCoalescingEnabled() "event coalescing"
+         * is enabled, contains positions of all cursor motion events merged
+         * into this one, in order, with the last being equal to
+         * @ref position(). Empty if event coalescing is disabled.
+         */
+        Containers::ArrayView<const Vector2i> coalescedPositions() const {
+            return _coalescedPositions;
+        }
+
         /**
          * @brief Modifiers
          *
@@ -1828,10 +1874,11 @@ class GlfwApplication::MouseMoveEvent: public GlfwApplication::InputEvent {
     private:
         friend GlfwApplication;
 
-        explicit MouseMoveEvent(GLFWwindow* window, const Vector2i& position, const Vector2i& relativePosition): _window{window}, _position{position}, _relativePosition{relativePosition} {}
+        explicit MouseMoveEvent(GLFWwindow* window, const Vector2i& position, const Vector2i& relativePosition, Containers::ArrayView<const Vector2i> coalescedPositions = nullptr): _window{window}, _position{position}, _relativePosition{relativePosition}, _coalescedPositions{coalescedPositions} {}
 
         GLFWwindow* const _window;
         const Vector2i _position, _relativePosition;
+        const Containers::ArrayView<const Vector2i> _coalescedPositions;
         Containers::Optional<Buttons> _buttons;
         Containers::Optional<Modifiers> _modifiers;
 };
@@ -0,0 +1,128 @@
+#ifndef Magnum_Platform_Implementation_EventCoalescing_h
+#define Magnum_Platform_Implementation_EventCoalescing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+/* Merges consecutive mouse move and text input events arriving in a single
+   event loop iteration into one. Doesn't know anything about the windowing
+   toolkit, so it can be tested with synthetic event sequences. For every
+   incoming event the application first asks flushNeeded() and if it returns
+   true, dispatches the pending event and calls clear(). Then it either adds
+   the event here or dispatches it directly, and at the end of the iteration
+   dispatches whatever is still pending. That way the relative order of all
+   events is preserved, only adjacent events of the same kind get merged. */
+class EventCoalescer {
+    public:
+        enum class Type: UnsignedByte {
+            /* Nothing pending, or an event that can't be coalesced */
+            None,
+            MouseMove,
+            TextInput
+        };
+
+        Type pending() const { return _pending; }
+
+        /* Whether the pending event has to be dispatched before an event of
+           given type can be accepted. Mouse moves with different button
+           state are not merged together, so drag start and end is still
+           visible to the application. */
+        bool flushNeeded(Type type, UnsignedInt buttons = 0) const {
+            if(_pending == Type::None) return false;
+            if(type != _pending) return true;
+            return type == Type::MouseMove && buttons != _buttons;
+        }
+
+        void addMouseMove(const Vector2i& position, const Vector2i& relativePosition, UnsignedInt buttons = 0) {
+            CORRADE_INTERNAL_ASSERT(!flushNeeded(Type::MouseMove, buttons));
+            if(_pending == Type::None) {
+                _relativePosition = {};
+                _positions.clear();
+            }
+            _pending = Type::MouseMove;
+            _position = position;
+            _relativePosition += relativePosition;
+            _buttons = buttons;
+            _positions.push_back(position);
+        }
+
+        void addTextInput(Containers::ArrayView<const char> text) {
+            CORRADE_INTERNAL_ASSERT(!flushNeeded(Type::TextInput));
+            if(_pending == Type::None) {
+                _text.clear();
+                _count = 0;
+            }
+            _pending = Type::TextInput;
+            _text.insert(_text.end(), text.begin(), text.end());
+            ++_count;
+        }
+
+        /* Position of the last merged mouse move */
+        Vector2i position() const { return _position; }
+
+        /* Sum of relative positions of all merged mouse moves */
+        Vector2i relativePosition() const { return _relativePosition; }
+
+        UnsignedInt buttons() const { return _buttons; }
+
+        /* Positions of all merged mouse moves, in order */
+        Containers::ArrayView<const Vector2i> positions() const {
+            return {_positions.data(), _positions.size()};
+        }
+
+        /* Concatenated text of all merged text input events */
+        Containers::ArrayView<const char> text() const {
+            return {_text.data(), _text.size()};
+        }
+
+        /* How many events got merged into the pending one */
+        std::size_t count() const {
+            return _pending == Type::MouseMove ? _positions.size() : _count;
+        }
+
+        /* Marks the pending event as dispatched. The buffers are kept
+           allocated for the next iteration. */
+        void clear() { _pending = Type::None; }
+
+    private:
+        Type _pending{};
+        UnsignedInt _buttons{};
+        std::size_t _count{};
+        Vector2i _position, _relativePosition;
+        std::vector<Vector2i> _positions;
+        std::vector<char> _text;
+};
+
+}}}
+
+#endif
@@ -53,6 +53,7 @@
 #include "Magnum/Math/Range.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
 #include "Magnum/Platform/Implementation/DpiScaling.h"
+#include "Magnum/Platform/Implementation/EventCoalescing.h"
 
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/Version.h"
@@ -88,7 +89,7 @@ Sdl2Application::InputEvent::Modifiers fixedModifiers(Uint16 mod) {
 
 }
 
-enum class Sdl2Application::Flag: UnsignedByte {
+enum class Sdl2Application::Flag: UnsignedShort {
     Redraw = 1 << 0,
     VSyncEnabled = 1 << 1,
     NoTickEvent = 1 << 2,
@@ -99,8 +100,16 @@ enum class Sdl2Application::Flag: UnsignedByte {
     Resizable = 1 << 6,
     #endif
     #ifdef CORRADE_TARGET_APPLE
-    HiDpiWarningPrinted = 1 << 7
+    HiDpiWarningPrinted = 1 << 7,
     #endif
+    CoalesceEvents = 1 << 8
+};
+
+struct Sdl2Application::EventCoalescing {
+    Implementation::EventCoalescer coalescer;
+    /* Last of the merged events, for MouseMoveEvent::event() and
+       TextInputEvent::event() */
+    SDL_Event event;
 };
 
 Sdl2Application::Sdl2Application(const Arguments& arguments): Sdl2Application{arguments, Configuration{}} {}
@@ -768,6 +777,33 @@ bool Sdl2Application::setSwapInterval(const Int interval) {
 
 void Sdl2Application::redraw() { _flags |= Flag::Redraw; }
 
+bool Sdl2Application::isEventCoalescingEnabled() const {
+    return !!(_flags & Flag::CoalesceEvents);
+}
+
+void Sdl2Application::setEventCoalescingEnabled(const bool enabled) {
+    /* The coalescer is kept even if disabled again, so events that are
+       pending at that point still get dispatched at the end of the event
+       loop iteration */
+    if(enabled) {
+        if(!_eventCoalescing) _eventCoalescing.reset(new EventCoalescing);
+        _flags |= Flag::CoalesceEvents;
+    } else _flags &= ~Flag::CoalesceEvents;
+}
+
+void Sdl2Application::dispatchCoalescedEvent() {
+    Implementation::EventCoalescer& coalescer = _eventCoalescing->coalescer;
+    const SDL_Event& event = _eventCoalescing->event;
+    if(coalescer.pending() == Implementation::EventCoalescer::Type::MouseMove) {
+        MouseMoveEvent e{event, coalescer.position(), coalescer.relativePosition(), static_cast<MouseMoveEvent::Button>(coalescer.buttons()), coalescer.positions()};
+        mouseMoveEvent(e);
+    } else if(coalescer.pending() == Implementation::EventCoalescer::Type::TextInput) {
+        TextInputEvent e{event, coalescer.text()};
+        textInputEvent(e);
+    }
+    coalescer.clear();
+}
+
 Sdl2Application::~Sdl2Application() {
     #ifdef MAGNUM_TARGET_GL
     _context.reset();
@@ -847,6 +883,36 @@ bool Sdl2Application::mainLoopIteration() {
 
     SDL_Event event;
     while(SDL_PollEvent(&event)) {
+        /* If event coalescing is enabled, dispatch the pending merged event
+           if this one can't be merged into it, and then either merge this
+           event or dispatch it as usual. If coalescing was disabled since,
+           only the pending event is dispatched. */
+        if(_eventCoalescing) {
+            Implementation::EventCoalescer::Type type = Implementation::EventCoalescer::Type::None;
+            UnsignedInt buttons = 0;
+            if(_flags & Flag::CoalesceEvents) {
+                if(event.type == SDL_MOUSEMOTION) {
+                    type = Implementation::EventCoalescer::Type::MouseMove;
+                    buttons = event.motion.state;
+                } else if(event.type == SDL_TEXTINPUT)
+                    type = Implementation::EventCoalescer::Type::TextInput;
+            }
+
+            Implementation::EventCoalescer& coalescer = _eventCoalescing->coalescer;
+            if(coalescer.flushNeeded(type, buttons)) dispatchCoalescedEvent();
+
+            if(type == Implementation::EventCoalescer::Type::MouseMove) {
+                coalescer.addMouseMove({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, buttons);
+                _eventCoalescing->event = event;
+                continue;
+            }
+            if(type == Implementation::EventCoalescer::Type::TextInput) {
+                coalescer.addTextInput({event.text.text, std::strlen(event.text.text)});
+                _eventCoalescing->event = event;
+                continue;
+            }
+        }
+
         switch(event.type) {
             case SDL_WINDOWEVENT:
                 switch(event.window.event) {
@@ -948,6 +1014,10 @@ bool Sdl2Application::mainLoopIteration() {
         }
     }
 
+    /* Dispatch whatever was merged last */
+    if(_eventCoalescing && _eventCoalescing->coalescer.pending() != Implementation::EventCoalescer::Type::None)
+        dispatchCoalescedEvent();
+
     /* Tick event */
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
 
@@ -428,6 +428,22 @@ If your application is saving and restoring window size, it's advisable to take
     with @cpp 1.0f @ce as custom DPI scaling next time --- but this doesn't
     properly handle cases where the window is opened on a display with
     different DPI.
+
+@section Platform-Sdl2Application-event-coalescing Event coalescing
+
+By default, every SDL event results in one call of the corresponding event
+handler. A high-frequency mouse can generate over ten motion events per
+frame, and if @ref mouseMoveEvent() does anything expensive, such as picking
+or UI hit-testing, that work gets repeated for each of them. After calling
+@ref setEventCoalescingEnabled(), consecutive mouse motion events with the
+same button state that arrive in one main loop iteration are merged into a
+single @ref mouseMoveEvent() call. Its @ref MouseMoveEvent::position() is the
+last position and @ref MouseMoveEvent::relativePosition() is the sum of all
+merged relative motions. All merged positions are available through
+@ref MouseMoveEvent::coalescedPositions(). Consecutive text input events are
+merged the same way into one @ref textInputEvent() call with concatenated
+text. Events of any other kind are never merged and the relative order of
+all events is preserved.
 */
 class Sdl2Application {
     public:
@@ -835,6 +851,25 @@ class Sdl2Application {
         }
         #endif
 
+        /**
+         * @brief Whether event coalescing is enabled
+         * @m_since_latest
+         *
+         * @see @ref setEventCoalescingEnabled()
+         */
+        bool isEventCoalescingEnabled() const;
+
+        /**
+         * @brief Enable or disable event coalescing
+         * @m_since_latest
+         *
+         * If enabled, consecutive mouse motion and text input events arriving
+         * in one main loop iteration are merged together. See
+         * @ref Platform-Sdl2Application-event-coalescing for more
+         * information. Disabled by default.
+         */
+        void setEventCoalescingEnabled(bool enabled);
+
         /**
          * @brief Redraw immediately
          *
@@ -1144,10 +1179,14 @@ class Sdl2Application {
         /*@}*/
 
     private:
-        enum class Flag: UnsignedByte;
+        enum class Flag: UnsignedShort;
         typedef Containers::EnumSet<Flag> Flags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+        struct EventCoalescing;
+
+        void dispatchCoalescedEvent();
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Cursor* _cursors[14]{};
         #else
@@ -1178,6 +1217,9 @@ class Sdl2Application {
 
         Flags _flags;
 
+        /* Created on first setEventCoalescingEnabled(true) */
+        Containers::Pointer<EventCoalescing> _eventCoalescing;
+
         int _exitCode = 0;
 };
 
@@ -2400,6 +2442,19 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
         /** @brief Mouse buttons */
         Buttons buttons() const { return _buttons; }
 
+        /**
+         * @brief Positions of coalesced events
+         * @m_since_latest
+         *
+         * If @ref Sdl2Application::setEventCoalescingEnabled() "event coalescing"
+         * is enabled, contains positions of all mouse motion events merged
+         * into this one, in order, with the last being equal to
+         * @ref position(). Empty if event coalescing is disabled.
+         */
+        Containers::ArrayView<const Vector2i> coalescedPositions() const {
+            return _coalescedPositions;
+        }
+
         /**
          * @brief Modifiers
          *
@@ -2410,10 +2465,11 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
     private:
         friend Sdl2Application;
 
-        explicit MouseMoveEvent(const SDL_Event& event, const Vector2i& position, const Vector2i& relativePosition, Buttons buttons): InputEvent{event}, _position{position}, _relativePosition{relativePosition}, _buttons{buttons} {}
+        explicit MouseMoveEvent(const SDL_Event& event, const Vector2i& position, const Vector2i& relativePosition, Buttons buttons, Containers::ArrayView<const Vector2i> coalescedPositions = nullptr): InputEvent{event}, _position{position}, _relativePosition{relativePosition}, _buttons{buttons}, _coalescedPositions{coalescedPositions} {}
 
         const Vector2i _position, _relativePosition;
         const Buttons _buttons;
+        const Containers::ArrayView<const Vector2i> _coalescedPositions;
         Containers::Optional<Modifiers> _modifiers;
 };
 
@@ -2567,7 +2623,9 @@ class Sdl2Application::TextInputEvent {
         /**
          * @brief Underlying SDL event
          *
-         * Of type `SDL_TEXTINPUT`.
+         * Of type `SDL_TEXTINPUT`. If
+         * @ref Sdl2Application::setEventCoalescingEnabled() "event coalescing"
+         * is enabled, it's the last of the merged events.
          * @see @ref Sdl2Application::anyEvent()
          */
         const SDL_Event& event() const { return _event; }
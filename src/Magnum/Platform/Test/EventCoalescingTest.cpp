@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Platform/Implementation/EventCoalescing.h"
+
+namespace Magnum { namespace Platform { namespace Test { namespace {
+
+typedef Implementation::EventCoalescer EventCoalescer;
+
+struct EventCoalescingTest: TestSuite::Tester {
+    explicit EventCoalescingTest();
+
+    void empty();
+    void mouseMove();
+    void mouseMoveDifferentButtons();
+    void textInput();
+    void differentTypes();
+    void clear();
+
+    void sequence();
+};
+
+/* A synthetic event, only the fields relevant for given type are used */
+struct Event {
+    EventCoalescer::Type type;
+    Vector2i position, relativePosition;
+    UnsignedInt buttons;
+    const char* text;
+};
+
+/* Replicates what Sdl2Application and GlfwApplication do in the event loop
+   and prints every dispatched event to a string */
+std::vector<std::string> process(EventCoalescer& coalescer, const std::vector<Event>& events) {
+    std::vector<std::string> out;
+    auto dispatch = [&]() {
+        std::ostringstream o;
+        if(coalescer.pending() == EventCoalescer::Type::MouseMove)
+            Debug{&o, Debug::Flag::NoNewlineAtTheEnd} << "move" << coalescer.position() << coalescer.relativePosition() << coalescer.buttons() << coalescer.count();
+        else if(coalescer.pending() == EventCoalescer::Type::TextInput)
+            Debug{&o, Debug::Flag::NoNewlineAtTheEnd} << "text" << std::string{coalescer.text().data(), coalescer.text().size()};
+        out.push_back(o.str());
+        coalescer.clear();
+    };
+
+    for(const Event& event: events) {
+        if(coalescer.flushNeeded(event.type, event.buttons)) dispatch();
+
+        if(event.type == EventCoalescer::Type::MouseMove)
+            coalescer.addMouseMove(event.position, event.relativePosition, event.buttons);
+        else if(event.type == EventCoalescer::Type::TextInput)
+            coalescer.addTextInput({event.text, std::strlen(event.text)});
+        else out.push_back("other");
+    }
+
+    if(coalescer.pending() != EventCoalescer::Type::None) dispatch();
+    return out;
+}
+
+EventCoalescingTest::EventCoalescingTest() {
+    addTests({&EventCoalescingTest::empty,
+              &EventCoalescingTest::mouseMove,
+              &EventCoalescingTest::mouseMoveDifferentButtons,
+              &EventCoalescingTest::textInput,
+              &EventCoalescingTest::differentTypes,
+              &EventCoalescingTest::clear,
+
+              &EventCoalescingTest::sequence});
+}
+
+void EventCoalescingTest::empty() {
+    EventCoalescer coalescer;
+    CORRADE_VERIFY(coalescer.pending() == EventCoalescer::Type::None);
+    CORRADE_VERIFY(!coalescer.flushNeeded(EventCoalescer::Type::None));
+    CORRADE_VERIFY(!coalescer.flushNeeded(EventCoalescer::Type::MouseMove, 3));
+    CORRADE_VERIFY(!coalescer.flushNeeded(EventCoalescer::Type::TextInput));
+}
+
+void EventCoalescingTest::mouseMove() {
+    EventCoalescer coalescer;
+    coalescer.addMouseMove({10, 20}, {1, 2}, 1);
+    coalescer.addMouseMove({13, 19}, {3, -1}, 1);
+    CORRADE_VERIFY(!coalescer.flushNeeded(EventCoalescer::Type::MouseMove, 1));
+    coalescer.addMouseMove({14, 15}, {1, -4}, 1);
+
+    CORRADE_VERIFY(coalescer.pending() == EventCoalescer::Type::MouseMove);
+    CORRADE_COMPARE(coalescer.count(), 3);
+    CORRADE_COMPARE(coalescer.position(), (Vector2i{14, 15}));
+    CORRADE_COMPARE(coalescer.relativePosition(), (Vector2i{5, -3}));
+    CORRADE_COMPARE(coalescer.buttons(), 1);
+    const Vector2i expected[]{{10, 20}, {13, 19}, {14, 15}};
+    CORRADE_COMPARE_AS(coalescer.positions(), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void EventCoalescingTest::mouseMoveDifferentButtons() {
+    EventCoalescer coalescer;
+    coalescer.addMouseMove({10, 20}, {1, 2}, 0);
+    CORRADE_VERIFY(!coalescer.flushNeeded(EventCoalescer::Type::MouseMove, 0));
+    CORRADE_VERIFY(coalescer.flushNeeded(EventCoalescer::Type::MouseMove, 1));
+}
+
+void EventCoalescingTest::textInput() {
+    EventCoalescer coalescer;
+    coalescer.addTextInput({"he", 2});
+    coalescer.addTextInput({"llo", 3});
+
+    CORRADE_VERIFY(coalescer.pending() == EventCoalescer::Type::TextInput);
+    CORRADE_COMPARE(coalescer.count(), 2);
+    CORRADE_COMPARE((std::string{coalescer.text().data(), coalescer.text().size()}), "hello");
+}
+
+void EventCoalescingTest::differentTypes() {
+    EventCoalescer coalescer;
+    coalescer.addMouseMove({10, 20}, {1, 2});
+    CORRADE_VERIFY(coalescer.flushNeeded(EventCoalescer::Type::TextInput));
+    CORRADE_VERIFY(coalescer.flushNeeded(EventCoalescer::Type::None));
+
+    coalescer.clear();
+    coalescer.addTextInput({"a", 1});
+    CORRADE_VERIFY(coalescer.flushNeeded(EventCoalescer::Type::MouseMove));
+    CORRADE_VERIFY(coalescer.flushNeeded(EventCoalescer::Type::None));
+}
+
+void EventCoalescingTest::clear() {
+    EventCoalescer coalescer;
+    coalescer.addMouseMove({10, 20}, {1, 2});
+    coalescer.addMouseMove({11, 20}, {1, 0});
+    coalescer.clear();
+    CORRADE_VERIFY(coalescer.pending() == EventCoalescer::Type::None);
+
+    /* Accumulated state starts from scratch after a clear */
+    coalescer.addMouseMove({12, 21}, {1, 1});
+    CORRADE_COMPARE(coalescer.count(), 1);
+    CORRADE_COMPARE(coalescer.relativePosition(), (Vector2i{1, 1}));
+
+    coalescer.clear();
+    coalescer.addTextInput({"ab", 2});
+    coalescer.clear();
+    coalescer.addTextInput({"c", 1});
+    CORRADE_COMPARE(coalescer.count(), 1);
+    CORRADE_COMPARE((std::string{coalescer.text().data(), coalescer.text().size()}), "c");
+}
+
+void EventCoalescingTest::sequence() {
+    EventCoalescer coalescer;
+    const EventCoalescer::Type Move = EventCoalescer::Type::MouseMove;
+    const EventCoalescer::Type Text = EventCoalescer::Type::TextInput;
+    const EventCoalescer::Type Other = EventCoalescer::Type::None;
+
+    /* A 1000 Hz mouse moving during a 60 Hz frame, a button press in the
+       middle, then a drag and some typing */
+    std::vector<std::string> out = process(coalescer, {
+        {Move, {1, 0}, {1, 0}, 0, nullptr},
+        {Move, {2, 0}, {1, 0}, 0, nullptr},
+        {Move, {3, 1}, {1, 1}, 0, nullptr},
+        {Move, {4, 1}, {1, 0}, 0, nullptr},
+        {Other, {}, {}, 0, nullptr},
+        {Move, {5, 2}, {1, 1}, 1, nullptr},
+        {Move, {7, 2}, {2, 0}, 1, nullptr},
+        {Move, {7, 3}, {0, 1}, 0, nullptr},
+        {Text, {}, {}, 0, "a"},
+        {Text, {}, {}, 0, "b"},
+        {Text, {}, {}, 0, "c"}
+    });
+
+    CORRADE_COMPARE_AS(out, (std::vector<std::string>{
+        "move Vector(4, 1) Vector(4, 1) 0 4",
+        "other",
+        "move Vector(7, 2) Vector(3, 1) 1 2",
+        "move Vector(7, 3) Vector(0, 1) 0 1",
+        "text abc"
+    }), TestSuite::Compare::Container);
+
+    /* Nothing left pending, the next iteration starts from scratch */
+    CORRADE_VERIFY(coalescer.pending() == EventCoalescer::Type::None);
+    out = process(coalescer, {
+        {Text, {}, {}, 0, "d"},
+        {Other, {}, {}, 0, nullptr},
+        {Text, {}, {}, 0, "e"}
+    });
+    CORRADE_COMPARE_AS(out, (std::vector<std::string>{
+        "text d",
+        "other",
+        "text e"
+    }), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Platform::Test::EventCoalescingTest)
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
@@ -181,6 +182,23 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, finalTransformationMatrix);
         }
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object allocated from a frame arena
+         * @m_since_latest
+         *
+         * Like @ref transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&, const MatrixType&) const,
+         * but both the output and all temporary storage is allocated from
+         * @p arena, so the call doesn't allocate any heap memory once the
+         * arena reaches a steady state. The returned view is valid until the
+         * next @ref FrameArena::reset().
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        Containers::ArrayView<MatrixType> transformationMatrices(FrameArena& arena, Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, const MatrixType& finalTransformationMatrix = MatrixType()) const {
+            return doTransformationMatrices(arena, objects, finalTransformationMatrix);
+        }
+
         /*@}*/
 
         /**
@@ -258,6 +276,10 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const = 0;
+        /* Not pure virtual so subclasses implementing only the above don't
+           break, the default implementation delegates to it and copies the
+           result to the arena */
+        virtual Containers::ArrayView<MatrixType> doTransformationMatrices(FrameArena& arena, Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, const MatrixType& finalTransformationMatrix) const;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
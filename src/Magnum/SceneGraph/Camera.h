@@ -196,6 +196,19 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> drawableTransformations(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Drawable transformations allocated from a frame arena
+         * @m_since_latest
+         *
+         * Like @ref drawableTransformations(DrawableGroup<dimensions, T>&),
+         * but both the output and all temporary storage is allocated from
+         * @p arena, so the call doesn't allocate any heap memory once the
+         * arena reaches a steady state. The returned view is valid until the
+         * next @ref FrameArena::reset().
+         * @see @ref draw(Containers::ArrayView<const std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>)
+         */
+        Containers::ArrayView<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> drawableTransformations(FrameArena& arena, DrawableGroup<dimensions, T>& group);
+
         /**
          * @brief Draw
          *
@@ -204,6 +217,16 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw using a frame arena for temporary storage
+         * @m_since_latest
+         *
+         * Like @ref draw(DrawableGroup<dimensions, T>&), but all temporary
+         * storage is allocated from @p arena, so the call doesn't allocate
+         * any heap memory once the arena reaches a steady state.
+         */
+        void draw(FrameArena& arena, DrawableGroup<dimensions, T>& group);
+
         /**
          * @brief Draw given drawables with transformations
          *
@@ -213,6 +236,15 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         void draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations);
 
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Useful in combination with
+         * @ref drawableTransformations(FrameArena&, DrawableGroup<dimensions, T>&).
+         */
+        void draw(Containers::ArrayView<const std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> drawableTransformations);
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -29,6 +29,7 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include "Magnum/FrameArena.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -106,6 +107,28 @@ template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_w
     return combined;
 }
 
+template<UnsignedInt dimensions, class T> Containers::ArrayView<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> Camera<dimensions, T>::drawableTransformations(FrameArena& arena, DrawableGroup<dimensions, T>& group) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::Camera::drawableTransformations(): cannot draw when camera is not part of any scene", {});
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the camera */
+    const Containers::ArrayView<std::reference_wrapper<AbstractObject<dimensions, T>>> objects = arena.allocate<std::reference_wrapper<AbstractObject<dimensions, T>>>(Containers::NoInit, group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        new(&objects[i]) std::reference_wrapper<AbstractObject<dimensions, T>>{group[i].object()};
+    const Containers::ArrayView<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(arena, objects, _cameraMatrix);
+
+    /* Combine drawable references and transformation matrices */
+    const Containers::ArrayView<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> combined = arena.allocate<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>(Containers::NoInit, transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        new(&combined[i]) std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>{group[i], transformations[i]};
+
+    return combined;
+}
+
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "SceneGraph::Camera::draw(): cannot draw when camera is not part of any scene", );
@@ -126,11 +149,23 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
         group[i].draw(transformations[i], *this);
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(FrameArena& arena, DrawableGroup<dimensions, T>& group) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    draw(drawableTransformations(arena, group));
+}
+
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations) {
     for(auto&& drawableTransformation: drawableTransformations)
         drawableTransformation.first.get().draw(drawableTransformation.second, *this);
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const Containers::ArrayView<const std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> drawableTransformations) {
+    for(auto&& drawableTransformation: drawableTransformations)
+        drawableTransformation.first.get().draw(drawableTransformation.second, *this);
+}
+
 }}
 
 #endif
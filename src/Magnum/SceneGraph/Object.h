@@ -260,6 +260,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object allocated from a frame arena
+         * @m_since_latest
+         *
+         * Like @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const,
+         * but both the output and all temporary storage is allocated from
+         * @p arena, so the call doesn't allocate any heap memory once the
+         * arena reaches a steady state. The returned view is valid until the
+         * next @ref FrameArena::reset().
+         */
+        Containers::ArrayView<MatrixType> transformationMatrices(FrameArena& arena, Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const MatrixType& finalTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
@@ -279,6 +291,24 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Transformations of given group of objects relative to this object allocated from a frame arena
+         * @m_since_latest
+         *
+         * Like @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&) const,
+         * but both the output and all temporary storage is allocated from
+         * @p arena, so the call doesn't allocate any heap memory once the
+         * arena reaches a steady state. The returned view is valid until the
+         * next @ref FrameArena::reset().
+         */
+        Containers::ArrayView<typename Transformation::DataType> transformations(FrameArena& arena, Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
         /*@}*/
 
         /**
@@ -355,8 +385,16 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix) const override final;
+        Containers::ArrayView<MatrixType> doTransformationMatrices(FrameArena& arena, Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, const MatrixType& finalTransformationMatrix) const override final;
+
+        /* Shared implementation of both transformations() variants. The
+           `objects` array is clobbered, `jointObjects` and
+           `jointTransformations` have to have space for 2*objectCount items
+           and the output is in the first objectCount items of the latter.
+           Returns false if an assertion fails. */
+        bool MAGNUM_SCENEGRAPH_LOCAL transformationsInternal(Object<Transformation>** objects, std::size_t objectCount, Object<Transformation>** jointObjects, typename Transformation::DataType* jointTransformations, const typename Transformation::DataType& finalTransformation) const;
 
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const;
+        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(Object<Transformation>* const* jointObjects, typename Transformation::DataType* jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <stack>
 
+#include "Magnum/FrameArena.h"
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
@@ -41,6 +42,17 @@ namespace Magnum { namespace SceneGraph {
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::AbstractObject() {}
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~AbstractObject() {}
 
+template<UnsignedInt dimensions, class T> auto AbstractObject<dimensions, T>::doTransformationMatrices(FrameArena& arena, const Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, const MatrixType& finalTransformationMatrix) const -> Containers::ArrayView<MatrixType> {
+    /* Fallback for subclasses that implement only the std::vector variant,
+       allocates on the heap */
+    const std::vector<MatrixType> transformationMatrices = doTransformationMatrices(std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>{objects.begin(), objects.end()}, finalTransformationMatrix);
+    Containers::ArrayView<MatrixType> out = arena.allocate<MatrixType>(Containers::NoInit, transformationMatrices.size());
+    for(std::size_t i = 0; i != transformationMatrices.size(); ++i)
+        new(&out[i]) MatrixType{transformationMatrices[i]};
+
+    return out;
+}
+
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
 template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
@@ -179,6 +191,15 @@ template<class Transformation> auto Object<Transformation>::doTransformationMatr
     return transformationMatrices(std::move(castObjects), finalTransformationMatrix);
 }
 
+template<class Transformation> auto Object<Transformation>::doTransformationMatrices(FrameArena& arena, const Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, const MatrixType& finalTransformationMatrix) const -> Containers::ArrayView<MatrixType> {
+    Containers::ArrayView<std::reference_wrapper<Object<Transformation>>> castObjects = arena.allocate<std::reference_wrapper<Object<Transformation>>>(Containers::NoInit, objects.size());
+    /** @todo Ensure this doesn't crash, somehow */
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        new(&castObjects[i]) std::reference_wrapper<Object<Transformation>>{static_cast<Object<Transformation>&>(objects[i].get())};
+
+    return transformationMatrices(arena, castObjects, finalTransformationMatrix);
+}
+
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
     std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix));
     std::vector<MatrixType> transformationMatrices(transformations.size());
@@ -188,6 +209,50 @@ template<class Transformation> auto Object<Transformation>::transformationMatric
     return transformationMatrices;
 }
 
+template<class Transformation> auto Object<Transformation>::transformationMatrices(FrameArena& arena, const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const MatrixType& finalTransformationMatrix) const -> Containers::ArrayView<MatrixType> {
+    const Containers::ArrayView<typename Transformation::DataType> transformations = this->transformations(arena, objects, Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix));
+    const Containers::ArrayView<MatrixType> transformationMatrices = arena.allocate<MatrixType>(Containers::NoInit, transformations.size());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        new(&transformationMatrices[i]) MatrixType{Implementation::Transformation<Transformation>::toMatrix(transformations[i])};
+
+    return transformationMatrices;
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
+    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+
+    /* First half is a copy of the input that gets clobbered, second half for
+       the joints */
+    const std::size_t objectCount = objects.size();
+    std::vector<Object<Transformation>*> storage(objectCount*3);
+    for(std::size_t i = 0; i != objectCount; ++i)
+        storage[i] = &objects[i].get();
+
+    std::vector<typename Transformation::DataType> jointTransformations(objectCount*2);
+    if(!transformationsInternal(storage.data(), objectCount, storage.data() + objectCount, jointTransformations.data(), finalTransformation))
+        return {};
+
+    /* Shrink the array to contain only transformations of requested objects
+       and return */
+    jointTransformations.resize(objectCount);
+    return jointTransformations;
+}
+
+template<class Transformation> Containers::ArrayView<typename Transformation::DataType> Object<Transformation>::transformations(FrameArena& arena, const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
+    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+
+    const std::size_t objectCount = objects.size();
+    const Containers::ArrayView<Object<Transformation>*> storage = arena.allocate<Object<Transformation>*>(Containers::NoInit, objectCount*3);
+    for(std::size_t i = 0; i != objectCount; ++i)
+        storage[i] = &objects[i].get();
+
+    const Containers::ArrayView<typename Transformation::DataType> jointTransformations = arena.allocate<typename Transformation::DataType>(objectCount*2);
+    if(!transformationsInternal(storage.data(), objectCount, storage.data() + objectCount, jointTransformations.data(), finalTransformation))
+        return {};
+
+    return jointTransformations.prefix(objectCount);
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -201,24 +266,25 @@ divided into two groups:
 Then for all joints their transformation (relative to parent joint) is
 computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
-*/
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
-
-    /* Remember object count for later */
-    std::size_t objectCount = objects.size();
 
+Every path going up from a requested object stops at the first already visited
+object, adding at most one new joint, so there's at most twice as many joints
+as there are requested objects.
+*/
+template<class Transformation> bool Object<Transformation>::transformationsInternal(Object<Transformation>** const objects, const std::size_t objectCount, Object<Transformation>** const jointObjects, typename Transformation::DataType* const jointTransformations, const typename Transformation::DataType& finalTransformation) const {
     /* Mark all original objects as joints and create initial list of joints
        from them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
+    for(std::size_t i = 0; i != objectCount; ++i) {
+        jointObjects[i] = objects[i];
+
         /* Multiple occurences of one object in the array, don't overwrite it
            with different counter */
-        if(objects[i].get().counter != 0xFFFFu) continue;
+        if(objects[i]->counter != 0xFFFFu) continue;
 
-        objects[i].get().counter = UnsignedShort(i);
-        objects[i].get().flags |= Flag::Joint;
+        objects[i]->counter = UnsignedShort(i);
+        objects[i]->flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
+    std::size_t jointCount = objectCount;
 
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
     /* Scene object */
@@ -226,98 +292,94 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     #endif
 
     /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", false);
+
+    /* Mark all objects up the hierarchy as visited. Paths are walked one
+       after another from the back, finished ones are popped off. */
+    std::size_t pendingCount = objectCount;
+    while(pendingCount) {
+        Object<Transformation>*& o = objects[pendingCount - 1];
 
-    /* Mark all objects up the hierarchy as visited */
-    auto it = objects.begin();
-    while(!objects.empty()) {
         /* Already visited, remove and continue to next (duplicate occurence) */
-        if(it->get().flags & Flag::Visited) {
-            it = objects.erase(it);
+        if(o->flags & Flag::Visited) {
+            --pendingCount;
             continue;
         }
 
         /* Mark the object as visited */
-        it->get().flags |= Flag::Visited;
+        o->flags |= Flag::Visited;
 
-        Object<Transformation>* parent = it->get().parent();
+        Object<Transformation>* parent = o->parent();
 
         /* If this is root object, remove from list */
         if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
-            it = objects.erase(it);
+            CORRADE_ASSERT(o == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", false);
+            --pendingCount;
 
         /* Parent is an joint or already visited - remove current from list */
         } else if(parent->flags & (Flag::Visited|Flag::Joint)) {
-            it = objects.erase(it);
+            --pendingCount;
 
             /* If not already marked as joint, mark it as such and add it to
                list of joint objects */
             if(!(parent->flags & Flag::Joint)) {
-                CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
+                CORRADE_ASSERT(jointCount < 0xFFFFu,
+                               "SceneGraph::Object::transformations(): too large scene", false);
                 CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
-                parent->counter = UnsignedShort(jointObjects.size());
+                CORRADE_INTERNAL_ASSERT(jointCount < objectCount*2);
+                parent->counter = UnsignedShort(jointCount);
                 parent->flags |= Flag::Joint;
-                jointObjects.push_back(*parent);
+                jointObjects[jointCount++] = parent;
             }
 
         /* Else go up the hierarchy */
-        } else *it = *parent;
-
-        /* Cycle if reached end */
-        if(it == objects.end()) it = objects.begin();
+        } else o = parent;
     }
 
-    /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
-
     /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
+    for(std::size_t i = 0; i != jointCount; ++i)
         computeJointTransformation(jointObjects, jointTransformations, i, finalTransformation);
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
     for(std::size_t i = 0; i != objectCount; ++i) {
-        if(jointObjects[i].get().counter != i)
-            jointTransformations[i] = jointTransformations[jointObjects[i].get().counter];
+        if(jointObjects[i]->counter != i)
+            jointTransformations[i] = jointTransformations[jointObjects[i]->counter];
     }
 
     /* All visited marks are now cleaned, clean joint marks and counters */
-    for(auto i: jointObjects) {
+    for(std::size_t i = 0; i != jointCount; ++i) {
         /* All not-already cleaned objects (...duplicate occurences) should
            have joint mark */
-        CORRADE_INTERNAL_ASSERT(i.get().counter == 0xFFFFu || i.get().flags & Flag::Joint);
-        i.get().flags &= ~Flag::Joint;
-        i.get().counter = 0xFFFFu;
+        CORRADE_INTERNAL_ASSERT(jointObjects[i]->counter == 0xFFFFu || jointObjects[i]->flags & Flag::Joint);
+        jointObjects[i]->flags &= ~Flag::Joint;
+        jointObjects[i]->counter = 0xFFFFu;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
-    jointTransformations.resize(objectCount);
-    return jointTransformations;
+    return true;
 }
 
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const {
-    std::reference_wrapper<Object<Transformation>> o = jointObjects[joint];
+template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(Object<Transformation>* const* const jointObjects, typename Transformation::DataType* const jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const {
+    Object<Transformation>* o = jointObjects[joint];
 
     /* Transformation already computed ("unvisited" by this function before
        either due to recursion or duplicate object occurences), done */
-    if(!(o.get().flags & Flag::Visited)) return jointTransformations[joint];
+    if(!(o->flags & Flag::Visited)) return jointTransformations[joint];
 
     /* Initialize transformation */
-    jointTransformations[joint] = o.get().transformation();
+    jointTransformations[joint] = o->transformation();
 
     /* Go up until next joint or root */
     for(;;) {
         /* Clean visited mark */
-        CORRADE_INTERNAL_ASSERT(o.get().flags & Flag::Visited);
-        o.get().flags &= ~Flag::Visited;
+        CORRADE_INTERNAL_ASSERT(o->flags & Flag::Visited);
+        o->flags &= ~Flag::Visited;
 
-        Object<Transformation>* parent = o.get().parent();
+        Object<Transformation>* parent = o->parent();
 
         /* Root object, compose transformation with final, done */
         if(!parent) {
-            CORRADE_INTERNAL_ASSERT(o.get().isScene());
+            CORRADE_INTERNAL_ASSERT(o->isScene());
             return (jointTransformations[joint] =
                 Implementation::Transformation<Transformation>::compose(finalTransformation, jointTransformations[joint]));
 
@@ -329,7 +391,7 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
         /* Else compose transformation with parent, go up the hierarchy */
         } else {
             jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(parent->transformation(), jointTransformations[joint]);
-            o = *parent;
+            o = parent;
         }
     }
 }
@@ -0,0 +1,282 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionCuller.h"
+
+#include <utility>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+/* Size of a tile with a single farthest depth value */
+constexpr Int TileSize = 8;
+
+/* Vertex positions are snapped to 1/16th of a pixel so the edge functions
+   can be evaluated exactly in integers */
+constexpr Int Subpixel = 16;
+
+/* Triangles with vertices farther than this many pixels from the origin are
+   skipped so the edge functions don't overflow, that's conservative */
+constexpr Float GuardBand = Float(1 << 22);
+
+typedef Math::Vector2<Long> Vector2l;
+typedef Math::Vector3<Long> Vector3l;
+
+/* Projects a clip-space point to the depth buffer space, with XY in pixels
+   and Z in normalized device coordinates */
+inline Vector3 project(const Vector4& clip, const Vector2& size) {
+    const Vector3 ndc = clip.xyz()/clip.w();
+    return {(ndc.xy()*0.5f + Vector2{0.5f})*size, ndc.z()};
+}
+
+/* Clip-space point in front of the near plane or behind the camera */
+inline bool isOutsideNearPlane(const Vector4& clip) {
+    return clip.w() < Math::TypeTraits<Float>::epsilon() || clip.z() < -clip.w();
+}
+
+/* With counterclockwise winding in a Y-up space, left edges go down and top
+   edges go left */
+inline bool isTopLeft(const Vector2l& edge) {
+    return edge.y() < 0 || (edge.y() == 0 && edge.x() < 0);
+}
+
+}
+
+OcclusionCuller::OcclusionCuller(const Vector2i& size): _size{size} {
+    CORRADE_ASSERT(size.x() > 0 && size.y() > 0 && size.x() % TileSize == 0 && size.y() % TileSize == 0,
+        "SceneGraph::OcclusionCuller: expected size to be a non-zero multiple of 8 but got" << size, );
+
+    _depth = Containers::Array<Float>{Containers::NoInit, std::size_t(size.product())};
+    _tileDepth = Containers::Array<Float>{Containers::NoInit, std::size_t((size/TileSize).product())};
+    clear();
+}
+
+OcclusionCuller::OcclusionCuller(OcclusionCuller&&) noexcept = default;
+
+OcclusionCuller::~OcclusionCuller() = default;
+
+OcclusionCuller& OcclusionCuller::operator=(OcclusionCuller&&) noexcept = default;
+
+OcclusionCuller& OcclusionCuller::setProjectionMatrix(const Matrix4& matrix) {
+    _projectionMatrix = matrix;
+    return *this;
+}
+
+OcclusionCuller& OcclusionCuller::clear() {
+    for(Float& i: _depth) i = Constants::inf();
+    for(Float& i: _tileDepth) i = Constants::inf();
+    return *this;
+}
+
+OcclusionCuller& OcclusionCuller::addOccluder(const Matrix4& transformation, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "SceneGraph::OcclusionCuller::addOccluder(): index count not divisible by 3", *this);
+
+    /* Transform all vertices to clip space first */
+    const Matrix4 matrix = _projectionMatrix*transformation;
+    Containers::Array<Vector4> clip{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        clip[i] = matrix*Vector4{positions[i], 1.0f};
+
+    const Vector2 size{_size};
+    Vector2i dirtyMin = _size, dirtyMax;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt ia = indices[i], ib = indices[i + 1], ic = indices[i + 2];
+        CORRADE_ASSERT(ia < clip.size() && ib < clip.size() && ic < clip.size(),
+            "SceneGraph::OcclusionCuller::addOccluder(): index out of bounds for" << clip.size() << "vertices", *this);
+
+        /* Skip triangles that aren't completely behind the near plane,
+           that's conservative */
+        if(isOutsideNearPlane(clip[ia]) ||
+           isOutsideNearPlane(clip[ib]) ||
+           isOutsideNearPlane(clip[ic])) continue;
+
+        Vector3 a = project(clip[ia], size);
+        Vector3 b = project(clip[ib], size);
+        Vector3 c = project(clip[ic], size);
+        if((Math::abs(a.xy()) > Vector2{GuardBand}).any() ||
+           (Math::abs(b.xy()) > Vector2{GuardBand}).any() ||
+           (Math::abs(c.xy()) > Vector2{GuardBand}).any()) continue;
+
+        /* Snap to the subpixel grid */
+        Vector2l al{Math::round(a.xy()*Float(Subpixel))};
+        Vector2l bl{Math::round(b.xy()*Float(Subpixel))};
+        Vector2l cl{Math::round(c.xy()*Float(Subpixel))};
+        a.xy() = Vector2{al}/Float(Subpixel);
+        b.xy() = Vector2{bl}/Float(Subpixel);
+        c.xy() = Vector2{cl}/Float(Subpixel);
+
+        /* Make the winding counterclockwise, skip degenerate triangles */
+        Long areal = Math::cross(bl - al, cl - al);
+        if(areal == 0) continue;
+        if(areal < 0) {
+            std::swap(b, c);
+            std::swap(bl, cl);
+            areal = -areal;
+        }
+        const Float area = Float(areal)/Float(Subpixel*Subpixel);
+
+        /* Clipped bounding rectangle, max is exclusive */
+        const Vector2i min{Math::max(Math::floor(Math::min(Math::min(a.xy(), b.xy()), c.xy())), Vector2{0.0f})};
+        const Vector2i max{Math::min(Math::ceil(Math::max(Math::max(a.xy(), b.xy()), c.xy())), size)};
+        if(min.x() >= max.x() || min.y() >= max.y()) continue;
+        dirtyMin = Math::min(dirtyMin, min);
+        dirtyMax = Math::max(dirtyMax, max);
+
+        /* Depth plane gradient. The farthest depth inside a pixel is at most
+           half a gradient away from the depth at its center, and it's never
+           farther than the farthest vertex. */
+        const Vector2 ab = b.xy() - a.xy();
+        const Vector2 ac = c.xy() - a.xy();
+        const Vector2 depthGradient{
+            ((b.z() - a.z())*ac.y() - (c.z() - a.z())*ab.y())/area,
+            ((c.z() - a.z())*ab.x() - (b.z() - a.z())*ac.x())/area};
+        const Float depthOffset = 0.5f*(Math::abs(depthGradient.x()) + Math::abs(depthGradient.y()));
+        const Float depthMax = Math::max(Math::max(a.z(), b.z()), c.z());
+
+        /* Edge functions in subpixel units, positive inside the triangle,
+           evaluated at the first pixel center, and their per-pixel
+           increments. Pixels with the center exactly on an edge are written
+           only if it's a top or a left edge, so pixels on edges shared by
+           adjacent triangles are written exactly once. The other edges are
+           biased by one to make the test the same for all three. */
+        const Vector2l start = Vector2l{min}*Long(Subpixel) + Vector2l{Long(Subpixel/2)};
+        const Vector3l edgeStepX = Vector3l{bl.y() - cl.y(), cl.y() - al.y(), al.y() - bl.y()}*Long(Subpixel);
+        const Vector3l edgeStepY = Vector3l{cl.x() - bl.x(), al.x() - cl.x(), bl.x() - al.x()}*Long(Subpixel);
+        Vector3l edgeRow{
+            Math::cross(cl - bl, start - bl) - (isTopLeft(cl - bl) ? 0 : 1),
+            Math::cross(al - cl, start - cl) - (isTopLeft(al - cl) ? 0 : 1),
+            Math::cross(bl - al, start - al) - (isTopLeft(bl - al) ? 0 : 1)};
+        const Vector2 startCenter = Vector2{min} + Vector2{0.5f};
+        Float depthRow = a.z() + Math::dot(depthGradient, startCenter - a.xy()) + depthOffset;
+
+        for(Int y = min.y(); y != max.y(); ++y) {
+            Float* const row = _depth.data() + y*_size.x();
+            Vector3l edge = edgeRow;
+            Float depth = depthRow;
+            for(Int x = min.x(); x != max.x(); ++x) {
+                if(edge.x() >= 0 && edge.y() >= 0 && edge.z() >= 0)
+                    row[x] = Math::min(row[x], Math::min(depth, depthMax));
+                edge += edgeStepX;
+                depth += depthGradient.x();
+            }
+
+            edgeRow += edgeStepY;
+            depthRow += depthGradient.y();
+        }
+    }
+
+    if(dirtyMin.x() < dirtyMax.x())
+        updateTileDepth(dirtyMin, dirtyMax);
+
+    return *this;
+}
+
+void OcclusionCuller::updateTileDepth(const Vector2i& min, const Vector2i& max) {
+    const Int tileCountX = _size.x()/TileSize;
+    for(Int ty = min.y()/TileSize, tyEnd = (max.y() - 1)/TileSize + 1; ty != tyEnd; ++ty) {
+        for(Int tx = min.x()/TileSize, txEnd = (max.x() - 1)/TileSize + 1; tx != txEnd; ++tx) {
+            Float farthest = -Constants::inf();
+            for(Int y = ty*TileSize; y != (ty + 1)*TileSize; ++y) {
+                const Float* const row = _depth.data() + y*_size.x() + tx*TileSize;
+                for(Int x = 0; x != TileSize; ++x)
+                    farthest = Math::max(farthest, row[x]);
+            }
+
+            _tileDepth[ty*tileCountX + tx] = farthest;
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const Matrix4& transformation, const Range3D& bounds) const {
+    const Matrix4 matrix = _projectionMatrix*transformation;
+    const Vector2 size{_size};
+
+    /* Project all eight corners, calculate the covered rectangle and the
+       nearest depth */
+    Vector2 rectMin{Constants::inf()}, rectMax{-Constants::inf()};
+    Float nearest = Constants::inf();
+    for(UnsignedInt i = 0; i != 8; ++i) {
+        const Vector4 clip = matrix*Vector4{
+            (i & 1 ? bounds.max() : bounds.min()).x(),
+            (i & 2 ? bounds.max() : bounds.min()).y(),
+            (i & 4 ? bounds.max() : bounds.min()).z(), 1.0f};
+
+        /* Crossing the camera plane, can't say anything */
+        if(clip.w() < Math::TypeTraits<Float>::epsilon()) return true;
+
+        const Vector3 projected = project(clip, size);
+        rectMin = Math::min(rectMin, projected.xy());
+        rectMax = Math::max(rectMax, projected.xy());
+        nearest = Math::min(nearest, projected.z());
+    }
+
+    /* Outside of the view */
+    const Vector2i min{Math::floor(Math::clamp(rectMin, Vector2{0.0f}, size))};
+    const Vector2i max{Math::ceil(Math::clamp(rectMax, Vector2{0.0f}, size))};
+    if(min.x() >= max.x() || min.y() >= max.y()) return false;
+
+    /* Go through all tiles and test pixels only in tiles that aren't
+       completely in front of the box */
+    const Int tileCountX = _size.x()/TileSize;
+    for(Int ty = min.y()/TileSize, tyEnd = (max.y() - 1)/TileSize + 1; ty != tyEnd; ++ty) {
+        for(Int tx = min.x()/TileSize, txEnd = (max.x() - 1)/TileSize + 1; tx != txEnd; ++tx) {
+            if(_tileDepth[ty*tileCountX + tx] < nearest) continue;
+
+            const Int yMin = Math::max(min.y(), ty*TileSize);
+            const Int yMax = Math::min(max.y(), (ty + 1)*TileSize);
+            const Int xMin = Math::max(min.x(), tx*TileSize);
+            const Int xMax = Math::min(max.x(), (tx + 1)*TileSize);
+            for(Int y = yMin; y != yMax; ++y) {
+                const Float* const row = _depth.data() + y*_size.x();
+                for(Int x = xMin; x != xMax; ++x)
+                    if(row[x] >= nearest) return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+std::size_t OcclusionCuller::cull(std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>>& drawableTransformations, const std::function<Range3D(Drawable3D&)>& bounds) const {
+    std::size_t out = 0;
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        if(!isVisible(drawableTransformations[i].second, bounds(drawableTransformations[i].first)))
+            continue;
+        if(out != i) drawableTransformations[out] = drawableTransformations[i];
+        ++out;
+    }
+
+    const std::size_t removed = drawableTransformations.size() - out;
+    drawableTransformations.erase(drawableTransformations.begin() + out, drawableTransformations.end());
+    return removed;
+}
+
+}}
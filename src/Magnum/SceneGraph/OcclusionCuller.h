@@ -0,0 +1,205 @@
+#ifndef Magnum_SceneGraph_OcclusionCuller_h
+#define Magnum_SceneGraph_OcclusionCuller_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::OcclusionCuller
+ * @m_since_latest
+ */
+
+#include <functional>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Software occlusion culler
+@m_since_latest
+
+Rasterizes a set of occluder meshes into a low-resolution depth buffer on the
+CPU and then tests bounding boxes of drawables against it. Useful for scenes
+where a large part of drawables is hidden behind a few big occluders, such as
+buildings in a city scene. As everything is done on the CPU, the results are
+available immediately without any GPU synchronization.
+
+@section SceneGraph-OcclusionCuller-usage Usage
+
+Every frame, clear the depth buffer using @ref clear(), set the projection
+matrix to the one used by the camera and rasterize the occluders using
+@ref addOccluder(). Occluder geometry should be a simplified, conservative
+version of the actual mesh --- it should never be larger than the visible
+mesh, otherwise objects that are actually visible can get culled. Then, get
+camera-relative drawable transformations using
+@ref Camera::drawableTransformations(), remove occluded drawables with
+@ref cull() and draw the rest using @ref Camera::draw():
+
+@code{.cpp}
+SceneGraph::Camera3D& camera = ...;
+SceneGraph::DrawableGroup3D drawables;
+SceneGraph::OcclusionCuller culler{{256, 128}};
+
+culler.clear()
+    .setProjectionMatrix(camera.projectionMatrix());
+for(Occluder& occluder: occluders)
+    culler.addOccluder(camera.cameraMatrix()*occluder.transformation,
+        occluder.positions, occluder.indices);
+
+auto drawableTransformations = camera.drawableTransformations(drawables);
+culler.cull(drawableTransformations, [](SceneGraph::Drawable3D& drawable) {
+    return static_cast<MyDrawable&>(drawable).boundingBox();
+});
+camera.draw(drawableTransformations);
+@endcode
+
+@section SceneGraph-OcclusionCuller-implementation Implementation
+
+The depth buffer is split into 8x8 pixel tiles, each tile additionally storing
+the farthest depth of all its pixels. When testing a bounding box, tiles
+farther than the box are skipped as a whole and only the remaining ones are
+tested pixel-by-pixel. Triangles are rasterized using half-space edge
+functions evaluated exactly on a subpixel grid, writing pixels with the center
+inside the triangle. A top-left fill rule is used for centers lying exactly
+on an edge, so pixels on edges shared by adjacent occluder triangles are
+written exactly once and multi-triangle occluders have no cracks. The depth
+written for each covered pixel is the farthest depth of the triangle plane
+inside that pixel, which makes the depth test conservative. Occluder
+triangles that aren't completely behind the near plane are skipped, bounding
+boxes crossing the camera plane are always treated as visible.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT OcclusionCuller {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Depth buffer size
+         *
+         * Expects that the size is a non-zero multiple of 8 in both
+         * dimensions. A few hundred pixels in each direction is usually
+         * enough. The depth buffer is initially cleared and the projection
+         * matrix is set to identity.
+         */
+        explicit OcclusionCuller(const Vector2i& size);
+
+        /** @brief Copying is not allowed */
+        OcclusionCuller(const OcclusionCuller&) = delete;
+
+        /** @brief Move constructor */
+        OcclusionCuller(OcclusionCuller&&) noexcept;
+
+        ~OcclusionCuller();
+
+        /** @brief Copying is not allowed */
+        OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+        /** @brief Move assignment */
+        OcclusionCuller& operator=(OcclusionCuller&&) noexcept;
+
+        /** @brief Depth buffer size */
+        Vector2i size() const { return _size; }
+
+        /**
+         * @brief Depth buffer
+         *
+         * Row-major, with the first row at the bottom. Values are in the
+         * normalized device coordinates, with pixels not covered by any
+         * occluder set to @ref Constants::inf(). Useful mainly for debugging.
+         */
+        Containers::ArrayView<const Float> depth() const { return _depth; }
+
+        /** @brief Projection matrix */
+        Matrix4 projectionMatrix() const { return _projectionMatrix; }
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Should be set to the same value as @ref Camera::projectionMatrix().
+         * Affects only subsequent @ref addOccluder() calls, so if the
+         * projection changes, the depth buffer should be cleared.
+         */
+        OcclusionCuller& setProjectionMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Clear the depth buffer
+         * @return Reference to self (for method chaining)
+         */
+        OcclusionCuller& clear();
+
+        /**
+         * @brief Rasterize an occluder mesh
+         * @param transformation    Camera-relative occluder transformation
+         * @param positions         Occluder vertex positions
+         * @param indices           Occluder triangle indices
+         * @return Reference to self (for method chaining)
+         *
+         * Triangles of both windings are rasterized. Expects that the index
+         * count is divisible by 3 and all indices are in bounds.
+         */
+        OcclusionCuller& addOccluder(const Matrix4& transformation, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+        /**
+         * @brief Whether a bounding box is potentially visible
+         * @param transformation    Camera-relative bounding box transformation
+         * @param bounds            Bounding box
+         *
+         * Returns @cpp false @ce if the bounding box is outside of the view
+         * or completely hidden behind occluders, @cpp true @ce otherwise.
+         */
+        bool isVisible(const Matrix4& transformation, const Range3D& bounds) const;
+
+        /**
+         * @brief Remove occluded drawables
+         * @param[in,out] drawableTransformations Drawables with
+         *      camera-relative transformations
+         * @param[in] bounds    Function returning a bounding box of given
+         *      drawable
+         * @return Count of removed drawables
+         *
+         * Calls @ref isVisible() for each drawable and removes those that
+         * are not visible, preserving the order of the rest. The input is
+         * meant to be produced by @ref Camera::drawableTransformations() and
+         * the output passed to @ref Camera::draw().
+         */
+        std::size_t cull(std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>>& drawableTransformations, const std::function<Range3D(Drawable3D&)>& bounds) const;
+
+    private:
+        void updateTileDepth(const Vector2i& min, const Vector2i& max);
+
+        Vector2i _size;
+        Matrix4 _projectionMatrix;
+        Containers::Array<Float> _depth;
+        Containers::Array<Float> _tileDepth;
+};
+
+}}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionQueryCuller.h"
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+/* Radius of a sphere around the camera that contains the whole near plane
+   rectangle */
+Float nearPlaneRadius(const Matrix4& projectionMatrix) {
+    const Matrix4 inverted = projectionMatrix.inverted();
+    Float radius = 0.0f;
+    for(const Vector2& corner: {Vector2{-1.0f, -1.0f}, Vector2{1.0f, -1.0f}, Vector2{-1.0f, 1.0f}, Vector2{1.0f, 1.0f}})
+        radius = Math::max(radius, inverted.transformPoint({corner, -1.0f}).length());
+    return radius;
+}
+
+/* Whether a bounding box, transformed to camera space, is closer than given
+   distance to the camera along any axis */
+bool isNearCamera(const Matrix4& transformationMatrix, const Range3D& bounds, const Float distance) {
+    const Vector3 center = transformationMatrix.transformPoint(bounds.center());
+    const Vector3 halfSize = bounds.size()*0.5f;
+    Vector3 extents;
+    for(std::size_t i = 0; i != 3; ++i)
+        extents[i] = Math::abs(transformationMatrix[0][i])*halfSize[0] +
+                     Math::abs(transformationMatrix[1][i])*halfSize[1] +
+                     Math::abs(transformationMatrix[2][i])*halfSize[2];
+    return (Math::abs(center) <= extents + Vector3{distance}).all();
+}
+
+}
+
+OcclusionQueryCuller::OcclusionQueryCuller():
+    #ifndef MAGNUM_TARGET_GLES
+    _target{GL::Context::current().isExtensionSupported<GL::Extensions::ARB::occlusion_query2>() ? GL::SampleQuery::Target::AnySamplesPassed : GL::SampleQuery::Target::SamplesPassed}
+    #else
+    _target{GL::SampleQuery::Target::AnySamplesPassed}
+    #endif
+{
+    #ifndef MAGNUM_TARGET_GLES
+    _conditionalRender = GL::Context::current().isExtensionSupported<GL::Extensions::NV::conditional_render>();
+    #endif
+}
+
+OcclusionQueryCuller::~OcclusionQueryCuller() = default;
+
+bool OcclusionQueryCuller::isVisible(Drawable3D& drawable) const {
+    const auto found = _states.find(&drawable);
+    return found == _states.end() || found->second.visible;
+}
+
+UnsignedInt OcclusionQueryCuller::acquireQuery() {
+    if(!_freeQueries.empty()) {
+        const UnsignedInt id = _freeQueries.back();
+        _freeQueries.pop_back();
+        return id;
+    }
+
+    _queries.emplace_back(_target);
+    return _queries.size() - 1;
+}
+
+void OcclusionQueryCuller::updateState(State& state) {
+    /* Retrieve the result only if it's there already to avoid a stall.
+       Non-boolean SamplesPassed query results are converted to bool just
+       fine. */
+    if(state.query == -1 || !_queries[state.query].resultAvailable()) return;
+
+    state.visible = _queries[state.query].result<UnsignedInt>() != 0;
+    _freeQueries.push_back(UnsignedInt(state.query));
+    state.query = -1;
+}
+
+std::size_t OcclusionQueryCuller::draw(Camera3D& camera, const std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>>& drawableTransformations, const std::function<Range3D(Drawable3D&)>& bounds) {
+    ++_frame;
+    _drawnCount = _culledCount = 0;
+
+    const Float nearRadius = nearPlaneRadius(camera.projectionMatrix());
+
+    /* Update state of all drawables and draw the ones that were visible
+       last time first, so they fill the depth buffer for the queries */
+    std::vector<std::pair<State*, std::size_t>> hidden;
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        Drawable3D& drawable = drawableTransformations[i].first;
+        const Matrix4& transformationMatrix = drawableTransformations[i].second;
+
+        State& state = _states.emplace(&drawable, State{-1, true, _frame}).first->second;
+        state.frame = _frame;
+        updateState(state);
+
+        /* If the near plane touches the bounding box, the box faces could be
+           clipped away and the query would report zero samples, so treat it
+           as visible */
+        if(!state.visible && isNearCamera(transformationMatrix, bounds(drawable), nearRadius))
+            state.visible = true;
+
+        if(!state.visible) {
+            hidden.emplace_back(&state, i);
+            continue;
+        }
+
+        /* Wrap the draw in a query to know when the drawable becomes hidden,
+           unless the previous query is still in flight */
+        if(state.query == -1) {
+            state.query = Int(acquireQuery());
+            GL::SampleQuery& query = _queries[state.query];
+            query.begin();
+            drawable.draw(transformationMatrix, camera);
+            query.end();
+        } else drawable.draw(transformationMatrix, camera);
+
+        ++_drawnCount;
+    }
+
+    /* Issue bounding box queries for hidden drawables. Done in one pass with
+       writes disabled to avoid excessive state changes. The masks are
+       expected to be fully enabled on entry (there's no way to query them
+       without a GL roundtrip), so they're set back to that. */
+    if(!hidden.empty()) {
+        GL::Renderer::setColorMask(false, false, false, false);
+        GL::Renderer::setDepthMask(false);
+
+        for(const std::pair<State*, std::size_t>& i: hidden) {
+            State& state = *i.first;
+            if(state.query != -1) continue;
+
+            Drawable3D& drawable = drawableTransformations[i.second].first;
+            const Matrix4& transformationMatrix = drawableTransformations[i.second].second;
+
+            state.query = Int(acquireQuery());
+            GL::SampleQuery& query = _queries[state.query];
+            query.begin();
+            drawBoundingBox(transformationMatrix, bounds(drawable), camera);
+            query.end();
+        }
+
+        GL::Renderer::setDepthMask(true);
+        GL::Renderer::setColorMask(true, true, true, true);
+    }
+
+    /* Draw the hidden drawables conditionally on the query result so the
+       ones that became visible in this frame don't pop in one frame later. If
+       conditional rendering isn't available, they get drawn once the query
+       result arrives. */
+    for(const std::pair<State*, std::size_t>& i: hidden) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(_conditionalRender) {
+            GL::SampleQuery& query = _queries[i.first->query];
+            query.beginConditionalRender(GL::SampleQuery::ConditionalRenderMode::NoWait);
+            drawableTransformations[i.second].first.get().draw(drawableTransformations[i.second].second, camera);
+            query.endConditionalRender();
+            ++_drawnCount;
+            continue;
+        }
+        #endif
+
+        ++_culledCount;
+    }
+
+    /* Forget drawables that weren't drawn in this frame. Their queries, if
+       any, can't be recycled until they finish, but there's no way to wait
+       for that without a stall, so they're simply recycled as the result
+       will be overwritten by the next begin() anyway. */
+    for(auto it = _states.begin(); it != _states.end(); ) {
+        if(it->second.frame != _frame) {
+            if(it->second.query != -1) _freeQueries.push_back(UnsignedInt(it->second.query));
+            it = _states.erase(it);
+        } else ++it;
+    }
+
+    return _culledCount;
+}
+
+void OcclusionQueryCuller::clear() {
+    for(const auto& state: _states)
+        if(state.second.query != -1) _freeQueries.push_back(UnsignedInt(state.second.query));
+    _states.clear();
+}
+
+}}
@@ -0,0 +1,266 @@
+#ifndef Magnum_SceneGraph_OcclusionQueryCuller_h
+#define Magnum_SceneGraph_OcclusionQueryCuller_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::OcclusionQueryCuller
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/SampleQuery.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Hardware occlusion query culler
+@m_since_latest
+
+Draws drawables while using GPU occlusion queries to skip those that were
+hidden in previous frames. Compared to @ref OcclusionCuller it doesn't need any
+simplified occluder geometry, but the visibility information has a latency of
+at least one frame.
+
+This class is built into a separate `SceneGraphGL` library, which is
+available if Magnum is built with both `WITH_SCENEGRAPH` and `WITH_GL`
+enabled. To use it with CMake, request the `SceneGraphGL` component of the
+`Magnum` package and link to the `Magnum::SceneGraphGL` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED SceneGraphGL)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::SceneGraphGL)
+@endcode
+
+See @ref building and @ref cmake for more information.
+
+@section SceneGraph-OcclusionQueryCuller-usage Usage
+
+Subclass it and implement @ref drawBoundingBox(), which is used to draw a
+proxy for drawables hidden in previous frames. The box needs to go through the
+depth test, but color and depth writes are disabled by the culler before
+calling it, so a trivial shader is enough:
+
+@code{.cpp}
+class BoxCuller: public SceneGraph::OcclusionQueryCuller {
+    private:
+        void drawBoundingBox(const Matrix4& transformationMatrix, const Range3D& bounds, SceneGraph::Camera3D& camera) override {
+            _shader.setTransformationProjectionMatrix(
+                camera.projectionMatrix()*transformationMatrix*
+                Matrix4::translation(bounds.center())*
+                Matrix4::scaling(bounds.size()/2.0f));
+            _cube.draw(_shader);
+        }
+
+        Shaders::Flat3D _shader;
+        GL::Mesh _cube = MeshTools::compile(Primitives::cubeSolid());
+};
+@endcode
+
+Then, instead of calling @ref Camera::draw(), pass the drawable
+transformations together with a function returning a bounding box of each
+drawable to @ref draw():
+
+@code{.cpp}
+auto drawableTransformations = camera.drawableTransformations(drawables);
+culler.draw(camera, drawableTransformations, [](SceneGraph::Drawable3D& drawable) {
+    return static_cast<MyDrawable&>(drawable).boundingBox();
+});
+@endcode
+
+@section SceneGraph-OcclusionQueryCuller-state Renderer state
+
+The culler expects color and depth writes to be enabled for all channels when
+@ref draw() is called. While querying the bounding boxes of hidden drawables,
+it disables them using @ref GL::Renderer::setColorMask() and
+@ref GL::Renderer::setDepthMask() and then enables them again, so any other
+mask set before is not preserved. If your drawables need a different mask,
+set it inside @ref Drawable::draw() and restore it afterwards.
+
+@section SceneGraph-OcclusionQueryCuller-algorithm Algorithm
+
+Each drawable is either considered visible or hidden, based on the last
+available query result. Drawables seen for the first time are considered
+visible.
+
+-   Visible drawables are drawn first, so they fill the depth buffer. Each
+    draw is wrapped in a query, unless a previous one for the same drawable
+    is still in flight, so the culler can detect that the drawable became
+    hidden.
+-   For hidden drawables, a query is issued for their bounding box. On
+    desktop GL the drawable is then drawn with conditional rendering based on
+    the query result, so if it became visible, it gets drawn in the same frame
+    without the CPU waiting for the result. On OpenGL ES and WebGL, where
+    conditional rendering is not available, it's drawn one frame after the
+    query reports it as visible.
+-   Query results are retrieved only when they're available, so the CPU never
+    waits for the GPU. Queries that finished are recycled in a pool.
+-   A drawable whose bounding box is closer to the camera than the near
+    plane corners is always treated as visible, as its box faces could get
+    clipped by the near plane.
+
+@requires_gles30 Extension @gl_extension{EXT,occlusion_query_boolean} in
+    OpenGL ES 2.0.
+@requires_webgl20 Queries are not available in WebGL 1.0.
+*/
+class MAGNUM_SCENEGRAPHGL_EXPORT OcclusionQueryCuller {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects an active OpenGL context. Uses
+         * @ref GL::SampleQuery::Target::AnySamplesPassed if available,
+         * @ref GL::SampleQuery::Target::SamplesPassed otherwise.
+         */
+        explicit OcclusionQueryCuller();
+
+        /** @brief Copying is not allowed */
+        OcclusionQueryCuller(const OcclusionQueryCuller&) = delete;
+
+        /** @brief Moving is not allowed */
+        OcclusionQueryCuller(OcclusionQueryCuller&&) = delete;
+
+        virtual ~OcclusionQueryCuller();
+
+        /** @brief Copying is not allowed */
+        OcclusionQueryCuller& operator=(const OcclusionQueryCuller&) = delete;
+
+        /** @brief Moving is not allowed */
+        OcclusionQueryCuller& operator=(OcclusionQueryCuller&&) = delete;
+
+        /**
+         * @brief Count of query objects
+         *
+         * Includes both queries in flight and queries waiting in the pool
+         * for reuse.
+         */
+        std::size_t queryCount() const { return _queries.size(); }
+
+        /**
+         * @brief Count of drawables drawn in the last frame
+         *
+         * Includes drawables drawn using conditional rendering, even though
+         * they may have been discarded by the GPU.
+         */
+        std::size_t drawnCount() const { return _drawnCount; }
+
+        /**
+         * @brief Count of drawables culled in the last frame
+         *
+         * Drawables that were skipped on the CPU side. Same as the value
+         * returned from @ref draw().
+         */
+        std::size_t culledCount() const { return _culledCount; }
+
+        /**
+         * @brief Whether given drawable is considered visible
+         *
+         * Returns the visibility as known from the last available query
+         * result. Drawables not passed to @ref draw() yet are considered
+         * visible.
+         */
+        bool isVisible(Drawable3D& drawable) const;
+
+        /**
+         * @brief Draw
+         * @param camera                    Camera
+         * @param drawableTransformations   Drawables with camera-relative
+         *      transformations
+         * @param bounds    Function returning a bounding box of given
+         *      drawable
+         * @return Count of drawables that were culled
+         *
+         * The @p drawableTransformations is meant to be produced by
+         * @ref Camera::drawableTransformations(). Drawables that were present
+         * in the previous call but are not present in this one are
+         * forgotten. Expects that color and depth writes are enabled and
+         * leaves them enabled, see
+         * @ref SceneGraph-OcclusionQueryCuller-state for more information.
+         */
+        std::size_t draw(Camera3D& camera, const std::vector<std::pair<std::reference_wrapper<Drawable3D>, Matrix4>>& drawableTransformations, const std::function<Range3D(Drawable3D&)>& bounds);
+
+        /**
+         * @brief Forget all drawables
+         *
+         * All drawables will be considered visible again. Query objects are
+         * kept in the pool for reuse.
+         */
+        void clear();
+
+    private:
+        /**
+         * @brief Draw a bounding box
+         * @param transformationMatrix  Drawable transformation relative to
+         *      camera
+         * @param bounds                Drawable bounding box
+         * @param camera                Camera
+         *
+         * Called inside an occlusion query for drawables that were hidden in
+         * previous frames. Color and depth writes are disabled while this
+         * function is called, the implementation should not change that.
+         */
+        virtual void drawBoundingBox(const Matrix4& transformationMatrix, const Range3D& bounds, Camera3D& camera) = 0;
+
+        struct State {
+            /* Index into _queries or -1 if there's no query in flight */
+            Int query;
+            bool visible;
+            /* Last frame in which the drawable was passed to draw() */
+            UnsignedInt frame;
+        };
+
+        UnsignedInt acquireQuery();
+        void updateState(State& state);
+
+        GL::SampleQuery::Target _target;
+        std::vector<GL::SampleQuery> _queries;
+        std::vector<UnsignedInt> _freeQueries;
+        std::unordered_map<Drawable3D*, State> _states;
+        UnsignedInt _frame{};
+        #ifndef MAGNUM_TARGET_GLES
+        bool _conditionalRender;
+        #endif
+        std::size_t _drawnCount{}, _culledCount{};
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build and not in WebGL 1.0
+#endif
+
+#endif
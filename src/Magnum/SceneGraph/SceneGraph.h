@@ -129,12 +129,19 @@ typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
+class OcclusionCuller;
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class OcclusionQueryCuller;
+#endif
 
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
 typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
+class SpatialIndex;
+class SpatialIndexFeature;
+
 template<class Transformation> class Scene;
 
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
@@ -0,0 +1,311 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+
+constexpr std::size_t NotDirty = ~std::size_t{};
+
+struct CellHash {
+    std::size_t operator()(const Vector3i& cell) const {
+        return (std::size_t(cell.x())*73856093) ^ (std::size_t(cell.y())*19349663) ^ (std::size_t(cell.z())*83492791);
+    }
+};
+
+}
+
+struct SpatialIndex::State {
+    std::unordered_map<Vector3i, std::vector<SpatialIndexFeature*>, CellHash> cells;
+    /* Features with bounding box larger than cell size */
+    std::vector<SpatialIndexFeature*> large;
+    std::vector<SpatialIndexFeature*> dirty;
+    std::size_t count{};
+};
+
+SpatialIndex::SpatialIndex(const Float cellSize): _cellSize{cellSize}, _state{Containers::InPlaceInit} {
+    CORRADE_ASSERT(cellSize > 0.0f,
+        "SceneGraph::SpatialIndex: expected positive cell size but got" << cellSize, );
+}
+
+SpatialIndex::~SpatialIndex() {
+    CORRADE_ASSERT(!_state->count,
+        "SceneGraph::SpatialIndex: destroyed while" << _state->count << "features are still in the index", );
+}
+
+std::size_t SpatialIndex::size() const { return _state->count; }
+
+std::size_t SpatialIndex::dirtyCount() const { return _state->dirty.size(); }
+
+void SpatialIndex::insert(SpatialIndexFeature& feature) {
+    const Range3D& bounds = feature._absoluteBounds;
+    std::vector<SpatialIndexFeature*>* list;
+    if((bounds.size() > Vector3{_cellSize}).any()) {
+        feature._large = true;
+        list = &_state->large;
+    } else {
+        feature._large = false;
+        feature._cell = Vector3i{Math::floor(bounds.center()/_cellSize)};
+        list = &_state->cells[feature._cell];
+    }
+
+    feature._cellPosition = list->size();
+    feature._inserted = true;
+    list->push_back(&feature);
+}
+
+void SpatialIndex::remove(SpatialIndexFeature& feature) {
+    std::vector<SpatialIndexFeature*>& list = feature._large ?
+        _state->large : _state->cells.at(feature._cell);
+
+    /* Swap with the last and pop, so the removal is O(1) */
+    SpatialIndexFeature* const last = list.back();
+    list[feature._cellPosition] = last;
+    last->_cellPosition = feature._cellPosition;
+    list.pop_back();
+    feature._inserted = false;
+
+    /* Don't keep empty cells around, otherwise moving objects would
+       gradually fill the whole map */
+    if(list.empty() && !feature._large) _state->cells.erase(feature._cell);
+}
+
+void SpatialIndex::markDirty(SpatialIndexFeature& feature) {
+    if(feature._dirtyPosition != NotDirty) return;
+    feature._dirtyPosition = _state->dirty.size();
+    _state->dirty.push_back(&feature);
+}
+
+void SpatialIndex::markClean(SpatialIndexFeature& feature) {
+    if(feature._dirtyPosition == NotDirty) return;
+    SpatialIndexFeature* const last = _state->dirty.back();
+    _state->dirty[feature._dirtyPosition] = last;
+    last->_dirtyPosition = feature._dirtyPosition;
+    _state->dirty.pop_back();
+    feature._dirtyPosition = NotDirty;
+}
+
+SpatialIndex& SpatialIndex::update() {
+    if(_state->dirty.empty()) return *this;
+
+    /* Clean all dirty objects in a single batch. Multiple features can share
+       the same object, so remove the duplicates first. */
+    std::vector<AbstractObject3D*> objects;
+    objects.reserve(_state->dirty.size());
+    for(SpatialIndexFeature* feature: _state->dirty)
+        if(feature->object().isDirty()) objects.push_back(&feature->object());
+    std::sort(objects.begin(), objects.end());
+    std::vector<std::reference_wrapper<AbstractObject3D>> uniqueObjects;
+    uniqueObjects.reserve(objects.size());
+    for(auto it = objects.begin(), end = std::unique(objects.begin(), objects.end()); it != end; ++it)
+        uniqueObjects.push_back(**it);
+    AbstractObject3D::setClean(uniqueObjects);
+
+    /* Features that are left were marked dirty on an object that is already
+       clean, either because they were just created or their bounds changed.
+       Their clean() removes them from the list. */
+    while(!_state->dirty.empty()) {
+        SpatialIndexFeature& feature = *_state->dirty.back();
+        feature.clean(feature.object().absoluteTransformationMatrix());
+    }
+
+    return *this;
+}
+
+void SpatialIndex::candidates(const Range3D& box, const std::function<void(SpatialIndexFeature&)>& callback) const {
+    for(SpatialIndexFeature* feature: _state->large) callback(*feature);
+
+    /* Features in a cell can extend at most half a cell outside of it.
+       Calculated in floats, because the box can be infinite. */
+    const Vector3 min = Math::floor((box.min() - Vector3{_cellSize*0.5f})/_cellSize);
+    const Vector3 max = Math::floor((box.max() + Vector3{_cellSize*0.5f})/_cellSize);
+    Double cellCount = 1.0;
+    for(std::size_t i = 0; i != 3; ++i)
+        cellCount *= Math::max(Double(max[i]) - Double(min[i]) + 1.0, 0.0);
+
+    /* If the range covers more cells than there are occupied, go through the
+       occupied cells instead. The negated comparison handles NaNs as well. */
+    if(!(cellCount <= Double(_state->cells.size()))) {
+        for(const auto& cell: _state->cells) {
+            const Vector3 key{cell.first};
+            if((key < min).any() || (key > max).any()) continue;
+            for(SpatialIndexFeature* feature: cell.second) callback(*feature);
+        }
+        return;
+    }
+
+    const Vector3i mini{min}, maxi{max};
+    for(Int z = mini.z(); z <= maxi.z(); ++z)
+        for(Int y = mini.y(); y <= maxi.y(); ++y)
+            for(Int x = mini.x(); x <= maxi.x(); ++x) {
+                auto found = _state->cells.find({x, y, z});
+                if(found == _state->cells.end()) continue;
+                for(SpatialIndexFeature* feature: found->second) callback(*feature);
+            }
+}
+
+std::vector<std::reference_wrapper<SpatialIndexFeature>> SpatialIndex::queryBox(const Range3D& box) {
+    update();
+
+    std::vector<std::reference_wrapper<SpatialIndexFeature>> out;
+    candidates(box, [&](SpatialIndexFeature& feature) {
+        if(Math::intersects(box, feature._absoluteBounds))
+            out.push_back(feature);
+    });
+    return out;
+}
+
+std::vector<std::reference_wrapper<SpatialIndexFeature>> SpatialIndex::querySphere(const Vector3& center, const Float radius) {
+    update();
+
+    std::vector<std::reference_wrapper<SpatialIndexFeature>> out;
+    const Float radiusSquared = radius*radius;
+    candidates(Range3D::fromCenter(center, Vector3{radius}), [&](SpatialIndexFeature& feature) {
+        const Vector3 closest = Math::clamp(center, feature._absoluteBounds.min(), feature._absoluteBounds.max());
+        if((closest - center).dot() <= radiusSquared)
+            out.push_back(feature);
+    });
+    return out;
+}
+
+std::vector<std::reference_wrapper<SpatialIndexFeature>> SpatialIndex::queryFrustum(const Frustum& frustum) {
+    update();
+
+    std::vector<std::reference_wrapper<SpatialIndexFeature>> out;
+    for(SpatialIndexFeature* feature: _state->large)
+        if(Math::Intersection::rangeFrustum(feature->_absoluteBounds, frustum))
+            out.push_back(*feature);
+
+    /* Test whole cells first, including the half-cell overlap, and only then
+       the features inside */
+    for(const auto& cell: _state->cells) {
+        const Vector3 min = Vector3{cell.first}*_cellSize;
+        const Range3D cellBounds{min - Vector3{_cellSize*0.5f}, min + Vector3{_cellSize*1.5f}};
+        if(!Math::Intersection::rangeFrustum(cellBounds, frustum)) continue;
+
+        for(SpatialIndexFeature* feature: cell.second)
+            if(Math::Intersection::rangeFrustum(feature->_absoluteBounds, frustum))
+                out.push_back(*feature);
+    }
+
+    return out;
+}
+
+std::vector<std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>> SpatialIndex::queryRay(const Vector3& origin, const Vector3& direction, const Float maxDistance) {
+    update();
+
+    /* Bounding box of the ray. Zero direction components are handled
+       separately to avoid 0*inf producing a NaN. */
+    Vector3 end;
+    for(std::size_t i = 0; i != 3; ++i)
+        end[i] = direction[i] == 0.0f ? origin[i] : origin[i] + direction[i]*maxDistance;
+
+    std::vector<std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>> out;
+    candidates(Range3D{Math::min(origin, end), Math::max(origin, end)}, [&](SpatialIndexFeature& feature) {
+        /* Slab test */
+        const Range3D& bounds = feature._absoluteBounds;
+        Float tNear = 0.0f, tFar = maxDistance;
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(direction[i] == 0.0f) {
+                if(origin[i] < bounds.min()[i] || origin[i] > bounds.max()[i])
+                    return;
+                continue;
+            }
+
+            Float t1 = (bounds.min()[i] - origin[i])/direction[i];
+            Float t2 = (bounds.max()[i] - origin[i])/direction[i];
+            if(t1 > t2) std::swap(t1, t2);
+            tNear = Math::max(tNear, t1);
+            tFar = Math::min(tFar, t2);
+            if(tNear > tFar) return;
+        }
+
+        out.emplace_back(feature, tNear);
+    });
+
+    std::sort(out.begin(), out.end(), [](const std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>& a, const std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>& b) {
+        return a.second < b.second;
+    });
+    return out;
+}
+
+SpatialIndexFeature::SpatialIndexFeature(AbstractObject3D& object, const Range3D& bounds, SpatialIndex& index): AbstractFeature3D{object}, _index(index), _bounds{bounds} {
+    setCachedTransformations(CachedTransformation::Absolute);
+    ++_index._state->count;
+    _index.markDirty(*this);
+}
+
+SpatialIndexFeature::~SpatialIndexFeature() {
+    if(_inserted) _index.remove(*this);
+    _index.markClean(*this);
+    --_index._state->count;
+}
+
+SpatialIndexFeature& SpatialIndexFeature::setBounds(const Range3D& bounds) {
+    _bounds = bounds;
+    _index.markDirty(*this);
+    return *this;
+}
+
+void SpatialIndexFeature::markDirty() {
+    _index.markDirty(*this);
+}
+
+void SpatialIndexFeature::clean(const Matrix4& absoluteTransformationMatrix) {
+    _index.markClean(*this);
+
+    /* Transform the center and take absolute values of the rotation / scaling
+       part to get extents of the transformed box */
+    const Vector3 center = absoluteTransformationMatrix.transformPoint(_bounds.center());
+    const Vector3 halfSize = _bounds.size()*0.5f;
+    Vector3 extents;
+    for(std::size_t i = 0; i != 3; ++i)
+        extents[i] = Math::abs(absoluteTransformationMatrix[0][i])*halfSize[0] +
+                     Math::abs(absoluteTransformationMatrix[1][i])*halfSize[1] +
+                     Math::abs(absoluteTransformationMatrix[2][i])*halfSize[2];
+    _absoluteBounds = {center - extents, center + extents};
+
+    /* Move to another cell only if the cell actually changed */
+    if(_inserted) {
+        if(!_large && (_absoluteBounds.size() <= Vector3{_index._cellSize}).all() && Vector3i{Math::floor(center/_index._cellSize)} == _cell)
+            return;
+        _index.remove(*this);
+    }
+    _index.insert(*this);
+}
+
+}}
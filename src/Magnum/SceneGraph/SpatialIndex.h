@@ -0,0 +1,272 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialIndex, @ref Magnum::SceneGraph::SpatialIndexFeature
+ * @m_since_latest
+ */
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Dynamic spatial index of 3D objects
+@m_since_latest
+
+Allows to find objects near a point, inside a volume or along a ray without
+iterating over all objects and calculating their absolute transformation.
+Objects are added to the index by attaching a @ref SpatialIndexFeature with a
+local bounding box to them:
+
+@code{.cpp}
+SceneGraph::SpatialIndex index{4.0f};
+
+Object3D* object = new Object3D{&scene};
+new SceneGraph::SpatialIndexFeature{*object, Range3D{Vector3{-0.5f}, Vector3{0.5f}}, index};
+
+for(SceneGraph::SpatialIndexFeature& feature: index.querySphere({0.0f, 0.0f, 0.0f}, 10.0f))
+    Debug{} << "Object" << &feature.object() << "is near the origin";
+@endcode
+
+@section SceneGraph-SpatialIndex-updates Incremental updates
+
+The index is built on the @ref scenegraph-features-caching "dirty / clean mechanism"
+of the scene graph. When an object transformation changes, the feature
+remembers itself in the index as dirty. Before each query, all dirty objects
+are cleaned in a single batch using
+@ref AbstractObject::setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&),
+which calculates their absolute transformations and moves them to a
+different cell of the index if needed. Objects that didn't move since the
+last query cost nothing. If the objects are cleaned by other means in the
+meantime, such as by @ref Object::setClean(), the index gets updated as well.
+You can also call @ref update() explicitly, for example at a fixed point in
+the frame.
+
+@section SceneGraph-SpatialIndex-implementation Implementation
+
+The index is a loose hashed grid. Each object is put into exactly one cell
+based on the center of its absolute bounding box, which means moving an
+object is a constant-time operation. Cells are stored in a hash map so the
+grid is unbounded and only occupied cells use memory. Because an object can
+extend outside of its cell, queries additionally look into neighboring cells.
+Objects with bounding box larger than the cell size are kept in a separate
+list that is tested on every query, so the cell size should be chosen to be
+larger than a typical object, ideally about twice its size.
+
+Bounding boxes are axis-aligned in world space, calculated from the local
+bounding box and the absolute object transformation, so they're conservative
+for rotated objects. Queries test these bounding boxes, not the actual
+geometry.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex {
+    public:
+        /**
+         * @brief Constructor
+         * @param cellSize  Grid cell size
+         *
+         * Expects that the cell size is positive.
+         */
+        explicit SpatialIndex(Float cellSize);
+
+        /** @brief Copying is not allowed */
+        SpatialIndex(const SpatialIndex&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpatialIndex(SpatialIndex&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all features were removed from the index already,
+         * i.e. that the objects are destroyed before the index.
+         */
+        ~SpatialIndex();
+
+        /** @brief Copying is not allowed */
+        SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpatialIndex& operator=(SpatialIndex&&) = delete;
+
+        /** @brief Grid cell size */
+        Float cellSize() const { return _cellSize; }
+
+        /** @brief Count of features in the index */
+        std::size_t size() const;
+
+        /** @brief Whether the index is empty */
+        bool isEmpty() const { return !size(); }
+
+        /**
+         * @brief Count of features waiting for an update
+         *
+         * Features with a changed object transformation since the last
+         * @ref update().
+         */
+        std::size_t dirtyCount() const;
+
+        /**
+         * @brief Update the index
+         * @return Reference to self (for method chaining)
+         *
+         * Cleans objects of all dirty features and moves them to new
+         * cells. Called implicitly by all queries.
+         */
+        SpatialIndex& update();
+
+        /**
+         * @brief Features with bounding box intersecting given box
+         *
+         * Boxes touching only on the boundary are not considered
+         * intersecting. Order of the returned features is unspecified.
+         * @see @ref Math::intersects(const Range<dimensions, T>&, const Range<dimensions, T>&)
+         */
+        std::vector<std::reference_wrapper<SpatialIndexFeature>> queryBox(const Range3D& box);
+
+        /**
+         * @brief Features with bounding box intersecting given sphere
+         *
+         * Order of the returned features is unspecified.
+         */
+        std::vector<std::reference_wrapper<SpatialIndexFeature>> querySphere(const Vector3& center, Float radius);
+
+        /**
+         * @brief Features with bounding box intersecting given frustum
+         *
+         * Useful for culling, the test is conservative so some of the
+         * features might be actually outside of the frustum. Order of the
+         * returned features is unspecified.
+         * @see @ref Frustum::fromMatrix(),
+         *      @ref Math::Intersection::rangeFrustum()
+         */
+        std::vector<std::reference_wrapper<SpatialIndexFeature>> queryFrustum(const Frustum& frustum);
+
+        /**
+         * @brief Features with bounding box hit by given ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction length
+         *
+         * Returns features together with distance of the intersection from
+         * the ray origin, sorted front to back. Features containing the ray
+         * origin are returned with zero distance.
+         */
+        std::vector<std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>> queryRay(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf());
+
+    private:
+        friend SpatialIndexFeature;
+        struct State;
+
+        void insert(SpatialIndexFeature& feature);
+        void remove(SpatialIndexFeature& feature);
+        void markDirty(SpatialIndexFeature& feature);
+        void markClean(SpatialIndexFeature& feature);
+        void candidates(const Range3D& box, const std::function<void(SpatialIndexFeature&)>& callback) const;
+
+        Float _cellSize;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Feature adding an object to a spatial index
+@m_since_latest
+
+See @ref SpatialIndex for more information.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT SpatialIndexFeature: public AbstractFeature3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object to attach the feature to
+         * @param bounds    Bounding box in object local coordinates
+         * @param index     Spatial index to add the object to
+         */
+        explicit SpatialIndexFeature(AbstractObject3D& object, const Range3D& bounds, SpatialIndex& index);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the feature from the index.
+         */
+        ~SpatialIndexFeature();
+
+        /** @brief Spatial index the feature is in */
+        SpatialIndex& index() { return _index; }
+        const SpatialIndex& index() const { return _index; } /**< @overload */
+
+        /** @brief Bounding box in object local coordinates */
+        Range3D bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounding box in object local coordinates
+         * @return Reference to self (for method chaining)
+         *
+         * The index is updated on next query or @ref SpatialIndex::update().
+         */
+        SpatialIndexFeature& setBounds(const Range3D& bounds);
+
+        /**
+         * @brief Axis-aligned bounding box in world coordinates
+         *
+         * Calculated from @ref bounds() and absolute object transformation
+         * on last @ref SpatialIndex::update() or when the object was last
+         * cleaned.
+         */
+        Range3D absoluteBounds() const { return _absoluteBounds; }
+
+    private:
+        friend SpatialIndex;
+
+        void markDirty() override;
+        void clean(const Matrix4& absoluteTransformationMatrix) override;
+
+        SpatialIndex& _index;
+        Range3D _bounds, _absoluteBounds;
+
+        /* Position in the index. Cell key is valid only if the feature is
+           not in the list of large features. */
+        Vector3i _cell;
+        bool _large{};
+        bool _inserted{};
+        std::size_t _cellPosition{};
+        std::size_t _dirtyPosition{~std::size_t{}};
+};
+
+}}
+
+#endif
@@ -27,6 +27,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/FrameArena.h"
 #include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
@@ -50,6 +51,8 @@ struct CameraTest: TestSuite::Tester {
 
     void draw();
     void drawOrdered();
+    void drawArena();
+    void drawableTransformationsArena();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
@@ -67,7 +70,9 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeViewport,
 
               &CameraTest::draw,
-              &CameraTest::drawOrdered});
+              &CameraTest::drawOrdered,
+              &CameraTest::drawArena,
+              &CameraTest::drawableTransformationsArena});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -267,6 +272,93 @@ void CameraTest::drawOrdered() {
     }), TestSuite::Compare::Container);
 }
 
+void CameraTest::drawArena() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Matrix4& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Matrix4& result;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(&scene);
+    Matrix4 firstTransformation;
+    first.scale(Vector3(5.0f));
+    new Drawable(first, &group, firstTransformation);
+
+    Object3D second(&scene);
+    Matrix4 secondTransformation;
+    second.translate(Vector3::yAxis(3.0f));
+    new Drawable(second, &group, secondTransformation);
+
+    Object3D third(&second);
+    Matrix4 thirdTransformation;
+    third.translate(Vector3::zAxis(-1.5f));
+    new Drawable(third, &group, thirdTransformation);
+
+    Camera3D camera(third);
+
+    /* The arena is too small in the first frame, after that it shouldn't
+       need any more heap allocations */
+    FrameArena arena{16};
+    for(std::size_t frame = 0; frame != 3; ++frame) {
+        arena.reset();
+        camera.draw(arena, group);
+
+        CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+        CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+        CORRADE_COMPARE(thirdTransformation, Matrix4());
+    }
+
+    const std::size_t heapAllocationCount = arena.heapAllocationCount();
+    arena.reset();
+    camera.draw(arena, group);
+    CORRADE_COMPARE(arena.heapAllocationCount(), heapAllocationCount);
+}
+
+void CameraTest::drawableTransformationsArena() {
+    struct Drawable: SceneGraph::Drawable3D {
+        using SceneGraph::Drawable3D::Drawable3D;
+
+        void draw(const Matrix4&, Camera3D&) override {}
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D first(&scene);
+    first.scale(Vector3(5.0f));
+    SceneGraph::Drawable3D* firstDrawable = new Drawable{first, &group};
+
+    Object3D second(&first);
+    second.translate(Vector3::yAxis(3.0f));
+    SceneGraph::Drawable3D* secondDrawable = new Drawable{second, &group};
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(2.0f));
+    Camera3D camera(cameraObject);
+
+    FrameArena arena;
+    Containers::ArrayView<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> transformations = camera.drawableTransformations(arena, group);
+    CORRADE_COMPARE(transformations.size(), 2);
+    CORRADE_COMPARE(&transformations[0].first.get(), firstDrawable);
+    CORRADE_COMPARE(&transformations[1].first.get(), secondDrawable);
+
+    /* Should match the std::vector variant */
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> expected = camera.drawableTransformations(group);
+    CORRADE_COMPARE(transformations[0].second, expected[0].second);
+    CORRADE_COMPARE(transformations[1].second, expected[1].second);
+    CORRADE_COMPARE(transformations[1].second, Matrix4::translation(Vector3::zAxis(-2.0f))*Matrix4::scaling(Vector3(5.0f))*Matrix4::translation(Vector3::yAxis(3.0f)));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -26,8 +26,10 @@
 #include <sstream>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/FrameArena.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -47,6 +49,9 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsArena();
+    void transformationsArenaOrphan();
+    void transformationMatricesArena();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
@@ -84,6 +89,9 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsArena,
+              &ObjectTest::transformationsArenaOrphan,
+              &ObjectTest::transformationMatricesArena,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
@@ -310,6 +318,72 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsArena() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    const Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+    const Matrix4 firstExpected = initial*Matrix4::rotationZ(Deg(30.0f));
+    const Matrix4 secondExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f));
+    const Matrix4 thirdExpected = initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f));
+
+    /* Joints, duplicates and the scene itself */
+    const std::reference_wrapper<Object3D> objects[]{second, third, second, first, third, s};
+    const Matrix4 expected[]{secondExpected, thirdExpected, secondExpected, firstExpected, thirdExpected, initial};
+
+    /* Should give the same result as the std::vector variant and not
+       allocate anything on the heap once the arena is large enough */
+    FrameArena arena{4096};
+    for(std::size_t frame = 0; frame != 3; ++frame) {
+        arena.reset();
+        CORRADE_COMPARE_AS(s.transformations(arena, objects, initial),
+            Containers::arrayView(expected),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(arena.heapAllocationCount(), 1);
+    }
+
+    /* Empty list */
+    CORRADE_VERIFY(s.transformations(arena, {}, initial).empty());
+}
+
+void ObjectTest::transformationsArenaOrphan() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    Object3D orphan;
+    FrameArena arena;
+    const std::reference_wrapper<Object3D> objects[]{orphan};
+    CORRADE_VERIFY(s.transformations(arena, objects).empty());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+}
+
+void ObjectTest::transformationMatricesArena() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+
+    /* Through the type-erased interface */
+    const std::reference_wrapper<AbstractObject3D> objects[]{second, first};
+    const Matrix4 expected[]{
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        Matrix4::rotationZ(Deg(30.0f))
+    };
+
+    FrameArena arena;
+    const AbstractObject3D& scene = s;
+    CORRADE_COMPARE_AS(scene.transformationMatrices(arena, objects),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
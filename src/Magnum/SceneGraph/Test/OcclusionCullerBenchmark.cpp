@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/SceneGraph/OcclusionCuller.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct OcclusionCullerBenchmark: TestSuite::Tester {
+    explicit OcclusionCullerBenchmark();
+
+    void rasterize();
+    void test();
+};
+
+using namespace Math::Literals;
+
+OcclusionCullerBenchmark::OcclusionCullerBenchmark() {
+    addBenchmarks({&OcclusionCullerBenchmark::rasterize,
+                   &OcclusionCullerBenchmark::test}, 10);
+}
+
+constexpr Vector3 CubePositions[]{
+    {-1.0f, -1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    {-1.0f,  1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f},
+    {-1.0f, -1.0f,  1.0f},
+    { 1.0f, -1.0f,  1.0f},
+    {-1.0f,  1.0f,  1.0f},
+    { 1.0f,  1.0f,  1.0f}
+};
+
+constexpr UnsignedInt CubeIndices[]{
+    0, 2, 1, 1, 2, 3, /* -Z */
+    4, 5, 6, 5, 7, 6, /* +Z */
+    0, 4, 2, 2, 4, 6, /* -X */
+    1, 3, 5, 3, 7, 5, /* +X */
+    0, 1, 4, 1, 5, 4, /* -Y */
+    2, 6, 3, 3, 6, 7  /* +Y */
+};
+
+/* A city block grid seen from a street level. Buildings are 16x16 units
+   large with 8 units wide streets between them, the camera is looking along
+   a street. */
+constexpr Int GridSize = 32;
+
+Matrix4 cameraMatrix() {
+    return (Matrix4::translation({-12.0f, 2.0f, 0.0f})*
+        Matrix4::rotationY(-10.0_degf)).inverted();
+}
+
+Matrix4 buildingTransformation(Int x, Int z) {
+    return Matrix4::translation({x*24.0f - GridSize*12.0f, 20.0f, -z*24.0f - 24.0f})*
+        Matrix4::scaling({8.0f, 20.0f, 8.0f});
+}
+
+void OcclusionCullerBenchmark::rasterize() {
+    OcclusionCuller culler{{256, 128}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 2.0f, 0.1f, 1000.0f));
+    const Matrix4 camera = cameraMatrix();
+
+    CORRADE_BENCHMARK(10) {
+        culler.clear();
+        for(Int z = 0; z != GridSize; ++z)
+            for(Int x = 0; x != GridSize; ++x)
+                culler.addOccluder(camera*buildingTransformation(x, z), CubePositions, CubeIndices);
+    }
+}
+
+void OcclusionCullerBenchmark::test() {
+    OcclusionCuller culler{{256, 128}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 2.0f, 0.1f, 1000.0f));
+    const Matrix4 camera = cameraMatrix();
+    for(Int z = 0; z != GridSize; ++z)
+        for(Int x = 0; x != GridSize; ++x)
+            culler.addOccluder(camera*buildingTransformation(x, z), CubePositions, CubeIndices);
+
+    /* Small objects scattered in the streets */
+    Containers::Array<Matrix4> transformations{Containers::NoInit, 16384};
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformations[i] = camera*Matrix4::translation({
+            Float(i % 128)*6.0f - GridSize*12.0f,
+            0.5f,
+            -Float(i/128)*6.0f - 4.0f});
+
+    const Range3D bounds{Vector3{-0.5f}, Vector3{0.5f}};
+    std::size_t visible = 0;
+    CORRADE_BENCHMARK(1) {
+        visible = 0;
+        for(const Matrix4& transformation: transformations)
+            if(culler.isVisible(transformation, bounds)) ++visible;
+    }
+
+    /* Most objects are hidden behind the buildings or outside of the view,
+       but not all of them */
+    CORRADE_VERIFY(visible);
+    CORRADE_COMPARE_AS(visible, transformations.size()/4,
+        TestSuite::Compare::Less);
+
+    /* An object straight down the street the camera is in is visible, an
+       object in a cross street behind the building in the middle of the
+       view is not */
+    CORRADE_VERIFY(culler.isVisible(transformations[2*128 + 62], bounds));
+    CORRADE_VERIFY(!culler.isVisible(transformations[9*128 + 64], bounds));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionCullerBenchmark)
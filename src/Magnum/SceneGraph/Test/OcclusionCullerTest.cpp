@@ -0,0 +1,368 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/OcclusionCuller.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct OcclusionCullerTest: TestSuite::Tester {
+    explicit OcclusionCullerTest();
+
+    void construct();
+    void constructInvalidSize();
+    void constructMove();
+
+    void rasterize();
+    void rasterizeFillRule();
+    void rasterizePerspective();
+    void rasterizeBehindCamera();
+    void rasterizeNearPlane();
+    void rasterizeInvalidIndexCount();
+    void rasterizeIndexOutOfBounds();
+
+    void visible();
+    void visibleOutsideView();
+    void visibleCrossingCameraPlane();
+
+    void cull();
+};
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+OcclusionCullerTest::OcclusionCullerTest() {
+    addTests({&OcclusionCullerTest::construct,
+              &OcclusionCullerTest::constructInvalidSize,
+              &OcclusionCullerTest::constructMove,
+
+              &OcclusionCullerTest::rasterize,
+              &OcclusionCullerTest::rasterizeFillRule,
+              &OcclusionCullerTest::rasterizePerspective,
+              &OcclusionCullerTest::rasterizeBehindCamera,
+              &OcclusionCullerTest::rasterizeNearPlane,
+              &OcclusionCullerTest::rasterizeInvalidIndexCount,
+              &OcclusionCullerTest::rasterizeIndexOutOfBounds,
+
+              &OcclusionCullerTest::visible,
+              &OcclusionCullerTest::visibleOutsideView,
+              &OcclusionCullerTest::visibleCrossingCameraPlane,
+
+              &OcclusionCullerTest::cull});
+}
+
+/* A quad covering the middle of the view, split along the diagonal from
+   (0.5, -0.5) to (-0.5, 0.5) */
+constexpr Vector3 QuadPositions[]{
+    {-0.5f, -0.5f, 0.0f},
+    { 0.5f, -0.5f, 0.0f},
+    {-0.5f,  0.5f, 0.0f},
+    { 0.5f,  0.5f, 0.0f}
+};
+
+constexpr UnsignedInt QuadIndices[]{
+    0, 1, 2,
+    2, 1, 3
+};
+
+void OcclusionCullerTest::construct() {
+    OcclusionCuller culler{{64, 32}};
+    CORRADE_COMPARE(culler.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(culler.projectionMatrix(), Matrix4{});
+    CORRADE_COMPARE(culler.depth().size(), 64*32);
+    CORRADE_COMPARE(culler.depth()[0], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[64*32 - 1], Constants::inf());
+}
+
+void OcclusionCullerTest::constructInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    OcclusionCuller{{64, 30}};
+    OcclusionCuller{{0, 32}};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::OcclusionCuller: expected size to be a non-zero multiple of 8 but got Vector(64, 30)\n"
+        "SceneGraph::OcclusionCuller: expected size to be a non-zero multiple of 8 but got Vector(0, 32)\n");
+}
+
+void OcclusionCullerTest::constructMove() {
+    OcclusionCuller a{{64, 32}};
+    a.setProjectionMatrix(Matrix4::scaling(Vector3{2.0f}));
+    const Float* depth = a.depth().data();
+
+    OcclusionCuller b{std::move(a)};
+    CORRADE_COMPARE(b.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(b.projectionMatrix(), Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(b.depth().data(), depth);
+
+    OcclusionCuller c{{8, 8}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(c.depth().data(), depth);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<OcclusionCuller>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<OcclusionCuller>::value);
+}
+
+void OcclusionCullerTest::rasterize() {
+    OcclusionCuller culler{{64, 32}};
+    culler.addOccluder(Matrix4::translation(Vector3::zAxis(0.25f)), QuadPositions, QuadIndices);
+
+    /* The quad covers pixels from 16 to 47 in X and from 8 to 23 in Y */
+    CORRADE_COMPARE(culler.depth()[8*64 + 16], 0.25f);
+    CORRADE_COMPARE(culler.depth()[23*64 + 47], 0.25f);
+    CORRADE_COMPARE(culler.depth()[20*64 + 40], 0.25f);
+    CORRADE_COMPARE(culler.depth()[8*64 + 15], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[7*64 + 16], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[24*64 + 47], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[23*64 + 48], Constants::inf());
+
+    /* Pixels on the shared diagonal are covered as well */
+    CORRADE_COMPARE(culler.depth()[16*64 + 31], 0.25f);
+
+    /* A nearer occluder overwrites the depth, a farther one doesn't */
+    culler.addOccluder(Matrix4::translation({-0.5f, 0.0f, -0.5f}), QuadPositions, QuadIndices);
+    culler.addOccluder(Matrix4::translation({0.5f, 0.0f, 0.5f}), QuadPositions, QuadIndices);
+    CORRADE_COMPARE(culler.depth()[16*64 + 20], -0.5f);
+    CORRADE_COMPARE(culler.depth()[16*64 + 40], 0.25f);
+    CORRADE_COMPARE(culler.depth()[16*64 + 50], 0.5f);
+
+    culler.clear();
+    CORRADE_COMPARE(culler.depth()[20*64 + 40], Constants::inf());
+}
+
+void OcclusionCullerTest::rasterizeFillRule() {
+    OcclusionCuller culler{{64, 32}};
+
+    /* Shift the quad by half a pixel in both directions, so its edges go
+       through pixel centers at 16.5 and 48.5 in X and 8.5 and 24.5 in Y.
+       Only pixels on the left and top edge are covered. */
+    culler.addOccluder(Matrix4::translation({0.5f/32.0f, 0.5f/16.0f, 0.0f}), QuadPositions, QuadIndices);
+    CORRADE_COMPARE(culler.depth()[9*64 + 16], 0.0f);
+    CORRADE_COMPARE(culler.depth()[9*64 + 15], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[24*64 + 47], 0.0f);
+    CORRADE_COMPARE(culler.depth()[24*64 + 48], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[8*64 + 20], Constants::inf());
+    CORRADE_COMPARE(culler.depth()[25*64 + 20], Constants::inf());
+
+    /* The quad is exactly 32x16 pixels, so it covers exactly that many */
+    std::size_t covered = 0;
+    for(const Float depth: culler.depth())
+        if(depth != Constants::inf()) ++covered;
+    CORRADE_COMPARE(covered, 32*16);
+}
+
+void OcclusionCullerTest::rasterizePerspective() {
+    OcclusionCuller culler{{64, 64}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    /* A quad tilted away from the camera, so the depth increases to the
+       right */
+    culler.addOccluder(
+        Matrix4::translation(Vector3::zAxis(-2.0f))*
+        Matrix4::rotationY(30.0_degf), QuadPositions, QuadIndices);
+
+    const Float left = culler.depth()[32*64 + 28];
+    const Float right = culler.depth()[32*64 + 36];
+    CORRADE_VERIFY(left != Constants::inf());
+    CORRADE_VERIFY(right != Constants::inf());
+    CORRADE_COMPARE_AS(left, right, TestSuite::Compare::Less);
+
+    /* The depth is conservative -- never nearer than the actual depth at the
+       pixel center */
+    const Matrix4 matrix = culler.projectionMatrix()*
+        Matrix4::translation(Vector3::zAxis(-2.0f))*
+        Matrix4::rotationY(30.0_degf);
+    const Vector4 center = matrix*Vector4{0.0f, 0.0f, 0.0f, 1.0f};
+    CORRADE_COMPARE_AS(culler.depth()[32*64 + 32], center.z()/center.w() - 0.0001f,
+        TestSuite::Compare::Greater);
+}
+
+void OcclusionCullerTest::rasterizeBehindCamera() {
+    OcclusionCuller culler{{64, 64}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    /* Triangles crossing the camera plane are skipped */
+    culler.addOccluder(Matrix4::rotationX(90.0_degf), QuadPositions, QuadIndices);
+    for(const Float depth: culler.depth())
+        CORRADE_COMPARE(depth, Constants::inf());
+}
+
+void OcclusionCullerTest::rasterizeNearPlane() {
+    OcclusionCuller culler{{64, 64}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+
+    /* Between the camera and the near plane, nothing gets rasterized */
+    culler.addOccluder(Matrix4::translation(Vector3::zAxis(-0.05f)), QuadPositions, QuadIndices);
+    for(const Float depth: culler.depth())
+        CORRADE_COMPARE(depth, Constants::inf());
+
+    /* Crossing the near plane, skipped as well */
+    culler.addOccluder(Matrix4::translation(Vector3::zAxis(-0.1f))*Matrix4::rotationY(60.0_degf), QuadPositions, QuadIndices);
+    for(const Float depth: culler.depth())
+        CORRADE_COMPARE(depth, Constants::inf());
+
+    /* Right behind the near plane it's rasterized */
+    culler.addOccluder(Matrix4::translation(Vector3::zAxis(-0.2f)), QuadPositions, QuadIndices);
+    CORRADE_VERIFY(culler.depth()[32*64 + 32] != Constants::inf());
+}
+
+void OcclusionCullerTest::rasterizeInvalidIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    OcclusionCuller culler{{64, 32}};
+    const UnsignedInt indices[4]{};
+    culler.addOccluder({}, QuadPositions, indices);
+    CORRADE_COMPARE(out.str(), "SceneGraph::OcclusionCuller::addOccluder(): index count not divisible by 3\n");
+}
+
+void OcclusionCullerTest::rasterizeIndexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    OcclusionCuller culler{{64, 32}};
+    const UnsignedInt indices[]{0, 1, 4};
+    culler.addOccluder({}, QuadPositions, indices);
+    CORRADE_COMPARE(out.str(), "SceneGraph::OcclusionCuller::addOccluder(): index out of bounds for 4 vertices\n");
+}
+
+void OcclusionCullerTest::visible() {
+    OcclusionCuller culler{{64, 32}};
+    const Range3D box{Vector3{-0.1f}, Vector3{0.1f}};
+
+    /* Everything in the view is visible with no occluders */
+    CORRADE_VERIFY(culler.isVisible({}, box));
+
+    culler.addOccluder({}, QuadPositions, QuadIndices);
+
+    /* Behind the occluder, on either side of the diagonal and right behind
+       it */
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation({-0.25f, -0.25f, 0.5f}), box));
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation({0.25f, 0.25f, 0.5f}), box));
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation(Vector3::zAxis(0.5f)), box));
+
+    /* In front of the occluder */
+    CORRADE_VERIFY(culler.isVisible(Matrix4::translation(Vector3::zAxis(-0.5f)), box));
+
+    /* Intersecting the occluder */
+    CORRADE_VERIFY(culler.isVisible({}, box));
+
+    /* Behind, but sticking out on a side */
+    CORRADE_VERIFY(culler.isVisible(Matrix4::translation({0.45f, 0.0f, 0.5f}), box));
+}
+
+void OcclusionCullerTest::visibleOutsideView() {
+    OcclusionCuller culler{{64, 32}};
+    const Range3D box{Vector3{-0.1f}, Vector3{0.1f}};
+
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation(Vector3::xAxis(1.5f)), box));
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation(Vector3::yAxis(-1.5f)), box));
+    CORRADE_VERIFY(culler.isVisible(Matrix4::translation(Vector3::xAxis(1.0f)), box));
+}
+
+void OcclusionCullerTest::visibleCrossingCameraPlane() {
+    OcclusionCuller culler{{64, 64}};
+    culler.setProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f));
+    culler.addOccluder(Matrix4::translation(Vector3::zAxis(-1.0f))*Matrix4::scaling(Vector3{100.0f}), QuadPositions, QuadIndices);
+
+    /* Behind the occluder */
+    CORRADE_VERIFY(!culler.isVisible(Matrix4::translation(Vector3::zAxis(-5.0f)), Range3D{Vector3{-0.5f}, Vector3{0.5f}}));
+
+    /* Around the camera, can't say anything */
+    CORRADE_VERIFY(culler.isVisible({}, Range3D{Vector3{-0.5f}, Vector3{0.5f}}));
+}
+
+void OcclusionCullerTest::cull() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Matrix4>& result): SceneGraph::Drawable3D(object, group), _result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                _result.push_back(transformationMatrix);
+            }
+
+        private:
+            std::vector<Matrix4>& _result;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Matrix4> transformations;
+
+    Object3D behind{&scene};
+    behind.translate({-0.25f, -0.25f, 0.5f});
+    new Drawable{behind, &group, transformations};
+
+    Object3D front{&scene};
+    front.translate(Vector3::zAxis(-0.5f));
+    new Drawable{front, &group, transformations};
+
+    Object3D behindAside{&scene};
+    behindAside.translate({0.8f, 0.0f, 0.5f});
+    new Drawable{behindAside, &group, transformations};
+
+    Object3D behindCenter{&scene};
+    behindCenter.translate(Vector3::zAxis(0.5f));
+    new Drawable{behindCenter, &group, transformations};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    OcclusionCuller culler{{64, 32}};
+    culler.setProjectionMatrix(camera.projectionMatrix())
+        .addOccluder(camera.cameraMatrix(), QuadPositions, QuadIndices);
+
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> drawableTransformations = camera.drawableTransformations(group);
+    CORRADE_COMPARE(culler.cull(drawableTransformations, [](SceneGraph::Drawable3D&) {
+        return Range3D{Vector3{-0.1f}, Vector3{0.1f}};
+    }), 2);
+    CORRADE_COMPARE(drawableTransformations.size(), 2);
+
+    /* The order of the visible ones is preserved */
+    camera.draw(drawableTransformations);
+    CORRADE_COMPARE_AS(transformations, (std::vector<Matrix4>{
+        Matrix4::translation(Vector3::zAxis(-0.5f)),
+        Matrix4::translation({0.8f, 0.0f, 0.5f})
+    }), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionCullerTest)
@@ -0,0 +1,415 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Cube.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/OcclusionQueryCuller.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct OcclusionQueryCullerGLTest: GL::OpenGLTester {
+    explicit OcclusionQueryCullerGLTest();
+
+    void setup();
+    void teardown();
+
+    void construct();
+    void draw();
+    void drawCameraInside();
+    void drawNearPlaneInside();
+    void drawForgotten();
+    void clear();
+
+    private:
+        GL::Renderbuffer _color{NoCreate}, _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+typedef Object<MatrixTransformation3D> Object3D;
+typedef Scene<MatrixTransformation3D> Scene3D;
+
+struct Cube: Object3D, Drawable3D {
+    explicit Cube(Object3D* parent, DrawableGroup3D& group, Shaders::Flat3D& shader, GL::Mesh& mesh): Object3D{parent}, Drawable3D{*this, &group}, shader(shader), mesh(mesh) {}
+
+    void draw(const Matrix4& transformationMatrix, Camera3D& camera) override {
+        shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix);
+        mesh.draw(shader);
+        ++drawCount;
+    }
+
+    Shaders::Flat3D& shader;
+    GL::Mesh& mesh;
+    Int drawCount{};
+};
+
+struct BoxCuller: OcclusionQueryCuller {
+    explicit BoxCuller(Shaders::Flat3D& shader, GL::Mesh& mesh): shader(shader), mesh(mesh) {}
+
+    void drawBoundingBox(const Matrix4& transformationMatrix, const Range3D& bounds, Camera3D& camera) override {
+        shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix*Matrix4::translation(bounds.center())*Matrix4::scaling(bounds.size()/2.0f));
+        mesh.draw(shader);
+        ++boxCount;
+    }
+
+    Shaders::Flat3D& shader;
+    GL::Mesh& mesh;
+    Int boxCount{};
+};
+
+Range3D cubeBounds(Drawable3D&) {
+    return {Vector3{-1.0f}, Vector3{1.0f}};
+}
+
+constexpr Vector2i FramebufferSize{32};
+
+OcclusionQueryCullerGLTest::OcclusionQueryCullerGLTest() {
+    addTests({&OcclusionQueryCullerGLTest::construct});
+
+    addTests({&OcclusionQueryCullerGLTest::draw,
+              &OcclusionQueryCullerGLTest::drawCameraInside,
+              &OcclusionQueryCullerGLTest::drawNearPlaneInside,
+              &OcclusionQueryCullerGLTest::drawForgotten,
+              &OcclusionQueryCullerGLTest::clear},
+        &OcclusionQueryCullerGLTest::setup,
+        &OcclusionQueryCullerGLTest::teardown);
+}
+
+void OcclusionQueryCullerGLTest::setup() {
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        FramebufferSize);
+    _depth = GL::Renderbuffer{};
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent16, FramebufferSize);
+    _framebuffer = GL::Framebuffer{{{}, FramebufferSize}};
+    _framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+        .bind();
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void OcclusionQueryCullerGLTest::teardown() {
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+    _depth = GL::Renderbuffer{NoCreate};
+}
+
+bool hasConditionalRender() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::NV::conditional_render>();
+    #else
+    return false;
+    #endif
+}
+
+void OcclusionQueryCullerGLTest::construct() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh{NoCreate};
+    BoxCuller culler{shader, mesh};
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(culler.queryCount(), 0);
+    CORRADE_COMPARE(culler.drawnCount(), 0);
+    CORRADE_COMPARE(culler.culledCount(), 0);
+}
+
+void OcclusionQueryCullerGLTest::draw() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    /* A wall covering the whole view and a small cube behind it. The wall is
+       first so it fills the depth buffer before the cube gets drawn. */
+    DrawableGroup3D drawables;
+    Cube wall{&scene, drawables, shader, mesh};
+    wall.scale({10.0f, 10.0f, 1.0f})
+        .translate(Vector3::zAxis(-5.0f));
+    Cube cube{&scene, drawables, shader, mesh};
+    cube.translate(Vector3::zAxis(-20.0f));
+
+    BoxCuller culler{shader, mesh};
+
+    /* First frame, everything is assumed visible */
+    CORRADE_COMPARE(culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(culler.drawnCount(), 2);
+    CORRADE_COMPARE(culler.culledCount(), 0);
+    CORRADE_COMPARE(culler.queryCount(), 2);
+    CORRADE_COMPARE(wall.drawCount, 1);
+    CORRADE_COMPARE(cube.drawCount, 1);
+    CORRADE_COMPARE(culler.boxCount, 0);
+    CORRADE_VERIFY(culler.isVisible(wall));
+    CORRADE_VERIFY(culler.isVisible(cube));
+
+    /* Make sure the query results are available in the next frame */
+    GL::Renderer::finish();
+
+    /* Second frame, the cube got hidden. It's tested with a bounding box
+       and drawn conditionally if possible. */
+    _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    const std::size_t culled = culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(culler.isVisible(wall));
+    CORRADE_VERIFY(!culler.isVisible(cube));
+    CORRADE_COMPARE(culler.boxCount, 1);
+    CORRADE_COMPARE(wall.drawCount, 2);
+    if(hasConditionalRender()) {
+        CORRADE_COMPARE(culled, 0);
+        CORRADE_COMPARE(culler.drawnCount(), 2);
+        CORRADE_COMPARE(cube.drawCount, 2);
+    } else {
+        CORRADE_COMPARE(culled, 1);
+        CORRADE_COMPARE(culler.drawnCount(), 1);
+        CORRADE_COMPARE(cube.drawCount, 1);
+    }
+    CORRADE_COMPARE(culler.culledCount(), culled);
+
+    /* Finished queries got recycled */
+    CORRADE_COMPARE(culler.queryCount(), 2);
+
+    GL::Renderer::finish();
+
+    /* Remove the wall, the cube box query now passes */
+    drawables.remove(wall);
+    _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!culler.isVisible(cube));
+    CORRADE_COMPARE(culler.boxCount, 2);
+
+    GL::Renderer::finish();
+
+    /* And now the cube is visible again and drawn normally */
+    _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    CORRADE_COMPARE(culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(culler.isVisible(cube));
+    CORRADE_COMPARE(culler.boxCount, 2);
+    CORRADE_COMPARE(culler.queryCount(), 2);
+}
+
+void OcclusionQueryCullerGLTest::drawCameraInside() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    Cube wall{&scene, drawables, shader, mesh};
+    wall.scale({10.0f, 10.0f, 1.0f})
+        .translate(Vector3::zAxis(-5.0f));
+    /* The camera is inside a huge cube that's entirely hidden behind the
+       wall, as the front-facing sides are all behind the camera */
+    Cube cube{&scene, drawables, shader, mesh};
+    cube.scale(Vector3{50.0f})
+        .translate(Vector3::zAxis(-40.0f));
+
+    BoxCuller culler{shader, mesh};
+
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    GL::Renderer::finish();
+    _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+
+    /* The query reported the cube as hidden, but since the camera is inside
+       its bounds, it's drawn anyway */
+    CORRADE_COMPARE(culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(culler.isVisible(cube));
+    CORRADE_COMPARE(culler.drawnCount(), 2);
+    CORRADE_COMPARE(culler.boxCount, 0);
+    CORRADE_COMPARE(cube.drawCount, 2);
+}
+
+void OcclusionQueryCullerGLTest::drawNearPlaneInside() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    /* The camera is outside of the cube, but its front face is closer than
+       the near plane so it gets clipped away, and its back face is hidden
+       behind the wall. The sides are outside of the view. */
+    DrawableGroup3D drawables;
+    Cube wall{&scene, drawables, shader, mesh};
+    wall.scale({10.0f, 10.0f, 0.1f})
+        .translate(Vector3::zAxis(-1.0f));
+    Cube cube{&scene, drawables, shader, mesh};
+    cube.scale({50.0f, 50.0f, 1.0f})
+        .translate(Vector3::zAxis(-1.05f));
+
+    BoxCuller culler{shader, mesh};
+
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    GL::Renderer::finish();
+    _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+
+    /* The query reported the cube as hidden, but since the near plane
+       touches its bounds, it's drawn anyway */
+    CORRADE_COMPARE(culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(culler.isVisible(cube));
+    CORRADE_COMPARE(culler.drawnCount(), 2);
+    CORRADE_COMPARE(culler.boxCount, 0);
+    CORRADE_COMPARE(cube.drawCount, 2);
+}
+
+void OcclusionQueryCullerGLTest::drawForgotten() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    Cube a{&scene, drawables, shader, mesh};
+    a.translate(Vector3::zAxis(-5.0f));
+
+    BoxCuller culler{shader, mesh};
+
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(culler.queryCount(), 1);
+
+    /* Replacing the drawable with another recycles the query without
+       allocating a new one */
+    {
+        Cube b{&scene, drawables, shader, mesh};
+        b.translate(Vector3::zAxis(-5.0f));
+        drawables.remove(a);
+
+        culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(culler.queryCount(), 2);
+        CORRADE_COMPARE(culler.drawnCount(), 1);
+    }
+
+    Cube c{&scene, drawables, shader, mesh};
+    c.translate(Vector3::zAxis(-5.0f));
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(culler.queryCount(), 2);
+    CORRADE_VERIFY(culler.isVisible(c));
+}
+
+void OcclusionQueryCullerGLTest::clear() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(GL::Extensions::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Shaders::Flat3D shader;
+    GL::Mesh mesh = MeshTools::compile(Primitives::cubeSolid());
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    DrawableGroup3D drawables;
+    Cube wall{&scene, drawables, shader, mesh};
+    wall.scale({10.0f, 10.0f, 1.0f})
+        .translate(Vector3::zAxis(-5.0f));
+    Cube cube{&scene, drawables, shader, mesh};
+    cube.translate(Vector3::zAxis(-20.0f));
+
+    BoxCuller culler{shader, mesh};
+
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    GL::Renderer::finish();
+    culler.draw(camera, camera.drawableTransformations(drawables), cubeBounds);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!culler.isVisible(cube));
+
+    /* After clearing, the cube is considered visible again, but the query
+       objects are kept */
+    culler.clear();
+    CORRADE_VERIFY(culler.isVisible(cube));
+    CORRADE_COMPARE(culler.queryCount(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionQueryCullerGLTest)
@@ -0,0 +1,240 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct SpatialIndexBenchmark: TestSuite::Tester {
+    explicit SpatialIndexBenchmark();
+
+    void update();
+    void updateAll();
+    void queryBox();
+    void queryBoxBruteForce();
+    void querySphere();
+    void queryFrustum();
+    void queryRay();
+};
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexBenchmark::SpatialIndexBenchmark() {
+    addBenchmarks({&SpatialIndexBenchmark::update,
+                   &SpatialIndexBenchmark::updateAll,
+                   &SpatialIndexBenchmark::queryBox,
+                   &SpatialIndexBenchmark::queryBoxBruteForce,
+                   &SpatialIndexBenchmark::querySphere,
+                   &SpatialIndexBenchmark::queryFrustum,
+                   &SpatialIndexBenchmark::queryRay}, 10);
+}
+
+/* 100k unit-sized objects scattered in a 1000x100x1000 volume */
+constexpr std::size_t ObjectCount = 100000;
+
+struct Fixture {
+    explicit Fixture(): index{4.0f} {
+        objects.reserve(ObjectCount);
+        features.reserve(ObjectCount);
+        for(std::size_t i = 0; i != ObjectCount; ++i) {
+            Object3D* object = new Object3D{&scene};
+            object->translate({Float(random() % 1000) - 500.0f,
+                               Float(random() % 100) - 50.0f,
+                               Float(random() % 1000) - 500.0f});
+            features.push_back(new SpatialIndexFeature{*object, {Vector3{-0.5f}, Vector3{0.5f}}, index});
+            objects.push_back(object);
+        }
+        index.update();
+    }
+
+    UnsignedInt random() {
+        seed = seed*1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    /* Moves every step-th object by a small amount */
+    void move(std::size_t step) {
+        for(std::size_t i = 0; i < objects.size(); i += step)
+            objects[i]->translate({Float(random() % 5) - 2.0f, 0.0f, Float(random() % 5) - 2.0f});
+    }
+
+    UnsignedInt seed = 17;
+    SpatialIndex index;
+    Scene3D scene;
+    std::vector<Object3D*> objects;
+    std::vector<SpatialIndexFeature*> features;
+};
+
+/* Counts features for which given predicate on the absolute bounds is true
+   by testing all of them, to verify the index queries against */
+template<class F> std::size_t countBruteForce(const Fixture& fixture, F predicate) {
+    std::size_t count = 0;
+    for(SpatialIndexFeature* feature: fixture.features)
+        if(predicate(feature->absoluteBounds())) ++count;
+    return count;
+}
+
+Range3D queryBoxFor(Int i) {
+    return Range3D::fromCenter({Float(i % 100)*10.0f - 500.0f, 0.0f, Float(i/10) - 50.0f}, {5.0f, 50.0f, 5.0f});
+}
+
+void SpatialIndexBenchmark::update() {
+    Fixture fixture;
+
+    /* Every tenth object moves each frame */
+    std::size_t i = 0;
+    CORRADE_BENCHMARK(1) {
+        fixture.move(10 + (i++ % 2));
+        fixture.index.update();
+    }
+
+    CORRADE_COMPARE(fixture.index.dirtyCount(), 0);
+}
+
+void SpatialIndexBenchmark::updateAll() {
+    Fixture fixture;
+
+    CORRADE_BENCHMARK(1) {
+        fixture.move(1);
+        fixture.index.update();
+    }
+
+    CORRADE_COMPARE(fixture.index.dirtyCount(), 0);
+}
+
+void SpatialIndexBenchmark::queryBox() {
+    Fixture fixture;
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        found = 0;
+        for(Int i = 0; i != 1000; ++i)
+            found += fixture.index.queryBox(queryBoxFor(i)).size();
+    }
+
+    std::size_t expected = 0;
+    for(Int i = 0; i != 1000; ++i) {
+        const Range3D box = queryBoxFor(i);
+        expected += countBruteForce(fixture, [&](const Range3D& bounds) {
+            return Math::intersects(box, bounds);
+        });
+    }
+    CORRADE_COMPARE(found, expected);
+}
+
+void SpatialIndexBenchmark::queryBoxBruteForce() {
+    Fixture fixture;
+
+    /* Same as above, but testing all objects, for comparison */
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        found = 0;
+        for(Int i = 0; i != 1000; ++i) {
+            const Range3D box = queryBoxFor(i);
+            for(SpatialIndexFeature* feature: fixture.features)
+                if(Math::intersects(box, feature->absoluteBounds())) ++found;
+        }
+    }
+
+    /* Should find the same as the index */
+    std::size_t expected = 0;
+    for(Int i = 0; i != 1000; ++i)
+        expected += fixture.index.queryBox(queryBoxFor(i)).size();
+    CORRADE_COMPARE(found, expected);
+}
+
+void SpatialIndexBenchmark::querySphere() {
+    Fixture fixture;
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        found = 0;
+        for(Int i = 0; i != 1000; ++i)
+            found += fixture.index.querySphere({Float(i % 100)*10.0f - 500.0f, 0.0f, Float(i/10) - 50.0f}, 10.0f).size();
+    }
+
+    std::size_t expected = 0;
+    for(Int i = 0; i != 1000; ++i) {
+        const Vector3 center{Float(i % 100)*10.0f - 500.0f, 0.0f, Float(i/10) - 50.0f};
+        expected += countBruteForce(fixture, [&](const Range3D& bounds) {
+            return (Math::clamp(center, bounds.min(), bounds.max()) - center).dot() <= 10.0f*10.0f;
+        });
+    }
+    CORRADE_COMPARE(found, expected);
+}
+
+void SpatialIndexBenchmark::queryFrustum() {
+    Fixture fixture;
+
+    const Frustum frustum = Frustum::fromMatrix(
+        Matrix4::perspectiveProjection(60.0_degf, 16.0f/9.0f, 0.1f, 200.0f)*
+        Matrix4::rotationY(30.0_degf));
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        found = fixture.index.queryFrustum(frustum).size();
+    }
+
+    CORRADE_COMPARE(found, countBruteForce(fixture, [&](const Range3D& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, frustum);
+    }));
+}
+
+void SpatialIndexBenchmark::queryRay() {
+    Fixture fixture;
+
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(1) {
+        found = 0;
+        for(Int i = 0; i != 1000; ++i)
+            found += fixture.index.queryRay({Float(i % 100)*10.0f - 500.0f, 0.0f, -500.0f}, {0.0f, 0.0f, 1.0f}, 100.0f).size();
+    }
+
+    /* The rays go along Z, so it's enough to check the XY overlap and the Z
+       extent */
+    std::size_t expected = 0;
+    for(Int i = 0; i != 1000; ++i) {
+        const Float x = Float(i % 100)*10.0f - 500.0f;
+        expected += countBruteForce(fixture, [&](const Range3D& bounds) {
+            return x >= bounds.min().x() && x <= bounds.max().x() &&
+                0.0f >= bounds.min().y() && 0.0f <= bounds.max().y() &&
+                bounds.max().z() >= -500.0f && bounds.min().z() <= -400.0f;
+        });
+    }
+    CORRADE_COMPARE(found, expected);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexBenchmark)
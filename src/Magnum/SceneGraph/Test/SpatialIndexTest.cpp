@@ -0,0 +1,469 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void construct();
+    void constructInvalidCellSize();
+
+    void addRemove();
+    void addQueryNotMoved();
+    void update();
+    void updateMultipleFeatures();
+    void updateCleanedExternally();
+    void setBounds();
+    void absoluteBoundsRotated();
+
+    void queryBox();
+    void queryBoxLarge();
+    void queryBoxMoving();
+    void querySphere();
+    void queryFrustum();
+    void queryRay();
+    void queryRayMaxDistance();
+};
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::construct,
+              &SpatialIndexTest::constructInvalidCellSize,
+
+              &SpatialIndexTest::addRemove,
+              &SpatialIndexTest::addQueryNotMoved,
+              &SpatialIndexTest::update,
+              &SpatialIndexTest::updateMultipleFeatures,
+              &SpatialIndexTest::updateCleanedExternally,
+              &SpatialIndexTest::setBounds,
+              &SpatialIndexTest::absoluteBoundsRotated,
+
+              &SpatialIndexTest::queryBox,
+              &SpatialIndexTest::queryBoxLarge,
+              &SpatialIndexTest::queryBoxMoving,
+              &SpatialIndexTest::querySphere,
+              &SpatialIndexTest::queryFrustum,
+              &SpatialIndexTest::queryRay,
+              &SpatialIndexTest::queryRayMaxDistance});
+}
+
+const Range3D UnitBounds{Vector3{-0.5f}, Vector3{0.5f}};
+
+/* Indices of query results in the list of all features, sorted, so they can
+   be compared regardless of the order the index returned them in */
+std::vector<std::size_t> indices(const std::vector<std::reference_wrapper<SpatialIndexFeature>>& result, const std::vector<SpatialIndexFeature*>& features) {
+    std::vector<std::size_t> out;
+    for(SpatialIndexFeature& feature: result)
+        out.push_back(std::find(features.begin(), features.end(), &feature) - features.begin());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void SpatialIndexTest::construct() {
+    SpatialIndex index{4.0f};
+    CORRADE_COMPARE(index.cellSize(), 4.0f);
+    CORRADE_COMPARE(index.size(), 0);
+    CORRADE_VERIFY(index.isEmpty());
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_VERIFY(index.queryBox({Vector3{-100.0f}, Vector3{100.0f}}).empty());
+}
+
+void SpatialIndexTest::constructInvalidCellSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SpatialIndex{0.0f};
+    SpatialIndex{-1.0f};
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::SpatialIndex: expected positive cell size but got 0\n"
+        "SceneGraph::SpatialIndex: expected positive cell size but got -1\n");
+}
+
+void SpatialIndexTest::addRemove() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    Object3D* b = new Object3D{&scene};
+    SpatialIndexFeature* fa = new SpatialIndexFeature{*a, UnitBounds, index};
+    new SpatialIndexFeature{*b, UnitBounds, index};
+    CORRADE_COMPARE(&fa->index(), &index);
+    CORRADE_COMPARE(fa->bounds(), UnitBounds);
+    CORRADE_COMPARE(index.size(), 2);
+    CORRADE_COMPARE(index.dirtyCount(), 2);
+
+    /* Removing a feature that's not in the index yet */
+    delete fa;
+    CORRADE_COMPARE(index.size(), 1);
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+
+    index.update();
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_COMPARE(index.queryBox(UnitBounds).size(), 1);
+
+    /* Removing a feature that's in the index */
+    delete b;
+    CORRADE_COMPARE(index.size(), 0);
+    CORRADE_VERIFY(index.queryBox(UnitBounds).empty());
+}
+
+void SpatialIndexTest::addQueryNotMoved() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    /* The object is clean already and never moves, so the feature gets into
+       the index only through being marked dirty on construction */
+    Object3D* a = new Object3D{&scene};
+    a->translate({0.0f, 3.0f, 0.0f});
+    a->setClean();
+    SpatialIndexFeature* feature = new SpatialIndexFeature{*a, UnitBounds, index};
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+
+    CORRADE_COMPARE(index.queryBox({{-0.1f, 2.9f, -0.1f}, {0.1f, 3.1f, 0.1f}}).size(), 1);
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{-0.5f, 2.5f, -0.5f}, {0.5f, 3.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::update() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    a->translate({10.0f, 0.0f, 0.0f});
+    SpatialIndexFeature* feature = new SpatialIndexFeature{*a, UnitBounds, index};
+
+    index.update();
+    CORRADE_VERIFY(!a->isDirty());
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{9.5f, -0.5f, -0.5f}, {10.5f, 0.5f, 0.5f}}));
+
+    /* Moving the object within the same cell */
+    a->translate({0.5f, 0.0f, 0.0f});
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+    CORRADE_COMPARE(index.queryBox({{10.8f, -0.1f, -0.1f}, {10.9f, 0.1f, 0.1f}}).size(), 1);
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{10.0f, -0.5f, -0.5f}, {11.0f, 0.5f, 0.5f}}));
+
+    /* Moving the object to a different cell. Moving its parent marks it
+       dirty as well. */
+    Object3D* parent = new Object3D{&scene};
+    a->setParent(parent);
+    index.update();
+    parent->translate({-30.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+    CORRADE_VERIFY(index.queryBox({{10.8f, -0.1f, -0.1f}, {10.9f, 0.1f, 0.1f}}).empty());
+    CORRADE_COMPARE(index.queryBox({{-19.2f, -0.1f, -0.1f}, {-19.1f, 0.1f, 0.1f}}).size(), 1);
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{-20.0f, -0.5f, -0.5f}, {-19.0f, 0.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::updateMultipleFeatures() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    /* Two features on the same object, the object should be passed to
+       setClean() only once */
+    Object3D* a = new Object3D{&scene};
+    SpatialIndexFeature* small = new SpatialIndexFeature{*a, UnitBounds, index};
+    SpatialIndexFeature* big = new SpatialIndexFeature{*a, {Vector3{-1.5f}, Vector3{1.5f}}, index};
+    CORRADE_COMPARE(index.dirtyCount(), 2);
+
+    a->translate({0.0f, 5.0f, 0.0f});
+    index.update();
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_COMPARE(small->absoluteBounds(), (Range3D{{-0.5f, 4.5f, -0.5f}, {0.5f, 5.5f, 0.5f}}));
+    CORRADE_COMPARE(big->absoluteBounds(), (Range3D{{-1.5f, 3.5f, -1.5f}, {1.5f, 6.5f, 1.5f}}));
+    CORRADE_COMPARE(index.queryBox({{1.0f, 6.0f, 1.0f}, {2.0f, 7.0f, 2.0f}}).size(), 1);
+}
+
+void SpatialIndexTest::updateCleanedExternally() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    SpatialIndexFeature* feature = new SpatialIndexFeature{*a, UnitBounds, index};
+    index.update();
+
+    /* Cleaning the object directly updates the index as well */
+    a->translate({0.0f, 0.0f, 7.0f});
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+    a->setClean();
+    CORRADE_COMPARE(index.dirtyCount(), 0);
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{-0.5f, -0.5f, 6.5f}, {0.5f, 0.5f, 7.5f}}));
+    CORRADE_COMPARE(index.queryBox({{-0.1f, -0.1f, 6.9f}, {0.1f, 0.1f, 7.1f}}).size(), 1);
+}
+
+void SpatialIndexTest::setBounds() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    a->translate({0.0f, 0.0f, 7.0f});
+    SpatialIndexFeature* feature = new SpatialIndexFeature{*a, UnitBounds, index};
+    index.update();
+    CORRADE_VERIFY(index.queryBox({{1.9f, -0.1f, 6.9f}, {2.1f, 0.1f, 7.1f}}).empty());
+
+    /* The object is clean, but the bounds need to be updated anyway */
+    feature->setBounds({Vector3{-2.5f}, Vector3{2.5f}});
+    CORRADE_COMPARE(feature->bounds(), (Range3D{Vector3{-2.5f}, Vector3{2.5f}}));
+    CORRADE_COMPARE(index.dirtyCount(), 1);
+    CORRADE_COMPARE(index.queryBox({{1.9f, -0.1f, 6.9f}, {2.1f, 0.1f, 7.1f}}).size(), 1);
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{-2.5f, -2.5f, 4.5f}, {2.5f, 2.5f, 9.5f}}));
+}
+
+void SpatialIndexTest::absoluteBoundsRotated() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    Object3D* a = new Object3D{&scene};
+    a->rotateZ(90.0_degf)
+        .scale(Vector3{2.0f})
+        .translate({1.0f, 2.0f, 3.0f});
+    SpatialIndexFeature* feature = new SpatialIndexFeature{*a, {{-1.0f, -0.5f, -0.25f}, {1.0f, 0.5f, 0.25f}}, index};
+    index.update();
+    CORRADE_COMPARE(feature->absoluteBounds(), (Range3D{{0.0f, 0.0f, 2.5f}, {2.0f, 4.0f, 3.5f}}));
+}
+
+void SpatialIndexTest::queryBox() {
+    SpatialIndex index{2.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    for(const Vector3& position: {Vector3{0.0f, 0.0f, 0.0f},
+                                  Vector3{1.9f, 0.0f, 0.0f},
+                                  Vector3{2.1f, 0.0f, 0.0f},
+                                  Vector3{-3.0f, 0.0f, 0.0f},
+                                  Vector3{0.0f, 0.0f, 12.0f}}) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(position);
+        features.push_back(new SpatialIndexFeature{*object, UnitBounds, index});
+    }
+
+    /* Features overlapping neighboring cells are found as well, the objects
+       at 1.9 and 2.1 are in different cells */
+    CORRADE_COMPARE_AS(indices(index.queryBox({{1.5f, -1.0f, -1.0f}, {1.7f, 1.0f, 1.0f}}), features),
+        (std::vector<std::size_t>{1, 2}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.queryBox({{-2.6f, -1.0f, -1.0f}, {0.0f, 1.0f, 1.0f}}), features),
+        (std::vector<std::size_t>{0, 3}), TestSuite::Compare::Container);
+
+    /* Touching the boundary is not an intersection */
+    CORRADE_COMPARE_AS(indices(index.queryBox({{2.6f, -1.0f, -1.0f}, {3.0f, 1.0f, 1.0f}}), features),
+        (std::vector<std::size_t>{}), TestSuite::Compare::Container);
+
+    /* A box larger than the occupied area goes through occupied cells
+       instead */
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{-1000.0f}, Vector3{1000.0f}}), features),
+        (std::vector<std::size_t>{0, 1, 2, 3, 4}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{-Constants::inf()}, {Constants::inf(), Constants::inf(), 11.0f}}), features),
+        (std::vector<std::size_t>{0, 1, 2, 3}), TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::queryBoxLarge() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    Object3D* a = new Object3D{&scene};
+    features.push_back(new SpatialIndexFeature{*a, UnitBounds, index});
+    Object3D* b = new Object3D{&scene};
+    features.push_back(new SpatialIndexFeature{*b, {Vector3{-50.0f}, Vector3{50.0f}}, index});
+
+    /* The large object is found even far from the cell of its center */
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{40.0f}, Vector3{41.0f}}), features),
+        (std::vector<std::size_t>{1}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{60.0f}, Vector3{61.0f}}), features),
+        (std::vector<std::size_t>{}), TestSuite::Compare::Container);
+
+    /* Shrinking it moves it back to the grid */
+    features[1]->setBounds(UnitBounds);
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{40.0f}, Vector3{41.0f}}), features),
+        (std::vector<std::size_t>{}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.queryBox({Vector3{-0.1f}, Vector3{0.1f}}), features),
+        (std::vector<std::size_t>{0, 1}), TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::queryBoxMoving() {
+    SpatialIndex index{2.0f};
+    Scene3D scene;
+
+    /* Objects of varying size moving around pseudo-randomly, the result
+       should be always the same as a brute-force test */
+    UnsignedInt seed = 17;
+    auto random = [&seed](Float min, Float max) {
+        seed = seed*1103515245u + 12345u;
+        return min + (max - min)*Float((seed >> 8) & 0xffff)/Float(0xffff);
+    };
+
+    std::vector<Object3D*> objects;
+    std::vector<SpatialIndexFeature*> features;
+    for(std::size_t i = 0; i != 200; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate({random(-20.0f, 20.0f), random(-20.0f, 20.0f), random(-20.0f, 20.0f)});
+        objects.push_back(object);
+        features.push_back(new SpatialIndexFeature{*object, Range3D::fromCenter({}, Vector3{random(0.1f, 3.0f)}), index});
+    }
+
+    for(std::size_t iteration = 0; iteration != 10; ++iteration) {
+        /* Move only a part of the objects each time */
+        for(std::size_t i = iteration % 3; i < objects.size(); i += 3)
+            objects[i]->translate({random(-3.0f, 3.0f), random(-3.0f, 3.0f), random(-3.0f, 3.0f)});
+
+        const Range3D box = Range3D::fromCenter({random(-15.0f, 15.0f), random(-15.0f, 15.0f), random(-15.0f, 15.0f)}, Vector3{random(1.0f, 8.0f)});
+        std::vector<std::size_t> result = indices(index.queryBox(box), features);
+
+        std::vector<std::size_t> expected;
+        for(std::size_t i = 0; i != objects.size(); ++i) {
+            const Vector3 center = objects[i]->transformationMatrix().translation();
+            if(Math::intersects(box, Range3D::fromCenter(center, features[i]->bounds().size()*0.5f)))
+                expected.push_back(i);
+        }
+
+        CORRADE_COMPARE_AS(result, expected, TestSuite::Compare::Container);
+    }
+}
+
+void SpatialIndexTest::querySphere() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    for(const Vector3& position: {Vector3{0.0f, 0.0f, 0.0f},
+                                  Vector3{3.0f, 0.0f, 0.0f},
+                                  Vector3{3.0f, 3.0f, 0.0f},
+                                  Vector3{-8.0f, 0.0f, 0.0f}}) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(position);
+        features.push_back(new SpatialIndexFeature{*object, UnitBounds, index});
+    }
+
+    /* Closest point of the box at (3, 3) is at distance sqrt(2*2.5^2) = 3.54,
+       so it's outside, while the box at (3, 0) is at 2.5 */
+    CORRADE_COMPARE_AS(indices(index.querySphere({}, 3.0f), features),
+        (std::vector<std::size_t>{0, 1}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.querySphere({}, 3.6f), features),
+        (std::vector<std::size_t>{0, 1, 2}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(indices(index.querySphere({-5.0f, 0.0f, 0.0f}, 2.6f), features),
+        (std::vector<std::size_t>{3}), TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::queryFrustum() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    for(const Vector3& position: {Vector3{0.0f, 0.0f, -5.0f},
+                                  Vector3{0.0f, 0.0f, 5.0f},
+                                  Vector3{10.0f, 0.0f, -5.0f},
+                                  Vector3{2.3f, 0.0f, -5.0f},
+                                  Vector3{0.0f, -1.9f, -10.4f}}) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(position);
+        features.push_back(new SpatialIndexFeature{*object, UnitBounds, index});
+    }
+
+    /* Box from (-2, -2, -10) to (2, 2, 0), the last two objects intersect
+       it only partially */
+    const Frustum frustum = Frustum::fromMatrix(Matrix4::orthographicProjection({4.0f, 4.0f}, 0.0f, 10.0f));
+    CORRADE_COMPARE_AS(indices(index.queryFrustum(frustum), features),
+        (std::vector<std::size_t>{0, 3, 4}), TestSuite::Compare::Container);
+}
+
+void SpatialIndexTest::queryRay() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    for(const Vector3& position: {Vector3{10.0f, 0.0f, 0.0f},
+                                  Vector3{20.0f, 0.0f, 0.0f},
+                                  Vector3{5.0f, 0.0f, 0.0f},
+                                  Vector3{0.0f, 0.0f, 0.0f},
+                                  Vector3{10.0f, 5.0f, 0.0f},
+                                  Vector3{-10.0f, 0.0f, 0.0f}}) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(position);
+        features.push_back(new SpatialIndexFeature{*object, UnitBounds, index});
+    }
+
+    /* Sorted front to back, the box containing the origin is at zero
+       distance, the ones off the ray or behind it are not included. Direction
+       length scales the distance. */
+    std::vector<std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>> result = index.queryRay({}, {2.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(result.size(), 4);
+    CORRADE_COMPARE(&result[0].first.get(), features[3]);
+    CORRADE_COMPARE(result[0].second, 0.0f);
+    CORRADE_COMPARE(&result[1].first.get(), features[2]);
+    CORRADE_COMPARE(result[1].second, 2.25f);
+    CORRADE_COMPARE(&result[2].first.get(), features[0]);
+    CORRADE_COMPARE(result[2].second, 4.75f);
+    CORRADE_COMPARE(&result[3].first.get(), features[1]);
+    CORRADE_COMPARE(result[3].second, 9.75f);
+
+    /* Diagonal ray */
+    result = index.queryRay({0.0f, -5.0f, 0.0f}, Vector3{1.0f, 1.0f, 0.0f}.normalized());
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_COMPARE(&result[0].first.get(), features[2]);
+    CORRADE_COMPARE(result[0].second, 4.5f*Constants::sqrt2());
+    CORRADE_COMPARE(&result[1].first.get(), features[4]);
+    CORRADE_COMPARE(result[1].second, 9.5f*Constants::sqrt2());
+}
+
+void SpatialIndexTest::queryRayMaxDistance() {
+    SpatialIndex index{4.0f};
+    Scene3D scene;
+
+    std::vector<SpatialIndexFeature*> features;
+    for(const Vector3& position: {Vector3{0.0f, 0.0f, -5.0f},
+                                  Vector3{0.0f, 0.0f, -10.0f},
+                                  Vector3{0.0f, 0.0f, -15.0f}}) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(position);
+        features.push_back(new SpatialIndexFeature{*object, UnitBounds, index});
+    }
+
+    std::vector<std::pair<std::reference_wrapper<SpatialIndexFeature>, Float>> result = index.queryRay({}, {0.0f, 0.0f, -1.0f}, 10.0f);
+    CORRADE_COMPARE(result.size(), 2);
+    CORRADE_COMPARE(&result[0].first.get(), features[0]);
+    CORRADE_COMPARE(result[0].second, 4.5f);
+    CORRADE_COMPARE(&result[1].first.get(), features[1]);
+    CORRADE_COMPARE(result[1].second, 9.5f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
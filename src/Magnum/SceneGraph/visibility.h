@@ -40,9 +40,20 @@
     #define MAGNUM_SCENEGRAPH_EXPORT CORRADE_VISIBILITY_STATIC
 #endif
 #define MAGNUM_SCENEGRAPH_LOCAL CORRADE_VISIBILITY_LOCAL
+
+#ifndef MAGNUM_BUILD_STATIC
+    #ifdef MagnumSceneGraphGL_EXPORTS
+        #define MAGNUM_SCENEGRAPHGL_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_SCENEGRAPHGL_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_SCENEGRAPHGL_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
 #else
 #define MAGNUM_SCENEGRAPH_EXPORT
 #define MAGNUM_SCENEGRAPH_LOCAL
+#define MAGNUM_SCENEGRAPHGL_EXPORT
 #endif
 
 #endif
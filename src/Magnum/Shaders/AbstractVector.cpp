@@ -25,8 +25,10 @@
 
 #include "AbstractVector.h"
 
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Utility/Debug.h>
+
 #include "Magnum/GL/Texture.h"
-#include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
@@ -35,9 +37,46 @@ template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dime
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dimensions>::bindGlyphTableTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::InstancedGlyphs,
+        "Shaders::AbstractVector::bindGlyphTableTexture(): the shader was not created with instanced glyphs enabled", *this);
+    texture.bind(GlyphTableTextureLayer);
+    return *this;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHADERS_EXPORT AbstractVector<2>;
 template class MAGNUM_SHADERS_EXPORT AbstractVector<3>;
 #endif
 
+namespace Implementation {
+
+Debug& operator<<(Debug& debug, const AbstractVectorFlag value) {
+    debug << "Shaders::AbstractVector::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case AbstractVectorFlag::v: return debug << "::" #v;
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(InstancedGlyphs)
+        #endif
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const AbstractVectorFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::AbstractVector::Flags{}", {
+        #ifndef MAGNUM_TARGET_GLES2
+        AbstractVectorFlag::InstancedGlyphs
+        #endif
+        });
+}
+
+}
+
 }}
@@ -29,11 +29,23 @@
  * @brief Class @ref Magnum::Shaders::AbstractVector, typedef @ref Magnum::Shaders::AbstractVector2D, @ref Magnum::Shaders::AbstractVector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class AbstractVectorFlag: UnsignedByte {
+        #ifndef MAGNUM_TARGET_GLES2
+        InstancedGlyphs = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<AbstractVectorFlag> AbstractVectorFlags;
+}
+
 /**
 @brief Base for vector shaders
 
@@ -59,6 +71,51 @@ template<UnsignedInt dimensions> class AbstractVector: public GL::AbstractShader
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Glyph index
+         * @m_since_latest
+         *
+         * Index into the glyph table bound with @ref bindGlyphTableTexture(),
+         * @ref Magnum::UnsignedInt "UnsignedInt". Used only if
+         * @ref Flag::InstancedGlyphs is set, in which case it's expected to be
+         * an instanced attribute together with @ref Position, which then
+         * contains the bottom left corner of the glyph quad.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Integer attributes are not available in OpenGL ES
+         *      2.0 or WebGL 1.0.
+         */
+        typedef GL::Attribute<5, UnsignedInt> GlyphIndex;
+
+        /**
+         * @brief Glyph scale
+         * @m_since_latest
+         *
+         * Scale of the glyph quad size from the glyph table, applied around
+         * the bottom left corner, @ref Magnum::Float "Float". Used only if
+         * @ref Flag::InstancedGlyphs is set, in which case it's expected to be
+         * an instanced attribute together with @ref GlyphIndex.
+         * @requires_gles30 Instanced glyph rendering is not available in
+         *      OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef GL::Attribute<6, Float> GlyphScale;
+
+        /**
+         * @brief Glyph color
+         * @m_since_latest
+         *
+         * Multiplied with the color set on the shader,
+         * @ref Magnum::Color4 "Color4", usually supplied as a normalized
+         * @ref Magnum::Color4ub "Color4ub". Uses the same location as
+         * @ref Generic::Color4. Used only if @ref Flag::InstancedGlyphs is
+         * set, in which case it's expected to be an instanced attribute
+         * together with @ref GlyphIndex.
+         * @requires_gles30 Instanced glyph rendering is not available in
+         *      OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef GL::Attribute<3, Magnum::Color4> GlyphColor;
+        #endif
+
         enum: UnsignedInt {
             /**
              * Color shader output. @ref shaders-generic "Generic output",
@@ -68,6 +125,45 @@ template<UnsignedInt dimensions> class AbstractVector: public GL::AbstractShader
             ColorOutput = Generic<dimensions>::ColorOutput
         };
 
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         * @m_since_latest
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Instanced glyph rendering. Instead of a triangle mesh with
+             * @ref Position and @ref TextureCoordinates for each quad corner,
+             * the shader expects one instance per glyph with @ref Position
+             * being the quad bottom left corner and @ref GlyphIndex pointing
+             * into a glyph table bound with @ref bindGlyphTableTexture(),
+             * together with a per-glyph @ref GlyphScale and @ref GlyphColor.
+             * The quad is then expanded from @glsl gl_VertexID @ce, so the mesh is
+             * meant to be a four-vertex @ref MeshPrimitive::TriangleStrip
+             * without any per-vertex attributes. See
+             * @ref Text::InstancedRenderer for a renderer producing such
+             * meshes.
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Integer attributes and @glsl gl_VertexID @ce
+             *      are not available in OpenGL ES 2.0 or WebGL 1.0.
+             */
+            InstancedGlyphs = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         * @m_since_latest
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::AbstractVectorFlag Flag;
+        typedef Implementation::AbstractVectorFlags Flags;
+        #endif
+
         /** @brief Copying is not allowed */
         AbstractVector(const AbstractVector<dimensions>&) = delete;
 
@@ -86,6 +182,28 @@ template<UnsignedInt dimensions> class AbstractVector: public GL::AbstractShader
          */
         AbstractVector<dimensions>& bindVectorTexture(GL::Texture2D& texture);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind glyph table texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with @ref Flag::InstancedGlyphs
+         * enabled. The texture is expected to be in the format produced by
+         * @ref Text::GlyphTable, i.e. a @ref GL::TextureFormat::RGBA32F
+         * texture with two texels per glyph.
+         * @requires_gles30 Instanced glyph rendering is not available in
+         *      OpenGL ES 2.0 or WebGL 1.0.
+         */
+        AbstractVector<dimensions>& bindGlyphTableTexture(GL::Texture2D& texture);
+        #endif
+
+        /**
+         * @brief Flags
+         * @m_since_latest
+         */
+        Flags flags() const { return _flags; }
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -97,9 +215,16 @@ template<UnsignedInt dimensions> class AbstractVector: public GL::AbstractShader
            go above that. Binding 7 is used by TextureTools::DistanceField. */
         enum: Int { VectorTextureLayer = 6 };
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used only for instanced glyph rendering, which is ES3+ only */
+        enum: Int { GlyphTableTextureLayer = 5 };
+        #endif
+
         explicit AbstractVector(NoCreateT) noexcept: GL::AbstractShaderProgram{NoCreate} {}
-        explicit AbstractVector() = default;
+        explicit AbstractVector(Flags flags = {}): _flags{flags} {}
         ~AbstractVector() = default;
+
+        Flags _flags;
 };
 
 /** @brief Base for two-dimensional text shaders */
@@ -108,6 +233,26 @@ typedef AbstractVector<2> AbstractVector2D;
 /** @brief Base for three-dimensional text shader */
 typedef AbstractVector<3> AbstractVector3D;
 
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/**
+ * @debugoperatorclassenum{AbstractVector,AbstractVector::Flag}
+ * @m_since_latest
+ */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, AbstractVector<dimensions>::Flag value);
+
+/**
+ * @debugoperatorclassenum{AbstractVector,AbstractVector::Flags}
+ * @m_since_latest
+ */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, AbstractVector<dimensions>::Flags value);
+#else
+namespace Implementation {
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, AbstractVectorFlag value);
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, AbstractVectorFlags value);
+    CORRADE_ENUMSET_OPERATORS(AbstractVectorFlags)
+}
+#endif
+
 }}
 
 #endif
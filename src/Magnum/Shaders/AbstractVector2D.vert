@@ -47,9 +47,53 @@ layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
 
+#ifdef INSTANCED_GLYPHS
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_INDEX_ATTRIBUTE_LOCATION)
+#endif
+in highp uint glyphIndex;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_SCALE_ATTRIBUTE_LOCATION)
+#endif
+in highp float glyphScale;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 glyphColor;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+/* See AbstractVector.h for details about the ID */
+layout(binding = GLYPH_TABLE_TEXTURE_LAYER)
+#endif
+uniform highp sampler2D glyphTable;
+#endif
+
 out mediump vec2 fragmentTextureCoordinates;
+#ifdef INSTANCED_GLYPHS
+out lowp vec4 fragmentGlyphColor;
+#endif
 
 void main() {
+    #ifdef INSTANCED_GLYPHS
+    /* Two texels per glyph, 256 glyphs in a row, see Text::GlyphTable. The
+       first texel is the texture rectangle, the second contains quad size. */
+    highp ivec2 tableCoordinates = ivec2(int(glyphIndex % 256u)*2, int(glyphIndex/256u));
+    highp vec4 textureRectangle = texelFetch(glyphTable, tableCoordinates, 0);
+    highp vec2 quadSize = texelFetch(glyphTable, tableCoordinates + ivec2(1, 0), 0).xy*glyphScale;
+
+    /* Four-vertex triangle strip with the same corner order as the indexed
+       quads in Text::Renderer, position is the bottom left corner:
+       0---2
+       |   |
+       1---3 */
+    highp vec2 corner = vec2(float(gl_VertexID >> 1), float(1 - (gl_VertexID & 1)));
+    gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position + corner*quadSize, 1.0), 0.0);
+    fragmentTextureCoordinates = mix(textureRectangle.xy, textureRectangle.zw, corner);
+    fragmentGlyphColor = glyphColor;
+    #else
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     fragmentTextureCoordinates = textureCoordinates;
+    #endif
 }
@@ -68,6 +68,9 @@ layout(binding = 6)
 uniform lowp sampler2D vectorTexture;
 
 in mediump vec2 fragmentTextureCoordinates;
+#ifdef INSTANCED_GLYPHS
+in lowp vec4 fragmentGlyphColor;
+#endif
 
 #ifdef NEW_GLSL
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -80,7 +83,11 @@ void main() {
     lowp float intensity = texture(vectorTexture, fragmentTextureCoordinates).r;
 
     /* Fill color */
-    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
+    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*
+        #ifdef INSTANCED_GLYPHS
+        fragmentGlyphColor*
+        #endif
+        color;
 
     /* Outline */
     if(outlineRange.x > outlineRange.y) {
@@ -67,7 +67,27 @@ Common rendering setup:
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector: public AbstractVector<dimensions> {
     public:
-        explicit DistanceFieldVector();
+        /**
+         * @brief Flag
+         * @m_since_latest
+         *
+         * See @ref AbstractVector::Flag for more information.
+         */
+        typedef typename AbstractVector<dimensions>::Flag Flag;
+
+        /**
+         * @brief Flags
+         * @m_since_latest
+         *
+         * See @ref AbstractVector::Flags for more information.
+         */
+        typedef typename AbstractVector<dimensions>::Flags Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DistanceFieldVector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
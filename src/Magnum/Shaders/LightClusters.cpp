@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusters.h"
+
+#include <cmath>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+/* Point on a ray at given depth. The depth is infinite for the last slice, in
+   which case zero components have to stay zero instead of becoming NaN. */
+Vector3 pointAtDepth(const Vector3& ray, const Float depth) {
+    Vector3 out{Math::NoInit};
+    for(std::size_t i = 0; i != 3; ++i)
+        out[i] = ray[i] ? ray[i]*depth : 0.0f;
+    return out;
+}
+
+}
+
+LightClusters::LightClusters(const Vector3i& size): _size{size}, _lightIndices(LightIndexImageWidth) {
+    CORRADE_ASSERT(size.product(),
+        "Shaders::LightClusters: expected a non-zero size but got" << size, );
+
+    _clusters = Containers::Array<Vector2ui>{Containers::ValueInit, std::size_t(size.product())};
+}
+
+LightClusters::LightClusters(LightClusters&&) noexcept = default;
+
+LightClusters::~LightClusters() = default;
+
+LightClusters& LightClusters::operator=(LightClusters&&) noexcept = default;
+
+LightClusters& LightClusters::setProjection(const Matrix4& projectionMatrix, const Float near, const Float far) {
+    CORRADE_ASSERT(projectionMatrix[2][3] != 0.0f,
+        "Shaders::LightClusters::setProjection(): expected a perspective projection", *this);
+    CORRADE_ASSERT(near > 0.0f && near < far,
+        "Shaders::LightClusters::setProjection(): expected 0 < near < far but got" << near << "and" << far, *this);
+
+    /* Slice k spans depths from near*(far/near)^(k/Z) to
+       near*(far/near)^((k + 1)/Z), which gives k = log(depth)*s - b */
+    const Float logRatio = std::log(far/near);
+    _depthSliceParameters = {_size.z()/logRatio, _size.z()*std::log(near)/logRatio};
+
+    /* Directions of rays going through tile corners, scaled so they end at
+       a unit depth */
+    const Matrix4 inverted = projectionMatrix.inverted();
+    const Vector2i cornerCount = _size.xy() + Vector2i{1};
+    Containers::Array<Vector3> rays{Containers::NoInit, std::size_t(cornerCount.product())};
+    for(Int y = 0; y != cornerCount.y(); ++y) {
+        for(Int x = 0; x != cornerCount.x(); ++x) {
+            const Vector2 ndc = Vector2{Float(x), Float(y)}/Vector2{_size.xy()}*2.0f - Vector2{1.0f};
+            const Vector3 point = inverted.transformPoint({ndc, -1.0f});
+            rays[y*cornerCount.x() + x] = point/-point.z();
+        }
+    }
+
+    const std::size_t count = _clusters.size();
+    _bounds = Containers::Array<Float>{Containers::NoInit, 6*count};
+    for(Int z = 0; z != _size.z(); ++z) {
+        /* The first slice extends all the way to the camera, as fragments
+           closer than near are assigned to it, and the last slice extends to
+           infinity for the same reason */
+        const Float depthMin = z ? near*std::pow(far/near, Float(z)/_size.z()) : 0.0f;
+        const Float depthMax = z + 1 != _size.z() ? near*std::pow(far/near, Float(z + 1)/_size.z()) : Constants::inf();
+
+        for(Int y = 0; y != _size.y(); ++y) {
+            for(Int x = 0; x != _size.x(); ++x) {
+                const Vector3 corners[]{
+                    rays[y*cornerCount.x() + x],
+                    rays[y*cornerCount.x() + x + 1],
+                    rays[(y + 1)*cornerCount.x() + x],
+                    rays[(y + 1)*cornerCount.x() + x + 1]
+                };
+
+                Vector3 min{Constants::inf()}, max{-Constants::inf()};
+                for(const Vector3& corner: corners) {
+                    const Vector3 a = corner*depthMin;
+                    const Vector3 b = pointAtDepth(corner, depthMax);
+                    min = Math::min(min, Math::min(a, b));
+                    max = Math::max(max, Math::max(a, b));
+                }
+
+                const std::size_t i = (z*_size.y() + y)*_size.x() + x;
+                for(std::size_t j = 0; j != 3; ++j) {
+                    _bounds[j*count + i] = min[j];
+                    _bounds[(3 + j)*count + i] = max[j];
+                }
+            }
+        }
+    }
+
+    return *this;
+}
+
+Range3D LightClusters::clusterBounds(const Vector3i& cluster) const {
+    CORRADE_ASSERT(_bounds,
+        "Shaders::LightClusters::clusterBounds(): projection was not set", {});
+    CORRADE_ASSERT((cluster >= Vector3i{}).all() && (cluster < _size).all(),
+        "Shaders::LightClusters::clusterBounds(): cluster" << cluster << "out of bounds for" << _size << "clusters", {});
+
+    const std::size_t count = _clusters.size();
+    const std::size_t i = (cluster.z()*_size.y() + cluster.y())*_size.x() + cluster.x();
+    return {{_bounds[i], _bounds[count + i], _bounds[2*count + i]},
+            {_bounds[3*count + i], _bounds[4*count + i], _bounds[5*count + i]}};
+}
+
+LightClusters& LightClusters::assign(const Containers::StridedArrayView1D<const Vector4>& lights) {
+    CORRADE_ASSERT(_bounds,
+        "Shaders::LightClusters::assign(): projection was not set", *this);
+
+    const std::size_t count = _clusters.size();
+    const std::size_t tileCount = _size.xy().product();
+    _lightIndices.clear();
+
+    for(Int z = 0; z != _size.z(); ++z) {
+        const std::size_t sliceOffset = z*tileCount;
+        const Float* const minX = _bounds + sliceOffset;
+        const Float* const minY = minX + count;
+        const Float* const minZ = minY + count;
+        const Float* const maxX = minZ + count;
+        const Float* const maxY = maxX + count;
+        const Float* const maxZ = maxY + count;
+
+        /* Pick lights that overlap the slice depth range. All tiles in a
+           slice share the same Z bounds, so take them from the first. */
+        _sliceLights.clear();
+        for(std::size_t i = 0; i != lights.size(); ++i) {
+            const Vector4& light = lights[i];
+            if(light.z() - light.w() <= maxZ[0] && light.z() + light.w() >= minZ[0])
+                _sliceLights.push_back(UnsignedInt(i));
+        }
+
+        /* Test each light against all tiles in the slice. This loop is
+           branchless so it can be vectorized. */
+        _hits.resize(_sliceLights.size()*tileCount);
+        for(std::size_t j = 0; j != _sliceLights.size(); ++j) {
+            const Vector4& light = lights[_sliceLights[j]];
+            const Float x = light.x(), y = light.y(), lz = light.z();
+            const Float rangeSquared = light.w()*light.w();
+            UnsignedByte* const hits = _hits.data() + j*tileCount;
+            for(std::size_t i = 0; i != tileCount; ++i) {
+                const Float dx = Math::max(Math::max(minX[i] - x, x - maxX[i]), 0.0f);
+                const Float dy = Math::max(Math::max(minY[i] - y, y - maxY[i]), 0.0f);
+                const Float dz = Math::max(Math::max(minZ[i] - lz, lz - maxZ[i]), 0.0f);
+                hits[i] = dx*dx + dy*dy + dz*dz <= rangeSquared;
+            }
+        }
+
+        /* Gather the hits into per-cluster light lists */
+        for(std::size_t i = 0; i != tileCount; ++i) {
+            const std::size_t offset = _lightIndices.size();
+            for(std::size_t j = 0; j != _sliceLights.size(); ++j)
+                if(_hits[j*tileCount + i]) _lightIndices.push_back(_sliceLights[j]);
+            _clusters[sliceOffset + i] = {UnsignedInt(offset), UnsignedInt(_lightIndices.size() - offset)};
+        }
+    }
+
+    /* Pad to whole rows of the index image, having always at least one */
+    _lightIndexCount = _lightIndices.size();
+    _lightIndices.resize(Math::max(std::size_t(1), (_lightIndexCount + LightIndexImageWidth - 1)/LightIndexImageWidth)*LightIndexImageWidth, 0);
+
+    return *this;
+}
+
+ImageView3D LightClusters::clusterImage() const {
+    return ImageView3D{PixelFormat::RG32UI, _size, Containers::ArrayView<const Vector2ui>{_clusters}};
+}
+
+ImageView2D LightClusters::lightIndexImage() const {
+    return ImageView2D{PixelFormat::R32UI, {Int(LightIndexImageWidth), Int(_lightIndices.size()/LightIndexImageWidth)}, Containers::ArrayView<const UnsignedInt>{_lightIndices.data(), _lightIndices.size()}};
+}
+
+}}
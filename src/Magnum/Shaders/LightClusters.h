@@ -0,0 +1,220 @@
+#ifndef Magnum_Shaders_LightClusters_h
+#define Magnum_Shaders_LightClusters_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::LightClusters
+ * @m_since_latest
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Clustered light assignment
+@m_since_latest
+
+Subdivides the view frustum into a grid of clusters --- screen-space tiles
+along X and Y and exponentially distributed depth slices along Z --- and
+assigns point lights to them on the CPU, so a shader can iterate only the
+lights affecting a particular fragment instead of all lights in the scene. The
+result is consumed by the @ref Phong shader with @ref Phong::Flag::ClusteredLights
+enabled, but the data can be used by any other shader as well.
+
+@section Shaders-LightClusters-usage Usage
+
+Create the instance with desired cluster grid size and set the projection
+matrix. The cluster bounds get recalculated only when the projection changes:
+
+@snippet MagnumShaders.cpp LightClusters-usage1
+
+Then each frame pass the light positions in view space together with their
+range to @ref assign() and upload the data to textures:
+
+@snippet MagnumShaders.cpp LightClusters-usage2
+
+@section Shaders-LightClusters-data Data layout
+
+Clusters are ordered with X being the fastest-changing coordinate and Z being
+the slowest. For every cluster, @ref clusters() contains a pair of an offset
+into @ref lightIndices() and a count of lights in the cluster.
+
+The @ref lightIndices() array is ordered by cluster. Each depth slice is
+processed independently and all sphere-vs-cluster tests for a single light
+in a slice are done in a tight loop over a structure-of-arrays cluster bounds
+representation, allowing the compiler to vectorize it.
+*/
+class MAGNUM_SHADERS_EXPORT LightClusters {
+    public:
+        /**
+         * @brief Width of the light index image
+         *
+         * @see @ref lightIndexImage()
+         */
+        enum: UnsignedInt {
+            LightIndexImageWidth = 1024
+        };
+
+        /**
+         * @brief Constructor
+         * @param size      Count of clusters in each dimension. The X and Y
+         *      components are count of screen-space tiles, Z is count of
+         *      depth slices.
+         *
+         * Expects that all components of @p size are non-zero. Before calling
+         * @ref assign(), you need to call @ref setProjection().
+         */
+        explicit LightClusters(const Vector3i& size);
+
+        /** @brief Copying is not allowed */
+        LightClusters(const LightClusters&) = delete;
+
+        /** @brief Move constructor */
+        LightClusters(LightClusters&&) noexcept;
+
+        ~LightClusters();
+
+        /** @brief Copying is not allowed */
+        LightClusters& operator=(const LightClusters&) = delete;
+
+        /** @brief Move assignment */
+        LightClusters& operator=(LightClusters&&) noexcept;
+
+        /** @brief Cluster grid size */
+        Vector3i size() const { return _size; }
+
+        /**
+         * @brief Set projection
+         * @param projectionMatrix  Perspective projection matrix
+         * @param near              Distance of the first depth slice
+         * @param far               Distance of the last depth slice
+         * @return Reference to self (for method chaining)
+         *
+         * Calculates view-space bounds of all clusters. The depth slices are
+         * distributed exponentially between @p near and @p far, which don't
+         * need to match the near and far plane of @p projectionMatrix ---
+         * fragments closer than @p near are treated as being in the first
+         * slice and fragments farther than @p far as being in the last slice.
+         * Because of that, bounds of the first slice extend to the camera and
+         * bounds of the last slice to infinity.
+         * Expects that @p projectionMatrix is a perspective projection and
+         * that @cpp 0.0f < near < far @ce.
+         */
+        LightClusters& setProjection(const Matrix4& projectionMatrix, Float near, Float far);
+
+        /**
+         * @brief Bounds of given cluster
+         *
+         * View-space axis-aligned bounding box, calculated in
+         * @ref setProjection(). Expects that @p cluster is in bounds for
+         * @ref size().
+         */
+        Range3D clusterBounds(const Vector3i& cluster) const;
+
+        /**
+         * @brief Depth slice parameters
+         *
+         * Scale and bias, used to calculate a depth slice index @f$ k @f$
+         * from a view-space depth @f$ z @f$ as @f$ k = \log(-z) s - b @f$.
+         * Calculated in @ref setProjection().
+         */
+        Vector2 depthSliceParameters() const { return _depthSliceParameters; }
+
+        /**
+         * @brief Assign lights to clusters
+         * @param lights    View-space light positions in the XYZ components
+         *      and light ranges in the W component
+         * @return Reference to self (for method chaining)
+         *
+         * A light is assigned to all clusters intersected by a sphere of
+         * given position and range. Expects that @ref setProjection() was
+         * called before.
+         */
+        LightClusters& assign(const Containers::StridedArrayView1D<const Vector4>& lights);
+
+        /**
+         * @brief Clusters
+         *
+         * Offset into @ref lightIndices() and light count for every cluster.
+         * Contains @cpp size().product() @ce items, see
+         * @ref Shaders-LightClusters-data for more information.
+         */
+        Containers::ArrayView<const Vector2ui> clusters() const { return _clusters; }
+
+        /**
+         * @brief Light indices
+         *
+         * Indices into the @p lights array passed to the last @ref assign()
+         * call, ordered by cluster.
+         */
+        Containers::ArrayView<const UnsignedInt> lightIndices() const {
+            return {_lightIndices.data(), _lightIndexCount};
+        }
+
+        /**
+         * @brief Cluster image
+         *
+         * @ref clusters() as a three-dimensional @ref PixelFormat::RG32UI
+         * image of @ref size(), suitable for uploading to a texture.
+         */
+        ImageView3D clusterImage() const;
+
+        /**
+         * @brief Light index image
+         *
+         * @ref lightIndices() as a two-dimensional @ref PixelFormat::R32UI
+         * image of @ref LightIndexImageWidth columns and as many rows as
+         * needed to fit all indices, suitable for uploading to a texture. The
+         * last row is padded with zeros. Index @f$ i @f$ is at position
+         * @f$ (i \bmod w, \lfloor i / w \rfloor) @f$.
+         */
+        ImageView2D lightIndexImage() const;
+
+    private:
+        Vector3i _size;
+        Vector2 _depthSliceParameters;
+        /* Cluster bounds as six arrays (min X, Y, Z, max X, Y, Z), each
+           having size().product() items so the intersection tests can be
+           vectorized */
+        Containers::Array<Float> _bounds;
+        Containers::Array<Vector2ui> _clusters;
+        std::vector<UnsignedInt> _lightIndices;
+        std::size_t _lightIndexCount{};
+        /* Scratch memory for assign(), kept to avoid reallocations */
+        std::vector<UnsignedInt> _sliceLights;
+        std::vector<UnsignedByte> _hits;
+};
+
+}}
+
+#endif
@@ -35,11 +35,23 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Texture.h"
+#endif
 
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
 
 namespace Magnum { namespace Shaders {
 
+#ifndef MAGNUM_TARGET_GLES2
+namespace {
+    enum: Int {
+        VertexFetchIndexTextureLayer = 0,
+        VertexFetchPositionTextureLayer = 1
+    };
+}
+#endif
+
 MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
     #ifndef MAGNUM_TARGET_GLES2
     if(flags & Flag::Wireframe && !(flags & Flag::NoGeometryShader)) {
@@ -55,6 +67,11 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
         MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::OES::standard_derivatives);
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::VertexFetch)
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL310);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -77,6 +94,9 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
 
     vert.addSource(flags & Flag::Wireframe ? "#define WIREFRAME_RENDERING\n" : "")
         .addSource(flags & Flag::NoGeometryShader ? "#define NO_GEOMETRY_SHADER\n" : "")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags >= Flag::VertexFetch ? "#define VERTEX_FETCH\n" : "")
+        #endif
         #ifdef MAGNUM_TARGET_WEBGL
         .addSource("#define SUBSCRIPTING_WORKAROUND\n")
         #elif defined(MAGNUM_TARGET_GLES2)
@@ -145,6 +165,18 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
         }
     }
 
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::VertexFetch && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    #else
+    if(flags >= Flag::VertexFetch)
+    #endif
+    {
+        setUniform(uniformLocation("indexTexture"), VertexFetchIndexTextureLayer);
+        setUniform(uniformLocation("positionTexture"), VertexFetchPositionTextureLayer);
+    }
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     setTransformationProjectionMatrix({});
@@ -199,6 +231,16 @@ MeshVisualizer& MeshVisualizer::setSmoothness(const Float smoothness) {
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+MeshVisualizer& MeshVisualizer::bindVertexFetchTextures(GL::Texture2D& indices, GL::Texture2D& positions) {
+    CORRADE_ASSERT(_flags >= Flag::VertexFetch,
+        "Shaders::MeshVisualizer::bindVertexFetchTextures(): the shader was not created with vertex fetch enabled", *this);
+    indices.bind(VertexFetchIndexTextureLayer);
+    positions.bind(VertexFetchPositionTextureLayer);
+    return *this;
+}
+#endif
+
 Debug& operator<<(Debug& debug, const MeshVisualizer::Flag value) {
     debug << "Shaders::MeshVisualizer::Flag" << Debug::nospace;
 
@@ -207,6 +249,9 @@ Debug& operator<<(Debug& debug, const MeshVisualizer::Flag value) {
         #define _c(v) case MeshVisualizer::Flag::v: return debug << "::" #v;
         _c(NoGeometryShader)
         _c(Wireframe)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(VertexFetch)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -217,6 +262,10 @@ Debug& operator<<(Debug& debug, const MeshVisualizer::Flag value) {
 Debug& operator<<(Debug& debug, const MeshVisualizer::Flags value) {
     return Containers::enumSetDebugOutput(debug, value, "Shaders::MeshVisualizer::Flags{}", {
         MeshVisualizer::Flag::Wireframe,
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Contains NoGeometryShader, so has to be before */
+        MeshVisualizer::Flag::VertexFetch,
+        #endif
         /* Wireframe contains this on ES2 so it's not reported there */
         MeshVisualizer::Flag::NoGeometryShader
     });
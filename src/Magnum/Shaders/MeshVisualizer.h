@@ -59,11 +59,19 @@ If you have geometry shaders available, you don't need to do anything else.
     wireframe rendering using geometry shaders.
 
 If you don't have geometry shaders, you need to set @ref Flag::NoGeometryShader
-(it's enabled by default in OpenGL ES 2.0) and use only **non-indexed** triangle
-meshes (see @ref MeshTools::duplicate() for a possible solution). Additionaly,
-if you have OpenGL < 3.1 or OpenGL ES 2.0, you need to provide also the
+(it's enabled by default in OpenGL ES 2.0) and use triangle meshes where each
+triangle consists of vertices with distinct index modulo 3. That's either a
+**non-indexed** mesh (see @ref MeshTools::duplicate() for a possible solution)
+or an indexed mesh prepared using @ref MeshTools::duplicateForWireframe(),
+which duplicates only a small fraction of the vertices. Additionaly, if you
+have OpenGL < 3.1 or OpenGL ES 2.0, you need to provide also the
 @ref VertexIndex attribute.
 
+On OpenGL 3.1, OpenGL ES 3.0, WebGL 2.0 and newer, an indexed mesh can be also
+visualized without any duplication by enabling @ref Flag::VertexFetch. The
+index and position data are then uploaded to textures and the shader fetches
+them based on @cb{.glsl} gl_VertexID @ce of a non-indexed draw.
+
 @requires_gles30 Extension @gl_extension{OES,standard_derivatives} for
     wireframe rendering without geometry shaders.
 
@@ -92,6 +100,29 @@ Rendering setup:
 
 @snippet MagnumShaders.cpp MeshVisualizer-usage-no-geom2
 
+With @ref MeshTools::duplicateForWireframe(), the mesh setup keeps the
+indices and only the vertices that have to are duplicated:
+
+@snippet MagnumShaders.cpp MeshVisualizer-usage-no-geom-indexed
+
+Rendering setup is the same as above.
+
+@subsection Shaders-MeshVisualizer-usage-wireframe-vertex-fetch Wireframe visualization of indexed meshes using vertex fetch
+
+Both textures are addressed in a row-major order and their width can be
+arbitrary, the index texture is expected to have an unsigned integer format,
+the position texture a floating-point format with three or four components.
+Because the fetch is done using @cb{.glsl} texelFetch() @ce, the textures
+need to have @ref GL::SamplerFilter::Nearest filtering set in order to be
+complete. The mesh has no attributes and its count is the index count of the
+original mesh:
+
+@snippet MagnumShaders.cpp MeshVisualizer-usage-vertex-fetch1
+
+Rendering setup:
+
+@snippet MagnumShaders.cpp MeshVisualizer-usage-vertex-fetch2
+
 @subsection Shaders-MeshVisualizer-usage-wireframe-no-geom-old Wireframe visualization of non-indexed meshes without a geometry shader on older hardware
 
 You need to provide also the @ref VertexIndex attribute. Mesh setup *in
@@ -158,7 +189,26 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public GL::AbstractShaderProgram {
              * attribute in the mesh. In OpenGL ES 2.0 enabled alongside
              * @ref Flag::Wireframe.
              */
-            NoGeometryShader = 1 << 1
+            NoGeometryShader = 1 << 1,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Fetch vertex positions of an indexed mesh from textures bound
+             * with @ref bindVertexFetchTextures() instead of using the
+             * @ref Position attribute. The mesh is then drawn non-indexed,
+             * without any attributes and with a count equal to the index
+             * count. Implies @ref Flag::NoGeometryShader. See
+             * @ref Shaders-MeshVisualizer-usage-wireframe-vertex-fetch for
+             * more information.
+             * @requires_gl31 The @cb{.glsl} gl_VertexID @ce shader builtin
+             *      is not available in OpenGL < 3.1.
+             * @requires_gles30 Integer textures and the
+             *      @cb{.glsl} gl_VertexID @ce shader builtin are not
+             *      available in OpenGL ES 2.0 or WebGL 1.0.
+             * @m_since_latest
+             */
+            VertexFetch = (1 << 2)|(1 << 1)
+            #endif
         };
 
         /** @brief Flags */
@@ -251,6 +301,28 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public GL::AbstractShaderProgram {
          */
         MeshVisualizer& setSmoothness(Float smoothness);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind textures for vertex fetch
+         * @param indices       Index texture
+         * @param positions     Position texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with @ref Flag::VertexFetch
+         * enabled. The @p indices texture is expected to have an unsigned
+         * integer format such as @ref GL::TextureFormat::R32UI, the
+         * @p positions texture a floating-point format such as
+         * @ref GL::TextureFormat::RGB32F. Both need to have
+         * @ref GL::SamplerFilter::Nearest filtering set.
+         * @requires_gl31 The @cb{.glsl} gl_VertexID @ce shader builtin is
+         *      not available in OpenGL < 3.1.
+         * @requires_gles30 Integer textures are not available in OpenGL ES
+         *      2.0 or WebGL 1.0.
+         */
+        MeshVisualizer& bindVertexFetchTextures(GL::Texture2D& indices, GL::Texture2D& positions);
+        #endif
+
     private:
         Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
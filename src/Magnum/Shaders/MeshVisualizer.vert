@@ -37,10 +37,22 @@ uniform highp mat4 transformationProjectionMatrix
     #endif
     ;
 
+#ifdef VERTEX_FETCH
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform highp usampler2D indexTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform highp sampler2D positionTexture;
+#else
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
+#endif
 
 #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
 #if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
@@ -55,6 +67,15 @@ out vec3 barycentric;
 #endif
 
 void main() {
+    #ifdef VERTEX_FETCH
+    /* Fetch the index of the current vertex and then its position, both
+       textures are addressed in a row-major order */
+    highp int indexWidth = textureSize(indexTexture, 0).x;
+    highp int index = int(texelFetch(indexTexture, ivec2(gl_VertexID % indexWidth, gl_VertexID/indexWidth), 0).x);
+    highp int positionWidth = textureSize(positionTexture, 0).x;
+    highp vec4 position = vec4(texelFetch(positionTexture, ivec2(index % positionWidth, index/positionWidth), 0).xyz, 1.0);
+    #endif
+
     gl_Position = transformationProjectionMatrix*position;
 
     #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
@@ -40,6 +40,7 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
 
+#include "Magnum/Shaders/LightClusters.h"
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
 
 namespace Magnum { namespace Shaders {
@@ -49,7 +50,12 @@ namespace {
         AmbientTextureLayer = 0,
         DiffuseTextureLayer = 1,
         SpecularTextureLayer = 2,
-        NormalTextureLayer = 3
+        NormalTextureLayer = 3,
+        #ifndef MAGNUM_TARGET_GLES2
+        LightClusterTextureLayer = 4,
+        LightIndexTextureLayer = 5,
+        LightTextureLayer = 6
+        #endif
     };
 }
 
@@ -59,6 +65,15 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     if(!Utility::Resource::hasGroup("MagnumShaders"))
         importShaderResources();
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    const bool clusteredLights = !!(flags & Flag::ClusteredLights);
+    #else
+    constexpr bool clusteredLights = false;
+    #endif
+    /* With clustered lights the count isn't baked into the shader, so the
+       lighting calculation is there even if lightCount is zero */
+    _lighting = lightCount || clusteredLights;
+
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
@@ -72,7 +87,7 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
 
     #ifndef MAGNUM_TARGET_GLES
     std::string lightInitializer;
-    if(lightCount) {
+    if(lightCount && !clusteredLights) {
         /* Initializer for the light color array -- we need a list of vec4(1.0)
            joined by commas. For GLES we'll simply upload the values directly. */
         constexpr const char lightInitializerPreamble[] = "#define LIGHT_COLOR_INITIALIZER ";
@@ -95,6 +110,7 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     vert.addSource(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture) ? "#define TEXTURED\n" : "")
         .addSource(flags & Flag::NormalTexture ? "#define NORMAL_TEXTURE\n" : "")
         .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(clusteredLights ? "#define CLUSTERED_LIGHTS\n" : "")
         .addSource(Utility::formatString("#define LIGHT_COUNT {}\n", lightCount))
         .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
@@ -107,11 +123,12 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         #ifndef MAGNUM_TARGET_GLES2
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         #endif
+        .addSource(clusteredLights ? "#define CLUSTERED_LIGHTS\n" : "")
         .addSource(Utility::formatString(
             "#define LIGHT_COUNT {}\n"
             "#define LIGHT_COLORS_LOCATION {}\n", lightCount, _lightPositionsUniform + lightCount));
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) frag.addSource(std::move(lightInitializer));
+    if(lightCount && !clusteredLights) frag.addSource(std::move(lightInitializer));
     #endif
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.frag"));
@@ -128,9 +145,9 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     #endif
     {
         bindAttributeLocation(Position::Location, "position");
-        if(lightCount)
+        if(_lighting)
             bindAttributeLocation(Normal::Location, "normal");
-        if((flags & Flag::NormalTexture) && lightCount)
+        if((flags & Flag::NormalTexture) && _lighting)
             bindAttributeLocation(Tangent::Location, "tangent");
         if(flags & Flag::VertexColor)
             bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
@@ -154,13 +171,20 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         _transformationMatrixUniform = uniformLocation("transformationMatrix");
         _projectionMatrixUniform = uniformLocation("projectionMatrix");
         _ambientColorUniform = uniformLocation("ambientColor");
-        if(lightCount) {
+        if(_lighting) {
             _normalMatrixUniform = uniformLocation("normalMatrix");
             _diffuseColorUniform = uniformLocation("diffuseColor");
             _specularColorUniform = uniformLocation("specularColor");
             _shininessUniform = uniformLocation("shininess");
-            _lightPositionsUniform = uniformLocation("lightPositions");
-            _lightColorsUniform = uniformLocation("lightColors");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(clusteredLights)
+                _lightClusterParametersUniform = uniformLocation("lightClusterParameters");
+            else
+            #endif
+            {
+                _lightPositionsUniform = uniformLocation("lightPositions");
+                _lightColorsUniform = uniformLocation("lightColors");
+            }
         }
         if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
@@ -173,10 +197,17 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     #endif
     {
         if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
-        if(lightCount) {
+        if(_lighting) {
             if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
             if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureLayer);
             if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureLayer);
+            #ifndef MAGNUM_TARGET_GLES2
+            if(clusteredLights) {
+                setUniform(uniformLocation("lightClusterTexture"), LightClusterTextureLayer);
+                setUniform(uniformLocation("lightIndexTexture"), LightIndexTextureLayer);
+                setUniform(uniformLocation("lightTexture"), LightTextureLayer);
+            }
+            #endif
         }
     }
 
@@ -187,13 +218,14 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     else setAmbientColor(Magnum::Color4{0.0f});
     setTransformationMatrix({});
     setProjectionMatrix({});
-    if(lightCount) {
+    if(_lighting) {
         setDiffuseColor(Magnum::Color4{1.0f});
         setSpecularColor(Magnum::Color4{1.0f});
         setShininess(80.0f);
         if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
         /* Object ID is zero by default */
-        setLightColors(Containers::Array<Magnum::Color4>{Containers::DirectInit, lightCount, Magnum::Color4{1.0f}});
+        if(!clusteredLights)
+            setLightColors(Containers::Array<Magnum::Color4>{Containers::DirectInit, lightCount, Magnum::Color4{1.0f}});
         /* Light position is zero by default */
         setNormalMatrix({});
     }
@@ -213,33 +245,33 @@ Phong& Phong::bindAmbientTexture(GL::Texture2D& texture) {
 }
 
 Phong& Phong::setDiffuseColor(const Magnum::Color4& color) {
-    if(_lightCount) setUniform(_diffuseColorUniform, color);
+    if(_lighting) setUniform(_diffuseColorUniform, color);
     return *this;
 }
 
 Phong& Phong::bindDiffuseTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::DiffuseTexture,
         "Shaders::Phong::bindDiffuseTexture(): the shader was not created with diffuse texture enabled", *this);
-    if(_lightCount) texture.bind(DiffuseTextureLayer);
+    if(_lighting) texture.bind(DiffuseTextureLayer);
     return *this;
 }
 
 Phong& Phong::setSpecularColor(const Magnum::Color4& color) {
-    if(_lightCount) setUniform(_specularColorUniform, color);
+    if(_lighting) setUniform(_specularColorUniform, color);
     return *this;
 }
 
 Phong& Phong::bindSpecularTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::SpecularTexture,
         "Shaders::Phong::bindSpecularTexture(): the shader was not created with specular texture enabled", *this);
-    if(_lightCount) texture.bind(SpecularTextureLayer);
+    if(_lighting) texture.bind(SpecularTextureLayer);
     return *this;
 }
 
 Phong& Phong::bindNormalTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::NormalTexture,
         "Shaders::Phong::bindNormalTexture(): the shader was not created with normal texture enabled", *this);
-    if(_lightCount) texture.bind(NormalTextureLayer);
+    if(_lighting) texture.bind(NormalTextureLayer);
     return *this;
 }
 
@@ -251,7 +283,7 @@ Phong& Phong::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, GL::T
 }
 
 Phong& Phong::setShininess(Float shininess) {
-    if(_lightCount) setUniform(_shininessUniform, shininess);
+    if(_lighting) setUniform(_shininessUniform, shininess);
     return *this;
 }
 
@@ -277,7 +309,7 @@ Phong& Phong::setTransformationMatrix(const Matrix4& matrix) {
 }
 
 Phong& Phong::setNormalMatrix(const Matrix3x3& matrix) {
-    if(_lightCount) setUniform(_normalMatrixUniform, matrix);
+    if(_lighting) setUniform(_normalMatrixUniform, matrix);
     return *this;
 }
 
@@ -287,6 +319,10 @@ Phong& Phong::setProjectionMatrix(const Matrix4& matrix) {
 }
 
 Phong& Phong::setLightPositions(const Containers::ArrayView<const Vector3> positions) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags & Flag::ClusteredLights),
+        "Shaders::Phong::setLightPositions(): the shader was created with clustered lights", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == positions.size(),
         "Shaders::Phong::setLightPositions(): expected" << _lightCount << "items but got" << positions.size(), *this);
     if(_lightCount) setUniform(_lightPositionsUniform, positions);
@@ -294,6 +330,10 @@ Phong& Phong::setLightPositions(const Containers::ArrayView<const Vector3> posit
 }
 
 Phong& Phong::setLightPosition(UnsignedInt id, const Vector3& position) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags & Flag::ClusteredLights),
+        "Shaders::Phong::setLightPosition(): the shader was created with clustered lights", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightPosition(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightPositionsUniform + id, position);
@@ -307,6 +347,10 @@ Phong& Phong::setLightPositions(std::initializer_list<Vector3> lights) {
 }
 
 Phong& Phong::setLightColors(const Containers::ArrayView<const Magnum::Color4> colors) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags & Flag::ClusteredLights),
+        "Shaders::Phong::setLightColors(): the shader was created with clustered lights", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
     if(_lightCount) setUniform(_lightColorsUniform, colors);
@@ -320,12 +364,36 @@ Phong& Phong::setLightColors(std::initializer_list<Magnum::Color4> colors) {
 }
 
 Phong& Phong::setLightColor(UnsignedInt id, const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags & Flag::ClusteredLights),
+        "Shaders::Phong::setLightColor(): the shader was created with clustered lights", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightColorsUniform + id, color);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::bindLightClusterTextures(GL::Texture3D& clusters, GL::Texture2D& lightIndices, GL::Texture2D& lights) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::bindLightClusterTextures(): the shader was not created with clustered lights enabled", *this);
+    clusters.bind(LightClusterTextureLayer);
+    lightIndices.bind(LightIndexTextureLayer);
+    lights.bind(LightTextureLayer);
+    return *this;
+}
+
+Phong& Phong::setLightClusters(const LightClusters& clusters, const Vector2i& viewportSize) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::setLightClusters(): the shader was not created with clustered lights enabled", *this);
+    setUniform(_lightClusterParametersUniform, Vector4{
+        Vector2{clusters.size().xy()}/Vector2{viewportSize},
+        clusters.depthSliceParameters()});
+    return *this;
+}
+#endif
+
 Debug& operator<<(Debug& debug, const Phong::Flag value) {
     debug << "Shaders::Phong::Flag" << Debug::nospace;
 
@@ -340,6 +408,7 @@ Debug& operator<<(Debug& debug, const Phong::Flag value) {
         _c(VertexColor)
         #ifndef MAGNUM_TARGET_GLES2
         _c(ObjectId)
+        _c(ClusteredLights)
         #endif
         #undef _c
         /* LCOV_EXCL_STOP */
@@ -357,7 +426,8 @@ Debug& operator<<(Debug& debug, const Phong::Flags value) {
         Phong::Flag::AlphaMask,
         Phong::Flag::VertexColor,
         #ifndef MAGNUM_TARGET_GLES2
-        Phong::Flag::ObjectId
+        Phong::Flag::ObjectId,
+        Phong::Flag::ClusteredLights
         #endif
         });
 }
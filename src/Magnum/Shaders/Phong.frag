@@ -53,7 +53,7 @@ uniform lowp vec4 ambientColor
     #endif
     ;
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
 #ifdef DIFFUSE_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 1)
@@ -122,7 +122,31 @@ layout(location = 9)
 uniform highp uint objectId; /* defaults to zero */
 #endif
 
-#if LIGHT_COUNT
+#ifdef CLUSTERED_LIGHTS
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 4)
+#endif
+uniform highp usampler3D lightClusterTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 5)
+#endif
+uniform highp usampler2D lightIndexTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 6)
+#endif
+uniform highp sampler2D lightTexture;
+
+/* Location 10 is free as there are no light arrays in this case. XY is
+   cluster count divided by viewport size, ZW depth slice scale and bias. */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform highp vec4 lightClusterParameters; /* defaults to zero */
+#endif
+
+#if LIGHT_COUNT && !defined(CLUSTERED_LIGHTS)
 /* Needs to be last because it uses locations 10 + LIGHT_COUNT to
    10 + 2*LIGHT_COUNT - 1. Location 10 is lightPositions. Also it can't be
    specified as 10 + LIGHT_COUNT because that requires ARB_enhanced_layouts. */
@@ -136,12 +160,16 @@ uniform lowp vec4 lightColors[LIGHT_COUNT]
     ;
 #endif
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
 in mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
 in mediump vec3 transformedTangent;
 #endif
+#ifdef CLUSTERED_LIGHTS
+in highp vec3 viewPosition;
+#else
 in highp vec3 lightDirections[LIGHT_COUNT];
+#endif
 in highp vec3 cameraDirection;
 #endif
 
@@ -173,7 +201,7 @@ void main() {
         texture(ambientTexture, interpolatedTextureCoords)*
         #endif
         ambientColor;
-    #if LIGHT_COUNT
+    #if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
     lowp const vec4 finalDiffuseColor =
         #ifdef DIFFUSE_TEXTURE
         texture(diffuseTexture, interpolatedTextureCoords)*
@@ -192,7 +220,7 @@ void main() {
     /* Ambient color */
     fragmentColor = finalAmbientColor;
 
-    #if LIGHT_COUNT
+    #if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
     /* Normal */
     mediump vec3 normalizedTransformedNormal = normalize(transformedNormal);
     #ifdef NORMAL_TEXTURE
@@ -206,6 +234,44 @@ void main() {
     normalizedTransformedNormal = tbn*(texture(normalTexture, interpolatedTextureCoords).rgb*2.0 - vec3(1.0));
     #endif
 
+    #ifdef CLUSTERED_LIGHTS
+    /* Find the cluster this fragment belongs to */
+    highp ivec3 clusterCount = textureSize(lightClusterTexture, 0);
+    highp ivec3 cluster = clamp(ivec3(
+        gl_FragCoord.xy*lightClusterParameters.xy,
+        log(-viewPosition.z)*lightClusterParameters.z - lightClusterParameters.w),
+        ivec3(0), clusterCount - ivec3(1));
+    highp uvec2 clusterLights = texelFetch(lightClusterTexture, cluster, 0).xy;
+    highp int lightIndexTextureWidth = textureSize(lightIndexTexture, 0).x;
+
+    /* The alpha doesn't depend on the number of lights in the cluster */
+    fragmentColor.a += finalDiffuseColor.a;
+
+    /* Add diffuse and specular color for each light in the cluster */
+    for(highp int i = int(clusterLights.x), end = int(clusterLights.x + clusterLights.y); i < end; ++i) {
+        highp int light = int(texelFetch(lightIndexTexture, ivec2(i % lightIndexTextureWidth, i/lightIndexTextureWidth), 0).x);
+        highp vec4 lightPosition = texelFetch(lightTexture, ivec2(light, 0), 0);
+        lowp vec4 lightColor = texelFetch(lightTexture, ivec2(light, 1), 0);
+
+        /* Smoothly fade the light out towards its range so there are no
+           discontinuities on cluster boundaries */
+        highp vec3 lightDirection = lightPosition.xyz - viewPosition;
+        highp float distanceRatio = length(lightDirection)/lightPosition.w;
+        lowp float attenuation = clamp(1.0 - distanceRatio*distanceRatio*distanceRatio*distanceRatio, 0.0, 1.0);
+        attenuation *= attenuation;
+
+        highp vec3 normalizedLightDirection = normalize(lightDirection);
+        lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection))*attenuation;
+        fragmentColor.rgb += finalDiffuseColor.rgb*lightColor.rgb*intensity;
+
+        /* Add specular color, if needed */
+        if(intensity > 0.001) {
+            highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
+            mediump float specularity = clamp(pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess), 0.0, 1.0);
+            fragmentColor.rgb += finalSpecularColor.rgb*specularity*attenuation;
+        }
+    }
+    #else
     /* Add diffuse color for each light */
     for(int i = 0; i < LIGHT_COUNT; ++i) {
         highp vec3 normalizedLightDirection = normalize(lightDirections[i]);
@@ -220,6 +286,7 @@ void main() {
         }
     }
     #endif
+    #endif
 
     #ifdef ALPHA_MASK
     /* Using <= because if mask is set to 1.0, it should discard all, similarly
@@ -31,6 +31,7 @@
 
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Shaders.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
@@ -106,6 +107,21 @@ example.
 @requires_gles30 Object ID output requires integer buffer attachments, which
     are not available in OpenGL ES 2.0 or WebGL 1.0.
 
+@section Shaders-Phong-clustered-lights Clustered lights
+
+By default, the count of lights is baked into the shader and each fragment is
+shaded by all of them, which gets expensive with large light counts. With
+@ref Flag::ClusteredLights, lights are assigned to view-space clusters on the
+CPU using @ref LightClusters and each fragment iterates only the lights in its
+cluster. Unlike with the fixed light arrays, the light contribution fades out
+to zero at the light range. Light positions and colors are supplied through a
+texture instead of @ref setLightPositions() and @ref setLightColors():
+
+@snippet MagnumShaders.cpp Phong-usage-clustered
+
+@requires_gles30 Integer textures are not available in OpenGL ES 2.0 or WebGL
+    1.0.
+
 @section Shaders-Phong-zero-lights Zero lights
 
 Creating this shader with zero lights makes its output equivalent to the
@@ -113,7 +129,8 @@ Creating this shader with zero lights makes its output equivalent to the
 (if @ref Flag::AmbientTexture is enabled) are taken into account, which
 correspond to @ref Flat::setColor() and @ref Flat::bindTexture(). This is
 useful to reduce complexity in apps that render models with pre-baked lights.
-In addition, enabling @ref Flag::VertexColor and using a default ambient color with no texturing makes this shader equivalent to @ref VertexColor.
+This doesn't apply to @ref Flag::ClusteredLights, where the light count isn't
+baked into the shader and lighting is always enabled. In addition, enabling @ref Flag::VertexColor and using a default ambient color with no texturing makes this shader equivalent to @ref VertexColor.
 
 @see @ref shaders
 */
@@ -260,7 +277,19 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
              *      WebGL 1.0.
              * @m_since{2019,10}
              */
-            ObjectId = 1 << 6
+            ObjectId = 1 << 6,
+
+            /**
+             * Take lights from textures filled from @ref LightClusters
+             * instead of the fixed light arrays. See
+             * @ref Shaders-Phong-clustered-lights for more information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4} and
+             *      @gl_extension{EXT,texture_integer}
+             * @requires_gles30 Integer textures are not available in OpenGL
+             *      ES 2.0 or WebGL 1.0.
+             * @m_since_latest
+             */
+            ClusteredLights = 1 << 7
             #endif
         };
 
@@ -275,6 +304,12 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @brief Constructor
          * @param flags         Flags
          * @param lightCount    Count of light sources
+         *
+         * If @ref Flag::ClusteredLights is set, lights are taken from the
+         * textures passed to @ref bindLightClusterTextures() and
+         * @p lightCount isn't used for anything except being returned from
+         * @ref lightCount() --- it can be zero, the lighting calculation is
+         * enabled regardless.
          */
         explicit Phong(Flags flags = {}, UnsignedInt lightCount = 1);
 
@@ -488,7 +523,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * Initial values are zero vectors --- that will in most cases cause
          * the object to be rendered black (or in the ambient color), as the
          * lights are is inside of it. Expects that the size of the @p lights
-         * array is the same as @ref lightCount().
+         * array is the same as @ref lightCount() and that the shader was not
+         * created with @ref Flag::ClusteredLights.
          * @see @ref setLightPosition(UnsignedInt, const Vector3&),
          *      @ref setLightPosition(const Vector3&)
          */
@@ -524,7 +560,8 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          * @return Reference to self (for method chaining)
          *
          * Initial values are @cpp 0xffffffff_rgbaf @ce. Expects that the size
-         * of the @p colors array is the same as @ref lightCount().
+         * of the @p colors array is the same as @ref lightCount() and that
+         * the shader was not created with @ref Flag::ClusteredLights.
          */
         Phong& setLightColors(Containers::ArrayView<const Magnum::Color4> colors);
 
@@ -553,9 +590,62 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
             return setLightColors({&color, 1});
         }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Bind light cluster textures
+         * @param clusters      Cluster texture
+         * @param lightIndices  Light index texture
+         * @param lights        Light texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the shader was created with
+         * @ref Flag::ClusteredLights enabled. The @p clusters texture is
+         * expected to have a @ref GL::TextureFormat::RG32UI format and be
+         * filled from @ref LightClusters::clusterImage(), @p lightIndices a
+         * @ref GL::TextureFormat::R32UI format filled from
+         * @ref LightClusters::lightIndexImage(). The @p lights texture is
+         * expected to have a floating-point format, a width of at least the
+         * count of lights passed to @ref LightClusters::assign() and two
+         * rows, the first containing view-space light positions and ranges
+         * (i.e., the same data that were passed to
+         * @ref LightClusters::assign()) and the second light colors. All
+         * textures are accessed using @glsl texelFetch() @ce, so they need
+         * to have just a single level or have a non-mipmapped minification
+         * filter. See @ref Shaders-Phong-clustered-lights for more
+         * information.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4} and
+         *      @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Integer textures are not available in OpenGL ES
+         *      2.0 or WebGL 1.0.
+         */
+        Phong& bindLightClusterTextures(GL::Texture3D& clusters, GL::Texture2D& lightIndices, GL::Texture2D& lights);
+
+        /**
+         * @brief Set light cluster parameters
+         * @param clusters      Light clusters
+         * @param viewportSize  Size of the viewport the shader renders to
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Takes @ref LightClusters::size() and
+         * @ref LightClusters::depthSliceParameters() from @p clusters and uses
+         * them together with @p viewportSize to find a cluster for each
+         * fragment. Expects that the shader was created with
+         * @ref Flag::ClusteredLights enabled. Needs to be called again every
+         * time the cluster projection or the viewport changes.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4} and
+         *      @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Integer textures are not available in OpenGL ES
+         *      2.0 or WebGL 1.0.
+         */
+        Phong& setLightClusters(const LightClusters& clusters, const Vector2i& viewportSize);
+        #endif
+
     private:
         Flags _flags;
         UnsignedInt _lightCount;
+        bool _lighting;
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -569,6 +659,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
             #endif
         Int _lightPositionsUniform{10},
             _lightColorsUniform; /* 10 + lightCount, set in the constructor */
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used instead of the light arrays if ClusteredLights is set */
+        Int _lightClusterParametersUniform{10};
+        #endif
 };
 
 /** @debugoperatorclassenum{Phong,Phong::Flag} */
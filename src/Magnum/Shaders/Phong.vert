@@ -46,7 +46,7 @@ uniform highp mat4 projectionMatrix
     #endif
     ;
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -57,7 +57,7 @@ uniform mediump mat3 normalMatrix
     ;
 #endif
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT && !defined(CLUSTERED_LIGHTS)
 /* Needs to be last because it uses locations 10 to 10 + LIGHT_COUNT - 1 */
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 10)
@@ -70,7 +70,7 @@ layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = NORMAL_ATTRIBUTE_LOCATION)
 #endif
@@ -102,12 +102,16 @@ in lowp vec4 vertexColor;
 out lowp vec4 interpolatedVertexColor;
 #endif
 
-#if LIGHT_COUNT
+#if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
 out mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
 out mediump vec3 transformedTangent;
 #endif
+#ifdef CLUSTERED_LIGHTS
+out highp vec3 viewPosition;
+#else
 out highp vec3 lightDirections[LIGHT_COUNT];
+#endif
 out highp vec3 cameraDirection;
 #endif
 
@@ -116,16 +120,21 @@ void main() {
     highp vec4 transformedPosition4 = transformationMatrix*position;
     highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
-    #if LIGHT_COUNT
+    #if LIGHT_COUNT || defined(CLUSTERED_LIGHTS)
     /* Transformed normal and tangent vector */
     transformedNormal = normalMatrix*normal;
     #ifdef NORMAL_TEXTURE
     transformedTangent = normalMatrix*tangent;
     #endif
 
+    #ifdef CLUSTERED_LIGHTS
+    /* Lights are picked per fragment, pass the position there */
+    viewPosition = transformedPosition;
+    #else
     /* Direction to the light */
     for(int i = 0; i < LIGHT_COUNT; ++i)
         lightDirections[i] = normalize(lightPositions[i] - transformedPosition);
+    #endif
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
@@ -48,6 +48,7 @@ typedef Flat<3> Flat3D;
 
 /* Generic is used only statically */
 
+class LightClusters;
 class MeshVisualizer;
 class Phong;
 
@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/LightClusters.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct LightClustersBenchmark: TestSuite::Tester {
+    explicit LightClustersBenchmark();
+
+    void setProjection();
+    void assign();
+};
+
+using namespace Math::Literals;
+
+constexpr struct {
+    const char* name;
+    std::size_t lightCount;
+    Float range;
+} AssignData[]{
+    {"64 lights", 64, 10.0f},
+    {"512 lights", 512, 10.0f},
+    {"512 large lights", 512, 50.0f},
+    {"4096 lights", 4096, 5.0f}
+};
+
+LightClustersBenchmark::LightClustersBenchmark() {
+    addBenchmarks({&LightClustersBenchmark::setProjection}, 10);
+
+    addInstancedBenchmarks({&LightClustersBenchmark::assign}, 10,
+        Containers::arraySize(AssignData));
+}
+
+/* A common 16:9 setup with 16x9 tiles and 24 depth slices */
+constexpr Vector3i ClusterCount{16, 9, 24};
+
+Matrix4 projectionMatrix() {
+    return Matrix4::perspectiveProjection(60.0_degf, 16.0f/9.0f, 0.1f, 1000.0f);
+}
+
+void LightClustersBenchmark::setProjection() {
+    LightClusters clusters{ClusterCount};
+    const Matrix4 projection = projectionMatrix();
+
+    CORRADE_BENCHMARK(10) {
+        clusters.setProjection(projection, 0.1f, 500.0f);
+    }
+}
+
+void LightClustersBenchmark::assign() {
+    auto&& data = AssignData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    LightClusters clusters{ClusterCount};
+    clusters.setProjection(projectionMatrix(), 0.1f, 500.0f);
+
+    /* Lights scattered in a grid on a ground plane in front of the camera */
+    Containers::Array<Vector4> lights{Containers::NoInit, data.lightCount};
+    for(std::size_t i = 0; i != lights.size(); ++i)
+        lights[i] = {Float(i % 64)*4.0f - 128.0f, -2.0f, -Float(i/64)*4.0f - 1.0f, data.range};
+
+    CORRADE_BENCHMARK(1) {
+        clusters.assign(Containers::arrayView(lights));
+    }
+
+    /* Not all lights are in the frustum, but a light can't be in a cluster
+       more than once */
+    CORRADE_VERIFY(!clusters.lightIndices().empty());
+    CORRADE_COMPARE_AS(clusters.lightIndices().size(), data.lightCount*clusters.clusters().size(),
+        TestSuite::Compare::LessOrEqual);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClustersBenchmark)
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/LightClusters.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct LightClustersTest: TestSuite::Tester {
+    explicit LightClustersTest();
+
+    void construct();
+    void constructZeroSize();
+    void constructMove();
+
+    void setProjection();
+    void setProjectionNotPerspective();
+    void setProjectionInvalidRange();
+    void clusterBoundsOutOfRange();
+
+    void assign();
+    void assignNoLights();
+    void assignManyIndices();
+    void assignBeyondFar();
+    void assignNoProjection();
+};
+
+using namespace Math::Literals;
+
+LightClustersTest::LightClustersTest() {
+    addTests({&LightClustersTest::construct,
+              &LightClustersTest::constructZeroSize,
+              &LightClustersTest::constructMove,
+
+              &LightClustersTest::setProjection,
+              &LightClustersTest::setProjectionNotPerspective,
+              &LightClustersTest::setProjectionInvalidRange,
+              &LightClustersTest::clusterBoundsOutOfRange,
+
+              &LightClustersTest::assign,
+              &LightClustersTest::assignNoLights,
+              &LightClustersTest::assignManyIndices,
+              &LightClustersTest::assignBeyondFar,
+              &LightClustersTest::assignNoProjection});
+}
+
+void LightClustersTest::construct() {
+    LightClusters clusters{{4, 3, 2}};
+    CORRADE_COMPARE(clusters.size(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(clusters.clusters().size(), 24);
+    CORRADE_COMPARE(clusters.clusters()[23], (Vector2ui{}));
+    CORRADE_VERIFY(clusters.lightIndices().empty());
+
+    ImageView3D clusterImage = clusters.clusterImage();
+    CORRADE_COMPARE(clusterImage.format(), PixelFormat::RG32UI);
+    CORRADE_COMPARE(clusterImage.size(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(clusterImage.data().size(), 24*8);
+
+    ImageView2D lightIndexImage = clusters.lightIndexImage();
+    CORRADE_COMPARE(lightIndexImage.format(), PixelFormat::R32UI);
+    CORRADE_COMPARE(lightIndexImage.size(), (Vector2i{LightClusters::LightIndexImageWidth, 1}));
+}
+
+void LightClustersTest::constructZeroSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters{{4, 0, 2}};
+    CORRADE_COMPARE(out.str(), "Shaders::LightClusters: expected a non-zero size but got Vector(4, 0, 2)\n");
+}
+
+void LightClustersTest::constructMove() {
+    LightClusters a{{4, 3, 2}};
+    a.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), 1.0f, 100.0f);
+
+    LightClusters b{std::move(a)};
+    CORRADE_COMPARE(b.size(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(b.clusters().size(), 24);
+
+    LightClusters c{{1, 1, 1}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(c.clusters().size(), 24);
+    CORRADE_COMPARE(c.clusterBounds({3, 2, 1}), (Range3D{{5.0f, 10.0f/3.0f, -Constants::inf()}, {Constants::inf(), Constants::inf(), -10.0f}}));
+}
+
+void LightClustersTest::setProjection() {
+    /* With 90° FoV the frustum is from -depth to +depth in both X and Y */
+    LightClusters clusters{{2, 2, 2}};
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.5f, 200.0f), 1.0f, 100.0f);
+
+    /* The slices are exponentially distributed, the first one extends to the
+       camera and the last one to infinity */
+    CORRADE_COMPARE(clusters.depthSliceParameters(), (Vector2{2.0f/std::log(100.0f), 0.0f}));
+    CORRADE_COMPARE(clusters.clusterBounds({0, 0, 0}), (Range3D{{-10.0f, -10.0f, -10.0f}, {0.0f, 0.0f, 0.0f}}));
+    CORRADE_COMPARE(clusters.clusterBounds({1, 1, 0}), (Range3D{{0.0f, 0.0f, -10.0f}, {10.0f, 10.0f, 0.0f}}));
+    CORRADE_COMPARE(clusters.clusterBounds({1, 0, 1}), (Range3D{{0.0f, -Constants::inf(), -Constants::inf()}, {Constants::inf(), 0.0f, -10.0f}}));
+
+    /* Slice index calculated from the parameters matches the bounds */
+    const Vector2 parameters = clusters.depthSliceParameters();
+    CORRADE_COMPARE(std::log(5.0f)*parameters.x() - parameters.y(), std::log(5.0f)/std::log(10.0f));
+    CORRADE_COMPARE(std::log(10.0f)*parameters.x() - parameters.y(), 1.0f);
+    CORRADE_COMPARE(std::log(100.0f)*parameters.x() - parameters.y(), 2.0f);
+}
+
+void LightClustersTest::setProjectionNotPerspective() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters{{2, 2, 2}};
+    clusters.setProjection(Matrix4::orthographicProjection({2.0f, 2.0f}, 1.0f, 100.0f), 1.0f, 100.0f);
+    CORRADE_COMPARE(out.str(), "Shaders::LightClusters::setProjection(): expected a perspective projection\n");
+}
+
+void LightClustersTest::setProjectionInvalidRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters{{2, 2, 2}};
+    const Matrix4 projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f);
+    clusters.setProjection(projection, 0.0f, 100.0f);
+    clusters.setProjection(projection, 10.0f, 10.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusters::setProjection(): expected 0 < near < far but got 0 and 100\n"
+        "Shaders::LightClusters::setProjection(): expected 0 < near < far but got 10 and 10\n");
+}
+
+void LightClustersTest::clusterBoundsOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters{{2, 2, 2}};
+    clusters.clusterBounds({});
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), 1.0f, 100.0f);
+    clusters.clusterBounds({1, 2, 1});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusters::clusterBounds(): projection was not set\n"
+        "Shaders::LightClusters::clusterBounds(): cluster Vector(1, 2, 1) out of bounds for Vector(2, 2, 2) clusters\n");
+}
+
+void LightClustersTest::assign() {
+    LightClusters clusters{{2, 2, 2}};
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), 1.0f, 100.0f);
+
+    const Vector4 lights[]{
+        /* Inside cluster {0, 0, 1} only */
+        {-50.0f, -50.0f, -50.0f, 1.0f},
+        /* Touching all clusters */
+        {0.0f, 0.0f, -10.0f, 1.0f},
+        /* Behind the camera */
+        {0.0f, 0.0f, 5.0f, 1.0f},
+        /* Inside cluster {1, 1, 0} and {1, 1, 1} */
+        {5.0f, 5.0f, -9.5f, 1.0f}
+    };
+    clusters.assign(lights);
+
+    CORRADE_COMPARE_AS(clusters.clusters(), (Containers::Array<Vector2ui>{Containers::InPlaceInit, {
+        {0, 1}, {1, 1}, {2, 1}, {3, 2},
+        {5, 2}, {7, 1}, {8, 1}, {9, 2}
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(clusters.lightIndices(), (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {
+        1, 1, 1, 1, 3,
+        0, 1, 1, 1, 1, 3
+    }}), TestSuite::Compare::Container);
+
+    ImageView2D lightIndexImage = clusters.lightIndexImage();
+    CORRADE_COMPARE(lightIndexImage.size(), (Vector2i{LightClusters::LightIndexImageWidth, 1}));
+    CORRADE_COMPARE(lightIndexImage.pixels<UnsignedInt>()[0][4], 3);
+    /* Padded with zeros */
+    CORRADE_COMPARE(lightIndexImage.pixels<UnsignedInt>()[0][11], 0);
+
+    ImageView3D clusterImage = clusters.clusterImage();
+    CORRADE_COMPARE(clusterImage.pixels<Vector2ui>()[1][0][1], (Vector2ui{7, 1}));
+}
+
+void LightClustersTest::assignNoLights() {
+    LightClusters clusters{{2, 2, 2}};
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), 1.0f, 100.0f);
+
+    const Vector4 lights[]{{0.0f, 0.0f, -10.0f, 1.0f}};
+    clusters.assign(lights);
+    CORRADE_COMPARE(clusters.lightIndices().size(), 8);
+
+    /* Assigning again discards the previous state */
+    clusters.assign(nullptr);
+    CORRADE_VERIFY(clusters.lightIndices().empty());
+    CORRADE_COMPARE(clusters.clusters()[7], (Vector2ui{0, 0}));
+    CORRADE_COMPARE(clusters.lightIndexImage().size(), (Vector2i{LightClusters::LightIndexImageWidth, 1}));
+}
+
+void LightClustersTest::assignManyIndices() {
+    LightClusters clusters{{4, 4, 4}};
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), 1.0f, 100.0f);
+
+    /* 20 huge lights covering everything, which makes 1280 indices */
+    Vector4 lights[20];
+    for(Vector4& light: lights) light = {0.0f, 0.0f, -10.0f, 1000.0f};
+    clusters.assign(lights);
+
+    CORRADE_COMPARE(clusters.lightIndices().size(), 1280);
+    CORRADE_COMPARE(clusters.clusters()[63], (Vector2ui{1260, 20}));
+    CORRADE_COMPARE(clusters.lightIndexImage().size(), (Vector2i{LightClusters::LightIndexImageWidth, 2}));
+    CORRADE_COMPARE(clusters.lightIndexImage().pixels<UnsignedInt>()[1][255], 19);
+}
+
+void LightClustersTest::assignBeyondFar() {
+    LightClusters clusters{{2, 2, 2}};
+    clusters.setProjection(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 1000.0f), 1.0f, 100.0f);
+
+    /* Fragments farther than the last slice are assigned to it, so it has to
+       contain lights that are there as well */
+    const Vector4 lights[]{{-200.0f, -200.0f, -500.0f, 1.0f}};
+    clusters.assign(lights);
+
+    CORRADE_COMPARE_AS(clusters.clusters(), (Containers::Array<Vector2ui>{Containers::InPlaceInit, {
+        {0, 0}, {0, 0}, {0, 0}, {0, 0},
+        {0, 1}, {1, 0}, {1, 0}, {1, 0}
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(clusters.lightIndices(), (Containers::Array<UnsignedInt>{Containers::InPlaceInit, {
+        0
+    }}), TestSuite::Compare::Container);
+}
+
+void LightClustersTest::assignNoProjection() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters{{2, 2, 2}};
+    clusters.assign(nullptr);
+    CORRADE_COMPARE(out.str(), "Shaders::LightClusters::assign(): projection was not set\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClustersTest)
@@ -25,6 +25,7 @@
 
 #include <numeric>
 #include <sstream>
+#include <tuple>
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -39,6 +40,11 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#endif
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
@@ -46,6 +52,7 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/DuplicateForWireframe.h"
 #include "Magnum/Primitives/Circle.h"
 #include "Magnum/Primitives/Icosphere.h"
 #include "Magnum/Primitives/UVSphere.h"
@@ -66,10 +73,16 @@ struct MeshVisualizerGLTest: GL::OpenGLTester {
     void constructWireframeGeometryShader();
     #endif
     void constructWireframeNoGeometryShader();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructWireframeVertexFetch();
+    #endif
 
     void constructMove();
 
     void setWireframeNotEnabled();
+    #ifndef MAGNUM_TARGET_GLES2
+    void bindVertexFetchTexturesNotEnabled();
+    #endif
 
     void renderSetup();
     void renderTeardown();
@@ -80,6 +93,7 @@ struct MeshVisualizerGLTest: GL::OpenGLTester {
     #endif
     void render();
     void renderWireframe();
+    void renderWireframeIndexed();
 
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
@@ -120,16 +134,33 @@ constexpr struct {
     {"no geometry shader, wide/sharp", MeshVisualizer::Flag::NoGeometryShader, 3.0f, 1.0f, "wireframe-wide.tga", "wireframe-nogeo.tga"}
 };
 
+constexpr struct {
+    const char* name;
+    MeshVisualizer::Flags flags;
+} WireframeIndexedData[] {
+    {"duplicated for wireframe", MeshVisualizer::Flag::NoGeometryShader},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"vertex fetch", MeshVisualizer::Flag::VertexFetch}
+    #endif
+};
+
 MeshVisualizerGLTest::MeshVisualizerGLTest() {
     addTests({&MeshVisualizerGLTest::construct,
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
               &MeshVisualizerGLTest::constructWireframeGeometryShader,
               #endif
               &MeshVisualizerGLTest::constructWireframeNoGeometryShader,
+              #ifndef MAGNUM_TARGET_GLES2
+              &MeshVisualizerGLTest::constructWireframeVertexFetch,
+              #endif
 
               &MeshVisualizerGLTest::constructMove,
 
-              &MeshVisualizerGLTest::setWireframeNotEnabled});
+              &MeshVisualizerGLTest::setWireframeNotEnabled,
+              #ifndef MAGNUM_TARGET_GLES2
+              &MeshVisualizerGLTest::bindVertexFetchTexturesNotEnabled
+              #endif
+              });
 
     addTests({&MeshVisualizerGLTest::renderDefaults,
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -144,6 +175,11 @@ MeshVisualizerGLTest::MeshVisualizerGLTest() {
         &MeshVisualizerGLTest::renderSetup,
         &MeshVisualizerGLTest::renderTeardown);
 
+    addInstancedTests({&MeshVisualizerGLTest::renderWireframeIndexed},
+        Containers::arraySize(WireframeIndexedData),
+        &MeshVisualizerGLTest::renderSetup,
+        &MeshVisualizerGLTest::renderTeardown);
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -221,6 +257,26 @@ void MeshVisualizerGLTest::constructWireframeNoGeometryShader() {
     }
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void MeshVisualizerGLTest::constructWireframeVertexFetch() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported");
+    #endif
+
+    MeshVisualizer shader{MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::VertexFetch};
+    CORRADE_COMPARE(shader.flags(), MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::VertexFetch);
+    CORRADE_VERIFY(shader.flags() & MeshVisualizer::Flag::NoGeometryShader);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.id());
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 void MeshVisualizerGLTest::constructMove() {
     MeshVisualizer a{MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::NoGeometryShader};
     const GLuint id = a.id();
@@ -255,6 +311,20 @@ void MeshVisualizerGLTest::setWireframeNotEnabled() {
         "Shaders::MeshVisualizer::setSmoothness(): the shader was not created with wireframe enabled\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void MeshVisualizerGLTest::bindVertexFetchTexturesNotEnabled() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture;
+    MeshVisualizer shader{MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::NoGeometryShader};
+    shader.bindVertexFetchTextures(texture, texture);
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizer::bindVertexFetchTextures(): the shader was not created with vertex fetch enabled\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void MeshVisualizerGLTest::renderSetup() {
@@ -489,6 +559,102 @@ void MeshVisualizerGLTest::renderWireframe() {
     }
 }
 
+void MeshVisualizerGLTest::renderWireframeIndexed() {
+    auto&& data = WireframeIndexedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags >= MeshVisualizer::Flag::VertexFetch && !GL::Context::current().isVersionSupported(GL::Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported");
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::OES::element_index_uint>())
+        CORRADE_SKIP(GL::Extensions::OES::element_index_uint::string() + std::string(" is not supported"));
+    #endif
+
+    const Trade::MeshData3D sphereData = Primitives::icosphereSolid(1);
+    const Containers::ArrayView<const UnsignedInt> indices = sphereData.indices();
+    const Containers::ArrayView<const Vector3> positions = sphereData.positions(0);
+
+    GL::Mesh sphere;
+    #ifndef MAGNUM_TARGET_GLES2
+    GL::Texture2D indexTexture{NoCreate}, positionTexture{NoCreate};
+    if(data.flags >= MeshVisualizer::Flag::VertexFetch) {
+        /* The sphere is small enough to fit into a single row */
+        indexTexture = GL::Texture2D{};
+        indexTexture.setMinificationFilter(GL::SamplerFilter::Nearest)
+            .setMagnificationFilter(GL::SamplerFilter::Nearest)
+            .setStorage(1, GL::TextureFormat::R32UI, {Int(indices.size()), 1})
+            .setSubImage(0, {}, ImageView2D{PixelFormat::R32UI, {Int(indices.size()), 1}, indices});
+        positionTexture = GL::Texture2D{};
+        positionTexture.setMinificationFilter(GL::SamplerFilter::Nearest)
+            .setMagnificationFilter(GL::SamplerFilter::Nearest)
+            .setStorage(1, GL::TextureFormat::RGB32F, {Int(positions.size()), 1})
+            .setSubImage(0, {}, ImageView2D{PixelFormat::RGB32F, {Int(positions.size()), 1}, positions});
+
+        /* No attributes, just the count */
+        sphere.setCount(indices.size());
+    } else
+    #endif
+    {
+        Containers::Array<UnsignedInt> wireframeIndices, vertexMapping;
+        std::tie(wireframeIndices, vertexMapping) = MeshTools::duplicateForWireframe(indices);
+
+        GL::Buffer vertices, indexBuffer;
+        vertices.setData(MeshTools::duplicate<UnsignedInt, Vector3>(Containers::arrayView(vertexMapping), positions));
+        indexBuffer.setData(wireframeIndices);
+        sphere.setCount(wireframeIndices.size())
+            .addVertexBuffer(std::move(vertices), 0, MeshVisualizer::Position{})
+            .setIndexBuffer(std::move(indexBuffer), 0, MeshIndexType::UnsignedInt);
+
+        /* Supply also the vertex ID, if needed. It's the new vertex index,
+           not a position in the index buffer. */
+        #ifndef MAGNUM_TARGET_GLES2
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>())
+        #endif
+        {
+            Containers::Array<Float> vertexIndex{vertexMapping.size()};
+            std::iota(vertexIndex.begin(), vertexIndex.end(), 0.0f);
+
+            GL::Buffer vertexId;
+            vertexId.setData(vertexIndex);
+            sphere.addVertexBuffer(std::move(vertexId), 0, MeshVisualizer::VertexIndex{});
+        }
+    }
+
+    MeshVisualizer shader{data.flags|MeshVisualizer::Flag::Wireframe};
+    shader.setColor(0xffff99_rgbf)
+        .setWireframeColor(0x9999ff_rgbf)
+        .setTransformationProjectionMatrix(
+            Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)*
+            Matrix4::translation(Vector3::zAxis(-2.15f))*
+            Matrix4::rotationY(-15.0_degf)*
+            Matrix4::rotationX(15.0_degf));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.flags >= MeshVisualizer::Flag::VertexFetch)
+        shader.bindVertexFetchTextures(indexTexture, positionTexture);
+    #endif
+    sphere.draw(shader);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImageImporter plugins not found.");
+
+    /* Should be the same as the de-indexed mesh */
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    const Float maxThreshold = 170.0f, meanThreshold = 0.330f;
+    #else
+    /* WebGL 1 doesn't have 8bit renderbuffer storage, so it's way worse */
+    const Float maxThreshold = 170.0f, meanThreshold = 1.699f;
+    #endif
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join({_testDir, "MeshVisualizerTestFiles", "wireframe-nogeo.tga"}),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::MeshVisualizerGLTest)
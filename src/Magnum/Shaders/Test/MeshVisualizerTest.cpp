@@ -41,6 +41,9 @@ struct MeshVisualizerTest: TestSuite::Tester {
 
     void debugFlag();
     void debugFlags();
+    #ifndef MAGNUM_TARGET_GLES2
+    void debugFlagsVertexFetch();
+    #endif
 };
 
 MeshVisualizerTest::MeshVisualizerTest() {
@@ -50,7 +53,11 @@ MeshVisualizerTest::MeshVisualizerTest() {
               &MeshVisualizerTest::vertexIndexNoConflict,
 
               &MeshVisualizerTest::debugFlag,
-              &MeshVisualizerTest::debugFlags});
+              &MeshVisualizerTest::debugFlags,
+              #ifndef MAGNUM_TARGET_GLES2
+              &MeshVisualizerTest::debugFlagsVertexFetch
+              #endif
+              });
 }
 
 void MeshVisualizerTest::constructNoCreate() {
@@ -94,6 +101,16 @@ void MeshVisualizerTest::debugFlags() {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void MeshVisualizerTest::debugFlagsVertexFetch() {
+    std::ostringstream out;
+
+    /* NoGeometryShader is a subset of VertexFetch, so it's not printed */
+    Debug{&out} << (MeshVisualizer::Flag::Wireframe|MeshVisualizer::Flag::VertexFetch) << (MeshVisualizer::Flag::NoGeometryShader|MeshVisualizer::Flag::VertexFetch);
+    CORRADE_COMPARE(out.str(), "Shaders::MeshVisualizer::Flag::Wireframe|Shaders::MeshVisualizer::Flag::VertexFetch Shaders::MeshVisualizer::Flag::VertexFetch\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::MeshVisualizerTest)
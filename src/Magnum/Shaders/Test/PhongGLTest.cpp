@@ -41,6 +41,7 @@
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Renderbuffer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Sampler.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Math/Color.h"
@@ -49,6 +50,7 @@
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Plane.h"
 #include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Shaders/LightClusters.h"
 #include "Magnum/Shaders/Phong.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData3D.h"
@@ -72,12 +74,19 @@ struct PhongGLTest: GL::OpenGLTester {
     #endif
     void setWrongLightCount();
     void setWrongLightId();
+    #ifndef MAGNUM_TARGET_GLES2
+    void bindLightClusterTexturesNotEnabled();
+    void setLightsClustered();
+    #endif
 
     void renderSetup();
     void renderTeardown();
 
     void renderDefaults();
     void renderColored();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderClustered();
+    #endif
     void renderSinglePixelTextured();
 
     void renderTextured();
@@ -148,6 +157,9 @@ constexpr struct {
     #ifndef MAGNUM_TARGET_GLES2
     {"object ID", Phong::Flag::ObjectId, 1},
     {"object ID + alpha mask + specular texture", Phong::Flag::ObjectId|Phong::Flag::AlphaMask|Phong::Flag::SpecularTexture, 1},
+    {"clustered lights", Phong::Flag::ClusteredLights, 16},
+    {"clustered lights + normal texture", Phong::Flag::ClusteredLights|Phong::Flag::NormalTexture, 16},
+    {"clustered lights, zero light count", Phong::Flag::ClusteredLights, 0},
     #endif
     {"five lights", {}, 5},
     {"zero lights", {}, 0}
@@ -268,7 +280,12 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::setObjectIdNotEnabled,
               #endif
               &PhongGLTest::setWrongLightCount,
-              &PhongGLTest::setWrongLightId});
+              &PhongGLTest::setWrongLightId,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::bindLightClusterTexturesNotEnabled,
+              &PhongGLTest::setLightsClustered
+              #endif
+              });
 
     addTests({&PhongGLTest::renderDefaults},
         &PhongGLTest::renderSetup,
@@ -279,6 +296,13 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::renderClustered},
+        Containers::arraySize(RenderColoredData),
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+    #endif
+
     addInstancedTests({&PhongGLTest::renderSinglePixelTextured},
         Containers::arraySize(RenderSinglePixelTexturedData),
         &PhongGLTest::renderSetup,
@@ -474,6 +498,41 @@ void PhongGLTest::setWrongLightId() {
         "Shaders::Phong::setLightPosition(): light ID 3 is out of bounds for 3 lights\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::bindLightClusterTexturesNotEnabled() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture3D clusters;
+    GL::Texture2D texture;
+    LightClusters lightClusters{{1, 1, 1}};
+    Phong shader;
+    shader.bindLightClusterTextures(clusters, texture, texture)
+        .setLightClusters(lightClusters, {80, 80});
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindLightClusterTextures(): the shader was not created with clustered lights enabled\n"
+        "Shaders::Phong::setLightClusters(): the shader was not created with clustered lights enabled\n");
+}
+
+void PhongGLTest::setLightsClustered() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::ClusteredLights, 2};
+    shader.setLightPositions({{}, {}})
+        .setLightPosition(1, {})
+        .setLightColors({{}, {}})
+        .setLightColor(1, {});
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setLightPositions(): the shader was created with clustered lights\n"
+        "Shaders::Phong::setLightPosition(): the shader was created with clustered lights\n"
+        "Shaders::Phong::setLightColors(): the shader was created with clustered lights\n"
+        "Shaders::Phong::setLightColor(): the shader was created with clustered lights\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void PhongGLTest::renderSetup() {
@@ -579,6 +638,81 @@ void PhongGLTest::renderColored() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::renderClustered() {
+    auto&& data = RenderColoredData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Same setup as in renderColored(), but with the lights supplied through
+       clusters. The lights have a large range so the attenuation doesn't
+       affect the output. */
+    const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f);
+    const Vector4 lights[]{
+        {data.lightPosition1, -3.0f, 0.0f, 1000.0f},
+        {data.lightPosition2, -3.0f, 0.0f, 1000.0f}
+    };
+    LightClusters clusters{{4, 4, 4}};
+    clusters.setProjection(projection, 0.1f, 10.0f)
+        .assign(lights);
+
+    GL::Texture3D clusterTexture;
+    clusterTexture.setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::RG32UI, clusters.size())
+        .setSubImage(0, {}, clusters.clusterImage());
+
+    const ImageView2D lightIndexImage = clusters.lightIndexImage();
+    GL::Texture2D lightIndexTexture;
+    lightIndexTexture.setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::R32UI, lightIndexImage.size())
+        .setSubImage(0, {}, lightIndexImage);
+
+    const Vector4 lightData[]{
+        lights[0], lights[1],
+        data.lightColor1, data.lightColor2
+    };
+    GL::Texture2D lightTexture;
+    lightTexture.setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::RGBA32F, {2, 2})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA32F, {2, 2}, lightData});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Phong shader{Phong::Flag::ClusteredLights, 2};
+    shader.bindLightClusterTextures(clusterTexture, lightIndexTexture, lightTexture)
+        .setLightClusters(clusters, RenderSize)
+        .setAmbientColor(0x330033_rgbf)
+        .setDiffuseColor(0xccffcc_rgbf)
+        .setSpecularColor(0x6666ff_rgbf)
+        .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f))*
+                                 Matrix4::rotationY(data.rotation))
+        .setNormalMatrix(Matrix4::rotationY(data.rotation).rotationScaling())
+        .setProjectionMatrix(projection);
+
+    sphere.draw(shader);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImageImporter plugins not found.");
+
+    /* Light directions are calculated per fragment instead of being
+       interpolated from vertices, which causes slight differences compared
+       to the ground truth */
+    const Float maxThreshold = 24.0f, meanThreshold = 0.5f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 constexpr GL::TextureFormat TextureFormatRGB =
     #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
     GL::TextureFormat::RGB8
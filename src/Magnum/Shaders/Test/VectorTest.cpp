@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Shaders/Vector.h"
 
@@ -37,6 +39,9 @@ struct VectorTest: TestSuite::Tester {
 
     void constructCopy2D();
     void constructCopy3D();
+
+    void debugFlag();
+    void debugFlags();
 };
 
 VectorTest::VectorTest() {
@@ -44,7 +49,10 @@ VectorTest::VectorTest() {
               &VectorTest::constructNoCreate3D,
 
               &VectorTest::constructCopy2D,
-              &VectorTest::constructCopy3D});
+              &VectorTest::constructCopy3D,
+
+              &VectorTest::debugFlag,
+              &VectorTest::debugFlags});
 }
 
 void VectorTest::constructNoCreate2D() {
@@ -75,6 +83,30 @@ void VectorTest::constructCopy3D() {
     CORRADE_VERIFY(!(std::is_assignable<Vector3D, const Vector3D&>{}));
 }
 
+void VectorTest::debugFlag() {
+    std::ostringstream out;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    Debug{&out} << Vector2D::Flag::InstancedGlyphs << Vector2D::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::AbstractVector::Flag::InstancedGlyphs Shaders::AbstractVector::Flag(0xf0)\n");
+    #else
+    Debug{&out} << Vector2D::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::AbstractVector::Flag(0xf0)\n");
+    #endif
+}
+
+void VectorTest::debugFlags() {
+    std::ostringstream out;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    Debug{&out} << Vector3D::Flags{Vector3D::Flag::InstancedGlyphs} << Vector3D::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::AbstractVector::Flag::InstancedGlyphs Shaders::AbstractVector::Flags{}\n");
+    #else
+    Debug{&out} << Vector3D::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::AbstractVector::Flags{}\n");
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VectorTest)
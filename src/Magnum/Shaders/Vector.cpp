@@ -26,6 +26,7 @@
 #include "Vector.h"
 
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
@@ -45,7 +46,16 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "AbstractVector3D.vert"; }
 }
 
-template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): AbstractVector<dimensions>{flags} {
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::InstancedGlyphs) {
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::instanced_arrays);
+    }
+    #endif
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -62,9 +72,26 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
-    vert.addSource(rs.get("generic.glsl"))
+    vert
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::InstancedGlyphs ? Utility::formatString(
+            "#define INSTANCED_GLYPHS\n"
+            "#define GLYPH_INDEX_ATTRIBUTE_LOCATION {}\n"
+            "#define GLYPH_SCALE_ATTRIBUTE_LOCATION {}\n"
+            "#define GLYPH_COLOR_ATTRIBUTE_LOCATION {}\n"
+            "#define GLYPH_TABLE_TEXTURE_LAYER {}\n",
+            UnsignedInt(AbstractVector<dimensions>::GlyphIndex::Location),
+            UnsignedInt(AbstractVector<dimensions>::GlyphScale::Location),
+            UnsignedInt(AbstractVector<dimensions>::GlyphColor::Location),
+            Int(AbstractVector<dimensions>::GlyphTableTextureLayer)) : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
-    frag.addSource(rs.get("generic.glsl"))
+    frag
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::InstancedGlyphs ? "#define INSTANCED_GLYPHS\n" : "")
+        #endif
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Vector.frag"));
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
@@ -79,6 +106,13 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     {
         GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
         GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::InstancedGlyphs) {
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphIndex::Location, "glyphIndex");
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphScale::Location, "glyphScale");
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::GlyphColor::Location, "glyphColor");
+        }
+        #endif
     }
     #endif
 
@@ -98,6 +132,11 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector() {
     #endif
     {
         GL::AbstractShaderProgram::setUniform(GL::AbstractShaderProgram::uniformLocation("vectorTexture"), AbstractVector<dimensions>::VectorTextureLayer);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::InstancedGlyphs)
+            GL::AbstractShaderProgram::setUniform(GL::AbstractShaderProgram::uniformLocation("glyphTable"),
+                AbstractVector<dimensions>::GlyphTableTextureLayer);
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
@@ -50,6 +50,9 @@ layout(binding = 6)
 uniform lowp sampler2D vectorTexture;
 
 in mediump vec2 fragmentTextureCoordinates;
+#ifdef INSTANCED_GLYPHS
+in lowp vec4 fragmentGlyphColor;
+#endif
 
 #ifdef NEW_GLSL
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -60,5 +63,9 @@ out lowp vec4 fragmentColor;
 
 void main() {
     lowp float intensity = texture(vectorTexture, fragmentTextureCoordinates).r;
-    fragmentColor = mix(backgroundColor, color, intensity);
+    fragmentColor = mix(backgroundColor,
+        #ifdef INSTANCED_GLYPHS
+        fragmentGlyphColor*
+        #endif
+        color, intensity);
 }
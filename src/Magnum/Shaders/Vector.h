@@ -63,7 +63,27 @@ Common rendering setup:
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public AbstractVector<dimensions> {
     public:
-        explicit Vector();
+        /**
+         * @brief Flag
+         * @m_since_latest
+         *
+         * See @ref AbstractVector::Flag for more information.
+         */
+        typedef typename AbstractVector<dimensions>::Flag Flag;
+
+        /**
+         * @brief Flags
+         * @m_since_latest
+         *
+         * See @ref AbstractVector::Flags for more information.
+         */
+        typedef typename AbstractVector<dimensions>::Flags Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit Vector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
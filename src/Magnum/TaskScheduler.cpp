@@ -0,0 +1,337 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+
+struct Task {
+    /* Either a standalone task ... */
+    std::function<void()> function;
+    /* Starts at 1 so the task doesn't get scheduled while its dependencies
+       are still being registered */
+    std::atomic<UnsignedInt> remaining{1};
+    std::atomic<bool> done{false};
+    /* Guarded by State::tasksMutex */
+    std::vector<Task*> dependents;
+
+    /* ... or a parallelFor() chunk, which needs neither an allocation for the
+       function nor dependency tracking */
+    const std::function<void(std::size_t, std::size_t)>* range{};
+    std::size_t begin{}, end{};
+    std::atomic<std::size_t>* remainingChunks{};
+};
+
+struct Queue {
+    std::mutex mutex;
+    std::deque<Task*> tasks;
+};
+
+}
+
+struct TaskScheduler::State {
+    explicit State(UnsignedInt workerCount): queues{Containers::ValueInit, workerCount} {}
+
+    /* Index of the queue belonging to the current thread or queues.size() if
+       not called from a worker */
+    std::size_t currentQueue() const;
+    void schedule(Task& task);
+    Task* pop(std::size_t self);
+    void execute(Task& task);
+    /* Pops and executes a single task, returns false if there was none */
+    bool executeOne();
+    void work(std::size_t self);
+
+    Containers::Array<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> nextQueue{0};
+
+    /* Upper bound on the count of tasks in all queues, incremented before a
+       task is pushed and decremented after it's popped */
+    std::atomic<std::size_t> queuedCount{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool quit = false;
+
+    /* User-visible tasks, pointers stay stable until the next wait(). IDs
+       are never reused, the first task has ID firstId and all tasks with IDs
+       below finished before the last wait(). */
+    mutable std::mutex tasksMutex;
+    std::vector<Containers::Pointer<Task>> tasks;
+    UnsignedInt firstId{};
+    std::atomic<std::size_t> unfinishedCount{0};
+};
+
+std::size_t TaskScheduler::State::currentQueue() const {
+    const std::thread::id id = std::this_thread::get_id();
+    for(std::size_t i = 0; i != workers.size(); ++i)
+        if(workers[i].get_id() == id) return i;
+    return queues.size();
+}
+
+void TaskScheduler::State::schedule(Task& task) {
+    /* Deterministic single-threaded mode, execute directly */
+    if(queues.empty()) {
+        execute(task);
+        return;
+    }
+
+    /* Workers put tasks into their own queue, the rest is distributed
+       round-robin */
+    std::size_t queue = currentQueue();
+    if(queue == queues.size()) queue = nextQueue++ % queues.size();
+
+    ++queuedCount;
+    {
+        std::lock_guard<std::mutex> lock{queues[queue].mutex};
+        queues[queue].tasks.push_back(&task);
+    }
+    {
+        /* Locking to avoid a lost wakeup between the predicate check and
+           the wait in work() */
+        std::lock_guard<std::mutex> lock{sleepMutex};
+    }
+    wakeUp.notify_one();
+}
+
+Task* TaskScheduler::State::pop(const std::size_t self) {
+    /* Newest task from own queue first, as its data are most likely still in
+       the cache */
+    if(self < queues.size()) {
+        Queue& queue = queues[self];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if(!queue.tasks.empty()) {
+            Task* task = queue.tasks.back();
+            queue.tasks.pop_back();
+            --queuedCount;
+            return task;
+        }
+    }
+
+    /* Otherwise steal the oldest task from the others, starting with the
+       next queue so not everyone hammers the first one */
+    for(std::size_t i = 1; i <= queues.size(); ++i) {
+        Queue& queue = queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if(!queue.tasks.empty()) {
+            Task* task = queue.tasks.front();
+            queue.tasks.pop_front();
+            --queuedCount;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void TaskScheduler::State::execute(Task& task) {
+    /* A parallelFor() chunk. The task is owned by the parallelFor() caller
+       and can be gone right after the counter decrement, so touch nothing
+       after */
+    if(task.range) {
+        (*task.range)(task.begin, task.end);
+        --*task.remainingChunks;
+        return;
+    }
+
+    task.function();
+
+    std::vector<Task*> dependents;
+    {
+        std::lock_guard<std::mutex> lock{tasksMutex};
+        task.done = true;
+        std::swap(dependents, task.dependents);
+    }
+    for(Task* dependent: dependents)
+        if(--dependent->remaining == 0) schedule(*dependent);
+
+    /* Has to be the last so wait() doesn't free the tasks while they're
+       still being accessed */
+    --unfinishedCount;
+}
+
+bool TaskScheduler::State::executeOne() {
+    Task* task = pop(currentQueue());
+    if(!task) return false;
+    execute(*task);
+    return true;
+}
+
+void TaskScheduler::State::work(const std::size_t self) {
+    for(;;) {
+        if(Task* task = pop(self)) {
+            execute(*task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{sleepMutex};
+        wakeUp.wait(lock, [this]{ return quit || queuedCount; });
+        if(quit && !queuedCount) return;
+    }
+}
+
+UnsignedInt TaskScheduler::defaultWorkerCount() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const UnsignedInt count = std::thread::hardware_concurrency();
+    return count ? count - 1 : 0;
+    #else
+    return 0;
+    #endif
+}
+
+TaskScheduler::TaskScheduler(const UnsignedInt workerCount): _state{new State{workerCount}} {
+    /* Spawning only after all queues exist, as the workers immediately start
+       looking into them */
+    _state->workers.reserve(workerCount);
+    for(std::size_t i = 0; i != workerCount; ++i)
+        _state->workers.emplace_back(&State::work, _state.get(), i);
+}
+
+TaskScheduler::TaskScheduler(): TaskScheduler{defaultWorkerCount()} {}
+
+TaskScheduler::~TaskScheduler() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock{_state->sleepMutex};
+        _state->quit = true;
+    }
+    _state->wakeUp.notify_all();
+    for(std::thread& worker: _state->workers) worker.join();
+}
+
+UnsignedInt TaskScheduler::workerCount() const {
+    return _state->workers.size();
+}
+
+UnsignedInt TaskScheduler::add(std::function<void()> function, const Containers::ArrayView<const UnsignedInt> dependencies) {
+    Task* task;
+    UnsignedInt id;
+    {
+        std::lock_guard<std::mutex> lock{_state->tasksMutex};
+        id = _state->firstId + _state->tasks.size();
+        #ifndef CORRADE_NO_ASSERT
+        for(const UnsignedInt dependency: dependencies)
+            CORRADE_ASSERT(dependency < id,
+                "TaskScheduler::add(): dependency" << dependency << "not added yet", {});
+        #endif
+
+        _state->tasks.emplace_back(new Task);
+        task = _state->tasks.back().get();
+        task->function = std::move(function);
+        for(const UnsignedInt dependency: dependencies) {
+            /* Tasks from before the last wait() are finished */
+            if(dependency < _state->firstId) continue;
+            Task& other = *_state->tasks[dependency - _state->firstId];
+            if(other.done) continue;
+            other.dependents.push_back(task);
+            ++task->remaining;
+        }
+    }
+
+    ++_state->unfinishedCount;
+    if(--task->remaining == 0) _state->schedule(*task);
+    return id;
+}
+
+UnsignedInt TaskScheduler::add(std::function<void()> function, const std::initializer_list<UnsignedInt> dependencies) {
+    return add(std::move(function), Containers::arrayView(dependencies.begin(), dependencies.size()));
+}
+
+bool TaskScheduler::isDone(const UnsignedInt id) const {
+    std::lock_guard<std::mutex> lock{_state->tasksMutex};
+    CORRADE_ASSERT(id < _state->firstId + _state->tasks.size(),
+        "TaskScheduler::isDone(): task" << id << "not added yet", {});
+    return id < _state->firstId || _state->tasks[id - _state->firstId]->done;
+}
+
+void TaskScheduler::wait(const UnsignedInt id) {
+    Task* task;
+    {
+        std::lock_guard<std::mutex> lock{_state->tasksMutex};
+        CORRADE_ASSERT(id < _state->firstId + _state->tasks.size(),
+            "TaskScheduler::wait(): task" << id << "not added yet", );
+        if(id < _state->firstId) return;
+        task = _state->tasks[id - _state->firstId].get();
+    }
+
+    while(!task->done)
+        if(!_state->executeOne()) std::this_thread::yield();
+}
+
+void TaskScheduler::wait() {
+    while(_state->unfinishedCount)
+        if(!_state->executeOne()) std::this_thread::yield();
+
+    std::lock_guard<std::mutex> lock{_state->tasksMutex};
+    _state->firstId += _state->tasks.size();
+    _state->tasks.clear();
+}
+
+void TaskScheduler::parallelFor(const std::size_t count, const std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& body) {
+    CORRADE_ASSERT(grainSize,
+        "TaskScheduler::parallelFor(): grain size can't be zero", );
+
+    /* Single-threaded mode or nothing to split, process everything in order
+       on the calling thread */
+    if(_state->queues.empty() || count <= grainSize) {
+        for(std::size_t begin = 0; begin < count; begin += grainSize)
+            body(begin, Math::min(begin + grainSize, count));
+        return;
+    }
+
+    const std::size_t chunkCount = (count + grainSize - 1)/grainSize;
+    std::atomic<std::size_t> remainingChunks{chunkCount};
+    Containers::Array<Task> chunks{Containers::ValueInit, chunkCount};
+    for(std::size_t i = 0; i != chunkCount; ++i) {
+        Task& chunk = chunks[i];
+        chunk.range = &body;
+        chunk.begin = i*grainSize;
+        chunk.end = Math::min(chunk.begin + grainSize, count);
+        chunk.remainingChunks = &remainingChunks;
+        _state->schedule(chunk);
+    }
+
+    /* Help with the work instead of blocking, which also makes nested
+       parallelFor() calls from inside workers possible */
+    while(remainingChunks)
+        if(!_state->executeOne()) std::this_thread::yield();
+}
+
+}
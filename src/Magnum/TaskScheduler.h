@@ -0,0 +1,219 @@
+#ifndef Magnum_TaskScheduler_h
+#define Magnum_TaskScheduler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Class @ref Magnum::TaskScheduler
+ * @m_since_latest
+ */
+
+#include <functional>
+#include <initializer_list>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Work-stealing task scheduler
+@m_since_latest
+
+Executes tasks on a fixed set of worker threads. Each worker has its own task
+queue, tasks scheduled from inside a worker are put into the queue of that
+worker and executed newest-first for cache locality, while idle workers steal
+the oldest tasks from queues of other workers. Tasks scheduled from outside
+of the workers are distributed among the queues in a round-robin fashion.
+
+@section TaskScheduler-usage Basic usage
+
+Tasks are added using @ref add(), optionally with a list of tasks that have to
+finish first. The returned ID can be then used to wait for a particular task
+using @ref wait(UnsignedInt), while @ref wait() waits for all tasks:
+
+@snippet Magnum.cpp TaskScheduler-usage
+
+The thread calling @ref wait() doesn't block but executes queued tasks itself
+until the awaited tasks finish, which means it's also possible to wait from
+inside another task without deadlocking the pool.
+
+@section TaskScheduler-parallel-for Parallel for
+
+For data-parallel work, @ref parallelFor() splits an index range into chunks
+of at most given size, executes them on the workers and the calling thread
+and returns once all chunks are processed:
+
+@snippet Magnum.cpp TaskScheduler-parallelFor
+
+Several batch APIs such as @ref Math::packInto(),
+@ref MeshTools::duplicateInto() or @ref MeshTools::generateFlatNormalsInto()
+have overloads taking a scheduler that are implemented on top of
+@ref parallelFor().
+
+@section TaskScheduler-single-threaded Deterministic single-threaded mode
+
+If constructed with zero workers, no threads are spawned. A task is then
+executed directly inside @ref add() --- since dependencies have to be added
+before the tasks that depend on them, they're always already done at that
+point --- and @ref parallelFor() processes the chunks sequentially from the
+first to the last. The order of execution is thus fully deterministic, which
+is useful for tests, debugging and platforms without thread support such as
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", where
+@ref defaultWorkerCount() is always @cpp 0 @ce.
+*/
+class MAGNUM_EXPORT TaskScheduler {
+    public:
+        /**
+         * @brief Default worker count
+         *
+         * One less than the hardware thread count, as the thread calling
+         * @ref wait() or @ref parallelFor() participates on the work as well.
+         * Returns @cpp 0 @ce if the hardware thread count can't be queried
+         * and on platforms without thread support.
+         */
+        static UnsignedInt defaultWorkerCount();
+
+        /**
+         * @brief Constructor
+         *
+         * Spawns @p workerCount worker threads. If @p workerCount is
+         * @cpp 0 @ce, the scheduler operates in a
+         * @ref TaskScheduler-single-threaded "deterministic single-threaded mode".
+         */
+        explicit TaskScheduler(UnsignedInt workerCount);
+
+        /**
+         * @brief Construct with a default worker count
+         *
+         * Equivalent to calling @ref TaskScheduler(UnsignedInt) with
+         * @ref defaultWorkerCount().
+         */
+        explicit TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler(TaskScheduler&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for all scheduled tasks to finish and joins the worker
+         * threads.
+         */
+        ~TaskScheduler();
+
+        /** @brief Copying is not allowed */
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt workerCount() const;
+
+        /**
+         * @brief Add a task
+         * @param task          Task to execute
+         * @param dependencies  IDs of tasks that have to finish before
+         *      @p task gets executed
+         * @return Task ID
+         *
+         * IDs are assigned sequentially from @cpp 0 @ce and are never reused
+         * during the lifetime of the scheduler. Tasks that finished before
+         * the last call to @ref wait() are released, but their IDs stay
+         * valid and are treated as finished. Expects that all
+         * @p dependencies are IDs of already added tasks.
+         */
+        UnsignedInt add(std::function<void()> task, Containers::ArrayView<const UnsignedInt> dependencies);
+
+        /** @overload */
+        UnsignedInt add(std::function<void()> task, std::initializer_list<UnsignedInt> dependencies = {});
+
+        /**
+         * @brief Whether given task finished
+         *
+         * Always @cpp true @ce for tasks added before the last call to
+         * @ref wait(). Expects that @p id is an ID of an already added task.
+         */
+        bool isDone(UnsignedInt id) const;
+
+        /**
+         * @brief Wait for given task
+         *
+         * Executes other queued tasks while waiting. Returns immediately for
+         * tasks added before the last call to @ref wait(). Expects that
+         * @p id is an ID of an already added task.
+         */
+        void wait(UnsignedInt id);
+
+        /**
+         * @brief Wait for all tasks
+         *
+         * Executes queued tasks until all are finished and releases them.
+         * Their IDs are not reused, see @ref add() for more information.
+         */
+        void wait();
+
+        /**
+         * @brief Parallel for over an index range
+         * @param count     Index range size
+         * @param grainSize Max count of indices processed in a single chunk
+         * @param body      Function called with a @cpp [begin, end) @ce
+         *      index range of each chunk
+         *
+         * Splits the range into chunks of at most @p grainSize indices and
+         * executes @p body on each of them on the worker threads and the
+         * calling thread. Returns after all chunks are processed. Expects
+         * that @p grainSize is not zero.
+         */
+        void parallelFor(std::size_t count, std::size_t grainSize, const std::function<void(std::size_t, std::size_t)>& body);
+
+        /**
+         * @brief Parallel for over a strided array view
+         *
+         * Calls @p body on consecutive slices of @p view of at most
+         * @p grainSize items, together with the offset of each slice in
+         * @p view. See @ref parallelFor(std::size_t, std::size_t, const std::function<void(std::size_t, std::size_t)>&)
+         * for more information.
+         */
+        template<class T, class F> void parallelFor(const Containers::StridedArrayView1D<T>& view, std::size_t grainSize, F body) {
+            parallelFor(view.size(), grainSize, [&view, &body](std::size_t begin, std::size_t end) {
+                body(view.slice(begin, end), begin);
+            });
+        }
+
+    private:
+        struct State;
+
+        Containers::Pointer<State> _state;
+};
+
+}
+
+#endif
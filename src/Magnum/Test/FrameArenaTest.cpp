@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <type_traits>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/FrameArena.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct FrameArenaTest: TestSuite::Tester {
+    explicit FrameArenaTest();
+
+    void construct();
+    void constructEmpty();
+    void constructCopy();
+
+    void allocate();
+    void allocateTyped();
+    void allocateNoInit();
+    void allocateInvalidAlignment();
+    void allocateOverflow();
+    void allocateEmptyArena();
+
+    void reset();
+    void resetSteadyState();
+};
+
+FrameArenaTest::FrameArenaTest() {
+    addTests({&FrameArenaTest::construct,
+              &FrameArenaTest::constructEmpty,
+              &FrameArenaTest::constructCopy,
+
+              &FrameArenaTest::allocate,
+              &FrameArenaTest::allocateTyped,
+              &FrameArenaTest::allocateNoInit,
+              &FrameArenaTest::allocateInvalidAlignment,
+              &FrameArenaTest::allocateOverflow,
+              &FrameArenaTest::allocateEmptyArena,
+
+              &FrameArenaTest::reset,
+              &FrameArenaTest::resetSteadyState});
+}
+
+void FrameArenaTest::construct() {
+    FrameArena arena{1024};
+    CORRADE_COMPARE(arena.capacity(), 1024);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 1);
+}
+
+void FrameArenaTest::constructEmpty() {
+    FrameArena arena;
+    CORRADE_COMPARE(arena.capacity(), 0);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 0);
+}
+
+void FrameArenaTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<FrameArena, const FrameArena&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<FrameArena, const FrameArena&>{}));
+    CORRADE_VERIFY(!(std::is_constructible<FrameArena, FrameArena&&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<FrameArena, FrameArena&&>{}));
+}
+
+void FrameArenaTest::allocate() {
+    FrameArena arena{1024};
+
+    void* a = arena.allocate(3, 1);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(arena.usedSize(), 3);
+    CORRADE_COMPARE(arena.allocationCount(), 1);
+
+    /* Aligned allocation gets padded */
+    void* b = arena.allocate(16, 16);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b) % 16, 0);
+    CORRADE_VERIFY(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+    CORRADE_COMPARE(arena.allocationCount(), 2);
+    CORRADE_COMPARE(arena.usedSize(), std::size_t(static_cast<char*>(b) + 16 - static_cast<char*>(a)));
+
+    /* Still fits into the initial block */
+    CORRADE_COMPARE(arena.heapAllocationCount(), 1);
+}
+
+void FrameArenaTest::allocateTyped() {
+    FrameArena arena{1024};
+
+    Containers::ArrayView<Vector3> a = arena.allocate<Vector3>(5);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % alignof(Vector3), 0);
+    for(const Vector3& i: a) CORRADE_COMPARE(i, Vector3{});
+
+    Containers::ArrayView<Double> b = arena.allocate<Double>(3);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % alignof(Double), 0);
+    for(Double i: b) CORRADE_COMPARE(i, 0.0);
+
+    CORRADE_COMPARE(arena.allocationCount(), 2);
+}
+
+void FrameArenaTest::allocateNoInit() {
+    FrameArena arena{1024};
+
+    Containers::ArrayView<UnsignedShort> a = arena.allocate<UnsignedShort>(Containers::NoInit, 4);
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % alignof(UnsignedShort), 0);
+    CORRADE_COMPARE(arena.usedSize(), 8);
+}
+
+void FrameArenaTest::allocateInvalidAlignment() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FrameArena arena{1024};
+    CORRADE_VERIFY(!arena.allocate(16, 0));
+    CORRADE_VERIFY(!arena.allocate(16, 6));
+    CORRADE_COMPARE(out.str(),
+        "FrameArena::allocate(): alignment 0 is not a power of two\n"
+        "FrameArena::allocate(): alignment 6 is not a power of two\n");
+}
+
+void FrameArenaTest::allocateOverflow() {
+    FrameArena arena{64};
+
+    Containers::ArrayView<Int> a = arena.allocate<Int>(Containers::NoInit, 12);
+    for(std::size_t i = 0; i != a.size(); ++i) a[i] = Int(i*3);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 1);
+
+    /* Doesn't fit into the remaining space, a new block gets allocated */
+    Containers::ArrayView<Int> b = arena.allocate<Int>(Containers::NoInit, 100);
+    for(std::size_t i = 0; i != b.size(); ++i) b[i] = Int(1000 + i);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 2);
+    CORRADE_COMPARE(arena.allocationCount(), 2);
+    CORRADE_VERIFY(arena.capacity() >= 64 + 400);
+
+    /* Earlier allocations stay intact */
+    for(std::size_t i = 0; i != a.size(); ++i) CORRADE_COMPARE(a[i], Int(i*3));
+    for(std::size_t i = 0; i != b.size(); ++i) CORRADE_COMPARE(b[i], Int(1000 + i));
+}
+
+void FrameArenaTest::allocateEmptyArena() {
+    FrameArena arena;
+
+    Containers::ArrayView<Float> a = arena.allocate<Float>(4);
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(a[3], 0.0f);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 1);
+    CORRADE_VERIFY(arena.capacity() >= 16);
+}
+
+void FrameArenaTest::reset() {
+    FrameArena arena{32};
+    arena.allocate(24, 4);
+    arena.allocate(48, 4);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 2);
+    const std::size_t capacity = arena.capacity();
+
+    /* The blocks get consolidated into a single one */
+    arena.reset();
+    CORRADE_COMPARE(arena.capacity(), capacity);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 3);
+
+    /* Resetting again without overflowing doesn't allocate anything */
+    arena.allocate(24, 4);
+    arena.reset();
+    CORRADE_COMPARE(arena.capacity(), capacity);
+    CORRADE_COMPARE(arena.heapAllocationCount(), 3);
+}
+
+void FrameArenaTest::resetSteadyState() {
+    FrameArena arena;
+
+    /* Simulates a few frames doing the same set of allocations, only the
+       first frame should need to hit the heap */
+    std::size_t firstFrameHeapAllocationCount{};
+    for(std::size_t frame = 0; frame != 5; ++frame) {
+        arena.reset();
+        if(frame == 1) firstFrameHeapAllocationCount = arena.heapAllocationCount();
+
+        arena.allocate<Vector3>(100);
+        arena.allocate<UnsignedByte>(Containers::NoInit, 7);
+        arena.allocate<Double>(Containers::NoInit, 50);
+        arena.allocate(1000, 64);
+        CORRADE_COMPARE(arena.allocationCount(), 4);
+    }
+
+    CORRADE_VERIFY(firstFrameHeapAllocationCount);
+    CORRADE_COMPARE(arena.heapAllocationCount(), firstFrameHeapAllocationCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FrameArenaTest)
@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/MemoryAccounting.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct MemoryAccountingTest: TestSuite::Tester {
+    explicit MemoryAccountingTest();
+
+    void setup();
+    void teardown();
+
+    void disabled();
+    void construct();
+    void constructDefault();
+    void constructCopy();
+    void constructMove();
+    void setSize();
+    void enableInBetween();
+    void disableInBetween();
+
+    void peakUsage();
+    void totalUsage();
+    void threads();
+    void report();
+
+    void debugCategory();
+};
+
+MemoryAccountingTest::MemoryAccountingTest() {
+    addTests({&MemoryAccountingTest::disabled});
+
+    addTests({&MemoryAccountingTest::construct,
+              &MemoryAccountingTest::constructDefault,
+              &MemoryAccountingTest::constructCopy,
+              &MemoryAccountingTest::constructMove,
+              &MemoryAccountingTest::setSize,
+              &MemoryAccountingTest::enableInBetween,
+              &MemoryAccountingTest::disableInBetween,
+
+              &MemoryAccountingTest::peakUsage,
+              &MemoryAccountingTest::totalUsage,
+              &MemoryAccountingTest::threads,
+              &MemoryAccountingTest::report},
+        &MemoryAccountingTest::setup,
+        &MemoryAccountingTest::teardown);
+
+    addTests({&MemoryAccountingTest::debugCategory});
+}
+
+void MemoryAccountingTest::setup() {
+    MemoryAccounting::setEnabled(true);
+    MemoryAccounting::resetPeakUsage();
+}
+
+void MemoryAccountingTest::teardown() {
+    MemoryAccounting::setEnabled(false);
+}
+
+void MemoryAccountingTest::disabled() {
+    CORRADE_VERIFY(!MemoryAccounting::isEnabled());
+
+    AccountedMemory a{MemoryCategory::ImageData, 1024};
+    CORRADE_COMPARE(a.category(), MemoryCategory::ImageData);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::ImageData), 0);
+}
+
+void MemoryAccountingTest::construct() {
+    {
+        AccountedMemory a{MemoryCategory::MeshData, 1024};
+        CORRADE_COMPARE(a.category(), MemoryCategory::MeshData);
+        CORRADE_COMPARE(a.size(), 1024);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 1024);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 1);
+
+        AccountedMemory b{MemoryCategory::MeshData, 76};
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 1100);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 2);
+
+        /* Zero-sized allocations are not counted */
+        AccountedMemory c{MemoryCategory::MeshData};
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 2);
+
+        /* Other categories are not affected */
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 0);
+    }
+
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 0);
+}
+
+void MemoryAccountingTest::constructDefault() {
+    AccountedMemory a;
+    CORRADE_COMPARE(a.category(), MemoryCategory::Other);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::Other), 0);
+}
+
+void MemoryAccountingTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<AccountedMemory, const AccountedMemory&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<AccountedMemory, const AccountedMemory&>{}));
+}
+
+void MemoryAccountingTest::constructMove() {
+    {
+        AccountedMemory a{MemoryCategory::GLBuffer, 256};
+        AccountedMemory b{std::move(a)};
+        CORRADE_COMPARE(a.size(), 0);
+        CORRADE_COMPARE(b.category(), MemoryCategory::GLBuffer);
+        CORRADE_COMPARE(b.size(), 256);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLBuffer), 256);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::GLBuffer), 1);
+
+        AccountedMemory c{MemoryCategory::GLTexture, 1024};
+        c = std::move(b);
+        CORRADE_COMPARE(c.category(), MemoryCategory::GLBuffer);
+        CORRADE_COMPARE(c.size(), 256);
+        CORRADE_COMPARE(b.category(), MemoryCategory::GLTexture);
+        CORRADE_COMPARE(b.size(), 1024);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLBuffer), 256);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLTexture), 1024);
+    }
+
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLBuffer), 0);
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLTexture), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<AccountedMemory>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<AccountedMemory>::value);
+}
+
+void MemoryAccountingTest::setSize() {
+    AccountedMemory a{MemoryCategory::GLBuffer, 256};
+    a.setSize(4096);
+    CORRADE_COMPARE(a.size(), 4096);
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLBuffer), 4096);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::GLBuffer), 1);
+
+    a.setSize(0);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLBuffer), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::GLBuffer), 0);
+}
+
+void MemoryAccountingTest::enableInBetween() {
+    MemoryAccounting::setEnabled(false);
+    AccountedMemory a{MemoryCategory::ImageData, 128};
+    MemoryAccounting::setEnabled(true);
+
+    /* Not accounted, so nothing gets removed at the end either */
+    AccountedMemory b{MemoryCategory::ImageData, 64};
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 64);
+}
+
+void MemoryAccountingTest::disableInBetween() {
+    {
+        AccountedMemory a{MemoryCategory::ImageData, 128};
+        MemoryAccounting::setEnabled(false);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 128);
+    }
+
+    /* Gets removed even though the accounting is disabled now */
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 0);
+}
+
+void MemoryAccountingTest::peakUsage() {
+    {
+        AccountedMemory a{MemoryCategory::GLTextureArray, 1000};
+        {
+            AccountedMemory b{MemoryCategory::GLTextureArray, 500};
+            CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::GLTextureArray), 1500);
+        }
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::GLTextureArray), 1000);
+        CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::GLTextureArray), 1500);
+
+        MemoryAccounting::resetPeakUsage();
+        CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::GLTextureArray), 1000);
+    }
+
+    CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::GLTextureArray), 1000);
+    MemoryAccounting::resetPeakUsage();
+    CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::GLTextureArray), 0);
+}
+
+void MemoryAccountingTest::totalUsage() {
+    AccountedMemory a{MemoryCategory::ImageData, 100};
+    AccountedMemory b{MemoryCategory::GLBuffer, 20};
+    AccountedMemory c{MemoryCategory::GLCubeMapTexture, 3};
+    CORRADE_COMPARE(MemoryAccounting::totalUsage(), 123);
+}
+
+void MemoryAccountingTest::threads() {
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([]{
+        for(std::size_t j = 0; j != 1000; ++j) {
+            AccountedMemory a{MemoryCategory::Other, 16};
+            AccountedMemory b{MemoryCategory::Other, 32};
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::Other), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::Other), 0);
+    CORRADE_VERIFY(MemoryAccounting::peakUsage(MemoryCategory::Other) >= 48);
+    CORRADE_VERIFY(MemoryAccounting::peakUsage(MemoryCategory::Other) <= 4*48);
+}
+
+void MemoryAccountingTest::report() {
+    AccountedMemory a{MemoryCategory::ImageData, 4096};
+    {
+        AccountedMemory b{MemoryCategory::GLBuffer, 1048576};
+    }
+    AccountedMemory c{MemoryCategory::GLBuffer, 65536};
+
+    CORRADE_COMPARE(MemoryAccounting::report(),
+        "Category                     Usage          Peak   Allocations\n"
+        "Other                            0             0             0\n"
+        "ImageData                     4096          4096             1\n"
+        "MeshData                         0             0             0\n"
+        "GLBuffer                     65536       1048576             1\n"
+        "GLTexture                        0             0             0\n"
+        "GLTextureArray                   0             0             0\n"
+        "GLCubeMapTexture                 0             0             0\n"
+        "Total                        69632\n");
+}
+
+void MemoryAccountingTest::debugCategory() {
+    std::ostringstream out;
+    Debug{&out} << MemoryCategory::GLTextureArray << MemoryCategory(0xde);
+    CORRADE_COMPARE(out.str(), "MemoryCategory::GLTextureArray MemoryCategory(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MemoryAccountingTest)
@@ -0,0 +1,507 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/TaskScheduler.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct TaskSchedulerTest: TestSuite::Tester {
+    explicit TaskSchedulerTest();
+
+    void construct();
+    void constructDefault();
+    void constructCopy();
+
+    void add();
+    void waitTask();
+    void dependencies();
+    void dependenciesFinished();
+    void waitStale();
+    void nested();
+    void singleThreadedOrder();
+
+    void parallelFor();
+    void parallelForEmpty();
+    void parallelForSingleChunk();
+    void parallelForStrided();
+    void parallelForNested();
+    void parallelForZeroGrainSize();
+
+    void isDoneOutOfRange();
+    void waitOutOfRange();
+    void addDependencyOutOfRange();
+
+    void packInto();
+    void unpackInto();
+    void packIntoWrongSize();
+
+    void benchmarkParallelFor();
+    void benchmarkPackInto();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt workerCount;
+} WorkerData[]{
+    {"single-threaded", 0},
+    {"1 worker", 1},
+    {"3 workers", 3}
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt workerCount;
+} BenchmarkData[]{
+    {"single-threaded", 0},
+    {"1 worker", 1},
+    {"3 workers", 3},
+    {"7 workers", 7}
+};
+
+TaskSchedulerTest::TaskSchedulerTest() {
+    addInstancedTests({&TaskSchedulerTest::construct},
+        Containers::arraySize(WorkerData));
+
+    addTests({&TaskSchedulerTest::constructDefault,
+              &TaskSchedulerTest::constructCopy});
+
+    addInstancedTests({&TaskSchedulerTest::add,
+                       &TaskSchedulerTest::waitTask,
+                       &TaskSchedulerTest::dependencies,
+                       &TaskSchedulerTest::dependenciesFinished,
+                       &TaskSchedulerTest::waitStale,
+                       &TaskSchedulerTest::nested},
+        Containers::arraySize(WorkerData));
+
+    addTests({&TaskSchedulerTest::singleThreadedOrder});
+
+    addInstancedTests({&TaskSchedulerTest::parallelFor,
+                       &TaskSchedulerTest::parallelForEmpty,
+                       &TaskSchedulerTest::parallelForSingleChunk,
+                       &TaskSchedulerTest::parallelForStrided,
+                       &TaskSchedulerTest::parallelForNested},
+        Containers::arraySize(WorkerData));
+
+    addTests({&TaskSchedulerTest::parallelForZeroGrainSize,
+
+              &TaskSchedulerTest::isDoneOutOfRange,
+              &TaskSchedulerTest::waitOutOfRange,
+              &TaskSchedulerTest::addDependencyOutOfRange});
+
+    addInstancedTests({&TaskSchedulerTest::packInto,
+                       &TaskSchedulerTest::unpackInto},
+        Containers::arraySize(WorkerData));
+
+    addTests({&TaskSchedulerTest::packIntoWrongSize});
+
+    addInstancedBenchmarks({&TaskSchedulerTest::benchmarkParallelFor,
+                            &TaskSchedulerTest::benchmarkPackInto}, 25,
+        Containers::arraySize(BenchmarkData));
+}
+
+void TaskSchedulerTest::construct() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    CORRADE_COMPARE(scheduler.workerCount(), data.workerCount);
+}
+
+void TaskSchedulerTest::constructDefault() {
+    TaskScheduler scheduler;
+    CORRADE_COMPARE(scheduler.workerCount(), TaskScheduler::defaultWorkerCount());
+}
+
+void TaskSchedulerTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<TaskScheduler, const TaskScheduler&>{}));
+    CORRADE_VERIFY(!(std::is_constructible<TaskScheduler, TaskScheduler&&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<TaskScheduler, const TaskScheduler&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<TaskScheduler, TaskScheduler&&>{}));
+}
+
+void TaskSchedulerTest::add() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::atomic<UnsignedInt> counter{0};
+    for(UnsignedInt i = 0; i != 100; ++i)
+        CORRADE_COMPARE(scheduler.add([&counter]{ ++counter; }), i);
+
+    scheduler.wait();
+    CORRADE_COMPARE(counter.load(), 100);
+
+    /* IDs are not reused after a wait(), so a stale ID doesn't alias a new
+       task */
+    CORRADE_COMPARE(scheduler.add([&counter]{ ++counter; }), 100);
+    scheduler.wait();
+    CORRADE_COMPARE(counter.load(), 101);
+}
+
+void TaskSchedulerTest::waitTask() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::atomic<bool> executed{false};
+    const UnsignedInt id = scheduler.add([&executed]{ executed = true; });
+    scheduler.wait(id);
+    CORRADE_VERIFY(scheduler.isDone(id));
+    CORRADE_VERIFY(executed.load());
+}
+
+void TaskSchedulerTest::dependencies() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+
+    /* A diamond, repeated several times to give the workers a chance to
+       reorder things */
+    for(std::size_t iteration = 0; iteration != 50; ++iteration) {
+        std::atomic<UnsignedInt> counter{0};
+        UnsignedInt order[4]{};
+        const UnsignedInt a = scheduler.add([&]{ order[0] = counter++; });
+        const UnsignedInt b = scheduler.add([&]{ order[1] = counter++; }, {a});
+        const UnsignedInt c = scheduler.add([&]{ order[2] = counter++; }, {a});
+        scheduler.add([&]{ order[3] = counter++; }, {b, c});
+        scheduler.wait();
+
+        CORRADE_COMPARE(counter.load(), 4);
+        CORRADE_COMPARE_AS(order[0], order[1], TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(order[0], order[2], TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(order[1], order[3], TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(order[2], order[3], TestSuite::Compare::Less);
+    }
+}
+
+void TaskSchedulerTest::dependenciesFinished() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::atomic<UnsignedInt> counter{0};
+    const UnsignedInt a = scheduler.add([&counter]{ ++counter; });
+    scheduler.wait(a);
+
+    /* Depending on an already finished task shouldn't block */
+    const UnsignedInt b = scheduler.add([&counter]{ ++counter; }, {a});
+    scheduler.wait(b);
+    CORRADE_COMPARE(counter.load(), 2);
+
+    /* Neither should depending on a task released by wait() */
+    scheduler.wait();
+    const UnsignedInt c = scheduler.add([&counter]{ ++counter; }, {a, b});
+    scheduler.wait(c);
+    CORRADE_COMPARE(counter.load(), 3);
+}
+
+void TaskSchedulerTest::waitStale() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    const UnsignedInt a = scheduler.add([]{});
+    scheduler.wait();
+
+    /* A task added after the wait() gets a new ID and the released one is
+       still reported as finished */
+    std::atomic<bool> executed{false};
+    const UnsignedInt b = scheduler.add([&executed]{ executed = true; });
+    CORRADE_VERIFY(b != a);
+    CORRADE_VERIFY(scheduler.isDone(a));
+    scheduler.wait(a);
+
+    scheduler.wait(b);
+    CORRADE_VERIFY(scheduler.isDone(b));
+    CORRADE_VERIFY(executed.load());
+}
+
+void TaskSchedulerTest::nested() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::atomic<UnsignedInt> counter{0};
+
+    /* Waiting from inside a task executes other tasks instead of blocking,
+       so this shouldn't deadlock even with a single worker */
+    for(std::size_t i = 0; i != 8; ++i) scheduler.add([&]{
+        UnsignedInt ids[4];
+        for(UnsignedInt& id: ids) id = scheduler.add([&counter]{ ++counter; });
+        for(UnsignedInt id: ids) scheduler.wait(id);
+    });
+    scheduler.wait();
+
+    CORRADE_COMPARE(counter.load(), 32);
+}
+
+void TaskSchedulerTest::singleThreadedOrder() {
+    TaskScheduler scheduler{0};
+
+    /* Tasks are executed directly in add() */
+    std::vector<Int> order;
+    const UnsignedInt a = scheduler.add([&order]{ order.push_back(0); });
+    CORRADE_COMPARE(order, std::vector<Int>{0});
+    CORRADE_VERIFY(scheduler.isDone(a));
+    scheduler.add([&order]{ order.push_back(1); }, {a});
+    scheduler.add([&order]{ order.push_back(2); });
+    CORRADE_COMPARE(order, (std::vector<Int>{0, 1, 2}));
+
+    /* Chunks are processed from first to last */
+    std::vector<std::size_t> ranges;
+    scheduler.parallelFor(10, 3, [&ranges](std::size_t begin, std::size_t end) {
+        ranges.push_back(begin);
+        ranges.push_back(end);
+    });
+    CORRADE_COMPARE(ranges, (std::vector<std::size_t>{
+        0, 3, 3, 6, 6, 9, 9, 10}));
+}
+
+void TaskSchedulerTest::parallelFor() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+
+    /* Every index should be visited exactly once, in chunks of at most the
+       grain size */
+    Containers::Array<UnsignedInt> visited{Containers::ValueInit, 100003};
+    std::atomic<std::size_t> largestChunk{0};
+    scheduler.parallelFor(visited.size(), 1000, [&](std::size_t begin, std::size_t end) {
+        std::size_t size = end - begin;
+        std::size_t largest = largestChunk;
+        while(size > largest && !largestChunk.compare_exchange_weak(largest, size));
+        for(std::size_t i = begin; i != end; ++i) ++visited[i];
+    });
+
+    CORRADE_COMPARE(largestChunk.load(), 1000);
+    std::size_t wrongCount = 0;
+    for(std::size_t i = 0; i != visited.size(); ++i)
+        if(visited[i] != 1) ++wrongCount;
+    CORRADE_COMPARE(wrongCount, 0);
+}
+
+void TaskSchedulerTest::parallelForEmpty() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    bool called = false;
+    scheduler.parallelFor(0, 100, [&called](std::size_t, std::size_t) {
+        called = true;
+    });
+    CORRADE_VERIFY(!called);
+}
+
+void TaskSchedulerTest::parallelForSingleChunk() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::vector<std::size_t> ranges;
+    scheduler.parallelFor(57, 100, [&ranges](std::size_t begin, std::size_t end) {
+        ranges.push_back(begin);
+        ranges.push_back(end);
+    });
+    CORRADE_COMPARE(ranges, (std::vector<std::size_t>{0, 57}));
+}
+
+void TaskSchedulerTest::parallelForStrided() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+
+    /* Every second item of the array */
+    Containers::Array<std::size_t> array{Containers::ValueInit, 20000};
+    Containers::StridedArrayView1D<std::size_t> view{array, array.data(), array.size()/2, 2*sizeof(std::size_t)};
+    scheduler.parallelFor(view, 128, [](const Containers::StridedArrayView1D<std::size_t>& slice, std::size_t offset) {
+        for(std::size_t i = 0; i != slice.size(); ++i)
+            slice[i] = offset + i + 1;
+    });
+
+    std::size_t wrongCount = 0;
+    for(std::size_t i = 0; i != array.size(); ++i)
+        if(array[i] != (i % 2 ? 0 : i/2 + 1)) ++wrongCount;
+    CORRADE_COMPARE(wrongCount, 0);
+}
+
+void TaskSchedulerTest::parallelForNested() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TaskScheduler scheduler{data.workerCount};
+    std::atomic<std::size_t> sum{0};
+    scheduler.parallelFor(16, 1, [&](std::size_t, std::size_t) {
+        scheduler.parallelFor(1000, 100, [&sum](std::size_t begin, std::size_t end) {
+            sum += end - begin;
+        });
+    });
+    CORRADE_COMPARE(sum.load(), 16000);
+}
+
+void TaskSchedulerTest::parallelForZeroGrainSize() {
+    TaskScheduler scheduler{0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.parallelFor(10, 0, [](std::size_t, std::size_t) {});
+    CORRADE_COMPARE(out.str(), "TaskScheduler::parallelFor(): grain size can't be zero\n");
+}
+
+void TaskSchedulerTest::isDoneOutOfRange() {
+    TaskScheduler scheduler{0};
+    scheduler.add([]{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.isDone(1);
+    CORRADE_COMPARE(out.str(), "TaskScheduler::isDone(): task 1 not added yet\n");
+}
+
+void TaskSchedulerTest::waitOutOfRange() {
+    TaskScheduler scheduler{0};
+    scheduler.add([]{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.wait(1);
+    CORRADE_COMPARE(out.str(), "TaskScheduler::wait(): task 1 not added yet\n");
+}
+
+void TaskSchedulerTest::addDependencyOutOfRange() {
+    TaskScheduler scheduler{0};
+    scheduler.add([]{});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.add([]{}, {0, 1});
+    CORRADE_COMPARE(out.str(), "TaskScheduler::add(): dependency 1 not added yet\n");
+}
+
+void TaskSchedulerTest::packInto() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split into several chunks */
+    Containers::Array<Float> src{Containers::NoInit, 3*50000};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i % 1000)/999.0f;
+    const Containers::StridedArrayView2D<const Float> srcView{src, {50000, 3}};
+
+    Containers::Array<UnsignedShort> expected{Containers::NoInit, src.size()};
+    Math::packInto(srcView, Containers::StridedArrayView2D<UnsignedShort>{expected, {50000, 3}});
+
+    TaskScheduler scheduler{data.workerCount};
+    Containers::Array<UnsignedShort> dst{Containers::NoInit, src.size()};
+    Math::packInto(scheduler, srcView, Containers::StridedArrayView2D<UnsignedShort>{dst, {50000, 3}});
+    CORRADE_COMPARE_AS(dst, expected, TestSuite::Compare::Container);
+}
+
+void TaskSchedulerTest::unpackInto() {
+    auto&& data = WorkerData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Byte> src{Containers::NoInit, 4*50000};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Byte(i % 256 - 128);
+    const Containers::StridedArrayView2D<const Byte> srcView{src, {50000, 4}};
+
+    Containers::Array<Float> expected{Containers::NoInit, src.size()};
+    Math::unpackInto(srcView, Containers::StridedArrayView2D<Float>{expected, {50000, 4}});
+
+    TaskScheduler scheduler{data.workerCount};
+    Containers::Array<Float> dst{Containers::NoInit, src.size()};
+    Math::unpackInto(scheduler, srcView, Containers::StridedArrayView2D<Float>{dst, {50000, 4}});
+    CORRADE_COMPARE_AS(dst, expected, TestSuite::Compare::Container);
+}
+
+void TaskSchedulerTest::packIntoWrongSize() {
+    const Float src[6]{};
+    UnsignedByte dst[4];
+
+    TaskScheduler scheduler{0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::packInto(scheduler,
+        Containers::StridedArrayView2D<const Float>{src, {3, 2}},
+        Containers::StridedArrayView2D<UnsignedByte>{dst, {2, 2}});
+    CORRADE_COMPARE(out.str(), "Math::packInto(): wrong destination size, got {2, 2} but expected {3, 2}\n");
+}
+
+void TaskSchedulerTest::benchmarkParallelFor() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Mostly measures the scheduling overhead */
+    TaskScheduler scheduler{data.workerCount};
+    Containers::Array<UnsignedInt> values{Containers::ValueInit, 1 << 20};
+    CORRADE_BENCHMARK(1) {
+        scheduler.parallelFor(values.size(), 4096, [&values](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) values[i] += i;
+        });
+    }
+
+    CORRADE_COMPARE(values[1000] % 1000, 0);
+    CORRADE_VERIFY(values[1000]);
+}
+
+void TaskSchedulerTest::benchmarkPackInto() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Float> src{Containers::NoInit, 4*(1 << 18)};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i % 1000)/999.0f;
+
+    TaskScheduler scheduler{data.workerCount};
+    Containers::Array<UnsignedByte> dst{Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        Math::packInto(scheduler,
+            Containers::StridedArrayView2D<const Float>{src, {1 << 18, 4}},
+            Containers::StridedArrayView2D<UnsignedByte>{dst, {1 << 18, 4}});
+    }
+
+    CORRADE_COMPARE(dst[999], 255);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TaskSchedulerTest)
@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GlyphTable.h"
+
+#include <cstring>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+std::size_t hashTextureCoordinates(const Range2D& textureCoordinates) {
+    /* FNV-1a over the raw float bits. The texture coordinates are never
+       calculated, only passed through, so bitwise comparison is fine. */
+    UnsignedInt bits[4];
+    static_assert(sizeof(bits) == sizeof(Range2D), "unexpected Range2D size");
+    std::memcpy(bits, &textureCoordinates, sizeof(bits));
+    std::size_t hash = 2166136261u;
+    for(UnsignedInt b: bits) {
+        hash ^= b;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+}
+
+GlyphTable::GlyphTable(): _glyphCount{} {}
+
+GlyphTable::GlyphTable(AbstractFont& font, const AbstractGlyphCache& cache, const Float size): GlyphTable{} {
+    _lookup.reserve(cache.glyphCount());
+
+    /* Same calculation as in font plugins (e.g. MagnumFont), so the texture
+       coordinates match exactly what the layouter gives back later */
+    const Vector2 textureScale = 1.0f/Vector2{cache.textureSize()};
+    const Vector2 quadScale{size/font.size()};
+    for(const auto& glyph: cache) {
+        const Range2Di& rectangle = glyph.second.second;
+        add(Range2D{rectangle}.scaled(textureScale),
+            Range2D{Range2Di::fromSize(glyph.second.first, rectangle.size())}.scaled(quadScale).size());
+    }
+}
+
+UnsignedInt GlyphTable::add(const Range2D& textureCoordinates, const Vector2& quadSize) {
+    const std::size_t hash = hashTextureCoordinates(textureCoordinates);
+    const auto found = _lookup.equal_range(hash);
+    for(auto it = found.first; it != found.second; ++it) {
+        /* The same texture area can be used for quads of different sizes, for
+           example if the same cache is used for several font sizes */
+        const Vector4& existing = _data[it->second*2];
+        if(existing.xy() == textureCoordinates.min() && existing.zw() == textureCoordinates.max() && _data[it->second*2 + 1].xy() == quadSize)
+            return it->second;
+    }
+
+    /* Grow by a whole row if there's no space left */
+    if(_glyphCount*2 == _data.size())
+        _data.resize(_data.size() + GlyphsPerRow*2);
+
+    const UnsignedInt glyph = _glyphCount++;
+    _data[glyph*2] = {textureCoordinates.left(), textureCoordinates.bottom(),
+                      textureCoordinates.right(), textureCoordinates.top()};
+    _data[glyph*2 + 1] = {quadSize.x(), quadSize.y(), 0.0f, 0.0f};
+    _lookup.emplace(hash, glyph);
+    return glyph;
+}
+
+Range2D GlyphTable::textureCoordinates(const UnsignedInt glyph) const {
+    CORRADE_ASSERT(glyph < _glyphCount,
+        "Text::GlyphTable::textureCoordinates(): index" << glyph << "out of range for" << _glyphCount << "glyphs", {});
+    const Vector4& data = _data[glyph*2];
+    return {data.xy(), data.zw()};
+}
+
+Vector2 GlyphTable::quadSize(const UnsignedInt glyph) const {
+    CORRADE_ASSERT(glyph < _glyphCount,
+        "Text::GlyphTable::quadSize(): index" << glyph << "out of range for" << _glyphCount << "glyphs", {});
+    return _data[glyph*2 + 1].xy();
+}
+
+ImageView2D GlyphTable::image() const {
+    return ImageView2D{PixelFormat::RGBA32F,
+        {GlyphsPerRow*2, Int(_data.size()/(GlyphsPerRow*2))},
+        Containers::arrayView(_data)};
+}
+
+}}
@@ -0,0 +1,176 @@
+#ifndef Magnum_Text_GlyphTable_h
+#define Magnum_Text_GlyphTable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::GlyphTable, struct @ref Magnum::Text::InstancedGlyph
+ * @m_since_latest
+ */
+
+#include <vector>
+#include <unordered_map>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Instanced glyph
+@m_since_latest
+
+One glyph quad as consumed by @ref Shaders::AbstractVector::Flag::InstancedGlyphs.
+Compared to the four vertices with a position and texture coordinates and six
+indices per glyph produced by @ref Renderer, it's 20 bytes instead of 76 bytes
+in the best case, while additionally allowing to scale and color each glyph
+separately.
+@see @ref GlyphTable, @ref InstancedRenderer
+*/
+struct InstancedGlyph {
+    /** @brief Bottom left corner of the glyph quad */
+    Vector2 position;
+
+    /** @brief Index into @ref GlyphTable */
+    UnsignedInt glyph;
+
+    /**
+     * @brief Glyph scale
+     *
+     * Scales the quad size from @ref GlyphTable around @ref position.
+     */
+    Float scale;
+
+    /**
+     * @brief Glyph color
+     *
+     * Multiplied with the color set on the shader.
+     */
+    Color4ub color;
+};
+
+/**
+@brief Glyph rectangle table
+@m_since_latest
+
+Contains texture coordinates and quad size of each distinct glyph, referenced
+from @ref InstancedGlyph::glyph. The data are stored as two
+@ref Magnum::Vector4 "Vector4" per glyph --- the first is the texture
+coordinate rectangle in a @f$ (x_{min}, y_{min}, x_{max}, y_{max}) @f$ order
+and the second has the quad size in the first two components --- with
+@ref GlyphsPerRow glyphs in a row. The whole table is meant to be uploaded to
+a @ref PixelFormat::RGBA32F texture and bound to a shader via
+@ref Shaders::AbstractVector::bindGlyphTableTexture(), see @ref image().
+
+The table is filled with all glyphs from a glyph cache on construction.
+Glyphs are identified by their texture coordinates and quad size, because
+that's the only information @ref AbstractLayouter::renderGlyph() gives back,
+thus if a font plugin calculates glyph quads differently than assumed here,
+the glyph gets appended to the table on the first @ref add() call instead. Use
+@ref glyphCount() to detect whether the table changed and needs to be
+uploaded again.
+
+This class doesn't depend on any graphics API and can be used on its own.
+@see @ref InstancedRenderer
+*/
+class MAGNUM_TEXT_EXPORT GlyphTable {
+    public:
+        enum: UnsignedInt {
+            /** Count of glyphs in a single table row */
+            GlyphsPerRow = 256
+        };
+
+        /**
+         * @brief Construct an empty table
+         *
+         * Glyphs can be added using @ref add().
+         */
+        explicit GlyphTable();
+
+        /**
+         * @brief Construct a table from a glyph cache
+         * @param font      Font
+         * @param cache     Glyph cache
+         * @param size      Font size
+         *
+         * Adds all glyphs in the glyph cache, with quads scaled to given
+         * size.
+         */
+        explicit GlyphTable(AbstractFont& font, const AbstractGlyphCache& cache, Float size);
+
+        /** @brief Count of glyphs in the table */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /**
+         * @brief Add a glyph
+         * @param textureCoordinates    Glyph texture coordinates
+         * @param quadSize              Glyph quad size
+         * @return Index of the glyph in the table
+         *
+         * If a glyph with the same texture coordinates and quad size is
+         * already present, returns its index, otherwise appends a new one.
+         */
+        UnsignedInt add(const Range2D& textureCoordinates, const Vector2& quadSize);
+
+        /** @brief Texture coordinates of given glyph */
+        Range2D textureCoordinates(UnsignedInt glyph) const;
+
+        /** @brief Quad size of given glyph */
+        Vector2 quadSize(UnsignedInt glyph) const;
+
+        /**
+         * @brief Table data
+         *
+         * Two items per glyph, padded to whole rows. See class documentation
+         * for details about the layout.
+         */
+        Containers::ArrayView<const Vector4> data() const {
+            return {_data.data(), _data.size()};
+        }
+
+        /**
+         * @brief Table image
+         *
+         * The @ref data() wrapped in a @ref PixelFormat::RGBA32F image of
+         * size @cpp {GlyphsPerRow*2, rowCount} @ce. For an empty table it has
+         * zero size.
+         */
+        ImageView2D image() const;
+
+    private:
+        UnsignedInt _glyphCount;
+        std::vector<Vector4> _data;
+        /* Hash of the texture coordinates to glyph index, colliding entries
+           are resolved by comparing the actual data */
+        std::unordered_multimap<std::size_t, UnsignedInt> _lookup;
+};
+
+}}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef Magnum_Text_Implementation_renderGlyphs_h
+#define Magnum_Text_Implementation_renderGlyphs_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/Alignment.h"
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+/* Lays out the text line by line and aligns it. For each glyph the output
+   function is called with the output vector, quad position and texture
+   coordinates and is expected to append exactly glyphStride items to it. The
+   items are expected to have a Vector2 position member, which gets
+   translated for alignment. Shared by Renderer and InstancedRenderer. */
+template<class T, class Output> Range2D renderGlyphs(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const std::string& text, const Alignment alignment, std::vector<T>& out, const std::size_t glyphStride, Output output) {
+    /* Reserve memory as when the text would be ASCII-only. In reality the
+       actual item count will be smaller, but allocating more at once is
+       better than reallocating many times later. */
+    out.clear();
+    out.reserve(text.size()*glyphStride);
+
+    /* Total rendered bounds, intial line position, line increment, last+1
+       item on previous line */
+    Range2D rectangle;
+    Vector2 linePosition;
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
+    std::size_t lastLineLastItem = 0;
+
+    /* Temp buffer so we don't allocate for each new line */
+    /**
+     * @todo C++1z: use std::string_view to avoid the one allocation and all
+     *      the copying altogether
+     */
+    std::string line;
+    line.reserve(text.size());
+
+    /* Render each line separately and align it horizontally */
+    std::size_t pos, prevPos = 0;
+    do {
+        /* Empty line, nothing to do (the rest is done below in while expression) */
+        if((pos = text.find('\n', prevPos)) == prevPos) continue;
+
+        /* Copy the line into the temp buffer */
+        line.assign(text, prevPos, pos-prevPos);
+
+        /* Layout the line */
+        Containers::Pointer<AbstractLayouter> layouter = font.layout(cache, size, line);
+
+        /* Verify that we don't reallocate anything. The only problem might
+           arise when the layouter decides to compose one character from more
+           than one glyph (i.e. accents). Will remove the assert when this
+           issue arises. */
+        CORRADE_INTERNAL_ASSERT(out.size() + layouter->glyphCount()*glyphStride <= out.capacity());
+
+        /* Bounds of rendered line */
+        Range2D lineRectangle;
+
+        /* Render all glyphs */
+        Vector2 cursorPosition(linePosition);
+        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+            Range2D quadPosition, textureCoordinates;
+            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
+            output(out, quadPosition, textureCoordinates);
+        }
+
+        /** @todo What about top-down text? */
+
+        /* Horizontally align the rendered line */
+        Float alignmentOffsetX = 0.0f;
+        if((UnsignedByte(alignment) & AlignmentHorizontal) == AlignmentCenter)
+            alignmentOffsetX = -lineRectangle.centerX();
+        else if((UnsignedByte(alignment) & AlignmentHorizontal) == AlignmentRight)
+            alignmentOffsetX = -lineRectangle.right();
+
+        /* Integer alignment */
+        if(UnsignedByte(alignment) & AlignmentIntegral)
+            alignmentOffsetX = Math::round(alignmentOffsetX);
+
+        /* Align positions and bounds on current line */
+        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+        for(auto it = out.begin()+lastLineLastItem; it != out.end(); ++it)
+            it->position.x() += alignmentOffsetX;
+
+        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
+        if(!rectangle.size().isZero()) {
+            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+        } else rectangle = lineRectangle;
+
+    /* Move to next line */
+    } while(prevPos = pos+1,
+            linePosition -= lineAdvance,
+            lastLineLastItem = out.size(),
+            pos != std::string::npos);
+
+    /* Vertically align the rendered text */
+    Float alignmentOffsetY = 0.0f;
+    if((UnsignedByte(alignment) & AlignmentVertical) == AlignmentMiddle)
+        alignmentOffsetY = -rectangle.centerY();
+    else if((UnsignedByte(alignment) & AlignmentVertical) == AlignmentTop)
+        alignmentOffsetY = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & AlignmentIntegral)
+        alignmentOffsetY = Math::round(alignmentOffsetY);
+
+    /* Align positions and bounds */
+    rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
+    for(auto& v: out) v.position.y() += alignmentOffsetY;
+
+    return rectangle;
+}
+
+}}}
+
+#endif
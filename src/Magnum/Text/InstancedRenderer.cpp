@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstancedRenderer.h"
+
+#include <Corrade/Containers/ArrayViewStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Shaders/AbstractVector.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Implementation/renderGlyphs.h"
+
+namespace Magnum { namespace Text {
+
+static_assert(sizeof(InstancedGlyph) == 20, "improper size of InstancedGlyph");
+
+std::tuple<std::vector<InstancedGlyph>, Range2D> AbstractInstancedRenderer::render(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, GlyphTable& glyphTable, const Alignment alignment) {
+    std::vector<InstancedGlyph> glyphs;
+    const Range2D rectangle = Implementation::renderGlyphs(font, cache, size, text, alignment, glyphs, 1,
+        [&glyphTable](std::vector<InstancedGlyph>& out, const Range2D& quadPosition, const Range2D& textureCoordinates) {
+            out.push_back({quadPosition.bottomLeft(), glyphTable.add(textureCoordinates, quadPosition.size()), 1.0f, Color4ub{255}});
+        });
+
+    return std::make_tuple(std::move(glyphs), rectangle);
+}
+
+AbstractInstancedRenderer::AbstractInstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _instanceBuffer{GL::Buffer::TargetHint::Array}, _font(font), _cache(cache), _size(size), _alignment(alignment), _capacity(0), _glyphTable{font, cache, size}, _uploadedGlyphCount{0} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::instanced_arrays);
+    #endif
+
+    _glyphTableTexture
+        .setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge);
+    uploadGlyphTable();
+
+    /* Four vertices of a triangle strip per instance, no instances yet */
+    _mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .setInstanceCount(0);
+}
+
+AbstractInstancedRenderer::~AbstractInstancedRenderer() = default;
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::InstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): AbstractInstancedRenderer(font, cache, size, alignment) {
+    /* Finalize mesh configuration */
+    _mesh.addVertexBufferInstanced(_instanceBuffer, 1, 0,
+        typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+        typename Shaders::AbstractVector<dimensions>::GlyphIndex(),
+        typename Shaders::AbstractVector<dimensions>::GlyphScale(),
+        typename Shaders::AbstractVector<dimensions>::GlyphColor(
+            Shaders::AbstractVector<dimensions>::GlyphColor::DataType::UnsignedByte,
+            Shaders::AbstractVector<dimensions>::GlyphColor::DataOption::Normalized));
+}
+
+void AbstractInstancedRenderer::uploadGlyphTable() {
+    if(_glyphTable.glyphCount() == _uploadedGlyphCount) return;
+
+    /* The table is small, so it's simpler to upload it whole again than to
+       track which rows changed */
+    _glyphTableTexture.setImage(0, GL::TextureFormat::RGBA32F, _glyphTable.image());
+    _uploadedGlyphCount = _glyphTable.glyphCount();
+}
+
+void AbstractInstancedRenderer::reserve(const UnsignedInt glyphCount, const GL::BufferUsage usage) {
+    _capacity = glyphCount;
+
+    /* Allocate instance buffer, reset instance count */
+    _instanceBuffer.setData({nullptr, glyphCount*sizeof(InstancedGlyph)}, usage);
+    _mesh.setInstanceCount(0);
+}
+
+void AbstractInstancedRenderer::render(const std::string& text) {
+    /* Render instance data */
+    std::vector<InstancedGlyph> glyphs;
+    _rectangle = {};
+    std::tie(glyphs, _rectangle) = render(_font, _cache, _size, text, _glyphTable, _alignment);
+
+    const UnsignedInt glyphCount = glyphs.size();
+    CORRADE_ASSERT(glyphCount <= _capacity,
+        "Text::InstancedRenderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* The layouter produced glyphs that weren't in the cache-populated table,
+       reupload it */
+    uploadGlyphTable();
+
+    /* The instance data are an order of magnitude smaller than in case of
+       Renderer, so a plain data update is used instead of buffer mapping */
+    _instanceBuffer.setSubData(0, glyphs);
+
+    /* Update instance count */
+    _mesh.setInstanceCount(glyphCount);
+}
+
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<2>;
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<3>;
+
+}}
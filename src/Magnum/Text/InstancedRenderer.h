@@ -0,0 +1,227 @@
+#ifndef Magnum_Text_InstancedRenderer_h
+#define Magnum_Text_InstancedRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::AbstractInstancedRenderer, @ref Magnum::Text::InstancedRenderer, typedef @ref Magnum::Text::InstancedRenderer2D, @ref Magnum::Text::InstancedRenderer3D
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#ifndef MAGNUM_TARGET_GLES2
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/GlyphTable.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Base for instanced text renderers
+@m_since_latest
+
+Not meant to be used directly, see @ref InstancedRenderer for more information.
+@see @ref InstancedRenderer2D, @ref InstancedRenderer3D
+*/
+class MAGNUM_TEXT_EXPORT AbstractInstancedRenderer {
+    public:
+        /**
+         * @brief Render text
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param text          Text to render
+         * @param glyphTable    Glyph table to reference glyphs from
+         * @param alignment     Text alignment
+         *
+         * Returns per-glyph instance data and rectangle spanning the
+         * rendered text. Glyphs not yet present in @p glyphTable are added
+         * to it. The @ref InstancedGlyph::scale is set to @cpp 1.0f @ce and
+         * @ref InstancedGlyph::color to white, change them as needed before
+         * uploading the data.
+         */
+        static std::tuple<std::vector<InstancedGlyph>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GlyphTable& glyphTable, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const { return _rectangle; }
+
+        /** @brief Glyph table */
+        const GlyphTable& glyphTable() const { return _glyphTable; }
+
+        /**
+         * @brief Glyph table texture
+         *
+         * Contents of @ref glyphTable() uploaded to a
+         * @ref GL::TextureFormat::RGBA32F texture, meant to be bound via
+         * @ref Shaders::AbstractVector::bindGlyphTableTexture().
+         */
+        GL::Texture2D& glyphTableTexture() { return _glyphTableTexture; }
+
+        /** @brief Instance buffer */
+        GL::Buffer& instanceBuffer() { return _instanceBuffer; }
+
+        /** @brief Mesh */
+        GL::Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates memory in the instance buffer to hold @p glyphCount
+         * glyphs. Consider using appropriate @p usage if the text will be
+         * changed frequently.
+         *
+         * Initially zero capacity is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, GL::BufferUsage usage);
+
+        /**
+         * @brief Render text
+         *
+         * Renders the text to the instance buffer and updates the instance
+         * count of @ref mesh(). If the text contains glyphs that weren't in
+         * the glyph table yet, the table texture is uploaded again.
+         * Rectangle spanning the rendered text is available through
+         * @ref rectangle().
+         *
+         * Initially no text is rendered.
+         * @attention The capacity must be large enough to contain all glyphs,
+         *      see @ref reserve() for more information.
+         */
+        void render(const std::string& text);
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        explicit MAGNUM_TEXT_LOCAL AbstractInstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment);
+
+        ~AbstractInstancedRenderer();
+
+        GL::Mesh _mesh;
+        GL::Buffer _instanceBuffer;
+
+    private:
+        MAGNUM_TEXT_LOCAL void uploadGlyphTable();
+
+        AbstractFont& _font;
+        const GlyphCache& _cache;
+        Float _size;
+        Alignment _alignment;
+        UnsignedInt _capacity;
+        Range2D _rectangle;
+        GlyphTable _glyphTable;
+        GL::Texture2D _glyphTableTexture;
+        UnsignedInt _uploadedGlyphCount;
+};
+
+/**
+@brief Instanced text renderer
+@m_since_latest
+
+Alternative to @ref Renderer that, instead of four vertices and six indices
+per glyph, uploads a single @ref InstancedGlyph per glyph and draws each glyph
+as an instance of a four-vertex triangle strip. Texture coordinates and quad
+sizes of all distinct glyphs are stored in a @ref GlyphTable that's uploaded
+to @ref glyphTableTexture() and the quad corners are expanded in the vertex
+shader. That makes the per-glyph data almost four times smaller, which matters
+mostly for large amounts of frequently changing text.
+
+The mesh is meant to be rendered with a @ref Shaders::AbstractVector subclass
+created with @ref Shaders::AbstractVector::Flag::InstancedGlyphs:
+
+@code{.cpp}
+Text::InstancedRenderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, GL::BufferUsage::DynamicDraw);
+renderer.render("Hello World!");
+
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::InstancedGlyphs};
+shader.bindVectorTexture(cache.texture())
+    .bindGlyphTableTexture(renderer.glyphTableTexture());
+renderer.mesh().draw(shader);
+@endcode
+
+@requires_gl30 Extension @gl_extension{ARB,instanced_arrays}
+@requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+
+@see @ref InstancedRenderer2D, @ref InstancedRenderer3D, @ref AbstractFont
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT InstancedRenderer: public AbstractInstancedRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit InstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        InstancedRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        using AbstractInstancedRenderer::render;
+        #endif
+};
+
+/**
+@brief Two-dimensional instanced text renderer
+@m_since_latest
+*/
+typedef InstancedRenderer<2> InstancedRenderer2D;
+
+/**
+@brief Three-dimensional instanced text renderer
+@m_since_latest
+*/
+typedef InstancedRenderer<3> InstancedRenderer3D;
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
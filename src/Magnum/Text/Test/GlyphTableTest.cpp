@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/GlyphTable.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct GlyphTableTest: TestSuite::Tester {
+    explicit GlyphTableTest();
+
+    void constructEmpty();
+    void constructFromCache();
+
+    void add();
+    void addDuplicate();
+    void addDifferentQuadSize();
+    void addNextRow();
+
+    void accessOutOfRange();
+};
+
+GlyphTableTest::GlyphTableTest() {
+    addTests({&GlyphTableTest::constructEmpty,
+              &GlyphTableTest::constructFromCache,
+
+              &GlyphTableTest::add,
+              &GlyphTableTest::addDuplicate,
+              &GlyphTableTest::addDifferentQuadSize,
+              &GlyphTableTest::addNextRow,
+
+              &GlyphTableTest::accessOutOfRange});
+}
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+struct DummyFont: AbstractFont {
+    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+
+    Metrics doOpenData(Containers::ArrayView<const char>, Float size) override {
+        _opened = true;
+        return {size, 1.0f, -1.0f, 2.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+
+    bool _opened = false;
+};
+
+void GlyphTableTest::constructEmpty() {
+    GlyphTable table;
+
+    CORRADE_COMPARE(table.glyphCount(), 0);
+    CORRADE_VERIFY(table.data().empty());
+
+    ImageView2D image = table.image();
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA32F);
+    CORRADE_COMPARE(image.size(), (Vector2i{512, 0}));
+}
+
+void GlyphTableTest::constructFromCache() {
+    DummyFont font;
+    CORRADE_VERIFY(font.openData(nullptr, 16.0f));
+
+    DummyGlyphCache cache{{100, 200}};
+    cache.insert(3, {1, 2}, Range2Di::fromSize({10, 20}, {5, 10}));
+
+    /* Rendering at half the font size */
+    GlyphTable table{font, cache, 8.0f};
+
+    /* The invalid glyph is always in the cache */
+    CORRADE_COMPARE(table.glyphCount(), 2);
+
+    /* Same texture coordinates as a font plugin would calculate --- adding
+       them again should return an existing glyph */
+    const UnsignedInt glyph = table.add(Range2D{Range2Di::fromSize({10, 20}, {5, 10})}.scaled(1.0f/Vector2{100.0f, 200.0f}), {2.5f, 5.0f});
+    CORRADE_COMPARE(table.glyphCount(), 2);
+    CORRADE_COMPARE(table.textureCoordinates(glyph), (Range2D{{0.1f, 0.1f}, {0.15f, 0.15f}}));
+    CORRADE_COMPARE(table.quadSize(glyph), (Vector2{2.5f, 5.0f}));
+}
+
+void GlyphTableTest::add() {
+    GlyphTable table;
+    CORRADE_COMPARE(table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {3.0f, 2.0f}), 0);
+    CORRADE_COMPARE(table.add({{0.0f, 0.0f}, {0.25f, 0.125f}}, {1.0f, 0.5f}), 1);
+    CORRADE_COMPARE(table.glyphCount(), 2);
+
+    CORRADE_COMPARE(table.textureCoordinates(0), (Range2D{{0.25f, 0.5f}, {0.5f, 0.75f}}));
+    CORRADE_COMPARE(table.quadSize(0), (Vector2{3.0f, 2.0f}));
+    CORRADE_COMPARE(table.textureCoordinates(1), (Range2D{{0.0f, 0.0f}, {0.25f, 0.125f}}));
+    CORRADE_COMPARE(table.quadSize(1), (Vector2{1.0f, 0.5f}));
+
+    /* Padded to a whole row */
+    CORRADE_COMPARE(table.data().size(), 512);
+    CORRADE_COMPARE(table.data()[0], (Vector4{0.25f, 0.5f, 0.5f, 0.75f}));
+    CORRADE_COMPARE(table.data()[1], (Vector4{3.0f, 2.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(table.data()[2], (Vector4{0.0f, 0.0f, 0.25f, 0.125f}));
+    CORRADE_COMPARE(table.data()[3], (Vector4{1.0f, 0.5f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(table.image().size(), (Vector2i{512, 1}));
+}
+
+void GlyphTableTest::addDuplicate() {
+    GlyphTable table;
+    table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {3.0f, 2.0f});
+    table.add({{0.0f, 0.0f}, {0.25f, 0.125f}}, {1.0f, 0.5f});
+
+    CORRADE_COMPARE(table.add({{0.0f, 0.0f}, {0.25f, 0.125f}}, {1.0f, 0.5f}), 1);
+    CORRADE_COMPARE(table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {3.0f, 2.0f}), 0);
+    CORRADE_COMPARE(table.glyphCount(), 2);
+}
+
+void GlyphTableTest::addDifferentQuadSize() {
+    GlyphTable table;
+    table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {3.0f, 2.0f});
+
+    /* Same texture area but a different size is a different glyph */
+    CORRADE_COMPARE(table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {1.5f, 1.0f}), 1);
+    CORRADE_COMPARE(table.glyphCount(), 2);
+    CORRADE_COMPARE(table.quadSize(0), (Vector2{3.0f, 2.0f}));
+    CORRADE_COMPARE(table.quadSize(1), (Vector2{1.5f, 1.0f}));
+
+    /* Both are found afterwards */
+    CORRADE_COMPARE(table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {3.0f, 2.0f}), 0);
+    CORRADE_COMPARE(table.add({{0.25f, 0.5f}, {0.5f, 0.75f}}, {1.5f, 1.0f}), 1);
+    CORRADE_COMPARE(table.glyphCount(), 2);
+}
+
+void GlyphTableTest::addNextRow() {
+    GlyphTable table;
+    for(UnsignedInt i = 0; i != GlyphTable::GlyphsPerRow + 1; ++i)
+        CORRADE_COMPARE(table.add({{Float(i), 0.0f}, {Float(i) + 1.0f, 1.0f}}, {1.0f, 1.0f}), i);
+
+    CORRADE_COMPARE(table.glyphCount(), 257);
+    CORRADE_COMPARE(table.data().size(), 1024);
+    CORRADE_COMPARE(table.image().size(), (Vector2i{512, 2}));
+    CORRADE_COMPARE(table.textureCoordinates(256), (Range2D{{256.0f, 0.0f}, {257.0f, 1.0f}}));
+}
+
+void GlyphTableTest::accessOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GlyphTable table;
+    table.add({}, {});
+    table.textureCoordinates(1);
+    table.quadSize(1);
+    CORRADE_COMPARE(out.str(),
+        "Text::GlyphTable::textureCoordinates(): index 1 out of range for 1 glyphs\n"
+        "Text::GlyphTable::quadSize(): index 1 out of range for 1 glyphs\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::GlyphTableTest)
@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/InstancedRenderer.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct InstancedRendererGLTest: GL::OpenGLTester {
+    explicit InstancedRendererGLTest();
+
+    void renderData();
+    void renderDataExistingGlyphs();
+    void mutableText();
+};
+
+InstancedRendererGLTest::InstancedRendererGLTest() {
+    addTests({&InstancedRendererGLTest::renderData,
+              &InstancedRendererGLTest::renderDataExistingGlyphs,
+              &InstancedRendererGLTest::mutableText});
+}
+
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*((i+1)*_size)),
+                Range2D::fromSize({i*6.0f, 0.0f}, {6.0f, 10.0f}),
+                (Vector2::xAxis((i+1)*3.0f)+Vector2(1.0f, -1.0f))*_size
+            );
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    FontFeatures doFeatures() const override { return {}; }
+
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+
+    Metrics doOpenFile(const std::string&, const Float size) override {
+        _opened = true;
+        return {size, 1.0f, -1.0f, 2.0f};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, const Float size, const std::string& text) override {
+        return Containers::Pointer<AbstractLayouter>(new TestLayouter(size, text.size()));
+    }
+
+    bool _opened = false;
+};
+
+/* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
+char glyphCacheData;
+GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
+
+void InstancedRendererGLTest::renderData() {
+    TestFont font;
+    CORRADE_VERIFY(font.openFile({}, 0.5f));
+    GlyphTable glyphTable;
+    std::vector<InstancedGlyph> glyphs;
+    Range2D bounds;
+    std::tie(glyphs, bounds) = AbstractInstancedRenderer::render(font, nullGlyphCache, 0.25f, "abc", glyphTable, Alignment::TopCenter);
+
+    /* Alignment offset */
+    const Vector2 offset{-2.5f, -1.0f};
+
+    /* Same bounds as with the non-instanced renderer */
+    CORRADE_COMPARE(bounds, Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated(offset));
+
+    /* One instance per glyph, positioned at the bottom left quad corner
+              +---+
+          +-+ |   |
+        a |b| | c |
+          +-+ |   |
+              +---+ */
+    CORRADE_COMPARE(glyphs.size(), 3);
+    CORRADE_COMPARE(glyphs[0].position, (Vector2{0.0f, 0.0f} + offset));
+    CORRADE_COMPARE(glyphs[0].glyph, 0);
+    CORRADE_COMPARE(glyphs[1].position, (Vector2{1.0f, -0.25f} + offset));
+    CORRADE_COMPARE(glyphs[1].glyph, 1);
+    CORRADE_COMPARE(glyphs[2].position, (Vector2{2.75f, -0.5f} + offset));
+    CORRADE_COMPARE(glyphs[2].glyph, 2);
+
+    /* Scale and color are left at defaults for the user to change */
+    for(const InstancedGlyph& glyph: glyphs) {
+        CORRADE_COMPARE(glyph.scale, 1.0f);
+        CORRADE_COMPARE(glyph.color, Color4ub{255});
+    }
+
+    /* Quad sizes and texture coordinates went into the table */
+    CORRADE_COMPARE(glyphTable.glyphCount(), 3);
+    CORRADE_COMPARE(glyphTable.quadSize(0), (Vector2{0.75f, 0.5f}));
+    CORRADE_COMPARE(glyphTable.textureCoordinates(0), (Range2D{{0.0f, 0.0f}, {6.0f, 10.0f}}));
+    CORRADE_COMPARE(glyphTable.quadSize(1), (Vector2{1.5f, 1.0f}));
+    CORRADE_COMPARE(glyphTable.textureCoordinates(1), (Range2D{{6.0f, 0.0f}, {12.0f, 10.0f}}));
+    CORRADE_COMPARE(glyphTable.quadSize(2), (Vector2{2.25f, 1.5f}));
+    CORRADE_COMPARE(glyphTable.textureCoordinates(2), (Range2D{{12.0f, 0.0f}, {18.0f, 10.0f}}));
+}
+
+void InstancedRendererGLTest::renderDataExistingGlyphs() {
+    TestFont font;
+    CORRADE_VERIFY(font.openFile({}, 0.5f));
+    GlyphTable glyphTable;
+    std::vector<InstancedGlyph> glyphs;
+    std::tie(glyphs, std::ignore) = AbstractInstancedRenderer::render(font, nullGlyphCache, 0.25f, "abc", glyphTable);
+    CORRADE_COMPARE(glyphTable.glyphCount(), 3);
+
+    /* Rendering the same text again reuses the glyphs */
+    std::tie(glyphs, std::ignore) = AbstractInstancedRenderer::render(font, nullGlyphCache, 0.25f, "cab", glyphTable);
+    CORRADE_COMPARE(glyphTable.glyphCount(), 3);
+    CORRADE_COMPARE(glyphs.size(), 3);
+    CORRADE_COMPARE(glyphs[2].glyph, 2);
+
+    /* Rendering at a different size gives the same texture coordinates but
+       different quad sizes, so new glyphs are added */
+    std::tie(glyphs, std::ignore) = AbstractInstancedRenderer::render(font, nullGlyphCache, 0.5f, "abc", glyphTable);
+    CORRADE_COMPARE(glyphTable.glyphCount(), 6);
+    CORRADE_COMPARE(glyphs[0].glyph, 3);
+    CORRADE_COMPARE(glyphTable.quadSize(3), (Vector2{1.5f, 1.0f}));
+    CORRADE_COMPARE(glyphTable.textureCoordinates(3), glyphTable.textureCoordinates(0));
+}
+
+void InstancedRendererGLTest::mutableText() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() + std::string(" is not supported"));
+    #endif
+
+    TestFont font;
+    CORRADE_VERIFY(font.openFile({}, 0.5f));
+
+    GlyphCache cache{{16, 16}};
+    InstancedRenderer2D renderer{font, cache, 0.25f};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 0);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D());
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+
+    /* The table is prefilled from the cache, which contains just the invalid
+       glyph */
+    CORRADE_COMPARE(renderer.glyphTable().glyphCount(), 1);
+
+    /* Reserve some capacity */
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+
+    /* Render text */
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 3);
+
+    /* The glyphs from the layouter aren't in the cache, so they got added */
+    CORRADE_COMPARE(renderer.glyphTable().glyphCount(), 4);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> instanceData = renderer.instanceBuffer().data();
+    CORRADE_COMPARE(instanceData.size(), 4*sizeof(InstancedGlyph));
+    Containers::ArrayView<const InstancedGlyph> instances = Containers::arrayCast<const InstancedGlyph>(instanceData);
+    CORRADE_COMPARE(instances[0].position, (Vector2{0.0f, 0.0f}));
+    CORRADE_COMPARE(instances[0].glyph, 1);
+    CORRADE_COMPARE(instances[1].position, (Vector2{1.0f, -0.25f}));
+    CORRADE_COMPARE(instances[1].glyph, 2);
+    CORRADE_COMPARE(instances[2].position, (Vector2{2.75f, -0.5f}));
+    CORRADE_COMPARE(instances[2].glyph, 3);
+    CORRADE_COMPARE(instances[2].scale, 1.0f);
+    CORRADE_COMPARE(instances[2].color, Color4ub{255});
+
+    /* The table texture got uploaded again with the new glyphs */
+    CORRADE_COMPARE(renderer.glyphTableTexture().imageSize(0), (Vector2i{GlyphTable::GlyphsPerRow*2, 1}));
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::InstancedRendererGLTest)
@@ -43,6 +43,8 @@ class AbstractLayouter;
 enum class Alignment: UnsignedByte;
 
 class AbstractGlyphCache;
+class GlyphTable;
+struct InstancedGlyph;
 #ifdef MAGNUM_TARGET_GL
 class DistanceFieldGlyphCache;
 class GlyphCache;
@@ -50,6 +52,12 @@ class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+#ifndef MAGNUM_TARGET_GLES2
+class AbstractInstancedRenderer;
+template<UnsignedInt> class InstancedRenderer;
+typedef InstancedRenderer<2> InstancedRenderer2D;
+typedef InstancedRenderer<3> InstancedRenderer3D;
+#endif
 #endif
 #endif
 
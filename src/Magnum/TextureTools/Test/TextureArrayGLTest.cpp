@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/TextureTools/TextureArray.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct TextureArrayGLTest: GL::OpenGLTester {
+    explicit TextureArrayGLTest();
+
+    void create();
+    void createLevels();
+    void createImplementationSpecific();
+};
+
+TextureArrayGLTest::TextureArrayGLTest() {
+    addTests({&TextureArrayGLTest::create,
+              &TextureArrayGLTest::createLevels,
+              &TextureArrayGLTest::createImplementationSpecific});
+}
+
+using namespace Math::Literals;
+
+const Color4ub DataA[]{
+    0xff0000ff_rgba, 0x00ff00ff_rgba,
+    0x0000ffff_rgba, 0xffffffff_rgba
+};
+
+const Color4ub DataB[]{
+    0x11223344_rgba, 0x55667788_rgba,
+    0x99aabbcc_rgba, 0xddeeff00_rgba
+};
+
+const Color4ub DataC[]{
+    0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba,
+    0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba,
+    0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba,
+    0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba, 0x336699ff_rgba
+};
+
+void TextureArrayGLTest::create() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    const std::vector<ImageView2D> textures{
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, DataA},
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, DataC},
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, DataB}
+    };
+    const TextureArrayBatch batch = batchTextureArrays(textures);
+    CORRADE_COMPARE(batch.arrays.size(), 2);
+
+    std::vector<GL::Texture2DArray> arrays = createTextureArrays(batch, textures);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(arrays.size(), 2);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D a = arrays[0].image(0, {PixelFormat::RGBA8Unorm});
+    Image3D b = arrays[1].image(0, {PixelFormat::RGBA8Unorm});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The first and the last texture are layers of the first array */
+    CORRADE_COMPARE(a.size(), (Vector3i{2, 2, 2}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(a.data()).prefix(4),
+        Containers::arrayView(DataA), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(a.data()).suffix(4),
+        Containers::arrayView(DataB), TestSuite::Compare::Container);
+    CORRADE_COMPARE(b.size(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(b.data()),
+        Containers::arrayView(DataC), TestSuite::Compare::Container);
+    #endif
+}
+
+void TextureArrayGLTest::createLevels() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    const std::vector<std::vector<ImageView2D>> textures{
+        {ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, DataA},
+         ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, Containers::arrayView(DataB).prefix(1)}},
+        {ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, DataB},
+         ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, Containers::arrayView(DataA).prefix(1)}}
+    };
+    const TextureArrayBatch batch = batchTextureArrays(textures);
+    CORRADE_COMPARE(batch.arrays.size(), 1);
+
+    std::vector<GL::Texture2DArray> arrays = createTextureArrays(batch, textures);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(arrays.size(), 1);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image = arrays[0].image(1, {PixelFormat::RGBA8Unorm});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const Color4ub expected[]{DataB[0], DataA[0]};
+    CORRADE_COMPARE(image.size(), (Vector3i{1, 1, 2}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()),
+        Containers::arrayView(expected), TestSuite::Compare::Container);
+    #endif
+}
+
+void TextureArrayGLTest::createImplementationSpecific() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    /* Uses RGBA8 as the internal format. There's no API to query it, so this
+       only verifies that the storage gets allocated and the data uploaded. */
+    const std::vector<ImageView2D> textures{
+        ImageView2D{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte, {2, 2}, DataA},
+        ImageView2D{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte, {2, 2}, DataB}
+    };
+    const TextureArrayBatch batch = batchTextureArrays(textures);
+    CORRADE_COMPARE(batch.arrays.size(), 1);
+
+    std::vector<GL::Texture2DArray> arrays = createTextureArrays(batch, textures);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(arrays.size(), 1);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image = arrays[0].image(0, {GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(image.size(), (Vector3i{2, 2, 2}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()).prefix(4),
+        Containers::arrayView(DataA), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()).suffix(4),
+        Containers::arrayView(DataB), TestSuite::Compare::Container);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::TextureArrayGLTest)
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/TextureTools/TextureArray.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct TextureArrayTest: TestSuite::Tester {
+    explicit TextureArrayTest();
+
+    void batch();
+    void batchLevels();
+    void batchFormatExtra();
+    void batchMaxLayers();
+    void batchMaxLayersInterleaved();
+    void batchEmpty();
+};
+
+TextureArrayTest::TextureArrayTest() {
+    addTests({&TextureArrayTest::batch,
+              &TextureArrayTest::batchLevels,
+              &TextureArrayTest::batchFormatExtra,
+              &TextureArrayTest::batchMaxLayers,
+              &TextureArrayTest::batchMaxLayersInterleaved,
+              &TextureArrayTest::batchEmpty});
+}
+
+typedef std::vector<std::pair<UnsignedInt, UnsignedInt>> Layers;
+
+Layers layers(const TextureArrayBatch& batch) {
+    Layers out;
+    for(const TextureArrayLayer& layer: batch.layers)
+        out.emplace_back(layer.array, layer.layer);
+    return out;
+}
+
+void TextureArrayTest::batch() {
+    /* Only the metadata matter, no need for any pixel data */
+    TextureArrayBatch batch = batchTextureArrays(std::vector<ImageView2D>{
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {32, 32}},
+        ImageView2D{PixelFormat::RGB8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}}
+    });
+
+    CORRADE_COMPARE(batch.arrays.size(), 3);
+    CORRADE_COMPARE(batch.arrays[0].size, (Vector2i{16, 16}));
+    CORRADE_COMPARE(batch.arrays[0].format, PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(batch.arrays[0].levels, 1);
+    CORRADE_COMPARE_AS(batch.arrays[0].textures, (std::vector<UnsignedInt>{0, 1, 4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.arrays[1].size, (Vector2i{32, 32}));
+    CORRADE_COMPARE(batch.arrays[1].format, PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(batch.arrays[1].textures, (std::vector<UnsignedInt>{2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.arrays[2].size, (Vector2i{16, 16}));
+    CORRADE_COMPARE(batch.arrays[2].format, PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE_AS(batch.arrays[2].textures, (std::vector<UnsignedInt>{3}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE_AS(layers(batch), (Layers{
+        {0, 0}, {0, 1}, {1, 0}, {2, 0}, {0, 2}
+    }), TestSuite::Compare::Container);
+}
+
+void TextureArrayTest::batchLevels() {
+    /* Same size and format, but different level count */
+    TextureArrayBatch batch = batchTextureArrays(std::vector<std::vector<ImageView2D>>{
+        {ImageView2D{PixelFormat::R8Unorm, {8, 4}},
+         ImageView2D{PixelFormat::R8Unorm, {4, 2}},
+         ImageView2D{PixelFormat::R8Unorm, {2, 1}},
+         ImageView2D{PixelFormat::R8Unorm, {1, 1}}},
+        {ImageView2D{PixelFormat::R8Unorm, {8, 4}}},
+        {ImageView2D{PixelFormat::R8Unorm, {8, 4}},
+         ImageView2D{PixelFormat::R8Unorm, {4, 2}},
+         ImageView2D{PixelFormat::R8Unorm, {2, 1}},
+         ImageView2D{PixelFormat::R8Unorm, {1, 1}}}
+    });
+
+    CORRADE_COMPARE(batch.arrays.size(), 2);
+    CORRADE_COMPARE(batch.arrays[0].levels, 4);
+    CORRADE_COMPARE_AS(batch.arrays[0].textures, (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.arrays[1].levels, 1);
+    CORRADE_COMPARE_AS(batch.arrays[1].textures, (std::vector<UnsignedInt>{1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layers(batch), (Layers{
+        {0, 0}, {1, 0}, {0, 1}
+    }), TestSuite::Compare::Container);
+}
+
+void TextureArrayTest::batchFormatExtra() {
+    /* Same implementation-specific format, but different extra specifier */
+    TextureArrayBatch batch = batchTextureArrays(std::vector<ImageView2D>{
+        ImageView2D{{}, 0x1908u, 0x1401u, 4, {16, 16}},
+        ImageView2D{{}, 0x1908u, 0x1406u, 16, {16, 16}},
+        ImageView2D{{}, 0x1908u, 0x1401u, 4, {16, 16}}
+    });
+
+    CORRADE_COMPARE(batch.arrays.size(), 2);
+    CORRADE_COMPARE(batch.arrays[0].format, pixelFormatWrap(0x1908u));
+    CORRADE_COMPARE(batch.arrays[0].formatExtra, 0x1401u);
+    CORRADE_COMPARE_AS(batch.arrays[0].textures, (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.arrays[1].formatExtra, 0x1406u);
+    CORRADE_COMPARE_AS(batch.arrays[1].textures, (std::vector<UnsignedInt>{1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layers(batch), (Layers{
+        {0, 0}, {1, 0}, {0, 1}
+    }), TestSuite::Compare::Container);
+}
+
+void TextureArrayTest::batchMaxLayers() {
+    TextureArrayBatch batch = batchTextureArrays(std::vector<ImageView2D>{
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}}
+    }, 2);
+
+    CORRADE_COMPARE(batch.arrays.size(), 3);
+    CORRADE_COMPARE_AS(batch.arrays[0].textures, (std::vector<UnsignedInt>{0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.arrays[1].textures, (std::vector<UnsignedInt>{2, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.arrays[2].textures, (std::vector<UnsignedInt>{4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layers(batch), (Layers{
+        {0, 0}, {0, 1}, {1, 0}, {1, 1}, {2, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void TextureArrayTest::batchMaxLayersInterleaved() {
+    /* A full array gets replaced only for its own key */
+    TextureArrayBatch batch = batchTextureArrays(std::vector<ImageView2D>{
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {32, 32}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {32, 32}},
+        ImageView2D{PixelFormat::RGBA8Unorm, {16, 16}}
+    }, 2);
+
+    CORRADE_COMPARE(batch.arrays.size(), 3);
+    CORRADE_COMPARE_AS(batch.arrays[0].textures, (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(batch.arrays[1].textures, (std::vector<UnsignedInt>{1, 3}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.arrays[2].size, (Vector2i{16, 16}));
+    CORRADE_COMPARE_AS(batch.arrays[2].textures, (std::vector<UnsignedInt>{4}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layers(batch), (Layers{
+        {0, 0}, {1, 0}, {0, 1}, {1, 1}, {2, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void TextureArrayTest::batchEmpty() {
+    TextureArrayBatch batch = batchTextureArrays(std::vector<ImageView2D>{});
+    CORRADE_VERIFY(batch.arrays.empty());
+    CORRADE_VERIFY(batch.layers.empty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::TextureArrayTest)
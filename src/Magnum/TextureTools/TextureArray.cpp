@@ -0,0 +1,93 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureArray.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+TextureArrayBatch batchTextureArrays(const std::vector<std::vector<ImageView2D>>& textures, const UnsignedInt maxLayers) {
+    TextureArrayBatch out;
+    out.layers.reserve(textures.size());
+
+    /* Index of the array that's currently being filled for each distinct
+       key. Linear lookup as there's usually just a few distinct keys. */
+    std::vector<UnsignedInt> openArrays;
+
+    for(std::size_t i = 0; i != textures.size(); ++i) {
+        const std::vector<ImageView2D>& levels = textures[i];
+        CORRADE_ASSERT(!levels.empty(),
+            "TextureTools::batchTextureArrays(): texture" << i << "has no levels", {});
+
+        const Vector2i size = levels.front().size();
+        const PixelFormat format = levels.front().format();
+        const UnsignedInt formatExtra = levels.front().formatExtra();
+        for(std::size_t l = 1; l != levels.size(); ++l) {
+            CORRADE_ASSERT(levels[l].format() == format && levels[l].formatExtra() == formatExtra,
+                "TextureTools::batchTextureArrays(): level" << l << "of texture" << i << "has format" << levels[l].format() << Debug::nospace << "," << levels[l].formatExtra() << "but expected" << format << Debug::nospace << "," << formatExtra, {});
+            const Vector2i expectedSize = Math::max(size >> Int(l), Vector2i{1});
+            CORRADE_ASSERT(levels[l].size() == expectedSize,
+                "TextureTools::batchTextureArrays(): level" << l << "of texture" << i << "has size" << levels[l].size() << "but expected" << expectedSize, {});
+        }
+
+        /* Find an array with the same properties that has space left,
+           replace it with a new one if it's full */
+        UnsignedInt* open = nullptr;
+        for(UnsignedInt& a: openArrays) {
+            const TextureArrayBatch::Array& array = out.arrays[a];
+            if(array.size == size && array.format == format && array.formatExtra == formatExtra && array.levels == Int(levels.size())) {
+                open = &a;
+                break;
+            }
+        }
+        if(!open || (maxLayers && out.arrays[*open].textures.size() == maxLayers)) {
+            const UnsignedInt index = out.arrays.size();
+            out.arrays.push_back({size, format, formatExtra, Int(levels.size()), {}});
+            if(open) *open = index;
+            else {
+                openArrays.push_back(index);
+                open = &openArrays.back();
+            }
+        }
+
+        TextureArrayBatch::Array& array = out.arrays[*open];
+        out.layers.push_back({*open, UnsignedInt(array.textures.size())});
+        array.textures.push_back(i);
+    }
+
+    return out;
+}
+
+TextureArrayBatch batchTextureArrays(const std::vector<ImageView2D>& textures, const UnsignedInt maxLayers) {
+    std::vector<std::vector<ImageView2D>> levels;
+    levels.reserve(textures.size());
+    for(const ImageView2D& image: textures) levels.push_back({image});
+    return batchTextureArrays(levels, maxLayers);
+}
+
+}}
@@ -0,0 +1,167 @@
+#ifndef Magnum_TextureTools_TextureArray_h
+#define Magnum_TextureTools_TextureArray_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::TextureTools::TextureArrayLayer, @ref Magnum::TextureTools::TextureArrayBatch, function @ref Magnum::TextureTools::batchTextureArrays(), @ref Magnum::TextureTools::createTextureArrays()
+ * @m_since_latest
+ */
+
+#include <vector>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+#include "Magnum/GL/GL.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Location of a texture in a texture array
+@m_since_latest
+
+@see @ref TextureArrayBatch::layers
+*/
+struct TextureArrayLayer {
+    UnsignedInt array;  /**< @brief Index of the array */
+    UnsignedInt layer;  /**< @brief Layer in the array */
+};
+
+/**
+@brief Textures grouped into texture arrays
+@m_since_latest
+
+@see @ref batchTextureArrays()
+*/
+struct TextureArrayBatch {
+    /** @brief Texture array */
+    struct Array {
+        Vector2i size;              /**< @brief Size of each layer */
+        PixelFormat format;         /**< @brief Pixel format */
+        UnsignedInt formatExtra;    /**< @brief Additional pixel format specifier */
+        Int levels;                 /**< @brief Mip level count */
+
+        /** @brief Original texture IDs, in layer order */
+        std::vector<UnsignedInt> textures;
+    };
+
+    /** @brief Texture arrays */
+    std::vector<Array> arrays;
+
+    /** @brief Location of each original texture, indexed by its ID */
+    std::vector<TextureArrayLayer> layers;
+};
+
+/**
+@brief Group textures into texture arrays
+@param textures     Mip levels of each texture
+@param maxLayers    Max layer count in one array. Use @cpp 0 @ce for no
+    limit.
+@m_since_latest
+
+Textures that have the same size, pixel format, additional pixel format
+specifier and mip level count are put
+into layers of the same array, in the order in which they appear in
+@p textures. If an array would have more than @p maxLayers layers, a new
+array is started for the rest. Pass @ref GL::Texture2DArray::maxSize() "GL::Texture2DArray::maxSize().z()"
+to respect the GL implementation limit. The original texture ID is its index
+in @p textures, the returned @ref TextureArrayBatch::layers has one item for
+each. A draw that used texture @cpp i @ce binds
+@cpp arrays[layers[i].array] @ce instead and uses @cpp layers[i].layer @ce as
+a per-draw layer index, so all draws with textures from the same array can be
+batched together.
+
+Expects that each texture has at least one level and that all levels have
+the same format and additional format specifier as the first one and are half the size of the previous level,
+rounded down but at least one pixel. Only the image properties are used, the
+pixel data are not touched.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT TextureArrayBatch batchTextureArrays(const std::vector<std::vector<ImageView2D>>& textures, UnsignedInt maxLayers = 0);
+
+/**
+@brief Group single-level textures into texture arrays
+@m_since_latest
+
+Same as above, with each texture having only one level. Image data imported
+through @ref Trade::AbstractImporter::image2D() can be passed here directly.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT TextureArrayBatch batchTextureArrays(const std::vector<ImageView2D>& textures, UnsignedInt maxLayers = 0);
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+/**
+@brief Create texture arrays from a batch
+@param batch        Result of @ref batchTextureArrays()
+@param textures     The same textures that were passed to
+    @ref batchTextureArrays()
+@m_since_latest
+
+Creates one @ref GL::Texture2DArray for each item in
+@ref TextureArrayBatch::arrays, allocates its storage with the internal format
+given by @ref GL::textureFormat() and uploads all levels of all textures into
+their layers. The arrays have linear filtering set up, using linear mip
+selection if there's more than one level. Expects that @p textures has one
+item for each item in @ref TextureArrayBatch::layers.
+
+For an implementation-specific format, @ref TextureArrayBatch::Array::format
+is expected to be a wrapped @ref GL::PixelFormat and
+@ref TextureArrayBatch::Array::formatExtra a @ref GL::PixelType. The internal
+format is then the one of the first generic @ref PixelFormat that maps to the
+same pixel format and type, for example @ref GL::TextureFormat::RGBA8 and
+not @ref GL::TextureFormat::SRGB8Alpha8 for @ref GL::PixelFormat::RGBA and
+@ref GL::PixelType::UnsignedByte. Expects that such generic format exists.
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+@requires_gl30 Extension @gl_extension{EXT,texture_array}
+@requires_gles30 Array textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Array textures are not available in WebGL 1.0.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT std::vector<GL::Texture2DArray> createTextureArrays(const TextureArrayBatch& batch, const std::vector<std::vector<ImageView2D>>& textures);
+
+/**
+@brief Create texture arrays from a batch of single-level textures
+@m_since_latest
+
+Same as above, with each texture having only one level.
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+@requires_gl30 Extension @gl_extension{EXT,texture_array}
+@requires_gles30 Array textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Array textures are not available in WebGL 1.0.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT std::vector<GL::Texture2DArray> createTextureArrays(const TextureArrayBatch& batch, const std::vector<ImageView2D>& textures);
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureArray.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Generic formats that have a texture format, in the order of the generic
+   enum. Unorm formats are before sRGB formats that have the same pixel format
+   and type. */
+constexpr struct {
+    GL::PixelFormat format;
+    GL::PixelType type;
+    GL::TextureFormat textureFormat;
+} TextureFormatMapping[] {
+    #define _c(input, format, type, textureFormat) {GL::PixelFormat::format, GL::PixelType::type, GL::TextureFormat::textureFormat},
+    #define _n(input, format, type)
+    #define _s(input)
+    #include "Magnum/GL/Implementation/pixelFormatMapping.hpp"
+    #undef _s
+    #undef _n
+    #undef _c
+};
+
+/* For implementation-specific formats, formatExtra is the GL pixel type.
+   Picks the first generic format with the same GL pixel format and type,
+   returns an empty value if there's none. */
+GL::TextureFormat textureFormatFor(const PixelFormat format, const UnsignedInt formatExtra) {
+    if(!isPixelFormatImplementationSpecific(format))
+        return GL::textureFormat(format);
+
+    const GL::PixelFormat glFormat = pixelFormatUnwrap<GL::PixelFormat>(format);
+    const GL::PixelType glType = GL::PixelType(formatExtra);
+    for(const auto& mapping: TextureFormatMapping)
+        if(mapping.format == glFormat && mapping.type == glType)
+            return mapping.textureFormat;
+
+    return {};
+}
+
+}
+
+std::vector<GL::Texture2DArray> createTextureArrays(const TextureArrayBatch& batch, const std::vector<std::vector<ImageView2D>>& textures) {
+    CORRADE_ASSERT(textures.size() == batch.layers.size(),
+        "TextureTools::createTextureArrays(): expected" << batch.layers.size() << "textures but got" << textures.size(), {});
+
+    std::vector<GL::Texture2DArray> out;
+    out.reserve(batch.arrays.size());
+    for(const TextureArrayBatch::Array& array: batch.arrays) {
+        const GL::TextureFormat format = textureFormatFor(array.format, array.formatExtra);
+        CORRADE_ASSERT(UnsignedInt(format),
+            "TextureTools::createTextureArrays(): can't map" << pixelFormatUnwrap<GL::PixelFormat>(array.format) << "and" << GL::PixelType(array.formatExtra) << "to a texture format", {});
+
+        GL::Texture2DArray texture;
+        texture.setMinificationFilter(GL::SamplerFilter::Linear, array.levels > 1 ? GL::SamplerMipmap::Linear : GL::SamplerMipmap::Base)
+            .setMagnificationFilter(GL::SamplerFilter::Linear)
+            .setStorage(array.levels, format, {array.size, Int(array.textures.size())});
+
+        for(std::size_t layer = 0; layer != array.textures.size(); ++layer) {
+            const std::vector<ImageView2D>& levels = textures[array.textures[layer]];
+            CORRADE_ASSERT(levels.size() == std::size_t(array.levels),
+                "TextureTools::createTextureArrays(): expected" << array.levels << "levels for texture" << array.textures[layer] << "but got" << levels.size(), {});
+            for(std::size_t level = 0; level != levels.size(); ++level) {
+                const ImageView2D& image = levels[level];
+                texture.setSubImage(Int(level), {0, 0, Int(layer)}, ImageView3D{image.storage(), image.format(), image.formatExtra(), image.pixelSize(), {image.size(), 1}, image.data()});
+            }
+        }
+
+        out.push_back(std::move(texture));
+    }
+
+    return out;
+}
+
+std::vector<GL::Texture2DArray> createTextureArrays(const TextureArrayBatch& batch, const std::vector<ImageView2D>& textures) {
+    std::vector<std::vector<ImageView2D>> levels;
+    levels.reserve(textures.size());
+    for(const ImageView2D& image: textures) levels.push_back({image});
+    return createTextureArrays(batch, levels);
+}
+
+}}
+#endif
@@ -32,6 +32,7 @@
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/PixelStorage.h"
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/Trade/visibility.h"
@@ -478,6 +479,7 @@ template<UnsignedInt dimensions> class ImageData {
         UnsignedInt _pixelSize;
         Math::Vector<Dimensions, Int> _size;
         Containers::Array<char> _data;
+        AccountedMemory _accountedMemory;
         const void* _importerState;
 };
 
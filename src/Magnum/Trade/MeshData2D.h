@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/Trade/visibility.h"
 
 namespace Magnum { namespace Trade {
@@ -168,6 +169,7 @@ class MAGNUM_TRADE_EXPORT MeshData2D {
         std::vector<std::vector<Vector2>> _positions;
         std::vector<std::vector<Vector2>> _textureCoords2D;
         std::vector<std::vector<Color4>> _colors;
+        AccountedMemory _accountedMemory;
         const void* _importerState;
 };
 
@@ -29,8 +29,20 @@
 
 namespace Magnum { namespace Trade {
 
-MeshData3D::MeshData3D(const MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<std::vector<Color4>> colors, const void* const importerState): _primitive{primitive}, _indices{std::move(indices)}, _positions{std::move(positions)}, _normals{std::move(normals)}, _textureCoords2D{std::move(textureCoords2D)}, _colors{std::move(colors)}, _importerState{importerState} {
+namespace {
+
+template<class T> std::size_t dataSize(const std::vector<std::vector<T>>& arrays) {
+    std::size_t size = 0;
+    for(const std::vector<T>& array: arrays) size += array.size()*sizeof(T);
+    return size;
+}
+
+}
+
+MeshData3D::MeshData3D(const MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<std::vector<Color4>> colors, const void* const importerState): _primitive{primitive}, _indices{std::move(indices)}, _positions{std::move(positions)}, _normals{std::move(normals)}, _textureCoords2D{std::move(textureCoords2D)}, _colors{std::move(colors)}, _accountedMemory{MemoryCategory::MeshData}, _importerState{importerState} {
     CORRADE_ASSERT(!_positions.empty(), "Trade::MeshData3D: no position array specified", );
+
+    _accountedMemory.setSize(_indices.size()*sizeof(UnsignedInt) + dataSize(_positions) + dataSize(_normals) + dataSize(_textureCoords2D) + dataSize(_colors));
 }
 
 MeshData3D::MeshData3D(MeshData3D&&)
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/Trade/visibility.h"
 
 namespace Magnum { namespace Trade {
@@ -185,6 +186,7 @@ class MAGNUM_TRADE_EXPORT MeshData3D {
         std::vector<std::vector<Vector3>> _normals;
         std::vector<std::vector<Vector2>> _textureCoords2D;
         std::vector<std::vector<Color4>> _colors;
+        AccountedMemory _accountedMemory;
         const void* _importerState;
 };
 
@@ -73,6 +73,8 @@ struct ImageDataTest: TestSuite::Tester {
     void release();
     void releaseCompressed();
 
+    void memoryAccounting();
+
     void pixels1D();
     void pixels2D();
     void pixels3D();
@@ -127,6 +129,8 @@ ImageDataTest::ImageDataTest() {
               &ImageDataTest::release,
               &ImageDataTest::releaseCompressed,
 
+              &ImageDataTest::memoryAccounting,
+
               &ImageDataTest::pixels1D,
               &ImageDataTest::pixels2D,
               &ImageDataTest::pixels3D,
@@ -634,6 +638,36 @@ void ImageDataTest::releaseCompressed() {
     CORRADE_COMPARE(a.size(), Vector2i());
 }
 
+void ImageDataTest::memoryAccounting() {
+    MemoryAccounting::setEnabled(true);
+    /* The peak is global state, reset it so it doesn't depend on what ran
+       before */
+    MemoryAccounting::resetPeakUsage();
+
+    {
+        Trade::ImageData2D a{PixelFormat::RGBA8Unorm, {4, 4}, Containers::Array<char>{64}};
+        Trade::ImageData2D b{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Containers::Array<char>{8}};
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 72);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::ImageData), 2);
+
+        /* Moving doesn't change anything */
+        Trade::ImageData2D c{std::move(a)};
+        a = std::move(b);
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 72);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::ImageData), 2);
+
+        /* The released data are not owned by the image anymore */
+        c.release();
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 8);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::ImageData), 1);
+    }
+
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::ImageData), 0);
+    CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::ImageData), 72);
+
+    MemoryAccounting::setEnabled(false);
+}
+
 void ImageDataTest::pixels1D() {
     ImageData1D image{
         PixelStorage{}
@@ -25,6 +25,7 @@
 
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/MemoryAccounting.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Trade/MeshData3D.h"
@@ -41,6 +42,8 @@ struct MeshData3DTest: TestSuite::Tester {
     void constructNoColors();
     void constructCopy();
     void constructMove();
+
+    void memoryAccounting();
 };
 
 MeshData3DTest::MeshData3DTest() {
@@ -50,7 +53,9 @@ MeshData3DTest::MeshData3DTest() {
               &MeshData3DTest::constructNoTexCoords,
               &MeshData3DTest::constructNoColors,
               &MeshData3DTest::constructCopy,
-              &MeshData3DTest::constructMove});
+              &MeshData3DTest::constructMove,
+
+              &MeshData3DTest::memoryAccounting});
 }
 
 using namespace Math::Literals;
@@ -195,6 +200,36 @@ void MeshData3DTest::constructMove() {
     CORRADE_COMPARE(d.importerState(), &a);
 }
 
+void MeshData3DTest::memoryAccounting() {
+    MemoryAccounting::setEnabled(true);
+    /* The peak is global state, reset it so it doesn't depend on what ran
+       before */
+    MemoryAccounting::resetPeakUsage();
+
+    {
+        MeshData3D data{MeshPrimitive::Lines, {12, 1, 0},
+            {{{0.5f, 1.0f, 0.1f}, {-1.0f, 0.3f, -1.0f}}},
+            {{{0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}}},
+            {{{0.0f, 0.0f}, {0.3f, 0.7f}}},
+            {{0xff98ab_rgbf, 0xff3366_rgbf}}};
+
+        /* 3 indices, 2 positions, normals, texture coordinates and colors */
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 3*4 + 2*12 + 2*12 + 2*8 + 2*16);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 1);
+
+        /* Moving doesn't change anything */
+        MeshData3D b{std::move(data)};
+        CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 108);
+        CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 1);
+    }
+
+    CORRADE_COMPARE(MemoryAccounting::usage(MemoryCategory::MeshData), 0);
+    CORRADE_COMPARE(MemoryAccounting::allocationCount(MemoryCategory::MeshData), 0);
+    CORRADE_COMPARE(MemoryAccounting::peakUsage(MemoryCategory::MeshData), 108);
+
+    MemoryAccounting::setEnabled(false);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshData3DTest)